@@ -294,6 +294,7 @@ else:
         "gpu.texture",
         "gpu.platform",
         "gpu.capabilities",
+        "gpu.profiling",
         "gpu_extras",
         "idprop.types",
         "mathutils",
@@ -2226,6 +2227,7 @@ def write_rst_importable_modules(basepath):
         "gpu.texture": "GPU Texture Utilities",
         "gpu.platform": "GPU Platform Utilities",
         "gpu.capabilities": "GPU Capabilities Utilities",
+        "gpu.profiling": "GPU Profiling Utilities",
         "bmesh": "BMesh Module",
         "bmesh.ops": "BMesh Operators",
         "bmesh.types": "BMesh Types",
@@ -25,6 +25,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/math.h"
+#include "util/tbb.h"
 
 #include "mikktspace.hh"
 
@@ -35,6 +36,10 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Number of vertices and triangles converted per task when copying mesh data in parallel. */
+static const size_t VERTS_PER_TASK = 16384;
+static const size_t TRIANGLES_PER_TASK = 8192;
+
 /* Tangent Space */
 
 template<bool is_subd> struct MikkMeshWrapper {
@@ -477,12 +482,15 @@ static void attr_create_uv_map(Scene *scene,
         const blender::VArraySpan b_uv_map = *b_attributes.lookup<blender::float2>(
             uv_name.c_str(), blender::bke::AttrDomain::Corner);
         float2 *fdata = uv_attr->data_float2();
-        for (const int i : corner_tris.index_range()) {
-          const blender::int3 &tri = corner_tris[i];
-          fdata[i * 3 + 0] = make_float2(b_uv_map[tri[0]][0], b_uv_map[tri[0]][1]);
-          fdata[i * 3 + 1] = make_float2(b_uv_map[tri[1]][0], b_uv_map[tri[1]][1]);
-          fdata[i * 3 + 2] = make_float2(b_uv_map[tri[2]][0], b_uv_map[tri[2]][1]);
-        }
+        parallel_for(blocked_range<size_t>(0, corner_tris.size(), TRIANGLES_PER_TASK),
+                     [&](const blocked_range<size_t> &r) {
+                       for (size_t i = r.begin(); i != r.end(); i++) {
+                         const blender::int3 &tri = corner_tris[i];
+                         fdata[i * 3 + 0] = make_float2(b_uv_map[tri[0]][0], b_uv_map[tri[0]][1]);
+                         fdata[i * 3 + 1] = make_float2(b_uv_map[tri[1]][0], b_uv_map[tri[1]][1]);
+                         fdata[i * 3 + 2] = make_float2(b_uv_map[tri[2]][0], b_uv_map[tri[2]][1]);
+                       }
+                     });
       }
 
       /* UV tangent */
@@ -865,9 +873,12 @@ static void create_mesh(Scene *scene,
   mesh->resize_mesh(positions.size(), numtris);
 
   float3 *verts = mesh->get_verts().data();
-  for (const int i : positions.index_range()) {
-    verts[i] = make_float3(positions[i][0], positions[i][1], positions[i][2]);
-  }
+  parallel_for(blocked_range<size_t>(0, positions.size(), VERTS_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   verts[i] = make_float3(positions[i][0], positions[i][1], positions[i][2]);
+                 }
+               });
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
@@ -875,9 +886,13 @@ static void create_mesh(Scene *scene,
 
   if (subdivision || !(use_corner_normals && !corner_normals.is_empty())) {
     const blender::Span<blender::float3> vert_normals = b_mesh.vert_normals();
-    for (const int i : vert_normals.index_range()) {
-      N[i] = make_float3(vert_normals[i][0], vert_normals[i][1], vert_normals[i][2]);
-    }
+    parallel_for(blocked_range<size_t>(0, vert_normals.size(), VERTS_PER_TASK),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); i++) {
+                     const blender::float3 &normal = vert_normals[i];
+                     N[i] = make_float3(normal[0], normal[1], normal[2]);
+                   }
+                 });
   }
 
   const set<ustring> blender_uv_names = get_blender_uv_names(b_mesh);
@@ -924,33 +939,42 @@ static void create_mesh(Scene *scene,
     int *shader = mesh->get_shader().data();
 
     const blender::Span<blender::int3> corner_tris = b_mesh.corner_tris();
-    for (const int i : corner_tris.index_range()) {
-      const blender::int3 &tri = corner_tris[i];
-      triangles[i * 3 + 0] = corner_verts[tri[0]];
-      triangles[i * 3 + 1] = corner_verts[tri[1]];
-      triangles[i * 3 + 2] = corner_verts[tri[2]];
-    }
-
-    if (!material_indices.is_empty()) {
-      const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
-        shader[i] = clamp_material_index(material_indices[tri_faces[i]]);
-      }
-    }
-    else {
-      std::fill(shader, shader + numtris, 0);
-    }
-
-    if (!sharp_faces.is_empty() && !(use_corner_normals && !corner_normals.is_empty())) {
-      const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
-        smooth[i] = !sharp_faces[tri_faces[i]];
-      }
-    }
-    else {
-      /* If only face normals are needed, all faces are sharp. */
-      std::fill(smooth, smooth + numtris, normals_domain != blender::bke::MeshNormalDomain::Face);
-    }
+    const bool use_face_smooth = !sharp_faces.is_empty() &&
+                                 !(use_corner_normals && !corner_normals.is_empty());
+    const blender::Span<int> tri_faces = (!material_indices.is_empty() || use_face_smooth) ?
+                                             b_mesh.corner_tri_faces() :
+                                             blender::Span<int>();
+
+    parallel_for(blocked_range<size_t>(0, corner_tris.size(), TRIANGLES_PER_TASK),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); i++) {
+                     const blender::int3 &tri = corner_tris[i];
+                     triangles[i * 3 + 0] = corner_verts[tri[0]];
+                     triangles[i * 3 + 1] = corner_verts[tri[1]];
+                     triangles[i * 3 + 2] = corner_verts[tri[2]];
+                   }
+
+                   if (!material_indices.is_empty()) {
+                     for (size_t i = r.begin(); i != r.end(); i++) {
+                       shader[i] = clamp_material_index(material_indices[tri_faces[i]]);
+                     }
+                   }
+                   else {
+                     std::fill(shader + r.begin(), shader + r.end(), 0);
+                   }
+
+                   if (use_face_smooth) {
+                     for (size_t i = r.begin(); i != r.end(); i++) {
+                       smooth[i] = !sharp_faces[tri_faces[i]];
+                     }
+                   }
+                   else {
+                     /* If only face normals are needed, all faces are sharp. */
+                     std::fill(smooth + r.begin(),
+                               smooth + r.end(),
+                               normals_domain != blender::bke::MeshNormalDomain::Face);
+                   }
+                 });
 
     if (use_corner_normals && !corner_normals.is_empty()) {
       for (const int i : corner_tris.index_range()) {
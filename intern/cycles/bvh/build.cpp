@@ -26,6 +26,8 @@
 #include "util/queue.h"
 #include "util/simd.h"
 #include "util/stack_allocator.h"
+#include "util/tbb.h"
+#include "util/thread.h"
 #include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
@@ -56,6 +58,56 @@ BVHBuild::~BVHBuild() {}
 
 /* Adding References */
 
+void BVHBuild::add_reference_triangles_static(BoundBox &root,
+                                              BoundBox &center,
+                                              Mesh *mesh,
+                                              int object_index)
+{
+  /* Static triangles are the common case for large meshes, so their bounds are computed in
+   * parallel. References are written at their triangle index and invalid triangles are removed
+   * afterwards, which gives the same order as adding the triangles one by one. */
+  const PrimitiveType primitive_type = mesh->primitive_type();
+  const size_t num_triangles = mesh->num_triangles();
+  if (num_triangles == 0) {
+    return;
+  }
+
+  const float3 *verts = &mesh->verts[0];
+  const size_t references_start = references.size();
+  references.resize(references_start + num_triangles);
+  BVHReference *mesh_references = &references[references_start];
+
+  thread_mutex bounds_mutex;
+  static const size_t TRIANGLES_PER_TASK = 4096;
+  parallel_for(blocked_range<size_t>(0, num_triangles, TRIANGLES_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 BoundBox local_root = BoundBox::empty, local_center = BoundBox::empty;
+                 for (size_t j = r.begin(); j != r.end(); j++) {
+                   Mesh::Triangle t = mesh->get_triangle(j);
+                   BoundBox bounds = BoundBox::empty;
+                   t.bounds_grow(verts, bounds);
+                   if (bounds.valid() && t.valid(verts)) {
+                     mesh_references[j] = BVHReference(bounds, j, object_index, primitive_type);
+                     local_root.grow(bounds);
+                     local_center.grow(bounds.center2());
+                   }
+                   else {
+                     /* Tag as invalid, object indices of actual references are never negative. */
+                     mesh_references[j] = BVHReference(BoundBox::empty, j, -1, primitive_type);
+                   }
+                 }
+
+                 thread_scoped_lock lock(bounds_mutex);
+                 root.grow(local_root);
+                 center.grow(local_center);
+               });
+
+  references.erase(std::remove_if(references.begin() + references_start,
+                                  references.end(),
+                                  [](const BVHReference &ref) { return ref.prim_object() < 0; }),
+                   references.end());
+}
+
 void BVHBuild::add_reference_triangles(BoundBox &root,
                                        BoundBox &center,
                                        Mesh *mesh,
@@ -67,19 +119,16 @@ void BVHBuild::add_reference_triangles(BoundBox &root,
     attr_mP = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
   }
   const size_t num_triangles = mesh->num_triangles();
+
+  if (attr_mP == NULL) {
+    add_reference_triangles_static(root, center, mesh, object_index);
+    return;
+  }
+
   for (uint j = 0; j < num_triangles; j++) {
     Mesh::Triangle t = mesh->get_triangle(j);
     const float3 *verts = &mesh->verts[0];
-    if (attr_mP == NULL) {
-      BoundBox bounds = BoundBox::empty;
-      t.bounds_grow(verts, bounds);
-      if (bounds.valid() && t.valid(verts)) {
-        references.push_back(BVHReference(bounds, j, object_index, primitive_type));
-        root.grow(bounds);
-        center.grow(bounds.center2());
-      }
-    }
-    else if (params.num_motion_triangle_steps == 0 || params.use_spatial_split) {
+    if (params.num_motion_triangle_steps == 0 || params.use_spatial_split) {
       /* Motion triangles, simple case: single node for the whole
        * primitive. Lowest memory footprint and faster BVH build but
        * least optimal ray-tracing.
@@ -55,10 +55,7 @@ DeviceQueue::~DeviceQueue()
 
 void DeviceQueue::debug_init_execution()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
-    last_sync_time_ = time_dt();
-  }
-
+  last_sync_time_ = time_dt();
   last_kernels_enqueued_ = 0;
 }
 
@@ -70,6 +67,10 @@ void DeviceQueue::debug_enqueue_begin(DeviceKernel kernel, const int work_size)
   }
 
   last_kernels_enqueued_ |= (uint64_t(1) << (uint64_t)kernel);
+
+  KernelStatistics &stats = stats_kernel_launches_[kernel];
+  stats.num_launches++;
+  stats.work_size += work_size;
 }
 
 void DeviceQueue::debug_enqueue_end()
@@ -81,20 +82,21 @@ void DeviceQueue::debug_enqueue_end()
 
 void DeviceQueue::debug_synchronize()
 {
+  /* The time is always accumulated, as it is cheap compared to the synchronization itself and
+   * is used for the render statistics. */
+  const double new_time = time_dt();
+  const double elapsed_time = new_time - last_sync_time_;
   if (VLOG_DEVICE_STATS_IS_ON) {
-    const double new_time = time_dt();
-    const double elapsed_time = new_time - last_sync_time_;
     VLOG_DEVICE_STATS << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time << "s";
+  }
 
-    /* There is no sense to have an entries in the performance data
-     * container without related kernel information. */
-    if (last_kernels_enqueued_ != 0) {
-      stats_kernel_time_[last_kernels_enqueued_] += elapsed_time;
-    }
-
-    last_sync_time_ = new_time;
+  /* There is no sense to have an entries in the performance data
+   * container without related kernel information. */
+  if (last_kernels_enqueued_ != 0) {
+    stats_kernel_time_[last_kernels_enqueued_] += elapsed_time;
   }
 
+  last_sync_time_ = new_time;
   last_kernels_enqueued_ = 0;
 }
 
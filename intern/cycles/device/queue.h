@@ -162,6 +162,28 @@ class DeviceQueue {
     return nullptr;
   }
 
+  /* Statistics about launches of a kernel on this queue. They are gathered with a negligible
+   * overhead, independently from the logging level. */
+  struct KernelStatistics {
+    /* Number of times the kernel was enqueued. */
+    uint64_t num_launches = 0;
+    /* Sum of the work sizes of all launches. For path tracing kernels this is the number of
+     * paths which were active when the kernel was launched. */
+    uint64_t work_size = 0;
+  };
+
+  const KernelStatistics &get_kernel_statistics(DeviceKernel kernel) const
+  {
+    return stats_kernel_launches_[kernel];
+  }
+
+  /* Accumulated execution time for combinations of kernels launched together. Kernels are only
+   * timed individually with the CYCLES_DEBUG_PER_KERNEL_PERFORMANCE environment variable. */
+  const map<DeviceKernelMask, double> &get_kernel_time_statistics() const
+  {
+    return stats_kernel_time_;
+  }
+
  protected:
   /* Hide construction so that allocation via `Device` API is enforced. */
   explicit DeviceQueue(Device *device);
@@ -179,6 +201,8 @@ class DeviceQueue {
   double last_sync_time_;
   /* Accumulated execution time for combinations of kernels launched together. */
   map<DeviceKernelMask, double> stats_kernel_time_;
+  /* Launch statistics of every kernel. */
+  KernelStatistics stats_kernel_launches_[DEVICE_KERNEL_NUM];
   /* If it is true, then a performance statistics in the debugging logs will have focus on kernels
    * and an explicit queue synchronization will be added after each kernel execution. */
   bool is_per_kernel_performance_;
@@ -1308,6 +1308,13 @@ string PathTrace::full_report() const
   return result;
 }
 
+void PathTrace::collect_statistics(RenderStats *stats) const
+{
+  for (const unique_ptr<PathTraceWork> &path_trace_work : path_trace_works_) {
+    path_trace_work->collect_statistics(stats);
+  }
+}
+
 void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bool reset)
 {
 #ifdef WITH_PATH_GUIDING
@@ -27,6 +27,7 @@ class DisplayDriver;
 class Film;
 class RenderBuffers;
 class RenderScheduler;
+class RenderStats;
 class RenderWork;
 class PathTraceDisplay;
 class OutputDriver;
@@ -176,6 +177,9 @@ class PathTrace {
    * times, and so on. */
   string full_report() const;
 
+  /* Add device kernel statistics of all path trace works to the render statistics. */
+  void collect_statistics(RenderStats *stats) const;
+
   /* Callback which is called to report current rendering progress.
    *
    * It is supposed to be cheaper than buffer update/write, hence can be called more often.
@@ -18,6 +18,7 @@ class DeviceScene;
 class Film;
 class PathTraceDisplay;
 class RenderBuffers;
+class RenderStats;
 
 class PathTraceWork {
  public:
@@ -126,6 +127,9 @@ class PathTraceWork {
   /* Run cryptomatte pass post-processing kernels. */
   virtual void cryptomatte_postproces() = 0;
 
+  /* Add device kernel statistics of this work to the render statistics. */
+  virtual void collect_statistics(RenderStats * /*stats*/) {}
+
   /* Cheap-ish request to see whether rendering is requested and is to be stopped as soon as
    * possible, without waiting for any samples to be finished. */
   inline bool is_cancel_requested() const
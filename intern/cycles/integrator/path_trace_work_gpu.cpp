@@ -9,6 +9,7 @@
 
 #include "integrator/pass_accessor_gpu.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "util/log.h"
 #include "util/string.h"
@@ -1159,6 +1160,25 @@ void PathTraceWorkGPU::cryptomatte_postproces()
   queue_->enqueue(DEVICE_KERNEL_CRYPTOMATTE_POSTPROCESS, work_size, args);
 }
 
+void PathTraceWorkGPU::collect_statistics(RenderStats *stats)
+{
+  stats->has_device_kernel_stats = true;
+
+  for (const auto &[mask, time] : queue_->get_kernel_time_statistics()) {
+    stats->device_kernel_time.add_entry(NamedTimeEntry(device_kernel_mask_as_string(mask), time));
+  }
+
+  for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+    const DeviceKernel kernel = static_cast<DeviceKernel>(i);
+    const DeviceQueue::KernelStatistics &kernel_stats = queue_->get_kernel_statistics(kernel);
+    if (kernel_stats.num_launches == 0) {
+      continue;
+    }
+    stats->device_kernel_launches.add_entry(NamedLaunchEntry(
+        device_kernel_as_string(kernel), kernel_stats.num_launches, kernel_stats.work_size));
+  }
+}
+
 bool PathTraceWorkGPU::copy_render_buffers_from_device()
 {
   queue_->copy_from_device(buffers_->buffer);
@@ -1020,10 +1020,15 @@ bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
   }
 
   /* Avoid excessive denoising in viewport after reaching a certain sample count and render time.
-   */
+   *
+   * The interval between denoised updates is derived from the measured denoising time, so that
+   * the render device does not spend more than a quarter of the time waiting for the denoiser.
+   * A fast denoiser updates the display more often, while the interval never exceeds 1 second,
+   * to keep the viewport responsive with slow denoisers. */
   /* TODO(sergey): Consider making time interval and sample configurable. */
+  const double denoise_interval = min(1.0, denoise_time_.get_average() * 3.0);
   delayed = (path_trace_time_.get_wall() > 4 && num_samples_finished >= 20 &&
-             (time_dt() - state_.last_display_update_time) < 1.0);
+             (time_dt() - state_.last_display_update_time) < denoise_interval);
 
   return !delayed;
 }
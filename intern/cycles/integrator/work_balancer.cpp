@@ -38,9 +38,10 @@ static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_i
   return total_time;
 }
 
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
+/* The balance is based on the throughput of every device, which is the measured work it did per
+ * second. Weights proportional to the throughput make all devices finish their work at the same
+ * time, assuming the throughput stays the same. Converging in a single step avoids devices being
+ * idle at the end of every sample while the balance is still being corrected. */
 
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
@@ -49,26 +50,13 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
   const double total_time = calculate_total_time(work_balance_infos);
   const double time_average = total_time / num_infos;
 
-  double total_weight = 0;
-  vector<double> new_weights;
-  new_weights.reserve(num_infos);
-
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
+  if (time_average <= 0.0) {
+    return false;
+  }
 
   bool has_big_difference = false;
-
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = mix(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
-    new_weights.push_back(new_weight);
-    total_weight += new_weight;
-
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
+    if (std::fabs(1.0 - info.time_spent / time_average) > 0.02) {
       has_big_difference = true;
     }
   }
@@ -77,10 +65,24 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
     return false;
   }
 
-  const double total_weight_inv = 1.0 / total_weight;
+  double total_throughput = 0;
+  vector<double> throughputs;
+  throughputs.reserve(num_infos);
+
+  for (const WorkBalanceInfo &info : work_balance_infos) {
+    /* A device which did not report any time (which happens when it got no work) is assumed to be
+     * as fast as the average device, so that it gets work again. */
+    const double time_spent = (info.time_spent > 0.0) ? info.time_spent : time_average;
+    const double weight = (info.weight > 0.0) ? info.weight : 1.0 / num_infos;
+    const double throughput = weight / time_spent;
+    throughputs.push_back(throughput);
+    total_throughput += throughput;
+  }
+
+  const double total_throughput_inv = 1.0 / total_throughput;
   for (int i = 0; i < num_infos; ++i) {
     WorkBalanceInfo &info = work_balance_infos[i];
-    info.weight = new_weights[i] * total_weight_inv;
+    info.weight = throughputs[i] * total_throughput_inv;
     info.time_spent = 0;
   }
 
@@ -187,9 +187,20 @@ void GeometryManager::device_update_mesh(Device *,
     float4 *points = dscene->points.alloc(point_size);
     uint *points_shader = dscene->points_shader.alloc(point_size);
 
+    const bool copy_all_data = dscene->points.need_realloc() ||
+                               dscene->points_shader.need_realloc();
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_pointcloud()) {
         PointCloud *pointcloud = static_cast<PointCloud *>(geom);
+
+        if (!pointcloud->points_is_modified() && !pointcloud->radius_is_modified() &&
+            !pointcloud->shader_is_modified() && !pointcloud->used_shaders_is_modified() &&
+            !copy_all_data)
+        {
+          continue;
+        }
+
         pointcloud->pack(
             scene, &points[pointcloud->prim_offset], &points_shader[pointcloud->prim_offset]);
         if (progress.get_cancel()) {
@@ -198,8 +209,8 @@ void GeometryManager::device_update_mesh(Device *,
       }
     }
 
-    dscene->points.copy_to_device();
-    dscene->points_shader.copy_to_device();
+    dscene->points.copy_to_device_if_modified();
+    dscene->points_shader.copy_to_device_if_modified();
   }
 
   if (patch_size != 0 && dscene->patches.need_realloc()) {
@@ -12,6 +12,7 @@
 #include "integrator/shader_eval.h"
 
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -489,42 +490,60 @@ void Hair::pack_curves(Scene *scene,
                        KernelCurve *curves,
                        KernelCurveSegment *curve_segments)
 {
+  /* Hair heavy scenes have millions of curves, so pack them in parallel. */
+  static const size_t KEYS_PER_TASK = 16384;
+  static const size_t CURVES_PER_TASK = 4096;
+
   size_t curve_keys_size = curve_keys.size();
 
   /* pack curve keys */
   if (curve_keys_size) {
-    float3 *keys_ptr = curve_keys.data();
-    float *radius_ptr = curve_radius.data();
-
-    for (size_t i = 0; i < curve_keys_size; i++) {
-      curve_key_co[i] = make_float4(keys_ptr[i].x, keys_ptr[i].y, keys_ptr[i].z, radius_ptr[i]);
-    }
+    const float3 *keys_ptr = curve_keys.data();
+    const float *radius_ptr = curve_radius.data();
+
+    parallel_for(blocked_range<size_t>(0, curve_keys_size, KEYS_PER_TASK),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); i++) {
+                     curve_key_co[i] = make_float4(
+                         keys_ptr[i].x, keys_ptr[i].y, keys_ptr[i].z, radius_ptr[i]);
+                   }
+                 });
   }
 
   /* pack curve segments */
   const PrimitiveType type = primitive_type();
 
   size_t curve_num = num_curves();
-  size_t index = 0;
-
-  for (size_t i = 0; i < curve_num; i++) {
-    Curve curve = get_curve(i);
-    int shader_id = curve_shader[i];
-    Shader *shader = (shader_id < used_shaders.size()) ?
-                         static_cast<Shader *>(used_shaders[shader_id]) :
-                         scene->default_surface;
-    shader_id = scene->shader_manager->get_shader_id(shader, false);
-
-    curves[i].shader_id = shader_id;
-    curves[i].first_key = curve_key_offset + curve.first_key;
-    curves[i].num_keys = curve.num_keys;
-    curves[i].type = type;
-
-    for (int k = 0; k < curve.num_segments(); ++k, ++index) {
-      curve_segments[index].prim = prim_offset + i;
-      curve_segments[index].type = PRIMITIVE_PACK_SEGMENT(type, k);
-    }
+  if (curve_num == 0) {
+    return;
   }
+
+  /* Keys of curves are stored contiguously and every curve has one segment less than keys, which
+   * gives the index of the first segment of every curve without a running counter. */
+  const int first_key_begin = curve_first_key[0];
+
+  parallel_for(
+      blocked_range<size_t>(0, curve_num, CURVES_PER_TASK), [&](const blocked_range<size_t> &r) {
+        for (size_t i = r.begin(); i != r.end(); i++) {
+          Curve curve = get_curve(i);
+          int shader_id = curve_shader[i];
+          Shader *shader = (shader_id < used_shaders.size()) ?
+                               static_cast<Shader *>(used_shaders[shader_id]) :
+                               scene->default_surface;
+          shader_id = scene->shader_manager->get_shader_id(shader, false);
+
+          curves[i].shader_id = shader_id;
+          curves[i].first_key = curve_key_offset + curve.first_key;
+          curves[i].num_keys = curve.num_keys;
+          curves[i].type = type;
+
+          size_t index = curve.first_key - first_key_begin - i;
+          for (int k = 0; k < curve.num_segments(); ++k, ++index) {
+            curve_segments[index].prim = prim_offset + i;
+            curve_segments[index].type = PRIMITIVE_PACK_SEGMENT(type, k);
+          }
+        }
+      });
 }
 
 PrimitiveType Hair::primitive_type() const
@@ -291,6 +291,15 @@ void ImageMetaData::detect_colorspace()
 
 ImageLoader::ImageLoader() {}
 
+bool ImageLoader::load_pixels_reduced(const ImageMetaData & /*metadata*/,
+                                      void * /*pixels*/,
+                                      const size_t /*width*/,
+                                      const size_t /*height*/,
+                                      const bool /*associate_alpha*/)
+{
+  return false;
+}
+
 ustring ImageLoader::osl_filepath() const
 {
   return ustring();
@@ -554,14 +563,48 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     return false;
   }
 
-  /* Allocate memory as needed, may be smaller to resize down. */
-  if (texture_limit > 0 && max_size > texture_limit) {
-    pixels_storage.resize(((size_t)width) * height * depth * 4);
-    pixels = &pixels_storage[0];
+  float scale_factor = 1.0f;
+  if (texture_limit > 0) {
+    while (max_size * scale_factor > texture_limit) {
+      scale_factor *= 0.5f;
+    }
   }
-  else {
-    thread_scoped_lock device_lock(device_mutex);
-    pixels = (StorageType *)img->mem->alloc(width, height, depth);
+
+  /* Load a lower resolution version of the image stored in the file if there is one, which
+   * avoids reading and scaling down the full resolution image. Uses the same dimensions as
+   * util_image_resize_pixels, which match the MIP map levels of tiled images. */
+  bool is_loaded = false;
+  if (scale_factor < 1.0f && depth <= 1) {
+    const size_t scaled_width = max((size_t)((float)width * scale_factor), (size_t)1);
+    const size_t scaled_height = max((size_t)((float)height * scale_factor), (size_t)1);
+
+    {
+      thread_scoped_lock device_lock(device_mutex);
+      pixels = (StorageType *)img->mem->alloc(scaled_width, scaled_height, depth);
+    }
+
+    if (pixels &&
+        img->loader->load_pixels_reduced(
+            img->metadata, pixels, scaled_width, scaled_height, image_associate_alpha(img)))
+    {
+      VLOG_WORK << "Loaded image " << img->loader->name() << " at reduced resolution "
+                << scaled_width << "x" << scaled_height << ".";
+      width = scaled_width;
+      height = scaled_height;
+      is_loaded = true;
+    }
+  }
+
+  if (!is_loaded) {
+    /* Allocate memory as needed, may be smaller to resize down. */
+    if (scale_factor < 1.0f) {
+      pixels_storage.resize(((size_t)width) * height * depth * 4);
+      pixels = &pixels_storage[0];
+    }
+    else {
+      thread_scoped_lock device_lock(device_mutex);
+      pixels = (StorageType *)img->mem->alloc(width, height, depth);
+    }
   }
 
   if (pixels == NULL) {
@@ -570,8 +613,10 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  if (!is_loaded) {
+    img->loader->load_pixels(
+        img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  }
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -657,10 +702,6 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
 
   /* Scale image down if needed. */
   if (pixels_storage.size() > 0) {
-    float scale_factor = 1.0f;
-    while (max_size * scale_factor > texture_limit) {
-      scale_factor *= 0.5f;
-    }
     VLOG_WORK << "Scaling image " << img->loader->name() << " by a factor of " << scale_factor
               << ".";
     vector<StorageType> scaled_pixels;
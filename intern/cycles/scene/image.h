@@ -108,6 +108,15 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Optional loading of a lower resolution version of the image with the given dimensions, like
+   * a MIP map level stored in the file. Returns false if no such version exists, in which case the
+   * full resolution image is loaded and scaled down instead. */
+  virtual bool load_pixels_reduced(const ImageMetaData &metadata,
+                                   void *pixels,
+                                   const size_t width,
+                                   const size_t height,
+                                   const bool associate_alpha);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
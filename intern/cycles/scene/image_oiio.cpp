@@ -92,6 +92,7 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 static void oiio_load_pixels(const ImageMetaData &metadata,
                              const unique_ptr<ImageInput> &in,
+                             const int miplevel,
                              const bool associate_alpha,
                              StorageType *pixels)
 {
@@ -111,7 +112,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
   if (depth <= 1) {
     size_t scanlinesize = width * components * sizeof(StorageType);
     in->read_image(0,
-                   0,
+                   miplevel,
                    0,
                    components,
                    FileFormat,
@@ -121,7 +122,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
                    AutoStride);
   }
   else {
-    in->read_image(0, 0, 0, components, FileFormat, (uchar *)readpixels);
+    in->read_image(0, miplevel, 0, components, FileFormat, (uchar *)readpixels);
   }
 
   if (components > 4) {
@@ -168,6 +169,27 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
                                   void *pixels,
                                   const size_t,
                                   const bool associate_alpha)
+{
+  return load_pixels_at_size(metadata, pixels, metadata.width, metadata.height, associate_alpha);
+}
+
+bool OIIOImageLoader::load_pixels_reduced(const ImageMetaData &metadata,
+                                          void *pixels,
+                                          const size_t width,
+                                          const size_t height,
+                                          const bool associate_alpha)
+{
+  if (metadata.depth > 1) {
+    return false;
+  }
+  return load_pixels_at_size(metadata, pixels, width, height, associate_alpha);
+}
+
+bool OIIOImageLoader::load_pixels_at_size(const ImageMetaData &metadata,
+                                          void *pixels,
+                                          const size_t width,
+                                          const size_t height,
+                                          const bool associate_alpha)
 {
   unique_ptr<ImageInput> in = NULL;
 
@@ -216,23 +238,47 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     }
   }
 
+  /* Find the MIP map level with the requested size, tiled files like `.tx` store these. */
+  int miplevel = 0;
+  if (width != metadata.width || height != metadata.height) {
+    ImageSpec level_spec;
+    bool found = false;
+    for (miplevel = 1; in->seek_subimage(0, miplevel, level_spec); miplevel++) {
+      if ((size_t)level_spec.width == width && (size_t)level_spec.height == height) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      in->close();
+      return false;
+    }
+  }
+
+  ImageMetaData level_metadata = metadata;
+  level_metadata.width = width;
+  level_metadata.height = height;
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
-      oiio_load_pixels<TypeDesc::UINT8, uchar>(metadata, in, do_associate_alpha, (uchar *)pixels);
+      oiio_load_pixels<TypeDesc::UINT8, uchar>(
+          level_metadata, in, miplevel, do_associate_alpha, (uchar *)pixels);
       break;
     case IMAGE_DATA_TYPE_USHORT:
     case IMAGE_DATA_TYPE_USHORT4:
       oiio_load_pixels<TypeDesc::USHORT, uint16_t>(
-          metadata, in, do_associate_alpha, (uint16_t *)pixels);
+          level_metadata, in, miplevel, do_associate_alpha, (uint16_t *)pixels);
       break;
     case IMAGE_DATA_TYPE_HALF:
     case IMAGE_DATA_TYPE_HALF4:
-      oiio_load_pixels<TypeDesc::HALF, half>(metadata, in, do_associate_alpha, (half *)pixels);
+      oiio_load_pixels<TypeDesc::HALF, half>(
+          level_metadata, in, miplevel, do_associate_alpha, (half *)pixels);
       break;
     case IMAGE_DATA_TYPE_FLOAT:
     case IMAGE_DATA_TYPE_FLOAT4:
-      oiio_load_pixels<TypeDesc::FLOAT, float>(metadata, in, do_associate_alpha, (float *)pixels);
+      oiio_load_pixels<TypeDesc::FLOAT, float>(
+          level_metadata, in, miplevel, do_associate_alpha, (float *)pixels);
       break;
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT:
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
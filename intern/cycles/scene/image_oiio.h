@@ -21,6 +21,12 @@ class OIIOImageLoader : public ImageLoader {
                    const size_t pixels_size,
                    const bool associate_alpha) override;
 
+  bool load_pixels_reduced(const ImageMetaData &metadata,
+                           void *pixels,
+                           const size_t width,
+                           const size_t height,
+                           const bool associate_alpha) override;
+
   string name() const override;
 
   ustring osl_filepath() const override;
@@ -29,6 +35,14 @@ class OIIOImageLoader : public ImageLoader {
 
  protected:
   ustring filepath;
+
+ private:
+  /* Load pixels of the MIP map level with the given size, fails if there is no such level. */
+  bool load_pixels_at_size(const ImageMetaData &metadata,
+                           void *pixels,
+                           const size_t width,
+                           const size_t height,
+                           const bool associate_alpha);
 };
 
 CCL_NAMESPACE_END
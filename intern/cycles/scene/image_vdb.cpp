@@ -9,6 +9,7 @@
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/tools/Dense.h>
+#  include <openvdb/tools/Prune.h>
 #endif
 #ifdef WITH_NANOVDB
 #  define NANOVDB_USE_OPENVDB
@@ -48,6 +49,14 @@ struct ToNanoOp {
   nanovdb::GridHandle<> nanogrid;
   int precision;
 
+  /* Replace leaf nodes without active voxels by inactive tiles, so that their voxels are not
+   * stored in the NanoVDB grid and uploaded to the device. The grid is a copy made for the
+   * conversion, so the original grid is not modified. */
+  template<typename FloatGridType> static void prune_inactive(FloatGridType &floatgrid)
+  {
+    openvdb::tools::pruneInactive(floatgrid.tree());
+  }
+
   template<typename GridType, typename FloatGridType, typename FloatDataType, int channels>
   bool operator()(const openvdb::GridBase::ConstPtr &grid)
   {
@@ -58,6 +67,7 @@ struct ToNanoOp {
         /* OpenVDB 11. */
         if constexpr (std::is_same_v<FloatGridType, openvdb::FloatGrid>) {
           openvdb::FloatGrid floatgrid(*openvdb::gridConstPtrCast<GridType>(grid));
+          prune_inactive(floatgrid);
           if (precision == 0) {
             nanogrid = nanovdb::createNanoGrid<openvdb::FloatGrid, nanovdb::FpN>(floatgrid);
           }
@@ -70,6 +80,7 @@ struct ToNanoOp {
         }
         else if constexpr (std::is_same_v<FloatGridType, openvdb::Vec3fGrid>) {
           openvdb::Vec3fGrid floatgrid(*openvdb::gridConstPtrCast<GridType>(grid));
+          prune_inactive(floatgrid);
           nanogrid = nanovdb::createNanoGrid<openvdb::Vec3fGrid, nanovdb::Vec3f>(
               floatgrid, nanovdb::StatsMode::Disable);
         }
@@ -77,6 +88,7 @@ struct ToNanoOp {
         /* OpenVDB 10. */
         if constexpr (std::is_same_v<FloatGridType, openvdb::FloatGrid>) {
           openvdb::FloatGrid floatgrid(*openvdb::gridConstPtrCast<GridType>(grid));
+          prune_inactive(floatgrid);
           if (precision == 0) {
             nanogrid =
                 nanovdb::openToNanoVDB<nanovdb::HostBuffer, openvdb::FloatTree, nanovdb::FpN>(
@@ -93,6 +105,7 @@ struct ToNanoOp {
         }
         else if constexpr (std::is_same_v<FloatGridType, openvdb::Vec3fGrid>) {
           openvdb::Vec3fGrid floatgrid(*openvdb::gridConstPtrCast<GridType>(grid));
+          prune_inactive(floatgrid);
           nanogrid = nanovdb::openToNanoVDB(floatgrid);
         }
 #    endif
@@ -140,12 +153,7 @@ bool VDBImageLoader::load_metadata(const ImageDeviceFeatures &features, ImageMet
   /* Set data type. */
 #  ifdef WITH_NANOVDB
   if (features.has_nanovdb) {
-    /* NanoVDB expects no inactive leaf nodes. */
-#    if 0
-    openvdb::FloatGrid &pruned_grid = *openvdb::gridPtrCast<openvdb::FloatGrid>(grid);
-    openvdb::tools::pruneInactive(pruned_grid.tree());
-    nanogrid = nanovdb::openToNanoVDB(pruned_grid);
-#    endif
+    /* NanoVDB expects no inactive leaf nodes, which are pruned by the conversion. */
     ToNanoOp op;
     op.precision = precision;
     if (!openvdb::grid_type_operation(grid, op)) {
@@ -252,12 +252,15 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, int prim_id)
   return false;
 }
 
-void LightTree::add_mesh(Scene *scene, Mesh *mesh, int object_id)
+void LightTree::add_mesh(Scene *scene,
+                         Mesh *mesh,
+                         int object_id,
+                         vector<LightTreeEmitter> &r_emitters)
 {
   size_t mesh_num_triangles = mesh->num_triangles();
   for (size_t i = 0; i < mesh_num_triangles; i++) {
     if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+      r_emitters.emplace_back(scene, i, object_id);
     }
   }
 }
@@ -332,6 +335,7 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
 
   /* Create a node for each mesh light, and keep track of unique mesh lights. */
   std::unordered_map<Mesh *, std::tuple<LightTreeNode *, int, int>> unique_mesh;
+  vector<LightTreeEmitter *> unique_mesh_emitters;
   uint *object_offsets = dscene->object_lookup_offset.alloc(scene->objects.size());
   emitters_.reserve(num_triangles + num_local_lights + num_distant_lights);
   for (LightTreeEmitter &emitter : mesh_lights_) {
@@ -341,11 +345,8 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
 
     auto map_it = unique_mesh.find(mesh);
     if (map_it == unique_mesh.end()) {
-      const int start = emitters_.size();
-      add_mesh(scene, mesh, emitter.object_id);
-      const int end = emitters_.size();
-
-      unique_mesh[mesh] = std::make_tuple(emitter.root.get(), start, end);
+      unique_mesh[mesh] = std::make_tuple(emitter.root.get(), 0, 0);
+      unique_mesh_emitters.push_back(&emitter);
       emitter.root->object_id = emitter.object_id;
     }
     else {
@@ -354,6 +355,30 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
     object_offsets[emitter.object_id] = offset_map_[mesh];
   }
 
+  /* Create the triangle emitters of all unique meshes in parallel, then append them in the order
+   * of the mesh lights so the result does not depend on the scheduling. */
+  vector<vector<LightTreeEmitter>> triangle_emitters(unique_mesh_emitters.size());
+  parallel_for(size_t(0), unique_mesh_emitters.size(), [&](const size_t i) {
+    const int object_id = unique_mesh_emitters[i]->object_id;
+    Mesh *mesh = static_cast<Mesh *>(scene->objects[object_id]->get_geometry());
+    add_mesh(scene, mesh, object_id, triangle_emitters[i]);
+  });
+
+  for (size_t i = 0; i < unique_mesh_emitters.size(); i++) {
+    const int object_id = unique_mesh_emitters[i]->object_id;
+    Mesh *mesh = static_cast<Mesh *>(scene->objects[object_id]->get_geometry());
+
+    const int start = emitters_.size();
+    std::move(triangle_emitters[i].begin(),
+              triangle_emitters[i].end(),
+              std::back_inserter(emitters_));
+    const int end = emitters_.size();
+
+    std::get<1>(unique_mesh[mesh]) = start;
+    std::get<2>(unique_mesh[mesh]) = end;
+  }
+  triangle_emitters.clear();
+
   /* Build a subtree for each unique mesh light. */
   parallel_for_each(unique_mesh, [this](auto &map_it) {
     LightTreeNode *node = std::get<0>(map_it.second);
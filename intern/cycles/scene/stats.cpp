@@ -28,6 +28,12 @@ bool namedTimeEntryComparator(const NamedTimeEntry &a, const NamedTimeEntry &b)
   return a.time > b.time;
 }
 
+bool namedLaunchEntryComparator(const NamedLaunchEntry &a, const NamedLaunchEntry &b)
+{
+  /* We sort in descending order. */
+  return a.work_size > b.work_size;
+}
+
 bool namedTimeSampleEntryComparator(const NamedNestedSampleStats &a,
                                     const NamedNestedSampleStats &b)
 {
@@ -93,6 +99,46 @@ string NamedTimeStats::full_report(int indent_level)
   return result;
 }
 
+/* Named launch statistics. */
+
+NamedLaunchEntry::NamedLaunchEntry() : name(""), launches(0), work_size(0) {}
+
+NamedLaunchEntry::NamedLaunchEntry(const string &name, uint64_t launches, uint64_t work_size)
+    : name(name), launches(launches), work_size(work_size)
+{
+}
+
+NamedLaunchStats::NamedLaunchStats() {}
+
+void NamedLaunchStats::add_entry(const NamedLaunchEntry &entry)
+{
+  foreach (NamedLaunchEntry &existing_entry, entries) {
+    if (existing_entry.name == entry.name) {
+      existing_entry.launches += entry.launches;
+      existing_entry.work_size += entry.work_size;
+      return;
+    }
+  }
+  entries.push_back(entry);
+}
+
+string NamedLaunchStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  sort(entries.begin(), entries.end(), namedLaunchEntryComparator);
+  foreach (const NamedLaunchEntry &entry, entries) {
+    const double average_work_size = double(entry.work_size) / max(entry.launches, uint64_t(1));
+    result += string_printf("%s%-40s %s launches, %s items (%.0f per launch)\n",
+                            indent.c_str(),
+                            entry.name.c_str(),
+                            string_human_readable_number(entry.launches).c_str(),
+                            string_human_readable_number(entry.work_size).c_str(),
+                            average_work_size);
+  }
+  return result;
+}
+
 /* Named time sample statistics. */
 
 NamedNestedSampleStats::NamedNestedSampleStats() : name(""), self_samples(0), sum_samples(0) {}
@@ -227,6 +273,7 @@ string ImageStats::full_report(int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  has_device_kernel_stats = false;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -292,7 +339,11 @@ string RenderStats::full_report()
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
   }
-  else {
+  if (has_device_kernel_stats) {
+    result += "Device kernel time:\n" + device_kernel_time.full_report(1);
+    result += "Device kernel launches:\n" + device_kernel_launches.full_report(1);
+  }
+  if (!has_profiling && !has_device_kernel_stats) {
     result += "Profiling information not available (only works with CPU rendering)";
   }
   return result;
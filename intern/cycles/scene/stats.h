@@ -90,6 +90,32 @@ class NamedTimeStats {
   }
 };
 
+/* Named entry with the number of launches of a device kernel and the sum of their work sizes. */
+class NamedLaunchEntry {
+ public:
+  NamedLaunchEntry();
+  NamedLaunchEntry(const string &name, uint64_t launches, uint64_t work_size);
+
+  string name;
+  uint64_t launches;
+  uint64_t work_size;
+};
+
+/* Container of named launch entries, used to store device kernel launch statistics. Entries
+ * with the same name are accumulated, so that statistics of multiple devices are combined. */
+class NamedLaunchStats {
+ public:
+  NamedLaunchStats();
+
+  /* Add entry to the statistics. */
+  void add_entry(const NamedLaunchEntry &entry);
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  vector<NamedLaunchEntry> entries;
+};
+
 class NamedNestedSampleStats {
  public:
   NamedNestedSampleStats();
@@ -173,12 +199,18 @@ class RenderStats {
   void collect_profiling(Scene *scene, Profiler &prof);
 
   bool has_profiling;
+  bool has_device_kernel_stats;
 
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Kernel statistics of GPU devices. Time is measured for the groups of kernels which were
+   * executed between queue synchronizations. */
+  NamedTimeStats device_kernel_time;
+  NamedLaunchStats device_kernel_launches;
 };
 
 class UpdateTimeStats {
@@ -73,6 +73,11 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
+  /* Clear the node usage flags, so that they only contain the node types used by the current
+   * shaders. Kernels specialized on the scene data then compile out the code of every other node
+   * type, rather than keeping all node types that were ever used in the session. */
+  memset((void *)&dscene->data.svm_usage, 0, sizeof(dscene->data.svm_usage));
+
   /* Build all shaders. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
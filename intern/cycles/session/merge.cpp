@@ -382,93 +382,129 @@ static void merge_channels_metadata(vector<MergeImage> &images, ImageSpec &out_s
   }
 }
 
-static void alloc_pixels(const ImageSpec &spec, array<float> &pixels)
-{
-  const size_t width = spec.width;
-  const size_t height = spec.height;
-  const size_t num_channels = spec.nchannels;
-
-  const size_t num_pixels = width * height;
-  pixels.resize(num_pixels * num_channels);
-}
+/* Number of image rows that are merged at once for images that are not tiled. */
+static const int MERGE_BAND_HEIGHT = 64;
 
+/* Merge the pixels of all images and write them to the output, one band of rows at a time, so
+ * that the memory usage does not depend on the image size. */
 static bool merge_pixels(const vector<MergeImage> &images,
                          const ImageSpec &out_spec,
                          const unordered_map<string, SampleCount> &layer_samples,
-                         array<float> &out_pixels,
+                         ImageOutput *out,
                          string &error)
 {
-  alloc_pixels(out_spec, out_pixels);
-  memset(out_pixels.data(), 0, out_pixels.size() * sizeof(float));
+  const bool is_tiled = (out_spec.tile_width != 0);
+  const int band_height = (is_tiled) ? out_spec.tile_height : MERGE_BAND_HEIGHT;
+  const size_t width = out_spec.width;
 
-  for (const MergeImage &image : images) {
-    /* Read all channels into buffer. Reading all channels at once is
-     * faster than individually due to interleaved EXR channel storage. */
-    array<float> pixels;
-    alloc_pixels(image.in->spec(), pixels);
-    const int num_channels = image.in->spec().nchannels;
-    if (!image.in->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, pixels.data())) {
-      error = "Failed to read image: " + image.filepath;
-      return false;
-    }
+  array<float> out_pixels;
+  array<float> pixels;
+
+  for (int y = 0; y < out_spec.height; y += band_height) {
+    const int num_rows = std::min(band_height, out_spec.height - y);
+    const size_t num_band_pixels = width * num_rows;
+    /* Index of the first pixel of the band in the per-pixel sample counts. */
+    const size_t band_pixel_offset = width * y;
+
+    out_pixels.resize(num_band_pixels * out_spec.nchannels);
+    memset(out_pixels.data(), 0, out_pixels.size() * sizeof(float));
+
+    for (const MergeImage &image : images) {
+      /* Read all channels into buffer. Reading all channels at once is
+       * faster than individually due to interleaved EXR channel storage. */
+      const ImageSpec &in_spec = image.in->spec();
+      const int num_channels = in_spec.nchannels;
+      pixels.resize(num_band_pixels * num_channels);
+      if (!image.in->read_scanlines(0,
+                                    0,
+                                    in_spec.y + y,
+                                    in_spec.y + y + num_rows,
+                                    0,
+                                    0,
+                                    num_channels,
+                                    TypeDesc::FLOAT,
+                                    pixels.data()))
+      {
+        error = "Failed to read image: " + image.filepath;
+        return false;
+      }
 
-    for (const MergeImageLayer &layer : image.layers) {
-      const size_t stride = image.in->spec().nchannels;
-      const size_t out_stride = out_spec.nchannels;
-      const size_t num_pixels = pixels.size();
-
-      for (const MergeImagePass &pass : layer.passes) {
-        size_t offset = pass.offset;
-        size_t out_offset = pass.merge_offset;
-
-        switch (pass.op) {
-          case MERGE_CHANNEL_NOP:
-            break;
-          case MERGE_CHANNEL_COPY:
-            for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
-              out_pixels[out_offset] = pixels[offset];
-            }
-            break;
-          case MERGE_CHANNEL_SUM:
-            for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
-              out_pixels[out_offset] += pixels[offset];
-            }
-            break;
-          case MERGE_CHANNEL_AVERAGE: {
-            /* Weights based on sample count passes and sample metadata. Per channel since not
-             * all files are guaranteed to have the same channels. */
-            size_t sample_pass_offset = layer.sample_pass_offset;
-            const auto &samples = layer_samples.at(layer.name);
-
-            for (size_t i = 0; offset < num_pixels;
-                 offset += stride, sample_pass_offset += stride, out_offset += out_stride, i++)
-            {
-              const float total_samples = samples.per_pixel[i];
-
-              float layer_samples;
-              if (layer.has_sample_pass) {
-                layer_samples = pixels[sample_pass_offset] * layer.samples;
+      for (const MergeImageLayer &layer : image.layers) {
+        const size_t stride = num_channels;
+        const size_t out_stride = out_spec.nchannels;
+        const size_t num_pixels = pixels.size();
+
+        for (const MergeImagePass &pass : layer.passes) {
+          size_t offset = pass.offset;
+          size_t out_offset = pass.merge_offset;
+
+          switch (pass.op) {
+            case MERGE_CHANNEL_NOP:
+              break;
+            case MERGE_CHANNEL_COPY:
+              for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
+                out_pixels[out_offset] = pixels[offset];
               }
-              else {
-                layer_samples = layer.samples;
+              break;
+            case MERGE_CHANNEL_SUM:
+              for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
+                out_pixels[out_offset] += pixels[offset];
               }
-
-              out_pixels[out_offset] += pixels[offset] * (1.0f * layer_samples / total_samples);
+              break;
+            case MERGE_CHANNEL_AVERAGE: {
+              /* Weights based on sample count passes and sample metadata. Per channel since not
+               * all files are guaranteed to have the same channels. */
+              size_t sample_pass_offset = layer.sample_pass_offset;
+              const auto &samples = layer_samples.at(layer.name);
+
+              for (size_t i = band_pixel_offset; offset < num_pixels;
+                   offset += stride, sample_pass_offset += stride, out_offset += out_stride, i++)
+              {
+                const float total_samples = samples.per_pixel[i];
+
+                float layer_samples;
+                if (layer.has_sample_pass) {
+                  layer_samples = pixels[sample_pass_offset] * layer.samples;
+                }
+                else {
+                  layer_samples = layer.samples;
+                }
+
+                out_pixels[out_offset] += pixels[offset] * (1.0f * layer_samples / total_samples);
+              }
+              break;
             }
-            break;
-          }
-          case MERGE_CHANNEL_SAMPLES: {
-            const auto &samples = layer_samples.at(layer.name);
-            for (size_t i = 0; offset < num_pixels;
-                 offset += stride, out_offset += out_stride, i++)
-            {
-              out_pixels[out_offset] = 1.0f * samples.per_pixel[i] / samples.total;
+            case MERGE_CHANNEL_SAMPLES: {
+              const auto &samples = layer_samples.at(layer.name);
+              for (size_t i = band_pixel_offset; offset < num_pixels;
+                   offset += stride, out_offset += out_stride, i++)
+              {
+                out_pixels[out_offset] = 1.0f * samples.per_pixel[i] / samples.total;
+              }
+              break;
             }
-            break;
           }
         }
       }
     }
+
+    /* Write the merged band. */
+    const int ybegin = out_spec.y + y;
+    const int yend = ybegin + num_rows;
+    const bool ok = (is_tiled) ? out->write_tiles(out_spec.x,
+                                                  out_spec.x + out_spec.width,
+                                                  ybegin,
+                                                  yend,
+                                                  0,
+                                                  1,
+                                                  TypeDesc::FLOAT,
+                                                  out_pixels.data()) :
+                                 out->write_scanlines(
+                                     ybegin, yend, 0, TypeDesc::FLOAT, out_pixels.data());
+    if (!ok) {
+      error = "Failed to write merged image: " + out->geterror();
+      return false;
+    }
   }
 
   return true;
@@ -476,7 +512,8 @@ static bool merge_pixels(const vector<MergeImage> &images,
 
 static bool save_output(const string &filepath,
                         const ImageSpec &spec,
-                        const array<float> &pixels,
+                        vector<MergeImage> &images,
+                        const unordered_map<string, SampleCount> &layer_samples,
                         string &error)
 {
   /* Write to temporary file path, so we merge images in place and don't
@@ -491,17 +528,13 @@ static bool save_output(const string &filepath,
     return false;
   }
 
-  /* Open temporary file and write image buffers. */
+  /* Open temporary file and merge image buffers into it. */
   if (!out->open(tmp_filepath, spec)) {
     error = "Failed to open file " + tmp_filepath + " for writing: " + out->geterror();
     return false;
   }
 
-  bool ok = true;
-  if (!out->write_image(TypeDesc::FLOAT, pixels.data())) {
-    error = "Failed to write to file " + tmp_filepath + ": " + out->geterror();
-    ok = false;
-  }
+  bool ok = merge_pixels(images, spec, layer_samples, out.get(), error);
 
   if (!out->close()) {
     error = "Failed to save to file " + tmp_filepath + ": " + out->geterror();
@@ -510,6 +543,10 @@ static bool save_output(const string &filepath,
 
   out.reset();
 
+  /* We don't need input anymore at this point, and will possibly
+   * overwrite the same file. */
+  images.clear();
+
   /* Copy temporary file to output filepath. */
   string rename_error;
   if (ok && !OIIO::Filesystem::rename(tmp_filepath, filepath, rename_error)) {
@@ -597,18 +634,8 @@ bool ImageMerger::run()
   ImageSpec out_spec;
   merge_channels_metadata(images, out_spec);
 
-  /* Merge pixels. */
-  array<float> out_pixels;
-  if (!merge_pixels(images, out_spec, layer_samples, out_pixels, error)) {
-    return false;
-  }
-
-  /* We don't need input anymore at this point, and will possibly
-   * overwrite the same file. */
-  images.clear();
-
-  /* Save output file. */
-  return save_output(output, out_spec, out_pixels, error);
+  /* Merge pixels and save output file. */
+  return save_output(output, out_spec, images, layer_samples, error);
 }
 
 CCL_NAMESPACE_END
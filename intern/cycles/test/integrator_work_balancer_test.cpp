@@ -0,0 +1,60 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(work_balance_do_rebalance, Balanced)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.0;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.5, 1e-6);
+}
+
+TEST(work_balance_do_rebalance, Throughput)
+{
+  /* The second device is three times as fast as the first one. */
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 3.0;
+  infos[1].time_spent = 1.0;
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.25, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.75, 1e-6);
+  EXPECT_EQ(infos[0].time_spent, 0.0);
+  EXPECT_EQ(infos[1].time_spent, 0.0);
+
+  /* With the new weights both devices take the same time, so nothing changes anymore. */
+  infos[0].time_spent = 0.75;
+  infos[1].time_spent = 0.75;
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+}
+
+TEST(work_balance_do_rebalance, NoTimeSpent)
+{
+  vector<WorkBalanceInfo> infos(3);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 2.0;
+  infos[1].time_spent = 1.0;
+  infos[2].time_spent = 0.0;
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  double total_weight = 0.0;
+  for (const WorkBalanceInfo &info : infos) {
+    EXPECT_GT(info.weight, 0.0);
+    total_weight += info.weight;
+  }
+  EXPECT_NEAR(total_weight, 1.0, 1e-6);
+}
+
+CCL_NAMESPACE_END
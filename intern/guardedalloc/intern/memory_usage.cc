@@ -179,6 +179,18 @@ static void update_global_peak()
   }
 }
 
+/**
+ * Add to a counter of #Local. The counters are only modified by their own thread, other threads
+ * only read them. So a plain load and store is enough and avoids the cost of an atomic
+ * read-modify-write instruction for every allocation.
+ */
+static int64_t local_counter_add(std::atomic<int64_t> &counter, const int64_t value)
+{
+  const int64_t new_value = counter.load(std::memory_order_relaxed) + value;
+  counter.store(new_value, std::memory_order_relaxed);
+  return new_value;
+}
+
 void memory_usage_init()
 {
   /* Makes sure that the static and thread-local variables on the main thread are initialized. */
@@ -193,11 +205,13 @@ void memory_usage_block_alloc(const size_t size)
      * cases, because each thread has these counters on a separate cache line. It may only cause
      * synchronization if another thread is computing the total current memory usage at the same
      * time, which is very rare compared to doing allocations. */
-    local.blocks_num.fetch_add(1, std::memory_order_relaxed);
-    local.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    const int64_t mem_in_use = local_counter_add(local.mem_in_use, int64_t(size));
+    local_counter_add(local.blocks_num, 1);
 
     /* If a certain amount of new memory has been allocated, update the peak. */
-    if (local.mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
+    if (mem_in_use - local.mem_in_use_during_peak_update.load(std::memory_order_relaxed) >
+        peak_update_threshold)
+    {
       update_global_peak();
     }
   }
@@ -215,8 +229,8 @@ void memory_usage_block_free(const size_t size)
     /* Decrease local memory counts. See comment in #memory_usage_block_alloc for details regarding
      * thread synchronization. */
     Local &local = get_local_data();
-    local.mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
-    local.blocks_num.fetch_sub(1, std::memory_order_relaxed);
+    local_counter_add(local.mem_in_use, -int64_t(size));
+    local_counter_add(local.blocks_num, -1);
   }
   else {
     Global &global = get_global();
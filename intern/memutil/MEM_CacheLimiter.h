@@ -129,8 +129,10 @@ template<class T> class MEM_CacheLimiter {
   typedef size_t (*MEM_CacheLimiter_DataSize_Func)(void *data);
   typedef int (*MEM_CacheLimiter_ItemPriority_Func)(void *item, int default_priority);
   typedef bool (*MEM_CacheLimiter_ItemDestroyable_Func)(void *item);
+  typedef size_t (*MEM_CacheLimiter_ExternalMemory_Func)(void);
 
-  MEM_CacheLimiter(MEM_CacheLimiter_DataSize_Func data_size_func) : data_size_func(data_size_func)
+  MEM_CacheLimiter(MEM_CacheLimiter_DataSize_Func data_size_func)
+      : data_size_func(data_size_func), external_memory_func(NULL)
   {
   }
 
@@ -189,6 +191,12 @@ template<class T> class MEM_CacheLimiter {
 
     mem_in_use = get_memory_in_use();
 
+    /* Memory of caches which are not managed by this limiter but share its budget. Their items
+     * can not be freed from here, so the own items are freed until the sum fits. */
+    if (external_memory_func) {
+      mem_in_use += external_memory_func();
+    }
+
     if (mem_in_use <= max) {
       return;
     }
@@ -243,6 +251,11 @@ template<class T> class MEM_CacheLimiter {
     this->item_destroyable_func = item_destroyable_func;
   }
 
+  void set_external_memory_func(MEM_CacheLimiter_ExternalMemory_Func external_memory_func)
+  {
+    this->external_memory_func = external_memory_func;
+  }
+
  private:
   typedef MEM_CacheLimiterHandle<T> *MEM_CacheElementPtr;
   typedef std::vector<MEM_CacheElementPtr, MEM_Allocator<MEM_CacheElementPtr>> MEM_CacheQueue;
@@ -312,6 +325,7 @@ template<class T> class MEM_CacheLimiter {
   MEM_CacheLimiter_DataSize_Func data_size_func;
   MEM_CacheLimiter_ItemPriority_Func item_priority_func;
   MEM_CacheLimiter_ItemDestroyable_Func item_destroyable_func;
+  MEM_CacheLimiter_ExternalMemory_Func external_memory_func;
 };
 
 #endif  // __MEM_CACHELIMITER_H__
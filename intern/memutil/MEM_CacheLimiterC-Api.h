@@ -33,6 +33,9 @@ typedef int (*MEM_CacheLimiter_ItemPriority_Func)(void *, int);
 /* function to check whether item could be destroyed */
 typedef bool (*MEM_CacheLimiter_ItemDestroyable_Func)(void *);
 
+/* function used to measure memory of other caches sharing the same memory budget */
+typedef size_t (*MEM_CacheLimiter_ExternalMemory_Func)(void);
+
 #ifndef __MEM_CACHELIMITER_H__
 void MEM_CacheLimiter_set_maximum(size_t m);
 size_t MEM_CacheLimiter_get_maximum(void);
@@ -135,6 +138,13 @@ void MEM_CacheLimiter_ItemPriority_Func_set(MEM_CacheLimiterC *This,
 void MEM_CacheLimiter_ItemDestroyable_Func_set(
     MEM_CacheLimiterC *This, MEM_CacheLimiter_ItemDestroyable_Func item_destroyable_func);
 
+/**
+ * Set function which returns memory used outside of the limiter which is to be counted against
+ * the limit as well, used when several caches share one budget.
+ */
+void MEM_CacheLimiter_ExternalMemory_Func_set(
+    MEM_CacheLimiterC *This, MEM_CacheLimiter_ExternalMemory_Func external_memory_func);
+
 size_t MEM_CacheLimiter_get_memory_in_use(MEM_CacheLimiterC *This);
 
 #ifdef __cplusplus
@@ -240,8 +240,14 @@ def check(module_name):
     :return: (loaded_default, loaded_state)
     :rtype: tuple of booleans
     """
+    return _check(module_name, _preferences.addons)
+
+
+def _check(module_name, addons_enabled):
+    # Implementation of `check`, `addons_enabled` may be any container of enabled module names,
+    # so callers checking many modules can avoid looking them up in the preferences each time.
     import sys
-    loaded_default = module_name in _preferences.addons
+    loaded_default = module_name in addons_enabled
 
     mod = sys.modules.get(module_name)
     loaded_state = (
@@ -544,12 +550,19 @@ def reset_all(*, reload_scripts=False):
     modules._is_first = True
     addons_fake_modules.clear()
 
+    # Checking membership of the preferences collection is a linear search,
+    # avoid doing this for every module found in the add-on paths.
+    addons_enabled = {addon.module for addon in _preferences.addons}
+
     for path, pkg_id in _paths_with_extension_repos():
         if not pkg_id:
             _bpy.utils._sys_path_ensure_append(path)
 
         for mod_name, _mod_path in _bpy.path.module_names(path, package=pkg_id):
-            is_enabled, is_loaded = check(mod_name)
+            is_enabled, is_loaded = _check(mod_name, addons_enabled)
+            if is_loaded and not is_enabled:
+                # Add-ons registered while enabling others may have changed the preferences.
+                is_enabled, is_loaded = check(mod_name)
 
             # first check if reload is needed before changing state.
             if reload_scripts:
@@ -785,6 +785,7 @@ class GreasePencilSimplifyPanel:
         col.prop(rd, "simplify_gpencil_shader_fx")
         col.prop(rd, "simplify_gpencil_tint")
         col.prop(rd, "simplify_gpencil_antialiasing")
+        col.prop(rd, "simplify_gpencil_cull_occluded")
 
 
 class GreasePencilLayerTransformPanel:
@@ -930,6 +930,7 @@ class RENDER_PT_eevee_next_sampling_viewport(RenderButtonsPanel, Panel):
         col.prop(props, "taa_samples", text="Samples")
         col.prop(props, "use_taa_reprojection", text="Temporal Reprojection")
         col.prop(props, "use_shadow_jitter_viewport", text="Jittered Shadows")
+        col.prop(props, "viewport_frame_budget", text="Time Budget")
 
         # Add SSS sample count here.
 
@@ -1150,6 +1151,7 @@ class CompositorPerformanceButtonsPanel:
         row = col.row()
         row.prop(rd, "compositor_device", text="Device", expand=True)
         col.prop(rd, "compositor_precision", text="Precision")
+        col.prop(rd, "compositor_cache_limit", text="Cache Limit")
 
 
 class RENDER_PT_eevee_performance_compositor(RenderButtonsPanel, CompositorPerformanceButtonsPanel, Panel):
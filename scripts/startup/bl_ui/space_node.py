@@ -845,6 +845,7 @@ class NODE_PT_quality(bpy.types.Panel):
         col = layout.column()
         col.prop(rd, "compositor_device", text="Device")
         col.prop(rd, "compositor_precision", text="Precision")
+        col.prop(rd, "compositor_cache_limit", text="Cache Limit")
 
         col = layout.column()
         col.prop(tree, "use_viewer_border")
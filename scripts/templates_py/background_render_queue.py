@@ -0,0 +1,79 @@
+# This script is an example of how you can keep a single blender process running
+# in background mode and use it to render a queue of jobs, instead of starting
+# blender for every job. Jobs are read from the standard input, one per line.
+#
+# Example usage for this script.
+#  blender --background --python $HOME/background_render_queue.py
+#
+# Each job is a line of JSON, for example:
+#  {"file": "/path/to/shot.blend", "frames": [1, 2, 3], "output": "/tmp/shot_"}
+#  {"file": "/path/to/shot.blend", "frames": [4, 5, 6], "output": "/tmp/shot_"}
+#
+# The "frames" and "output" keys are optional, the frame and output path stored
+# in the file are used otherwise. An empty line or end of input stops the worker.
+#
+# For every job a line "done <file>" or "error <file>: <message>" is printed,
+# which can be read back by the process that submits the jobs.
+#
+# Notice:
+# Consecutive jobs for the same file reuse the already loaded file. Together with
+# 'use_persistent_data' this allows render engines that support it to keep their
+# scene data and device state between jobs. Changes made to the file on disk in
+# between such jobs are not picked up.
+
+
+import bpy
+
+
+def load_file(filepath):
+    # Only load the file when it is not the currently open one.
+    if bpy.data.filepath != filepath:
+        bpy.ops.wm.open_mainfile(filepath=filepath)
+
+    scene = bpy.context.scene
+    # Keep render data in memory between renders of this file.
+    scene.render.use_persistent_data = True
+    return scene
+
+
+def render_job(job):
+    scene = load_file(job["file"])
+    render = scene.render
+
+    if "output" in job:
+        render.filepath = job["output"]
+
+    frames = job.get("frames", [scene.frame_current])
+    for frame in frames:
+        scene.frame_set(frame)
+        bpy.ops.render.render(write_still=True)
+
+
+def main():
+    import sys
+    import json
+
+    for line in sys.stdin:
+        line = line.strip()
+        if not line:
+            break
+
+        try:
+            job = json.loads(line)
+        except json.JSONDecodeError as ex:
+            print("error <invalid job>:", ex, flush=True)
+            continue
+
+        try:
+            render_job(job)
+        except Exception as ex:
+            print("error {:s}: {:s}".format(job.get("file", "<no file>"), str(ex)), flush=True)
+            continue
+
+        print("done {:s}".format(job["file"]), flush=True)
+
+    print("render queue finished, exiting")
+
+
+if __name__ == "__main__":
+    main()
@@ -284,7 +284,7 @@ void blf_batch_draw_begin(FontBLF *font)
 
 static GPUTexture *blf_batch_cache_texture_load()
 {
-  GlyphCacheBLF *gc = g_batch.glyph_cache;
+  GlyphAtlasBLF *gc = g_batch.atlas;
   BLI_assert(gc);
   BLI_assert(gc->bitmap_len > 0);
 
@@ -471,7 +471,7 @@ static void blf_font_draw_ex(FontBLF *font,
       continue;
     }
     /* Do not return this loop if clipped, we want every character tested. */
-    blf_glyph_draw(font, gc, g, ft_pix_to_int_floor(pen_x), ft_pix_to_int_floor(pen_y));
+    blf_glyph_draw(font, g, ft_pix_to_int_floor(pen_x), ft_pix_to_int_floor(pen_y));
     pen_x += g->advance_x;
   }
 
@@ -510,7 +510,7 @@ int blf_font_draw_mono(
       continue;
     }
     /* Do not return this loop if clipped, we want every character tested. */
-    blf_glyph_draw(font, gc, g, ft_pix_to_int_floor(pen_x), ft_pix_to_int_floor(pen_y));
+    blf_glyph_draw(font, g, ft_pix_to_int_floor(pen_x), ft_pix_to_int_floor(pen_y));
 
     const int col = UNLIKELY(g->c == '\t') ? (tab_columns - (columns % tab_columns)) :
                                              BLI_wcwidth_safe(char32_t(g->c));
@@ -549,7 +549,7 @@ void blf_draw_svg_icon(
 
   GlyphBLF *g = blf_glyph_ensure_icon(gc, icon_id);
   if (g) {
-    blf_glyph_draw(font, gc, g, 0, 0);
+    blf_glyph_draw(font, g, 0, 0);
   }
 
   if (outline_alpha > 0) {
@@ -8,6 +8,7 @@
  * Glyph rendering, texturing and caching. Wraps Freetype and OpenGL functions.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -150,6 +151,10 @@ void blf_glyph_cache_release(FontBLF *font)
 GlyphCacheBLF::~GlyphCacheBLF()
 {
   this->glyphs.clear_and_shrink();
+}
+
+GlyphAtlasBLF::~GlyphAtlasBLF()
+{
   if (this->texture) {
     GPU_texture_free(this->texture);
   }
@@ -162,6 +167,7 @@ void blf_glyph_cache_clear(FontBLF *font)
 {
   std::lock_guard lock{font->glyph_cache_mutex};
   font->cache.clear_and_shrink();
+  font->atlas.reset();
 }
 
 /**
@@ -1479,44 +1485,51 @@ static void blf_texture_draw(const GlyphBLF *g,
   }
 }
 
-void blf_glyph_draw(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, const int x, const int y)
+void blf_glyph_draw(FontBLF *font, GlyphBLF *g, const int x, const int y)
 {
   if ((!g->dims[0]) || (!g->dims[1])) {
     return;
   }
 
-  if (g->glyph_cache == nullptr) {
+  if (g->atlas == nullptr) {
     if (font->tex_size_max == -1) {
       font->tex_size_max = GPU_max_texture_size();
     }
+    if (font->atlas == nullptr) {
+      font->atlas = std::make_unique<GlyphAtlasBLF>();
+    }
+    GlyphAtlasBLF *atlas = font->atlas.get();
 
-    g->offset = gc->bitmap_len;
+    g->offset = atlas->bitmap_len;
 
     int buff_size = g->dims[0] * g->dims[1] * g->num_channels;
-    int bitmap_len = gc->bitmap_len + buff_size;
+    int bitmap_len = atlas->bitmap_len + buff_size;
 
-    if (bitmap_len > gc->bitmap_len_alloc) {
+    if (bitmap_len > atlas->bitmap_len_alloc) {
       int w = font->tex_size_max;
-      int h = bitmap_len / w + 1;
+      /* Grow by doubling the height, the atlas is shared by all sizes of the font and the texture
+       * is uploaded again when it is reallocated. */
+      int h_prev = atlas->bitmap_len_alloc / w;
+      int h = std::max(bitmap_len / w + 1, std::min(h_prev * 2, font->tex_size_max));
 
-      gc->bitmap_len_alloc = w * h;
-      gc->bitmap_result = static_cast<char *>(
-          MEM_reallocN(gc->bitmap_result, size_t(gc->bitmap_len_alloc)));
+      atlas->bitmap_len_alloc = w * h;
+      atlas->bitmap_result = static_cast<char *>(
+          MEM_reallocN(atlas->bitmap_result, size_t(atlas->bitmap_len_alloc)));
 
       /* Keep in sync with the texture. */
-      if (gc->texture) {
-        GPU_texture_free(gc->texture);
+      if (atlas->texture) {
+        GPU_texture_free(atlas->texture);
       }
-      gc->texture = GPU_texture_create_2d(
+      atlas->texture = GPU_texture_create_2d(
           __func__, w, h, 1, GPU_R8, GPU_TEXTURE_USAGE_SHADER_READ, nullptr);
 
-      gc->bitmap_len_landed = 0;
+      atlas->bitmap_len_landed = 0;
     }
 
-    memcpy(&gc->bitmap_result[gc->bitmap_len], g->bitmap, size_t(buff_size));
-    gc->bitmap_len = bitmap_len;
+    memcpy(&atlas->bitmap_result[atlas->bitmap_len], g->bitmap, size_t(buff_size));
+    atlas->bitmap_len = bitmap_len;
 
-    g->glyph_cache = gc;
+    g->atlas = atlas;
   }
 
   if (font->flags & BLF_CLIPPING) {
@@ -1539,9 +1552,9 @@ void blf_glyph_draw(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, const int x,
     }
   }
 
-  if (g_batch.glyph_cache != g->glyph_cache) {
+  if (g_batch.atlas != g->atlas) {
     blf_batch_draw();
-    g_batch.glyph_cache = g->glyph_cache;
+    g_batch.atlas = g->atlas;
   }
 
   if (font->flags & BLF_SHADOW) {
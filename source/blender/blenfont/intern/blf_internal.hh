@@ -194,7 +194,7 @@ float blf_character_to_curves(FontBLF *font,
                               ListBase *nurbsbase,
                               const float scale);
 
-void blf_glyph_draw(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, int x, int y);
+void blf_glyph_draw(FontBLF *font, GlyphBLF *g, int x, int y);
 
 #ifdef WIN32
 /* `blf_font_win32_compat.cc` */
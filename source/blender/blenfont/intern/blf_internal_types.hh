@@ -94,6 +94,20 @@ inline ft_pix ft_pix_from_float(float v)
 /** A value in the kerning cache that indicates it is not yet set. */
 #define KERNING_ENTRY_UNSET INT_MAX
 
+/**
+ * Texture holding the bitmaps of the glyphs of all the glyph caches of a font, so that text
+ * of different sizes and styles can be drawn in a single batch.
+ */
+struct GlyphAtlasBLF {
+  GPUTexture *texture = nullptr;
+  char *bitmap_result = nullptr;
+  int bitmap_len = 0;
+  int bitmap_len_landed = 0;
+  int bitmap_len_alloc = 0;
+
+  ~GlyphAtlasBLF();
+};
+
 struct BatchBLF {
   /** Can only batch glyph from the same font. */
   FontBLF *font;
@@ -107,7 +121,7 @@ struct BatchBLF {
   /* Previous call `modelmatrix`. */
   float mat[4][4];
   bool enabled, active, simple_shader;
-  GlyphCacheBLF *glyph_cache;
+  GlyphAtlasBLF *atlas;
 };
 
 extern BatchBLF g_batch;
@@ -151,13 +165,6 @@ struct GlyphCacheBLF {
   /** The glyphs. */
   blender::Map<GlyphCacheKey, std::unique_ptr<GlyphBLF>> glyphs;
 
-  /** Texture array, to draw the glyphs. */
-  GPUTexture *texture;
-  char *bitmap_result;
-  int bitmap_len;
-  int bitmap_len_landed;
-  int bitmap_len_alloc;
-
   ~GlyphCacheBLF();
 };
 
@@ -181,7 +188,7 @@ struct GlyphBLF {
   ft_pix lsb_delta;
   ft_pix rsb_delta;
 
-  /** Position inside the texture where this glyph is store. */
+  /** Position inside the atlas texture where this glyph is stored. */
   int offset;
 
   /**
@@ -202,7 +209,8 @@ struct GlyphBLF {
    */
   int pos[2];
 
-  GlyphCacheBLF *glyph_cache;
+  /** Atlas the bitmap was added to, null until the glyph is first drawn. */
+  GlyphAtlasBLF *atlas;
 
   ~GlyphBLF();
 };
@@ -365,6 +373,9 @@ struct FontBLF {
    */
   blender::Vector<std::unique_ptr<GlyphCacheBLF>> cache;
 
+  /** Bitmaps of the glyphs of all caches, freed together with them. */
+  std::unique_ptr<GlyphAtlasBLF> atlas;
+
   /** Cache of unscaled kerning values. Will be NULL if font does not have kerning. */
   KerningCacheBLF *kerning_cache;
 
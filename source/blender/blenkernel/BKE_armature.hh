@@ -8,8 +8,13 @@
  * \ingroup bke
  */
 
+#include <memory>
+#include <optional>
+
+#include "BLI_array.hh"
 #include "BLI_bounds_types.hh"
 #include "BLI_function_ref.hh"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
@@ -690,6 +695,85 @@ void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                                               const char *defgrp_name,
                                               const BMEditMesh *em_target);
 
+namespace blender::bke {
+
+/**
+ * Normalized vertex group weights of a mesh for linear blend skinning. They only depend on the
+ * vertex groups and on which bones deform, so they are reused for as long as only the pose
+ * changes.
+ */
+struct ArmatureDeformWeights {
+  /** Offsets of the weights of every vertex in the arrays below. */
+  Array<int> offsets;
+  /** Vertex group index of every weight. */
+  Array<int> groups;
+  /**
+   * The weights are already divided by the total weight of their vertex and multiplied by the
+   * weight of the modifier's vertex group, like in #BKE_armature_deform_coords_with_mesh.
+   */
+  Array<float> weights;
+  int groups_num = 0;
+
+  /** Used to check if the weights can be reused in the next evaluation. */
+  const ImplicitSharingInfo *dverts_sharing_info = nullptr;
+  int64_t dverts_version = 0;
+  int armature_def_nr = -1;
+  bool invert_vgroup = false;
+  Array<bool> deforming_groups;
+
+  /**
+   * GPU buffers of the weights, owned by the draw code. They are freed with
+   * #armature_deform_free_gpu_cache_cb.
+   */
+  mutable void *gpu_cache = nullptr;
+
+  ArmatureDeformWeights() = default;
+  ArmatureDeformWeights(const ArmatureDeformWeights &other) = delete;
+  ArmatureDeformWeights &operator=(const ArmatureDeformWeights &other) = delete;
+  ~ArmatureDeformWeights();
+};
+
+/**
+ * Armature deformation that is done in the draw code instead of the modifier, which skips the
+ * deformation on the CPU during viewport playback. It is stored on the evaluated mesh, whose
+ * positions are not deformed. Other users of the evaluated mesh get a copy with deformed
+ * positions from #BKE_mesh_wrapper_ensure_subdivision.
+ */
+struct ArmatureGPUDeform {
+  std::shared_ptr<const ArmatureDeformWeights> weights;
+  /** Transform of every vertex group in the local space of the deformed object. */
+  Array<float4x4> group_matrices;
+  /** Bounds of the deformed positions. They are conservative, but usually tight. */
+  std::optional<Bounds<float3>> bounds;
+};
+
+/**
+ * Whether the deformation can be done with #ArmatureGPUDeform. This is the case when only vertex
+ * groups are used, without dual quaternions, B-Bones or envelope multiplication, and when the GPU
+ * backend supports compute shaders.
+ */
+bool armature_deform_supports_gpu(const Object &ob_arm, const Mesh &mesh, int deformflag);
+
+/**
+ * Prepare the deformation of the mesh for the draw code.
+ * \param weights_cache: The weights from the previous evaluation. They are replaced when they
+ * are not valid anymore.
+ */
+std::shared_ptr<const ArmatureGPUDeform> armature_gpu_deform_create(
+    const Object &ob_arm,
+    const Object &ob_target,
+    const Mesh &mesh,
+    int deformflag,
+    const char *defgrp_name,
+    std::shared_ptr<const ArmatureDeformWeights> &weights_cache);
+
+/** Deform the positions on the CPU, with the same result as the draw code. */
+void armature_gpu_deform_positions(const ArmatureGPUDeform &deform, MutableSpan<float3> positions);
+
+extern void (*armature_deform_free_gpu_cache_cb)(void *gpu_cache);
+
+}  // namespace blender::bke
+
 /** \} */
 
 namespace blender::bke {
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "BLI_sub_frame.hh"
 
 #include "BKE_bake_items.hh"
@@ -14,6 +16,7 @@ struct NodesModifierData;
 struct Main;
 struct Object;
 struct Scene;
+struct TaskPool;
 
 namespace blender::bke::bake {
 
@@ -37,6 +40,15 @@ struct FrameCache {
   BakeState state;
   /** Used when the baked data is loaded lazily. */
   std::optional<std::string> meta_path;
+  /**
+   * Lazily loaded frames may be loaded by a prefetch task in the background. The mutex has to be
+   * locked when accessing the #state of such a frame before it has been loaded.
+   */
+  std::mutex load_mutex;
+  /** True when loading the baked data has been attempted, even if it failed. */
+  bool load_attempted = false;
+  /** True when a prefetch task has been started for this frame. */
+  bool prefetch_scheduled = false;
 };
 
 /**
@@ -61,6 +73,14 @@ struct NodeBakeCache {
   std::unique_ptr<BlobReadSharing> blob_sharing;
   /** Used to avoid checking if a bake exists many times. */
   bool failed_finding_bake = false;
+  /**
+   * Loads upcoming lazily loaded frames in the background during playback. Those frames are only
+   * removed by #reset, which waits for the running tasks.
+   */
+  TaskPool *prefetch_pool = nullptr;
+
+  NodeBakeCache() = default;
+  ~NodeBakeCache();
 
   /** Range spanning from the first to the last baked frame. */
   IndexRange frame_range() const;
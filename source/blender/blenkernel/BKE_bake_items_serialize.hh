@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include "BLI_array.hh"
 #include "BLI_fileops.hh"
 #include "BLI_function_ref.hh"
+#include "BLI_mmap.hh"
 #include "BLI_serialize.hh"
 
 #include "BKE_bake_items.hh"
@@ -41,6 +43,14 @@ class BlobReader {
    */
   [[nodiscard]] virtual bool read_as_stream(const BlobSlice &slice,
                                             FunctionRef<bool(std::istream &)> fn) const;
+
+  /**
+   * Get shared access to the data of the slice without copying it into a new buffer. This is only
+   * supported by readers that can reference the stored data directly, e.g. by memory mapping.
+   * \return None if this is not supported for the slice.
+   */
+  [[nodiscard]] virtual std::optional<ImplicitSharingInfoAndData> read_mapped(
+      const BlobSlice &slice) const;
 };
 
 /**
@@ -95,9 +105,38 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    */
   Map<uint64_t, BlobSlice> slice_by_content_hash_;
 
+  /** An array of the last keyframe that later frames can be stored relative to. */
+  struct KeyframeArray {
+    Array<std::byte> data;
+    std::shared_ptr<io::serialize::DictionaryValue> io_data;
+  };
+
+  /** See #BlobWriteSharing(int keyframe_interval). */
+  int keyframe_interval_;
+  int frames_num_ = 0;
+  int next_array_index_ = 0;
+  /** Arrays of the last keyframe by their position in the frame. */
+  Map<int, KeyframeArray> keyframe_arrays_;
+
  public:
+  /**
+   * \param keyframe_interval: When larger than one, only every n-th frame is stored in full. The
+   * arrays of the frames in between are stored as compressed difference to the corresponding
+   * array of the last keyframe when that is smaller. This works well for simulations with a
+   * topology that does not change, because the arrays of consecutive frames are then similar.
+   */
+  BlobWriteSharing(int keyframe_interval = 0);
   ~BlobWriteSharing();
 
+  /** Has to be called before the data of every frame is written. */
+  void begin_frame();
+
+  /**
+   * Get a number that identifies the next array in the current frame. Corresponding arrays of
+   * different frames get the same number as long as the frames have the same structure.
+   */
+  int next_array_index();
+
   /**
    * Check if the data referenced by `sharing_info` has been written before. If yes, return the
    * identifier for the previously written data. Otherwise, write the data now and store the
@@ -115,6 +154,19 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    */
   [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated(
       BlobWriter &writer, const void *data, int64_t size_in_bytes);
+
+  /**
+   * Same as #write_deduplicated, but the array may be stored as difference to the array with the
+   * same index in the last keyframe, see #BlobWriteSharing(int keyframe_interval).
+   * \param word_size: Size of the values that make up the array, e.g. 4 for #float3. Bytes of the
+   * values with the same significance are compressed together.
+   */
+  [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated_delta(
+      BlobWriter &writer,
+      int array_index,
+      const void *data,
+      int64_t size_in_bytes,
+      int64_t word_size);
 };
 
 /**
@@ -152,10 +204,15 @@ class DiskBlobReader : public BlobReader {
   const std::string blobs_dir_;
   mutable std::mutex mutex_;
   mutable Map<std::string, std::unique_ptr<fstream>> open_input_streams_;
+  /** Files that are shared with the loaded data, they stay mapped as long as they are used. */
+  mutable Map<std::string, const MappedFile *> mapped_files_;
 
  public:
   DiskBlobReader(std::string blobs_dir);
+  ~DiskBlobReader();
   [[nodiscard]] bool read(const BlobSlice &slice, void *r_data) const override;
+  [[nodiscard]] std::optional<ImplicitSharingInfoAndData> read_mapped(
+      const BlobSlice &slice) const override;
 };
 
 /**
@@ -170,7 +227,7 @@ class DiskBlobWriter : public BlobWriter {
   std::string blob_name_;
   /** File handle. The file is opened when the first data is written. */
   std::fstream blob_stream_;
-  /** Current position in the file. */
+  /** Current position in the file, including the padding written before arrays. */
   int64_t current_offset_ = 0;
   /** Used to generate file names for bake data that is stored in independent files. */
   int independent_file_count_ = 0;
@@ -17,7 +17,6 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_span.hh"
 
-struct BVHCache;
 struct BVHTree;
 struct MFace;
 struct Mesh;
@@ -113,6 +112,9 @@ BVHTree *bvhtree_from_mesh_corner_tris_ex(BVHTreeFromMesh *data,
 /**
  * Builds or queries a BVH-cache for the cache BVH-tree of the request type.
  *
+ * When only the positions changed since the tree was built, its bounds are updated instead of
+ * building a new tree, as long as the tree isn't shared with other meshes.
+ *
  * \note This function only fills a cache, and therefore the mesh argument can
  * be considered logically const. Concurrent access is protected by a mutex.
  */
@@ -173,15 +175,3 @@ void BKE_bvhtree_from_pointcloud_get(const PointCloud &pointcloud,
 
 void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data);
 
-/**
- * BVHCache
- */
-
-/* Using local coordinates */
-
-bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree);
-BVHCache *bvhcache_init();
-/**
- * Frees a BVH-cache.
- */
-void bvhcache_free(BVHCache *bvh_cache);
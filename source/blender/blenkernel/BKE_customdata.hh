@@ -11,6 +11,7 @@
 
 #include "BLI_cpp_type.hh"
 #include "BLI_implicit_sharing.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_set.hh"
 #include "BLI_span.hh"
 #include "BLI_string_ref.hh"
@@ -436,6 +437,22 @@ void CustomData_interp(const CustomData *source,
                        const float *sub_weights,
                        int count,
                        int dest_index);
+/**
+ * Interpolate many destination elements at once, this is the batched version of
+ * #CustomData_interp. Every layer is processed in a single multi-threaded pass, with typed loops
+ * for the common attribute types.
+ *
+ * \param groups: The source elements of destination element `dest_start + i` are the
+ * `src_indices` in `groups[i]`.
+ * \param weights: The weights of the source elements, with the same size as `src_indices`. When
+ * empty, the source elements are averaged.
+ */
+void CustomData_interp_groups(const CustomData *source,
+                              CustomData *dest,
+                              blender::OffsetIndices<int> groups,
+                              blender::Span<int> src_indices,
+                              blender::Span<float> weights,
+                              int dest_start);
 /**
  * \note src_blocks_ofs & dst_block_ofs
  * must be pointers to the data, offset by layer->offset already.
@@ -9,6 +9,7 @@
  */
 
 #include <iosfwd>
+#include <memory>
 #include <mutex>
 
 #include "BLI_bounds_types.hh"
@@ -32,6 +33,7 @@ class AttributeIDRef;
 struct AttributeKind;
 class AttributeAccessor;
 struct AttributeMetaData;
+class CapturedFieldsCache;
 class ComponentAttributeProviders;
 class CurvesEditHints;
 class Instances;
@@ -83,6 +85,13 @@ class GeometryComponent : public ImplicitSharingMixin {
   Type type_;
 
  public:
+  /**
+   * Results of capturing fields on this component, which can be reused when the same fields are
+   * captured again while the data they depend on is unchanged. See
+   * #try_capture_fields_on_geometry. The cache is not copied with the component.
+   */
+  std::shared_ptr<CapturedFieldsCache> captured_fields_cache;
+
   GeometryComponent(Type type);
   virtual ~GeometryComponent() = default;
   static GeometryComponentPtr create(Type component_type);
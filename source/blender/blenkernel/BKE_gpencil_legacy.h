@@ -51,6 +51,8 @@ struct bGPdata;
   (GPENCIL_SIMPLIFY(scene) && (scene->r.simplify_gpencil & SIMPLIFY_GPENCIL_TINT))
 #define GPENCIL_SIMPLIFY_AA(scene) \
   (GPENCIL_SIMPLIFY(scene) && (scene->r.simplify_gpencil & SIMPLIFY_GPENCIL_AA))
+#define GPENCIL_SIMPLIFY_CULL_OCCLUDED(scene) \
+  (GPENCIL_SIMPLIFY(scene) && (scene->r.simplify_gpencil & SIMPLIFY_GPENCIL_CULL_OCCLUDED))
 
 /* Vertex Color macros. */
 #define GPENCIL_USE_VERTEX_COLOR(toolsettings) \
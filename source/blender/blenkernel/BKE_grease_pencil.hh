@@ -10,8 +10,10 @@
  */
 
 #include <atomic>
+#include <mutex>
 
 #include "BLI_array_utils.hh"
+#include "BLI_bounds_types.hh"
 #include "BLI_color.hh"
 #include "BLI_function_ref.hh"
 #include "BLI_implicit_sharing_ptr.hh"
@@ -19,6 +21,7 @@
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_shared_cache.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_utility_mixins.hh"
 #include "BLI_virtual_array.hh"
 
@@ -63,6 +66,11 @@ class DrawingRuntime {
    */
   mutable SharedCache<Vector<float4x2>> curve_texture_matrices;
 
+  /**
+   * Bounding box of every stroke, in layer space.
+   */
+  mutable SharedCache<Vector<Bounds<float3>>> curve_bounds_cache;
+
   /**
    * Number of users for this drawing. The users are the frames in the Grease Pencil layers.
    * Different frames can refer to the same drawing, so we need to make sure we count these users
@@ -75,6 +83,34 @@ class DrawingRuntime {
    */
   mutable Array<GPStrokePoint> points_2d;
   mutable Array<OndineRenderStroke> render_strokes;
+  /**
+   * Ondine: Compact variant of #points_2d, only computed for objects with
+   * #GP_ONDINE_COMPACT_POINTS, empty otherwise.
+   */
+  mutable Array<GPStrokePointCompact> points_2d_compact;
+  /**
+   * Ondine: Stroke indices ordered back to front by their distance to the camera. Only computed
+   * for objects rendered with true depth, empty otherwise.
+   */
+  mutable Array<int> render_stroke_order;
+
+  /**
+   * Ondine: Change stamp of the stroke geometry. A new, globally unique stamp is assigned
+   * every time write access to the strokes is requested, so data derived from the geometry can
+   * detect that it is outdated. Copies of a drawing keep the stamp of their source.
+   */
+  uint64_t geometry_stamp = 0;
+  /**
+   * Ondine: Hash of all the inputs (geometry stamp, transforms, camera, materials) that were
+   * used to compute #points_2d and #render_strokes. Zero when no render data was computed.
+   */
+  mutable uint64_t render_data_hash = 0;
+
+  /**
+   * Vertex and index data of the drawing, built and used by the draw module. Opaque here, and
+   * shared between copies of the drawing, so it survives re-evaluation of the grease pencil data.
+   */
+  mutable ImplicitSharingPtr<ImplicitSharingInfo> batch_data;
 };
 
 class Drawing : public ::GreasePencilDrawing {
@@ -96,6 +132,10 @@ class Drawing : public ::GreasePencilDrawing {
    * Normal vectors for a plane that fits the stroke.
    */
   Span<float3> curve_plane_normals() const;
+  /**
+   * Bounding boxes of the strokes, in layer space.
+   */
+  Span<Bounds<float3>> curve_bounds() const;
   void tag_texture_matrices_changed();
   void tag_positions_changed();
   void tag_topology_changed();
@@ -145,7 +185,13 @@ class Drawing : public ::GreasePencilDrawing {
    */
   VArray<int> seeds() const;
   MutableSpan<int> seeds_for_write();
-  void ensure_unique_seeds();
+  /**
+   * Give strokes without a seed, or with a seed already used by an earlier stroke, a new seed.
+   * New seeds are derived from the stroke index plus \a seed_offset, so the result is
+   * deterministic. Unique seeds are kept and the geometry is left untouched when all seeds are
+   * unique already.
+   */
+  void ensure_unique_seeds(int seed_offset = 0);
   void create_instance_seeds();
 
   /**
@@ -855,6 +901,50 @@ inline LayerGroup &Layer::parent_group()
 
 TREENODE_COMMON_METHODS_FORWARD_IMPL(LayerGroup);
 
+/**
+ * Ondine: identifies the result of the drawing modifiers for one layer. The geometry stamp is the
+ * one of the drawing shown after the time modifiers, so held frames and looped time offsets map
+ * to the same key.
+ */
+struct EvalDrawingCacheKey {
+  int layer_index;
+  uint64_t geometry_stamp;
+  /** Hash of the type and settings of all the enabled drawing modifiers. */
+  uint64_t modifiers_hash;
+
+  uint64_t hash() const
+  {
+    return get_default_hash(this->layer_index, this->geometry_stamp, this->modifiers_hash);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_3(EvalDrawingCacheKey,
+                                  layer_index,
+                                  geometry_stamp,
+                                  modifiers_hash)
+};
+
+/**
+ * Ondine: evaluated drawings of previous frames, so that playback doesn't evaluate the drawing
+ * modifiers again for drawings it already evaluated. The cached drawings share their geometry
+ * with the evaluated data through implicit sharing. Only used when the result of the modifier
+ * stack doesn't depend on the frame or on other objects.
+ */
+class EvalDrawingCache {
+ public:
+  /** Maximum number of cached drawings, the least recently used ones are removed first. */
+  static constexpr int max_size = 256;
+
+  struct Item {
+    Drawing drawing;
+    /** Value of #use_counter when the item was last used. */
+    uint64_t last_use;
+  };
+
+  std::mutex mutex;
+  Map<EvalDrawingCacheKey, std::unique_ptr<Item>> items;
+  uint64_t use_counter = 0;
+};
+
 }  // namespace greasepencil
 
 class GreasePencilRuntime {
@@ -874,6 +964,11 @@ class GreasePencilRuntime {
   bool is_drawing_stroke = false;
   /* Ondine: z-depth of object. */
   float render_zdepth;
+  /**
+   * Ondine: evaluated drawings of previous frames. Only used on the evaluated copy of the original
+   * data-block, which is kept when only the frame changes.
+   */
+  std::unique_ptr<greasepencil::EvalDrawingCache> eval_drawing_cache;
 
  public:
   GreasePencilRuntime() {}
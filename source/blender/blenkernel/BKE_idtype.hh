@@ -238,6 +238,10 @@ struct IDTypeInfo {
    *
    * \note Called from #setup_app_data when undoing or redoing a memfile step.
    *
+   * \note For IDs that changed and were read again at their old address, `id_old` still has the
+   * previous content, so runtime data like derived caches can be moved over when the data they
+   * depend on is unchanged. For unchanged IDs, `id_new` and `id_old` can be the same.
+   *
    * \note In case the whole ID should be fully preserved across undo steps, it is better to flag
    * its type with `IDTYPE_FLAGS_NO_MEMFILE_UNDO`, since that flag allows more aggressive
    * optimizations in readfile code for memfile undo.
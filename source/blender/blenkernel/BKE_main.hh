@@ -161,6 +161,13 @@ struct Main {
    * instead do a complete full re-read/update from stored memfile.
    */
   bool use_memfile_full_barrier;
+  /**
+   * All IDs are stored at their current address in the last memfile undo step, and all changes
+   * since then have been tagged. This allows the next step to skip writing unchanged IDs. It is
+   * not the case after an undo step has been loaded, because IDs that were allocated again
+   * change pointers in other IDs that are not tagged.
+   */
+  bool is_memfile_undo_id_skip_allowed;
 
   /**
    * When linking, disallow creation of new data-blocks.
@@ -502,9 +502,16 @@ void BKE_mesh_eval_geometry(Depsgraph *depsgraph, Mesh *mesh);
 /* Draw Cache */
 void BKE_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode);
 void BKE_mesh_batch_cache_free(void *batch_cache);
+/**
+ * Remove the batch cache from a mesh that is about to be freed, so that the GPU buffers can be
+ * reused for the next evaluated mesh. Returns null when the cache can't be reused, it's then freed
+ * with the mesh.
+ */
+void *BKE_mesh_batch_cache_take_for_reuse(Mesh *mesh);
 
 extern void (*BKE_mesh_batch_cache_dirty_tag_cb)(Mesh *mesh, eMeshBatchDirtyMode mode);
 extern void (*BKE_mesh_batch_cache_free_cb)(void *batch_cache);
+extern void *(*BKE_mesh_batch_cache_take_for_reuse_cb)(Mesh *mesh);
 
 /* `mesh_debug.cc` */
 
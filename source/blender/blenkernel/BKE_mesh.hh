@@ -372,4 +372,7 @@ void mesh_data_update(Depsgraph &depsgraph,
                       Object &ob,
                       const CustomData_MeshMasks &dataMask);
 
+/** Free the cached state of the modifier stack of an evaluated mesh object. */
+void mesh_modifier_stack_cache_free(Object &ob);
+
 }  // namespace blender::bke
@@ -8,6 +8,7 @@
  * \ingroup bke
  */
 
+#include <array>
 #include <memory>
 #include <mutex>
 
@@ -21,13 +22,15 @@
 
 #include "DNA_customdata_types.h"
 
+#include "BKE_bvhutils.hh"
+
 struct BMEditMesh;
-struct BVHCache;
 struct Mesh;
 class ShrinkwrapBoundaryData;
 struct SubdivCCG;
 struct SubsurfRuntimeData;
 namespace blender::bke {
+struct ArmatureGPUDeform;
 struct EditMeshData;
 }
 namespace blender::bke::bake {
@@ -107,6 +110,13 @@ struct TrianglesCache {
   void tag_dirty();
 };
 
+/** Frees a #BVHTree, so that it can be owned by a #std::unique_ptr. */
+struct BVHTreeDeleter {
+  void operator()(BVHTree *tree);
+};
+
+using BVHTreePtr = std::unique_ptr<BVHTree, BVHTreeDeleter>;
+
 struct MeshRuntime {
   /**
    * "Evaluated" mesh owned by this mesh. Used for objects which don't have effective modifiers, so
@@ -158,17 +168,22 @@ struct MeshRuntime {
   /** Cache for triangle to original face index map, accessed with #Mesh::corner_tri_faces(). */
   SharedCache<Array<int>> corner_tri_faces_cache;
 
-  /** Cache for BVH trees generated for the mesh. Defined in 'BKE_bvhutil.c' */
-  BVHCache *bvh_cache = nullptr;
+  /**
+   * Caches for BVH trees generated for the mesh, indexed by #BVHCacheType. Like the other shared
+   * caches, they are shared with copies of the mesh until the positions or the topology change.
+   * See #BKE_bvhtree_from_mesh_get.
+   */
+  std::array<SharedCache<BVHTreePtr>, BVHTREE_MAX_ITEM> bvh_caches;
 
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra = {};
 
   /**
    * Grids representation for multi-resolution sculpting. When this is set, the mesh will be empty,
-   * since it is conceptually replaced with the limited data stored in the grids.
+   * since it is conceptually replaced with the limited data stored in the grids. The multires
+   * modifier keeps a reference to reuse the grids in the next evaluation.
    */
-  std::unique_ptr<SubdivCCG> subdiv_ccg;
+  std::shared_ptr<SubdivCCG> subdiv_ccg;
   int subdiv_ccg_tot_level = 0;
 
   /** Set by modifier stack if only deformed from original. */
@@ -192,6 +207,12 @@ struct MeshRuntime {
    */
   SubsurfRuntimeData *subsurf_runtime_data = nullptr;
 
+  /**
+   * Armature deformation that is done by the draw code. The positions of the mesh are not
+   * deformed when this is set, see #ArmatureGPUDeform.
+   */
+  std::shared_ptr<const ArmatureGPUDeform> armature_gpu_deform;
+
   /** Lazily computed vertex normals (#Mesh::vert_normals()). */
   SharedCache<Vector<float3>> vert_normals_cache;
   /** Lazily computed face normals (#Mesh::face_normals()). */
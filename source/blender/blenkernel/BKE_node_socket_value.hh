@@ -126,6 +126,12 @@ class SocketValueVariant {
    */
   bool is_volume_grid() const;
 
+  /**
+   * True if both variants contain the same single value or equal fields. Grids are never
+   * considered to be equal.
+   */
+  bool is_equal_to(const SocketValueVariant &other) const;
+
   /**
    * Convert the stored value into a single value. For simple value access, this is not necessary,
    * because #get` does the conversion implicitly. However, it is necessary if one wants to use
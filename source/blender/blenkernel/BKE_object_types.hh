@@ -23,6 +23,7 @@ struct PoseBackup;
 namespace blender::bke {
 
 struct GeometrySet;
+struct ModifierStackCache;
 
 struct ObjectRuntime {
   /** Final transformation matrices with constraints & animsys applied. */
@@ -90,6 +91,19 @@ struct ObjectRuntime {
    */
   Mesh *mesh_deform_eval = nullptr;
 
+  /**
+   * State of the modifier stack right before the modifier that changed last, so that changing
+   * that modifier again doesn't evaluate the modifiers before it. Unlike the other evaluated data
+   * it is kept when the derived caches are freed, see #mesh_modifier_stack_cache_free.
+   */
+  ModifierStackCache *modifier_stack_cache = nullptr;
+
+  /**
+   * Draw cache of the last freed evaluated mesh. The draw code reuses the GPU buffers whose source
+   * data is the same in the next evaluated mesh, see #BKE_mesh_batch_cache_take_for_reuse.
+   */
+  void *mesh_batch_cache_prev = nullptr;
+
   /**
    * Evaluated mesh cage in edit mode.
    *
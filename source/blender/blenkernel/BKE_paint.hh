@@ -323,6 +323,19 @@ struct SculptBoundaryEditInfo {
   float strength_factor;
 };
 
+/**
+ * Geodesic distances calculated by sculpt tools, reused while the mesh doesn't change. Topology
+ * changes clear the cache explicitly, changes of the positions or the visibility are detected by
+ * comparing a hash of them.
+ */
+struct SculptGeodesicCacheEntry {
+  /* Sorted indices of the vertices the distances are measured from. */
+  blender::Vector<int> initial_verts;
+  float limit_radius;
+  uint32_t state_hash;
+  blender::Array<float> distances;
+};
+
 /* Edge for drawing the boundary preview in the cursor. */
 struct SculptBoundaryPreviewEdge {
   PBVHVertRef v1;
@@ -512,6 +525,9 @@ struct SculptSession : blender::NonCopyable, blender::NonMovable {
   blender::Array<int> vert_to_edge_indices;
   blender::GroupedSpan<int> vert_to_edge_map;
 
+  /* Recently calculated geodesic distances, the most recently used one is last. */
+  blender::Vector<SculptGeodesicCacheEntry> geodesic_cache;
+
   /* Mesh Face Sets */
   /* Total number of faces of the base mesh. */
   int totfaces = 0;
@@ -42,8 +42,17 @@ enum PBVHNodeFlags {
   PBVH_TexLeaf = 1 << 16,
   /** Used internally by `pbvh_bmesh.cc`. */
   PBVH_TopologyUpdated = 1 << 17,
+
+  /**
+   * Only some of the node's data changed, so only the draw buffers that use it have to be
+   * updated. #PBVH_UpdateDrawBuffers updates all of them.
+   */
+  PBVH_UpdateDrawPositions = 1 << 18,
+  PBVH_UpdateDrawMask = 1 << 19,
+  PBVH_UpdateDrawFaceSets = 1 << 20,
+  PBVH_UpdateDrawAttributes = 1 << 21,
 };
-ENUM_OPERATORS(PBVHNodeFlags, PBVH_TopologyUpdated);
+ENUM_OPERATORS(PBVHNodeFlags, PBVH_UpdateDrawAttributes);
 
 /* A few C++ methods to play nice with sets and maps. */
 #define PBVH_REF_CXX_METHODS(Class) \
@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "BLI_compiler_compat.h"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_sys_types.h"
+#include "BLI_vector.hh"
 
 struct Mesh;
 struct MultiresModifierData;
@@ -167,6 +171,18 @@ struct Subdiv {
   /* Statistics for debugging. */
   SubdivStats stats;
 
+  /* Implicitly shared arrays of the mesh the topology refiner was created from. When the next mesh
+   * shares the same arrays, like a deformed mesh of an animated character does, the refiner is
+   * reused without comparing the topology. A user of every array is kept, so that modifying one
+   * of them always makes a copy. */
+  blender::Vector<blender::ImplicitSharingPtr<blender::ImplicitSharingInfo>> mesh_topology_sharing;
+  int mesh_verts_num;
+
+  /* Draw buffers that only depend on the topology, owned by the draw code. They are kept here so
+   * that the draw cache of the next mesh with the same topology can reuse them, which avoids
+   * rebuilding them in every frame of an animation. */
+  std::shared_ptr<void> draw_cache;
+
   /* Cached values, are not supposed to be accessed directly. */
   struct {
     /* Indexed by base face index, element indicates total number of ptex
@@ -196,6 +196,18 @@ Mesh *BKE_subdiv_to_ccg_mesh(blender::bke::subdiv::Subdiv &subdiv,
                              const SubdivToCCGSettings &settings,
                              const Mesh &coarse_mesh);
 
+/**
+ * Update grids that were created from a mesh with the same topology for new positions of the
+ * coarse mesh. Only the grids whose limit surface depends on one of the changed vertices are
+ * evaluated again, which are the grids of faces that share a vertex with a face that uses a
+ * changed vertex. Displacement and mask are expected to be unchanged.
+ *
+ * NOTE: The displacement evaluator of the subdiv is expected to be attached for the mesh.
+ */
+bool BKE_subdiv_ccg_update_from_mesh(SubdivCCG &subdiv_ccg,
+                                     const Mesh &coarse_mesh,
+                                     const blender::IndexMask &changed_verts);
+
 /* Create a key for accessing grid elements at a given level. */
 CCGKey BKE_subdiv_ccg_key(const SubdivCCG &subdiv_ccg, int level);
 CCGKey BKE_subdiv_ccg_key_top_level(const SubdivCCG &subdiv_ccg);
@@ -70,4 +70,11 @@ auto BKE_volume_grid_type_operation(const VolumeGridType grid_type, OpType &&op)
 openvdb::GridBase::Ptr BKE_volume_grid_create_with_changed_resolution(
     const VolumeGridType grid_type, const openvdb::GridBase &old_grid, float resolution_factor);
 
+/**
+ * Change the transform of a grid in the same way as
+ * #BKE_volume_grid_create_with_changed_resolution does, without having to resample the tree.
+ */
+void BKE_volume_grid_transform_change_resolution(openvdb::math::Transform &transform,
+                                                 float resolution_factor);
+
 #endif
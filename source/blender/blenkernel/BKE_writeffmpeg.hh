@@ -81,6 +81,17 @@ void BKE_ffmpeg_exit();
  */
 SwsContext *BKE_ffmpeg_sws_get_context(
     int width, int height, int av_src_format, int av_dst_format, int sws_flags);
+/**
+ * Same as above, but for a context that also scales the image from the source to the
+ * destination size.
+ */
+SwsContext *BKE_ffmpeg_sws_get_context(int src_width,
+                                       int src_height,
+                                       int av_src_format,
+                                       int dst_width,
+                                       int dst_height,
+                                       int av_dst_format,
+                                       int sws_flags);
 void BKE_ffmpeg_sws_release_context(SwsContext *ctx);
 
 void BKE_ffmpeg_sws_scale_frame(SwsContext *ctx, AVFrame *dst, const AVFrame *src);
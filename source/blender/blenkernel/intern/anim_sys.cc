@@ -387,6 +387,46 @@ bool BKE_animsys_rna_path_resolve(
   return true;
 }
 
+/**
+ * The property resolved for the last F-Curve by #animsys_rna_path_resolve_cached. Consecutive
+ * F-Curves typically animate the items of the same array property (e.g. `location[0]` to
+ * `location[2]`), so this avoids parsing and resolving the same RNA path for every item.
+ */
+struct AnimsysPathResolveCache {
+  const char *rna_path = nullptr;
+  PathResolvedRNA anim_rna;
+  int array_len = 0;
+};
+
+/**
+ * Same as #BKE_animsys_rna_path_resolve, reusing the cached property if the RNA path of the F-Curve
+ * is the same as last time. The cache is expected to be used with the same `ptr` every time.
+ */
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            const FCurve *fcu,
+                                            AnimsysPathResolveCache &cache,
+                                            PathResolvedRNA *r_result)
+{
+  if (cache.rna_path != nullptr && fcu->rna_path != nullptr &&
+      STREQ(cache.rna_path, fcu->rna_path))
+  {
+    if (cache.array_len == 0 || fcu->array_index < cache.array_len) {
+      *r_result = cache.anim_rna;
+      r_result->prop_index = cache.array_len ? fcu->array_index : -1;
+      return true;
+    }
+  }
+
+  cache.rna_path = nullptr;
+  if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, r_result)) {
+    return false;
+  }
+  cache.rna_path = fcu->rna_path;
+  cache.anim_rna = *r_result;
+  cache.array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  return true;
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -565,6 +605,13 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+  AnimsysPathResolveCache path_cache;
+  AnimsysPathResolveCache orig_path_cache;
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -573,11 +620,14 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(ptr, fcu, path_cache, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        PathResolvedRNA orig_anim_rna;
+        if (animsys_rna_path_resolve_cached(&ptr_orig, fcu, orig_path_cache, &orig_anim_rna)) {
+          BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
+        }
       }
     }
   }
@@ -856,6 +906,8 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  AnimsysPathResolveCache path_cache;
+
   /* calculate then execute each curve */
   for (fcu = static_cast<FCurve *>(agrp->channels.first); (fcu) && (fcu->grp == agrp);
        fcu = fcu->next)
@@ -863,7 +915,7 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_cached(ptr, fcu, path_cache, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
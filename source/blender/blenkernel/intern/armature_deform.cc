@@ -17,11 +17,18 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_bounds.hh"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_simd.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -43,6 +50,9 @@
 
 #include "DEG_depsgraph_build.hh"
 
+#include "GPU_capabilities.hh"
+#include "GPU_context.hh"
+
 #include "CLG_log.h"
 
 static CLG_LogRef LOG = {"bke.armature_deform"};
@@ -227,6 +237,84 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
   (*contrib) += weight;
 }
 
+/**
+ * Whether the deformation of the bone is defined by its channel matrix alone, so that it can be
+ * accumulated with #BlendedBoneMatrix.
+ */
+static bool pchan_deform_is_linear(const bPoseChannel *pchan)
+{
+  const Bone *bone = pchan->bone;
+  if (bone->flag & BONE_MULT_VG_ENV) {
+    return false;
+  }
+  return !(bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments);
+}
+
+/**
+ * Sum of weighted bone matrices for linear blend skinning. Blending the matrices and transforming
+ * the coordinate once is cheaper than transforming the coordinate by every bone separately, and
+ * the matrix columns are blended with SIMD instructions. The result is the same as accumulating
+ * with #pchan_deform_accumulate, apart from floating point precision.
+ */
+struct BlendedBoneMatrix {
+#if BLI_HAVE_SSE2
+  __m128 columns[4];
+#else
+  float columns[4][4];
+#endif
+  float weight;
+
+  BlendedBoneMatrix()
+  {
+#if BLI_HAVE_SSE2
+    for (__m128 &column : columns) {
+      column = _mm_setzero_ps();
+    }
+#else
+    zero_m4(columns);
+#endif
+    weight = 0.0f;
+  }
+
+  void add(const float mat[4][4], const float mat_weight)
+  {
+#if BLI_HAVE_SSE2
+    const __m128 weight_4 = _mm_set1_ps(mat_weight);
+    for (const int i : blender::IndexRange(4)) {
+      columns[i] = _mm_add_ps(columns[i], _mm_mul_ps(_mm_loadu_ps(mat[i]), weight_4));
+    }
+#else
+    for (const int i : blender::IndexRange(4)) {
+      madd_v4_v4fl(columns[i], mat[i], mat_weight);
+    }
+#endif
+    weight += mat_weight;
+  }
+
+  /** Add the result to the accumulated values used by #armature_vert_task_with_dvert. */
+  void accumulate(const float co[3], float co_accum[3], float mat_accum[3][3]) const
+  {
+    float blended[4][4];
+#if BLI_HAVE_SSE2
+    for (const int i : blender::IndexRange(4)) {
+      _mm_storeu_ps(blended[i], columns[i]);
+    }
+#else
+    copy_m4_m4(blended, columns);
+#endif
+    float tmp[3];
+    mul_v3_m4v3(tmp, blended, co);
+    madd_v3_v3fl(tmp, co, -weight);
+    add_v3_v3(co_accum, tmp);
+
+    if (mat_accum) {
+      float tmpmat[3][3];
+      copy_m3_m4(tmpmat, blended);
+      add_m3_m3m3(mat_accum, mat_accum, tmpmat);
+    }
+  }
+};
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -342,6 +430,8 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     uint j;
+    /* Dual quaternions are not blended linearly, they always use #pchan_deform_accumulate. */
+    BlendedBoneMatrix blended_mat;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
       if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
@@ -350,6 +440,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
         deformed = 1;
 
+        if (!use_quaternion && pchan_deform_is_linear(pchan)) {
+          if (weight != 0.0f) {
+            blended_mat.add(pchan->chan_mat, weight);
+            contrib += weight;
+          }
+          continue;
+        }
+
         if (bone && bone->flag & BONE_MULT_VG_ENV) {
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
@@ -358,6 +456,9 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
         pchan_bone_deform(pchan, weight, vec, dq, smat, co, full_deform, &contrib);
       }
     }
+    if (blended_mat.weight != 0.0f) {
+      blended_mat.accumulate(co, vec, smat);
+    }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
       for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
@@ -727,3 +828,289 @@ void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Armature Deform in the Draw Code
+ *
+ * The deformation is split into the weights, which are the same in every frame, and the bone
+ * matrices of the current pose.
+ * \{ */
+
+namespace blender::bke {
+
+void (*armature_deform_free_gpu_cache_cb)(void *gpu_cache) = nullptr;
+
+ArmatureDeformWeights::~ArmatureDeformWeights()
+{
+  if (gpu_cache != nullptr && armature_deform_free_gpu_cache_cb != nullptr) {
+    armature_deform_free_gpu_cache_cb(gpu_cache);
+  }
+  if (dverts_sharing_info != nullptr) {
+    dverts_sharing_info->remove_weak_user_and_delete_if_last();
+  }
+}
+
+/** The pose channel of every vertex group, or null when the group does not deform the mesh. */
+static Array<const bPoseChannel *> get_pchan_from_defbase(const Object &ob_arm, const Mesh &mesh)
+{
+  const ListBase *defbase = BKE_id_defgroup_list_get(&mesh.id);
+  Array<const bPoseChannel *> pchans(BLI_listbase_count(defbase));
+  int i;
+  LISTBASE_FOREACH_INDEX (const bDeformGroup *, dg, defbase, i) {
+    const bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm.pose, dg->name);
+    pchans[i] = (pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) ? pchan : nullptr;
+  }
+  return pchans;
+}
+
+bool armature_deform_supports_gpu(const Object &ob_arm, const Mesh &mesh, const int deformflag)
+{
+  /* The vertex buffers are deformed with compute shaders. Like GPU subdivision, this is only
+   * implemented for OpenGL. */
+  if (GPU_backend_get_type() != GPU_BACKEND_OPENGL ||
+      GPU_max_compute_shader_storage_blocks() < 7)
+  {
+    return false;
+  }
+  if ((deformflag & ARM_DEF_VGROUP) == 0 ||
+      (deformflag & (ARM_DEF_ENVELOPE | ARM_DEF_QUATERNION)) != 0)
+  {
+    return false;
+  }
+  if (ob_arm.pose == nullptr || (ob_arm.pose->flag & POSE_RECALC) != 0) {
+    return false;
+  }
+  if (mesh.deform_verts().is_empty()) {
+    return false;
+  }
+  for (const bPoseChannel *pchan : get_pchan_from_defbase(ob_arm, mesh)) {
+    if (pchan != nullptr && !pchan_deform_is_linear(pchan)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static const ImplicitSharingInfo *get_dverts_sharing_info(const Mesh &mesh)
+{
+  const int layer_index = CustomData_get_layer_index(&mesh.vert_data, CD_MDEFORMVERT);
+  return layer_index == -1 ? nullptr : mesh.vert_data.layers[layer_index].sharing_info;
+}
+
+/** Same as the weight of a vertex in #armature_vert_task_with_dvert. */
+static float vert_armature_weight(const MDeformVert &dvert,
+                                  const int armature_def_nr,
+                                  const bool invert_vgroup)
+{
+  if (armature_def_nr == -1) {
+    return 1.0f;
+  }
+  const float weight = BKE_defvert_find_weight(&dvert, armature_def_nr);
+  return invert_vgroup ? 1.0f - weight : weight;
+}
+
+/**
+ * Call the function for every weight of the vertex that deforms it, and return the total weight.
+ * Vertices that are not deformed are skipped in the same way as on the CPU.
+ */
+template<typename Fn>
+static float foreach_deforming_weight(const MDeformVert &dvert,
+                                      const Span<bool> deforming_groups,
+                                      const Fn &fn)
+{
+  float contrib = 0.0f;
+  for (const MDeformWeight &dw : Span(dvert.dw, dvert.totweight)) {
+    if (dw.def_nr < deforming_groups.size() && deforming_groups[dw.def_nr] && dw.weight != 0.0f) {
+      fn(int(dw.def_nr), dw.weight);
+      contrib += dw.weight;
+    }
+  }
+  return contrib;
+}
+
+static std::shared_ptr<const ArmatureDeformWeights> create_deform_weights(
+    const Mesh &mesh,
+    Array<bool> deforming_groups,
+    const int armature_def_nr,
+    const bool invert_vgroup)
+{
+  const Span<MDeformVert> dverts = mesh.deform_verts();
+  auto weights = std::make_shared<ArmatureDeformWeights>();
+  weights->groups_num = deforming_groups.size();
+  weights->offsets.reinitialize(mesh.verts_num + 1);
+  threading::parallel_for(dverts.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      int count = 0;
+      const float contrib = foreach_deforming_weight(
+          dverts[i], deforming_groups, [&](const int /*group*/, const float /*weight*/) {
+            count++;
+          });
+      const float armature_weight = vert_armature_weight(dverts[i], armature_def_nr, invert_vgroup);
+      /* Vertices with such a small total weight are not deformed on the CPU either. */
+      weights->offsets[i] = (contrib > 0.0001f && armature_weight != 0.0f) ? count : 0;
+    }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(
+      weights->offsets);
+
+  weights->groups.reinitialize(offsets.total_size());
+  weights->weights.reinitialize(offsets.total_size());
+  threading::parallel_for(dverts.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange vert_weights = offsets[i];
+      if (vert_weights.is_empty()) {
+        continue;
+      }
+      int weight_index = vert_weights.start();
+      const float contrib = foreach_deforming_weight(
+          dverts[i], deforming_groups, [&](const int group, const float weight) {
+            weights->groups[weight_index] = group;
+            weights->weights[weight_index] = weight;
+            weight_index++;
+          });
+      const float factor = vert_armature_weight(dverts[i], armature_def_nr, invert_vgroup) /
+                           contrib;
+      for (float &weight : weights->weights.as_mutable_span().slice(vert_weights)) {
+        weight *= factor;
+      }
+    }
+  });
+
+  weights->dverts_sharing_info = get_dverts_sharing_info(mesh);
+  if (weights->dverts_sharing_info != nullptr) {
+    weights->dverts_sharing_info->add_weak_user();
+    weights->dverts_version = weights->dverts_sharing_info->version();
+  }
+  weights->armature_def_nr = armature_def_nr;
+  weights->invert_vgroup = invert_vgroup;
+  weights->deforming_groups = std::move(deforming_groups);
+  return weights;
+}
+
+static bool deform_weights_are_valid(const ArmatureDeformWeights &weights,
+                                     const Mesh &mesh,
+                                     const Span<bool> deforming_groups,
+                                     const int armature_def_nr,
+                                     const bool invert_vgroup)
+{
+  const ImplicitSharingInfo *sharing_info = get_dverts_sharing_info(mesh);
+  if (sharing_info == nullptr || sharing_info != weights.dverts_sharing_info ||
+      sharing_info->version() != weights.dverts_version)
+  {
+    return false;
+  }
+  return weights.offsets.size() == mesh.verts_num + 1 &&
+         weights.armature_def_nr == armature_def_nr && weights.invert_vgroup == invert_vgroup &&
+         weights.deforming_groups.as_span() == deforming_groups;
+}
+
+/**
+ * A deformed position is a weighted average of the positions transformed by every vertex group
+ * and the original position. So it is inside of the transformed bounds of the positions in every
+ * group, and inside of the bounds of the positions that are not fully deformed.
+ */
+static std::optional<Bounds<float3>> calc_deformed_bounds(const ArmatureDeformWeights &weights,
+                                                          const Span<float4x4> group_matrices,
+                                                          const Span<float3> positions)
+{
+  struct LocalBounds {
+    Array<std::optional<Bounds<float3>>> groups;
+    std::optional<Bounds<float3>> rest;
+  };
+  const OffsetIndices<int> offsets = weights.offsets.as_span();
+  threading::EnumerableThreadSpecific<LocalBounds> all_bounds(
+      [&]() { return LocalBounds{Array<std::optional<Bounds<float3>>>(weights.groups_num)}; });
+  threading::parallel_for(positions.index_range(), 2048, [&](const IndexRange range) {
+    LocalBounds &local = all_bounds.local();
+    for (const int i : range) {
+      float weight_sum = 0.0f;
+      for (const int weight_index : offsets[i]) {
+        const int group = weights.groups[weight_index];
+        local.groups[group] = bounds::min_max(local.groups[group], positions[i]);
+        weight_sum += weights.weights[weight_index];
+      }
+      if (weight_sum < 1.0f - 1e-5f) {
+        local.rest = bounds::min_max(local.rest, positions[i]);
+      }
+    }
+  });
+
+  std::optional<Bounds<float3>> result;
+  for (const LocalBounds &local : all_bounds) {
+    result = bounds::merge(result, local.rest);
+    for (const int group : local.groups.index_range()) {
+      if (!local.groups[group]) {
+        continue;
+      }
+      const Bounds<float3> &group_bounds = *local.groups[group];
+      for (const int corner : IndexRange(8)) {
+        const float3 position(corner & 1 ? group_bounds.max.x : group_bounds.min.x,
+                              corner & 2 ? group_bounds.max.y : group_bounds.min.y,
+                              corner & 4 ? group_bounds.max.z : group_bounds.min.z);
+        result = bounds::min_max(result,
+                                 math::transform_point(group_matrices[group], position));
+      }
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<const ArmatureGPUDeform> armature_gpu_deform_create(
+    const Object &ob_arm,
+    const Object &ob_target,
+    const Mesh &mesh,
+    const int deformflag,
+    const char *defgrp_name,
+    std::shared_ptr<const ArmatureDeformWeights> &weights_cache)
+{
+  const Array<const bPoseChannel *> pchans = get_pchan_from_defbase(ob_arm, mesh);
+  Array<bool> deforming_groups(pchans.size());
+  for (const int i : pchans.index_range()) {
+    deforming_groups[i] = pchans[i] != nullptr;
+  }
+  const int armature_def_nr = BKE_id_defgroup_name_index(&mesh.id, defgrp_name);
+  const bool invert_vgroup = (deformflag & ARM_DEF_INVERT_VGROUP) != 0;
+  if (!weights_cache || !deform_weights_are_valid(
+                            *weights_cache, mesh, deforming_groups, armature_def_nr, invert_vgroup))
+  {
+    weights_cache = create_deform_weights(
+        mesh, std::move(deforming_groups), armature_def_nr, invert_vgroup);
+  }
+
+  /* The same transforms as #ArmatureUserdata::premat and #ArmatureUserdata::postmat. */
+  const float4x4 postmat = math::invert(ob_target.object_to_world()) * ob_arm.object_to_world();
+  const float4x4 premat = math::invert(postmat);
+
+  auto deform = std::make_shared<ArmatureGPUDeform>();
+  deform->weights = weights_cache;
+  deform->group_matrices.reinitialize(pchans.size());
+  for (const int i : pchans.index_range()) {
+    deform->group_matrices[i] = pchans[i] ? postmat * float4x4(pchans[i]->chan_mat) * premat :
+                                            float4x4::identity();
+  }
+  deform->bounds = calc_deformed_bounds(
+      *deform->weights, deform->group_matrices, mesh.vert_positions());
+  return deform;
+}
+
+void armature_gpu_deform_positions(const ArmatureGPUDeform &deform, MutableSpan<float3> positions)
+{
+  const ArmatureDeformWeights &weights = *deform.weights;
+  const OffsetIndices<int> offsets = weights.offsets.as_span();
+  threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 position = positions[i];
+      float3 offset(0.0f);
+      for (const int weight_index : offsets[i]) {
+        const float4x4 &matrix = deform.group_matrices[weights.groups[weight_index]];
+        offset += weights.weights[weight_index] * (math::transform_point(matrix, position) -
+                                                   position);
+      }
+      positions[i] = position + offset;
+    }
+  });
+}
+
+}  // namespace blender::bke
+
+/** \} */
@@ -16,6 +16,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_path_util.h"
+#include "BLI_task.hh"
 
 #include "DNA_material_types.h"
 #include "DNA_volume_types.h"
@@ -26,6 +27,7 @@
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -39,6 +41,11 @@ namespace blender::bke::bake {
 using namespace io::serialize;
 using DictionaryValuePtr = std::shared_ptr<DictionaryValue>;
 
+/** Alignment of the arrays in blob files, enough for all types that are stored in them. */
+static constexpr int64_t blob_array_alignment = 16;
+/** Compression level used for arrays that are stored as difference to a keyframe. */
+static constexpr int delta_compression_level = 3;
+
 std::shared_ptr<DictionaryValue> BlobSlice::serialize() const
 {
   auto io_slice = std::make_shared<DictionaryValue>();
@@ -84,8 +91,23 @@ bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::is
   return true;
 }
 
+std::optional<ImplicitSharingInfoAndData> BlobReader::read_mapped(
+    const BlobSlice & /*slice*/) const
+{
+  return std::nullopt;
+}
+
 DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
 
+DiskBlobReader::~DiskBlobReader()
+{
+  for (const MappedFile *file : mapped_files_.values()) {
+    if (file) {
+      file->remove_user_and_delete_if_last();
+    }
+  }
+}
+
 [[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
 {
   if (slice.range.is_empty()) {
@@ -107,6 +129,26 @@ DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blo
   return true;
 }
 
+std::optional<ImplicitSharingInfoAndData> DiskBlobReader::read_mapped(
+    const BlobSlice &slice) const
+{
+  if (slice.range.is_empty()) {
+    return std::nullopt;
+  }
+
+  char blob_path[FILE_MAX];
+  BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), slice.name.c_str());
+
+  std::lock_guard lock{mutex_};
+  /* Failing to map a file is remembered, so that it is only tried once. */
+  const MappedFile *file = mapped_files_.lookup_or_add_cb_as(
+      blob_path, [&]() { return MappedFile::open(blob_path); });
+  if (file == nullptr || file->has_io_error()) {
+    return std::nullopt;
+  }
+  return file->share_range(slice.range);
+}
+
 DiskBlobWriter::DiskBlobWriter(std::string blob_dir, std::string base_name)
     : blob_dir_(std::move(blob_dir)), base_name_(std::move(base_name))
 {
@@ -122,6 +164,13 @@ BlobSlice DiskBlobWriter::write(const void *data, const int64_t size)
     blob_stream_.open(blob_path, std::ios::out | std::ios::binary);
   }
 
+  /* Align arrays, so that they can be used directly when the file is memory mapped. */
+  static const char zeros[blob_array_alignment] = {0};
+  const int64_t padding = (blob_array_alignment - current_offset_ % blob_array_alignment) %
+                          blob_array_alignment;
+  blob_stream_.write(zeros, padding);
+  current_offset_ += padding;
+
   const int64_t old_offset = current_offset_;
   blob_stream_.write(static_cast<const char *>(data), size);
   current_offset_ += size;
@@ -145,6 +194,11 @@ BlobSlice DiskBlobWriter::write_as_stream(const StringRef file_extension,
   return {file_name, {0, written_bytes_num}};
 }
 
+BlobWriteSharing::BlobWriteSharing(const int keyframe_interval)
+    : keyframe_interval_(keyframe_interval)
+{
+}
+
 BlobWriteSharing::~BlobWriteSharing()
 {
   for (const ImplicitSharingInfo *sharing_info : stored_by_runtime_.keys()) {
@@ -198,6 +252,104 @@ std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplic
   return slice.serialize();
 }
 
+void BlobWriteSharing::begin_frame()
+{
+  if (keyframe_interval_ > 1 && frames_num_ % keyframe_interval_ == 0) {
+    keyframe_arrays_.clear();
+  }
+  frames_num_++;
+  next_array_index_ = 0;
+}
+
+int BlobWriteSharing::next_array_index()
+{
+  return next_array_index_++;
+}
+
+/**
+ * The bytes of the difference between two arrays are grouped by their significance. The most
+ * significant bytes are usually zero when values change by a small amount, which makes it easier
+ * to compress them.
+ */
+static void xor_bytes_shuffled(const Span<std::byte> a,
+                               const Span<std::byte> b,
+                               const int64_t word_size,
+                               MutableSpan<std::byte> r_shuffled)
+{
+  const int64_t words_num = a.size() / word_size;
+  threading::parallel_for(IndexRange(words_num), 4096, [&](const IndexRange range) {
+    for (const int64_t word : range) {
+      for (const int64_t byte : IndexRange(word_size)) {
+        const int64_t i = word * word_size + byte;
+        r_shuffled[byte * words_num + word] = a[i] ^ b[i];
+      }
+    }
+  });
+}
+
+/** Inverse of #xor_bytes_shuffled, applies the shuffled difference to the array in place. */
+static void xor_bytes_unshuffle(const Span<std::byte> shuffled,
+                                const int64_t word_size,
+                                MutableSpan<std::byte> r_data)
+{
+  const int64_t words_num = r_data.size() / word_size;
+  threading::parallel_for(IndexRange(words_num), 4096, [&](const IndexRange range) {
+    for (const int64_t word : range) {
+      for (const int64_t byte : IndexRange(word_size)) {
+        r_data[word * word_size + byte] ^= shuffled[byte * words_num + word];
+      }
+    }
+  });
+}
+
+DictionaryValuePtr BlobWriteSharing::write_deduplicated_delta(BlobWriter &writer,
+                                                              const int array_index,
+                                                              const void *data,
+                                                              const int64_t size_in_bytes,
+                                                              const int64_t word_size)
+{
+  if (keyframe_interval_ <= 1 || size_in_bytes == 0) {
+    return this->write_deduplicated(writer, data, size_in_bytes);
+  }
+  const Span<std::byte> bytes{static_cast<const std::byte *>(data), size_in_bytes};
+  const bool is_keyframe = (frames_num_ - 1) % keyframe_interval_ == 0;
+  if (is_keyframe) {
+    DictionaryValuePtr io_data = this->write_deduplicated(writer, data, size_in_bytes);
+    keyframe_arrays_.add_overwrite(array_index, {Array<std::byte>(bytes), io_data});
+    return io_data;
+  }
+  const KeyframeArray *keyframe_array = keyframe_arrays_.lookup_ptr(array_index);
+  if (keyframe_array == nullptr || keyframe_array->data.size() != size_in_bytes ||
+      size_in_bytes % word_size != 0)
+  {
+    return this->write_deduplicated(writer, data, size_in_bytes);
+  }
+  /* Arrays that have been written before are referenced instead. */
+  if (slice_by_content_hash_.contains(XXH3_64bits(data, size_in_bytes))) {
+    return this->write_deduplicated(writer, data, size_in_bytes);
+  }
+
+  Array<std::byte> delta(size_in_bytes);
+  xor_bytes_shuffled(bytes, keyframe_array->data, word_size, delta);
+  Array<std::byte> compressed(ZSTD_compressBound(size_t(size_in_bytes)));
+  const size_t compressed_size = ZSTD_compress(compressed.data(),
+                                               size_t(compressed.size()),
+                                               delta.data(),
+                                               size_t(size_in_bytes),
+                                               delta_compression_level);
+  if (ZSTD_isError(compressed_size) || int64_t(compressed_size) >= size_in_bytes) {
+    return this->write_deduplicated(writer, data, size_in_bytes);
+  }
+
+  DictionaryValuePtr io_data = writer.write(compressed.data(), int64_t(compressed_size))
+                                   .serialize();
+  DictionaryValue &io_delta = *io_data->append_dict("delta");
+  io_delta.append("keyframe", keyframe_array->io_data);
+  io_delta.append_int("size", size_in_bytes);
+  io_delta.append_int("word_size", word_size);
+  return io_data;
+}
+
 std::optional<ImplicitSharingInfoAndData> BlobReadSharing::read_shared(
     const DictionaryValue &io_data,
     FunctionRef<std::optional<ImplicitSharingInfoAndData>()> read_fn) const
@@ -265,16 +417,72 @@ static std::optional<eCustomDataType> get_data_type_from_io_name(const StringRef
   return eCustomDataType(domain);
 }
 
+/**
+ * Read the stored bytes. When they are stored as difference to a keyframe, the keyframe is read and
+ * the decompressed difference is applied to it.
+ */
+[[nodiscard]] static bool read_blob_bytes(const BlobReader &blob_reader,
+                                          const DictionaryValue &io_data,
+                                          const int64_t bytes_num,
+                                          void *r_data)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return false;
+  }
+  const DictionaryValue *io_delta = io_data.lookup_dict("delta");
+  if (!io_delta) {
+    if (slice->range.size() != bytes_num) {
+      return false;
+    }
+    return blob_reader.read(*slice, r_data);
+  }
+  const DictionaryValue *io_keyframe = io_delta->lookup_dict("keyframe");
+  const std::optional<int64_t> size = io_delta->lookup_int("size");
+  const std::optional<int64_t> word_size = io_delta->lookup_int("word_size");
+  if (!io_keyframe || !size || !word_size) {
+    return false;
+  }
+  if (*size != bytes_num || *word_size <= 0 || bytes_num % *word_size != 0) {
+    return false;
+  }
+  /* Keyframes are always stored in full. */
+  if (io_keyframe->lookup_dict("delta")) {
+    return false;
+  }
+  if (!read_blob_bytes(blob_reader, *io_keyframe, bytes_num, r_data)) {
+    return false;
+  }
+  Array<std::byte> compressed(slice->range.size());
+  if (!blob_reader.read(*slice, compressed.data())) {
+    return false;
+  }
+  Array<std::byte> delta(bytes_num);
+  const size_t delta_size = ZSTD_decompress(
+      delta.data(), size_t(bytes_num), compressed.data(), size_t(compressed.size()));
+  if (ZSTD_isError(delta_size) || delta_size != size_t(bytes_num)) {
+    return false;
+  }
+  xor_bytes_unshuffle(delta, *word_size, {static_cast<std::byte *>(r_data), bytes_num});
+  return true;
+}
+
 /**
  * Write the data and remember which endianness the data had.
+ * \param array_index: Allows storing the data as difference to a keyframe, see
+ * #BlobWriteSharing::write_deduplicated_delta.
  */
 static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
     const void *data,
-    const int64_t size_in_bytes)
+    const int64_t size_in_bytes,
+    const int64_t word_size,
+    const std::optional<int> array_index)
 {
-  auto io_data = blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  auto io_data = array_index ? blob_sharing.write_deduplicated_delta(
+                                   blob_writer, *array_index, data, size_in_bytes, word_size) :
+                               blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
   if (ENDIAN_ORDER == B_ENDIAN) {
     io_data->append_str("endian", get_endian_io_name(ENDIAN_ORDER));
   }
@@ -290,14 +498,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
                                                          const int64_t elements_num,
                                                          void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != element_size * elements_num) {
-    return false;
-  }
-  if (!blob_reader.read(*slice, r_data)) {
+  if (!read_blob_bytes(blob_reader, io_data, element_size * elements_num, r_data)) {
     return false;
   }
   const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
@@ -324,11 +525,17 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
 }
 
 /** Write bytes ignoring endianness. */
-static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_writer,
-                                                             BlobWriteSharing &blob_sharing,
-                                                             const void *data,
-                                                             const int64_t size_in_bytes)
+static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(
+    BlobWriter &blob_writer,
+    BlobWriteSharing &blob_sharing,
+    const void *data,
+    const int64_t size_in_bytes,
+    const std::optional<int> array_index = std::nullopt)
 {
+  if (array_index) {
+    return blob_sharing.write_deduplicated_delta(
+        blob_writer, *array_index, data, size_in_bytes, 1);
+  }
   return blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
 }
 
@@ -338,27 +545,35 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
                                               const int64_t bytes_num,
                                               void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != bytes_num) {
-    return false;
+  return read_blob_bytes(blob_reader, io_data, bytes_num, r_data);
+}
+
+/** Size of the values that are switched when the endianness changes. */
+static int64_t get_endian_word_size(const CPPType &type)
+{
+  if (type.is_any<float2, int2, float3, float4x4, ColorGeometry4f, math::Quaternion>()) {
+    return 4;
   }
-  return blob_reader.read(*slice, r_data);
+  return type.size();
 }
 
 static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob_writer,
                                                                 BlobWriteSharing &blob_sharing,
-                                                                const GSpan data)
+                                                                const GSpan data,
+                                                                const int array_index)
 {
   const CPPType &type = data.type();
   BLI_assert(type.is_trivial());
   if (type.size() == 1 || type.is<ColorGeometry4b>()) {
-    return write_blob_raw_bytes(blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+    return write_blob_raw_bytes(
+        blob_writer, blob_sharing, data.data(), data.size_in_bytes(), array_index);
   }
-  return write_blob_raw_data_with_endian(
-      blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+  return write_blob_raw_data_with_endian(blob_writer,
+                                         blob_sharing,
+                                         data.data(),
+                                         data.size_in_bytes(),
+                                         get_endian_word_size(type),
+                                         array_index);
 }
 
 [[nodiscard]] static bool read_blob_simple_gspan(const BlobReader &blob_reader,
@@ -403,8 +618,39 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
     const GSpan data,
     const ImplicitSharingInfo *sharing_info)
 {
-  return blob_sharing.write_implicitly_shared(
-      sharing_info, [&]() { return write_blob_simple_gspan(blob_writer, blob_sharing, data); });
+  const int array_index = blob_sharing.next_array_index();
+  return blob_sharing.write_implicitly_shared(sharing_info, [&]() {
+    return write_blob_simple_gspan(blob_writer, blob_sharing, data, array_index);
+  });
+}
+
+/**
+ * Reference the stored data directly when it can be used as is, i.e. when the blob reader supports
+ * memory mapping, when the data is aligned and when no endian switch is necessary.
+ */
+[[nodiscard]] static std::optional<ImplicitSharingInfoAndData> read_blob_mapped_simple_gspan(
+    const BlobReader &blob_reader,
+    const DictionaryValue &io_data,
+    const CPPType &cpp_type,
+    const int size)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return std::nullopt;
+  }
+  if (slice->range.size() != cpp_type.size() * size ||
+      slice->range.start() % cpp_type.alignment() != 0)
+  {
+    return std::nullopt;
+  }
+  const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
+  if (stored_endian != get_endian_io_name(ENDIAN_ORDER)) {
+    return std::nullopt;
+  }
+  if (io_data.lookup_dict("delta")) {
+    return std::nullopt;
+  }
+  return blob_reader.read_mapped(*slice);
 }
 
 [[nodiscard]] static const void *read_blob_shared_simple_gspan(
@@ -418,6 +664,11 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
   const char *func = __func__;
   const std::optional<ImplicitSharingInfoAndData> sharing_info_and_data = blob_sharing.read_shared(
       io_data, [&]() -> std::optional<ImplicitSharingInfoAndData> {
+        if (std::optional<ImplicitSharingInfoAndData> mapped = read_blob_mapped_simple_gspan(
+                blob_reader, io_data, cpp_type, size))
+        {
+          return mapped;
+        }
         void *data_mem = MEM_mallocN_aligned(size * cpp_type.size(), cpp_type.alignment(), func);
         if (!read_blob_simple_gspan(blob_reader, io_data, {cpp_type, data_mem, size})) {
           MEM_freeN(data_mem);
@@ -1346,6 +1597,7 @@ void serialize_bake(const BakeState &bake_state,
                     BlobWriteSharing &blob_sharing,
                     std::ostream &r_stream)
 {
+  blob_sharing.begin_frame();
   io::serialize::DictionaryValue io_root;
   io_root.append_int("version", bake_file_version);
   io::serialize::DictionaryValue &io_items = *io_root.append_dict("items");
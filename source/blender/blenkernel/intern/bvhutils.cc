@@ -10,7 +10,7 @@
 #include "DNA_pointcloud_types.h"
 
 #include "BLI_math_geom.h"
-#include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_bvhutils.hh"
@@ -29,136 +29,19 @@ using blender::VArray;
 /** \name BVHCache
  * \{ */
 
-struct BVHCacheItem {
-  bool is_filled;
-  BVHTree *tree;
-};
+namespace blender::bke {
 
-struct BVHCache {
-  BVHCacheItem items[BVHTREE_MAX_ITEM];
-  ThreadMutex mutex;
-};
-
-/**
- * Queries a bvhcache for the cache bvhtree of the request type
- *
- * When the `r_locked` is filled and the tree could not be found the caches mutex will be
- * locked. This mutex can be unlocked by calling `bvhcache_unlock`.
- *
- * When `r_locked` is used the `mesh_eval_mutex` must contain the `MeshRuntime.eval_mutex`.
- */
-static bool bvhcache_find(BVHCache **bvh_cache_p,
-                          BVHCacheType type,
-                          BVHTree **r_tree,
-                          bool *r_locked,
-                          std::mutex *mesh_eval_mutex)
-{
-  bool do_lock = r_locked;
-  if (r_locked) {
-    *r_locked = false;
-  }
-  if (*bvh_cache_p == nullptr) {
-    if (!do_lock) {
-      /* Cache does not exist and no lock is requested. */
-      return false;
-    }
-    /* Lazy initialization of the bvh_cache using the `mesh_eval_mutex`. */
-    std::lock_guard lock{*mesh_eval_mutex};
-    if (*bvh_cache_p == nullptr) {
-      *bvh_cache_p = bvhcache_init();
-    }
-  }
-  BVHCache *bvh_cache = *bvh_cache_p;
-
-  if (bvh_cache->items[type].is_filled) {
-    *r_tree = bvh_cache->items[type].tree;
-    return true;
-  }
-  if (do_lock) {
-    BLI_mutex_lock(&bvh_cache->mutex);
-    bool in_cache = bvhcache_find(bvh_cache_p, type, r_tree, nullptr, nullptr);
-    if (in_cache) {
-      BLI_mutex_unlock(&bvh_cache->mutex);
-      return in_cache;
-    }
-    *r_locked = true;
-  }
-  return false;
-}
-
-static void bvhcache_unlock(BVHCache *bvh_cache, bool lock_started)
-{
-  if (lock_started) {
-    BLI_mutex_unlock(&bvh_cache->mutex);
-  }
-}
-
-bool bvhcache_has_tree(const BVHCache *bvh_cache, const BVHTree *tree)
-{
-  if (bvh_cache == nullptr) {
-    return false;
-  }
-
-  for (int i = 0; i < BVHTREE_MAX_ITEM; i++) {
-    if (bvh_cache->items[i].tree == tree) {
-      return true;
-    }
-  }
-  return false;
-}
-
-BVHCache *bvhcache_init()
-{
-  BVHCache *cache = MEM_cnew<BVHCache>(__func__);
-  BLI_mutex_init(&cache->mutex);
-  return cache;
-}
-/**
- * Inserts a BVHTree of the given type under the cache
- * After that the caller no longer needs to worry when to free the BVHTree
- * as that will be done when the cache is freed.
- *
- * A call to this assumes that there was no previous cached tree of the given type
- * \warning The #BVHTree can be nullptr.
- */
-static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType type)
+void BVHTreeDeleter::operator()(BVHTree *tree)
 {
-  BVHCacheItem *item = &bvh_cache->items[type];
-  BLI_assert(!item->is_filled);
-  item->tree = tree;
-  item->is_filled = true;
+  BLI_bvhtree_free(tree);
 }
 
-void bvhcache_free(BVHCache *bvh_cache)
-{
-  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
-    BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
-    item->tree = nullptr;
-  }
-  BLI_mutex_end(&bvh_cache->mutex);
-  MEM_freeN(bvh_cache);
-}
+}  // namespace blender::bke
 
-/**
- * BVH-tree balancing inside a mutex lock must be run in isolation. Balancing
- * is multithreaded, and we do not want the current thread to start another task
- * that may involve acquiring the same mutex lock that it is waiting for.
- */
-static void bvhtree_balance_isolated(void *userdata)
-{
-  BLI_bvhtree_balance((BVHTree *)userdata);
-}
-
-static void bvhtree_balance(BVHTree *tree, const bool isolate)
+static void bvhtree_balance(BVHTree *tree)
 {
   if (tree) {
-    if (isolate) {
-      BLI_task_isolate(bvhtree_balance_isolated, tree);
-    }
-    else {
-      BLI_bvhtree_balance(tree);
-    }
+    BLI_bvhtree_balance(tree);
   }
 }
 
@@ -593,7 +476,7 @@ BVHTree *bvhtree_from_mesh_verts_ex(BVHTreeFromMesh *data,
   BVHTree *tree = bvhtree_from_mesh_verts_create_tree(
       epsilon, tree_type, axis, vert_positions, verts_mask, verts_num_active);
 
-  bvhtree_balance(tree, false);
+  bvhtree_balance(tree);
 
   if (data) {
     /* Setup BVHTreeFromMesh */
@@ -648,7 +531,7 @@ BVHTree *bvhtree_from_mesh_edges_ex(BVHTreeFromMesh *data,
   BVHTree *tree = bvhtree_from_mesh_edges_create_tree(
       vert_positions, edges, edges_mask, edges_num_active, epsilon, tree_type, axis);
 
-  bvhtree_balance(tree, false);
+  bvhtree_balance(tree);
 
   if (data) {
     /* Setup BVHTreeFromMesh */
@@ -764,7 +647,7 @@ BVHTree *bvhtree_from_mesh_corner_tris_ex(BVHTreeFromMesh *data,
                                                             corner_tris_mask,
                                                             corner_tris_num_active);
 
-  bvhtree_balance(tree, false);
+  bvhtree_balance(tree);
 
   if (data) {
     /* Setup BVHTreeFromMesh */
@@ -896,110 +779,178 @@ static BitVector<> corner_tris_no_hidden_map_get(const blender::OffsetIndices<in
   return corner_tris_mask;
 }
 
-BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
-                                   const Mesh *mesh,
-                                   const BVHCacheType bvh_cache_type,
-                                   const int tree_type)
+/**
+ * Update the bounds of a tree that was built for the same topology, after the positions changed.
+ * This is much faster than building a new tree, but the tree is not rebalanced, so it may become
+ * less efficient when the shape of the mesh changes a lot.
+ * \return False if the tree has to be built again instead.
+ */
+static bool bvhtree_update_for_positions(BVHTree &tree,
+                                         const Mesh &mesh,
+                                         const BVHCacheType bvh_cache_type,
+                                         const Span<int3> corner_tris)
 {
   using namespace blender;
   using namespace blender::bke;
-  BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime->bvh_cache;
-
-  Span<int3> corner_tris;
-  if (ELEM(bvh_cache_type, BVHTREE_FROM_CORNER_TRIS, BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN)) {
-    corner_tris = mesh->corner_tris();
-  }
-
-  const Span<float3> positions = mesh->vert_positions();
-  const Span<int2> edges = mesh->edges();
-  const Span<int> corner_verts = mesh->corner_verts();
-
-  /* Setup BVHTreeFromMesh */
-  bvhtree_from_mesh_setup_data(nullptr,
-                               bvh_cache_type,
-                               positions,
-                               edges,
-                               corner_verts,
-                               corner_tris,
-                               (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-                               data);
-
-  bool lock_started = false;
-  data->cached = bvhcache_find(
-      bvh_cache_p, bvh_cache_type, &data->tree, &lock_started, &mesh->runtime->eval_mutex);
+  const Span<float3> positions = mesh.vert_positions();
+  const Span<int2> edges = mesh.edges();
+  const Span<int> corner_verts = mesh.corner_verts();
 
-  if (data->cached) {
-    BLI_assert(lock_started == false);
+  /* The leaves are stored in the order they were inserted, which is the order of the elements. */
+  const auto update_edge = [&](const int leaf, const int2 edge) {
+    float co[2][3];
+    copy_v3_v3(co[0], positions[edge[0]]);
+    copy_v3_v3(co[1], positions[edge[1]]);
+    BLI_bvhtree_update_node(&tree, leaf, co[0], nullptr, 2);
+  };
 
-    /* NOTE: #data->tree can be nullptr. */
-    return data->tree;
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS: {
+      if (BLI_bvhtree_get_len(&tree) != positions.size()) {
+        return false;
+      }
+      threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+        for (const int vert : range) {
+          BLI_bvhtree_update_node(&tree, vert, positions[vert], nullptr, 1);
+        }
+      });
+      break;
+    }
+    case BVHTREE_FROM_LOOSEVERTS: {
+      const LooseVertCache &loose_verts = mesh.loose_verts();
+      if (BLI_bvhtree_get_len(&tree) != loose_verts.count) {
+        return false;
+      }
+      int leaf = 0;
+      for (const int vert : positions.index_range()) {
+        if (loose_verts.is_loose_bits[vert]) {
+          BLI_bvhtree_update_node(&tree, leaf++, positions[vert], nullptr, 1);
+        }
+      }
+      break;
+    }
+    case BVHTREE_FROM_EDGES: {
+      if (BLI_bvhtree_get_len(&tree) != edges.size()) {
+        return false;
+      }
+      threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+        for (const int edge : range) {
+          update_edge(edge, edges[edge]);
+        }
+      });
+      break;
+    }
+    case BVHTREE_FROM_LOOSEEDGES: {
+      const LooseEdgeCache &loose_edges = mesh.loose_edges();
+      if (BLI_bvhtree_get_len(&tree) != loose_edges.count) {
+        return false;
+      }
+      int leaf = 0;
+      for (const int edge : edges.index_range()) {
+        if (loose_edges.is_loose_bits[edge]) {
+          update_edge(leaf++, edges[edge]);
+        }
+      }
+      break;
+    }
+    case BVHTREE_FROM_CORNER_TRIS: {
+      if (BLI_bvhtree_get_len(&tree) != corner_tris.size()) {
+        return false;
+      }
+      threading::parallel_for(corner_tris.index_range(), 4096, [&](const IndexRange range) {
+        for (const int tri : range) {
+          float co[3][3];
+          copy_v3_v3(co[0], positions[corner_verts[corner_tris[tri][0]]]);
+          copy_v3_v3(co[1], positions[corner_verts[corner_tris[tri][1]]]);
+          copy_v3_v3(co[2], positions[corner_verts[corner_tris[tri][2]]]);
+          BLI_bvhtree_update_node(&tree, tri, co[0], nullptr, 3);
+        }
+      });
+      break;
+    }
+    default:
+      /* The hidden state of the elements may have changed as well, and legacy faces are rarely
+       * used, so these trees are always built again. */
+      return false;
   }
+  BLI_bvhtree_update_tree(&tree);
+  return true;
+}
 
-  /* Create BVHTree. */
+static BVHTree *bvhtree_from_mesh_create_tree(const Mesh &mesh,
+                                              const BVHCacheType bvh_cache_type,
+                                              const int tree_type,
+                                              const Span<int3> corner_tris)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  const Span<float3> positions = mesh.vert_positions();
+  const Span<int2> edges = mesh.edges();
+  const Span<int> corner_verts = mesh.corner_verts();
 
+  BVHTree *tree = nullptr;
   switch (bvh_cache_type) {
     case BVHTREE_FROM_LOOSEVERTS: {
-      const LooseVertCache &loose_verts = mesh->loose_verts();
-      data->tree = bvhtree_from_mesh_verts_create_tree(
+      const LooseVertCache &loose_verts = mesh.loose_verts();
+      tree = bvhtree_from_mesh_verts_create_tree(
           0.0f, tree_type, 6, positions, loose_verts.is_loose_bits, loose_verts.count);
       break;
     }
     case BVHTREE_FROM_LOOSEVERTS_NO_HIDDEN: {
       int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_verts_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_verts_create_tree(
+      const BitVector<> mask = loose_verts_no_hidden_mask_get(mesh, &mask_bits_act_len);
+      tree = bvhtree_from_mesh_verts_create_tree(
           0.0f, tree_type, 6, positions, mask, mask_bits_act_len);
       break;
     }
     case BVHTREE_FROM_VERTS: {
-      data->tree = bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
+      tree = bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
       break;
     }
     case BVHTREE_FROM_LOOSEEDGES: {
-      const LooseEdgeCache &loose_edges = mesh->loose_edges();
-      data->tree = bvhtree_from_mesh_edges_create_tree(
+      const LooseEdgeCache &loose_edges = mesh.loose_edges();
+      tree = bvhtree_from_mesh_edges_create_tree(
           positions, edges, loose_edges.is_loose_bits, loose_edges.count, 0.0f, tree_type, 6);
       break;
     }
     case BVHTREE_FROM_LOOSEEDGES_NO_HIDDEN: {
       int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_edges_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_edges_create_tree(
+      const BitVector<> mask = loose_edges_no_hidden_mask_get(mesh, &mask_bits_act_len);
+      tree = bvhtree_from_mesh_edges_create_tree(
           positions, edges, mask, mask_bits_act_len, 0.0f, tree_type, 6);
       break;
     }
     case BVHTREE_FROM_EDGES: {
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          positions, edges, {}, -1, 0.0f, tree_type, 6);
+      tree = bvhtree_from_mesh_edges_create_tree(positions, edges, {}, -1, 0.0f, tree_type, 6);
       break;
     }
     case BVHTREE_FROM_FACES: {
-      BLI_assert(!(mesh->totface_legacy == 0 && mesh->faces_num != 0));
-      data->tree = bvhtree_from_mesh_faces_create_tree(
+      BLI_assert(!(mesh.totface_legacy == 0 && mesh.faces_num != 0));
+      tree = bvhtree_from_mesh_faces_create_tree(
           0.0f,
           tree_type,
           6,
           positions,
-          (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-          mesh->totface_legacy,
+          (const MFace *)CustomData_get_layer(&mesh.fdata_legacy, CD_MFACE),
+          mesh.totface_legacy,
           {},
           -1);
       break;
     }
     case BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN: {
-      AttributeAccessor attributes = mesh->attributes();
+      AttributeAccessor attributes = mesh.attributes();
       int mask_bits_act_len = -1;
       const BitVector<> mask = corner_tris_no_hidden_map_get(
-          mesh->faces(),
+          mesh.faces(),
           *attributes.lookup_or_default(".hide_poly", AttrDomain::Face, false),
           corner_tris.size(),
           &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+      tree = bvhtree_from_mesh_corner_tris_create_tree(
           0.0f, tree_type, 6, positions, corner_verts, corner_tris, mask, mask_bits_act_len);
       break;
     }
     case BVHTREE_FROM_CORNER_TRIS: {
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+      tree = bvhtree_from_mesh_corner_tris_create_tree(
           0.0f, tree_type, 6, positions, corner_verts, corner_tris, {}, -1);
       break;
     }
@@ -1008,14 +959,46 @@ BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
       break;
   }
 
-  bvhtree_balance(data->tree, lock_started);
+  bvhtree_balance(tree);
+  return tree;
+}
+
+BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
+                                   const Mesh *mesh,
+                                   const BVHCacheType bvh_cache_type,
+                                   const int tree_type)
+{
+  using namespace blender;
+  using namespace blender::bke;
+
+  Span<int3> corner_tris;
+  if (ELEM(bvh_cache_type, BVHTREE_FROM_CORNER_TRIS, BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN)) {
+    corner_tris = mesh->corner_tris();
+  }
+
+  /* Setup BVHTreeFromMesh */
+  bvhtree_from_mesh_setup_data(nullptr,
+                               bvh_cache_type,
+                               mesh->vert_positions(),
+                               mesh->edges(),
+                               mesh->corner_verts(),
+                               corner_tris,
+                               (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
+                               data);
+
+  /* A tree that is still stored in a dirty cache isn't shared with other meshes anymore, so it
+   * can be modified. */
+  SharedCache<BVHTreePtr> &cache = mesh->runtime->bvh_caches[bvh_cache_type];
+  cache.ensure([&](BVHTreePtr &tree) {
+    if (tree && bvhtree_update_for_positions(*tree, *mesh, bvh_cache_type, corner_tris)) {
+      return;
+    }
+    tree.reset(bvhtree_from_mesh_create_tree(*mesh, bvh_cache_type, tree_type, corner_tris));
+  });
 
-  /* Save on cache for later use */
-  // printf("BVHTree built and saved on cache\n");
-  BLI_assert(data->cached == false);
+  /* NOTE: #data->tree can be nullptr. */
+  data->tree = cache.data().get();
   data->cached = true;
-  bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type);
-  bvhcache_unlock(*bvh_cache_p, lock_started);
 
 #ifndef NDEBUG
   if (data->tree != nullptr) {
@@ -35,6 +35,7 @@
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -66,6 +67,8 @@
 using blender::Array;
 using blender::BitVector;
 using blender::float2;
+using blender::float3;
+using blender::float4;
 using blender::ImplicitSharingInfo;
 using blender::IndexRange;
 using blender::MutableSpan;
@@ -3698,6 +3701,134 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+/**
+ * Weighted sum of the source values of every group, the same as the `interp` callbacks of the
+ * generic attribute types.
+ */
+template<typename T>
+static void interp_groups_weighted_sum(const T *src,
+                                       const blender::OffsetIndices<int> groups,
+                                       const Span<int> src_indices,
+                                       const Span<float> weights,
+                                       MutableSpan<T> dst)
+{
+  blender::threading::parallel_for(groups.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange group = groups[i];
+      T result(0);
+      if (weights.is_empty()) {
+        const float weight = 1.0f / float(group.size());
+        for (const int src_i : src_indices.slice(group)) {
+          result += src[src_i] * weight;
+        }
+      }
+      else {
+        for (const int j : group) {
+          result += src[src_indices[j]] * weights[j];
+        }
+      }
+      dst[i] = result;
+    }
+  });
+}
+
+/** Call the `interp` callback of the layer type for every group. */
+static void interp_groups_generic(const LayerTypeInfo &type_info,
+                                  const void *src_data,
+                                  const blender::OffsetIndices<int> groups,
+                                  const Span<int> src_indices,
+                                  const Span<float> weights,
+                                  void *dst_data)
+{
+  blender::threading::parallel_for(groups.index_range(), 512, [&](const IndexRange range) {
+    Vector<const void *, SOURCE_BUF_SIZE> sources;
+    Vector<float, SOURCE_BUF_SIZE> default_weights;
+    for (const int i : range) {
+      const IndexRange group = groups[i];
+      sources.clear();
+      for (const int src_i : src_indices.slice(group)) {
+        sources.append(POINTER_OFFSET(src_data, size_t(src_i) * type_info.size));
+      }
+      const float *group_weights;
+      if (weights.is_empty()) {
+        default_weights.clear();
+        default_weights.append_n_times(1.0f / float(group.size()), group.size());
+        group_weights = default_weights.data();
+      }
+      else {
+        group_weights = &weights[group.start()];
+      }
+      type_info.interp(sources.data(),
+                       group_weights,
+                       nullptr,
+                       group.size(),
+                       POINTER_OFFSET(dst_data, size_t(i) * type_info.size));
+    }
+  });
+}
+
+void CustomData_interp_groups(const CustomData *source,
+                              CustomData *dest,
+                              const blender::OffsetIndices<int> groups,
+                              const Span<int> src_indices,
+                              const Span<float> weights,
+                              const int dest_start)
+{
+  using namespace blender;
+  BLI_assert(weights.is_empty() || weights.size() == src_indices.size());
+  if (groups.is_empty()) {
+    return;
+  }
+  const int dest_num = groups.size();
+  /* Layers are ordered by type, so the matching destination layers are found in a single pass, the
+   * same way as in #CustomData_interp. */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+    const eCustomDataType type = eCustomDataType(source->layers[src_i].type);
+    const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+    if (!typeInfo->interp) {
+      continue;
+    }
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < type) {
+      dest_i++;
+    }
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+    if (dest->layers[dest_i].type != type) {
+      continue;
+    }
+    const void *src_data = source->layers[src_i].data;
+    void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data, size_t(dest_start) * typeInfo->size);
+    const auto interp_typed = [&](auto dummy) {
+      using T = decltype(dummy);
+      interp_groups_weighted_sum<T>(static_cast<const T *>(src_data),
+                                    groups,
+                                    src_indices,
+                                    weights,
+                                    {static_cast<T *>(dst_data), dest_num});
+    };
+    switch (type) {
+      case CD_PROP_FLOAT:
+        interp_typed(float());
+        break;
+      case CD_PROP_FLOAT2:
+        interp_typed(float2());
+        break;
+      case CD_PROP_FLOAT3:
+        interp_typed(float3());
+        break;
+      case CD_PROP_COLOR:
+        interp_typed(float4());
+        break;
+      default:
+        interp_groups_generic(*typeInfo, src_data, groups, src_indices, weights, dst_data);
+        break;
+    }
+    dest_i++;
+  }
+}
+
 void CustomData_swap_corners(CustomData *data, const int index, const int *corner_indices)
 {
   for (int i = 0; i < data->totlayer; i++) {
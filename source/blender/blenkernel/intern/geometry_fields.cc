@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "BLI_array_utils.hh"
+#include "BLI_listbase.h"
+#include "BLI_set.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_curves.hh"
@@ -11,10 +13,13 @@
 #include "BKE_grease_pencil.hh"
 #include "BKE_instances.hh"
 #include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_pointcloud.hh"
 #include "BKE_type_conversions.hh"
 
+#include "DNA_curves_types.h"
 #include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
 #include "DNA_pointcloud_types.h"
 
 #include "BLT_translation.hh"
@@ -923,6 +928,308 @@ bool try_capture_fields_on_geometry(MutableAttributeAccessor attributes,
   return success;
 }
 
+/**
+ * The data of a geometry that the result of capturing fields may depend on. Arrays are identified
+ * by their sharing info together with its version, which changes when the data is modified in
+ * place. Weak users keep the sharing infos alive, so that their addresses can't be reused by other
+ * arrays while the state is stored.
+ */
+class GeometryDataState : NonCopyable, NonMovable {
+ private:
+  struct SharedArray {
+    int type;
+    std::string name;
+    const void *data;
+    const ImplicitSharingInfo *sharing_info;
+    int64_t version;
+
+    friend bool operator==(const SharedArray &a, const SharedArray &b)
+    {
+      return a.type == b.type && a.name == b.name && a.data == b.data &&
+             a.sharing_info == b.sharing_info && a.version == b.version;
+    }
+  };
+
+  Vector<int64_t> sizes_;
+  Vector<SharedArray> arrays_;
+  Vector<const void *> pointers_;
+  Vector<std::string> names_;
+  bool is_valid_ = true;
+
+ public:
+  ~GeometryDataState()
+  {
+    for (const SharedArray &array : arrays_) {
+      if (array.sharing_info) {
+        array.sharing_info->remove_weak_user_and_delete_if_last();
+      }
+    }
+  }
+
+  /** False when some data can't be identified, so changes to it would not be detected. */
+  bool is_valid() const
+  {
+    return is_valid_;
+  }
+
+  void add_size(const int64_t size)
+  {
+    sizes_.append(size);
+  }
+
+  void add_array(const int type,
+                 const StringRef name,
+                 const void *data,
+                 const ImplicitSharingInfo *sharing_info)
+  {
+    if (data != nullptr && sharing_info == nullptr) {
+      is_valid_ = false;
+      return;
+    }
+    if (sharing_info) {
+      sharing_info->add_weak_user();
+    }
+    arrays_.append({type, name, data, sharing_info, sharing_info ? sharing_info->version() : 0});
+  }
+
+  void add_custom_data(const CustomData &custom_data, const Span<StringRef> ignored_names)
+  {
+    for (const CustomDataLayer &layer : Span(custom_data.layers, custom_data.totlayer)) {
+      if (!ignored_names.contains(layer.name)) {
+        this->add_array(layer.type, layer.name, layer.data, layer.sharing_info);
+      }
+    }
+  }
+
+  void add_materials(const Span<Material *> materials)
+  {
+    pointers_.extend(materials.cast<const void *>());
+  }
+
+  void add_vertex_group_names(const ListBase &vertex_group_names)
+  {
+    LISTBASE_FOREACH (const bDeformGroup *, group, &vertex_group_names) {
+      names_.append(group->name);
+    }
+  }
+
+  friend bool operator==(const GeometryDataState &a, const GeometryDataState &b)
+  {
+    return a.sizes_ == b.sizes_ && a.arrays_ == b.arrays_ && a.pointers_ == b.pointers_ &&
+           a.names_ == b.names_;
+  }
+
+  friend bool operator!=(const GeometryDataState &a, const GeometryDataState &b)
+  {
+    return !(a == b);
+  }
+};
+
+/**
+ * Layers that are ignored don't become part of the state. That is used for the attributes that
+ * the fields are captured in, because otherwise capturing the fields would invalidate the result.
+ */
+static std::unique_ptr<GeometryDataState> get_geometry_data_state(
+    const GeometryComponent &component, const Span<StringRef> ignored_names)
+{
+  auto state = std::make_unique<GeometryDataState>();
+  switch (component.type()) {
+    case GeometryComponent::Type::Mesh: {
+      const Mesh *mesh = static_cast<const MeshComponent &>(component).get();
+      if (mesh == nullptr || mesh->runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+        return nullptr;
+      }
+      state->add_size(mesh->verts_num);
+      state->add_size(mesh->edges_num);
+      state->add_size(mesh->faces_num);
+      state->add_size(mesh->corners_num);
+      state->add_array(-1, "", mesh->face_offset_indices, mesh->runtime->face_offsets_sharing_info);
+      state->add_custom_data(mesh->vert_data, ignored_names);
+      state->add_custom_data(mesh->edge_data, ignored_names);
+      state->add_custom_data(mesh->face_data, ignored_names);
+      state->add_custom_data(mesh->corner_data, ignored_names);
+      state->add_vertex_group_names(mesh->vertex_group_names);
+      state->add_materials({mesh->mat, mesh->totcol});
+      break;
+    }
+    case GeometryComponent::Type::Curve: {
+      const Curves *curves_id = static_cast<const CurveComponent &>(component).get();
+      if (curves_id == nullptr) {
+        return nullptr;
+      }
+      const CurvesGeometry &curves = curves_id->geometry.wrap();
+      state->add_size(curves.points_num());
+      state->add_size(curves.curves_num());
+      state->add_array(-1, "", curves.curve_offsets, curves.runtime->curve_offsets_sharing_info);
+      state->add_custom_data(curves.point_data, ignored_names);
+      state->add_custom_data(curves.curve_data, ignored_names);
+      state->add_vertex_group_names(curves.vertex_group_names);
+      state->add_materials({curves_id->mat, curves_id->totcol});
+      break;
+    }
+    case GeometryComponent::Type::PointCloud: {
+      const PointCloud *pointcloud = static_cast<const PointCloudComponent &>(component).get();
+      if (pointcloud == nullptr) {
+        return nullptr;
+      }
+      state->add_size(pointcloud->totpoint);
+      state->add_custom_data(pointcloud->pdata, ignored_names);
+      state->add_materials({pointcloud->mat, pointcloud->totcol});
+      break;
+    }
+    default:
+      return nullptr;
+  }
+  if (!state->is_valid()) {
+    return nullptr;
+  }
+  return state;
+}
+
+class CapturedFieldsCache {
+ public:
+  struct Entry : NonCopyable, NonMovable {
+    Vector<fn::GField> fields;
+    AttrDomain domain;
+    std::unique_ptr<GeometryDataState> state;
+    /** The captured array of every field. The entry owns a user of each of them. */
+    Vector<ImplicitSharingInfoAndData> results;
+
+    Entry() = default;
+    ~Entry()
+    {
+      for (const ImplicitSharingInfoAndData &result : results) {
+        result.sharing_info->remove_user_and_delete_if_last();
+      }
+    }
+  };
+
+  /** The most recently used entries are at the end. */
+  Vector<std::unique_ptr<Entry>> entries;
+};
+
+/** Only a few entries are kept, e.g. for multiple capture nodes in a repeat zone. */
+static constexpr int captured_fields_cache_size = 4;
+
+static bool captured_fields_can_be_cached(const GeometryComponent &component,
+                                          const Span<AttributeIDRef> attribute_ids,
+                                          const fn::Field<bool> &selection)
+{
+  if (!ELEM(component.type(),
+            GeometryComponent::Type::Mesh,
+            GeometryComponent::Type::Curve,
+            GeometryComponent::Type::PointCloud))
+  {
+    return false;
+  }
+  /* Named attributes may have validators or be builtin attributes that can't be shared. */
+  for (const AttributeIDRef &id : attribute_ids) {
+    if (!id.is_anonymous()) {
+      return false;
+    }
+  }
+  return !selection.node().depends_on_input() && fn::evaluate_constant_field(selection);
+}
+
+/** The names of the attributes that are captured but not read by any of the fields. */
+static Vector<StringRef> get_unread_attribute_names(const Span<AttributeIDRef> attribute_ids,
+                                                    const Span<fn::GField> fields)
+{
+  Set<StringRef> read_names;
+  for (const fn::GField &field : fields) {
+    if (const std::shared_ptr<const fn::FieldInputs> &inputs = field.node().field_inputs()) {
+      for (const fn::FieldInput &input : inputs->deduplicated_nodes) {
+        if (const auto *anonymous_input = dynamic_cast<const AnonymousAttributeFieldInput *>(
+                &input))
+        {
+          read_names.add(anonymous_input->anonymous_id()->name());
+        }
+      }
+    }
+  }
+  Vector<StringRef> names;
+  for (const AttributeIDRef &id : attribute_ids) {
+    if (!read_names.contains(id.name())) {
+      names.append(id.name());
+    }
+  }
+  return names;
+}
+
+/**
+ * Same as #try_capture_fields_on_geometry, but the results are reused when the same fields were
+ * captured on the component before and the data they depend on did not change. That is common in
+ * repeat zones, and for geometries that are kept alive across evaluations.
+ */
+static bool try_capture_fields_on_geometry_cached(GeometryComponent &component,
+                                                  const Span<AttributeIDRef> attribute_ids,
+                                                  const AttrDomain domain,
+                                                  const fn::Field<bool> &selection,
+                                                  const Span<fn::GField> fields)
+{
+  MutableAttributeAccessor attributes = *component.attributes_for_write();
+  const GeometryFieldContext field_context{component, domain};
+
+  const Vector<StringRef> ignored_names = get_unread_attribute_names(attribute_ids, fields);
+  std::unique_ptr<GeometryDataState> state = get_geometry_data_state(component, ignored_names);
+  if (!state) {
+    return try_capture_fields_on_geometry(
+        attributes, field_context, attribute_ids, domain, selection, fields);
+  }
+
+  if (!component.captured_fields_cache) {
+    component.captured_fields_cache = std::make_shared<CapturedFieldsCache>();
+  }
+  CapturedFieldsCache &cache = *component.captured_fields_cache;
+
+  for (const int entry_index : cache.entries.index_range()) {
+    const CapturedFieldsCache::Entry &entry = *cache.entries[entry_index];
+    if (entry.domain != domain || entry.fields.as_span() != fields || *entry.state != *state) {
+      continue;
+    }
+    bool success = true;
+    for (const int i : attribute_ids.index_range()) {
+      const eCustomDataType data_type = cpp_type_to_custom_data_type(fields[i].cpp_type());
+      const ImplicitSharingInfoAndData &result = entry.results[i];
+      attributes.remove(attribute_ids[i]);
+      success &= attributes.add(attribute_ids[i],
+                                domain,
+                                data_type,
+                                AttributeInitShared(result.data, *result.sharing_info));
+    }
+    std::unique_ptr<CapturedFieldsCache::Entry> used_entry = std::move(cache.entries[entry_index]);
+    cache.entries.remove(entry_index);
+    cache.entries.append(std::move(used_entry));
+    return success;
+  }
+
+  if (!try_capture_fields_on_geometry(
+          attributes, field_context, attribute_ids, domain, selection, fields))
+  {
+    return false;
+  }
+
+  auto entry = std::make_unique<CapturedFieldsCache::Entry>();
+  for (const AttributeIDRef &id : attribute_ids) {
+    const GAttributeReader reader = attributes.lookup(id);
+    if (!reader || reader.domain != domain || reader.sharing_info == nullptr ||
+        !reader.varray.is_span())
+    {
+      return true;
+    }
+    reader.sharing_info->add_user();
+    entry->results.append({reader.sharing_info, reader.varray.get_internal_span().data()});
+  }
+  entry->fields = fields;
+  entry->domain = domain;
+  entry->state = std::move(state);
+  if (cache.entries.size() == captured_fields_cache_size) {
+    cache.entries.remove(0);
+  }
+  cache.entries.append(std::move(entry));
+  return true;
+}
+
 bool try_capture_fields_on_geometry(GeometryComponent &component,
                                     const Span<AttributeIDRef> attribute_ids,
                                     const AttrDomain domain,
@@ -966,6 +1273,11 @@ bool try_capture_fields_on_geometry(GeometryComponent &component,
     return false;
   }
 
+  if (captured_fields_can_be_cached(component, attribute_ids, selection)) {
+    return try_capture_fields_on_geometry_cached(
+        component, attribute_ids, domain, selection, fields);
+  }
+
   MutableAttributeAccessor attributes = *component.attributes_for_write();
   const GeometryFieldContext field_context{component, domain};
   return try_capture_fields_on_geometry(
@@ -4,6 +4,7 @@
 
 #include "BLI_bounds.hh"
 #include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_task.hh"
 
 #include "BLT_translation.hh"
@@ -99,6 +100,7 @@ void GeometryComponent::delete_self()
 void GeometryComponent::delete_data_only()
 {
   this->clear();
+  this->captured_fields_cache.reset();
 }
 
 /** \} */
@@ -681,6 +683,7 @@ void GeometrySet::gather_attributes_for_propagation(
 static void gather_component_types_recursive(const GeometrySet &geometry_set,
                                              const bool include_instances,
                                              const bool ignore_empty,
+                                             Set<GeometryComponentPtr> &handled_instances,
                                              Vector<GeometryComponent::Type> &r_types)
 {
   for (const GeometryComponent *component : geometry_set.get_components()) {
@@ -698,9 +701,20 @@ static void gather_component_types_recursive(const GeometrySet &geometry_set,
   if (instances == nullptr) {
     return;
   }
+  /* Instances that are referenced many times only have to be checked once. The component is kept
+   * alive until the traversal is done, so that its address can't be reused by temporary instances
+   * of collections. */
+  const InstancesComponent &instances_component =
+      *geometry_set.get_component<InstancesComponent>();
+  instances_component.add_user();
+  if (!handled_instances.add(
+          GeometryComponentPtr(const_cast<InstancesComponent *>(&instances_component))))
+  {
+    return;
+  }
   instances->foreach_referenced_geometry([&](const GeometrySet &instance_geometry_set) {
     gather_component_types_recursive(
-        instance_geometry_set, include_instances, ignore_empty, r_types);
+        instance_geometry_set, include_instances, ignore_empty, handled_instances, r_types);
   });
 }
 
@@ -708,33 +722,96 @@ Vector<GeometryComponent::Type> GeometrySet::gather_component_types(const bool i
                                                                     bool ignore_empty) const
 {
   Vector<GeometryComponent::Type> types;
-  gather_component_types_recursive(*this, include_instances, ignore_empty, types);
+  Set<GeometryComponentPtr> handled_instances;
+  gather_component_types_recursive(
+      *this, include_instances, ignore_empty, handled_instances, types);
   return types;
 }
 
-static void gather_mutable_geometry_sets(GeometrySet &geometry_set,
-                                         Vector<GeometrySet *> &r_geometry_sets)
-{
-  r_geometry_sets.append(&geometry_set);
-  if (!geometry_set.has_instances()) {
-    return;
+/**
+ * Geometry sets that reference the same components are equal. This is the case when the same
+ * geometry is instanced by different instance components, e.g. in nested instancing.
+ */
+struct GeometrySetIdentity {
+  std::array<const GeometryComponent *, GEO_COMPONENT_TYPE_ENUM_SIZE> components;
+
+  GeometrySetIdentity(const GeometrySet &geometry_set)
+  {
+    for (const int i : IndexRange(GEO_COMPONENT_TYPE_ENUM_SIZE)) {
+      components[i] = geometry_set.get_component(GeometryComponent::Type(i));
+    }
   }
-  /* In the future this can be improved by deduplicating instance references across different
-   * instances. */
-  Instances &instances = *geometry_set.get_instances_for_write();
-  instances.ensure_geometry_instances();
-  for (const int handle : instances.references().index_range()) {
-    if (instances.references()[handle].type() == InstanceReference::Type::GeometrySet) {
-      GeometrySet &instance_geometry = instances.geometry_set_from_reference(handle);
-      gather_mutable_geometry_sets(instance_geometry, r_geometry_sets);
+
+  uint64_t hash() const
+  {
+    uint64_t hash = 0;
+    for (const GeometryComponent *component : components) {
+      hash = hash * 33 ^ get_default_hash(component);
     }
+    return hash;
+  }
+
+  friend bool operator==(const GeometrySetIdentity &a, const GeometrySetIdentity &b)
+  {
+    return a.components == b.components;
+  }
+};
+
+/**
+ * Gather the geometry sets that have to be modified, one nesting level at a time. Referenced
+ * geometry sets that are equal to one that has been found already are only modified once. They
+ * are added to `r_duplicates` together with the geometry set that they are equal to.
+ */
+static void gather_mutable_geometry_sets(
+    GeometrySet &geometry_set,
+    Vector<GeometrySet *> &r_geometry_sets,
+    Vector<std::pair<GeometrySet *, const GeometrySet *>> &r_duplicates)
+{
+  Map<GeometrySetIdentity, GeometrySet *> unique_geometry_sets;
+  Vector<GeometrySet *> current_level = {&geometry_set};
+  while (!current_level.is_empty()) {
+    r_geometry_sets.extend(current_level);
+    /* Converting object and collection references to geometry sets can be expensive, so it is
+     * done for all geometry sets of a nesting level in parallel. */
+    threading::parallel_for(current_level.index_range(), 1, [&](const IndexRange range) {
+      for (GeometrySet *geometry_set : current_level.as_span().slice(range)) {
+        if (geometry_set->has_instances()) {
+          geometry_set->get_instances_for_write()->ensure_geometry_instances();
+        }
+      }
+    });
+    Vector<GeometrySet *> next_level;
+    for (GeometrySet *geometry_set : current_level) {
+      if (!geometry_set->has_instances()) {
+        continue;
+      }
+      Instances &instances = *geometry_set->get_instances_for_write();
+      for (const int handle : instances.references().index_range()) {
+        if (instances.references()[handle].type() != InstanceReference::Type::GeometrySet) {
+          continue;
+        }
+        GeometrySet &instance_geometry = instances.geometry_set_from_reference(handle);
+        /* The identity has to be found before instances of the geometry are made mutable, which
+         * may copy them. */
+        const GeometrySet *first = unique_geometry_sets.lookup_or_add(
+            GeometrySetIdentity(instance_geometry), &instance_geometry);
+        if (first == &instance_geometry) {
+          next_level.append(&instance_geometry);
+        }
+        else {
+          r_duplicates.append({&instance_geometry, first});
+        }
+      }
+    }
+    current_level = std::move(next_level);
   }
 }
 
 void GeometrySet::modify_geometry_sets(ForeachSubGeometryCallback callback)
 {
   Vector<GeometrySet *> geometry_sets;
-  gather_mutable_geometry_sets(*this, geometry_sets);
+  Vector<std::pair<GeometrySet *, const GeometrySet *>> duplicates;
+  gather_mutable_geometry_sets(*this, geometry_sets, duplicates);
   if (geometry_sets.size() == 1) {
     /* Avoid possible overhead and a large call stack when multithreading is pointless. */
     callback(*geometry_sets.first());
@@ -743,6 +820,11 @@ void GeometrySet::modify_geometry_sets(ForeachSubGeometryCallback callback)
     threading::parallel_for_each(geometry_sets,
                                  [&](GeometrySet *geometry_set) { callback(*geometry_set); });
   }
+  /* Share the result with the geometry sets that were equal before they were modified. The
+   * nested instances of the result have been modified already as well. */
+  for (const auto &[geometry_set, first] : duplicates) {
+    *geometry_set = *first;
+  }
 }
 
 bool object_has_geometry_set_instances(const Object &object)
@@ -9,6 +9,8 @@
 #include <iostream>
 #include <optional>
 
+#include <xxhash.h>
+
 #include "BKE_action.h"
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -27,6 +29,7 @@
 #include "BKE_object.hh"
 #include "BKE_object_types.hh"
 
+#include "BLI_array.hh"
 #include "BLI_bounds.hh"
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_map.hh"
@@ -37,6 +40,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_memarena.h"
 #include "BLI_memory_utils.hh"
+#include "BLI_noise.hh"
 #include "BLI_polyfill_2d.h"
 #include "BLI_span.hh"
 #include "BLI_stack.hh"
@@ -54,6 +58,7 @@
 #include "DNA_ID.h"
 #include "DNA_ID_enums.h"
 #include "DNA_brush_types.h"
+#include "DNA_color_types.h"
 #include "DNA_defaults.h"
 #include "DNA_gpencil_modifier_types.h"
 #include "DNA_grease_pencil_types.h"
@@ -336,6 +341,12 @@ static MutableSpan<T> get_mutable_attribute(CurvesGeometry &curves,
   return span;
 }
 
+static uint64_t next_geometry_stamp()
+{
+  static std::atomic<uint64_t> stamp = 0;
+  return ++stamp;
+}
+
 Drawing::Drawing()
 {
   this->base.type = GP_DRAWING;
@@ -344,6 +355,7 @@ Drawing::Drawing()
   new (&this->geometry) bke::CurvesGeometry();
   /* Initialize runtime data. */
   this->runtime = MEM_new<bke::greasepencil::DrawingRuntime>(__func__);
+  this->runtime->geometry_stamp = next_geometry_stamp();
 }
 
 Drawing::Drawing(const Drawing &other)
@@ -358,6 +370,10 @@ Drawing::Drawing(const Drawing &other)
   this->runtime->triangles_cache = other.runtime->triangles_cache;
   this->runtime->curve_plane_normals_cache = other.runtime->curve_plane_normals_cache;
   this->runtime->curve_texture_matrices = other.runtime->curve_texture_matrices;
+  this->runtime->curve_bounds_cache = other.runtime->curve_bounds_cache;
+  /* The geometry is the same, so the copy keeps the stamp until it is modified. */
+  this->runtime->geometry_stamp = other.runtime->geometry_stamp;
+  this->runtime->batch_data = other.runtime->batch_data;
 }
 
 Drawing::Drawing(Drawing &&other)
@@ -510,6 +526,24 @@ Span<float3> Drawing::curve_plane_normals() const
   return this->runtime->curve_plane_normals_cache.data().as_span();
 }
 
+Span<Bounds<float3>> Drawing::curve_bounds() const
+{
+  this->runtime->curve_bounds_cache.ensure([&](Vector<Bounds<float3>> &r_data) {
+    const CurvesGeometry &curves = this->strokes();
+    const Span<float3> positions = curves.positions();
+    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+
+    r_data.reinitialize(curves.curves_num());
+    threading::parallel_for(curves.curves_range(), 512, [&](const IndexRange range) {
+      for (const int curve_i : range) {
+        r_data[curve_i] = bounds::min_max(positions.slice(points_by_curve[curve_i]))
+                              .value_or(Bounds<float3>(float3(0.0f)));
+      }
+    });
+  });
+  return this->runtime->curve_bounds_cache.data().as_span();
+}
+
 /*
  * Returns the matrix that transforms from a 3D point in layer-space to a 2D point in
  * stroke-space for the stroke `curve_i`
@@ -718,6 +752,7 @@ const bke::CurvesGeometry &Drawing::strokes() const
 
 bke::CurvesGeometry &Drawing::strokes_for_write()
 {
+  this->runtime->geometry_stamp = next_geometry_stamp();
   return this->geometry.wrap();
 }
 
@@ -785,15 +820,37 @@ MutableSpan<int> Drawing::seeds_for_write()
       this->strokes_for_write(), AttrDomain::Curve, ATTR_ONDINE_SEED, 0);
 }
 
-void Drawing::ensure_unique_seeds()
+static int stroke_seed_from_index(const int index, const int attempt)
+{
+  const int seed = int(noise::hash(uint32_t(index), uint32_t(attempt)) & 0x7fffffff);
+  return (seed == 0) ? 1 : seed;
+}
+
+void Drawing::ensure_unique_seeds(const int seed_offset)
 {
-  MutableSpan<int> seeds = this->seeds_for_write();
   Set<int> used_seeds;
-  for (const int seed_i : seeds.index_range()) {
-    while (seeds[seed_i] == 0 || used_seeds.contains(seeds[seed_i])) {
-      seeds[seed_i] = rand() * 4096 + rand();
+  Vector<int> invalid_curves;
+  {
+    const VArraySpan<int> seeds = this->seeds();
+    used_seeds.reserve(seeds.size());
+    for (const int curve_i : seeds.index_range()) {
+      if (seeds[curve_i] == 0 || !used_seeds.add(seeds[curve_i])) {
+        invalid_curves.append(curve_i);
+      }
     }
-    used_seeds.add(seeds[seed_i]);
+  }
+  if (invalid_curves.is_empty()) {
+    return;
+  }
+
+  MutableSpan<int> seeds = this->seeds_for_write();
+  for (const int curve_i : invalid_curves) {
+    int attempt = 0;
+    int seed;
+    do {
+      seed = stroke_seed_from_index(seed_offset + curve_i, attempt++);
+    } while (!used_seeds.add(seed));
+    seeds[curve_i] = seed;
   }
 }
 
@@ -819,6 +876,7 @@ void Drawing::tag_positions_changed()
   this->strokes_for_write().tag_positions_changed();
   this->runtime->triangles_cache.tag_dirty();
   this->runtime->curve_plane_normals_cache.tag_dirty();
+  this->runtime->curve_bounds_cache.tag_dirty();
   this->tag_texture_matrices_changed();
 }
 
@@ -1920,11 +1978,260 @@ void BKE_grease_pencil_nomain_to_grease_pencil(GreasePencil *grease_pencil_src,
   BKE_id_free(nullptr, grease_pencil_src);
 }
 
+/**
+ * Ondine: drawing modifiers of which the result only depends on the drawing and on the modifier
+ * settings, not on the frame, the object transform or other objects.
+ */
+static bool grease_pencil_modifier_is_frame_independent(const ModifierData &md)
+{
+  switch (ModifierType(md.type)) {
+    case eModifierType_GreasePencilColor:
+    case eModifierType_GreasePencilDash:
+    case eModifierType_GreasePencilEnvelope:
+    case eModifierType_GreasePencilOffset:
+    case eModifierType_GreasePencilOpacity:
+    case eModifierType_GreasePencilSimplify:
+    case eModifierType_GreasePencilSmooth:
+    case eModifierType_GreasePencilSubdiv:
+    case eModifierType_GreasePencilTexture:
+    case eModifierType_GreasePencilThickness:
+      return true;
+    case eModifierType_GreasePencilArray:
+      return reinterpret_cast<const GreasePencilArrayModifierData &>(md).object == nullptr;
+    case eModifierType_GreasePencilMirror:
+      return reinterpret_cast<const GreasePencilMirrorModifierData &>(md).object == nullptr;
+    case eModifierType_GreasePencilTint:
+      return reinterpret_cast<const GreasePencilTintModifierData &>(md).object == nullptr;
+    default:
+      return false;
+  }
+}
+
+/** Ondine: hash the contents of a curve mapping, instead of the pointer to it. */
+static uint64_t curve_mapping_hash(const CurveMapping *curve_mapping, uint64_t hash)
+{
+  if (curve_mapping == nullptr) {
+    return hash;
+  }
+  hash = XXH3_64bits_withSeed(&curve_mapping->flag, sizeof(curve_mapping->flag), hash);
+  hash = XXH3_64bits_withSeed(&curve_mapping->clipr, sizeof(curve_mapping->clipr), hash);
+  for (const CurveMap &curve_map : curve_mapping->cm) {
+    hash = XXH3_64bits_withSeed(&curve_map.totpoint, sizeof(curve_map.totpoint), hash);
+    if (curve_map.curve != nullptr) {
+      hash = XXH3_64bits_withSeed(
+          curve_map.curve, sizeof(CurveMapPoint) * size_t(curve_map.totpoint), hash);
+    }
+  }
+  return hash;
+}
+
+/**
+ * Ondine: hash of the settings of a drawing modifier. Pointers to embedded data (the influence
+ * curve, the tint color ramp and the dash segments) are replaced by the data they point to, since
+ * that data can change in place and is reallocated on every copy of the modifier.
+ */
+static uint64_t grease_pencil_modifier_settings_hash(const ModifierData &md, uint64_t hash)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md.type));
+  /* All frame independent modifiers start with the influence settings. */
+  blender::Array<char> settings(mti->struct_size);
+  memcpy(settings.data(), &md, settings.size());
+  auto &influence = *reinterpret_cast<GreasePencilModifierInfluenceData *>(settings.data() +
+                                                                            sizeof(ModifierData));
+  hash = curve_mapping_hash(influence.custom_curve, hash);
+  influence.custom_curve = nullptr;
+  if (ModifierType(md.type) == eModifierType_GreasePencilTint) {
+    auto &tmd = *reinterpret_cast<GreasePencilTintModifierData *>(settings.data());
+    if (tmd.color_ramp != nullptr) {
+      hash = XXH3_64bits_withSeed(tmd.color_ramp, sizeof(ColorBand), hash);
+    }
+    tmd.color_ramp = nullptr;
+  }
+  if (ModifierType(md.type) == eModifierType_GreasePencilDash) {
+    auto &dmd = *reinterpret_cast<GreasePencilDashModifierData *>(settings.data());
+    const blender::Span<GreasePencilDashModifierSegment> segments = dmd.segments();
+    hash = XXH3_64bits_withSeed(segments.data(), segments.size_in_bytes(), hash);
+    dmd.segments_array = nullptr;
+  }
+  /* Hash the settings, which follow the common #ModifierData header. */
+  return XXH3_64bits_withSeed(settings.data() + sizeof(ModifierData),
+                              settings.size() - sizeof(ModifierData),
+                              hash);
+}
+
+/**
+ * Ondine: hash of the inputs of the modifier layer and material filters that are not part of the
+ * modifier settings: the layer names and pass indices, and the materials and their pass indices.
+ */
+static uint64_t grease_pencil_modifier_filters_hash(const Object &object,
+                                                    const GreasePencil &grease_pencil,
+                                                    uint64_t hash)
+{
+  using namespace blender;
+  for (const bke::greasepencil::Layer *layer : grease_pencil.layers()) {
+    const StringRefNull name = layer->name();
+    hash = XXH3_64bits_withSeed(name.data(), name.size(), hash);
+  }
+  const VArraySpan<int> layer_passes = *grease_pencil.attributes().lookup_or_default<int>(
+      "pass_index", bke::AttrDomain::Layer, 0);
+  hash = XXH3_64bits_withSeed(layer_passes.data(), layer_passes.size_in_bytes(), hash);
+
+  Object *ob = const_cast<Object *>(&object);
+  const short materials_num = *BKE_object_material_len_p(ob);
+  for (const int material_i : IndexRange(materials_num)) {
+    const Material *material = BKE_object_material_get(ob, material_i + 1);
+    const int material_pass = (material && material->gp_style) ? material->gp_style->index : 0;
+    hash = XXH3_64bits_withSeed(&material, sizeof(material), hash);
+    hash = XXH3_64bits_withSeed(&material_pass, sizeof(material_pass), hash);
+  }
+  return hash;
+}
+
+/**
+ * Ondine: hash of the enabled drawing modifiers, or nothing when their result can't be cached
+ * (see #grease_pencil_modifier_is_frame_independent) or when there are no drawing modifiers.
+ */
+static std::optional<uint64_t> grease_pencil_drawing_modifiers_hash(
+    const Scene *scene,
+    const Object &object,
+    const GreasePencil &grease_pencil,
+    ModifierData *md,
+    const ModifierMode required_mode)
+{
+  /* Random seeds of the modifiers are derived from the object and modifier names. */
+  uint64_t hash = XXH3_64bits(object.id.name, sizeof(object.id.name));
+  hash = XXH3_64bits_withSeed(&required_mode, sizeof(required_mode), hash);
+  bool has_drawing_modifiers = false;
+  for (; md; md = md->next) {
+    if (!BKE_modifier_is_enabled(scene, md, required_mode) ||
+        ModifierType(md->type) == eModifierType_GreasePencilTime)
+    {
+      continue;
+    }
+    if (!grease_pencil_modifier_is_frame_independent(*md)) {
+      return std::nullopt;
+    }
+    hash = XXH3_64bits_withSeed(&md->type, sizeof(md->type), hash);
+    hash = XXH3_64bits_withSeed(md->name, sizeof(md->name), hash);
+    hash = grease_pencil_modifier_settings_hash(*md, hash);
+    has_drawing_modifiers = true;
+  }
+  if (!has_drawing_modifiers) {
+    return std::nullopt;
+  }
+  return grease_pencil_modifier_filters_hash(object, grease_pencil, hash);
+}
+
+/**
+ * Ondine: get the cache keys of the drawings shown on the evaluated frame, after the time
+ * modifiers. Layers without a drawing get a negative layer index.
+ */
+static blender::Vector<blender::bke::greasepencil::EvalDrawingCacheKey> eval_drawing_cache_keys(
+    const GreasePencil &grease_pencil, const uint64_t modifiers_hash)
+{
+  using namespace blender;
+  using namespace blender::bke::greasepencil;
+  const Span<const Layer *> layers = grease_pencil.layers();
+  Vector<EvalDrawingCacheKey> keys(layers.size());
+  for (const int layer_i : layers.index_range()) {
+    const Drawing *drawing = grease_pencil.get_eval_drawing(*layers[layer_i]);
+    if (drawing == nullptr) {
+      keys[layer_i] = {-1, 0, modifiers_hash};
+      continue;
+    }
+    keys[layer_i] = {layer_i, drawing->runtime->geometry_stamp, modifiers_hash};
+  }
+  return keys;
+}
+
+/**
+ * Ondine: replace the drawings of the evaluated frame with the cached result of the drawing
+ * modifiers. Only done when the results of all the layers are cached, since the modifiers are
+ * evaluated for all layers at once.
+ */
+static bool eval_drawing_cache_apply(
+    blender::bke::greasepencil::EvalDrawingCache &cache,
+    const blender::Span<blender::bke::greasepencil::EvalDrawingCacheKey> keys,
+    blender::bke::GeometrySet &geometry_set)
+{
+  using namespace blender;
+  using namespace blender::bke::greasepencil;
+  std::scoped_lock lock(cache.mutex);
+  for (const EvalDrawingCacheKey &key : keys) {
+    if (key.layer_index >= 0 && !cache.items.contains(key)) {
+      return false;
+    }
+  }
+
+  GreasePencil &grease_pencil = *geometry_set.get_grease_pencil_for_write();
+  const Span<const Layer *> layers = grease_pencil.layers();
+  cache.use_counter++;
+  for (const EvalDrawingCacheKey &key : keys) {
+    if (key.layer_index < 0) {
+      continue;
+    }
+    EvalDrawingCache::Item &item = *cache.items.lookup(key);
+    item.last_use = cache.use_counter;
+    /* Copying a drawing shares its geometry and keeps its caches and geometry stamp, so the draw
+     * caches of the previous evaluation remain valid too. */
+    *grease_pencil.get_eval_drawing(*layers[key.layer_index]) = item.drawing;
+  }
+  return true;
+}
+
+static void eval_drawing_cache_store(
+    blender::bke::greasepencil::EvalDrawingCache &cache,
+    const blender::Span<blender::bke::greasepencil::EvalDrawingCacheKey> keys,
+    const blender::bke::GeometrySet &geometry_set)
+{
+  using namespace blender;
+  using namespace blender::bke::greasepencil;
+  const GreasePencil *grease_pencil = geometry_set.get_grease_pencil();
+  if (grease_pencil == nullptr || grease_pencil->layers().size() != keys.size()) {
+    return;
+  }
+  const Span<const Layer *> layers = grease_pencil->layers();
+
+  std::scoped_lock lock(cache.mutex);
+  cache.use_counter++;
+  for (const EvalDrawingCacheKey &key : keys) {
+    if (key.layer_index < 0) {
+      continue;
+    }
+    const Drawing *drawing = grease_pencil->get_eval_drawing(*layers[key.layer_index]);
+    if (drawing == nullptr) {
+      continue;
+    }
+    cache.items.add_overwrite(key,
+                              std::make_unique<EvalDrawingCache::Item>(
+                                  EvalDrawingCache::Item{*drawing, cache.use_counter}));
+  }
+
+  if (cache.items.size() <= EvalDrawingCache::max_size) {
+    return;
+  }
+  /* Remove the least recently used drawings. Leave some room, so that the sorting doesn't happen
+   * on every evaluation. */
+  Vector<std::pair<uint64_t, EvalDrawingCacheKey>> uses;
+  for (const auto item : cache.items.items()) {
+    uses.append({item.value->last_use, item.key});
+  }
+  std::sort(uses.begin(), uses.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  const int remove_num = cache.items.size() - EvalDrawingCache::max_size * 3 / 4;
+  for (const int i : IndexRange(remove_num)) {
+    cache.items.remove(uses[i].second);
+  }
+}
+
 static void grease_pencil_evaluate_modifiers(Depsgraph *depsgraph,
                                              Scene *scene,
                                              Object *object,
                                              blender::bke::GeometrySet &geometry_set)
 {
+  using namespace blender;
+  using namespace blender::bke::greasepencil;
   /* Modifier evaluation modes. */
   const bool use_render = DEG_get_mode(depsgraph) == DAG_EVAL_RENDER;
   ModifierMode required_mode = use_render ? eModifierMode_Render : eModifierMode_Realtime;
@@ -1960,6 +2267,28 @@ static void grease_pencil_evaluate_modifiers(Depsgraph *depsgraph,
     }
   }
 
+  /* Ondine: during playback, frames that show a drawing that was already evaluated (held frames,
+   * looped time offsets) reuse the result of the drawing modifiers. The cache is stored on the
+   * evaluated copy of the original data-block, which is only recreated when the data changes. */
+  GreasePencil &grease_pencil_input = *static_cast<GreasePencil *>(object->data);
+  std::optional<uint64_t> modifiers_hash;
+  if (!BKE_object_is_in_editmode(object) && geometry_set.has_grease_pencil()) {
+    modifiers_hash = grease_pencil_drawing_modifiers_hash(
+        scene, *object, *geometry_set.get_grease_pencil(), md, required_mode);
+  }
+  Vector<EvalDrawingCacheKey> cache_keys;
+  if (modifiers_hash) {
+    if (!grease_pencil_input.runtime->eval_drawing_cache) {
+      grease_pencil_input.runtime->eval_drawing_cache = std::make_unique<EvalDrawingCache>();
+    }
+    cache_keys = eval_drawing_cache_keys(*geometry_set.get_grease_pencil(), *modifiers_hash);
+    if (eval_drawing_cache_apply(
+            *grease_pencil_input.runtime->eval_drawing_cache, cache_keys, geometry_set))
+    {
+      return;
+    }
+  }
+
   /* Evaluate drawing modifiers. */
   for (; md; md = md->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
@@ -1974,6 +2303,11 @@ static void grease_pencil_evaluate_modifiers(Depsgraph *depsgraph,
       mti->modify_geometry_set(md, &mectx, &geometry_set);
     }
   }
+
+  if (modifiers_hash) {
+    eval_drawing_cache_store(
+        *grease_pencil_input.runtime->eval_drawing_cache, cache_keys, geometry_set);
+  }
 }
 
 void BKE_grease_pencil_data_update(Depsgraph *depsgraph, Scene *scene, Object *object)
@@ -3474,7 +3808,7 @@ static void read_drawing_array(GreasePencil &grease_pencil, BlendDataReader *rea
     switch (GreasePencilDrawingType(drawing_base->type)) {
       case GP_DRAWING: {
         GreasePencilDrawing *drawing = reinterpret_cast<GreasePencilDrawing *>(drawing_base);
-        drawing->wrap().strokes_for_write().blend_read(*reader);
+        drawing->geometry.wrap().blend_read(*reader);
         /* Initialize runtime data. */
         drawing->runtime = MEM_new<blender::bke::greasepencil::DrawingRuntime>(__func__);
         break;
@@ -3496,9 +3830,9 @@ static void write_drawing_array(GreasePencil &grease_pencil, BlendWriter *writer
       case GP_DRAWING: {
         GreasePencilDrawing *drawing = reinterpret_cast<GreasePencilDrawing *>(drawing_base);
         bke::CurvesGeometry::BlendWriteData write_data =
-            drawing->wrap().strokes_for_write().blend_write_prepare();
+            drawing->geometry.wrap().blend_write_prepare();
         BLO_write_struct(writer, GreasePencilDrawing, drawing);
-        drawing->wrap().strokes_for_write().blend_write(*writer, grease_pencil.id, write_data);
+        drawing->geometry.wrap().blend_write(*writer, grease_pencil.id, write_data);
         break;
       }
       case GP_DRAWING_REFERENCE: {
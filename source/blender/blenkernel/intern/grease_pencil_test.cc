@@ -4,6 +4,7 @@
 
 #include "testing/testing.h"
 
+#include "BLI_set.hh"
 #include "BLI_string.h"
 
 #include "BKE_curves.hh"
@@ -485,4 +486,49 @@ TEST(greasepencil, remove_drawings_with_no_users)
   BKE_id_free(nullptr, grease_pencil);
 }
 
+/* --------------------------------------------------------------------------------------------- */
+/* Drawing Seed Tests. */
+
+TEST(greasepencil, ensure_unique_seeds)
+{
+  Drawing drawing;
+  drawing.strokes_for_write().resize(8, 4);
+  MutableSpan<int> seeds = drawing.seeds_for_write();
+  seeds[0] = 42;
+  seeds[1] = 42;
+  seeds[2] = 7;
+
+  drawing.ensure_unique_seeds(100);
+  const VArraySpan<int> unique_seeds = drawing.seeds();
+  /* Unique seeds are kept. */
+  EXPECT_EQ(unique_seeds[0], 42);
+  EXPECT_EQ(unique_seeds[2], 7);
+  Set<int> used_seeds;
+  for (const int seed : unique_seeds) {
+    EXPECT_NE(seed, 0);
+    EXPECT_TRUE(used_seeds.add(seed));
+  }
+
+  /* New seeds only depend on the stroke index and the offset. */
+  Drawing other_drawing;
+  other_drawing.strokes_for_write().resize(8, 4);
+  other_drawing.seeds_for_write()[0] = 42;
+  other_drawing.seeds_for_write()[1] = 42;
+  other_drawing.seeds_for_write()[2] = 7;
+  other_drawing.ensure_unique_seeds(100);
+  const VArraySpan<int> other_seeds = other_drawing.seeds();
+  EXPECT_EQ_ARRAY(unique_seeds.data(), other_seeds.data(), unique_seeds.size());
+}
+
+TEST(greasepencil, ensure_unique_seeds_no_change)
+{
+  Drawing drawing;
+  drawing.strokes_for_write().resize(4, 2);
+  drawing.ensure_unique_seeds();
+  const uint64_t stamp = drawing.runtime->geometry_stamp;
+  /* Seeds are unique already, so the geometry isn't touched. */
+  drawing.ensure_unique_seeds();
+  EXPECT_EQ(drawing.runtime->geometry_stamp, stamp);
+}
+
 }  // namespace blender::bke::greasepencil::tests
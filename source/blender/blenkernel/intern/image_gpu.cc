@@ -6,6 +6,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_boxpack_2d.h"
@@ -13,6 +15,7 @@
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -580,11 +583,75 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+static size_t image_gpu_memory_size(const Image &ima)
+{
+  size_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      if (ima.gputexture[i][eye] != nullptr) {
+        size += GPU_texture_memory_size(ima.gputexture[i][eye]);
+      }
+    }
+  }
+  return size;
+}
+
+/**
+ * Free the GPU textures of the least recently used images until the memory used by image
+ * textures fits in the limit set in the preferences. Images used during the current second are
+ * kept, because the next redraw would upload them again.
+ */
+static void image_free_gputextures_over_limit(Main *bmain, const int ctime)
+{
+  static int lasttime = 0;
+  if (U.texmemlimit == 0 || ctime == lasttime) {
+    return;
+  }
+  lasttime = ctime;
+
+  struct ImageGPUMemory {
+    Image *ima;
+    size_t size;
+  };
+  blender::Vector<ImageGPUMemory> images;
+  size_t total_size = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const size_t size = image_gpu_memory_size(*ima);
+    total_size += size;
+    if (size > 0 && (ima->flag & IMA_NOCOLLECT) == 0 && ima->lastused < ctime) {
+      images.append({ima, size});
+    }
+  }
+
+  const size_t limit = size_t(U.texmemlimit) * 1024 * 1024;
+  if (total_size <= limit) {
+    return;
+  }
+
+  std::sort(images.begin(), images.end(), [](const ImageGPUMemory &a, const ImageGPUMemory &b) {
+    return a.ima->lastused < b.ima->lastused;
+  });
+  for (const ImageGPUMemory &image : images) {
+    if (total_size <= limit) {
+      break;
+    }
+    BKE_image_free_gputextures(image.ima);
+    total_size -= image.size;
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = int(BLI_time_now_seconds());
 
+  /* of course not! */
+  if (G.is_rendering) {
+    return;
+  }
+
+  image_free_gputextures_over_limit(bmain, ctime);
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
@@ -593,11 +660,6 @@ void BKE_image_free_old_gputextures(Main *bmain)
     return;
   }
 
-  /* of course not! */
-  if (G.is_rendering) {
-    return;
-  }
-
   lasttime = ctime;
 
   LISTBASE_FOREACH (Image *, ima, &bmain->images) {
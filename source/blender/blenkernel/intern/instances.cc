@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "BLI_array_utils.hh"
+#include "BLI_local_allocator.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
 
@@ -223,11 +224,15 @@ void Instances::remove_unused_references()
 
   Array<bool> usage_by_handle(tot_references_before, false);
   std::mutex mutex;
+  LocalAllocatorSet allocators;
 
   /* Loop over all instances to see which references are used. */
   threading::parallel_for(IndexRange(tot_instances), 1000, [&](IndexRange range) {
     /* Use local counter to avoid lock contention. */
-    Array<bool> local_usage_by_handle(tot_references_before, false);
+    LocalAllocator &allocator = allocators.local();
+    MutableSpan<bool> local_usage_by_handle = allocator.allocate_array<bool>(
+        tot_references_before);
+    local_usage_by_handle.fill(false);
 
     for (const int i : range) {
       const int handle = reference_handles[i];
@@ -235,10 +240,13 @@ void Instances::remove_unused_references()
       local_usage_by_handle[handle] = true;
     }
 
-    std::lock_guard lock{mutex};
-    for (const int i : IndexRange(tot_references_before)) {
-      usage_by_handle[i] |= local_usage_by_handle[i];
+    {
+      std::lock_guard lock{mutex};
+      for (const int i : IndexRange(tot_references_before)) {
+        usage_by_handle[i] |= local_usage_by_handle[i];
+      }
     }
+    allocator.deallocate_array(local_usage_by_handle);
   });
 
   if (!usage_by_handle.as_span().contains(false)) {
@@ -15,6 +15,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
+#include "BLI_index_mask.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.hh"
@@ -1612,11 +1613,20 @@ float *BKE_key_evaluate_object_ex(
   if (obdata != nullptr) {
     switch (GS(obdata->name)) {
       case ID_ME: {
+        using namespace blender;
         Mesh *mesh = (Mesh *)obdata;
         const int totvert = min_ii(tot, mesh->verts_num);
-        mesh->vert_positions_for_write().take_front(totvert).copy_from(
-            {reinterpret_cast<const blender::float3 *>(out), totvert});
-        mesh->tag_positions_changed();
+        const Span<float3> new_positions(reinterpret_cast<const float3 *>(out), totvert);
+        MutableSpan<float3> positions = mesh->vert_positions_for_write().take_front(totvert);
+        /* Shape keys often only move part of the mesh. Only the normals of that part have to be
+         * updated. */
+        IndexMaskMemory memory;
+        const IndexMask changed_verts = IndexMask::from_predicate(
+            positions.index_range(), GrainSize(4096), memory, [&](const int i) {
+              return positions[i] != new_positions[i];
+            });
+        positions.copy_from(new_positions);
+        mesh->tag_positions_changed(changed_verts);
         break;
       }
       case ID_LT: {
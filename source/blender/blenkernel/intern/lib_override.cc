@@ -816,9 +816,34 @@ struct LibOverrideGroupTagData {
   GHash *linked_object_to_instantiating_collections;
   MemArena *mem_arena;
 
+  /**
+   * All relations entries tagged as processed by the hierarchy traversals, so that these tags can
+   * be cleared without looping over all entries of the Main relations. This matters when many
+   * hierarchies are processed one after the other, e.g. when resyncing. */
+  blender::Vector<MainIDRelationsEntry *> processed_relations_entries;
+
+  void relations_entry_tag_processed(MainIDRelationsEntry *entry,
+                                     const eMainIDRelationsEntryTags processed_tag)
+  {
+    if ((entry->tags & MAINIDRELATIONS_ENTRY_TAGS_PROCESSED) == 0) {
+      processed_relations_entries.append(entry);
+    }
+    entry->tags |= processed_tag;
+  }
+  /** Same as clearing #MAINIDRELATIONS_ENTRY_TAGS_PROCESSED of all entries, assuming that it was
+   * only set through #relations_entry_tag_processed. */
+  void relations_processed_tags_clear()
+  {
+    for (MainIDRelationsEntry *entry : processed_relations_entries) {
+      entry->tags &= ~MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+    }
+    processed_relations_entries.clear();
+  }
+
   void clear()
   {
     linked_ids_hierarchy_default_override.clear();
+    processed_relations_entries.clear_and_shrink();
     BLI_ghash_free(linked_object_to_instantiating_collections, nullptr, nullptr);
     BLI_memarena_free(mem_arena);
 
@@ -950,7 +975,7 @@ static void lib_override_hierarchy_dependencies_recursive_tag_from(LibOverrideGr
   }
   /* This way we won't process again that ID, should we encounter it again through another
    * relationship hierarchy. */
-  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED_FROM;
+  data->relations_entry_tag_processed(entry, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED_FROM);
 
   for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != nullptr;
        from_id_entry = from_id_entry->next)
@@ -993,7 +1018,7 @@ static bool lib_override_hierarchy_dependencies_recursive_tag(LibOverrideGroupTa
   }
   /* This way we won't process again that ID, should we encounter it again through another
    * relationship hierarchy. */
-  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED_TO;
+  data->relations_entry_tag_processed(entry, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED_TO);
 
   for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != nullptr;
        to_id_entry = to_id_entry->next)
@@ -1042,7 +1067,7 @@ static void lib_override_linked_group_tag_recursive(LibOverrideGroupTagData *dat
   }
   /* This way we won't process again that ID, should we encounter it again through another
    * relationship hierarchy. */
-  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_PROCESSED;
+  data->relations_entry_tag_processed(entry, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED);
 
   for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != nullptr;
        to_id_entry = to_id_entry->next)
@@ -3285,11 +3310,13 @@ static bool lib_override_library_main_resync_on_library_indirect_level(
       continue;
     }
 
+    /* Only clear the processed tags of the relations visited for this hierarchy, clearing them
+     * in the whole Main for every overridden hierarchy gets very slow with many of them. */
     data.root_set(id->override_library->reference);
     lib_override_linked_group_tag(&data);
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    data.relations_processed_tags_clear();
     lib_override_hierarchy_dependencies_recursive_tag(&data);
-    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
+    data.relations_processed_tags_clear();
   }
   FOREACH_MAIN_ID_END;
   data.clear();
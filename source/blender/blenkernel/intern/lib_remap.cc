@@ -12,7 +12,9 @@
 
 #include "BLI_array.hh"
 #include "BLI_linklist.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_collection_types.h"
 #include "DNA_object_types.h"
@@ -461,6 +463,40 @@ static void libblock_remap_reset_remapping_status_fn(ID *old_id, ID *new_id)
   }
 }
 
+struct IDRemapUsageSearch {
+  const IDRemapper &id_remapper;
+  bool is_used;
+};
+
+/**
+ * Read-only callback finding whether an ID uses any of the mapped IDs, using the same checks as
+ * #foreach_libblock_remap_callback to detect pointers that it would not modify.
+ */
+static int foreach_libblock_remap_find_usage_callback(LibraryIDLinkCallbackData *cb_data)
+{
+  const int cb_flag = cb_data->cb_flag;
+  if (cb_flag & IDWALK_CB_EMBEDDED) {
+    return IDWALK_RET_NOP;
+  }
+  ID *id = *cb_data->id_pointer;
+  if (id == nullptr) {
+    return IDWALK_RET_NOP;
+  }
+  IDRemapUsageSearch *search = static_cast<IDRemapUsageSearch *>(cb_data->user_data);
+  IDRemapperApplyOptions id_remapper_options = ID_REMAP_APPLY_DEFAULT;
+  if (cb_flag & IDWALK_CB_NEVER_SELF) {
+    id_remapper_options |= ID_REMAP_APPLY_UNMAP_WHEN_REMAPPING_TO_SELF;
+  }
+  if (ELEM(search->id_remapper.get_mapping_result(id, id_remapper_options, cb_data->self_id),
+           ID_REMAP_RESULT_SOURCE_UNAVAILABLE,
+           ID_REMAP_RESULT_SOURCE_NOT_MAPPABLE))
+  {
+    return IDWALK_RET_NOP;
+  }
+  search->is_used = true;
+  return IDWALK_RET_STOP_ITER;
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -523,8 +559,8 @@ static void libblock_remap_data(
     /* Note that this is a very 'brute force' approach,
      * maybe we could use some depsgraph to only process objects actually using given old_id...
      * sounds rather unlikely currently, though, so this will do for now. */
+    blender::Vector<ID *> ids;
     ID *id_curr;
-
     FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
       const uint64_t can_use_filter_id = BKE_library_id_can_use_filter_id(id_curr, include_ui);
       const bool has_mapping = id_remapper.contains_mappings_for_any(can_use_filter_id);
@@ -533,6 +569,40 @@ static void libblock_remap_data(
       if (!has_mapping) {
         continue;
       }
+      ids.append(id_curr);
+    }
+    FOREACH_MAIN_ID_END;
+
+    /* Remapping changes user counts and tags, so it has to be done on a single thread. Most IDs
+     * don't use any of the remapped IDs though, finding the ones that do only reads the ID
+     * pointers and can be done in parallel. The remaining IDs are still processed in the order of
+     * Main.
+     *
+     * Cleanup changes the mappings for every pointer, and scenes sync their view layers while
+     * iterating over them, so those are always processed. */
+    blender::Array<bool> ids_use_mapping(ids.size(), true);
+    if (remap_type == ID_REMAP_TYPE_REMAP) {
+      blender::threading::parallel_for(ids.index_range(), 64, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          if (GS(ids[i]->name) == ID_SCE) {
+            continue;
+          }
+          IDRemapUsageSearch search = {id_remapper, false};
+          BKE_library_foreach_ID_link(bmain,
+                                      ids[i],
+                                      foreach_libblock_remap_find_usage_callback,
+                                      &search,
+                                      foreach_id_flags | IDWALK_READONLY);
+          ids_use_mapping[i] = search.is_used;
+        }
+      });
+    }
+
+    for (const int64_t i : ids.index_range()) {
+      if (!ids_use_mapping[i]) {
+        continue;
+      }
+      id_curr = ids[i];
 
       /* Note that we cannot skip indirect usages of old_id
        * here (if requested), we still need to check it for the
@@ -544,7 +614,6 @@ static void libblock_remap_data(
       BKE_library_foreach_ID_link(
           bmain, id_curr, foreach_libblock_remap_callback, &id_remap_data, foreach_id_flags);
     }
-    FOREACH_MAIN_ID_END;
   }
 
   id_remapper.iter([&](ID *old_id, ID *new_id) {
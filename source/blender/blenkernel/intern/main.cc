@@ -15,18 +15,22 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_map.hh"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
 
 #include "DNA_ID.h"
+#include "DNA_scene_types.h"
 
 #include "BKE_bpath.hh"
 #include "BKE_global.hh"
 #include "BKE_idtype.hh"
+#include "BKE_layer.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_lib_remap.hh"
@@ -461,59 +465,71 @@ void BKE_main_unlock(Main *bmain)
   BLI_spin_unlock((SpinLock *)bmain->lock);
 }
 
+/** An ID pointer found while building the relations, see #BKE_main_relations_create. */
+struct MainRelationsLink {
+  /** Can be an embedded ID of the iterated ID. */
+  ID *self_id;
+  ID **id_pointer;
+  int cb_flag;
+};
+
 static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
 {
-  MainIDRelations *bmain_relations = static_cast<MainIDRelations *>(cb_data->user_data);
-  ID *self_id = cb_data->self_id;
-  ID **id_pointer = cb_data->id_pointer;
-  const int cb_flag = cb_data->cb_flag;
+  blender::Vector<MainRelationsLink> &links = *static_cast<blender::Vector<MainRelationsLink> *>(
+      cb_data->user_data);
+  if (*cb_data->id_pointer) {
+    links.append({cb_data->self_id, cb_data->id_pointer, cb_data->cb_flag});
+  }
+  return IDWALK_RET_NOP;
+}
 
-  if (*id_pointer) {
-    MainIDRelationsEntry **entry_p;
+static void main_relations_add_link(MainIDRelations *bmain_relations,
+                                    ID *self_id,
+                                    ID **id_pointer,
+                                    const int cb_flag)
+{
+  MainIDRelationsEntry **entry_p;
 
-    /* Add `id_pointer` as child of `self_id`. */
+  /* Add `id_pointer` as child of `self_id`. */
+  {
+    if (!BLI_ghash_ensure_p(
+            bmain_relations->relations_from_pointers, self_id, (void ***)&entry_p))
     {
-      if (!BLI_ghash_ensure_p(
-              bmain_relations->relations_from_pointers, self_id, (void ***)&entry_p))
-      {
-        *entry_p = static_cast<MainIDRelationsEntry *>(MEM_callocN(sizeof(**entry_p), __func__));
-        (*entry_p)->session_uid = self_id->session_uid;
-      }
-      else {
-        BLI_assert((*entry_p)->session_uid == self_id->session_uid);
-      }
-      MainIDRelationsEntryItem *to_id_entry = static_cast<MainIDRelationsEntryItem *>(
-          BLI_mempool_alloc(bmain_relations->entry_items_pool));
-      to_id_entry->next = (*entry_p)->to_ids;
-      to_id_entry->id_pointer.to = id_pointer;
-      to_id_entry->session_uid = (*id_pointer != nullptr) ? (*id_pointer)->session_uid :
-                                                            MAIN_ID_SESSION_UID_UNSET;
-      to_id_entry->usage_flag = cb_flag;
-      (*entry_p)->to_ids = to_id_entry;
+      *entry_p = static_cast<MainIDRelationsEntry *>(MEM_callocN(sizeof(**entry_p), __func__));
+      (*entry_p)->session_uid = self_id->session_uid;
     }
-
-    /* Add `self_id` as parent of `id_pointer`. */
-    if (*id_pointer != nullptr) {
-      if (!BLI_ghash_ensure_p(
-              bmain_relations->relations_from_pointers, *id_pointer, (void ***)&entry_p))
-      {
-        *entry_p = static_cast<MainIDRelationsEntry *>(MEM_callocN(sizeof(**entry_p), __func__));
-        (*entry_p)->session_uid = (*id_pointer)->session_uid;
-      }
-      else {
-        BLI_assert((*entry_p)->session_uid == (*id_pointer)->session_uid);
-      }
-      MainIDRelationsEntryItem *from_id_entry = static_cast<MainIDRelationsEntryItem *>(
-          BLI_mempool_alloc(bmain_relations->entry_items_pool));
-      from_id_entry->next = (*entry_p)->from_ids;
-      from_id_entry->id_pointer.from = self_id;
-      from_id_entry->session_uid = self_id->session_uid;
-      from_id_entry->usage_flag = cb_flag;
-      (*entry_p)->from_ids = from_id_entry;
+    else {
+      BLI_assert((*entry_p)->session_uid == self_id->session_uid);
     }
+    MainIDRelationsEntryItem *to_id_entry = static_cast<MainIDRelationsEntryItem *>(
+        BLI_mempool_alloc(bmain_relations->entry_items_pool));
+    to_id_entry->next = (*entry_p)->to_ids;
+    to_id_entry->id_pointer.to = id_pointer;
+    to_id_entry->session_uid = (*id_pointer != nullptr) ? (*id_pointer)->session_uid :
+                                                          MAIN_ID_SESSION_UID_UNSET;
+    to_id_entry->usage_flag = cb_flag;
+    (*entry_p)->to_ids = to_id_entry;
+  }
+
+  /* Add `self_id` as parent of `id_pointer`. */
+  if (*id_pointer != nullptr) {
+    if (!BLI_ghash_ensure_p(
+            bmain_relations->relations_from_pointers, *id_pointer, (void ***)&entry_p))
+    {
+      *entry_p = static_cast<MainIDRelationsEntry *>(MEM_callocN(sizeof(**entry_p), __func__));
+      (*entry_p)->session_uid = (*id_pointer)->session_uid;
+    }
+    else {
+      BLI_assert((*entry_p)->session_uid == (*id_pointer)->session_uid);
+    }
+    MainIDRelationsEntryItem *from_id_entry = static_cast<MainIDRelationsEntryItem *>(
+        BLI_mempool_alloc(bmain_relations->entry_items_pool));
+    from_id_entry->next = (*entry_p)->from_ids;
+    from_id_entry->id_pointer.from = self_id;
+    from_id_entry->session_uid = self_id->session_uid;
+    from_id_entry->usage_flag = cb_flag;
+    (*entry_p)->from_ids = from_id_entry;
   }
-
-  return IDWALK_RET_NOP;
 }
 
 void BKE_main_relations_create(Main *bmain, const short flag)
@@ -531,11 +547,37 @@ void BKE_main_relations_create(Main *bmain, const short flag)
 
   bmain->relations->flag = flag;
 
+  const int idwalk_flag = IDWALK_READONLY |
+                          ((flag & MAINIDRELATIONS_INCLUDE_UI) != 0 ? IDWALK_INCLUDE_UI : 0);
+
+  /* Scenes sync their view layers while iterating over their bases. Do it here, so that the ID
+   * pointers of all IDs can be gathered in parallel without modifying any of them. */
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+      BKE_view_layer_synced_ensure(scene, view_layer);
+    }
+  }
+
+  blender::Vector<ID *> ids;
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
-    const int idwalk_flag = IDWALK_READONLY |
-                            ((flag & MAINIDRELATIONS_INCLUDE_UI) != 0 ? IDWALK_INCLUDE_UI : 0);
+    ids.append(id);
+  }
+  FOREACH_MAIN_ID_END;
 
+  /* Iterating over the ID pointers is the expensive part for large files, while adding them to
+   * the relations has to be done on a single thread. The links are still added in the order of
+   * the IDs in Main, so that the result is the same as a serial iteration. */
+  blender::Array<blender::Vector<MainRelationsLink>> links(ids.size());
+  blender::threading::parallel_for(ids.index_range(), 64, [&](const blender::IndexRange range) {
+    for (const int64_t i : range) {
+      BKE_library_foreach_ID_link(
+          nullptr, ids[i], main_relations_create_idlink_cb, &links[i], idwalk_flag);
+    }
+  });
+
+  for (const int64_t i : ids.index_range()) {
+    id = ids[i];
     /* Ensure all IDs do have an entry, even if they are not connected to any other. */
     MainIDRelationsEntry **entry_p;
     if (!BLI_ghash_ensure_p(bmain->relations->relations_from_pointers, id, (void ***)&entry_p)) {
@@ -546,10 +588,10 @@ void BKE_main_relations_create(Main *bmain, const short flag)
       BLI_assert((*entry_p)->session_uid == id->session_uid);
     }
 
-    BKE_library_foreach_ID_link(
-        nullptr, id, main_relations_create_idlink_cb, bmain->relations, idwalk_flag);
+    for (const MainRelationsLink &link : links[i]) {
+      main_relations_add_link(bmain->relations, link.self_id, link.id_pointer, link.cb_flag);
+    }
   }
-  FOREACH_MAIN_ID_END;
 }
 
 void BKE_main_relations_free(Main *bmain)
@@ -157,13 +157,27 @@ struct UniqueName_Value {
   }
 };
 
-/* Tracking of names for a single ID type. */
+/* Tracking of names for a single ID type. The names are expensive to hash and compare, so the
+ * slots store the hash to skip comparing names in collisions and rehashing them on growth. */
 struct UniqueName_TypeMap {
   /* Set of full names that are in use. */
-  Set<UniqueName_Key> full_names;
+  Set<UniqueName_Key,
+      0,
+      DefaultProbingStrategy,
+      DefaultHash<UniqueName_Key>,
+      DefaultEquality<UniqueName_Key>,
+      HashedSetSlot<UniqueName_Key>>
+      full_names;
   /* For each base name (i.e. without numeric suffix), track the
    * numeric suffixes that are in use. */
-  Map<UniqueName_Key, UniqueName_Value> base_name_to_num_suffix;
+  Map<UniqueName_Key,
+      UniqueName_Value,
+      0,
+      DefaultProbingStrategy,
+      DefaultHash<UniqueName_Key>,
+      DefaultEquality<UniqueName_Key>,
+      HashedMapSlot<UniqueName_Key, UniqueName_Value>>
+      base_name_to_num_suffix;
 };
 
 struct UniqueName_Map {
@@ -45,6 +45,7 @@
 #include "BLT_translation.hh"
 
 #include "BKE_anim_data.hh"
+#include "BKE_armature.hh"
 #include "BKE_attribute.hh"
 #include "BKE_bake_data_block_id.hh"
 #include "BKE_bpath.hh"
@@ -114,6 +115,7 @@ static void mesh_copy_data(Main *bmain,
   mesh_dst->runtime->deformed_only = mesh_src->runtime->deformed_only;
   mesh_dst->runtime->wrapper_type = mesh_src->runtime->wrapper_type;
   mesh_dst->runtime->subsurf_runtime_data = mesh_src->runtime->subsurf_runtime_data;
+  mesh_dst->runtime->armature_gpu_deform = mesh_src->runtime->armature_gpu_deform;
   mesh_dst->runtime->cd_mask_extra = mesh_src->runtime->cd_mask_extra;
   /* Copy face dot tags and edge tags, since meshes may be duplicated after a subsurf modifier or
    * node, but we still need to be able to draw face center vertices and "optimal edges"
@@ -152,6 +154,7 @@ static void mesh_copy_data(Main *bmain,
   mesh_dst->runtime->vert_to_face_map_cache = mesh_src->runtime->vert_to_face_map_cache;
   mesh_dst->runtime->vert_to_corner_map_cache = mesh_src->runtime->vert_to_corner_map_cache;
   mesh_dst->runtime->corner_to_face_map_cache = mesh_src->runtime->corner_to_face_map_cache;
+  mesh_dst->runtime->bvh_caches = mesh_src->runtime->bvh_caches;
   if (mesh_src->runtime->bake_materials) {
     mesh_dst->runtime->bake_materials = std::make_unique<blender::bke::bake::BakeMaterialsList>(
         *mesh_src->runtime->bake_materials);
@@ -384,6 +387,59 @@ static void mesh_blend_read_data(BlendDataReader *reader, ID *id)
   }
 }
 
+/**
+ * Keep derived caches of the mesh from before an undo step was loaded, when the data they depend
+ * on is still the same. Geometry arrays that did not change are implicitly shared with the undo
+ * step, so the reloaded mesh references the exact same arrays. This avoids recomputing normals,
+ * triangulation and topology maps after every undo, e.g. when only a material was changed.
+ */
+static void mesh_undo_preserve(BlendLibReader * /*reader*/, ID *id_new, ID *id_old)
+{
+  if (id_new == id_old) {
+    return;
+  }
+  Mesh *mesh_new = reinterpret_cast<Mesh *>(id_new);
+  const Mesh *mesh_old = reinterpret_cast<const Mesh *>(id_old);
+  if (mesh_new->runtime == nullptr || mesh_old->runtime == nullptr) {
+    return;
+  }
+  blender::bke::MeshRuntime &runtime_new = *mesh_new->runtime;
+  const blender::bke::MeshRuntime &runtime_old = *mesh_old->runtime;
+
+  const bool same_positions = mesh_new->verts_num == mesh_old->verts_num &&
+                              mesh_new->vert_positions().data() ==
+                                  mesh_old->vert_positions().data();
+  const bool same_topology = mesh_new->verts_num == mesh_old->verts_num &&
+                             mesh_new->edges_num == mesh_old->edges_num &&
+                             mesh_new->faces_num == mesh_old->faces_num &&
+                             mesh_new->corners_num == mesh_old->corners_num &&
+                             mesh_new->edges().data() == mesh_old->edges().data() &&
+                             mesh_new->face_offsets().data() == mesh_old->face_offsets().data() &&
+                             mesh_new->corner_verts().data() == mesh_old->corner_verts().data() &&
+                             mesh_new->corner_edges().data() == mesh_old->corner_edges().data();
+
+  if (same_positions) {
+    runtime_new.bounds_cache = runtime_old.bounds_cache;
+  }
+  if (same_topology) {
+    runtime_new.loose_verts_cache = runtime_old.loose_verts_cache;
+    runtime_new.verts_no_face_cache = runtime_old.verts_no_face_cache;
+    runtime_new.loose_edges_cache = runtime_old.loose_edges_cache;
+    runtime_new.corner_tris_cache = runtime_old.corner_tris_cache;
+    runtime_new.corner_tri_faces_cache = runtime_old.corner_tri_faces_cache;
+    runtime_new.vert_to_face_offset_cache = runtime_old.vert_to_face_offset_cache;
+    runtime_new.vert_to_face_map_cache = runtime_old.vert_to_face_map_cache;
+    runtime_new.vert_to_corner_map_cache = runtime_old.vert_to_corner_map_cache;
+    runtime_new.corner_to_face_map_cache = runtime_old.corner_to_face_map_cache;
+  }
+  /* Corner normals also depend on sharpness attributes and custom normals, which may have
+   * changed, so they are always recomputed. */
+  if (same_positions && same_topology) {
+    runtime_new.vert_normals_cache = runtime_old.vert_normals_cache;
+    runtime_new.face_normals_cache = runtime_old.face_normals_cache;
+  }
+}
+
 IDTypeInfo IDType_ID_ME = {
     /*id_code*/ ID_ME,
     /*id_filter*/ FILTER_ID_ME,
@@ -409,7 +465,7 @@ IDTypeInfo IDType_ID_ME = {
     /*blend_read_data*/ mesh_blend_read_data,
     /*blend_read_after_liblink*/ nullptr,
 
-    /*blend_read_undo_preserve*/ nullptr,
+    /*blend_read_undo_preserve*/ mesh_undo_preserve,
 
     /*lib_override_apply_post*/ nullptr,
 };
@@ -1220,6 +1276,10 @@ std::optional<blender::Bounds<blender::float3>> Mesh::bounds_min_max() const
   if (verts_num == 0) {
     return std::nullopt;
   }
+  if (const bke::ArmatureGPUDeform *armature_deform = this->runtime->armature_gpu_deform.get()) {
+    /* The positions are deformed in the draw code. */
+    return armature_deform->bounds;
+  }
   this->runtime->bounds_cache.ensure([&](Bounds<float3> &r_bounds) {
     switch (this->runtime->wrapper_type) {
       case ME_WRAPPER_TYPE_BMESH:
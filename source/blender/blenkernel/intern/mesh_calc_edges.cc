@@ -8,6 +8,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_ordered_edge.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_vector_set.hh"
@@ -171,10 +172,154 @@ static void deselect_known_edges(const OffsetIndices<int> edge_offsets,
   });
 }
 
+/**
+ * For large meshes, sorting all edges is faster than the hash maps. The sort and the steps after
+ * it are parallelized over all threads instead of one thread per hash map, and they access memory
+ * sequentially.
+ */
+static bool use_sorted_edges(const Mesh &mesh)
+{
+  return mesh.corners_num >= 1 << 20;
+}
+
+/** Sorts edges by their first and then their second vertex. */
+static uint64_t edge_sort_key(const OrderedEdge &edge)
+{
+  return (uint64_t(edge.v_low) << 32) | uint64_t(edge.v_high);
+}
+
+/** Sorted after all valid edges, because vertex indices are never negative. */
+static constexpr uint64_t invalid_edge_key = std::numeric_limits<uint64_t>::max();
+
+static void mesh_calc_edges_sorted(Mesh &mesh,
+                                   const bool keep_existing_edges,
+                                   const bool select_new_edges)
+{
+  const OffsetIndices<int> faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int2> existing_edges = keep_existing_edges ? mesh.edges() : Span<int2>();
+  const int corners_num = mesh.corners_num;
+
+  /* Every face corner references the edge to the next corner. The existing edges are added after
+   * the corners, with indices after the corner indices. */
+  const int64_t items_num = corners_num + existing_edges.size();
+  Array<uint64_t> keys(items_num, NoInitialization());
+  Array<int> items(items_num, NoInitialization());
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int face_index : range) {
+      const IndexRange face = faces[face_index];
+      for (const int corner : face) {
+        const int vert = corner_verts[corner];
+        const int vert_next = corner_verts[bke::mesh::face_corner_next(face, corner)];
+        /* Can only be the same when the mesh data is invalid. */
+        keys[corner] = LIKELY(vert != vert_next) ? edge_sort_key(OrderedEdge(vert, vert_next)) :
+                                                   invalid_edge_key;
+        items[corner] = corner;
+      }
+    }
+  });
+  threading::parallel_for(existing_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int edge : range) {
+      keys[corners_num + edge] = edge_sort_key(OrderedEdge(existing_edges[edge]));
+      items[corners_num + edge] = corners_num + edge;
+    }
+  });
+
+  parallel_radix_sort(keys.as_mutable_span(), items.as_mutable_span());
+
+  /* Every run of equal keys becomes one edge. Count the runs in every chunk to find where the
+   * edges of the chunk start. */
+  const int64_t chunk_size = 1 << 16;
+  const int64_t chunks_num = (items_num + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * chunk_size;
+    return IndexRange(start, std::min(chunk_size, items_num - start));
+  };
+  const auto is_new_edge = [&](const int64_t i) {
+    return keys[i] != invalid_edge_key && (i == 0 || keys[i] != keys[i - 1]);
+  };
+  Array<int> chunk_offsets(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      int count = 0;
+      for (const int64_t i : chunk_range(chunk)) {
+        count += is_new_edge(i);
+      }
+      chunk_offsets[chunk] = count;
+    }
+  });
+  const OffsetIndices<int> edges_by_chunk = offset_indices::accumulate_counts_to_offsets(
+      chunk_offsets);
+  const int edges_num = edges_by_chunk.total_size();
+
+  MutableSpan<int2> new_edges(MEM_cnew_array<int2>(edges_num, __func__), edges_num);
+  MutableAttributeAccessor attributes = mesh.attributes_for_write();
+  attributes.add<int>(".corner_edge", AttrDomain::Corner, AttributeInitConstruct());
+  MutableSpan<int> corner_edges = mesh.corner_edges_for_write();
+  Array<int> existing_edge_indices(select_new_edges ? existing_edges.size() : 0);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      int edge_index = edges_by_chunk[chunk].start() - 1;
+      for (const int64_t i : chunk_range(chunk)) {
+        const uint64_t key = keys[i];
+        const int item = items[i];
+        if (key == invalid_edge_key) {
+          /* This is an invalid edge; normally this does not happen in Blender,
+           * but it can be part of an imported mesh with invalid geometry. See
+           * #76514. */
+          corner_edges[item] = 0;
+          continue;
+        }
+        if (is_new_edge(i)) {
+          edge_index++;
+          new_edges[edge_index] = int2(int(key >> 32), int(key & 0xFFFFFFFF));
+        }
+        if (item < corners_num) {
+          corner_edges[item] = edge_index;
+        }
+        else if (!existing_edge_indices.is_empty()) {
+          existing_edge_indices[item - corners_num] = edge_index;
+        }
+      }
+    }
+  });
+
+  /* Free old CustomData and assign new one. */
+  CustomData_free(&mesh.edge_data, mesh.edges_num);
+  CustomData_reset(&mesh.edge_data);
+  mesh.edges_num = edges_num;
+  attributes.add<int2>(".edge_verts", AttrDomain::Edge, AttributeInitMoveArray(new_edges.data()));
+
+  if (select_new_edges) {
+    SpanAttributeWriter<bool> select_edge = attributes.lookup_or_add_for_write_span<bool>(
+        ".select_edge", AttrDomain::Edge);
+    if (select_edge) {
+      select_edge.span.fill(true);
+      threading::parallel_for(
+          existing_edge_indices.index_range(), 4096, [&](const IndexRange range) {
+            for (const int edge_index : existing_edge_indices.as_span().slice(range)) {
+              select_edge.span[edge_index] = false;
+            }
+          });
+      select_edge.finish();
+    }
+  }
+
+  if (!keep_existing_edges) {
+    /* All edges are rebuilt from the faces, so there are no loose edges. */
+    mesh.tag_loose_edges_none();
+  }
+}
+
 }  // namespace calc_edges
 
 void mesh_calc_edges(Mesh &mesh, bool keep_existing_edges, const bool select_new_edges)
 {
+  if (calc_edges::use_sorted_edges(mesh)) {
+    calc_edges::mesh_calc_edges_sorted(mesh, keep_existing_edges, select_new_edges);
+    return;
+  }
+
   /* Parallelization is achieved by having multiple hash tables for different subsets of edges.
    * Each edge is assigned to one of the hash maps based on the lower bits of a hash value. */
   const int parallel_maps = calc_edges::get_parallel_maps_count(mesh);
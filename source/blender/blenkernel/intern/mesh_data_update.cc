@@ -305,6 +305,212 @@ static void set_rest_position(Mesh &mesh)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Stack Cache
+ *
+ * Changing a setting of a modifier tags the whole geometry of the object for an update. To avoid
+ * evaluating the unchanged modifiers before the changed one over and over while a setting is
+ * tweaked interactively, the state of the stack right before the last changed modifier is kept.
+ * It is reused as long as the input mesh, and the settings and dependencies of all modifiers
+ * before it did not change.
+ * \{ */
+
+struct ModifierStackCache {
+  struct ModifierState {
+    int persistent_uid;
+    bool is_enabled;
+    /** DNA data of the modifier after the #ModifierData header. */
+    Array<std::byte> settings;
+  };
+
+  /** All modifiers at the start of the last evaluation, to find the first one that changed. */
+  Vector<ModifierState> modifiers;
+
+  /** Index of the modifier the cached state is the input of, or -1 when nothing is cached. */
+  int input_index = -1;
+  CustomData_MeshMasks data_mask = {};
+  bool need_mapping = false;
+  /** Scene settings read by modifiers, see #modifier_stack_simplify_subsurf_levels_get. */
+  int2 simplify_subsurf_levels = int2(-1);
+  Mesh *input_mesh = nullptr;
+  Mesh *deform_mesh = nullptr;
+  GeometrySet geometry_set;
+  bool have_non_onlydeform_modifiers_applied = false;
+
+  ~ModifierStackCache()
+  {
+    this->input_clear();
+  }
+
+  void input_clear()
+  {
+    if (input_mesh) {
+      BKE_id_free(nullptr, input_mesh);
+    }
+    if (deform_mesh) {
+      BKE_id_free(nullptr, deform_mesh);
+    }
+    input_index = -1;
+    input_mesh = nullptr;
+    deform_mesh = nullptr;
+    geometry_set.clear();
+  }
+};
+
+void mesh_modifier_stack_cache_free(Object &ob)
+{
+  MEM_delete(ob.runtime->modifier_stack_cache);
+  ob.runtime->modifier_stack_cache = nullptr;
+}
+
+static Vector<ModifierStackCache::ModifierState> modifier_stack_state_get(const Scene &scene,
+                                                                          const Object &ob)
+{
+  Vector<ModifierStackCache::ModifierState> states;
+  LISTBASE_FOREACH (ModifierData *, md, &ob.modifiers) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+    const Span<std::byte> settings(reinterpret_cast<const std::byte *>(md) + sizeof(ModifierData),
+                                   mti->struct_size - int64_t(sizeof(ModifierData)));
+    states.append({md->persistent_uid,
+                   BKE_modifier_is_enabled(&scene, md, eModifierMode_Realtime),
+                   Array<std::byte>(settings)});
+  }
+  return states;
+}
+
+static int modifier_stack_first_changed_index(
+    const Span<ModifierStackCache::ModifierState> old_states,
+    const Span<ModifierStackCache::ModifierState> new_states)
+{
+  const int size = std::min(old_states.size(), new_states.size());
+  for (const int i : IndexRange(size)) {
+    const ModifierStackCache::ModifierState &a = old_states[i];
+    const ModifierStackCache::ModifierState &b = new_states[i];
+    if (a.persistent_uid != b.persistent_uid || a.is_enabled != b.is_enabled ||
+        a.settings.as_span() != b.settings.as_span())
+    {
+      return i;
+    }
+  }
+  return size;
+}
+
+/**
+ * The subdivision levels limit of the scene simplify settings, used by subdivision surface and
+ * multi-resolution modifiers, or -1 when simplify is disabled. Changing them doesn't change the
+ * modifier settings, so they are compared separately.
+ */
+static int2 modifier_stack_simplify_subsurf_levels_get(const Scene &scene)
+{
+  if ((scene.r.mode & R_SIMPLIFY) == 0) {
+    return int2(-1);
+  }
+  return int2(scene.r.simplify_subsurf, scene.r.simplify_subsurf_render);
+}
+
+/**
+ * Modifiers which depend on time or keep state between evaluations have to be evaluated every
+ * time, so the output of the stack after them can't be reused.
+ */
+static bool modifier_allows_cached_output(const Scene &scene, ModifierData &md)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md.type));
+  if (mti->flags & eModifierTypeFlag_UsesPointCache) {
+    return false;
+  }
+  return !BKE_modifier_depends_ontime(const_cast<Scene *>(&scene), &md);
+}
+
+/** Whether any data-block used by the modifier changed since the last evaluation. */
+static bool modifier_has_changed_dependency(const Object &ob, ModifierData &md)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md.type));
+  if (mti->foreach_ID_link == nullptr) {
+    return false;
+  }
+  bool has_changed_dependency = false;
+  mti->foreach_ID_link(
+      &md,
+      const_cast<Object *>(&ob),
+      [](void *user_data, Object *ob, ID **idpoin, int /*cb_flag*/) {
+        const ID *id = *idpoin;
+        if (id != nullptr && id != &ob->id && id->recalc != 0) {
+          *static_cast<bool *>(user_data) = true;
+        }
+      },
+      &has_changed_dependency);
+  return has_changed_dependency;
+}
+
+/** Whether the state right before the modifier at the given index can be cached. */
+static bool modifier_stack_cache_can_store(const Scene &scene, const Object &ob, const int index)
+{
+  int md_index = 0;
+  LISTBASE_FOREACH_INDEX (ModifierData *, md, &ob.modifiers, md_index) {
+    if (md_index == index) {
+      break;
+    }
+    /* Errors are cleared before the evaluation and would get lost. */
+    if (md->error != nullptr || !modifier_allows_cached_output(scene, *md)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Copy the input mesh for deform modifiers. The normals of the input mesh are calculated first,
+ * because they are shared with the copy. The input mesh usually stays the same when only the
+ * deformation is animated, so the normals are calculated once. Then the evaluated copies only
+ * update the normals of the parts that moved, see #BKE_modifier_deform_verts.
+ */
+static Mesh *copy_input_mesh_for_deform(const Mesh &mesh_input)
+{
+  if (mesh_input.runtime->wrapper_type == ME_WRAPPER_TYPE_MDATA) {
+    mesh_input.vert_normals();
+  }
+  return BKE_mesh_copy_for_eval(mesh_input);
+}
+
+/**
+ * Whether the cached state can be used for the evaluation of the object with the given arguments.
+ * The settings of the modifiers before the cached state are checked separately.
+ */
+static bool modifier_stack_cache_is_valid(const ModifierStackCache &cache,
+                                          const Scene &scene,
+                                          const Object &ob,
+                                          const Mesh &mesh_input,
+                                          const CustomData_MeshMasks &data_mask,
+                                          const bool need_mapping)
+{
+  if (cache.input_index == -1) {
+    return false;
+  }
+  if (!CustomData_MeshMasks_are_matching(&cache.data_mask, &data_mask) ||
+      !CustomData_MeshMasks_are_matching(&data_mask, &cache.data_mask) ||
+      cache.need_mapping != need_mapping ||
+      cache.simplify_subsurf_levels != modifier_stack_simplify_subsurf_levels_get(scene))
+  {
+    return false;
+  }
+  /* Changes to the mesh and the transform of the object itself affect all modifiers. */
+  if (mesh_input.id.recalc != 0 || (ob.id.recalc & ID_RECALC_TRANSFORM)) {
+    return false;
+  }
+  int md_index = 0;
+  LISTBASE_FOREACH_INDEX (ModifierData *, md, &ob.modifiers, md_index) {
+    if (md_index == cache.input_index) {
+      break;
+    }
+    if (!modifier_allows_cached_output(scene, *md) || modifier_has_changed_dependency(ob, *md)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(Depsgraph &depsgraph,
                                 const Scene &scene,
                                 Object &ob,
@@ -313,6 +519,7 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
                                 const CustomData_MeshMasks &dataMask,
                                 const bool use_cache,
                                 const bool allow_shared_mesh,
+                                ModifierStackCache *stack_cache,
                                 /* return args */
                                 Mesh **r_deform,
                                 Mesh **r_final,
@@ -367,6 +574,44 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
   /* XXX Always copying POLYINDEX, else tessellated data are no more valid! */
   CustomData_MeshMasks append_mask = CD_MASK_BAREMESH_ORIGINDEX;
 
+  /* The stack can only be restarted from a cached state when it contains the modifiers of the
+   * object only, and when no meshes are computed along with it. */
+  if (stack_cache != nullptr) {
+    bool needs_orco_mesh = final_datamask.vmask & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO);
+    for (const CDMaskLink *link = datamasks; link; link = link->next) {
+      needs_orco_mesh |= link->mask.vmask & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO);
+    }
+    if (needs_orco_mesh || firstmd != ob.modifiers.first || sculpt_mode ||
+        (ob.modifier_flag & OB_MODIFIER_FLAG_ADD_REST_POSITION))
+    {
+      stack_cache->input_clear();
+      stack_cache->modifiers.clear();
+      stack_cache = nullptr;
+    }
+  }
+
+  /* Restart from the cached input of a modifier when nothing before it changed, and cache the
+   * input of the first changed modifier for the next evaluation. */
+  Vector<ModifierStackCache::ModifierState> modifier_states;
+  int resume_index = -1;
+  int cache_index = -1;
+  if (stack_cache != nullptr) {
+    modifier_states = modifier_stack_state_get(scene, ob);
+    const int first_changed_index = modifier_stack_first_changed_index(stack_cache->modifiers,
+                                                                       modifier_states);
+    if (stack_cache->input_index <= first_changed_index &&
+        modifier_stack_cache_is_valid(*stack_cache, scene, ob, mesh_input, dataMask, need_mapping))
+    {
+      resume_index = stack_cache->input_index;
+    }
+    else {
+      stack_cache->input_clear();
+    }
+    if (first_changed_index < modifier_states.size() && first_changed_index != resume_index) {
+      cache_index = first_changed_index;
+    }
+  }
+
   /* Clear errors before evaluation. */
   BKE_modifiers_clear_errors(&ob);
 
@@ -378,9 +623,24 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
     set_rest_position(*mesh);
   }
 
+  int md_index = 0;
+  bool have_non_onlydeform_modifiers_applied = false;
+
+  if (resume_index != -1) {
+    mesh = BKE_mesh_copy_for_eval(*stack_cache->input_mesh);
+    if (stack_cache->deform_mesh) {
+      mesh_deform = BKE_mesh_copy_for_eval(*stack_cache->deform_mesh);
+    }
+    geometry_set_final = stack_cache->geometry_set;
+    have_non_onlydeform_modifiers_applied = stack_cache->have_non_onlydeform_modifiers_applied;
+    for (; md_index < resume_index; md_index++) {
+      md = md->next;
+      md_datamask = md_datamask->next;
+    }
+  }
   /* Apply all leading deform modifiers. */
-  if (use_deform) {
-    for (; md; md = md->next, md_datamask = md_datamask->next) {
+  else if (use_deform) {
+    for (; md; md = md->next, md_datamask = md_datamask->next, md_index++) {
       const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
       if (!BKE_modifier_is_enabled(&scene, md, required_mode)) {
@@ -390,7 +650,7 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
       if (mti->type == ModifierTypeType::OnlyDeform && !sculpt_dyntopo) {
         ScopedModifierTimer modifier_timer{*md};
         if (!mesh) {
-          mesh = BKE_mesh_copy_for_eval(mesh_input);
+          mesh = copy_input_mesh_for_deform(mesh_input);
           ASSERT_IS_VALID_MESH(mesh);
         }
 
@@ -418,10 +678,27 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
   }
 
   /* Apply all remaining constructive and deforming modifiers. */
-  bool have_non_onlydeform_modifiers_applied = false;
-  for (; md; md = md->next, md_datamask = md_datamask->next) {
+  for (; md; md = md->next, md_datamask = md_datamask->next, md_index++) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
+    if (md_index == cache_index && mesh != nullptr &&
+        mesh->runtime->wrapper_type == ME_WRAPPER_TYPE_MDATA &&
+        modifier_stack_cache_can_store(scene, ob, md_index))
+    {
+      /* The meshes share their data with the ones used for evaluation, so this is cheap. */
+      stack_cache->input_clear();
+      stack_cache->input_index = md_index;
+      stack_cache->data_mask = dataMask;
+      stack_cache->need_mapping = need_mapping;
+      stack_cache->simplify_subsurf_levels = modifier_stack_simplify_subsurf_levels_get(scene);
+      stack_cache->input_mesh = BKE_mesh_copy_for_eval(*mesh);
+      if (mesh_deform) {
+        stack_cache->deform_mesh = BKE_mesh_copy_for_eval(*mesh_deform);
+      }
+      stack_cache->geometry_set = geometry_set_final;
+      stack_cache->have_non_onlydeform_modifiers_applied = have_non_onlydeform_modifiers_applied;
+    }
+
     if (!BKE_modifier_is_enabled(&scene, md, required_mode)) {
       continue;
     }
@@ -485,7 +762,7 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
 
     if (mti->type == ModifierTypeType::OnlyDeform) {
       if (!mesh) {
-        mesh = BKE_mesh_copy_for_eval(mesh_input);
+        mesh = copy_input_mesh_for_deform(mesh_input);
         ASSERT_IS_VALID_MESH(mesh);
       }
       BKE_modifier_deform_verts(md, &mectx, mesh, mesh->vert_positions_for_write());
@@ -654,6 +931,10 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
     BKE_modifier_free_temporary_data(md);
   }
 
+  if (stack_cache != nullptr) {
+    stack_cache->modifiers = std::move(modifier_states);
+  }
+
   if (mesh == nullptr) {
     if (allow_shared_mesh) {
       mesh = &mesh_input;
@@ -991,6 +1272,18 @@ static void mesh_build_data(Depsgraph &depsgraph,
   }
 #endif
 
+  /* Only keep the state of the modifier stack for interactive changes. */
+  ModifierStackCache *stack_cache = nullptr;
+  if (DEG_is_active(&depsgraph) && BLI_listbase_count_at_most(&ob.modifiers, 2) == 2) {
+    if (ob.runtime->modifier_stack_cache == nullptr) {
+      ob.runtime->modifier_stack_cache = MEM_new<ModifierStackCache>(__func__);
+    }
+    stack_cache = ob.runtime->modifier_stack_cache;
+  }
+  else {
+    mesh_modifier_stack_cache_free(ob);
+  }
+
   Mesh *mesh_eval = nullptr, *mesh_deform_eval = nullptr;
   GeometrySet *geometry_set_eval = nullptr;
   mesh_calc_modifiers(depsgraph,
@@ -1001,6 +1294,7 @@ static void mesh_build_data(Depsgraph &depsgraph,
                       dataMask,
                       true,
                       true,
+                      stack_cache,
                       &mesh_deform_eval,
                       &mesh_eval,
                       &geometry_set_eval);
@@ -1219,8 +1513,18 @@ Mesh *mesh_create_eval_final(Depsgraph *depsgraph,
                              const CustomData_MeshMasks *dataMask)
 {
   Mesh *result;
-  mesh_calc_modifiers(
-      *depsgraph, *scene, *ob, true, false, *dataMask, false, false, nullptr, &result, nullptr);
+  mesh_calc_modifiers(*depsgraph,
+                      *scene,
+                      *ob,
+                      true,
+                      false,
+                      *dataMask,
+                      false,
+                      false,
+                      nullptr,
+                      nullptr,
+                      &result,
+                      nullptr);
   return result;
 }
 
@@ -1230,8 +1534,18 @@ Mesh *mesh_create_eval_no_deform(Depsgraph *depsgraph,
                                  const CustomData_MeshMasks *dataMask)
 {
   Mesh *result;
-  mesh_calc_modifiers(
-      *depsgraph, *scene, *ob, false, false, *dataMask, false, false, nullptr, &result, nullptr);
+  mesh_calc_modifiers(*depsgraph,
+                      *scene,
+                      *ob,
+                      false,
+                      false,
+                      *dataMask,
+                      false,
+                      false,
+                      nullptr,
+                      nullptr,
+                      &result,
+                      nullptr);
   return result;
 }
 
@@ -1241,8 +1555,18 @@ Mesh *mesh_create_eval_no_deform_render(Depsgraph *depsgraph,
                                         const CustomData_MeshMasks *dataMask)
 {
   Mesh *result;
-  mesh_calc_modifiers(
-      *depsgraph, *scene, *ob, false, false, *dataMask, false, false, nullptr, &result, nullptr);
+  mesh_calc_modifiers(*depsgraph,
+                      *scene,
+                      *ob,
+                      false,
+                      false,
+                      *dataMask,
+                      false,
+                      false,
+                      nullptr,
+                      nullptr,
+                      &result,
+                      nullptr);
   return result;
 }
 
@@ -155,6 +155,30 @@ void normals_calc_faces(const Span<float3> positions,
   });
 }
 
+static float3 vert_normal_calc(const Span<float3> positions,
+                               const OffsetIndices<int> faces,
+                               const Span<int> corner_verts,
+                               const Span<int> vert_faces,
+                               const Span<float3> face_normals,
+                               const int vert)
+{
+  if (vert_faces.is_empty()) {
+    return math::normalize(positions[vert]);
+  }
+
+  float3 vert_normal(0);
+  for (const int face : vert_faces) {
+    const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
+    const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+    const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+    const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
+
+    vert_normal += face_normals[face] * factor;
+  }
+
+  return math::normalize(vert_normal);
+}
+
 void normals_calc_verts(const Span<float3> vert_positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -165,23 +189,8 @@ void normals_calc_verts(const Span<float3> vert_positions,
   const Span<float3> positions = vert_positions;
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
     for (const int vert : range) {
-      const Span<int> vert_faces = vert_to_face_map[vert];
-      if (vert_faces.is_empty()) {
-        vert_normals[vert] = math::normalize(positions[vert]);
-        continue;
-      }
-
-      float3 vert_normal(0);
-      for (const int face : vert_faces) {
-        const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
-        const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
-        const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
-        const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
-
-        vert_normal += face_normals[face] * factor;
-      }
-
-      vert_normals[vert] = math::normalize(vert_normal);
+      vert_normals[vert] = vert_normal_calc(
+          positions, faces, corner_verts, vert_to_face_map[vert], face_normals, vert);
     }
   });
 }
@@ -310,6 +319,95 @@ blender::Span<blender::float3> Mesh::corner_normals() const
   return this->runtime->corner_normals_cache.data();
 }
 
+void Mesh::tag_positions_changed(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  if (changed_verts.is_empty()) {
+    return;
+  }
+  /* Updating the normals locally only pays off when a small part of the mesh moved. */
+  if (!this->runtime->face_normals_cache.is_cached() || changed_verts.size() > this->verts_num / 4)
+  {
+    this->tag_positions_changed();
+    return;
+  }
+  this->tag_positions_changed_no_normals();
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face = this->vert_to_face_map();
+
+  /* The normals of faces that use a moved vertex change. Those faces affect the normals of all
+   * of their vertices, i.e. the moved vertices and their neighbors. The normals of moved loose
+   * vertices depend on their own position. */
+  IndexMaskMemory memory;
+  Array<bool> vert_changed(this->verts_num, false);
+  changed_verts.to_bools(vert_changed);
+  const IndexMask changed_faces = IndexMask::from_predicate(
+      faces.index_range(), GrainSize(4096), memory, [&](const int face) {
+        const Span<int> face_verts = corner_verts.slice(faces[face]);
+        return std::any_of(face_verts.begin(), face_verts.end(), [&](const int vert) {
+          return vert_changed[vert];
+        });
+      });
+  Array<bool> face_changed(faces.size(), false);
+  changed_faces.to_bools(face_changed);
+  const IndexMask affected_verts = IndexMask::from_predicate(
+      IndexRange(this->verts_num), GrainSize(4096), memory, [&](const int vert) {
+        if (vert_changed[vert]) {
+          return true;
+        }
+        const Span<int> vert_faces = vert_to_face[vert];
+        return std::any_of(vert_faces.begin(), vert_faces.end(), [&](const int face) {
+          return face_changed[face];
+        });
+      });
+
+  this->runtime->face_normals_cache.update([&](Vector<float3> &r_data) {
+    changed_faces.foreach_index(GrainSize(1024), [&](const int face) {
+      r_data[face] = mesh::face_normal_calc(positions, corner_verts.slice(faces[face]));
+    });
+  });
+  const Span<float3> face_normals = this->runtime->face_normals_cache.data();
+
+  if (this->runtime->vert_normals_cache.is_cached()) {
+    this->runtime->vert_normals_cache.update([&](Vector<float3> &r_data) {
+      affected_verts.foreach_index(GrainSize(1024), [&](const int vert) {
+        r_data[vert] = mesh::vert_normal_calc(
+            positions, faces, corner_verts, vert_to_face[vert], face_normals, vert);
+      });
+    });
+  }
+
+  if (!this->runtime->corner_normals_cache.is_cached()) {
+    return;
+  }
+  switch (this->normals_domain()) {
+    case MeshNormalDomain::Point: {
+      const Span<float3> vert_normals = this->vert_normals();
+      this->runtime->corner_normals_cache.update([&](Vector<float3> &r_data) {
+        array_utils::gather(vert_normals, corner_verts, r_data.as_mutable_span());
+      });
+      break;
+    }
+    case MeshNormalDomain::Face: {
+      this->runtime->corner_normals_cache.update([&](Vector<float3> &r_data) {
+        changed_faces.foreach_index(GrainSize(1024), [&](const int face) {
+          r_data.as_mutable_span().slice(faces[face]).fill(face_normals[face]);
+        });
+      });
+      break;
+    }
+    case MeshNormalDomain::Corner: {
+      /* The corner fans with custom normals or sharp edges are computed for the whole mesh. */
+      this->runtime->corner_normals_cache.tag_dirty();
+      break;
+    }
+  }
+}
+
 void BKE_lnor_spacearr_init(MLoopNorSpaceArray *lnors_spacearr,
                             const int numLoops,
                             const char data_type)
@@ -41,11 +41,22 @@ static void free_mesh_eval(MeshRuntime &mesh_runtime)
   }
 }
 
+/** The trees can't be updated for a different topology, so they are always freed. */
 static void free_bvh_cache(MeshRuntime &mesh_runtime)
 {
-  if (mesh_runtime.bvh_cache) {
-    bvhcache_free(mesh_runtime.bvh_cache);
-    mesh_runtime.bvh_cache = nullptr;
+  for (SharedCache<BVHTreePtr> &cache : mesh_runtime.bvh_caches) {
+    cache = {};
+  }
+}
+
+/**
+ * Unlike #free_bvh_cache, trees that aren't shared with other meshes are kept, so that their
+ * bounds can be updated for the new positions.
+ */
+static void tag_bvh_cache_positions_changed(MeshRuntime &mesh_runtime)
+{
+  for (SharedCache<BVHTreePtr> &cache : mesh_runtime.bvh_caches) {
+    cache.tag_dirty();
   }
 }
 
@@ -62,7 +73,6 @@ MeshRuntime::MeshRuntime() = default;
 MeshRuntime::~MeshRuntime()
 {
   free_mesh_eval(*this);
-  free_bvh_cache(*this);
   free_batch_cache(*this);
 }
 
@@ -392,7 +402,7 @@ void Mesh::tag_positions_changed()
 
 void Mesh::tag_positions_changed_no_normals()
 {
-  free_bvh_cache(*this->runtime);
+  tag_bvh_cache_positions_changed(*this->runtime);
   this->runtime->corner_tris_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
@@ -401,7 +411,7 @@ void Mesh::tag_positions_changed_no_normals()
 void Mesh::tag_positions_changed_uniformly()
 {
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
-  free_bvh_cache(*this->runtime);
+  tag_bvh_cache_positions_changed(*this->runtime);
   this->runtime->bounds_cache.tag_dirty();
 }
 
@@ -420,6 +430,7 @@ void Mesh::tag_topology_changed()
 
 void (*BKE_mesh_batch_cache_dirty_tag_cb)(Mesh *mesh, eMeshBatchDirtyMode mode) = nullptr;
 void (*BKE_mesh_batch_cache_free_cb)(void *batch_cache) = nullptr;
+void *(*BKE_mesh_batch_cache_take_for_reuse_cb)(Mesh *mesh) = nullptr;
 
 void BKE_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode)
 {
@@ -431,6 +442,13 @@ void BKE_mesh_batch_cache_free(void *batch_cache)
 {
   BKE_mesh_batch_cache_free_cb(batch_cache);
 }
+void *BKE_mesh_batch_cache_take_for_reuse(Mesh *mesh)
+{
+  if (mesh->runtime->batch_cache) {
+    return BKE_mesh_batch_cache_take_for_reuse_cb(mesh);
+  }
+  return nullptr;
+}
 
 /** \} */
 
@@ -33,9 +33,11 @@
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
+#include "BKE_armature.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_editmesh_cache.hh"
 #include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_runtime.hh"
 #include "BKE_mesh_wrapper.hh"
@@ -312,6 +314,30 @@ int BKE_mesh_wrapper_face_len(const Mesh *mesh)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name CPU Armature Deformation
+ * \{ */
+
+/** Deform a copy of the mesh when the armature deformation was delayed to the draw code. */
+static Mesh *mesh_wrapper_ensure_armature_deform(Mesh *mesh)
+{
+  using namespace blender::bke;
+  Mesh *deformed_mesh = BKE_mesh_copy_for_eval(*mesh);
+  deformed_mesh->runtime->armature_gpu_deform.reset();
+  armature_gpu_deform_positions(*mesh->runtime->armature_gpu_deform,
+                                deformed_mesh->vert_positions_for_write());
+  deformed_mesh->tag_positions_changed();
+
+  if (mesh->runtime->mesh_eval != nullptr) {
+    BKE_id_free(nullptr, mesh->runtime->mesh_eval);
+  }
+  mesh->runtime->mesh_eval = deformed_mesh;
+  mesh->runtime->wrapper_type = ME_WRAPPER_TYPE_SUBD;
+  return deformed_mesh;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name CPU Subdivision Evaluation
  * \{ */
@@ -319,6 +345,9 @@ int BKE_mesh_wrapper_face_len(const Mesh *mesh)
 static Mesh *mesh_wrapper_ensure_subdivision(Mesh *mesh)
 {
   using namespace blender::bke;
+  if (mesh->runtime->armature_gpu_deform) {
+    return mesh_wrapper_ensure_armature_deform(mesh);
+  }
   SubsurfRuntimeData *runtime_data = (SubsurfRuntimeData *)mesh->runtime->subsurf_runtime_data;
   if (runtime_data == nullptr || runtime_data->settings.level == 0) {
     return mesh;
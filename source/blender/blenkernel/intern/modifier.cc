@@ -34,6 +34,8 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
@@ -58,6 +60,7 @@
 #include "BKE_lib_id.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_mesh_wrapper.hh"
 #include "BKE_multires.hh"
 #include "BKE_object.hh"
@@ -920,7 +923,24 @@ void BKE_modifier_deform_verts(ModifierData *md,
                                Mesh *mesh,
                                blender::MutableSpan<blender::float3> positions)
 {
+  using namespace blender;
   const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+  if (mesh && mesh->runtime->face_normals_cache.is_cached() &&
+      positions.data() == mesh->vert_positions().data())
+  {
+    /* Deform modifiers often only move part of the mesh, e.g. an armature that only influences
+     * some vertex groups. Compare the positions, so that the normals that were calculated before
+     * can be updated locally. */
+    const Array<float3> old_positions(positions.as_span());
+    mti->deform_verts(md, ctx, mesh, positions);
+    IndexMaskMemory memory;
+    const IndexMask changed_verts = IndexMask::from_predicate(
+        positions.index_range(), GrainSize(4096), memory, [&](const int i) {
+          return positions[i] != old_positions[i];
+        });
+    mesh->tag_positions_changed(changed_verts);
+    return;
+  }
   mti->deform_verts(md, ctx, mesh, positions);
   if (mesh) {
     mesh->tag_positions_changed();
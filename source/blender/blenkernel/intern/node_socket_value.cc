@@ -237,6 +237,33 @@ bool SocketValueVariant::is_volume_grid() const
   return kind_ == Kind::Grid;
 }
 
+bool SocketValueVariant::is_equal_to(const SocketValueVariant &other) const
+{
+  if (kind_ != other.kind_) {
+    return false;
+  }
+  switch (kind_) {
+    case Kind::None: {
+      return true;
+    }
+    case Kind::Single: {
+      if (socket_type_ != other.socket_type_) {
+        return false;
+      }
+      const GPointer value = this->get_single_ptr();
+      return value.type()->is_equal_or_false(value.get(), other.get_single_ptr().get());
+    }
+    case Kind::Field: {
+      return value_.get<fn::GField>() == other.value_.get<fn::GField>();
+    }
+    case Kind::Grid: {
+      return false;
+    }
+  }
+  BLI_assert_unreachable();
+  return false;
+}
+
 void SocketValueVariant::convert_to_single()
 {
   switch (kind_) {
@@ -292,6 +292,14 @@ static void object_copy_data(Main *bmain,
   }
 }
 
+static void object_mesh_batch_cache_prev_free(Object &ob)
+{
+  if (ob.runtime->mesh_batch_cache_prev) {
+    BKE_mesh_batch_cache_free(ob.runtime->mesh_batch_cache_prev);
+    ob.runtime->mesh_batch_cache_prev = nullptr;
+  }
+}
+
 static void object_free_data(ID *id)
 {
   Object *ob = (Object *)id;
@@ -324,6 +332,8 @@ static void object_free_data(ID *id)
   sbFree(ob);
 
   BKE_sculptsession_free(ob);
+  blender::bke::mesh_modifier_stack_cache_free(*ob);
+  object_mesh_batch_cache_prev_free(*ob);
 
   BLI_freelistN(&ob->pc_ids);
 
@@ -1648,6 +1658,13 @@ void BKE_object_free_derived_caches(Object *ob)
   ob->runtime->editmesh_eval_cage = nullptr;
 
   if (ob->runtime->data_eval != nullptr) {
+    if (GS(ob->runtime->data_eval->name) == ID_ME &&
+        ob->runtime->data_eval != ob->runtime->data_orig)
+    {
+      object_mesh_batch_cache_prev_free(*ob);
+      ob->runtime->mesh_batch_cache_prev = BKE_mesh_batch_cache_take_for_reuse(
+          reinterpret_cast<Mesh *>(ob->runtime->data_eval));
+    }
     if (ob->runtime->is_data_eval_owned) {
       ID *data_eval = ob->runtime->data_eval;
       if (GS(data_eval->name) == ID_ME) {
@@ -4896,11 +4913,13 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int /*flag*/)
   runtime->data_eval = nullptr;
   runtime->gpd_eval = nullptr;
   runtime->mesh_deform_eval = nullptr;
+  runtime->mesh_batch_cache_prev = nullptr;
   runtime->curve_cache = nullptr;
   runtime->object_as_temp_mesh = nullptr;
   runtime->pose_backup = nullptr;
   runtime->object_as_temp_curve = nullptr;
   runtime->geometry_set_eval = nullptr;
+  runtime->modifier_stack_cache = nullptr;
 
   runtime->crazyspace_deform_imats = {};
   runtime->crazyspace_deform_cos = {};
@@ -4908,8 +4927,9 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int /*flag*/)
 
 void BKE_object_runtime_free_data(Object *object)
 {
-  /* Currently this is all that's needed. */
   BKE_object_free_derived_caches(object);
+  blender::bke::mesh_modifier_stack_cache_free(*object);
+  object_mesh_batch_cache_prev_free(*object);
 
   BKE_object_runtime_reset(object);
 }
@@ -1537,6 +1537,7 @@ static void sculptsession_free_pbvh(Object *object)
   ss->vert_to_edge_offsets = {};
   ss->vert_to_edge_indices = {};
   ss->vert_to_edge_map = {};
+  ss->geodesic_cache.clear_and_shrink();
 
   MEM_SAFE_FREE(ss->preview_vert_list);
   ss->preview_vert_count = 0;
@@ -2226,6 +2227,7 @@ PBVH *BKE_sculpt_object_pbvh_ensure(Depsgraph *depsgraph, Object *ob)
   }
 
   ob->sculpt->islands_valid = false;
+  ob->sculpt->geodesic_cache.clear_and_shrink();
 
   if (ob->sculpt->bm != nullptr) {
     /* Sculpting on a BMesh (dynamic-topology) gets a special PBVH. */
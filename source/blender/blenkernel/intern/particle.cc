@@ -32,6 +32,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
@@ -2655,6 +2656,9 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
 
   BLI_kdtree_3d_balance(tree);
 
+  /* Find the parents of all remaining children in one batch, which runs in parallel. */
+  const int first_child = p;
+  blender::Array<float3> child_orcos(std::max(totchild - first_child, 0));
   for (; p < totchild; p++, cpa++) {
     psys_particle_on_emitter(sim->psmd,
                              from,
@@ -2666,8 +2670,15 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
                              nullptr,
                              nullptr,
                              nullptr,
-                             orco);
-    cpa->parent = BLI_kdtree_3d_find_nearest(tree, orco, nullptr);
+                             child_orcos[p - first_child]);
+  }
+  blender::Array<KDTreeNearest_3d> nearest(child_orcos.size());
+  BLI_kdtree_3d_find_nearest_batch(tree,
+                                   reinterpret_cast<const float(*)[3]>(child_orcos.data()),
+                                   uint(child_orcos.size()),
+                                   nearest.data());
+  for (const int i : child_orcos.index_range()) {
+    sim->psys->child[first_child + i].parent = nearest[i].index;
   }
 
   BLI_kdtree_3d_free(tree);
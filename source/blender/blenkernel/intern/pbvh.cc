@@ -8,6 +8,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <array>
+#include <atomic>
 #include <climits>
 
 #include "BLI_array_utils.hh"
@@ -174,15 +176,15 @@ static int partition_indices_material_faces(MutableSpan<int> indices,
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
 static int map_insert_vert(Map<int, int> &map,
-                           MutableSpan<bool> vert_bitmap,
+                           const Span<std::atomic<int>> vert_owners,
+                           const int node_index,
                            int *face_verts,
                            int *uniq_verts,
                            int vertex)
 {
   return map.lookup_or_add_cb(vertex, [&]() {
     int value;
-    if (!vert_bitmap[vertex]) {
-      vert_bitmap[vertex] = true;
+    if (vert_owners[vertex].load(std::memory_order_relaxed) == node_index) {
       value = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -199,7 +201,8 @@ static void build_mesh_leaf_node(const Span<int> corner_verts,
                                  const Span<int3> corner_tris,
                                  const Span<int> tri_faces,
                                  const Span<bool> hide_poly,
-                                 MutableSpan<bool> vert_bitmap,
+                                 const Span<std::atomic<int>> vert_owners,
+                                 const int node_index,
                                  PBVHNode *node)
 {
   node->uniq_verts = node->face_verts = 0;
@@ -214,8 +217,12 @@ static void build_mesh_leaf_node(const Span<int> corner_verts,
   for (const int i : prim_indices.index_range()) {
     const int3 &tri = corner_tris[prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      node->face_vert_indices[i][j] = map_insert_vert(
-          map, vert_bitmap, &node->face_verts, &node->uniq_verts, corner_verts[tri[j]]);
+      node->face_vert_indices[i][j] = map_insert_vert(map,
+                                                      vert_owners,
+                                                      node_index,
+                                                      &node->face_verts,
+                                                      &node->uniq_verts,
+                                                      corner_verts[tri[j]]);
     }
   }
 
@@ -309,7 +316,7 @@ static void build_leaf(PBVH &pbvh,
                        const Span<int3> corner_tris,
                        const Span<int> tri_faces,
                        const Span<bool> hide_poly,
-                       MutableSpan<bool> vert_bitmap,
+                       const Span<std::atomic<int>> vert_owners,
                        int node_index,
                        const Span<Bounds<float3>> prim_bounds,
                        int offset,
@@ -324,7 +331,8 @@ static void build_leaf(PBVH &pbvh,
   update_vb(pbvh.prim_indices, &node, prim_bounds, offset, count);
 
   if (!corner_tris.is_empty()) {
-    build_mesh_leaf_node(corner_verts, corner_tris, tri_faces, hide_poly, vert_bitmap, &node);
+    build_mesh_leaf_node(
+        corner_verts, corner_tris, tri_faces, hide_poly, vert_owners, node_index, &node);
   }
   else {
     build_grid_leaf_node(pbvh, &node);
@@ -389,149 +397,216 @@ static void test_face_boundaries(PBVH &pbvh, const Mesh &mesh)
 }
 #endif
 
-/* Recursively build a node in the tree
- *
- * vb is the voxel box around all of the primitives contained in
- * this node.
- *
- * cb is the bounding box around all the centroids of the primitives
- * contained in this node
- *
- * offset and start indicate a range in the array of primitive indices
+/** Number of bins used to find the split position of a node. */
+static constexpr int split_bins_num = 16;
+
+struct SplitBin {
+  Bounds<float3> bounds = negative_bounds();
+  int count = 0;
+};
+using SplitBins = std::array<SplitBin, split_bins_num>;
+
+static float bounds_half_area(const Bounds<float3> &bounds)
+{
+  const float3 size = bounds.max - bounds.min;
+  return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+static Bounds<float3> calc_centroid_bounds(const Span<int> prim_indices,
+                                           const Span<Bounds<float3>> prim_bounds)
+{
+  return threading::parallel_reduce(
+      prim_indices.index_range(),
+      1024,
+      negative_bounds(),
+      [&](const IndexRange range, const Bounds<float3> &init) {
+        Bounds<float3> current = init;
+        for (const int prim : prim_indices.slice(range)) {
+          const float3 center = math::midpoint(prim_bounds[prim].min, prim_bounds[prim].max);
+          math::min_max(center, current.min, current.max);
+        }
+        return current;
+      },
+      [](const Bounds<float3> &a, const Bounds<float3> &b) { return bounds::merge(a, b); });
+}
+
+/**
+ * Find the position to split a node at along the axis with the widest range of primitive
+ * centroids. The bin boundary with the lowest surface area heuristic cost is used, which gives
+ * tighter bounds than the middle of the range when the primitives are distributed unevenly.
+ * Boundaries that leave less than an eighth of the primitives on one side are skipped to keep the
+ * tree balanced, if there is no other boundary, the middle of the range is used.
  */
+static float calc_split_position(const Span<int> prim_indices,
+                                 const Span<Bounds<float3>> prim_bounds,
+                                 const Bounds<float3> &centroid_bounds,
+                                 const int axis)
+{
+  const float min = centroid_bounds.min[axis];
+  const float extent = centroid_bounds.max[axis] - min;
+  const float midpoint = min + extent * 0.5f;
+  if (!(extent > 0.0f)) {
+    return midpoint;
+  }
+
+  const float bin_scale = split_bins_num / extent;
+  const SplitBins bins = threading::parallel_reduce(
+      prim_indices.index_range(),
+      1024,
+      SplitBins(),
+      [&](const IndexRange range, const SplitBins &init) {
+        SplitBins current = init;
+        for (const int prim : prim_indices.slice(range)) {
+          const Bounds<float3> &bounds = prim_bounds[prim];
+          const float center = math::midpoint(bounds.min[axis], bounds.max[axis]);
+          const int bin = std::clamp(int((center - min) * bin_scale), 0, split_bins_num - 1);
+          current[bin].bounds = bounds::merge(current[bin].bounds, bounds);
+          current[bin].count++;
+        }
+        return current;
+      },
+      [](const SplitBins &a, const SplitBins &b) {
+        SplitBins result;
+        for (const int i : IndexRange(split_bins_num)) {
+          result[i].bounds = bounds::merge(a[i].bounds, b[i].bounds);
+          result[i].count = a[i].count + b[i].count;
+        }
+        return result;
+      });
+
+  /* Accumulate the bins from the right, so that the costs can be evaluated in one pass. */
+  SplitBins right;
+  right.back() = bins.back();
+  for (int i = split_bins_num - 2; i >= 0; i--) {
+    right[i].bounds = bounds::merge(right[i + 1].bounds, bins[i].bounds);
+    right[i].count = right[i + 1].count + bins[i].count;
+  }
+
+  const int min_side_count = prim_indices.size() / 8;
+  float best_cost = FLT_MAX;
+  int best_split = -1;
+  SplitBin left;
+  for (int i = 1; i < split_bins_num; i++) {
+    left.bounds = bounds::merge(left.bounds, bins[i - 1].bounds);
+    left.count += bins[i - 1].count;
+    if (std::min(left.count, right[i].count) < std::max(min_side_count, 1)) {
+      continue;
+    }
+    const float cost = bounds_half_area(left.bounds) * left.count +
+                       bounds_half_area(right[i].bounds) * right[i].count;
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_split = i;
+    }
+  }
+  if (best_split == -1) {
+    return midpoint;
+  }
+  return min + best_split / bin_scale;
+}
 
-static void build_sub(PBVH &pbvh,
-                      const Span<int> corner_verts,
-                      const Span<int3> corner_tris,
-                      const Span<int> tri_faces,
-                      const Span<bool> hide_poly,
+/** A node whose primitives are known, but which hasn't been split or built as a leaf yet. */
+struct BuildNode {
+  int node_index;
+  int offset;
+  int count;
+  int depth;
+};
+
+/**
+ * Decide whether a node is a leaf, and partition its primitives into two children otherwise.
+ * Only the node's own range of the primitive indices and the scratch buffer are accessed, so
+ * nodes can be split in parallel.
+ *
+ * \return The index of the first primitive of the second child, or -1 for leaf nodes.
+ */
+static int split_node(PBVH &pbvh,
+                      const Span<int> prim_to_face_map,
                       const Span<int> material_indices,
                       const Span<bool> sharp_faces,
                       const int leaf_limit,
-                      MutableSpan<bool> vert_bitmap,
-                      int node_index,
+                      const BuildNode &build_node,
                       const Bounds<float3> *cb,
                       const Span<Bounds<float3>> prim_bounds,
-                      int offset,
-                      int count,
-                      int *prim_scratch,
-                      int depth)
+                      MutableSpan<int> prim_scratch)
 {
-  const Span<int> prim_to_face_map = pbvh.header.type == PBVH_FACES ?
-                                         tri_faces :
-                                         pbvh.subdiv_ccg->grid_to_face_map;
-  int end;
+  const int offset = build_node.offset;
+  const int count = build_node.count;
 
-  if (!prim_scratch) {
-    prim_scratch = static_cast<int *>(
-        MEM_malloc_arrayN(pbvh.prim_indices.size(), sizeof(int), __func__));
-  }
-
-  /* Decide whether this is a leaf or not */
-  const bool below_leaf_limit = count <= leaf_limit || depth >= STACK_FIXED_DEPTH - 1;
+  const bool below_leaf_limit = count <= leaf_limit || build_node.depth >= STACK_FIXED_DEPTH - 1;
   if (below_leaf_limit) {
     if (!leaf_needs_material_split(
             pbvh, prim_to_face_map, material_indices, sharp_faces, offset, count))
     {
-      build_leaf(pbvh,
-                 corner_verts,
-                 corner_tris,
-                 tri_faces,
-                 hide_poly,
-                 vert_bitmap,
-                 node_index,
-                 prim_bounds,
-                 offset,
-                 count);
-
-      if (node_index == 0) {
-        MEM_SAFE_FREE(prim_scratch);
-      }
-
-      return;
+      return -1;
     }
   }
 
-  /* Add two child nodes */
-  pbvh.nodes[node_index].children_offset = pbvh.nodes.size();
-  pbvh.nodes.resize(pbvh.nodes.size() + 2);
-
   /* Update parent node bounding box */
-  update_vb(pbvh.prim_indices, &pbvh.nodes[node_index], prim_bounds, offset, count);
-
-  Bounds<float3> cb_backing;
-  if (!below_leaf_limit) {
-    /* Find axis with widest range of primitive centroids */
-    if (!cb) {
-      cb_backing = negative_bounds();
-      for (int i = offset + count - 1; i >= offset; i--) {
-        const int prim = pbvh.prim_indices[i];
-        const float3 center = math::midpoint(prim_bounds[prim].min, prim_bounds[prim].max);
-        math::min_max(center, cb_backing.min, cb_backing.max);
-      }
-      cb = &cb_backing;
-    }
-    const int axis = math::dominant_axis(cb->max - cb->min);
+  update_vb(pbvh.prim_indices, &pbvh.nodes[build_node.node_index], prim_bounds, offset, count);
 
-    /* Partition primitives along that axis */
-    end = partition_prim_indices(pbvh.prim_indices,
-                                 prim_scratch,
-                                 offset,
-                                 offset + count,
-                                 axis,
-                                 math::midpoint(cb->min[axis], cb->max[axis]),
-                                 prim_bounds,
-                                 prim_to_face_map);
-  }
-  else {
+  if (below_leaf_limit) {
     /* Partition primitives by material */
-    end = partition_indices_material_faces(pbvh.prim_indices,
-                                           prim_to_face_map,
-                                           material_indices,
-                                           sharp_faces,
-                                           offset,
-                                           offset + count - 1);
-  }
-
-  /* Build children */
-  build_sub(pbvh,
-            corner_verts,
-            corner_tris,
-            tri_faces,
-            hide_poly,
-            material_indices,
-            sharp_faces,
-            leaf_limit,
-            vert_bitmap,
-            pbvh.nodes[node_index].children_offset,
-            nullptr,
-            prim_bounds,
-            offset,
-            end - offset,
-            prim_scratch,
-            depth + 1);
-  build_sub(pbvh,
-            corner_verts,
-            corner_tris,
-            tri_faces,
-            hide_poly,
-            material_indices,
-            sharp_faces,
-            leaf_limit,
-            vert_bitmap,
-            pbvh.nodes[node_index].children_offset + 1,
-            nullptr,
-            prim_bounds,
-            end,
-            offset + count - end,
-            prim_scratch,
-            depth + 1);
-
-  if (node_index == 0) {
-    MEM_SAFE_FREE(prim_scratch);
-  }
+    return partition_indices_material_faces(pbvh.prim_indices,
+                                            prim_to_face_map,
+                                            material_indices,
+                                            sharp_faces,
+                                            offset,
+                                            offset + count - 1);
+  }
+
+  const Span<int> node_prims = pbvh.prim_indices.as_span().slice(offset, count);
+  const Bounds<float3> centroid_bounds = cb ? *cb : calc_centroid_bounds(node_prims, prim_bounds);
+  const int axis = math::dominant_axis(centroid_bounds.max - centroid_bounds.min);
+  const float split = calc_split_position(node_prims, prim_bounds, centroid_bounds, axis);
+
+  /* Partition primitives along that axis */
+  return partition_prim_indices(pbvh.prim_indices,
+                                prim_scratch.data() + offset,
+                                offset,
+                                offset + count,
+                                axis,
+                                split,
+                                prim_bounds,
+                                prim_to_face_map);
+}
+
+/**
+ * Vertices used by multiple leaves are unique to the leaf with the lowest index. Deciding that
+ * before building the leaves allows building them in parallel with a deterministic result.
+ */
+static void calc_vert_owners(const PBVH &pbvh,
+                             const Span<int> corner_verts,
+                             const Span<int3> corner_tris,
+                             const Span<BuildNode> leaves,
+                             MutableSpan<std::atomic<int>> vert_owners)
+{
+  threading::parallel_for(vert_owners.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : range) {
+      vert_owners[vert].store(INT_MAX, std::memory_order_relaxed);
+    }
+  });
+  threading::parallel_for(leaves.index_range(), 1, [&](const IndexRange range) {
+    for (const BuildNode &leaf : leaves.slice(range)) {
+      for (const int tri : pbvh.prim_indices.as_span().slice(leaf.offset, leaf.count)) {
+        for (int i = 0; i < 3; i++) {
+          std::atomic<int> &owner = vert_owners[corner_verts[corner_tris[tri][i]]];
+          int old_owner = owner.load(std::memory_order_relaxed);
+          while (leaf.node_index < old_owner &&
+                 !owner.compare_exchange_weak(
+                     old_owner, leaf.node_index, std::memory_order_relaxed))
+          {
+          }
+        }
+      }
+    }
+  });
 }
 
+/**
+ * Build the tree one level at a time. The nodes of a level are split in parallel, then their
+ * children are allocated. Finally all leaves are built in parallel.
+ */
 static void pbvh_build(PBVH &pbvh,
                        const Span<int> corner_verts,
                        const Span<int3> corner_tris,
@@ -540,7 +615,7 @@ static void pbvh_build(PBVH &pbvh,
                        const Span<int> material_indices,
                        const Span<bool> sharp_faces,
                        const int leaf_limit,
-                       MutableSpan<bool> vert_bitmap,
+                       const int verts_num,
                        const Bounds<float3> *cb,
                        const Span<Bounds<float3>> prim_bounds,
                        int totprim)
@@ -552,22 +627,67 @@ static void pbvh_build(PBVH &pbvh,
 
   pbvh.nodes.resize(1);
 
-  build_sub(pbvh,
-            corner_verts,
-            corner_tris,
-            tri_faces,
-            hide_poly,
-            material_indices,
-            sharp_faces,
-            leaf_limit,
-            vert_bitmap,
-            0,
-            cb,
-            prim_bounds,
-            0,
-            totprim,
-            nullptr,
-            0);
+  const Span<int> prim_to_face_map = pbvh.header.type == PBVH_FACES ?
+                                         tri_faces :
+                                         pbvh.subdiv_ccg->grid_to_face_map;
+
+  Array<int> prim_scratch(totprim);
+  Vector<BuildNode> leaves;
+  Vector<BuildNode> level = {{0, 0, totprim, 0}};
+  while (!level.is_empty()) {
+    Array<int> split_ends(level.size());
+    threading::parallel_for(level.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        split_ends[i] = split_node(pbvh,
+                                   prim_to_face_map,
+                                   material_indices,
+                                   sharp_faces,
+                                   leaf_limit,
+                                   level[i],
+                                   level[i].node_index == 0 ? cb : nullptr,
+                                   prim_bounds,
+                                   prim_scratch);
+      }
+    });
+
+    /* Add two child nodes */
+    Vector<BuildNode> next_level;
+    for (const int i : level.index_range()) {
+      const BuildNode &node = level[i];
+      const int end = split_ends[i];
+      if (end == -1) {
+        leaves.append(node);
+        continue;
+      }
+      const int children_offset = pbvh.nodes.size();
+      pbvh.nodes[node.node_index].children_offset = children_offset;
+      pbvh.nodes.resize(children_offset + 2);
+      next_level.append({children_offset, node.offset, end - node.offset, node.depth + 1});
+      next_level.append(
+          {children_offset + 1, end, node.offset + node.count - end, node.depth + 1});
+    }
+    level = std::move(next_level);
+  }
+
+  Array<std::atomic<int>> vert_owners(corner_tris.is_empty() ? 0 : verts_num);
+  if (!corner_tris.is_empty()) {
+    calc_vert_owners(pbvh, corner_verts, corner_tris, leaves, vert_owners);
+  }
+
+  threading::parallel_for(leaves.index_range(), 1, [&](const IndexRange range) {
+    for (const BuildNode &leaf : leaves.as_span().slice(range)) {
+      build_leaf(pbvh,
+                 corner_verts,
+                 corner_tris,
+                 tri_faces,
+                 hide_poly,
+                 vert_owners,
+                 leaf.node_index,
+                 prim_bounds,
+                 leaf.offset,
+                 leaf.count);
+    }
+  });
 }
 
 #ifdef VALIDATE_UNIQUE_NODE_FACES
@@ -663,8 +783,6 @@ std::unique_ptr<PBVH> build_mesh(Mesh *mesh)
   update_mesh_pointers(*pbvh, mesh);
   const Span<int> tri_faces = mesh->corner_tri_faces();
 
-  Array<bool> vert_bitmap(mesh->verts_num, false);
-
 #ifdef TEST_PBVH_FACE_SPLIT
   /* Use lower limit to increase probability of
    * edge cases.
@@ -708,7 +826,7 @@ std::unique_ptr<PBVH> build_mesh(Mesh *mesh)
                material_index,
                sharp_face,
                leaf_limit,
-               vert_bitmap,
+               mesh->verts_num,
                &cb,
                prim_bounds,
                corner_tris.size());
@@ -785,7 +903,7 @@ std::unique_ptr<PBVH> build_grids(const CCGKey *key, Mesh *mesh, SubdivCCG *subd
                material_index,
                sharp_face,
                leaf_limit,
-               {},
+               0,
                &cb,
                prim_bounds,
                grids.size());
@@ -1656,17 +1774,17 @@ void BKE_pbvh_node_mark_update(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawMask | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_color(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawAttributes | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_face_sets(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateDrawFaceSets | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_mark_rebuild_pixels(PBVH &pbvh)
@@ -1696,7 +1814,7 @@ void BKE_pbvh_node_mark_redraw(PBVHNode *node)
 
 void BKE_pbvh_node_mark_positions_update(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateNormals | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw | PBVH_UpdateBB;
+  node->flag |= PBVH_UpdateNormals | PBVH_UpdateDrawPositions | PBVH_UpdateRedraw | PBVH_UpdateBB;
 }
 
 void BKE_pbvh_node_fully_hidden_set(PBVHNode *node, int fully_hidden)
@@ -2627,6 +2745,33 @@ static blender::draw::pbvh::PBVH_GPU_Args pbvh_draw_args_init(const Mesh &mesh,
 
 namespace blender::bke::pbvh {
 
+/** All flags that require updating some of the node's draw buffers. */
+static constexpr int draw_update_flags = PBVH_UpdateDrawBuffers | PBVH_UpdateDrawPositions |
+                                         PBVH_UpdateDrawMask | PBVH_UpdateDrawFaceSets |
+                                         PBVH_UpdateDrawAttributes;
+
+static draw::pbvh::DirtyData draw_dirty_data_get(const PBVHNodeFlags flag)
+{
+  using draw::pbvh::DirtyData;
+  if (flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers)) {
+    return DirtyData::All;
+  }
+  DirtyData dirty = DirtyData::None;
+  if (flag & PBVH_UpdateDrawPositions) {
+    dirty |= DirtyData::Positions;
+  }
+  if (flag & PBVH_UpdateDrawMask) {
+    dirty |= DirtyData::Mask;
+  }
+  if (flag & PBVH_UpdateDrawFaceSets) {
+    dirty |= DirtyData::FaceSets;
+  }
+  if (flag & PBVH_UpdateDrawAttributes) {
+    dirty |= DirtyData::Attributes;
+  }
+  return dirty;
+}
+
 static void node_update_draw_buffers(const Mesh &mesh, PBVH &pbvh, PBVHNode &node)
 {
   /* Create and update draw buffers. The functions called here must not
@@ -2637,12 +2782,12 @@ static void node_update_draw_buffers(const Mesh &mesh, PBVH &pbvh, PBVHNode &nod
     node.draw_batches = blender::draw::pbvh::node_create(args);
   }
 
-  if (node.flag & PBVH_UpdateDrawBuffers) {
+  if (node.flag & draw_update_flags) {
     node.debug_draw_gen++;
 
     if (node.draw_batches) {
       const blender::draw::pbvh::PBVH_GPU_Args args = pbvh_draw_args_init(mesh, pbvh, node);
-      blender::draw::pbvh::node_update(node.draw_batches, args);
+      blender::draw::pbvh::node_update(node.draw_batches, args, draw_dirty_data_get(node.flag));
     }
   }
 }
@@ -2671,7 +2816,7 @@ static void pbvh_update_draw_buffers(const Mesh &mesh,
       if (node->flag & PBVH_RebuildDrawBuffers) {
         free_draw_buffers(pbvh, node);
       }
-      else if ((node->flag & PBVH_UpdateDrawBuffers) && node->draw_batches) {
+      else if ((node->flag & draw_update_flags) && node->draw_batches) {
         const draw::pbvh::PBVH_GPU_Args args = pbvh_draw_args_init(mesh, pbvh, *node);
         draw::pbvh::update_pre(node->draw_batches, args);
       }
@@ -2687,14 +2832,14 @@ static void pbvh_update_draw_buffers(const Mesh &mesh,
 
   /* Flush buffers uses OpenGL, so not in parallel. */
   for (PBVHNode *node : nodes) {
-    if (node->flag & PBVH_UpdateDrawBuffers) {
+    if (node->flag & draw_update_flags) {
 
       if (node->draw_batches) {
         draw::pbvh::node_gpu_flush(node->draw_batches);
       }
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVHNodeFlags(draw_update_flags));
   }
 }
 
@@ -2715,16 +2860,16 @@ void draw_cb(const Mesh &mesh,
       update_flag |= node.flag;
       return true;
     });
-    if (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers)) {
+    if (update_flag & (PBVH_RebuildDrawBuffers | draw_update_flags)) {
       pbvh_update_draw_buffers(mesh, pbvh, nodes, update_flag);
     }
   }
   else {
     /* Get all nodes with draw updates, also those outside the view. */
     Vector<PBVHNode *> nodes = search_gather(pbvh, [&](PBVHNode &node) {
-      return update_search(&node, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+      return update_search(&node, PBVH_RebuildDrawBuffers | draw_update_flags);
     });
-    pbvh_update_draw_buffers(mesh, pbvh, nodes, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    pbvh_update_draw_buffers(mesh, pbvh, nodes, PBVH_RebuildDrawBuffers | draw_update_flags);
   }
 
   /* Draw visible nodes. */
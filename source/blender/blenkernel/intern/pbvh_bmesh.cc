@@ -16,6 +16,7 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -915,67 +916,102 @@ static void long_edge_queue_edge_add_recursive(
 }
 #endif /* USE_EDGEQUEUE_EVEN_SUBDIV */
 
-static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_TAG
-  if (EDGE_QUEUE_TEST(e) == false)
-#endif
-  {
-    const float len_sq = BM_edge_calc_length_squared(e);
-    if (len_sq < eq_ctx->q->limit_len_squared) {
-      edge_queue_insert(eq_ctx, e, short_edge_queue_priority(*e));
+#ifdef USE_EDGEQUEUE_FRONTFACE
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
+#endif
+  return q->edge_queue_tri_in_range(q, f);
 }
 
+/** Add the long edges of a face that is in range of the queue. */
 static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
-    }
-  }
-#endif
-
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face. */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
+  /* Check each edge of the face. */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
 #ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
-      }
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+    }
 #else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  } while ((l_iter = l_iter->next) != l_first);
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/** Leaf nodes marked for topology update. */
+static Vector<PBVHNode *> topology_update_nodes_gather(PBVH &pbvh)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  Vector<PBVHNode *> nodes;
+  for (PBVHNode &node : pbvh.nodes) {
+    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
+        !(node.flag & PBVH_FullyHidden))
+    {
+      nodes.append(&node);
     }
   }
-#endif
+  return nodes;
+}
+
+/**
+ * Find the faces of every node that are in range of the queue. Unlike adding edges to the queue,
+ * this only reads the mesh, so the nodes are processed in parallel. The faces keep the order of
+ * the node's face set, so the queue is the same as when filling it serially.
+ */
+static Array<Vector<BMFace *>> edge_queue_faces_in_range_gather(const EdgeQueue *q,
+                                                                const Span<PBVHNode *> nodes)
+{
+  Array<Vector<BMFace *>> node_faces(nodes.size());
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (BMFace *f : nodes[i]->bm_faces) {
+        if (edge_queue_face_in_range(q, f)) {
+          node_faces[i].append(f);
+        }
+      }
+    }
+  });
+  return node_faces;
+}
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+struct ShortEdgeCandidate {
+  BMEdge *edge;
+  float priority;
+};
 
-    /* Check each edge of the face. */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+/**
+ * Find the short edges of the faces in range and calculate their priority in parallel. Edges
+ * shared by multiple faces are contained multiple times, only the first one is added to the queue
+ * because of the queue tag.
+ */
+static Array<Vector<ShortEdgeCandidate>> short_edge_candidates_gather(
+    const EdgeQueue *q, const Span<Vector<BMFace *>> node_faces)
+{
+  Array<Vector<ShortEdgeCandidate>> node_edges(node_faces.size());
+  threading::parallel_for(node_faces.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (BMFace *f : node_faces[i]) {
+        /* Check each edge of the face. */
+        BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+        BMLoop *l_iter = l_first;
+        do {
+          BMEdge *e = l_iter->e;
+          if (BM_edge_calc_length_squared(e) < q->limit_len_squared) {
+            node_edges[i].append({e, short_edge_queue_priority(*e)});
+          }
+        } while ((l_iter = l_iter->next) != l_first);
+      }
+    }
+  });
+  return node_edges;
 }
 
 /**
@@ -1024,14 +1060,13 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (PBVHNode &node : pbvh.nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
-        !(node.flag & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
+  /* The recursive subdivision of neighboring edges depends on the queue tags of the edges that
+   * have been added before, so only finding the faces in range is done in parallel. */
+  const Vector<PBVHNode *> nodes = topology_update_nodes_gather(pbvh);
+  const Array<Vector<BMFace *>> node_faces = edge_queue_faces_in_range_gather(eq_ctx->q, nodes);
+  for (const Span<BMFace *> faces : node_faces) {
+    for (BMFace *f : faces) {
+      long_edge_queue_face_add(eq_ctx, f);
     }
   }
 }
@@ -1078,14 +1113,18 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (PBVHNode &node : pbvh.nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
-        !(node.flag & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces) {
-        short_edge_queue_face_add(eq_ctx, f);
+  const Vector<PBVHNode *> nodes = topology_update_nodes_gather(pbvh);
+  const Array<Vector<BMFace *>> node_faces = edge_queue_faces_in_range_gather(eq_ctx->q, nodes);
+  const Array<Vector<ShortEdgeCandidate>> node_edges = short_edge_candidates_gather(eq_ctx->q,
+                                                                                    node_faces);
+  for (const Span<ShortEdgeCandidate> candidates : node_edges) {
+    for (const ShortEdgeCandidate &candidate : candidates) {
+#ifdef USE_EDGEQUEUE_TAG
+      if (EDGE_QUEUE_TEST(candidate.edge)) {
+        continue;
       }
+#endif
+      edge_queue_insert(eq_ctx, candidate.edge, candidate.priority);
     }
   }
 }
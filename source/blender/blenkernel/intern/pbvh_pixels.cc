@@ -10,6 +10,7 @@
 
 #include "DNA_image_types.h"
 
+#include "BLI_bounds.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
@@ -456,6 +457,23 @@ struct EncodePixelsUserData {
   const UVPrimitiveLookup *uv_primitive_lookup;
 };
 
+/** Whether UV bounds relative to the offset of a tile overlap with the tile. */
+static bool uv_bounds_overlap_tile(const Bounds<float2> &uv_bounds)
+{
+  return uv_bounds.max.x >= 0.0f && uv_bounds.max.y >= 0.0f && uv_bounds.min.x <= 1.0f &&
+         uv_bounds.min.y <= 1.0f;
+}
+
+static Bounds<float2> uv_primitive_bounds(const uv_islands::MeshData &mesh_data,
+                                          const uv_islands::UVPrimitive &uv_primitive)
+{
+  Bounds<float2> bounds(uv_primitive.get_uv_vertex(mesh_data, 0)->uv);
+  for (const int i : {1, 2}) {
+    math::min_max(uv_primitive.get_uv_vertex(mesh_data, i)->uv, bounds.min, bounds.max);
+  }
+  return bounds;
+}
+
 static void do_encode_pixels(EncodePixelsUserData *data, const int n)
 {
   const uv_islands::MeshData &mesh_data = *data->mesh_data;
@@ -465,8 +483,29 @@ static void do_encode_pixels(EncodePixelsUserData *data, const int n)
   NodeData *node_data = static_cast<NodeData *>(node->pixels.node_data);
   const uv_islands::UVIslandsMask &uv_masks = *data->uv_masks;
 
+  /* Only tiles that the UV primitives of the node overlap with have to be processed. That avoids
+   * acquiring the image buffers of every tile of large UDIM sets for every node. */
+  std::optional<Bounds<float2>> node_uv_bounds;
+  for (const int geom_prim_index : node->prim_indices) {
+    for (const UVPrimitiveLookup::Entry &entry :
+         data->uv_primitive_lookup->lookup[geom_prim_index])
+    {
+      const Bounds<float2> uv_bounds = uv_primitive_bounds(mesh_data, *entry.uv_primitive);
+      node_uv_bounds = node_uv_bounds ? bounds::merge(*node_uv_bounds, uv_bounds) : uv_bounds;
+    }
+  }
+  if (!node_uv_bounds) {
+    return;
+  }
+
   LISTBASE_FOREACH (ImageTile *, tile, &data->image->tiles) {
     image::ImageTileWrapper image_tile(tile);
+    const float2 tile_offset = float2(image_tile.get_tile_offset());
+    if (!uv_bounds_overlap_tile({node_uv_bounds->min - tile_offset,
+                                 node_uv_bounds->max - tile_offset}))
+    {
+      continue;
+    }
     image_user.tile = image_tile.get_tile_number();
     ImBuf *image_buffer = BKE_image_acquire_ibuf(image, &image_user, nullptr);
     if (image_buffer == nullptr) {
@@ -475,13 +514,17 @@ static void do_encode_pixels(EncodePixelsUserData *data, const int n)
 
     UDIMTilePixels tile_data;
     tile_data.tile_number = image_tile.get_tile_number();
-    float2 tile_offset = float2(image_tile.get_tile_offset());
 
     for (const int geom_prim_index : node->prim_indices) {
       for (const UVPrimitiveLookup::Entry &entry :
            data->uv_primitive_lookup->lookup[geom_prim_index])
       {
-        uv_islands::UVBorder uv_border = entry.uv_primitive->extract_border();
+        const Bounds<float2> uv_bounds = uv_primitive_bounds(mesh_data, *entry.uv_primitive);
+        if (!uv_bounds_overlap_tile({uv_bounds.min - tile_offset, uv_bounds.max - tile_offset})) {
+          /* Primitives outside of the tile don't have pixels in it. Skipping them also keeps the
+           * UV primitives of the node from growing with the number of tiles. */
+          continue;
+        }
         float2 uvs[3] = {
             entry.uv_primitive->get_uv_vertex(mesh_data, 0)->uv - tile_offset,
             entry.uv_primitive->get_uv_vertex(mesh_data, 1)->uv - tile_offset,
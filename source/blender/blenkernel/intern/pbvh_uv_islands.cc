@@ -7,6 +7,7 @@
 #include "BLI_math_matrix.hh"
 #include "BLI_math_vector.h"
 #include "BLI_ordered_edge.hh"
+#include "BLI_task.hh"
 
 #include "pbvh_uv_islands.hh"
 
@@ -1556,11 +1557,14 @@ static void add_uv_island(const MeshData &mesh_data,
 
 void UVIslandsMask::add(const MeshData &mesh_data, const UVIslands &uv_islands)
 {
-  for (Tile &tile : tiles) {
-    for (const int i : uv_islands.islands.index_range()) {
-      add_uv_island(mesh_data, tile, uv_islands.islands[i], i);
+  /* The tiles have separate masks, so they can be filled in parallel. */
+  threading::parallel_for(tiles.index_range(), 1, [&](const IndexRange range) {
+    for (Tile &tile : tiles.as_mutable_span().slice(range)) {
+      for (const int i : uv_islands.islands.index_range()) {
+        add_uv_island(mesh_data, tile, uv_islands.islands[i], i);
+      }
     }
-  }
+  });
 }
 
 void UVIslandsMask::add_tile(const float2 udim_offset, ushort2 resolution)
@@ -1631,9 +1635,11 @@ static void dilate_tile(UVIslandsMask::Tile &tile, int max_iterations)
 
 void UVIslandsMask::dilate(int max_iterations)
 {
-  for (Tile &tile : tiles) {
-    dilate_tile(tile, max_iterations);
-  }
+  threading::parallel_for(tiles.index_range(), 1, [&](const IndexRange range) {
+    for (Tile &tile : tiles.as_mutable_span().slice(range)) {
+      dilate_tile(tile, max_iterations);
+    }
+  });
 }
 
 bool UVIslandsMask::Tile::is_masked(const uint16_t island_index, const float2 uv) const
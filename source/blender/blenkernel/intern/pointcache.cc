@@ -1635,32 +1635,79 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, uint tot, uint siz
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
+/* Uncompressed files store the data of all types interleaved per point. The points are read and
+ * written with a single file access and (de)interleaved in memory, instead of accessing the file
+ * for every point and data type. */
+static uint ptcache_file_point_size(int data_types)
 {
-  int i;
+  uint point_size = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      point_size += ptcache_data_size[i];
+    }
+  }
+  return point_size;
+}
+static int ptcache_file_points_read(PTCacheFile *pf, PTCacheMem *pm)
+{
+  const uint point_size = ptcache_file_point_size(pm->data_types);
+  if (pm->totpoint == 0 || point_size == 0) {
+    return 1;
+  }
+  uchar *buffer = static_cast<uchar *>(
+      MEM_mallocN(size_t(pm->totpoint) * point_size, "pointcache_read_buffer"));
+  if (!ptcache_file_read(pf, buffer, pm->totpoint, point_size)) {
+    MEM_freeN(buffer);
+    return 0;
+  }
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) && !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i]))
-    {
-      return 0;
+  uint offset = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if ((pm->data_types & (1 << i)) == 0) {
+      continue;
+    }
+    const uint size = ptcache_data_size[i];
+    uchar *data = static_cast<uchar *>(pm->data[i]);
+    for (uint p = 0; p < pm->totpoint; p++) {
+      memcpy(data + size_t(p) * size, buffer + size_t(p) * point_size + offset, size);
     }
+    offset += size;
   }
 
+  MEM_freeN(buffer);
   return 1;
 }
-static int ptcache_file_data_write(PTCacheFile *pf)
+static int ptcache_file_points_write(PTCacheFile *pf, const PTCacheMem *pm)
 {
-  int i;
+  const uint point_size = ptcache_file_point_size(pm->data_types);
+  if (pm->totpoint == 0 || point_size == 0) {
+    return 1;
+  }
+  uchar *buffer = static_cast<uchar *>(
+      MEM_mallocN(size_t(pm->totpoint) * point_size, "pointcache_write_buffer"));
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i]))
-    {
-      return 0;
+  uint offset = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if ((pm->data_types & (1 << i)) == 0) {
+      continue;
+    }
+    const uint size = ptcache_data_size[i];
+    const uchar *data = static_cast<const uchar *>(pm->data[i]);
+    for (uint p = 0; p < pm->totpoint; p++) {
+      uchar *dst = buffer + size_t(p) * point_size + offset;
+      if (data) {
+        memcpy(dst, data + size_t(p) * size, size);
+      }
+      else {
+        memset(dst, 0, size);
+      }
     }
+    offset += size;
   }
 
-  return 1;
+  const int result = ptcache_file_write(pf, buffer, pm->totpoint, point_size);
+  MEM_freeN(buffer);
+  return result;
 }
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
@@ -1832,18 +1879,6 @@ static void ptcache_data_free(PTCacheMem *pm)
     }
   }
 }
-static void ptcache_data_copy(void *from[], void *to[])
-{
-  int i;
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    /* NOTE: durian file 03.4b_comp crashes if to[i] is not tested
-     * its nullptr, not sure if this should be fixed elsewhere but for now its needed */
-    if (from[i] && to[i]) {
-      memcpy(to[i], from[i], ptcache_data_size[i]);
-    }
-  }
-}
-
 static void ptcache_extra_free(PTCacheMem *pm)
 {
   PTCacheExtra *extra = static_cast<PTCacheExtra *>(pm->extradata.first);
@@ -1973,19 +2008,8 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_points_read(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2074,19 +2098,8 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_points_write(pf, pm)) {
+      error = 1;
     }
   }
 
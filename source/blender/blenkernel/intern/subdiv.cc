@@ -13,6 +13,8 @@
 
 #include "BLI_utildefines.h"
 
+#include "BKE_customdata.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_subdiv_modifier.hh"
 
 #include "MEM_guardedalloc.h"
@@ -113,7 +115,7 @@ Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *conve
      * The thing here is: OpenSubdiv can only deal with faces, but our
      * side of subdiv also deals with loose vertices and edges. */
   }
-  Subdiv *subdiv = MEM_cnew<Subdiv>(__func__);
+  Subdiv *subdiv = MEM_new<Subdiv>(__func__);
   subdiv->settings = *settings;
   subdiv->topology_refiner = osd_topology_refiner;
   subdiv->evaluator = nullptr;
@@ -167,12 +169,93 @@ Subdiv *update_from_converter(Subdiv *subdiv,
   return new_from_converter(settings, converter);
 }
 
+/**
+ * Gather the sharing info of the arrays that the mesh converter reads the topology from. Optional
+ * layers that don't exist are added as null. Returns false when one of the arrays is not shared,
+ * the topology has to be compared in that case.
+ */
+static bool mesh_topology_sharing_gather(const Mesh &mesh,
+                                         Vector<const ImplicitSharingInfo *> &r_sharing)
+{
+  const auto add_layer = [&](const CustomData &data, const StringRef name) {
+    const int layer_index = CustomData_get_named_layer_index_notype(&data, name);
+    if (layer_index == -1) {
+      r_sharing.append(nullptr);
+      return true;
+    }
+    r_sharing.append(data.layers[layer_index].sharing_info);
+    return data.layers[layer_index].sharing_info != nullptr;
+  };
+  if (mesh.faces_num > 0) {
+    if (mesh.runtime->face_offsets_sharing_info == nullptr) {
+      return false;
+    }
+    r_sharing.append(mesh.runtime->face_offsets_sharing_info);
+  }
+  bool all_shared = true;
+  all_shared &= add_layer(mesh.edge_data, ".edge_verts");
+  all_shared &= add_layer(mesh.corner_data, ".corner_vert");
+  all_shared &= add_layer(mesh.corner_data, ".corner_edge");
+  all_shared &= add_layer(mesh.vert_data, "crease_vert");
+  all_shared &= add_layer(mesh.edge_data, "crease_edge");
+  /* UV maps define the face-varying topology. */
+  for (const int i : IndexRange(mesh.corner_data.totlayer)) {
+    const CustomDataLayer &layer = mesh.corner_data.layers[i];
+    if (layer.type == CD_PROP_FLOAT2) {
+      r_sharing.append(layer.sharing_info);
+      all_shared &= layer.sharing_info != nullptr;
+    }
+  }
+  return all_shared;
+}
+
+static bool mesh_topology_sharing_matches(const Subdiv &subdiv,
+                                          const Mesh &mesh,
+                                          const Span<const ImplicitSharingInfo *> sharing)
+{
+  if (subdiv.mesh_verts_num != mesh.verts_num) {
+    return false;
+  }
+  if (subdiv.mesh_topology_sharing.size() != sharing.size()) {
+    return false;
+  }
+  for (const int i : sharing.index_range()) {
+    if (subdiv.mesh_topology_sharing[i].get() != sharing[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh)
 {
+  Vector<const ImplicitSharingInfo *> sharing;
+  const bool topology_is_shared = mesh_topology_sharing_gather(*mesh, sharing);
+  if (topology_is_shared && subdiv != nullptr && subdiv->topology_refiner != nullptr &&
+      settings_equal(&subdiv->settings, settings) &&
+      mesh_topology_sharing_matches(*subdiv, *mesh, sharing))
+  {
+    return subdiv;
+  }
+
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
   subdiv = update_from_converter(subdiv, settings, &converter);
   converter_free(&converter);
+  if (subdiv == nullptr) {
+    return nullptr;
+  }
+
+  subdiv->mesh_topology_sharing.clear();
+  if (topology_is_shared) {
+    for (const ImplicitSharingInfo *sharing_info : sharing) {
+      if (sharing_info != nullptr) {
+        sharing_info->add_user();
+      }
+      subdiv->mesh_topology_sharing.append(ImplicitSharingPtr<ImplicitSharingInfo>(sharing_info));
+    }
+    subdiv->mesh_verts_num = mesh->verts_num;
+  }
   return subdiv;
 }
 
@@ -196,7 +279,7 @@ void free(Subdiv *subdiv)
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
-  MEM_freeN(subdiv);
+  MEM_delete(subdiv);
 }
 
 /* --------------------------------------------------------------------
@@ -262,32 +262,22 @@ static void subdiv_ccg_eval_special_grid(Subdiv &subdiv,
   }
 }
 
-static bool subdiv_ccg_evaluate_grids(SubdivCCG &subdiv_ccg,
+static void subdiv_ccg_evaluate_grids(SubdivCCG &subdiv_ccg,
                                       Subdiv &subdiv,
+                                      const IndexMask &face_mask,
                                       SubdivCCGMaskEvaluator *mask_evaluator)
 {
-  using namespace blender;
-  const OpenSubdiv_TopologyRefiner *topology_refiner = subdiv.topology_refiner;
-  const int num_faces = topology_refiner->getNumFaces();
   const Span<int> face_ptex_offset(face_ptex_offset_get(&subdiv), subdiv_ccg.faces.size());
-  threading::parallel_for(IndexRange(num_faces), 1024, [&](const IndexRange range) {
-    for (const int face_index : range) {
-      if (subdiv_ccg.faces[face_index].size() == 4) {
-        subdiv_ccg_eval_regular_grid(
-            subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
-      }
-      else {
-        subdiv_ccg_eval_special_grid(
-            subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
-      }
+  face_mask.foreach_index(GrainSize(1024), [&](const int face_index) {
+    if (subdiv_ccg.faces[face_index].size() == 4) {
+      subdiv_ccg_eval_regular_grid(
+          subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
+    }
+    else {
+      subdiv_ccg_eval_special_grid(
+          subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
     }
   });
-  /* If displacement is used, need to calculate normals after all final
-   * coordinates are known. */
-  if (subdiv.displacement_evaluator != nullptr) {
-    BKE_subdiv_ccg_recalc_normals(subdiv_ccg);
-  }
-  return true;
 }
 
 static void subdiv_ccg_allocate_adjacent_edges(SubdivCCG &subdiv_ccg, const int num_edges)
@@ -474,9 +464,12 @@ std::unique_ptr<SubdivCCG> BKE_subdiv_to_ccg(Subdiv &subdiv,
   subdiv_ccg->grid_to_face_map = coarse_mesh.corner_to_face_map();
   subdiv_ccg_alloc_elements(*subdiv_ccg, subdiv);
   subdiv_ccg_init_faces_neighborhood(*subdiv_ccg);
-  if (!subdiv_ccg_evaluate_grids(*subdiv_ccg, subdiv, mask_evaluator)) {
-    stats_end(&subdiv.stats, SUBDIV_STATS_SUBDIV_TO_CCG);
-    return nullptr;
+  subdiv_ccg_evaluate_grids(
+      *subdiv_ccg, subdiv, subdiv_ccg->faces.index_range(), mask_evaluator);
+  /* If displacement is used, need to calculate normals after all final
+   * coordinates are known. */
+  if (subdiv.displacement_evaluator != nullptr) {
+    BKE_subdiv_ccg_recalc_normals(*subdiv_ccg);
   }
   stats_end(&subdiv.stats, SUBDIV_STATS_SUBDIV_TO_CCG);
   return subdiv_ccg;
@@ -513,6 +506,82 @@ Mesh *BKE_subdiv_to_ccg_mesh(Subdiv &subdiv,
   return result;
 }
 
+#ifdef WITH_OPENSUBDIV
+/**
+ * The limit surface of a face depends on the vertices of all faces that share a vertex with it,
+ * so a changed vertex affects the faces around the vertices of its own faces.
+ */
+static IndexMask subdiv_ccg_faces_affected_by_verts(const Mesh &coarse_mesh,
+                                                    const IndexMask &changed_verts,
+                                                    IndexMaskMemory &memory)
+{
+  const OffsetIndices<int> faces = coarse_mesh.faces();
+  const Span<int> corner_verts = coarse_mesh.corner_verts();
+  const blender::GroupedSpan<int> vert_to_face_map = coarse_mesh.vert_to_face_map();
+  Array<bool> vert_changed(coarse_mesh.verts_num, false);
+  changed_verts.to_bools(vert_changed);
+  const auto face_uses_vert = [&](const int face, const auto &fn) {
+    const Span<int> face_verts = corner_verts.slice(faces[face]);
+    return std::any_of(face_verts.begin(), face_verts.end(), fn);
+  };
+  const IndexMask changed_faces = IndexMask::from_predicate(
+      faces.index_range(), GrainSize(1024), memory, [&](const int face) {
+        return face_uses_vert(face, [&](const int vert) { return vert_changed[vert]; });
+      });
+  Array<bool> face_changed(faces.size(), false);
+  changed_faces.to_bools(face_changed);
+  return IndexMask::from_predicate(
+      faces.index_range(), GrainSize(1024), memory, [&](const int face) {
+        return face_uses_vert(face, [&](const int vert) {
+          const Span<int> vert_faces = vert_to_face_map[vert];
+          return std::any_of(vert_faces.begin(), vert_faces.end(), [&](const int vert_face) {
+            return face_changed[vert_face];
+          });
+        });
+      });
+}
+#endif
+
+bool BKE_subdiv_ccg_update_from_mesh(SubdivCCG &subdiv_ccg,
+                                     const Mesh &coarse_mesh,
+                                     const IndexMask &changed_verts)
+{
+#ifdef WITH_OPENSUBDIV
+  Subdiv &subdiv = *subdiv_ccg.subdiv;
+  BLI_assert(subdiv_ccg.faces.size() == coarse_mesh.faces_num);
+  /* The offsets are owned by the coarse mesh, which is a different one in every evaluation. */
+  subdiv_ccg.faces = coarse_mesh.faces();
+  subdiv_ccg.grid_to_face_map = coarse_mesh.corner_to_face_map();
+  if (changed_verts.is_empty()) {
+    return true;
+  }
+  stats_begin(&subdiv.stats, SUBDIV_STATS_SUBDIV_TO_CCG);
+  if (!eval_begin_from_mesh(&subdiv, &coarse_mesh, nullptr, SUBDIV_EVALUATOR_TYPE_CPU, nullptr)) {
+    stats_end(&subdiv.stats, SUBDIV_STATS_SUBDIV_TO_CCG);
+    return false;
+  }
+  IndexMaskMemory memory;
+  const IndexMask face_mask = subdiv_ccg_faces_affected_by_verts(
+      coarse_mesh, changed_verts, memory);
+  SubdivCCGMaskEvaluator mask_evaluator;
+  const bool has_mask = BKE_subdiv_ccg_mask_init_from_paint(&mask_evaluator, &coarse_mesh);
+  subdiv_ccg_evaluate_grids(subdiv_ccg, subdiv, face_mask, has_mask ? &mask_evaluator : nullptr);
+  if (has_mask) {
+    mask_evaluator.free(&mask_evaluator);
+  }
+  /* Limit normals match on the boundaries of the evaluated faces already, only normals that are
+   * calculated from the displaced positions have to be averaged with the neighbors. */
+  if (subdiv.displacement_evaluator != nullptr) {
+    BKE_subdiv_ccg_update_normals(subdiv_ccg, face_mask);
+  }
+  stats_end(&subdiv.stats, SUBDIV_STATS_SUBDIV_TO_CCG);
+  return true;
+#else
+  UNUSED_VARS(subdiv_ccg, coarse_mesh, changed_verts);
+  return false;
+#endif
+}
+
 SubdivCCG::~SubdivCCG()
 {
   if (this->subdiv != nullptr) {
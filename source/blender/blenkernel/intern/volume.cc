@@ -1090,8 +1090,7 @@ static typename GridType::Ptr create_grid_with_changed_resolution(const GridType
   typename GridType::Ptr new_grid = old_grid.copyWithNewTree();
   transformer.transformGrid<openvdb::tools::BoxSampler>(old_grid, *new_grid);
   new_grid->transform() = old_grid.transform();
-  new_grid->transform().preScale(1.0f / resolution_factor);
-  new_grid->transform().postTranslate(-new_grid->voxelSize() / 2.0f);
+  BKE_volume_grid_transform_change_resolution(new_grid->transform(), resolution_factor);
   return new_grid;
 }
 
@@ -1115,4 +1114,11 @@ openvdb::GridBase::Ptr BKE_volume_grid_create_with_changed_resolution(
   return BKE_volume_grid_type_operation(grid_type, op);
 }
 
+void BKE_volume_grid_transform_change_resolution(openvdb::math::Transform &transform,
+                                                 const float resolution_factor)
+{
+  transform.preScale(1.0f / resolution_factor);
+  transform.postTranslate(-transform.voxelSize() / 2.0f);
+}
+
 #endif
@@ -114,13 +114,20 @@ static FileCache create_file_cache(const StringRef file_path)
   return file_cache;
 }
 
-static FileCache &get_file_cache(const StringRef file_path)
+static FileCache &get_file_cache(std::unique_lock<std::mutex> &lock, const StringRef file_path)
 {
   GlobalCache &global_cache = get_global_cache();
   /* Assumes that the cache is locked already. */
-  BLI_assert(!global_cache.mutex.try_lock());
-  return global_cache.file_map.lookup_or_add_cb_as(file_path,
-                                                   [&]() { return create_file_cache(file_path); });
+  BLI_assert(lock.owns_lock());
+  if (FileCache *file_cache = global_cache.file_map.lookup_ptr_as(file_path)) {
+    return *file_cache;
+  }
+  /* Read the file without holding the lock, so that other files can be accessed in the meantime.
+   * If another thread added the same file already, its cache is used and this one is discarded. */
+  lock.unlock();
+  FileCache new_file_cache = create_file_cache(file_path);
+  lock.lock();
+  return global_cache.file_map.lookup_or_add_as(file_path, std::move(new_file_cache));
 }
 
 /**
@@ -168,11 +175,12 @@ static GVolumeGrid get_cached_grid(const StringRef file_path,
   };
   /* This allows the returned grid to already contain meta-data and transforms, even if the tree is
    * not loaded yet. */
-  openvdb::GridBase::Ptr meta_data_and_transform_grid;
-  if (simplify_level == 0) {
-    /* Only pass the meta-data grid when there is no simplification for now. For simplified grids,
-     * the transform would have to be updated here already. */
-    meta_data_and_transform_grid = grid_cache.meta_data_grid->copyGrid();
+  openvdb::GridBase::Ptr meta_data_and_transform_grid = grid_cache.meta_data_grid->copyGrid();
+  if (simplify_level > 0) {
+    /* Use the same transform that the simplified grid will have, so that e.g. bounds can be
+     * computed without loading and resampling the main grid. */
+    BKE_volume_grid_transform_change_resolution(meta_data_and_transform_grid->transform(),
+                                                1.0f / (1 << simplify_level));
   }
   VolumeGridData *grid_data = MEM_new<VolumeGridData>(
       __func__, load_grid_fn, meta_data_and_transform_grid);
@@ -186,8 +194,8 @@ GVolumeGrid get_grid_from_file(const StringRef file_path,
                                const int simplify_level)
 {
   GlobalCache &global_cache = get_global_cache();
-  std::lock_guard lock{global_cache.mutex};
-  FileCache &file_cache = get_file_cache(file_path);
+  std::unique_lock lock{global_cache.mutex};
+  FileCache &file_cache = get_file_cache(lock, file_path);
   if (GridCache *grid_cache = file_cache.grid_cache_by_name(grid_name)) {
     return get_cached_grid(file_path, *grid_cache, simplify_level);
   }
@@ -198,8 +206,8 @@ GridsFromFile get_all_grids_from_file(const StringRef file_path, const int simpl
 {
   GridsFromFile result;
   GlobalCache &global_cache = get_global_cache();
-  std::lock_guard lock{global_cache.mutex};
-  FileCache &file_cache = get_file_cache(file_path);
+  std::unique_lock lock{global_cache.mutex};
+  FileCache &file_cache = get_file_cache(lock, file_path);
 
   if (!file_cache.error_message.empty()) {
     result.error_message = file_cache.error_message;
@@ -26,6 +26,8 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.h"
+#  include "BLI_task.hh"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 #  include "BLI_vector.hh"
@@ -64,7 +66,8 @@ struct StampData;
 constexpr int64_t swscale_cache_max_entries = 32;
 
 struct SwscaleContext {
-  int width = 0, height = 0;
+  int src_width = 0, src_height = 0;
+  int dst_width = 0, dst_height = 0;
   AVPixelFormat src_format = AV_PIX_FMT_NONE, dst_format = AV_PIX_FMT_NONE;
   int flags = 0;
 
@@ -114,6 +117,12 @@ struct FFMpegContext {
 
   StampData *stamp_data;
 
+  /* Encoding and writing of the last appended frame runs in this pool, such that it overlaps with
+   * rendering of the next frame. The frame buffers are reused, so at most one frame is encoded at
+   * a time. Created on the first appended frame. */
+  TaskPool *encode_pool;
+  bool encode_failed;
+
 #  ifdef WITH_AUDASPACE
   AUD_Device *audio_mixdown_device;
 #  endif
@@ -421,28 +430,31 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
    * the image vertically. */
   int linesize = rgb_frame->linesize[0];
   int linesize_src = rgb_frame->width * 4;
-  for (int y = 0; y < height; y++) {
-    uint8_t *target = rgb_frame->data[0] + linesize * (height - y - 1);
-    const uint8_t *src = pixels + linesize_src * y;
+  blender::threading::parallel_for(
+      blender::IndexRange(height), 64, [&](const blender::IndexRange y_range) {
+        for (const int64_t y : y_range) {
+          uint8_t *target = rgb_frame->data[0] + linesize * (height - y - 1);
+          const uint8_t *src = pixels + linesize_src * y;
 
 #  if ENDIAN_ORDER == L_ENDIAN
-    memcpy(target, src, linesize_src);
+          memcpy(target, src, linesize_src);
 
 #  elif ENDIAN_ORDER == B_ENDIAN
-    const uint8_t *end = src + linesize_src;
-    while (src != end) {
-      target[3] = src[0];
-      target[2] = src[1];
-      target[1] = src[2];
-      target[0] = src[3];
-
-      target += 4;
-      src += 4;
-    }
+          const uint8_t *end = src + linesize_src;
+          while (src != end) {
+            target[3] = src[0];
+            target[2] = src[1];
+            target[1] = src[2];
+            target[0] = src[3];
+
+            target += 4;
+            src += 4;
+          }
 #  else
 #    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
 #  endif
-  }
+        }
+      });
 
   /* Convert to the output pixel format, if it's different that Blender's internal one. */
   if (context->img_convert_frame != nullptr) {
@@ -694,8 +706,13 @@ static const AVCodec *get_av1_encoder(
   return codec;
 }
 
-static SwsContext *sws_create_context(
-    int width, int height, int av_src_format, int av_dst_format, int sws_flags)
+static SwsContext *sws_create_context(int src_width,
+                                      int src_height,
+                                      int av_src_format,
+                                      int dst_width,
+                                      int dst_height,
+                                      int av_dst_format,
+                                      int sws_flags)
 {
 #  if defined(FFMPEG_SWSCALE_THREADING)
   /* sws_getContext does not allow passing flags that ask for multi-threaded
@@ -704,11 +721,11 @@ static SwsContext *sws_create_context(
   if (c == nullptr) {
     return nullptr;
   }
-  av_opt_set_int(c, "srcw", width, 0);
-  av_opt_set_int(c, "srch", height, 0);
+  av_opt_set_int(c, "srcw", src_width, 0);
+  av_opt_set_int(c, "srch", src_height, 0);
   av_opt_set_int(c, "src_format", av_src_format, 0);
-  av_opt_set_int(c, "dstw", width, 0);
-  av_opt_set_int(c, "dsth", height, 0);
+  av_opt_set_int(c, "dstw", dst_width, 0);
+  av_opt_set_int(c, "dsth", dst_height, 0);
   av_opt_set_int(c, "dst_format", av_dst_format, 0);
   av_opt_set_int(c, "sws_flags", sws_flags, 0);
   av_opt_set_int(c, "threads", BLI_system_thread_count(), 0);
@@ -718,11 +735,11 @@ static SwsContext *sws_create_context(
     return nullptr;
   }
 #  else
-  SwsContext *c = sws_getContext(width,
-                                 height,
+  SwsContext *c = sws_getContext(src_width,
+                                 src_height,
                                  AVPixelFormat(av_src_format),
-                                 width,
-                                 height,
+                                 dst_width,
+                                 dst_height,
                                  AVPixelFormat(av_dst_format),
                                  sws_flags,
                                  nullptr,
@@ -779,6 +796,18 @@ static void maintain_swscale_cache_size()
 
 SwsContext *BKE_ffmpeg_sws_get_context(
     int width, int height, int av_src_format, int av_dst_format, int sws_flags)
+{
+  return BKE_ffmpeg_sws_get_context(
+      width, height, av_src_format, width, height, av_dst_format, sws_flags);
+}
+
+SwsContext *BKE_ffmpeg_sws_get_context(int src_width,
+                                       int src_height,
+                                       int av_src_format,
+                                       int dst_width,
+                                       int dst_height,
+                                       int av_dst_format,
+                                       int sws_flags)
 {
   BLI_mutex_lock(&swscale_cache_lock);
 
@@ -789,8 +818,9 @@ SwsContext *BKE_ffmpeg_sws_get_context(
   /* Search for unused context that has suitable parameters. */
   SwsContext *ctx = nullptr;
   for (SwscaleContext &c : *swscale_cache) {
-    if (!c.is_used && c.width == width && c.height == height && c.src_format == av_src_format &&
-        c.dst_format == av_dst_format && c.flags == sws_flags)
+    if (!c.is_used && c.src_width == src_width && c.src_height == src_height &&
+        c.dst_width == dst_width && c.dst_height == dst_height &&
+        c.src_format == av_src_format && c.dst_format == av_dst_format && c.flags == sws_flags)
     {
       ctx = c.context;
       /* Mark as used. */
@@ -801,10 +831,13 @@ SwsContext *BKE_ffmpeg_sws_get_context(
   }
   if (ctx == nullptr) {
     /* No free matching context in cache: create a new one. */
-    ctx = sws_create_context(width, height, av_src_format, av_dst_format, sws_flags);
+    ctx = sws_create_context(
+        src_width, src_height, av_src_format, dst_width, dst_height, av_dst_format, sws_flags);
     SwscaleContext c;
-    c.width = width;
-    c.height = height;
+    c.src_width = src_width;
+    c.src_height = src_height;
+    c.dst_width = dst_width;
+    c.dst_height = dst_height;
     c.src_format = AVPixelFormat(av_src_format);
     c.dst_format = AVPixelFormat(av_dst_format);
     c.flags = sws_flags;
@@ -1706,6 +1739,48 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+struct FFMpegEncodeTaskData {
+  AVFrame *frame;
+  ReportList *reports;
+  double audio_to_pts;
+};
+
+/* Encode the given video frame and the audio up to the given time, and write them to the output
+ * file. */
+static void encode_frame(FFMpegContext *context,
+                         AVFrame *frame,
+                         ReportList *reports,
+                         double audio_to_pts)
+{
+  if (!write_video_frame(context, frame, reports)) {
+    context->encode_failed = true;
+  }
+#  ifdef WITH_AUDASPACE
+  write_audio_frames(context, audio_to_pts);
+#  else
+  UNUSED_VARS(audio_to_pts);
+#  endif
+}
+
+static void encode_frame_task(TaskPool *__restrict pool, void *task_data_v)
+{
+  FFMpegContext *context = static_cast<FFMpegContext *>(BLI_task_pool_user_data(pool));
+  FFMpegEncodeTaskData *task_data = static_cast<FFMpegEncodeTaskData *>(task_data_v);
+  encode_frame(context, task_data->frame, task_data->reports, task_data->audio_to_pts);
+}
+
+/* Wait until the frame that is being encoded in the background is written. Returns false if
+ * encoding any frame since the last call failed. */
+static bool encode_wait(FFMpegContext *context)
+{
+  if (context->encode_pool) {
+    BLI_task_pool_work_and_wait(context->encode_pool);
+  }
+  const bool success = !context->encode_failed;
+  context->encode_failed = false;
+  return success;
+}
+
 bool BKE_ffmpeg_append(void *context_v,
                        RenderData *rd,
                        int start_frame,
@@ -1721,17 +1796,24 @@ bool BKE_ffmpeg_append(void *context_v,
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, image->x, image->y);
 
   if (context->video_stream) {
+    /* The previous frame is still encoded from the same frame buffers, so wait for it before
+     * generating the next frame. A failure to encode it is reported for this frame. */
+    success = encode_wait(context);
+
     avframe = generate_video_frame(context, image);
-    success = (avframe && write_video_frame(context, avframe, reports));
-#  ifdef WITH_AUDASPACE
+    if (avframe == nullptr) {
+      return false;
+    }
+
     /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (double(rd->frs_sec) / double(rd->frs_sec_base)));
-#  else
-    UNUSED_VARS(start_frame);
-#  endif
+    const double audio_to_pts = (frame - start_frame + 1) /
+                                (double(rd->frs_sec) / double(rd->frs_sec_base));
 
     if (context->ffmpeg_autosplit) {
+      /* The file size is only known after the frame is written, so encode it right away. */
+      encode_frame(context, avframe, reports, audio_to_pts);
+      success &= encode_wait(context);
+
       if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
         end_ffmpeg_impl(context, true);
         context->ffmpeg_autosplit_count++;
@@ -1739,6 +1821,17 @@ bool BKE_ffmpeg_append(void *context_v,
         success &= start_ffmpeg_impl(context, rd, image->x, image->y, suffix, reports);
       }
     }
+    else {
+      if (context->encode_pool == nullptr) {
+        context->encode_pool = BLI_task_pool_create_background_serial(context,
+                                                                      TASK_PRIORITY_HIGH);
+      }
+      FFMpegEncodeTaskData *task_data = MEM_cnew<FFMpegEncodeTaskData>(__func__);
+      task_data->frame = avframe;
+      task_data->reports = reports;
+      task_data->audio_to_pts = audio_to_pts;
+      BLI_task_pool_push(context->encode_pool, encode_frame_task, task_data, true, nullptr);
+    }
   }
 
   return success;
@@ -1748,6 +1841,8 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing FFMPEG...\n");
 
+  encode_wait(context);
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -1974,6 +2069,10 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context == nullptr) {
     return;
   }
+  if (context->encode_pool) {
+    BLI_task_pool_work_and_wait(context->encode_pool);
+    BLI_task_pool_free(context->encode_pool);
+  }
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
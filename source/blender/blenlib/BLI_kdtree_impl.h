@@ -62,6 +62,34 @@ void BLI_kdtree_nd_(range_search_cb)(
     bool (*search_cb)(void *user_data, int index, const float co[KD_DIMS], float dist_sq),
     void *user_data);
 
+/**
+ * Batched versions of the searches above, the queries run in parallel.
+ *
+ * - #find_nearest_batch writes one result per query, with an index of -1 when nothing was found.
+ * - #find_nearest_n_batch writes \a nearest_len_capacity results per query, the number of found
+ *   results is written to \a r_found.
+ * - #range_search_batch_cb calls \a search_cb from multiple threads at once, so it has to be
+ *   thread-safe. A false return value stops the search of that query only.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        unsigned int co_len,
+                                        KDTreeNearest *r_nearest) ATTR_NONNULL(1, 4);
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          unsigned int co_len,
+                                          KDTreeNearest *r_nearest,
+                                          unsigned int nearest_len_capacity,
+                                          int *r_found) ATTR_NONNULL(1, 4, 6);
+void BLI_kdtree_nd_(range_search_batch_cb)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    unsigned int co_len,
+    float range,
+    bool (*search_cb)(
+        void *user_data, int query_index, int index, const float co[KD_DIMS], float dist_sq),
+    void *user_data);
+
 int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          float range,
                                          bool use_index_order,
@@ -0,0 +1,135 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * A #LocalAllocator provides temporary memory to code running on a single thread, without going
+ * through the global allocator for every buffer. Freed buffers are kept in free lists per size
+ * class and are reused by later allocations of the same thread.
+ *
+ * A #LocalAllocatorSet owns one local allocator per thread. It is typically created right before
+ * a parallel loop and captured by reference in the loop body, which then uses the allocator of
+ * the current thread to allocate its per-chunk buffers. All memory is freed when the set is
+ * destructed.
+ *
+ * \code{.cc}
+ * LocalAllocatorSet allocators;
+ * threading::parallel_for(range, 1024, [&](const IndexRange range) {
+ *   LocalAllocator &allocator = allocators.local();
+ *   MutableSpan<float> buffer = allocator.allocate_array<float>(range.size());
+ *   ...
+ *   allocator.deallocate_array(buffer);
+ * });
+ * \endcode
+ */
+
+#pragma once
+
+#include <array>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+class LocalAllocator : NonCopyable, NonMovable {
+ private:
+  /** Minimum size and alignment of the buffers handed out. */
+  static constexpr int64_t min_buffer_size = 16;
+  /** Buffers are at most aligned to this, which is enough for all types used in practice. */
+  static constexpr int64_t max_alignment = 64;
+  /** Buffers in larger size classes are not reused and go to the global allocator directly. */
+  static constexpr int size_classes_num = 17;
+
+  /** Owns the buffers of all size classes, they are freed together with the allocator. */
+  LinearAllocator<> linear_allocator_;
+  std::array<Vector<void *, 0>, size_classes_num> free_buffers_;
+
+ public:
+  /**
+   * Get a buffer with at least the given size and alignment. It has to be freed with
+   * #deallocate with the same size and alignment from the same thread, or it is freed when the
+   * allocator is destructed.
+   */
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    BLI_assert(size >= 0);
+    BLI_assert(alignment <= max_alignment);
+    const int size_class = this->size_class_get(size);
+    if (size_class == size_classes_num) {
+      return MEM_mallocN_aligned(size_t(size), size_t(alignment), __func__);
+    }
+    Vector<void *, 0> &free_buffers = free_buffers_[size_class];
+    if (!free_buffers.is_empty()) {
+      return free_buffers.pop_last();
+    }
+    const int64_t class_size = min_buffer_size << size_class;
+    return linear_allocator_.allocate(class_size, std::min(class_size, max_alignment));
+  }
+
+  void deallocate(const void *buffer, const int64_t size, const int64_t /*alignment*/)
+  {
+    if (buffer == nullptr) {
+      return;
+    }
+    const int size_class = this->size_class_get(size);
+    if (size_class == size_classes_num) {
+      MEM_freeN(const_cast<void *>(buffer));
+      return;
+    }
+    free_buffers_[size_class].append(const_cast<void *>(buffer));
+  }
+
+  /**
+   * Allocate a buffer for an array of the given size. The elements are not constructed.
+   */
+  template<typename T> MutableSpan<T> allocate_array(const int64_t size)
+  {
+    T *array = static_cast<T *>(this->allocate(sizeof(T) * size, alignof(T)));
+    return MutableSpan<T>(array, size);
+  }
+
+  /**
+   * Free a buffer from #allocate_array. The elements are not destructed.
+   */
+  template<typename T> void deallocate_array(const MutableSpan<T> array)
+  {
+    this->deallocate(array.data(), sizeof(T) * array.size(), alignof(T));
+  }
+
+ private:
+  /** Index of the smallest power of two size class that fits the size. */
+  int size_class_get(const int64_t size) const
+  {
+    int size_class = 0;
+    int64_t class_size = min_buffer_size;
+    while (class_size < size && size_class < size_classes_num) {
+      class_size <<= 1;
+      size_class++;
+    }
+    return size_class;
+  }
+};
+
+/**
+ * Owns a #LocalAllocator for every thread that uses it.
+ */
+class LocalAllocatorSet : NonCopyable, NonMovable {
+ private:
+  threading::EnumerableThreadSpecific<LocalAllocator> allocators_;
+
+ public:
+  /** The allocator of the current thread. */
+  LocalAllocator &local()
+  {
+    return allocators_.local();
+  }
+};
+
+}  // namespace blender
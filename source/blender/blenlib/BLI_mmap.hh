@@ -0,0 +1,84 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * A #MappedFile makes the memory mapped content of a file available to code that works with
+ * implicitly shared arrays, like #CustomData layers. Parts of the file can be referenced directly
+ * instead of reading them into newly allocated buffers. The pages are only loaded from disk when
+ * they are accessed, and they can be evicted by the operating system without swapping.
+ */
+
+#pragma once
+
+#ifndef __cplusplus
+#  error This is a C++ header
+#endif
+
+#include <optional>
+
+#include "BLI_implicit_sharing.hh"
+#include "BLI_index_range.hh"
+#include "BLI_mmap.h"
+#include "BLI_span.hh"
+
+namespace blender {
+
+/**
+ * A memory mapped file that is unmapped when its last user is removed.
+ *
+ * The mapping is copy-on-write. When the data of a shared range ends up with a single owner, that
+ * owner may modify it in place like any other implicitly shared data. The modified pages are
+ * private to the process and the file is never changed.
+ */
+class MappedFile : public ImplicitSharingMixin {
+ private:
+  BLI_mmap_file *file_;
+
+ public:
+  MappedFile(BLI_mmap_file *file);
+  ~MappedFile();
+
+  /**
+   * Map the file at the given path. The returned file has one user that has to be removed by
+   * the caller.
+   * \return Null when the file does not exist or can't be mapped.
+   */
+  static const MappedFile *open(const char *filepath);
+
+  /** The content of the whole file. */
+  Span<std::byte> data() const;
+
+  /**
+   * Whether accessing the memory failed, e.g. because the file was truncated. The content of the
+   * file is replaced with zeros in that case.
+   */
+  bool has_io_error() const;
+
+  /**
+   * Share a part of the file. Every shared range gets its own sharing info that keeps the file
+   * mapped, so that separate ranges can't be mistaken for the same data by code that compares
+   * sharing info pointers.
+   * \return None when the range is not inside of the file.
+   */
+  std::optional<ImplicitSharingInfoAndData> share_range(IndexRange byte_range) const;
+
+  /** Same as above, but for an array of trivial values. */
+  template<typename T>
+  std::optional<ImplicitSharingInfoAndData> share_array(const int64_t byte_offset,
+                                                        const int64_t size) const
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (byte_offset % alignof(T) != 0) {
+      return std::nullopt;
+    }
+    return this->share_range(IndexRange(byte_offset, sizeof(T) * size));
+  }
+
+ private:
+  void delete_self() override;
+};
+
+}  // namespace blender
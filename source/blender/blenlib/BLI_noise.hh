@@ -5,6 +5,7 @@
 #pragma once
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -65,6 +66,13 @@ float perlin_signed(float2 position);
 float perlin_signed(float3 position);
 float perlin_signed(float4 position);
 
+/**
+ * Same as above, but for many positions at once. Four positions are evaluated at the same time
+ * with SIMD instructions when they are available. The results can differ from the version for a
+ * single position in the last bits.
+ */
+void perlin_signed(Span<float3> positions, MutableSpan<float> r_values);
+
 /* Perlin noise in the range [0, 1]. */
 
 float perlin(float position);
@@ -77,6 +85,14 @@ float perlin(float4 position);
 template<typename T>
 float perlin_fbm(T p, float detail, float roughness, float lacunarity, bool normalize);
 
+/** Same as above, but for many positions that use the same parameters. */
+void perlin_fbm(Span<float3> positions,
+                float detail,
+                float roughness,
+                float lacunarity,
+                bool normalize,
+                MutableSpan<float> r_values);
+
 /* Distorted fractal perlin noise. */
 
 template<typename T>
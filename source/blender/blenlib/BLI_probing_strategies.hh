@@ -197,6 +197,42 @@ template<uint64_t LinearSteps = 2, bool PreShuffle = false> class ShuffleProbing
   }
 };
 
+/**
+ * Probes groups of consecutive slots, similar to the probing in Swiss tables. All slots of a group
+ * are checked before jumping to the next group, and the jumps between groups grow with triangular
+ * numbers, which hits every group when the number of groups is a power of two.
+ *
+ * A group spans a cache line for small slots, so a lookup mostly touches a single cache line even
+ * at high load factors. Works best with slot types that store the hash, like #HashedMapSlot and
+ * #HashedSetSlot, because then the keys in a group are only compared when their hash matches.
+ */
+template<uint64_t GroupSize = 16> class GroupProbingStrategy {
+ private:
+  uint64_t hash_;
+  uint64_t iteration_;
+
+  static_assert((GroupSize & (GroupSize - 1)) == 0, "Group size has to be a power of two");
+
+ public:
+  GroupProbingStrategy(const uint64_t hash) : hash_(hash), iteration_(0) {}
+
+  void next()
+  {
+    iteration_++;
+    hash_ += GroupSize * iteration_;
+  }
+
+  uint64_t get() const
+  {
+    return hash_;
+  }
+
+  int64_t linear_steps() const
+  {
+    return GroupSize;
+  }
+};
+
 /**
  * Having a specified default is convenient.
  */
@@ -14,6 +14,13 @@
 #  include <algorithm>
 #endif
 
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+#include "BLI_array.hh"
+#include "BLI_task.hh"
+
 namespace blender {
 
 #ifdef WITH_TBB
@@ -31,4 +38,150 @@ void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const C
 }
 #endif
 
+namespace detail {
+
+/** Placeholder for the values of #parallel_radix_sort when only keys are sorted. */
+struct RadixSortNoValue {};
+
+/**
+ * Map a key to unsigned bits that have the same order as the key. Negative floats are inverted,
+ * so that larger magnitudes come first. NaN values are sorted to the start or the end, depending
+ * on their sign bit.
+ */
+template<typename Key> inline auto radix_sort_key_bits(const Key key)
+{
+  using Bits = std::conditional_t<sizeof(Key) == 8, uint64_t, uint32_t>;
+  constexpr Bits sign_bit = Bits(1) << (sizeof(Bits) * 8 - 1);
+  if constexpr (std::is_floating_point_v<Key>) {
+    Bits bits;
+    memcpy(&bits, &key, sizeof(Key));
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+  }
+  else if constexpr (std::is_signed_v<Key>) {
+    return Bits(key) ^ sign_bit;
+  }
+  else {
+    return Bits(key);
+  }
+}
+
+template<typename Key, typename Value>
+inline void parallel_radix_sort_impl(MutableSpan<Key> keys, MutableSpan<Value> values)
+{
+  static_assert(ELEM(sizeof(Key), 4, 8) && std::is_arithmetic_v<Key>,
+                "Only 32 and 64 bit integer and float keys are supported");
+  static_assert(std::is_trivially_copyable_v<Value>);
+  constexpr bool use_values = !std::is_same_v<Value, RadixSortNoValue>;
+  constexpr int digit_bits = 8;
+  constexpr int digits_num = 1 << digit_bits;
+  constexpr int passes_num = sizeof(Key) * 8 / digit_bits;
+
+  const int64_t size = keys.size();
+  BLI_assert(!use_values || values.size() == size);
+  if (size < 2) {
+    return;
+  }
+
+  /* Every chunk gets its own histogram, so that chunks can be scattered in parallel. Because the
+   * chunks are processed in order, the sort is stable independent of the chunk size. */
+  const int64_t chunk_size = std::max<int64_t>(int64_t(1) << 14, size / 512);
+  const int64_t chunks_num = (size + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * chunk_size;
+    return IndexRange(start, std::min(chunk_size, size - start));
+  };
+
+  Array<Key> keys_buffer(size, NoInitialization());
+  Array<Value> values_buffer(use_values ? size : 0, NoInitialization());
+  Array<std::array<int64_t, digits_num>> chunk_offsets(chunks_num, NoInitialization());
+
+  MutableSpan<Key> src_keys = keys;
+  MutableSpan<Key> dst_keys = keys_buffer;
+  MutableSpan<Value> src_values = values;
+  MutableSpan<Value> dst_values = values_buffer;
+
+  for (int pass = 0; pass < passes_num; pass++) {
+    const int shift = pass * digit_bits;
+    const auto digit_of = [&](const Key key) {
+      return int((radix_sort_key_bits(key) >> shift) & (digits_num - 1));
+    };
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        std::array<int64_t, digits_num> &counts = chunk_offsets[chunk];
+        counts.fill(0);
+        for (const int64_t i : chunk_range(chunk)) {
+          counts[digit_of(src_keys[i])]++;
+        }
+      }
+    });
+
+    /* Turn the counts into the start offset of every digit in every chunk. A pass can be skipped
+     * when all keys have the same digit, which is common for the high bytes of small keys. */
+    bool all_keys_in_one_digit = false;
+    int64_t offset = 0;
+    for (const int digit : IndexRange(digits_num)) {
+      const int64_t digit_start = offset;
+      for (const int64_t chunk : IndexRange(chunks_num)) {
+        const int64_t count = chunk_offsets[chunk][digit];
+        chunk_offsets[chunk][digit] = offset;
+        offset += count;
+      }
+      if (offset - digit_start == size) {
+        all_keys_in_one_digit = true;
+        break;
+      }
+    }
+    if (all_keys_in_one_digit) {
+      continue;
+    }
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        std::array<int64_t, digits_num> &offsets = chunk_offsets[chunk];
+        for (const int64_t i : chunk_range(chunk)) {
+          const int64_t dst_index = offsets[digit_of(src_keys[i])]++;
+          dst_keys[dst_index] = src_keys[i];
+          if constexpr (use_values) {
+            dst_values[dst_index] = src_values[i];
+          }
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  if (src_keys.data() != keys.data()) {
+    threading::parallel_for(IndexRange(size), 4096, [&](const IndexRange range) {
+      keys.slice(range).copy_from(src_keys.slice(range));
+      if constexpr (use_values) {
+        values.slice(range).copy_from(src_values.slice(range));
+      }
+    });
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Sort the keys in ascending order with a least significant digit radix sort. The sort is stable
+ * and runs in linear time, which makes it much faster than a comparison sort for large arrays.
+ * Supported keys are 32 and 64 bit integers and floats.
+ */
+template<typename Key> inline void parallel_radix_sort(MutableSpan<Key> keys)
+{
+  detail::parallel_radix_sort_impl(keys, MutableSpan<detail::RadixSortNoValue>());
+}
+
+/**
+ * Same as above, but also reorders the values in the same way as the keys. Values with equal keys
+ * keep their order, so sorting indices by a key gives a deterministic result.
+ */
+template<typename Key, typename Value>
+inline void parallel_radix_sort(MutableSpan<Key> keys, MutableSpan<Value> values)
+{
+  detail::parallel_radix_sort_impl(keys, values);
+}
+
 }  // namespace blender
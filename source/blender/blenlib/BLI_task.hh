@@ -255,4 +255,67 @@ inline void memory_bandwidth_bound_task(const int64_t approximate_bytes_touched,
   detail::memory_bandwidth_bound_task_impl(function);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Task Tracing
+ *
+ * Opt-in recording of the tasks run by #parallel_for and task pools, to see where threads go idle
+ * in a timeline. The recorded tasks are written as Chrome trace JSON, which can be opened in
+ * `chrome://tracing` or Perfetto.
+ * \{ */
+
+namespace trace {
+
+/** Start recording tasks, discarding previously recorded ones. */
+void start();
+/**
+ * Stop recording and write the recorded tasks to the file.
+ * \return False when the file could not be written.
+ */
+bool stop_and_write(const char *filepath);
+bool is_enabled();
+
+/** The tag of the enclosing #TraceTag scope on this thread, or null. */
+const char *current_tag();
+
+/**
+ * Name the tasks started on this thread while the scope is alive. Tasks inherit the tag of the
+ * code that started them, so nested parallel loops are attributed to the same caller.
+ * The name is expected to be a static string.
+ */
+class TraceTag {
+  const char *previous_;
+
+ public:
+  TraceTag(const char *name);
+  ~TraceTag();
+
+  TraceTag(const TraceTag &other) = delete;
+  TraceTag &operator=(const TraceTag &other) = delete;
+};
+
+namespace detail {
+
+/** Records the execution of one task from construction to destruction. */
+class TaskScope {
+  const char *category_;
+  const char *tag_;
+  const char *previous_tag_;
+  int64_t grain_size_;
+  int64_t size_;
+  int64_t begin_;
+
+ public:
+  TaskScope(const char *category, const char *tag, int64_t grain_size, int64_t size);
+  ~TaskScope();
+
+  TaskScope(const TaskScope &other) = delete;
+  TaskScope &operator=(const TaskScope &other) = delete;
+};
+
+}  // namespace detail
+
+}  // namespace trace
+
+/** \} */
+
 }  // namespace blender::threading
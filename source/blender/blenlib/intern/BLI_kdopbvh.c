@@ -55,6 +55,10 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Bounds of branches with more leafs are computed in parallel, in blocks of leafs. */
+#define KDOPBVH_REFIT_PARALLEL_LEAF_THRESHOLD 16384
+#define KDOPBVH_REFIT_BLOCK_SIZE 4096
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -370,18 +374,12 @@ static void create_kdop_hull(
   }
 }
 
-/**
- * \note depends on the fact that the BVH's for each face is already built
- */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+static void refit_kdop_hull_bv(const BVHTree *tree, float *__restrict bv, int start, int end)
 {
   float newmin, newmax;
-  float *__restrict bv = node->bv;
   int j;
   axis_t axis_iter;
 
-  node_minmax_init(tree, node);
-
   for (j = start; j < end; j++) {
     float *__restrict node_bv = tree->nodes[j]->bv;
 
@@ -400,6 +398,75 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  int start, end;
+} BVHRefitData;
+
+typedef struct BVHRefitChunk {
+  float bv[26];
+} BVHRefitChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int iter,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  BVHRefitChunk *chunk = tls->userdata_chunk;
+  const int block_start = data->start + iter * KDOPBVH_REFIT_BLOCK_SIZE;
+  const int block_end = min_ii(block_start + KDOPBVH_REFIT_BLOCK_SIZE, data->end);
+  refit_kdop_hull_bv(data->tree, chunk->bv, block_start, block_end);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHRefitData *data = userdata;
+  float *bv_join = ((BVHRefitChunk *)chunk_join)->bv;
+  const float *bv = ((const BVHRefitChunk *)chunk)->bv;
+  for (axis_t axis_iter = data->tree->start_axis; axis_iter < data->tree->stop_axis; axis_iter++)
+  {
+    bv_join[2 * axis_iter] = min_ff(bv_join[2 * axis_iter], bv[2 * axis_iter]);
+    bv_join[2 * axis_iter + 1] = max_ff(bv_join[2 * axis_iter + 1], bv[2 * axis_iter + 1]);
+  }
+}
+
+/**
+ * \note depends on the fact that the BVH's for each face is already built
+ */
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  node_minmax_init(tree, node);
+
+  if (end - start <= KDOPBVH_REFIT_PARALLEL_LEAF_THRESHOLD) {
+    refit_kdop_hull_bv(tree, node->bv, start, end);
+    return;
+  }
+
+  /* The top levels of the tree have too few branches to keep all threads busy, so the bounds of
+   * their large leaf ranges are computed in parallel as well. */
+  BVHRefitData data = {tree, start, end};
+  BVHRefitChunk chunk;
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    chunk.bv[2 * axis_iter] = FLT_MAX;
+    chunk.bv[2 * axis_iter + 1] = -FLT_MAX;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_reduce = refit_kdop_hull_reduce;
+  const int blocks_num = (end - start + KDOPBVH_REFIT_BLOCK_SIZE - 1) / KDOPBVH_REFIT_BLOCK_SIZE;
+  BLI_task_parallel_range(0, blocks_num, &data, refit_kdop_hull_task_cb, &settings);
+
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    node->bv[2 * axis_iter] = chunk.bv[2 * axis_iter];
+    node->bv[2 * axis_iter + 1] = chunk.bv[2 * axis_iter + 1];
+  }
+}
+
 /**
  * Only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake.
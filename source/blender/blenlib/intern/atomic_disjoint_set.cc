@@ -60,28 +60,22 @@ void AtomicDisjointSet::calc_reduced_ids(MutableSpan<int> result) const
     }
   }
 
-  struct RootOccurence {
-    int root;
-    int first_occurrence;
-  };
-
   /* Sort roots by first occurrence. This removes the non-determinism above. */
-  Vector<RootOccurence, 16> root_occurrences;
-  root_occurrences.reserve(combined_map.size());
+  Array<int> first_occurrences(combined_map.size());
+  Array<int> roots(combined_map.size());
+  int root_index = 0;
   for (const auto item : combined_map.items()) {
-    root_occurrences.append({item.key, item.value});
+    first_occurrences[root_index] = item.value;
+    roots[root_index] = item.key;
+    root_index++;
   }
-  parallel_sort(root_occurrences.begin(),
-                root_occurrences.end(),
-                [](const RootOccurence &a, const RootOccurence &b) {
-                  return a.first_occurrence < b.first_occurrence;
-                });
+  parallel_radix_sort<int, int>(first_occurrences, roots);
 
   /* Remap original root values with deterministic values. */
   Map<int, int> id_by_root;
-  id_by_root.reserve(root_occurrences.size());
-  for (const int i : root_occurrences.index_range()) {
-    id_by_root.add_new(root_occurrences[i].root, i);
+  id_by_root.reserve(roots.size());
+  for (const int i : roots.index_range()) {
+    id_by_root.add_new(roots[i], i);
   }
   threading::parallel_for(IndexRange(size), 1024, [&](const IndexRange range) {
     for (const int i : range) {
@@ -11,9 +11,14 @@
 
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
+/* Maximum number of frames that are decompressed in parallel while reading sequentially. */
+#define ZSTD_PARALLEL_FRAMES_MAX 16
+
 typedef struct {
   FileReader reader;
 
@@ -28,8 +33,12 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
+    /* Decompressed frames, starting at #cached_frame. */
+    char *cached_content[ZSTD_PARALLEL_FRAMES_MAX];
     int cached_frame;
+    int cached_frames_num;
+    /* Number of frames that are decompressed together when reading sequentially. */
+    int parallel_frames_num;
   } seek;
 } ZstdReader;
 
@@ -126,6 +135,7 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.parallel_frames_num = clamp_i(BLI_system_thread_count(), 1, ZSTD_PARALLEL_FRAMES_MAX);
 
   return true;
 }
@@ -153,42 +163,104 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+static void zstd_cache_free(ZstdReader *zstd)
+{
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    MEM_freeN(zstd->seek.cached_content[i]);
+    zstd->seek.cached_content[i] = NULL;
+  }
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
+
+typedef struct ZstdDecompressData {
+  ZstdReader *zstd;
+  int first_frame;
+  const char *compressed_data;
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_fn(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = userdata;
+  ZstdReader *zstd = data->zstd;
+  const int frame = data->first_frame + i;
+
+  const size_t *compressed_ofs = zstd->seek.compressed_ofs;
+  const size_t *uncompressed_ofs = zstd->seek.uncompressed_ofs;
+  size_t compressed_size = compressed_ofs[frame + 1] - compressed_ofs[frame];
+  size_t uncompressed_size = uncompressed_ofs[frame + 1] - uncompressed_ofs[frame];
+
+  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* The context of the reader is only used by the calling thread, use a temporary context. */
+  size_t res = ZSTD_decompress(uncompressed_data,
+                               uncompressed_size,
+                               data->compressed_data + (compressed_ofs[frame] -
+                                                        compressed_ofs[data->first_frame]),
+                               compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    uncompressed_data = NULL;
+  }
+  zstd->seek.cached_content[i] = uncompressed_data;
+}
+
+/* Ensure that the wanted frame is loaded. When the frames are read in order, the following
+ * frames are decompressed in parallel together with the wanted one. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
+  if (frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_frames_num)
+  {
     /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+    return zstd->seek.cached_content[frame - zstd->seek.cached_frame];
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. Random access
+   * only decompresses a single frame, to avoid wasting time on frames that aren't used. */
+  const bool is_sequential = frame == 0 ||
+                             frame == zstd->seek.cached_frame + zstd->seek.cached_frames_num;
+  zstd_cache_free(zstd);
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  const int frames_num = is_sequential ? min_ii(zstd->seek.parallel_frames_num,
+                                                zstd->seek.frames_num - frame) :
+                                         1;
 
-  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* The frames are stored consecutively, so their compressed data is read at once. */
+  size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                           zstd->seek.compressed_ofs[frame];
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
   {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  ZstdDecompressData data = {zstd, frame, compressed_data};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = frames_num > 1;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_fn, &settings);
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
+
+  /* Only keep the frames before the first one that failed to decompress. */
+  int valid_frames_num = 0;
+  while (valid_frames_num < frames_num && zstd->seek.cached_content[valid_frames_num]) {
+    valid_frames_num++;
+  }
+  for (int i = valid_frames_num; i < frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
+  }
+  if (valid_frames_num == 0) {
     return NULL;
   }
 
   zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  zstd->seek.cached_frames_num = valid_frames_num;
+  return zstd->seek.cached_content[0];
 }
 
 static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -281,10 +353,7 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: #99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
+    zstd_cache_free(zstd);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -7,6 +7,7 @@
 #include <mutex>
 
 #include "BLI_array.hh"
+#include "BLI_bit_span_ops.hh"
 #include "BLI_bit_vector.hh"
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_index_mask.hh"
@@ -442,13 +443,50 @@ IndexMask IndexMask::from_bits(const BitSpan bits, IndexMaskMemory &memory)
   return IndexMask::from_bits(bits.index_range(), bits, memory);
 }
 
+/**
+ * Get the same bits with the data pointer moved to the first int, so that bit spans starting at
+ * an int boundary are bounded and can be processed an int at a time.
+ */
+static BitSpan bit_span_normalize_start(const BitSpan bits)
+{
+  const int64_t start = bits.bit_range().start();
+  return BitSpan(bits.data() + (start >> bits::BitToIntIndexShift),
+                 IndexRange(start & bits::BitIndexMask, bits.size()));
+}
+
 IndexMask IndexMask::from_bits(const IndexMask &universe,
                                const BitSpan bits,
                                IndexMaskMemory &memory)
 {
-  return IndexMask::from_predicate(universe, GrainSize(1024), memory, [bits](const int64_t index) {
-    return bits[index].test();
-  });
+  return detail::from_predicate_impl(
+      universe,
+      GrainSize(1024),
+      memory,
+      [bits](const IndexMaskSegment indices, int16_t *__restrict r_true_indices) {
+        int16_t *r_current = r_true_indices;
+        const int64_t offset = indices.offset();
+        if (unique_sorted_indices::non_empty_is_range(indices.base_span())) {
+          /* Skip over unset bits an int at a time, which makes sparse selections cheap. */
+          const IndexRange range(indices[0], indices.size());
+          const BitSpan range_bits = bit_span_normalize_start(bits.slice(range));
+          const int64_t first_local_index = range.start() - offset;
+          const auto handle = [&](const int64_t i) {
+            *r_current++ = int16_t(first_local_index + i);
+          };
+          if (is_bounded_span(range_bits)) {
+            bits::foreach_1_index(BoundedBitSpan(range_bits), handle);
+          }
+          else {
+            bits::foreach_1_index(range_bits, handle);
+          }
+          return int64_t(r_current - r_true_indices);
+        }
+        for (const int16_t local_index : indices.base_span()) {
+          *r_current = local_index;
+          r_current += bits[local_index + offset].test();
+        }
+        return int64_t(r_current - r_true_indices);
+      });
 }
 
 IndexMask IndexMask::from_bools(Span<bool> bools, IndexMaskMemory &memory)
@@ -10,6 +10,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include <string.h>
@@ -50,6 +51,11 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/* Sub-trees with more nodes than this are balanced in a separate task. */
+#define KD_BALANCE_TASK_NODES_MIN 8192
+/* Number of queries handled by a thread at once in the batched searches. */
+#define KD_BATCH_GRAIN_SIZE 256
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see #62210.
@@ -139,7 +145,22 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  uint *r_root;
+} KDTreeBalanceTask;
+
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata);
+
+/**
+ * \param pool: When not null, large sub-trees are balanced in parallel by pushing them as tasks
+ * into the pool. The sub-trees work on disjoint ranges of nodes, so they don't interfere.
+ */
+static uint kdtree_balance(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
 {
   KDTreeNode *node;
   float co;
@@ -188,13 +209,30 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
+  if (pool != NULL && median >= KD_BALANCE_TASK_NODES_MIN) {
+    KDTreeBalanceTask *task = MEM_mallocN(sizeof(*task), __func__);
+    task->nodes = nodes;
+    task->nodes_len = median;
+    task->axis = axis;
+    task->ofs = ofs;
+    task->r_root = &node->left;
+    BLI_task_pool_push(pool, kdtree_balance_task, task, true, NULL);
+  }
+  else {
+    node->left = kdtree_balance(pool, nodes, median, axis, ofs);
+  }
   node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+      pool, nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
 
   return median + ofs;
 }
 
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata)
+{
+  KDTreeBalanceTask *task = taskdata;
+  *task->r_root = kdtree_balance(pool, task->nodes, task->nodes_len, task->axis, task->ofs);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -204,7 +242,15 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len > KD_BALANCE_TASK_NODES_MIN) {
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    tree->root = kdtree_balance(pool, tree->nodes, tree->nodes_len, 0, 0);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+  else {
+    tree->root = kdtree_balance(NULL, tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifndef NDEBUG
   tree->is_balanced = true;
@@ -800,6 +846,133 @@ finally:
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Queries
+ *
+ * Run the same query for many points in parallel. The tree is only read, so the queries don't
+ * need any synchronization.
+ * \{ */
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeNearest *r_nearest;
+  uint nearest_len_capacity;
+  int *r_found;
+  float range;
+  bool (*search_cb)(
+      void *user_data, int query_index, int index, const float co[KD_DIMS], float dist_sq);
+  void *user_data;
+  int query_index;
+} KDTreeBatchData;
+
+static void kdtree_batch_settings(TaskParallelSettings *settings, const uint co_len)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = co_len > KD_BATCH_GRAIN_SIZE;
+  settings->min_iter_per_thread = KD_BATCH_GRAIN_SIZE;
+}
+
+static void kdtree_find_nearest_batch_fn(void *__restrict userdata,
+                                         const int iter,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  KDTreeNearest *nearest = &data->r_nearest[iter];
+  if (BLI_kdtree_nd_(find_nearest)(data->tree, data->co[iter], nearest) == -1) {
+    nearest->index = -1;
+  }
+}
+
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        KDTreeNearest *r_nearest)
+{
+  KDTreeBatchData data = {0};
+  data.tree = tree;
+  data.co = co;
+  data.r_nearest = r_nearest;
+
+  TaskParallelSettings settings;
+  kdtree_batch_settings(&settings, co_len);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_batch_fn, &settings);
+}
+
+static void kdtree_find_nearest_n_batch_fn(void *__restrict userdata,
+                                           const int iter,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  data->r_found[iter] = BLI_kdtree_nd_(find_nearest_n)(
+      data->tree,
+      data->co[iter],
+      &data->r_nearest[(size_t)iter * data->nearest_len_capacity],
+      data->nearest_len_capacity);
+}
+
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_found)
+{
+  KDTreeBatchData data = {0};
+  data.tree = tree;
+  data.co = co;
+  data.r_nearest = r_nearest;
+  data.nearest_len_capacity = nearest_len_capacity;
+  data.r_found = r_found;
+
+  TaskParallelSettings settings;
+  kdtree_batch_settings(&settings, co_len);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_n_batch_fn, &settings);
+}
+
+static bool kdtree_range_search_batch_cb(void *user_data,
+                                         const int index,
+                                         const float co[KD_DIMS],
+                                         const float dist_sq)
+{
+  const KDTreeBatchData *data = user_data;
+  return data->search_cb(data->user_data, data->query_index, index, co, dist_sq);
+}
+
+static void kdtree_range_search_batch_fn(void *__restrict userdata,
+                                         const int iter,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  /* Every query gets its own copy, to know the query index in the callback. */
+  KDTreeBatchData data = *(const KDTreeBatchData *)userdata;
+  data.query_index = iter;
+  BLI_kdtree_nd_(range_search_cb)(
+      data.tree, data.co[iter], data.range, kdtree_range_search_batch_cb, &data);
+}
+
+void BLI_kdtree_nd_(range_search_batch_cb)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    const uint co_len,
+    const float range,
+    bool (*search_cb)(
+        void *user_data, int query_index, int index, const float co[KD_DIMS], float dist_sq),
+    void *user_data)
+{
+  KDTreeBatchData data = {0};
+  data.tree = tree;
+  data.co = co;
+  data.range = range;
+  data.search_cb = search_cb;
+  data.user_data = user_data;
+
+  TaskParallelSettings settings;
+  kdtree_batch_settings(&settings, co_len);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_range_search_batch_fn, &settings);
+}
+
+/** \} */
+
 /**
  * Use when we want to loop over nodes ordered by index.
  * Requires indices to be aligned with nodes.
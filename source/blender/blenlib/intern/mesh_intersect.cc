@@ -14,6 +14,7 @@
 #  include <functional>
 #  include <iostream>
 #  include <memory>
+#  include <optional>
 
 #  include "BLI_allocator.hh"
 #  include "BLI_array.hh"
@@ -1140,22 +1141,21 @@ static int filter_plane_side(const double3 &p,
  * in the caller can avoid many allocations and frees of mpq3 and mpq_class structures.
  */
 static inline mpq3 tti_interp(
-    const mpq3 &a, const mpq3 &b, const mpq3 &c, const mpq3 &n, mpq3 &ab, mpq3 &ac, mpq3 &dotbuf)
+    const Vert *a, const Vert *b, const Vert *c, const mpq3 &n, mpq3 &ab, mpq3 &ac, mpq3 &dotbuf)
 {
-  ab = a;
-  ab -= b;
-  ac = a;
-  ac -= c;
+  ab = a->co_exact;
+  ab -= b->co_exact;
+  ac = a->co_exact;
+  ac -= c->co_exact;
   mpq_class den = math::dot_with_buffer(ab, n, dotbuf);
   BLI_assert(den != 0);
   mpq_class alpha = math::dot_with_buffer(ac, n, dotbuf) / den;
-  return a - alpha * ab;
+  return a->co_exact - alpha * ab;
 }
 
 /**
  * Return +1, 0, -1 as a + ad is above, on, or below the oriented plane containing a, b, c in CCW
  * order. This is the same as -oriented(a, b, c, a + ad), but uses fewer arithmetic operations.
- * TODO: change arguments to `const Vert *` and use floating filters.
  * The ba, ca, n, and dotbuf arguments are used as temporaries; declaring them
  * in the caller can avoid many allocations and frees of mpq3 and mpq_class structures.
  */
@@ -1180,6 +1180,80 @@ static inline int tti_above(const mpq3 &a,
   return sgn(math::dot_with_buffer(ad, n, dotbuf));
 }
 
+/**
+ * The index of #tti_above: the coordinates of the differences have index 2, the cross product
+ * coordinates have index 6 and the dot product of the cross product with `ad` has index 11.
+ */
+constexpr int index_tti_above = 11;
+
+/**
+ * Like #tti_above, but with double arithmetic and an error bound. The answer is 0 when the sign is
+ * not certain. `ad_supremum` is the supremum of the coordinates of `ad`.
+ */
+static inline int filter_tti_above(const double3 &a,
+                                   const double3 &b,
+                                   const double3 &c,
+                                   const double3 &ad,
+                                   const double3 &ad_supremum)
+{
+  const double3 n = math::cross(b - a, c - a);
+  const double d = math::dot(ad, n);
+  if (d == 0.0) {
+    return 0;
+  }
+  const double3 abs_a = math::abs(a);
+  const double3 ba_supremum = math::abs(b) + abs_a;
+  const double3 ca_supremum = math::abs(c) + abs_a;
+  const double3 n_supremum(ba_supremum.y * ca_supremum.z + ba_supremum.z * ca_supremum.y,
+                           ba_supremum.z * ca_supremum.x + ba_supremum.x * ca_supremum.z,
+                           ba_supremum.x * ca_supremum.y + ba_supremum.y * ca_supremum.x);
+  const double supremum = math::dot(ad_supremum, n_supremum);
+  const double err_bound = supremum * index_tti_above * DBL_EPSILON;
+  if (fabs(d) > err_bound) {
+    return d > 0 ? 1 : -1;
+  }
+  return 0;
+}
+
+/**
+ * The orientation tests of #itt_canon2, which all use `p2 - p1` as `ad`. They are decided with
+ * #filter_tti_above when possible, and `p2 - p1` is only computed exactly when that fails.
+ */
+class TTIAboveTester {
+ private:
+  const Vert *p1_;
+  const Vert *p2_;
+  double3 d_p1p2_;
+  double3 d_p1p2_supremum_;
+  std::optional<mpq3> p1p2_;
+
+ public:
+  mpq3 buf[4];
+
+  TTIAboveTester(const Vert *p1, const Vert *p2)
+      : p1_(p1),
+        p2_(p2),
+        d_p1p2_(p2->co - p1->co),
+        d_p1p2_supremum_(math::abs(p2->co) + math::abs(p1->co))
+  {
+  }
+
+  int operator()(const Vert *a, const Vert *b, const Vert *c)
+  {
+    const int filtered = filter_tti_above(a->co, b->co, c->co, d_p1p2_, d_p1p2_supremum_);
+    if (filtered != 0) {
+#  ifdef PERFDEBUG
+      incperfcount(5); /* Orientation tests decided by the filter. */
+#  endif
+      return filtered;
+    }
+    if (!p1p2_) {
+      p1p2_ = p2_->co_exact - p1_->co_exact;
+    }
+    return tti_above(a->co_exact, b->co_exact, c->co_exact, *p1p2_, buf[0], buf[1], buf[2], buf[3]);
+  }
+};
+
 /**
  * Given that triangles (p1, q1, r1) and (p2, q2, r2) are in canonical order,
  * use the classification chart in the Guigue and Devillers paper to find out
@@ -1193,12 +1267,12 @@ static inline int tti_above(const mpq3 &a,
  *   of the plane and at least one of q1 and r1 are off the plane.
  * Similarly for p2, q2, r2 with respect to the first triangle's plane.
  */
-static ITT_value itt_canon2(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon2(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2)
 {
@@ -1209,26 +1283,20 @@ static ITT_value itt_canon2(const mpq3 &p1,
     std::cout << "p2=" << p2 << " q2=" << q2 << " r2=" << r2 << "\n";
     std::cout << "n1=" << n1 << " n2=" << n2 << "\n";
     std::cout << "approximate values:\n";
-    std::cout << "p1=(" << p1[0].get_d() << "," << p1[1].get_d() << "," << p1[2].get_d() << ")\n";
-    std::cout << "q1=(" << q1[0].get_d() << "," << q1[1].get_d() << "," << q1[2].get_d() << ")\n";
-    std::cout << "r1=(" << r1[0].get_d() << "," << r1[1].get_d() << "," << r1[2].get_d() << ")\n";
-    std::cout << "p2=(" << p2[0].get_d() << "," << p2[1].get_d() << "," << p2[2].get_d() << ")\n";
-    std::cout << "q2=(" << q2[0].get_d() << "," << q2[1].get_d() << "," << q2[2].get_d() << ")\n";
-    std::cout << "r2=(" << r2[0].get_d() << "," << r2[1].get_d() << "," << r2[2].get_d() << ")\n";
     std::cout << "n1=(" << n1[0].get_d() << "," << n1[1].get_d() << "," << n1[2].get_d() << ")\n";
     std::cout << "n2=(" << n2[0].get_d() << "," << n2[1].get_d() << "," << n2[2].get_d() << ")\n";
   }
-  mpq3 p1p2 = p2 - p1;
+  TTIAboveTester tti_above_p1p2(p1, p2);
+  mpq3 *buf = tti_above_p1p2.buf;
   mpq3 intersect_1;
   mpq3 intersect_2;
-  mpq3 buf[4];
   bool no_overlap = false;
   /* Top test in classification tree. */
-  if (tti_above(p1, q1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+  if (tti_above_p1p2(p1, q1, r2) > 0) {
     /* Middle right test in classification tree. */
-    if (tti_above(p1, r1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) <= 0) {
+    if (tti_above_p1p2(p1, r1, r2) <= 0) {
       /* Bottom right test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+      if (tti_above_p1p2(p1, r1, q2) > 0) {
         /* Overlap is [k [i l] j]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i l] j]\n";
@@ -1257,7 +1325,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
   }
   else {
     /* Middle left test in classification tree. */
-    if (tti_above(p1, q1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) < 0) {
+    if (tti_above_p1p2(p1, q1, q2) < 0) {
       /* No overlap: [i j] [k l]. */
       if (dbg_level > 0) {
         std::cout << "no overlap: [i j] [k l]\n";
@@ -1266,7 +1334,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
     }
     else {
       /* Bottom left test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) >= 0) {
+      if (tti_above_p1p2(p1, r1, q2) >= 0) {
         /* Overlap is [k [i j] l]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i j] l]\n";
@@ -1303,12 +1371,12 @@ static ITT_value itt_canon2(const mpq3 &p1,
 
 /* Helper function for intersect_tri_tri. Arguments have been canonicalized for triangle 1. */
 
-static ITT_value itt_canon1(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon1(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2,
                             int sp2,
@@ -1510,49 +1578,49 @@ static ITT_value intersect_tri_tri(const IMesh &tm, int t1, int t2)
   ITT_value ans;
   if (sp1 > 0) {
     if (sq1 > 0) {
-      ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else if (sr1 > 0) {
-      ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
   }
   else if (sp1 < 0) {
     if (sq1 < 0) {
-      ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else if (sr1 < 0) {
-      ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
   }
   else {
     if (sq1 < 0) {
       if (sr1 >= 0) {
-        ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else if (sq1 > 0) {
       if (sr1 > 0) {
-        ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else {
       if (sr1 > 0) {
-        ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
       else if (sr1 < 0) {
-        ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
         if (dbg_level > 0) {
@@ -3176,6 +3244,10 @@ static void perfdata_init()
   perfdata->count.append(0);
   perfdata->count_name.append("final non-NONE intersects");
 
+  /* count 5. */
+  perfdata->count.append(0);
+  perfdata->count_name.append("tri tri orientation tests decided by filter");
+
   /* max 0. */
   perfdata->max.append(0);
   perfdata->max_name.append("total faces");
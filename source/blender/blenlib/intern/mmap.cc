@@ -0,0 +1,110 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <fcntl.h>
+#include <mutex>
+
+#include "BLI_fileops.h"
+#include "BLI_mmap.hh"
+
+#ifdef WIN32
+#  include "BLI_winstuff.h"
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace blender {
+
+/**
+ * Registering a mapping with the IO error handler modifies a global list, so opening and freeing
+ * have to be serialized.
+ */
+static std::mutex &mmap_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/** Keeps a #MappedFile alive as long as a range of it is used. */
+class MappedRangeSharingInfo : public ImplicitSharingInfo {
+ private:
+  const MappedFile *file_;
+
+ public:
+  MappedRangeSharingInfo(const MappedFile *file) : file_(file)
+  {
+    file_->add_user();
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    file_->remove_user_and_delete_if_last();
+    MEM_delete(this);
+  }
+};
+
+MappedFile::MappedFile(BLI_mmap_file *file) : file_(file)
+{
+  BLI_assert(file != nullptr);
+}
+
+MappedFile::~MappedFile()
+{
+  std::lock_guard lock{mmap_mutex()};
+  BLI_mmap_free(file_);
+}
+
+const MappedFile *MappedFile::open(const char *filepath)
+{
+  const int fd = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (fd == -1) {
+    return nullptr;
+  }
+  BLI_mmap_file *file;
+  {
+    std::lock_guard lock{mmap_mutex()};
+    file = BLI_mmap_open_copy_on_write(fd);
+  }
+  /* The mapping stays valid after the file is closed. */
+  close(fd);
+  if (file == nullptr) {
+    return nullptr;
+  }
+  return MEM_new<MappedFile>(__func__, file);
+}
+
+Span<std::byte> MappedFile::data() const
+{
+  return {static_cast<const std::byte *>(BLI_mmap_get_pointer(file_)),
+          int64_t(BLI_mmap_get_length(file_))};
+}
+
+bool MappedFile::has_io_error() const
+{
+  return BLI_mmap_any_io_error(file_);
+}
+
+std::optional<ImplicitSharingInfoAndData> MappedFile::share_range(
+    const IndexRange byte_range) const
+{
+  const Span<std::byte> data = this->data();
+  if (byte_range.is_empty() || byte_range.one_after_last() > data.size()) {
+    return std::nullopt;
+  }
+  const ImplicitSharingInfo *sharing_info = MEM_new<MappedRangeSharingInfo>(__func__, this);
+  return ImplicitSharingInfoAndData{sharing_info, data.data() + byte_range.start()};
+}
+
+void MappedFile::delete_self()
+{
+  MEM_delete(this);
+}
+
+}  // namespace blender
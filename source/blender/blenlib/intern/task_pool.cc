@@ -18,6 +18,7 @@
 
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -38,13 +39,20 @@ class Task {
   void *taskdata;
   bool free_taskdata;
   TaskFreeFunction freedata;
+  /** Tag of the code that pushed the task, for task tracing. */
+  const char *trace_tag;
 
   Task(TaskPool *pool,
        TaskRunFunction run,
        void *taskdata,
        bool free_taskdata,
        TaskFreeFunction freedata)
-      : pool(pool), run(run), taskdata(taskdata), free_taskdata(free_taskdata), freedata(freedata)
+      : pool(pool),
+        run(run),
+        taskdata(taskdata),
+        free_taskdata(free_taskdata),
+        freedata(freedata),
+        trace_tag(blender::threading::trace::current_tag())
   {
   }
 
@@ -69,7 +77,8 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        trace_tag(other.trace_tag)
   {
     other.pool = nullptr;
     other.run = nullptr;
@@ -89,7 +98,8 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        trace_tag(other.trace_tag)
   {
     ((Task &)other).pool = nullptr;
     ((Task &)other).run = nullptr;
@@ -168,6 +178,11 @@ struct TaskPool {
 /* Execute task. */
 void Task::operator()() const
 {
+  if (blender::threading::trace::is_enabled()) {
+    blender::threading::trace::detail::TaskScope scope("task_pool", trace_tag, 1, 1);
+    run(pool, taskdata);
+    return;
+  }
   run(pool, taskdata);
 }
 
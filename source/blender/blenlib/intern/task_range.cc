@@ -246,10 +246,10 @@ static void parallel_for_impl_accumulated_size_lookup(
       });
 }
 
-void parallel_for_impl(const IndexRange range,
-                       const int64_t grain_size,
-                       const FunctionRef<void(IndexRange)> function,
-                       const TaskSizeHints &size_hints)
+static void parallel_for_impl_dispatch(const IndexRange range,
+                                       const int64_t grain_size,
+                                       const FunctionRef<void(IndexRange)> function,
+                                       const TaskSizeHints &size_hints)
 {
 #ifdef WITH_TBB
   lazy_threading::send_hint();
@@ -286,6 +286,27 @@ void parallel_for_impl(const IndexRange range,
 #endif
 }
 
+void parallel_for_impl(const IndexRange range,
+                       const int64_t grain_size,
+                       const FunctionRef<void(IndexRange)> function,
+                       const TaskSizeHints &size_hints)
+{
+  if (!trace::is_enabled()) {
+    parallel_for_impl_dispatch(range, grain_size, function, size_hints);
+    return;
+  }
+  /* Attribute the tasks to the caller, also when they run on other threads. */
+  const char *tag = trace::current_tag();
+  parallel_for_impl_dispatch(
+      range,
+      grain_size,
+      [&](const IndexRange sub_range) {
+        trace::detail::TaskScope scope("parallel_for", tag, grain_size, sub_range.size());
+        function(sub_range);
+      },
+      size_hints);
+}
+
 void memory_bandwidth_bound_task_impl(const FunctionRef<void()> function)
 {
 #ifdef WITH_TBB
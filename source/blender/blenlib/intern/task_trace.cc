@@ -0,0 +1,182 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Recording of tasks for a timeline of the thread usage, see #blender::threading::trace.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include "BLI_fileops.h"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+namespace blender::threading::trace {
+
+struct TraceEvent {
+  const char *category;
+  const char *tag;
+  int64_t grain_size;
+  int64_t size;
+  /** Nanoseconds since the start of the recording. */
+  int64_t begin;
+  int64_t end;
+};
+
+/** Events recorded by one thread. The mutex is only contended while writing the trace. */
+struct ThreadEvents {
+  int thread_id;
+  std::mutex mutex;
+  Vector<TraceEvent> events;
+};
+
+static std::atomic<bool> trace_enabled = false;
+static std::chrono::steady_clock::time_point trace_start_time;
+
+static std::mutex threads_mutex;
+static Vector<std::unique_ptr<ThreadEvents>> threads_events;
+
+static thread_local const char *thread_tag = nullptr;
+static thread_local ThreadEvents *thread_events = nullptr;
+
+static int64_t trace_time_now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              trace_start_time)
+      .count();
+}
+
+static ThreadEvents &thread_events_get()
+{
+  if (thread_events == nullptr) {
+    std::lock_guard lock{threads_mutex};
+    std::unique_ptr<ThreadEvents> events = std::make_unique<ThreadEvents>();
+    events->thread_id = int(threads_events.size());
+    thread_events = events.get();
+    threads_events.append(std::move(events));
+  }
+  return *thread_events;
+}
+
+void start()
+{
+  std::lock_guard lock{threads_mutex};
+  for (std::unique_ptr<ThreadEvents> &events : threads_events) {
+    std::lock_guard events_lock{events->mutex};
+    events->events.clear();
+  }
+  trace_start_time = std::chrono::steady_clock::now();
+  trace_enabled.store(true, std::memory_order_release);
+}
+
+bool is_enabled()
+{
+  return trace_enabled.load(std::memory_order_relaxed);
+}
+
+/* Tags are expected to be identifiers, only escape what would break the JSON string. */
+static void write_json_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', file);
+    }
+    if (uchar(*c) >= 0x20) {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+bool stop_and_write(const char *filepath)
+{
+  trace_enabled.store(false, std::memory_order_release);
+
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  fputs("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n", file);
+  bool first = true;
+  std::lock_guard lock{threads_mutex};
+  for (std::unique_ptr<ThreadEvents> &events : threads_events) {
+    std::lock_guard events_lock{events->mutex};
+    for (const TraceEvent &event : events->events) {
+      fputs(first ? "" : ",\n", file);
+      first = false;
+      /* Chrome trace "complete" events, with times in microseconds. */
+      fputs("{\"name\": ", file);
+      write_json_string(file, event.tag ? event.tag : event.category);
+      fprintf(file,
+              ", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, \"ts\": %.3f, "
+              "\"dur\": %.3f, \"args\": {\"grain_size\": %lld, \"size\": %lld}}",
+              event.category,
+              events->thread_id,
+              double(event.begin) / 1000.0,
+              double(event.end - event.begin) / 1000.0,
+              (long long)event.grain_size,
+              (long long)event.size);
+    }
+    events->events.clear();
+  }
+  fputs("\n]}\n", file);
+
+  return fclose(file) == 0;
+}
+
+const char *current_tag()
+{
+  return thread_tag;
+}
+
+TraceTag::TraceTag(const char *name) : previous_(thread_tag)
+{
+  thread_tag = name;
+}
+
+TraceTag::~TraceTag()
+{
+  thread_tag = previous_;
+}
+
+namespace detail {
+
+TaskScope::TaskScope(const char *category,
+                     const char *tag,
+                     const int64_t grain_size,
+                     const int64_t size)
+    : category_(category),
+      tag_(tag),
+      previous_tag_(thread_tag),
+      grain_size_(grain_size),
+      size_(size),
+      begin_(trace_time_now())
+{
+  thread_tag = tag;
+}
+
+TaskScope::~TaskScope()
+{
+  thread_tag = previous_tag_;
+  const int64_t end = trace_time_now();
+  if (!is_enabled()) {
+    return;
+  }
+  ThreadEvents &events = thread_events_get();
+  std::lock_guard lock{events.mutex};
+  events.events.append({category_, tag_, grain_size_, size_, begin_, end});
+}
+
+}  // namespace detail
+
+}  // namespace blender::threading::trace
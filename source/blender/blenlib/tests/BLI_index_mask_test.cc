@@ -5,6 +5,7 @@
 #include "testing/testing.h"
 
 #include "BLI_array.hh"
+#include "BLI_bit_vector.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_rand.hh"
 #include "BLI_set.hh"
@@ -42,6 +43,38 @@ TEST(index_mask, FromBits)
   EXPECT_EQ(indices[4], 9);
 }
 
+TEST(index_mask, FromBitsFuzzy)
+{
+  RandomNumberGenerator rng;
+  const int64_t size = 100'000;
+  BitVector<> bits(size, false);
+  /* Sparse and dense regions, and a long run of set bits. */
+  for (const int64_t i : IndexRange(size)) {
+    const bool dense = (i / 10'000) % 2 == 1;
+    bits[i].set(rng.get_int32(dense ? 2 : 500) == 0);
+  }
+  MutableBitSpan(bits).slice(IndexRange(41'000, 20'000)).set_all();
+
+  IndexMaskMemory memory;
+  for (const IndexRange slice : {IndexRange(size), IndexRange(3, size - 10)}) {
+    const BitSpan bits_slice = BitSpan(bits).slice(slice);
+    const IndexMask mask = IndexMask::from_bits(bits_slice, memory);
+    const IndexMask expected = IndexMask::from_predicate(
+        bits_slice.index_range(), GrainSize(1024), memory, [&](const int64_t i) {
+          return bits_slice[i].test();
+        });
+    EXPECT_EQ(mask, expected);
+
+    /* Also use a universe that is not a range. */
+    const IndexMask universe = IndexMask::from_predicate(
+        bits_slice.index_range(), GrainSize(1024), memory, [](const int64_t i) {
+          return i % 3 != 0;
+        });
+    const IndexMask mask_in_universe = IndexMask::from_bits(universe, bits_slice, memory);
+    EXPECT_EQ(mask_in_universe, IndexMask::from_intersection(universe, expected, memory));
+  }
+}
+
 TEST(index_mask, FromSize)
 {
   {
@@ -134,3 +134,9 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+TEST(kdopbvh, FindNearest_20000)
+{
+  /* Large enough to compute the bounds of the top-level branches in parallel. */
+  find_nearest_points_test(20000, 1.0, 1000, 12);
+}
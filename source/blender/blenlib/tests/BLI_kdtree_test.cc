@@ -4,6 +4,9 @@
 
 #include "testing/testing.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
 #include "BLI_kdtree.h"
 
 #include <cmath>
@@ -63,3 +66,67 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, BatchQueriesLargeTree)
+{
+  /* Large enough to balance sub-trees in parallel. */
+  const int tree_size = 50000;
+  blender::Array<float> values(tree_size);
+  KDTree_1d *tree = BLI_kdtree_1d_new(tree_size);
+  for (int i = 0; i < tree_size; i++) {
+    values[i] = fmodf(i * 7.121f, 0.6037f); /* Co-prime. */
+    BLI_kdtree_1d_insert(tree, i, &values[i]);
+  }
+  BLI_kdtree_1d_balance(tree);
+
+  const int queries_num = 200;
+  const int n = 4;
+  blender::Array<float> query_values(queries_num);
+  for (int i = 0; i < queries_num; i++) {
+    query_values[i] = float(i) / queries_num;
+  }
+  const float(*queries)[1] = reinterpret_cast<const float(*)[1]>(query_values.data());
+
+  blender::Array<KDTreeNearest_1d> nearest(queries_num);
+  blender::Array<KDTreeNearest_1d> nearest_n(queries_num * n);
+  blender::Array<int> found(queries_num);
+  BLI_kdtree_1d_find_nearest_batch(tree, queries, queries_num, nearest.data());
+  BLI_kdtree_1d_find_nearest_n_batch(
+      tree, queries, queries_num, nearest_n.data(), n, found.data());
+
+  for (int i = 0; i < queries_num; i++) {
+    /* Compare with a brute force search to check the balanced tree. */
+    float min_dist = FLT_MAX;
+    for (int j = 0; j < tree_size; j++) {
+      min_dist = std::min(min_dist, fabsf(values[j] - queries[i][0]));
+    }
+    EXPECT_FLOAT_EQ(nearest[i].dist, min_dist);
+
+    KDTreeNearest_1d expected_n[n];
+    EXPECT_EQ(BLI_kdtree_1d_find_nearest_n(tree, queries[i], expected_n, n), found[i]);
+    for (int j = 0; j < found[i]; j++) {
+      EXPECT_EQ(expected_n[j].dist, nearest_n[i * n + j].dist);
+    }
+  }
+
+  /* Count the points within range of every query. The queries run in parallel, but each query
+   * only writes its own counter. */
+  blender::Array<int> counts(queries_num, 0);
+  BLI_kdtree_1d_range_search_batch_cb(
+      tree,
+      queries,
+      queries_num,
+      0.001f,
+      [](void *user_data, int query_index, int /*index*/, const float * /*co*/, float /*dist*/) {
+        static_cast<int *>(user_data)[query_index]++;
+        return true;
+      },
+      counts.data());
+  for (int i = 0; i < queries_num; i++) {
+    KDTreeNearest_1d *range_nearest = nullptr;
+    EXPECT_EQ(BLI_kdtree_1d_range_search(tree, queries[i], &range_nearest, 0.001f), counts[i]);
+    MEM_SAFE_FREE(range_nearest);
+  }
+
+  BLI_kdtree_1d_free(tree);
+}
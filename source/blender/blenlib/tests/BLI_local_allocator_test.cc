@@ -0,0 +1,70 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_local_allocator.hh"
+#include "BLI_task.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+static bool is_aligned(const void *ptr, const uintptr_t alignment)
+{
+  return (uintptr_t(ptr) & (alignment - 1)) == 0;
+}
+
+TEST(local_allocator, AllocationAlignment)
+{
+  LocalAllocator allocator;
+  EXPECT_TRUE(is_aligned(allocator.allocate(10, 4), 4));
+  EXPECT_TRUE(is_aligned(allocator.allocate(10, 16), 16));
+  EXPECT_TRUE(is_aligned(allocator.allocate(100, 64), 64));
+  EXPECT_TRUE(is_aligned(allocator.allocate(10000, 64), 64));
+  void *large = allocator.allocate(10 * 1024 * 1024, 64);
+  EXPECT_TRUE(is_aligned(large, 64));
+  allocator.deallocate(large, 10 * 1024 * 1024, 64);
+}
+
+TEST(local_allocator, ReuseFreedBuffers)
+{
+  LocalAllocator allocator;
+  MutableSpan<int> a = allocator.allocate_array<int>(100);
+  a.fill(1);
+  allocator.deallocate_array(a);
+  /* Same size class, so the buffer is reused. */
+  MutableSpan<int> b = allocator.allocate_array<int>(120);
+  EXPECT_EQ(a.data(), b.data());
+  MutableSpan<int> c = allocator.allocate_array<int>(120);
+  EXPECT_NE(b.data(), c.data());
+  allocator.deallocate_array(b);
+  allocator.deallocate_array(c);
+
+  /* Buffers beyond the largest size class are not kept. */
+  MutableSpan<char> large = allocator.allocate_array<char>(4 * 1024 * 1024);
+  large.fill(0);
+  allocator.deallocate_array(large);
+}
+
+TEST(local_allocator, ParallelFor)
+{
+  LocalAllocatorSet allocators;
+  Array<int> result(10000);
+  threading::parallel_for(result.index_range(), 100, [&](const IndexRange range) {
+    LocalAllocator &allocator = allocators.local();
+    MutableSpan<int> buffer = allocator.allocate_array<int>(range.size());
+    for (const int64_t i : range.index_range()) {
+      buffer[i] = int(range[i]) * 2;
+    }
+    result.as_mutable_span().slice(range).copy_from(buffer);
+    allocator.deallocate_array(buffer);
+  });
+  for (const int i : result.index_range()) {
+    EXPECT_EQ(result[i], i * 2);
+  }
+}
+
+}  // namespace blender::tests
@@ -711,6 +711,58 @@ TEST(map, Equality)
   EXPECT_NE(a, b);
 }
 
+TEST(map, GroupProbingHitsAllSlots)
+{
+  for (const uint64_t slots_num : {1, 8, 16, 64, 1024}) {
+    const uint64_t mask = slots_num - 1;
+    /* Number of probing steps until every slot has been visited. */
+    const int64_t steps = [&]() -> int64_t {
+      Set<uint64_t> hit;
+      int64_t steps = 0;
+      SLOT_PROBING_BEGIN (GroupProbingStrategy<>, 12345, mask, slot_index) {
+        hit.add(uint64_t(slot_index));
+        steps++;
+        if (uint64_t(hit.size()) == slots_num) {
+          return steps;
+        }
+      }
+      SLOT_PROBING_END();
+    }();
+    EXPECT_LE(steps, int64_t(std::max<uint64_t>(slots_num, 16)));
+  }
+}
+
+TEST(map, HashedSlotGroupProbing)
+{
+  Map<std::string,
+      int,
+      4,
+      GroupProbingStrategy<>,
+      DefaultHash<std::string>,
+      DefaultEquality<std::string>,
+      HashedMapSlot<std::string, int>>
+      map;
+  for (const int i : IndexRange(1000)) {
+    map.add_new("Name." + std::to_string(i), i);
+  }
+  EXPECT_EQ(map.size(), 1000);
+  for (const int i : IndexRange(1000)) {
+    EXPECT_EQ(map.lookup("Name." + std::to_string(i)), i);
+  }
+  EXPECT_FALSE(map.contains("Name.1000"));
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(map.remove("Name." + std::to_string(i)));
+  }
+  EXPECT_EQ(map.size(), 500);
+  EXPECT_FALSE(map.contains("Name.0"));
+  EXPECT_TRUE(map.contains("Name.1"));
+
+  auto copy = map;
+  EXPECT_EQ(copy.lookup("Name.999"), 999);
+  copy.clear();
+  EXPECT_EQ(map.lookup("Name.999"), 999);
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
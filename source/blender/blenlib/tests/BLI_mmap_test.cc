@@ -0,0 +1,70 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.hh"
+#include "BLI_mmap.hh"
+#include "BLI_path_util.h"
+#include "BLI_tempfile.h"
+
+namespace blender::tests {
+
+static std::string write_test_file(const Span<int> values)
+{
+  char temp_dir[FILE_MAX];
+  BLI_temp_directory_path_get(temp_dir, sizeof(temp_dir));
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), temp_dir, "mmap_test.bin");
+  blender::fstream stream(filepath, std::ios::out | std::ios::binary);
+  stream.write(reinterpret_cast<const char *>(values.data()), values.size_in_bytes());
+  stream.close();
+  return filepath;
+}
+
+TEST(mmap, ShareRange)
+{
+  Array<int> values(1000);
+  for (const int i : values.index_range()) {
+    values[i] = i * 3;
+  }
+  const std::string filepath = write_test_file(values);
+
+  const MappedFile *file = MappedFile::open(filepath.c_str());
+  ASSERT_NE(file, nullptr);
+  EXPECT_EQ(file->data().size(), values.as_span().size_in_bytes());
+  EXPECT_FALSE(file->has_io_error());
+
+  EXPECT_FALSE(file->share_array<int>(2, 10).has_value());
+  EXPECT_FALSE(file->share_array<int>(sizeof(int) * 990, 20).has_value());
+  std::optional<ImplicitSharingInfoAndData> shared = file->share_array<int>(sizeof(int) * 100,
+                                                                            50);
+  ASSERT_TRUE(shared.has_value());
+
+  /* The shared range keeps the file mapped. */
+  file->remove_user_and_delete_if_last();
+  const Span<int> shared_values(static_cast<const int *>(shared->data), 50);
+  EXPECT_EQ_ARRAY(shared_values.data(), values.as_span().slice(100, 50).data(), 50);
+
+  /* The only owner can modify the data without changing the file. */
+  EXPECT_TRUE(shared->sharing_info->is_mutable());
+  const_cast<int *>(shared_values.data())[0] = -1;
+  EXPECT_EQ(shared_values[0], -1);
+  shared->sharing_info->remove_user_and_delete_if_last();
+
+  const MappedFile *reopened = MappedFile::open(filepath.c_str());
+  ASSERT_NE(reopened, nullptr);
+  EXPECT_EQ(reinterpret_cast<const int *>(reopened->data().data())[100], 300);
+  reopened->remove_user_and_delete_if_last();
+
+  BLI_delete(filepath.c_str(), false, false);
+}
+
+TEST(mmap, OpenMissingFile)
+{
+  EXPECT_EQ(MappedFile::open("/this/file/does/not/exist.bin"), nullptr);
+}
+
+}  // namespace blender::tests
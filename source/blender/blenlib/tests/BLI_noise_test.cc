@@ -0,0 +1,60 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+#include "BLI_rand.hh"
+
+namespace blender::noise::tests {
+
+static Array<float3> random_positions(const int size, const float range)
+{
+  RandomNumberGenerator rng(0);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 2.0f * range -
+               float3(range);
+  }
+  return positions;
+}
+
+TEST(noise, PerlinSignedSpan)
+{
+  /* The size is not a multiple of four to test the remaining positions as well. */
+  const Array<float3> positions = random_positions(1001, 100.0f);
+  Array<float> values(positions.size());
+  perlin_signed(positions, values);
+  for (const int i : positions.index_range()) {
+    EXPECT_NEAR(values[i], perlin_signed(positions[i]), 1e-5f);
+  }
+}
+
+TEST(noise, PerlinSignedSpanLargeValues)
+{
+  const Array<float3> positions = random_positions(64, 2000000.0f);
+  Array<float> values(positions.size());
+  perlin_signed(positions, values);
+  for (const int i : positions.index_range()) {
+    EXPECT_NEAR(values[i], perlin_signed(positions[i]), 1e-5f);
+  }
+}
+
+TEST(noise, PerlinFbmSpan)
+{
+  const Array<float3> positions = random_positions(1001, 10.0f);
+  for (const float detail : {0.0f, 2.0f, 3.5f}) {
+    for (const bool normalize : {false, true}) {
+      Array<float> values(positions.size());
+      perlin_fbm(positions, detail, 0.5f, 2.0f, normalize, values);
+      for (const int i : positions.index_range()) {
+        const float expected = perlin_fbm<float3>(positions[i], detail, 0.5f, 2.0f, normalize);
+        EXPECT_NEAR(values[i], expected, 1e-5f);
+      }
+    }
+  }
+}
+
+}  // namespace blender::noise::tests
@@ -0,0 +1,70 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+TEST(sort, RadixSortSmall)
+{
+  Array<int> keys = {5, -3, 8, 0, -3, 100, 7};
+  parallel_radix_sort<int>(keys);
+  EXPECT_EQ_ARRAY(keys.data(), Span<int>({-3, -3, 0, 5, 7, 8, 100}).data(), keys.size());
+}
+
+TEST(sort, RadixSortFloat)
+{
+  const float inf = std::numeric_limits<float>::infinity();
+  Array<float> keys = {2.5f, -0.0f, -inf, 1.0f, -2.5f, inf, -1e-20f, 0.0f};
+  parallel_radix_sort<float>(keys);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  EXPECT_EQ(keys.first(), -inf);
+  EXPECT_EQ(keys.last(), inf);
+}
+
+TEST(sort, RadixSortStableWithValues)
+{
+  RandomNumberGenerator rng(42);
+  const int size = 100000;
+  Array<int64_t> keys(size);
+  Array<int> values(size);
+  Vector<std::pair<int64_t, int>> expected;
+  for (const int i : IndexRange(size)) {
+    /* Few distinct keys, so that stability matters. Some are negative and some need 64 bits. */
+    keys[i] = (int64_t(rng.get_int32(100)) - 50) << 33;
+    values[i] = i;
+    expected.append({keys[i], i});
+  }
+  std::stable_sort(expected.begin(), expected.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  parallel_radix_sort<int64_t, int>(keys, values);
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(keys[i], expected[i].first);
+    EXPECT_EQ(values[i], expected[i].second);
+  }
+}
+
+TEST(sort, RadixSortUnsigned)
+{
+  RandomNumberGenerator rng(7);
+  Array<uint32_t> keys(50000);
+  for (uint32_t &key : keys) {
+    key = uint32_t(rng.get_uint64());
+  }
+  Array<uint32_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  parallel_radix_sort<uint32_t>(keys);
+  EXPECT_EQ_ARRAY(keys.data(), expected.data(), keys.size());
+}
+
+}  // namespace blender::tests
@@ -5,6 +5,8 @@
 #include "testing/testing.h"
 #include <atomic>
 #include <cstring>
+#include <fstream>
+#include <sstream>
 
 #include "atomic_ops.h"
 
@@ -12,10 +14,13 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_path_util.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_tempfile.h"
 
 #define ITEMS_NUM 10000
 
@@ -245,3 +250,37 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, TraceParallelFor)
+{
+  using namespace blender;
+  char filepath[FILE_MAX];
+  BLI_temp_directory_path_get(filepath, sizeof(filepath));
+  BLI_path_append(filepath, sizeof(filepath), "blender_task_trace_test.json");
+
+  threading::trace::start();
+  EXPECT_TRUE(threading::trace::is_enabled());
+  std::atomic<int> counter = 0;
+  {
+    threading::trace::TraceTag tag("TraceTest");
+    EXPECT_STREQ(threading::trace::current_tag(), "TraceTest");
+    threading::parallel_for(IndexRange(ITEMS_NUM), 100, [&](const IndexRange range) {
+      EXPECT_STREQ(threading::trace::current_tag(), "TraceTest");
+      counter += int(range.size());
+    });
+  }
+  EXPECT_EQ(threading::trace::current_tag(), nullptr);
+  EXPECT_TRUE(threading::trace::stop_and_write(filepath));
+  EXPECT_FALSE(threading::trace::is_enabled());
+  EXPECT_EQ(counter, ITEMS_NUM);
+
+  std::ifstream file(filepath);
+  std::stringstream text;
+  text << file.rdbuf();
+  file.close();
+  BLI_delete(filepath, false, false);
+
+  EXPECT_EQ(text.str().rfind("{\"displayTimeUnit\"", 0), 0);
+  EXPECT_NE(text.str().find("\"name\": \"TraceTest\""), std::string::npos);
+  EXPECT_NE(text.str().find("\"grain_size\": 100"), std::string::npos);
+}
@@ -12,6 +12,7 @@
 #include "BLI_filereader.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_vector.hh"
 
 namespace blender {
 class ImplicitSharingInfo;
@@ -25,6 +26,11 @@ struct MemFileSharedStorage {
    * Maps the data pointer to the sharing info that it is owned by.
    */
   blender::Map<const void *, const blender::ImplicitSharingInfo *> map;
+  /**
+   * The keys of #map that were added while writing each ID, so that they can be kept when the
+   * ID is not written again in the next undo step.
+   */
+  blender::Map<uint, blender::Vector<const void *>> data_by_id_session_uid;
 
   ~MemFileSharedStorage();
 };
@@ -36,6 +42,12 @@ struct MemFileChunk {
   size_t size;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
+  /**
+   * When true, this chunk doesn't own the memory either, but the data has been found in a
+   * different chunk of the previous step (e.g. data of an ID that moved, or a duplicated ID).
+   * Unlike #is_identical, this says nothing about whether the ID changed.
+   */
+  bool is_buf_shared;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
@@ -43,8 +55,14 @@ struct MemFileChunk {
   /** Session UID of the ID being currently written (MAIN_ID_SESSION_UID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uid;
+  /** Hash of the content, used to find identical chunks at other positions. Only computed for
+   * chunks that are at least #MEMFILE_CHUNK_HASH_MIN_SIZE large, zero otherwise. */
+  uint64_t hash;
 };
 
+/** Smaller chunks are cheaper to copy than to look up by content. */
+#define MEMFILE_CHUNK_HASH_MIN_SIZE 512
+
 struct MemFile {
   ListBase chunks;
   size_t size;
@@ -64,6 +82,8 @@ struct MemFileWriteData {
 
   /** Maps an ID session uid to its first reference MemFileChunk, if existing. */
   blender::Map<uint, MemFileChunk *> id_session_uid_mapping;
+  /** Maps the content hash of reference chunks to one of the chunks with that hash. */
+  blender::Map<uint64_t, MemFileChunk *> hash_mapping;
 };
 
 struct MemFileUndoData {
@@ -90,6 +110,11 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add the chunks of the ID that is currently written from the reference memfile, instead of
+ * writing the ID again. The reference current chunk has to be the first chunk of that ID.
+ */
+void BLO_memfile_chunks_reuse_current_id(MemFileWriteData *mem_data);
 
 /* exports */
 
@@ -9,6 +9,7 @@
  * \brief external `writefile.cc` function prototypes.
  */
 
+struct BlendFileWriteBuffer;
 struct BlendThumbnail;
 struct Main;
 struct MemFile;
@@ -54,6 +55,27 @@ extern bool BLO_write_file(Main *mainvar,
                            const BlendFileWriteParams *params,
                            ReportList *reports);
 
+/**
+ * Serialize the file into memory without writing it to disk. This is the part of saving that
+ * needs to access #Main, the rest can be done later with #BLO_write_buffer_to_file, e.g. in a
+ * background thread while #Main is changed again.
+ *
+ * \return Null on failure, otherwise the buffer has to be freed with #BLO_write_buffer_free.
+ */
+BlendFileWriteBuffer *BLO_write_file_to_buffer(Main *mainvar,
+                                               const char *filepath,
+                                               int write_flags,
+                                               const BlendFileWriteParams *params,
+                                               ReportList *reports);
+/**
+ * Write the serialized file to disk, compressing it if requested by the write flags. Does not
+ * access #Main, so it can be called from any thread.
+ *
+ * \return Success.
+ */
+bool BLO_write_buffer_to_file(const BlendFileWriteBuffer *buffer, ReportList *reports);
+void BLO_write_buffer_free(BlendFileWriteBuffer *buffer);
+
 /**
  * \return Success.
  */
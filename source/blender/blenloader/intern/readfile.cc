@@ -14,6 +14,7 @@
 #include <cstdlib> /* for atoi. */
 #include <ctime>   /* for gmtime. */
 #include <fcntl.h> /* for open flags (O_BINARY, O_RDONLY). */
+#include <mutex>
 
 #include "BLI_utildefines.h"
 #ifndef WIN32
@@ -47,6 +48,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
@@ -63,6 +65,7 @@
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
 #include "BKE_asset.hh"
+#include "BKE_blender.hh"
 #include "BKE_blender_version.h"
 #include "BKE_collection.hh"
 #include "BKE_global.hh" /* for G */
@@ -915,6 +918,95 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   }
   return &new_bhead_data->bhead;
 }
+
+/**
+ * Create the list of all block headers from the index at the end of the file, see
+ * #BHeadIndexFooter. Blocks that are read on demand are not accessed at all, which avoids
+ * reading or decompressing most of the file for operations that only need a few data-blocks.
+ *
+ * \return False when the file has no valid index, the file is not changed then.
+ */
+static bool read_file_bhead_index(FileData *fd)
+{
+  /* The index contains the headers as they are stored, so it can only be used when they don't
+   * have to be converted. */
+  if (fd->file->seek == nullptr ||
+      (fd->flags & (FD_FLAGS_IS_MEMFILE | FD_FLAGS_SWITCH_ENDIAN | FD_FLAGS_POINTSIZE_DIFFERS)) ||
+      !BLI_listbase_is_empty(&fd->bhead_list))
+  {
+    return false;
+  }
+  const off64_t data_start = fd->file->offset;
+  BLI_assert(data_start == SIZEOFBLENDERHEADER);
+
+  BHeadIndexFooter footer;
+  const off64_t footer_offset = fd->file->seek(
+      fd->file, -off64_t(sizeof(BHeadIndexFooter)), SEEK_END);
+  if (footer_offset < data_start ||
+      fd->file->read(fd->file, &footer, sizeof(footer)) != sizeof(footer) ||
+      memcmp(footer.magic, BHEAD_INDEX_MAGIC, sizeof(footer.magic)) != 0 ||
+      footer.index_offset < uint64_t(data_start) || footer.index_offset > uint64_t(footer_offset) ||
+      footer.bheads_num == 0 || footer.bheads_num > uint64_t(footer_offset) / sizeof(BHead) ||
+      (uint64_t(footer_offset) - footer.index_offset) != footer.bheads_num * sizeof(BHead))
+  {
+    fd->file->seek(fd->file, data_start, SEEK_SET);
+    return false;
+  }
+
+  blender::Array<BHead> bheads(int64_t(footer.bheads_num), blender::NoInitialization());
+  const size_t index_size = sizeof(BHead) * size_t(footer.bheads_num);
+  bool is_valid = fd->file->seek(fd->file, off64_t(footer.index_offset), SEEK_SET) != -1 &&
+                  fd->file->read(fd->file, bheads.data(), index_size) == int64_t(index_size);
+
+  /* The blocks have to exactly fill the space before the index, ending with #BLO_CODE_ENDB. */
+  blender::Array<off64_t> data_offsets(bheads.size(), blender::NoInitialization());
+  off64_t offset = data_start;
+  for (const int64_t i : bheads.index_range()) {
+    if (!is_valid) {
+      break;
+    }
+    const BHead &bhead = bheads[i];
+    if (bhead.len < 0 || (bhead.code == BLO_CODE_ENDB) != (i == bheads.size() - 1)) {
+      is_valid = false;
+      break;
+    }
+    offset += off64_t(sizeof(BHead));
+    data_offsets[i] = offset;
+    offset += off64_t(bhead.len);
+  }
+  if (!is_valid || offset != off64_t(footer.index_offset)) {
+    fd->file->seek(fd->file, data_start, SEEK_SET);
+    return false;
+  }
+
+  for (const int64_t i : bheads.index_range()) {
+    const BHead &bhead = bheads[i];
+    const bool read_on_demand = BHEAD_USE_READ_ON_DEMAND(&bhead);
+    BHeadN *new_bhead = static_cast<BHeadN *>(
+        MEM_mallocN(sizeof(BHeadN) + (read_on_demand ? 0 : size_t(bhead.len)), "new_bhead"));
+    new_bhead->next = new_bhead->prev = nullptr;
+    new_bhead->file_offset = data_offsets[i];
+    new_bhead->has_data = !read_on_demand;
+    new_bhead->is_memchunk_identical = false;
+    new_bhead->bhead = bhead;
+    if (!read_on_demand && bhead.len > 0) {
+      if (fd->file->seek(fd->file, data_offsets[i], SEEK_SET) == -1 ||
+          fd->file->read(fd->file, new_bhead + 1, size_t(bhead.len)) != bhead.len)
+      {
+        MEM_freeN(new_bhead);
+        BLI_freelistN(&fd->bhead_list);
+        fd->file->seek(fd->file, data_start, SEEK_SET);
+        return false;
+      }
+    }
+    BLI_addtail(&fd->bhead_list, new_bhead);
+  }
+
+  /* All blocks are known already, the file is only read for their data from now on. */
+  fd->is_eof = true;
+  return true;
+}
+
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
@@ -1147,6 +1239,9 @@ static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
   decode_blender_header(fd);
 
   if (fd->flags & FD_FLAGS_FILE_OK) {
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    read_file_bhead_index(fd);
+#endif
     const char *error_message = nullptr;
     if (read_file_dna(fd, &error_message) == false) {
       BKE_reportf(
@@ -1262,6 +1357,177 @@ FileData *blo_filedata_from_file(const char *filepath, BlendFileReadReport *repo
   return nullptr;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Library Block Header Cache
+ *
+ * Library files are opened many times, e.g. for every link operation and for every file that
+ * uses them. Opening a file scans the headers of all its blocks, which is expensive for large
+ * files and particularly for compressed files, which are decompressed entirely by the scan. The
+ * headers of library files are kept in memory and reused when a file is opened again without
+ * having been modified. Only blocks that are read along with their header (data-block structs,
+ * DNA, etc.) keep their data, the data of other blocks is still read on demand.
+ * \{ */
+
+#ifdef USE_BHEAD_READ_ON_DEMAND
+
+/** Maximum memory used by the cached block headers of all files. */
+#  define LIBRARY_BHEAD_CACHE_MAX_SIZE (size_t(256) << 20)
+
+struct LibraryBHeadCache {
+  std::string filepath;
+  int64_t file_size;
+  int64_t file_mtime;
+  /** Copies of the #BHeadN of the file, in file order. */
+  blender::Vector<BHeadN *> bheads;
+  size_t mem_size;
+
+  ~LibraryBHeadCache()
+  {
+    for (BHeadN *bhead : bheads) {
+      MEM_freeN(bhead);
+    }
+  }
+};
+
+static std::mutex library_bhead_cache_mutex;
+/** Most recently used files first. */
+static blender::Vector<std::unique_ptr<LibraryBHeadCache>> library_bhead_cache;
+
+static void library_bhead_cache_free(void * /*user_data*/)
+{
+  std::lock_guard lock{library_bhead_cache_mutex};
+  library_bhead_cache.clear_and_shrink();
+}
+
+static bool library_bhead_cache_file_stat(const char *filepath,
+                                          int64_t *r_file_size,
+                                          int64_t *r_file_mtime)
+{
+  BLI_stat_t st;
+  if (BLI_stat(filepath, &st) == -1) {
+    return false;
+  }
+  *r_file_size = int64_t(st.st_size);
+  *r_file_mtime = int64_t(st.st_mtime);
+  return true;
+}
+
+/**
+ * Fill the block list of a newly opened file from the cache.
+ * \return False if the file is not cached or has been modified since.
+ */
+static bool library_bhead_cache_restore(FileData *fd, const char *filepath)
+{
+  int64_t file_size, file_mtime;
+  if (fd->file->seek == nullptr ||
+      !library_bhead_cache_file_stat(filepath, &file_size, &file_mtime))
+  {
+    return false;
+  }
+
+  std::lock_guard lock{library_bhead_cache_mutex};
+  int64_t index = -1;
+  for (const int64_t i : library_bhead_cache.index_range()) {
+    if (library_bhead_cache[i]->filepath == filepath) {
+      index = i;
+      break;
+    }
+  }
+  if (index == -1) {
+    return false;
+  }
+  if (library_bhead_cache[index]->file_size != file_size ||
+      library_bhead_cache[index]->file_mtime != file_mtime)
+  {
+    library_bhead_cache.remove(index);
+    return false;
+  }
+
+  std::unique_ptr<LibraryBHeadCache> cache = std::move(library_bhead_cache[index]);
+  library_bhead_cache.remove(index);
+  for (const BHeadN *cached_bhead : cache->bheads) {
+    BHeadN *new_bhead = static_cast<BHeadN *>(MEM_dupallocN(cached_bhead));
+    new_bhead->next = new_bhead->prev = nullptr;
+    BLI_addtail(&fd->bhead_list, new_bhead);
+  }
+  /* All blocks are known already, the file is only read for their data from now on. */
+  fd->is_eof = true;
+  library_bhead_cache.insert(0, std::move(cache));
+  return true;
+}
+
+/** Remember the block headers of a file that were not restored from the cache. */
+static void library_bhead_cache_add(FileData *fd, const char *filepath)
+{
+  /* Files that are not seekable store the data of all blocks with their headers, and the data
+   * of files with a different endianness is switched in place when it is read. */
+  if (fd->file->seek == nullptr || (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return;
+  }
+  std::unique_ptr<LibraryBHeadCache> cache = std::make_unique<LibraryBHeadCache>();
+  if (!library_bhead_cache_file_stat(filepath, &cache->file_size, &cache->file_mtime)) {
+    return;
+  }
+  cache->filepath = filepath;
+  cache->mem_size = 0;
+
+  /* Scan the remaining blocks, usually only #ENDB is left after reading the DNA. */
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+  }
+  LISTBASE_FOREACH (const BHeadN *, bhead, &fd->bhead_list) {
+    BHeadN *cached_bhead = static_cast<BHeadN *>(MEM_dupallocN(bhead));
+    cache->mem_size += MEM_allocN_len(cached_bhead);
+    cache->bheads.append(cached_bhead);
+  }
+
+  std::lock_guard lock{library_bhead_cache_mutex};
+  if (library_bhead_cache.is_empty()) {
+    static bool atexit_registered = false;
+    if (!atexit_registered) {
+      BKE_blender_atexit_register(library_bhead_cache_free, nullptr);
+      atexit_registered = true;
+    }
+  }
+  library_bhead_cache.remove_if([&](const std::unique_ptr<LibraryBHeadCache> &other) {
+    return other->filepath == filepath;
+  });
+  library_bhead_cache.insert(0, std::move(cache));
+
+  /* Evict the least recently used files, but always keep the newest one. */
+  size_t mem_size = 0;
+  for (const int64_t i : library_bhead_cache.index_range()) {
+    mem_size += library_bhead_cache[i]->mem_size;
+    if (i > 0 && mem_size > LIBRARY_BHEAD_CACHE_MAX_SIZE) {
+      library_bhead_cache.resize(i);
+      break;
+    }
+  }
+}
+
+#endif /* USE_BHEAD_READ_ON_DEMAND */
+
+FileData *blo_filedata_from_library_file(const char *filepath, BlendFileReadReport *reports)
+{
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  FileData *fd = blo_filedata_from_file_open(filepath, reports);
+  if (fd == nullptr) {
+    return nullptr;
+  }
+  STRNCPY(fd->relabase, filepath);
+
+  const bool is_cached = library_bhead_cache_restore(fd, filepath);
+  fd = blo_decode_and_check(fd, reports->reports);
+  if (fd != nullptr && !is_cached) {
+    library_bhead_cache_add(fd, filepath);
+  }
+  return fd;
+#else
+  return blo_filedata_from_file(filepath, reports);
+#endif
+}
+
+/** \} */
+
 /**
  * Same as blo_filedata_from_file(), but does not reads DNA data, only header.
  * Use it for light access (e.g. thumbnail reading).
@@ -4554,7 +4820,7 @@ static FileData *read_library_file_data(FileData *basefd,
                      mainptr->curlib->runtime.filepath_abs,
                      mainptr->curlib->filepath,
                      library_parent_filepath(mainptr->curlib));
-    fd = blo_filedata_from_file(mainptr->curlib->runtime.filepath_abs, basefd->reports);
+    fd = blo_filedata_from_library_file(mainptr->curlib->runtime.filepath_abs, basefd->reports);
   }
 
   if (fd) {
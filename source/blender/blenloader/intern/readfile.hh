@@ -142,6 +142,22 @@ struct FileData {
 
 #define SIZEOFBLENDERHEADER 12
 
+/**
+ * Regular files have an index after the #BLO_CODE_ENDB block: a copy of the headers of all
+ * blocks in file order, followed by this footer at the very end of the (uncompressed) file. It
+ * allows opening a file without reading through all of its blocks. Older versions stop reading
+ * at #BLO_CODE_ENDB and ignore it.
+ */
+struct BHeadIndexFooter {
+  /** Offset of the first header of the index. */
+  uint64_t index_offset;
+  uint64_t bheads_num;
+  /** #BHEAD_INDEX_MAGIC, without null terminator. */
+  char magic[8];
+};
+
+#define BHEAD_INDEX_MAGIC "BHINDEX1"
+
 /***/
 void blo_join_main(ListBase *mainlist);
 void blo_split_main(ListBase *mainlist, Main *main);
@@ -154,6 +170,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath) ATTR_N
  * cannot be called with relative paths anymore!
  */
 FileData *blo_filedata_from_file(const char *filepath, BlendFileReadReport *reports);
+/**
+ * Same as #blo_filedata_from_file, but the block headers are cached in memory and reused when
+ * the same file is opened again without having been modified. Meant for library files, which are
+ * opened many times for linking.
+ */
+FileData *blo_filedata_from_library_file(const char *filepath, BlendFileReadReport *reports);
 FileData *blo_filedata_from_memory(const void *mem, int memsize, BlendFileReadReport *reports);
 FileData *blo_filedata_from_memfile(MemFile *memfile,
                                     const BlendFileReadParams *params,
@@ -13,6 +13,8 @@
 #include <cstring>
 #include <fcntl.h>
 
+#include <xxhash.h>
+
 /* open/close */
 #ifndef _WIN32
 #  include <unistd.h>
@@ -38,10 +40,15 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+static bool memfile_chunk_owns_buf(const MemFileChunk *chunk)
+{
+  return !chunk->is_identical && !chunk->is_buf_shared;
+}
+
 void BLO_memfile_free(MemFile *memfile)
 {
   while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (memfile_chunk_owns_buf(chunk)) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -67,7 +74,7 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
 
   /* First, detect all memchunks in second memfile that are not owned by it. */
   LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
-    if (sc->is_identical) {
+    if (!memfile_chunk_owns_buf(sc)) {
       buffer_to_second_memchunk.add(sc->buf, sc);
     }
   }
@@ -75,10 +82,11 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
    * it is also used by the second memfile, transfer the ownership. */
   LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
-    if (!fc->is_identical) {
+    if (memfile_chunk_owns_buf(fc)) {
       if (MemFileChunk *sc = buffer_to_second_memchunk.lookup_default(fc->buf, nullptr)) {
-        BLI_assert(sc->is_identical);
+        BLI_assert(!memfile_chunk_owns_buf(sc));
         sc->is_identical = false;
+        sc->is_buf_shared = false;
         fc->is_identical = true;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
@@ -119,6 +127,9 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
         current_session_uid = mem_chunk->id_session_uid;
         mem_data->id_session_uid_mapping.add_new(current_session_uid, mem_chunk);
       }
+      if (mem_chunk->size >= MEMFILE_CHUNK_HASH_MIN_SIZE) {
+        mem_data->hash_mapping.add(mem_chunk->hash, mem_chunk);
+      }
     }
   }
 }
@@ -126,6 +137,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
 {
   mem_data->id_session_uid_mapping.clear_and_shrink();
+  mem_data->hash_mapping.clear_and_shrink();
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -138,6 +150,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = nullptr;
   curchunk->is_identical = false;
+  curchunk->is_buf_shared = false;
+  curchunk->hash = 0;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -151,6 +165,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->hash = compchunk->hash;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
       }
@@ -158,6 +173,22 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
+  /* The data may still exist elsewhere in the previous step, e.g. when IDs were reordered, when
+   * an ID was duplicated, or for unchanged arrays of an ID whose other data changed size. Only the
+   * buffer is shared then, the chunk is not considered identical for the detection of unchanged
+   * IDs. */
+  if (curchunk->buf == nullptr && size >= MEMFILE_CHUNK_HASH_MIN_SIZE) {
+    curchunk->hash = XXH3_64bits(buf, size);
+    if (const MemFileChunk *hashchunk = mem_data->hash_mapping.lookup_default(curchunk->hash,
+                                                                              nullptr))
+    {
+      if (hashchunk->size == size && memcmp(hashchunk->buf, buf, size) == 0) {
+        curchunk->buf = hashchunk->buf;
+        curchunk->is_buf_shared = true;
+      }
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == nullptr) {
     char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
@@ -167,6 +198,55 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+void BLO_memfile_chunks_reuse_current_id(MemFileWriteData *mem_data)
+{
+  MemFile *memfile = mem_data->written_memfile;
+  const uint id_session_uid = mem_data->current_id_session_uid;
+  BLI_assert(id_session_uid != MAIN_ID_SESSION_UID_UNSET);
+
+  MemFileChunk *compchunk = mem_data->reference_current_chunk;
+  while (compchunk != nullptr && compchunk->id_session_uid == id_session_uid) {
+    MemFileChunk *curchunk = static_cast<MemFileChunk *>(
+        MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
+    curchunk->buf = compchunk->buf;
+    curchunk->size = compchunk->size;
+    curchunk->is_identical = true;
+    curchunk->is_buf_shared = false;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uid = id_session_uid;
+    curchunk->hash = compchunk->hash;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+    compchunk = static_cast<MemFileChunk *>(compchunk->next);
+  }
+  mem_data->reference_current_chunk = compchunk;
+
+  /* Data that was shared with the previous step instead of being written has to stay available
+   * to the new step too. */
+  const MemFileSharedStorage *reference_storage = mem_data->reference_memfile->shared_storage;
+  if (reference_storage == nullptr) {
+    return;
+  }
+  const blender::Vector<const void *> *shared_data =
+      reference_storage->data_by_id_session_uid.lookup_ptr(id_session_uid);
+  if (shared_data == nullptr) {
+    return;
+  }
+  if (memfile->shared_storage == nullptr) {
+    memfile->shared_storage = MEM_new<MemFileSharedStorage>(__func__);
+  }
+  blender::Vector<const void *> &new_shared_data =
+      memfile->shared_storage->data_by_id_session_uid.lookup_or_add_default(id_session_uid);
+  for (const void *data : *shared_data) {
+    const blender::ImplicitSharingInfo *sharing_info = reference_storage->map.lookup(data);
+    if (memfile->shared_storage->map.add(data, sharing_info)) {
+      sharing_info->add_user();
+      new_shared_data.append(data);
+    }
+  }
+}
+
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
 {
   Main *bmain_undo = nullptr;
@@ -58,6 +58,7 @@
  *   - #BLENDER_USERPREF_FILE (on UNIX `~/.config/blender/X.X/config/userpref.blend`).
  */
 
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cmath>
@@ -87,6 +88,7 @@
 #include "DNA_key_types.h"
 #include "DNA_sdna_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -97,6 +99,8 @@
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
@@ -141,7 +145,13 @@
 #define ZSTD_BUFFER_SIZE (1 << 21) /* 2mb */
 #define ZSTD_CHUNK_SIZE (1 << 20)  /* 1mb */
 
+/**
+ * Compression level used when the storage is fast enough to keep up with the compression. Slower
+ * storage (e.g. network drives) makes the writing adapt the level up to the maximum, because
+ * compressing more saves time when writing the data is the bottleneck.
+ */
 #define ZSTD_COMPRESSION_LEVEL 3
+#define ZSTD_COMPRESSION_LEVEL_MAX 9
 
 static CLG_LogRef LOG = {"blo.writefile"};
 
@@ -164,6 +174,16 @@ class WriteWrap {
   virtual bool open(const char *filepath) = 0;
   virtual bool close() = 0;
   virtual bool write(const void *buf, size_t buf_len) = 0;
+  /**
+   * Same as #write, but the data is implicitly shared and stays valid as long as the wrapper
+   * holds a user of it. This allows keeping a reference instead of copying the data.
+   */
+  virtual bool write_shared(const void *buf,
+                            size_t buf_len,
+                            const blender::ImplicitSharingInfo & /*sharing_info*/)
+  {
+    return this->write(buf, buf_len);
+  }
 
   /** Buffer output (we only want when output isn't already buffered). */
   bool use_buf = true;
@@ -210,9 +230,17 @@ class ZstdWriteWrap : public WriteWrap {
   ThreadCondition condition = {};
   int next_frame = 0;
   int num_frames = 0;
+  int num_threads = 1;
 
   ListBase frames = {};
 
+  /** Level used for the next frames, see #adapt_compression_level. */
+  std::atomic<int> compression_level = ZSTD_COMPRESSION_LEVEL;
+  /** Moving averages of the time it takes to compress and to write a frame. Accessed with
+   * #mutex locked. */
+  double compress_seconds_avg = 0.0;
+  double write_seconds_avg = 0.0;
+
   bool write_error = false;
 
  public:
@@ -221,18 +249,27 @@ class ZstdWriteWrap : public WriteWrap {
   bool open(const char *filepath) override;
   bool close() override;
   bool write(const void *buf, size_t buf_len) override;
+  bool write_shared(const void *buf,
+                    size_t buf_len,
+                    const blender::ImplicitSharingInfo &sharing_info) override;
 
  private:
   struct ZstdWriteBlockTask;
+  void add_task(const void *data,
+                size_t size,
+                const blender::ImplicitSharingInfo *sharing_info);
   void write_task(ZstdWriteBlockTask *task);
+  void adapt_compression_level(double compress_seconds, double write_seconds);
   void write_u32_le(uint32_t val);
   void write_seekable_frames();
 };
 
 struct ZstdWriteWrap::ZstdWriteBlockTask {
   ZstdWriteBlockTask *next, *prev;
-  void *data;
+  const void *data;
   size_t size;
+  /** Keeps #data alive when it is referenced instead of copied, otherwise it's owned. */
+  const blender::ImplicitSharingInfo *sharing_info;
   int frame_number;
   ZstdWriteWrap *ww;
 
@@ -248,10 +285,20 @@ void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
 {
   size_t out_buf_len = ZSTD_compressBound(task->size);
   void *out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
-  size_t out_size = ZSTD_compress(
-      out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  const double compress_start = BLI_time_now_seconds();
+  size_t out_size = ZSTD_compress(out_buf,
+                                  out_buf_len,
+                                  task->data,
+                                  task->size,
+                                  compression_level.load(std::memory_order_relaxed));
+  const double compress_seconds = BLI_time_now_seconds() - compress_start;
 
-  MEM_freeN(task->data);
+  if (task->sharing_info) {
+    task->sharing_info->remove_user_and_delete_if_last();
+  }
+  else {
+    MEM_freeN(const_cast<void *>(task->data));
+  }
 
   BLI_mutex_lock(&mutex);
 
@@ -263,7 +310,10 @@ void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
     write_error = true;
   }
   else {
-    if (base_wrap.write(out_buf, out_size)) {
+    const double write_start = BLI_time_now_seconds();
+    const bool write_ok = base_wrap.write(out_buf, out_size);
+    this->adapt_compression_level(compress_seconds, BLI_time_now_seconds() - write_start);
+    if (write_ok) {
       ZstdFrame *frameinfo = static_cast<ZstdFrame *>(
           MEM_mallocN(sizeof(ZstdFrame), "zstd frameinfo"));
       frameinfo->uncompressed_size = task->size;
@@ -283,6 +333,36 @@ void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
   MEM_freeN(out_buf);
 }
 
+/**
+ * Frames are compressed in parallel but written one after another. When writing a frame takes
+ * longer than the compression of the following frames, the workers wait for the storage and a
+ * higher compression level makes the save faster, because less data has to be written. Once the
+ * compression becomes the bottleneck, the level is lowered again.
+ */
+void ZstdWriteWrap::adapt_compression_level(const double compress_seconds,
+                                            const double write_seconds)
+{
+  /* Smooth over a few frames, because single writes can be slow due to caching. */
+  const double factor = 0.25;
+  compress_seconds_avg += (compress_seconds - compress_seconds_avg) * factor;
+  write_seconds_avg += (write_seconds - write_seconds_avg) * factor;
+
+  const double compress_seconds_per_thread = compress_seconds_avg / num_threads;
+  const int level = compression_level.load(std::memory_order_relaxed);
+  if (write_seconds_avg > compress_seconds_per_thread * 1.5 && level < ZSTD_COMPRESSION_LEVEL_MAX)
+  {
+    compression_level.store(level + 1, std::memory_order_relaxed);
+    /* Compressing at the new level takes longer, don't raise it again before it's measured. */
+    compress_seconds_avg *= 1.5;
+  }
+  else if (write_seconds_avg < compress_seconds_per_thread * 0.5 &&
+           level > ZSTD_COMPRESSION_LEVEL)
+  {
+    compression_level.store(level - 1, std::memory_order_relaxed);
+    compress_seconds_avg /= 1.5;
+  }
+}
+
 bool ZstdWriteWrap::open(const char *filepath)
 {
   if (!base_wrap.open(filepath)) {
@@ -290,7 +370,7 @@ bool ZstdWriteWrap::open(const char *filepath)
   }
 
   /* Leave one thread open for the main writing logic, unless we only have one HW thread. */
-  int num_threads = max_ii(1, BLI_system_thread_count() - 1);
+  num_threads = max_ii(1, BLI_system_thread_count() - 1);
   BLI_threadpool_init(&threadpool, ZstdWriteBlockTask::write_task, num_threads);
   BLI_mutex_init(&mutex);
   BLI_condition_init(&condition);
@@ -359,11 +439,35 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
     return false;
   }
 
+  void *data = MEM_mallocN(buf_len, __func__);
+  memcpy(data, buf, buf_len);
+  this->add_task(data, buf_len, nullptr);
+  return true;
+}
+
+bool ZstdWriteWrap::write_shared(const void *buf,
+                                 size_t buf_len,
+                                 const blender::ImplicitSharingInfo &sharing_info)
+{
+  if (write_error) {
+    return false;
+  }
+
+  /* The frame is compressed straight from the shared data. */
+  sharing_info.add_user();
+  this->add_task(buf, buf_len, &sharing_info);
+  return true;
+}
+
+void ZstdWriteWrap::add_task(const void *data,
+                             const size_t size,
+                             const blender::ImplicitSharingInfo *sharing_info)
+{
   ZstdWriteBlockTask *task = static_cast<ZstdWriteBlockTask *>(
       MEM_mallocN(sizeof(ZstdWriteBlockTask), __func__));
-  task->data = MEM_mallocN(buf_len, __func__);
-  memcpy(task->data, buf, buf_len);
-  task->size = buf_len;
+  task->data = data;
+  task->size = size;
+  task->sharing_info = sharing_info;
   task->frame_number = num_frames++;
   task->ww = this;
 
@@ -386,10 +490,31 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
     MEM_freeN(first_task);
   }
   BLI_threadpool_insert(&threadpool, task);
-
-  return true;
 }
 
+/**
+ * Keeps the written data in memory, so that it can be written to the file later, see
+ * #BLO_write_file_to_buffer.
+ */
+class MemoryWriteWrap : public WriteWrap {
+ public:
+  blender::Vector<blender::Array<uchar>> chunks;
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, size_t buf_len) override
+  {
+    chunks.append(blender::Span<uchar>(static_cast<const uchar *>(buf), int64_t(buf_len)));
+    return true;
+  }
+};
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -430,6 +555,19 @@ struct WriteData {
    * Will be nullptr for UNDO.
    */
   WriteWrap *ww;
+
+  /**
+   * Implicitly shared data that is currently written by #BLO_write_shared when not writing undo
+   * data. Large writes from it are passed to #WriteWrap::write_shared without being copied.
+   */
+  struct {
+    const char *data;
+    size_t size;
+    const blender::ImplicitSharingInfo *sharing_info;
+  } shared;
+
+  /** Headers of all written blocks, for the index at the end of regular files. */
+  blender::Vector<BHead> bheads;
 };
 
 struct BlendWriter {
@@ -459,7 +597,10 @@ static WriteData *writedata_new(WriteWrap *ww)
   return wd;
 }
 
-static void writedata_do_write(WriteData *wd, const void *mem, size_t memlen)
+static void writedata_do_write(WriteData *wd,
+                               const void *mem,
+                               size_t memlen,
+                               const blender::ImplicitSharingInfo *sharing_info = nullptr)
 {
   if ((wd == nullptr) || wd->error || (mem == nullptr) || memlen < 1) {
     return;
@@ -479,7 +620,9 @@ static void writedata_do_write(WriteData *wd, const void *mem, size_t memlen)
     BLO_memfile_chunk_add(&wd->mem, static_cast<const char *>(mem), memlen);
   }
   else {
-    if (!wd->ww->write(mem, memlen)) {
+    const bool write_ok = sharing_info ? wd->ww->write_shared(mem, memlen, *sharing_info) :
+                                         wd->ww->write(mem, memlen);
+    if (!write_ok) {
       wd->error = true;
     }
   }
@@ -545,7 +688,11 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
 
       do {
         size_t writelen = std::min(len, wd->buffer.chunk_size);
-        writedata_do_write(wd, adr, writelen);
+        /* The padding of the last piece may be outside of the shared data. */
+        const char *piece = static_cast<const char *>(adr);
+        const bool is_shared = wd->shared.sharing_info != nullptr && piece >= wd->shared.data &&
+                               piece + writelen <= wd->shared.data + wd->shared.size;
+        writedata_do_write(wd, adr, writelen, is_shared ? wd->shared.sharing_info : nullptr);
         adr = (const char *)adr + writelen;
         len -= writelen;
       } while (len > 0);
@@ -565,6 +712,35 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
   }
 }
 
+/** Write the header of a block, its data has to be written right after it. */
+static void mywrite_bhead(WriteData *wd, const BHead &bhead)
+{
+  if (!wd->use_memfile) {
+    wd->bheads.append(bhead);
+  }
+  mywrite(wd, &bhead, sizeof(BHead));
+}
+
+/**
+ * Write the index of all blocks after the #BLO_CODE_ENDB block, see #BHeadIndexFooter.
+ */
+static void mywrite_bhead_index(WriteData *wd)
+{
+  if (wd->use_memfile || wd->bheads.is_empty()) {
+    return;
+  }
+  BHeadIndexFooter footer;
+  footer.index_offset = SIZEOFBLENDERHEADER;
+  for (const BHead &bhead : wd->bheads) {
+    footer.index_offset += sizeof(BHead) + uint64_t(bhead.len);
+  }
+  footer.bheads_num = uint64_t(wd->bheads.size());
+  memcpy(footer.magic, BHEAD_INDEX_MAGIC, sizeof(footer.magic));
+
+  mywrite(wd, wd->bheads.data(), sizeof(BHead) * size_t(wd->bheads.size()));
+  mywrite(wd, &footer, sizeof(footer));
+}
+
 /**
  * BeGiN initializer for mywrite
  * \param ww: File write wrapper.
@@ -654,6 +830,67 @@ static void mywrite_id_end(WriteData *wd, ID * /*id*/)
   }
 }
 
+/**
+ * Check whether an ID can keep the memory chunks of the previous undo step instead of being
+ * written again, see #BLO_memfile_chunks_reuse_current_id. Must be called after
+ * #mywrite_id_begin, with the shallow copy of the ID that would be written.
+ *
+ * Changes to IDs are expected to be tagged for the depsgraph, which accumulates them in
+ * `recalc_after_undo_push`. At this point #id_buffer_init_from_id already moved those tags into
+ * `recalc_up_to_undo_push` of the ID and its shallow copy, so that is what is checked. Types that
+ * are not evaluated by the depsgraph (UI, brushes, ...) are not always tagged when they change, so
+ * they are always written. As a cheap safety net against untagged changes, the ID header also has
+ * to match the one stored in the previous step. This also makes sure that the stored
+ * `recalc_up_to_undo_push` is still valid.
+ */
+static bool mywrite_id_is_unchanged(WriteData *wd,
+                                    const Main *bmain,
+                                    ID *id,
+                                    const ID *temp_id)
+{
+  if (!wd->use_memfile || wd->mem.reference_memfile == nullptr ||
+      !bmain->is_memfile_undo_id_skip_allowed)
+  {
+    return false;
+  }
+  if (!ID_TYPE_USE_COPY_ON_EVAL(GS(id->name)) || temp_id->recalc_up_to_undo_push != 0) {
+    return false;
+  }
+  /* Embedded IDs are written as part of their owner, but are tagged separately. */
+  if (const bNodeTree *nodetree = blender::bke::ntreeFromID(id)) {
+    if (nodetree->id.recalc_after_undo_push != 0) {
+      return false;
+    }
+  }
+  if (GS(id->name) == ID_SCE) {
+    const Scene *scene = reinterpret_cast<const Scene *>(id);
+    if (scene->master_collection != nullptr &&
+        scene->master_collection->id.recalc_after_undo_push != 0)
+    {
+      return false;
+    }
+  }
+
+  /* The reference chunk has to start with the ID struct itself. */
+  const MemFileChunk *chunk = wd->mem.reference_current_chunk;
+  if (chunk == nullptr || chunk->id_session_uid != id->session_uid ||
+      chunk->size < sizeof(BHead) + sizeof(ID))
+  {
+    return false;
+  }
+  if (chunk->prev != nullptr &&
+      static_cast<const MemFileChunk *>(chunk->prev)->id_session_uid == id->session_uid)
+  {
+    return false;
+  }
+  BHead bhead;
+  memcpy(&bhead, chunk->buf, sizeof(BHead));
+  if (bhead.code != GS(id->name) || bhead.old != id || bhead.nr != 1) {
+    return false;
+  }
+  return memcmp(chunk->buf + sizeof(BHead), temp_id, sizeof(ID)) == 0;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -685,7 +922,7 @@ static void writestruct_at_address_nr(
     return;
   }
 
-  mywrite(wd, &bh, sizeof(BHead));
+  mywrite_bhead(wd, bh);
   mywrite(wd, data, size_t(bh.len));
 }
 
@@ -721,7 +958,7 @@ static void writedata(WriteData *wd, int filecode, size_t len, const void *adr)
   bh.SDNAnr = 0;
   bh.len = int(len);
 
-  mywrite(wd, &bh, sizeof(BHead));
+  mywrite_bhead(wd, bh);
   mywrite(wd, adr, len);
 }
 
@@ -1371,6 +1608,13 @@ static bool write_file_handle(Main *mainvar,
 
         id_buffer_init_from_id(id_buffer, id, wd->use_memfile);
 
+        if (mywrite_id_is_unchanged(wd, mainvar, id, id_buffer->temp_id)) {
+          BLI_assert(wd->buffer.used_len == 0);
+          BLO_memfile_chunks_reuse_current_id(&wd->mem);
+          mywrite_id_end(wd, id);
+          continue;
+        }
+
         if (id_type->blend_write != nullptr) {
           id_type->blend_write(&writer, static_cast<ID *>(id_buffer->temp_id), id);
         }
@@ -1393,6 +1637,10 @@ static bool write_file_handle(Main *mainvar,
     override_storage = nullptr;
   }
 
+  if (wd->use_memfile) {
+    mainvar->is_memfile_undo_id_skip_allowed = true;
+  }
+
   /* Special handling, operating over split Mains... */
   write_libraries(wd, mainvar->next);
 
@@ -1412,7 +1660,9 @@ static bool write_file_handle(Main *mainvar,
   /* End of file. */
   memset(&bhead, 0, sizeof(BHead));
   bhead.code = BLO_CODE_ENDB;
-  mywrite(wd, &bhead, sizeof(BHead));
+  mywrite_bhead(wd, bhead);
+
+  mywrite_bhead_index(wd);
 
   blo_join_main(&mainlist);
 
@@ -1501,12 +1751,42 @@ static void write_file_main_validate_post(Main *bmain, ReportList *reports)
   }
 }
 
+/**
+ * Replace the file with the successfully written temporary file, keeping backups of the old
+ * file when requested.
+ */
+static bool write_file_replace(const char *filepath,
+                               const char *tempname,
+                               const bool use_save_versions,
+                               ReportList *reports)
+{
+  /* File save to temporary file was successful, now do reverse file history
+   * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
+  if (use_save_versions) {
+    if (!do_history(filepath, reports)) {
+      BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
+      return false;
+    }
+  }
+
+  if (BLI_rename_overwrite(tempname, filepath) != 0) {
+    BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * \param defer_file_write: Only serialize into the write wrapper, the file on disk is written
+ * later from the buffered data, see #BLO_write_file_to_buffer.
+ */
 static bool BLO_write_file_impl(Main *mainvar,
                                 const char *filepath,
                                 const int write_flags,
                                 const BlendFileWriteParams *params,
                                 ReportList *reports,
-                                WriteWrap &ww)
+                                WriteWrap &ww,
+                                const bool defer_file_write)
 {
   BLI_assert(!BLI_path_is_rel(filepath));
   BLI_assert(BLI_path_is_abs_from_cwd(filepath));
@@ -1632,25 +1912,19 @@ static bool BLO_write_file_impl(Main *mainvar,
 
   if (err) {
     BKE_report(reports, RPT_ERROR, strerror(errno));
-    remove(tempname);
+    if (!defer_file_write) {
+      remove(tempname);
+    }
 
     return false;
   }
 
-  /* File save to temporary file was successful, now do reverse file history
-   * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
-  if (use_save_versions) {
-    if (!do_history(filepath, reports)) {
-      BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
+  if (!defer_file_write) {
+    if (!write_file_replace(filepath, tempname, use_save_versions, reports)) {
       return false;
     }
   }
 
-  if (BLI_rename_overwrite(tempname, filepath) != 0) {
-    BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
-    return false;
-  }
-
   write_file_main_validate_post(mainvar, reports);
 
   return true;
@@ -1672,10 +1946,84 @@ bool BLO_write_file(Main *mainvar,
 
   if (write_flags & G_FILE_COMPRESS) {
     ZstdWriteWrap zstd_wrap(raw_wrap);
-    return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, zstd_wrap);
+    return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, zstd_wrap, false);
+  }
+
+  return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap, false);
+}
+
+struct BlendFileWriteBuffer {
+  MemoryWriteWrap memory_wrap;
+  char filepath[FILE_MAX];
+  int write_flags;
+  bool use_save_versions;
+};
+
+BlendFileWriteBuffer *BLO_write_file_to_buffer(Main *mainvar,
+                                               const char *filepath,
+                                               const int write_flags,
+                                               const BlendFileWriteParams *params,
+                                               ReportList *reports)
+{
+  BlendFileWriteBuffer *buffer = MEM_new<BlendFileWriteBuffer>(__func__);
+  if (!BLO_write_file_impl(
+          mainvar, filepath, write_flags, params, reports, buffer->memory_wrap, true))
+  {
+    MEM_delete(buffer);
+    return nullptr;
+  }
+  STRNCPY(buffer->filepath, filepath);
+  buffer->write_flags = write_flags;
+  buffer->use_save_versions = params->use_save_versions;
+  return buffer;
+}
+
+static bool write_buffer_to_file_impl(const BlendFileWriteBuffer &buffer,
+                                      ReportList *reports,
+                                      WriteWrap &ww)
+{
+  char tempname[FILE_MAX + 1];
+  SNPRINTF(tempname, "%s@", buffer.filepath);
+
+  if (ww.open(tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  bool ok = true;
+  for (const blender::Array<uchar> &chunk : buffer.memory_wrap.chunks) {
+    if (!ww.write(chunk.data(), size_t(chunk.size()))) {
+      ok = false;
+      break;
+    }
+  }
+  ok = ww.close() && ok;
+
+  if (!ok) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+    return false;
+  }
+
+  return write_file_replace(buffer.filepath, tempname, buffer.use_save_versions, reports);
+}
+
+bool BLO_write_buffer_to_file(const BlendFileWriteBuffer *buffer, ReportList *reports)
+{
+  RawWriteWrap raw_wrap;
+
+  if (buffer->write_flags & G_FILE_COMPRESS) {
+    ZstdWriteWrap zstd_wrap(raw_wrap);
+    return write_buffer_to_file_impl(*buffer, reports, zstd_wrap);
   }
 
-  return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
+  return write_buffer_to_file_impl(*buffer, reports, raw_wrap);
+}
+
+void BLO_write_buffer_free(BlendFileWriteBuffer *buffer)
+{
+  MEM_delete(buffer);
 }
 
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
@@ -1874,13 +2222,25 @@ void BLO_write_shared(BlendWriter *writer,
       if (memfile.shared_storage->map.add(data, sharing_info)) {
         /* The undo-step takes (shared) ownership of the data, which also makes it immutable. */
         sharing_info->add_user();
+        memfile.shared_storage->data_by_id_session_uid
+            .lookup_or_add_default(writer->wd->mem.current_id_session_uid)
+            .append(data);
         /* This size is an estimate, but good enough to count data with many users less. */
         memfile.size += approximate_size_in_bytes / sharing_info->strong_users();
         return;
       }
     }
+    write_fn();
+    return;
+  }
+  WriteData *wd = writer->wd;
+  if (sharing_info != nullptr) {
+    wd->shared.data = static_cast<const char *>(data);
+    wd->shared.size = approximate_size_in_bytes;
+    wd->shared.sharing_info = sharing_info;
   }
   write_fn();
+  wd->shared.sharing_info = nullptr;
 }
 
 bool BLO_write_is_undo(BlendWriter *writer)
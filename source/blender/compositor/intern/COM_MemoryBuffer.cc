@@ -4,9 +4,16 @@
 
 #include "COM_MemoryBuffer.h"
 
+#include "BLI_task.hh"
+
 #include "IMB_colormanagement.hh"
 #include "IMB_imbuf_types.hh"
 
+/* The number of rows that bulk copies and conversions process per task. Small areas are processed
+ * in a single task, which is typically the case when called from already multi-threaded
+ * operations, while large areas like whole images and render passes are split among threads. */
+static constexpr int64_t rows_grain_size = 32;
+
 #define ASSERT_BUFFER_CONTAINS_AREA(buf, area) \
   BLI_assert(BLI_rcti_inside_rcti(&(buf)->get_rect(), &(area)))
 
@@ -253,18 +260,20 @@ void MemoryBuffer::copy_from(const uchar *src,
   const int width = BLI_rcti_size_x(&area);
   const int height = BLI_rcti_size_y(&area);
   const uchar *const src_start = src + area.ymin * row_stride + channel_offset;
-  for (int y = 0; y < height; y++) {
-    const uchar *from_elem = src_start + y * row_stride + area.xmin * elem_stride;
-    float *to_elem = &this->get_value(to_x, to_y + y, to_channel_offset);
-    const float *row_end = to_elem + width * this->elem_stride;
-    while (to_elem < row_end) {
-      for (int i = 0; i < elem_size; i++) {
-        to_elem[i] = float(from_elem[i]) * (1.0f / 255.0f);
+  threading::parallel_for(IndexRange(height), rows_grain_size, [&](const IndexRange rows) {
+    for (const int64_t y : rows) {
+      const uchar *from_elem = src_start + y * row_stride + area.xmin * elem_stride;
+      float *to_elem = &this->get_value(to_x, to_y + y, to_channel_offset);
+      const float *row_end = to_elem + width * this->elem_stride;
+      while (to_elem < row_end) {
+        for (int i = 0; i < elem_size; i++) {
+          to_elem[i] = float(from_elem[i]) * (1.0f / 255.0f);
+        }
+        to_elem += this->elem_stride;
+        from_elem += elem_stride;
       }
-      to_elem += this->elem_stride;
-      from_elem += elem_stride;
     }
-  }
+  });
 }
 
 void MemoryBuffer::apply_processor(ColormanageProcessor &processor, const rcti area)
@@ -305,11 +314,14 @@ static void colorspace_to_scene_linear(MemoryBuffer *buf, const rcti &area, Colo
 
 static void premultiply_alpha(MemoryBuffer *buf, const rcti &area)
 {
-  for (int y = area.ymin; y < area.ymax; y++) {
-    for (int x = area.xmin; x < area.xmax; x++) {
-      straight_to_premul_v4(buf->get_elem(x, y));
+  const IndexRange rows = IndexRange::from_begin_end(area.ymin, area.ymax);
+  threading::parallel_for(rows, rows_grain_size, [&](const IndexRange sub_rows) {
+    for (const int64_t y : sub_rows) {
+      for (int x = area.xmin; x < area.xmax; x++) {
+        straight_to_premul_v4(buf->get_elem(x, y));
+      }
     }
-  }
+  });
 }
 
 void MemoryBuffer::copy_from(const ImBuf *src,
@@ -496,11 +508,13 @@ void MemoryBuffer::copy_rows_from(const MemoryBuffer *src,
   const int width = BLI_rcti_size_x(&area);
   const int height = BLI_rcti_size_y(&area);
   const int row_bytes = this->get_num_channels() * width * sizeof(float);
-  for (int y = 0; y < height; y++) {
-    float *to_row = this->get_elem(to_x, to_y + y);
-    const float *from_row = src->get_elem(area.xmin, area.ymin + y);
-    memcpy(to_row, from_row, row_bytes);
-  }
+  threading::parallel_for(IndexRange(height), rows_grain_size, [&](const IndexRange rows) {
+    for (const int64_t y : rows) {
+      float *to_row = this->get_elem(to_x, to_y + y);
+      const float *from_row = src->get_elem(area.xmin, area.ymin + y);
+      memcpy(to_row, from_row, row_bytes);
+    }
+  });
 }
 
 void MemoryBuffer::copy_elems_from(const MemoryBuffer *src,
@@ -519,16 +533,18 @@ void MemoryBuffer::copy_elems_from(const MemoryBuffer *src,
   const int width = BLI_rcti_size_x(&area);
   const int height = BLI_rcti_size_y(&area);
   const int elem_bytes = elem_size * sizeof(float);
-  for (int y = 0; y < height; y++) {
-    float *to_elem = &this->get_value(to_x, to_y + y, to_channel_offset);
-    const float *from_elem = &src->get_value(area.xmin, area.ymin + y, channel_offset);
-    const float *row_end = to_elem + width * this->elem_stride;
-    while (to_elem < row_end) {
-      memcpy(to_elem, from_elem, elem_bytes);
-      to_elem += this->elem_stride;
-      from_elem += src->elem_stride;
+  threading::parallel_for(IndexRange(height), rows_grain_size, [&](const IndexRange rows) {
+    for (const int64_t y : rows) {
+      float *to_elem = &this->get_value(to_x, to_y + y, to_channel_offset);
+      const float *from_elem = &src->get_value(area.xmin, area.ymin + y, channel_offset);
+      const float *row_end = to_elem + width * this->elem_stride;
+      while (to_elem < row_end) {
+        memcpy(to_elem, from_elem, elem_bytes);
+        to_elem += this->elem_stride;
+        from_elem += src->elem_stride;
+      }
     }
-  }
+  });
 }
 
 }  // namespace blender::compositor
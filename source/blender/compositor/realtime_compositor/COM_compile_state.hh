@@ -167,6 +167,13 @@ class CompileState {
    * the node in ShaderOperation::populate_results_for_node. */
   int compute_shader_node_operation_outputs_count(DNode node);
 
+  /* Estimates the register pressure of the shader that the current shader compile unit will be
+   * compiled into, computed as the maximum number of node output values that are alive at the
+   * same time while evaluating the nodes in order. A value is alive from the node that computes it
+   * until the last node in the compile unit that uses it, or until the end of the shader if it is
+   * also an output of the shader operation. */
+  int compute_shader_compile_unit_live_values_count();
+
  private:
   /* Compute the node domain of the given shader node. This is analogous to the
    * Operation::compute_domain method, except it is computed from the node itself as opposed to a
@@ -125,6 +125,11 @@ class Context {
    * executing as soon as possible. */
   virtual bool is_canceled() const;
 
+  /* Returns true if the textures returned by the get_input_texture method are never modified after
+   * they are returned for the lifetime of the context, such that their identity can be used to
+   * identify results computed from them across evaluations. Defaults to false. */
+  virtual bool are_input_textures_persistent() const;
+
   /* Resets the context's internal structures like texture pool and cache manager. This should be
    * called before every evaluation. */
   void reset();
@@ -147,6 +152,10 @@ class Context {
   /* Get the current time in seconds of the active scene. */
   float get_time() const;
 
+  /* Get the maximum size in bytes of the node results that can be cached across evaluations. Zero
+   * means node results should not be cached. See the CachedNodeResult class. */
+  int64_t get_node_results_cache_limit() const;
+
   /* Get a GPU shader with the given info name and precision. */
   GPUShader *get_shader(const char *info_name, ResultPrecision precision);
 
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 #include "BLI_string_ref.hh"
 
 #include "DNA_node_types.h"
@@ -27,11 +30,22 @@ using namespace nodes::derived_node_tree_types;
  * constructor. This class essentially just implements a default constructor that populates output
  * results for all outputs of the node as well as input descriptors for all inputs of the nodes
  * based on their socket declaration. The class also provides some utility methods for easier
- * implementation of nodes. */
+ * implementation of nodes.
+ *
+ * If the node results cache limit of the context is not zero, the results of node operations are
+ * cached across evaluations, identified by a hash of the node, its inputs, and the evaluation
+ * state. So if an operation in a later evaluation computes the same hash, the cached results are
+ * used and the operation is not executed. See the compute_results_cache_hash method. */
 class NodeOperation : public Operation {
  private:
   /* The node that this operation represents. */
   DNode node_;
+  /* The hash returned by the compute_node_cache_hash method, which is only computed once for the
+   * lifetime of the operation. */
+  std::optional<uint64_t> node_cache_hash_;
+  /* The hash that identifies the results of the operation in the current evaluation, or zero if
+   * the results can't be cached. */
+  uint64_t results_cache_hash_ = 0;
 
  public:
   /* Populate the output results based on the node outputs and populate the input descriptors based
@@ -52,6 +66,22 @@ class NodeOperation : public Operation {
   /* Compute a node preview using the result returned from the get_preview_result method. */
   void compute_preview() override;
 
+  /* Load the results of the operation from the node results cache if they were cached by an
+   * operation with the same results hash. See the compute_results_cache_hash method. */
+  bool load_cached_results() override;
+
+  /* Set the cache hashes of the results of the operation and add them to the node results cache
+   * if the cache limit allows it. */
+  void cache_results() override;
+
+  /* Compute a hash that identifies the node and all the data it reads except its inputs, or return
+   * zero if the node reads data whose changes can't be identified. The default implementation
+   * hashes the node type and the values of its properties, and returns zero for nodes that
+   * reference an ID. This can be overridden by nodes that can identify the data they read. This is
+   * only called once for the lifetime of the operation, since any change to the node tree causes
+   * the operation to be recreated. */
+  virtual uint64_t compute_node_cache_hash();
+
   /* Returns a reference to the derived node that this operation represents. */
   const DNode &node() const;
 
@@ -63,6 +93,14 @@ class NodeOperation : public Operation {
   bool should_compute_output(StringRef identifier);
 
  private:
+  /* Compute the hash that identifies the results of the operation in the current evaluation. This
+   * combines the hash of the node, the hashes of its input results or their values if they are
+   * single values, and the state of the evaluation like the frame number and compositing region.
+   * Zero is returned if the results can't be cached, either because caching is disabled, the node
+   * has no outputs and is thus evaluated for its side effects, or because the node or any of its
+   * inputs can't be identified. */
+  uint64_t compute_results_cache_hash();
+
   /* Get the result which will be previewed in the node, this is chosen as the first linked output
    * of the node, if no outputs exist, then the first allocated input will be chosen. Nullptr is
    * guaranteed not to be returned, since the node will always either have a linked output or an
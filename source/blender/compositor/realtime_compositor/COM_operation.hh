@@ -92,7 +92,8 @@ class Operation {
   /* Evaluate the operation by:
    * 1. Evaluating the input processors.
    * 2. Resetting the results of the operation.
-   * 3. Calling the execute method of the operation.
+   * 3. Loading the results of the operation from the cache if possible, otherwise, calling the
+   *    execute method of the operation and caching its results.
    * 4. Releasing the results mapped to the inputs. */
   virtual void evaluate();
 
@@ -129,6 +130,17 @@ class Operation {
    * output results. */
   virtual void execute() = 0;
 
+  /* Load the results of the operation from the results computed in a previous evaluation and
+   * return true if they were loaded, in which case, the execute method will not be called. This
+   * method defaults to an empty implementation that returns false and should be implemented by
+   * operations whose results can be cached. */
+  virtual bool load_cached_results();
+
+  /* Cache the results of the operation after it was executed, or at least the hashes of their
+   * content, such that later operations can identify them. This method defaults to an empty
+   * implementation. See Result::cache_hash() for more information. */
+  virtual void cache_results();
+
   /* Compute and set a preview of the operation if needed. This method defaults to an empty
    * implementation and should be implemented by operations which can have previews. */
   virtual void compute_preview();
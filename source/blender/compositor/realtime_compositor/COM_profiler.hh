@@ -15,6 +15,21 @@ namespace blender::realtime_compositor {
 
 class Context;
 
+/* Statistics about the fusion of pixel-wise nodes into shader operations, which can be used to
+ * measure how effective the fusion is for a node tree. */
+struct ShaderFusionStatistics {
+  /* The number of compiled shader operations. */
+  int shader_operations_count = 0;
+  /* The total number of nodes that were compiled into shader operations. */
+  int fused_nodes_count = 0;
+  /* The number of times a shader compile unit was split because its shader would have had too
+   * many outputs. */
+  int outputs_limit_splits_count = 0;
+  /* The number of times a shader compile unit was split because its estimated register pressure
+   * was too high. */
+  int register_pressure_splits_count = 0;
+};
+
 /* -------------------------------------------------------------------------------------------------
  * Profiler
  *
@@ -27,6 +42,7 @@ class Profiler {
    * together with other pixel-wise operations in a single operation, so we can't measure the
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
+  ShaderFusionStatistics shader_fusion_statistics_;
 
  public:
   /* Returns a reference to the nodes evaluation times. */
@@ -35,6 +51,16 @@ class Profiler {
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
 
+  /* Returns the statistics of the fusion of nodes into shader operations. */
+  const ShaderFusionStatistics &get_shader_fusion_statistics() const;
+
+  /* Record that a shader operation was compiled from the given number of nodes. */
+  void count_shader_operation(int nodes_count);
+
+  /* Record that a shader compile unit was split, either due to its register pressure or due to
+   * the number of its outputs. */
+  void count_shader_compile_unit_split(bool is_due_to_register_pressure);
+
   /* Finalize profiling by computing node group times. This should be called after evaluation. */
   void finalize(const bNodeTree &node_tree);
 
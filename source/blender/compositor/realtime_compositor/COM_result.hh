@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
 
@@ -127,6 +129,11 @@ class Result {
    * result. This is set up by a call to the wrap_external method. In that case, when the reference
    * count eventually reach zero, the texture will not be freed. */
   bool is_external_ = false;
+  /* A hash that identifies the content of the result across evaluations, such that two results
+   * with the same hash are assumed to store identical data. Zero means the content of the result
+   * can't be identified, for instance, because it was computed from data that changes between
+   * evaluations. This is used to cache node results, see the CachedNodeResult class. */
+  uint64_t cache_hash_ = 0;
 
  public:
   /* The pixels in the result represents data, which is not to be color-managed. */
@@ -326,6 +333,12 @@ class Result {
 
   /* Returns a reference to the domain of the result. See the Domain class. */
   const Domain &domain() const;
+
+  /* Returns the cache hash of the result. See the cache_hash_ member for more information. */
+  uint64_t cache_hash() const;
+
+  /* Sets the cache hash of the result. See the cache_hash_ member for more information. */
+  void set_cache_hash(uint64_t hash);
 };
 
 }  // namespace blender::realtime_compositor
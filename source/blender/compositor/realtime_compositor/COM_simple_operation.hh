@@ -40,6 +40,10 @@ class SimpleOperation : public Operation {
   /* Simple operations don't need input processors, so override with an empty implementation. */
   void add_and_evaluate_input_processors() override;
 
+  /* Simple operations compute their result from their input alone, so the result is identified by
+   * the hash of the input. See Result::cache_hash() for more information. */
+  void cache_results() override;
+
   /* Get a reference to the input result of the operation, this essentially calls the super
    * get_result method with the input identifier of the operation. */
   Result &get_input();
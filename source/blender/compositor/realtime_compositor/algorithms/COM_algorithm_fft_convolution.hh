@@ -0,0 +1,30 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "COM_result.hh"
+
+namespace blender::realtime_compositor {
+
+/* Returns true if convolving an image with a kernel of the given radius is expected to be faster
+ * using fft_convolution() than using a direct convolution, that is, if the radius is large enough
+ * to amortize the cost of the transforms and the compositor was built with FFTW. */
+bool is_fft_convolution_preferred(int radius);
+
+/* Convolves the given color input with the given color kernel using the Fast Fourier Transform and
+ * writes the result to the given output, which is allocated by this function. The kernel is
+ * sampled at the centers of a grid of (2 * radius + 1) ^ 2 pixels using nearest interpolation and
+ * is applied inverted along both directions, and the result is normalized by the sum of the
+ * kernel weights of each channel, all of which exactly match the behavior of the direct
+ * convolution of the Bokeh Blur node. If extend_bounds is true, the output is larger than the
+ * input by a radius amount of pixels in both sides and a zero boundary is assumed, otherwise, an
+ * extended boundary is assumed. */
+void fft_convolution(const Result &input,
+                     const Result &kernel,
+                     Result &output,
+                     int radius,
+                     bool extend_bounds);
+
+}  // namespace blender::realtime_compositor
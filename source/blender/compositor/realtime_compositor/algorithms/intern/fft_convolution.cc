@@ -0,0 +1,278 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <complex>
+#include <cstdint>
+
+#if defined(WITH_FFTW3)
+#  include <fftw3.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_assert.h"
+#include "BLI_fftw.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
+
+#include "GPU_state.hh"
+#include "GPU_texture.hh"
+
+#include "COM_domain.hh"
+#include "COM_result.hh"
+
+#include "COM_algorithm_fft_convolution.hh"
+
+namespace blender::realtime_compositor {
+
+/* The radius starting from which the direct convolution, whose cost grows quadratically with the
+ * radius, becomes slower than the FFT convolution, whose cost is mostly independent of the radius
+ * but includes the overhead of moving the data between the host and the device. The value was
+ * chosen empirically. */
+[[maybe_unused]] static constexpr int fft_convolution_minimum_radius = 32;
+
+bool is_fft_convolution_preferred(const int radius)
+{
+#if defined(WITH_FFTW3)
+  return radius >= fft_convolution_minimum_radius;
+#else
+  UNUSED_VARS(radius);
+  return false;
+#endif
+}
+
+void fft_convolution(const Result &input,
+                     const Result &kernel,
+                     Result &output,
+                     const int radius,
+                     const bool extend_bounds)
+{
+  BLI_assert(input.type() == ResultType::Color);
+  BLI_assert(kernel.type() == ResultType::Color);
+
+  Domain domain = input.domain();
+  if (extend_bounds) {
+    /* Add a radius amount of pixels in both sides of the image, hence the multiply by 2. */
+    domain.size += int2(radius * 2);
+  }
+  output.allocate_texture(domain);
+
+#if defined(WITH_FFTW3)
+  fftw::initialize_float();
+
+  /* The output pixel at texel t is the sum of the padded image pixels at t + radius - k for all
+   * kernel offsets k in the [-radius, radius] range, where the padded image is the input image
+   * shifted by a padding amount and extended according to the boundary condition. If bounds are
+   * not extended, the padding is the radius and the image is extended by clamping, otherwise, the
+   * padding is twice the radius and the image is extended by zeros. Since we will be doing a
+   * circular convolution, we need the spatial domain to be large enough to contain all of the
+   * pixels that contribute to the output without wrapping around. */
+  const int2 image_size = input.domain().size;
+  const int2 output_size = domain.size;
+  const int padding = extend_bounds ? radius * 2 : radius;
+  const int2 needed_spatial_size = output_size + int2(radius * 2);
+  const int2 spatial_size = fftw::optimal_size_for_real_transform(needed_spatial_size);
+
+  /* The FFTW real to complex transforms utilizes the hermitian symmetry of real transforms and
+   * stores only half the output since the other half is redundant, so we only allocate half of
+   * the first dimension. See Section 4.3.4 Real-data DFT Array Format in the FFTW manual for
+   * more information. */
+  const int2 frequency_size = int2(spatial_size.x / 2 + 1, spatial_size.y);
+
+  const int channels_count = 4;
+  const int64_t spatial_pixels_per_channel = int64_t(spatial_size.x) * spatial_size.y;
+  const int64_t frequency_pixels_per_channel = int64_t(frequency_size.x) * frequency_size.y;
+  const int64_t spatial_pixels_count = spatial_pixels_per_channel * channels_count;
+  const int64_t frequency_pixels_count = frequency_pixels_per_channel * channels_count;
+
+  float *image_spatial_domain = fftwf_alloc_real(spatial_pixels_count);
+  std::complex<float> *image_frequency_domain = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_count));
+  float *kernel_spatial_domain = fftwf_alloc_real(spatial_pixels_count);
+  std::complex<float> *kernel_frequency_domain = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_count));
+
+  /* Create a real to complex plan to transform the image and the kernel to the frequency
+   * domain. The same plan is used for both since they have the same size and alignment. */
+  fftwf_plan forward_plan = fftwf_plan_dft_r2c_2d(
+      spatial_size.y,
+      spatial_size.x,
+      image_spatial_domain,
+      reinterpret_cast<fftwf_complex *>(image_frequency_domain),
+      FFTW_ESTIMATE);
+
+  GPU_memory_barrier(GPU_BARRIER_TEXTURE_UPDATE);
+  float *input_buffer = static_cast<float *>(
+      GPU_texture_read(input.texture(), GPU_DATA_FLOAT, 0));
+
+  /* Pad the image to the required spatial domain size, storing each channel in planar format for
+   * better cache locality, that is, RRRR...GGGG...BBBB...AAAA. */
+  threading::parallel_for(IndexRange(spatial_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(spatial_size.x)) {
+        const int2 texel = int2(x, y) - int2(padding);
+        const bool is_inside_image = texel.x >= 0 && texel.y >= 0 && texel.x < image_size.x &&
+                                     texel.y < image_size.y;
+        const int2 clamped_texel = math::clamp(texel, int2(0), image_size - int2(1));
+        const int64_t image_index = (int64_t(clamped_texel.y) * image_size.x + clamped_texel.x) *
+                                    channels_count;
+        for (const int64_t channel : IndexRange(channels_count)) {
+          const int64_t output_index = y * spatial_size.x + x +
+                                       spatial_pixels_per_channel * channel;
+          if (extend_bounds && !is_inside_image) {
+            image_spatial_domain[output_index] = 0.0f;
+          }
+          else {
+            image_spatial_domain[output_index] = input_buffer[image_index + channel];
+          }
+        }
+      }
+    }
+  });
+
+  MEM_freeN(input_buffer);
+
+  float *kernel_buffer = nullptr;
+  int2 kernel_size = int2(1);
+  if (!kernel.is_single_value()) {
+    kernel_size = kernel.domain().size;
+    kernel_buffer = static_cast<float *>(GPU_texture_read(kernel.texture(), GPU_DATA_FLOAT, 0));
+  }
+  const float4 kernel_value = kernel.is_single_value() ? kernel.get_color_value() : float4(0.0f);
+
+  /* Sample the kernel at the centers of a grid of (2 * radius + 1) ^ 2 pixels and store it in the
+   * spatial domain such that its center is at the origin, wrapping negative offsets around to the
+   * other side of the domain. The kernel is applied inverted in the direct convolution, and a
+   * convolution inherently inverts the kernel, so the kernel is sampled as is. */
+  const int kernel_grid_size = radius * 2 + 1;
+  threading::parallel_for(IndexRange(spatial_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(spatial_size.x)) {
+        /* Compute the kernel offset of the current pixel, taking wrapping into account. */
+        const int2 offset = int2(x > spatial_size.x / 2 ? x - spatial_size.x : x,
+                                 y > spatial_size.y / 2 ? y - spatial_size.y : y);
+        const bool is_inside_kernel = math::abs(offset.x) <= radius &&
+                                      math::abs(offset.y) <= radius;
+
+        float4 weight = float4(0.0f);
+        if (is_inside_kernel && kernel_buffer) {
+          const float2 coordinates = (float2(offset) + float2(radius + 0.5f)) / kernel_grid_size;
+          const int2 kernel_texel = math::clamp(
+              int2(coordinates * float2(kernel_size)), int2(0), kernel_size - int2(1));
+          const int64_t kernel_index = (int64_t(kernel_texel.y) * kernel_size.x +
+                                        kernel_texel.x) *
+                                       channels_count;
+          weight = float4(kernel_buffer + kernel_index);
+        }
+        else if (is_inside_kernel) {
+          weight = kernel_value;
+        }
+
+        for (const int64_t channel : IndexRange(channels_count)) {
+          const int64_t output_index = y * spatial_size.x + x +
+                                       spatial_pixels_per_channel * channel;
+          kernel_spatial_domain[output_index] = weight[channel];
+        }
+      }
+    }
+  });
+
+  if (kernel_buffer) {
+    MEM_freeN(kernel_buffer);
+  }
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_r2c(forward_plan,
+                            image_spatial_domain + spatial_pixels_per_channel * channel,
+                            reinterpret_cast<fftwf_complex *>(image_frequency_domain) +
+                                frequency_pixels_per_channel * channel);
+      fftwf_execute_dft_r2c(forward_plan,
+                            kernel_spatial_domain + spatial_pixels_per_channel * channel,
+                            reinterpret_cast<fftwf_complex *>(kernel_frequency_domain) +
+                                frequency_pixels_per_channel * channel);
+    }
+  });
+
+  /* The zero frequency of the kernel is the sum of all of its weights, which is needed to
+   * normalize the convolution. Additionally, the FFT is not normalized, meaning the result of the
+   * FFT followed by an inverse FFT will result in an image that is scaled by a factor of the
+   * product of the width and height, so we take that into account by dividing by that scale. See
+   * Section 4.8.6 Multi-dimensional Transforms of the FFTW manual for more information. */
+  float4 normalization_scale;
+  for (const int64_t channel : IndexRange(channels_count)) {
+    const int64_t zero_frequency_index = frequency_pixels_per_channel * channel;
+    const float weights_sum = kernel_frequency_domain[zero_frequency_index].real();
+    normalization_scale[channel] = float(spatial_size.x) * spatial_size.y * weights_sum;
+  }
+
+  /* Multiply the kernel and the image in the frequency domain to perform the convolution. */
+  threading::parallel_for(IndexRange(frequency_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t channel : IndexRange(channels_count)) {
+      /* Similar to the direct convolution, channels whose weights sum to zero are zero. */
+      const float scale = normalization_scale[channel];
+      for (const int64_t y : sub_y_range) {
+        for (const int64_t x : IndexRange(frequency_size.x)) {
+          const int64_t index = x + y * frequency_size.x + frequency_pixels_per_channel * channel;
+          image_frequency_domain[index] = scale == 0.0f ? std::complex<float>(0.0f) :
+                                                          image_frequency_domain[index] *
+                                                              kernel_frequency_domain[index] /
+                                                              scale;
+        }
+      }
+    }
+  });
+
+  /* Create a complex to real plan to transform the image to the real domain. */
+  fftwf_plan backward_plan = fftwf_plan_dft_c2r_2d(
+      spatial_size.y,
+      spatial_size.x,
+      reinterpret_cast<fftwf_complex *>(image_frequency_domain),
+      image_spatial_domain,
+      FFTW_ESTIMATE);
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_c2r(backward_plan,
+                            reinterpret_cast<fftwf_complex *>(image_frequency_domain) +
+                                frequency_pixels_per_channel * channel,
+                            image_spatial_domain + spatial_pixels_per_channel * channel);
+    }
+  });
+
+  Array<float> output_buffer(int64_t(output_size.x) * output_size.y * channels_count);
+
+  /* Copy the result to the output, offsetting it by the radius as described above. */
+  threading::parallel_for(IndexRange(output_size.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(output_size.x)) {
+        const int64_t output_index = (y * output_size.x + x) * channels_count;
+        const int64_t base_index = (y + radius) * spatial_size.x + x + radius;
+        for (const int64_t channel : IndexRange(channels_count)) {
+          const int64_t input_index = base_index + spatial_pixels_per_channel * channel;
+          output_buffer[output_index + channel] = image_spatial_domain[input_index];
+        }
+      }
+    }
+  });
+
+  fftwf_destroy_plan(forward_plan);
+  fftwf_destroy_plan(backward_plan);
+  fftwf_free(image_spatial_domain);
+  fftwf_free(image_frequency_domain);
+  fftwf_free(kernel_spatial_domain);
+  fftwf_free(kernel_frequency_domain);
+
+  GPU_texture_update(output.texture(), GPU_DATA_FLOAT, output_buffer.data());
+#else
+  /* See is_fft_convolution_preferred(), which should be checked before calling this function. */
+  BLI_assert_unreachable();
+  UNUSED_VARS(kernel);
+#endif
+}
+
+}  // namespace blender::realtime_compositor
@@ -0,0 +1,92 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_string_ref.hh"
+
+#include "GPU_texture.hh"
+
+#include "COM_cached_resource.hh"
+#include "COM_domain.hh"
+#include "COM_result.hh"
+
+namespace blender::realtime_compositor {
+
+class Context;
+
+/* -------------------------------------------------------------------------------------------------
+ * Cached Node Result.
+ *
+ * A cached resource that stores a copy of the output results of a node operation, such that a later
+ * evaluation of an operation whose results are identified by the same hash can use them directly
+ * instead of executing the operation. See NodeOperation::compute_results_cache_hash() for more
+ * information on how the hash is computed. */
+class CachedNodeResult : public CachedResource {
+ private:
+  /* A copy of the data of an output result. The texture is nullptr if the result was a single
+   * value, in which case, the value member stores its value. */
+  struct Output {
+    GPUTexture *texture = nullptr;
+    ResultPrecision precision = ResultPrecision::Half;
+    float4 value = float4(0.0f);
+    Domain domain = Domain::identity();
+    bool is_data = false;
+  };
+
+  /* The size in bytes of the textures of the outputs as declared at construction. */
+  int64_t size_;
+  Map<std::string, Output> outputs_;
+
+ public:
+  CachedNodeResult(int64_t size);
+
+  ~CachedNodeResult();
+
+  /* Copy the data of the given allocated result and store it as the output with the given
+   * identifier. */
+  void add_output(StringRef identifier, const Result &result);
+
+  /* Returns true if an output with the given identifier was added. */
+  bool contains_output(StringRef identifier) const;
+
+  /* Load the output with the given identifier into the given result, which is expected to be
+   * reset but not allocated. Textures are wrapped as external textures as opposed to copied, so
+   * the result shouldn't be modified. */
+  void load_output(StringRef identifier, Result &result) const;
+
+  int64_t size() const;
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Result Container.
+ */
+class CachedNodeResultContainer : CachedResourceContainer {
+ private:
+  Map<uint64_t, std::unique_ptr<CachedNodeResult>> map_;
+  /* The sum of the sizes of all cached node results in the container. */
+  int64_t size_ = 0;
+
+ public:
+  void reset() override;
+
+  /* Check if there is an available CachedNodeResult cached resource with the given hash in the
+   * container, if one exists, tag it as needed to keep it cached for the next evaluation and
+   * return it, otherwise, return nullptr. */
+  CachedNodeResult *get(uint64_t hash);
+
+  /* Create a CachedNodeResult cached resource with the given hash and size in bytes, tag it as
+   * needed, and return it. If one with the same hash already exists or if adding it would make the
+   * sizes of all cached node results exceed the cache limit of the context, nothing is added and
+   * nullptr is returned. */
+  CachedNodeResult *add(Context &context, uint64_t hash, int64_t size);
+};
+
+}  // namespace blender::realtime_compositor
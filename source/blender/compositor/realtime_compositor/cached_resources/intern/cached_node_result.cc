@@ -0,0 +1,173 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstdint>
+#include <memory>
+
+#include "BLI_assert.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_string_ref.hh"
+
+#include "GPU_texture.hh"
+
+#include "COM_cached_node_result.hh"
+#include "COM_context.hh"
+#include "COM_result.hh"
+
+namespace blender::realtime_compositor {
+
+/* --------------------------------------------------------------------
+ * Cached Node Result.
+ */
+
+CachedNodeResult::CachedNodeResult(int64_t size) : size_(size) {}
+
+CachedNodeResult::~CachedNodeResult()
+{
+  for (Output &output : outputs_.values()) {
+    GPU_TEXTURE_FREE_SAFE(output.texture);
+  }
+}
+
+void CachedNodeResult::add_output(StringRef identifier, const Result &result)
+{
+  BLI_assert(result.is_allocated());
+
+  Output output;
+  output.precision = result.precision();
+  output.domain = result.domain();
+  output.is_data = result.is_data;
+
+  if (result.is_single_value()) {
+    switch (result.type()) {
+      case ResultType::Float:
+        output.value = float4(result.get_float_value());
+        break;
+      case ResultType::Vector:
+        output.value = result.get_vector_value();
+        break;
+      case ResultType::Color:
+        output.value = result.get_color_value();
+        break;
+      default:
+        /* Other types are internal and do not support single values. */
+        BLI_assert_unreachable();
+        break;
+    }
+  }
+  else {
+    GPUTexture *source = result.texture();
+    output.texture = GPU_texture_create_2d("Cached Node Result",
+                                           GPU_texture_width(source),
+                                           GPU_texture_height(source),
+                                           1,
+                                           GPU_texture_format(source),
+                                           GPU_TEXTURE_USAGE_GENERAL,
+                                           nullptr);
+    GPU_texture_copy(output.texture, source);
+  }
+
+  Output *previous_output = outputs_.lookup_ptr_as(identifier);
+  if (previous_output) {
+    GPU_TEXTURE_FREE_SAFE(previous_output->texture);
+  }
+  outputs_.add_overwrite(identifier, output);
+}
+
+bool CachedNodeResult::contains_output(StringRef identifier) const
+{
+  return outputs_.contains_as(identifier);
+}
+
+void CachedNodeResult::load_output(StringRef identifier, Result &result) const
+{
+  const Output &output = outputs_.lookup_as(identifier);
+
+  result.set_precision(output.precision);
+  result.is_data = output.is_data;
+
+  if (!output.texture) {
+    result.allocate_single_value();
+    switch (result.type()) {
+      case ResultType::Float:
+        result.set_float_value(output.value.x);
+        break;
+      case ResultType::Vector:
+        result.set_vector_value(output.value);
+        break;
+      case ResultType::Color:
+        result.set_color_value(output.value);
+        break;
+      default:
+        /* Other types are internal and do not support single values. */
+        BLI_assert_unreachable();
+        break;
+    }
+    return;
+  }
+
+  result.wrap_external(output.texture);
+  result.set_transformation(output.domain.transformation);
+  result.get_realization_options() = output.domain.realization_options;
+}
+
+int64_t CachedNodeResult::size() const
+{
+  return size_;
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Result Container.
+ */
+
+void CachedNodeResultContainer::reset()
+{
+  /* First, delete all cached node results that are no longer needed. */
+  map_.remove_if([&](auto item) {
+    if (item.value->needed) {
+      return false;
+    }
+    size_ -= item.value->size();
+    return true;
+  });
+
+  /* Second, reset the needed status of the remaining cached node results to false to ready them
+   * to track their needed status for the next evaluation. */
+  for (auto &value : map_.values()) {
+    value->needed = false;
+  }
+}
+
+CachedNodeResult *CachedNodeResultContainer::get(uint64_t hash)
+{
+  std::unique_ptr<CachedNodeResult> *cached_node_result = map_.lookup_ptr(hash);
+  if (!cached_node_result) {
+    return nullptr;
+  }
+
+  (*cached_node_result)->needed = true;
+  return cached_node_result->get();
+}
+
+CachedNodeResult *CachedNodeResultContainer::add(Context &context, uint64_t hash, int64_t size)
+{
+  /* An existing cached node result might be in use by other operations in the current evaluation,
+   * so it can't be replaced. */
+  if (map_.contains(hash)) {
+    return nullptr;
+  }
+
+  if (size_ + size > context.get_node_results_cache_limit()) {
+    return nullptr;
+  }
+
+  size_ += size;
+  CachedNodeResult &cached_node_result = *map_.lookup_or_add_cb(
+      hash, [&]() { return std::make_unique<CachedNodeResult>(size); });
+
+  cached_node_result.needed = true;
+  return &cached_node_result;
+}
+
+}  // namespace blender::realtime_compositor
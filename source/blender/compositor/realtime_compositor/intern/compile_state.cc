@@ -4,6 +4,8 @@
 
 #include <limits>
 
+#include "BLI_array.hh"
+#include "BLI_math_base.hh"
 #include "BLI_math_vector_types.hh"
 
 #include "DNA_node_types.h"
@@ -132,6 +134,50 @@ int CompileState::compute_shader_node_operation_outputs_count(DNode node)
   return outputs_count;
 }
 
+int CompileState::compute_shader_compile_unit_live_values_count()
+{
+  /* The change in the number of alive values at each node of the compile unit. */
+  Array<int> live_values_changes(shader_compile_unit_.size() + 1, 0);
+
+  for (const int i : shader_compile_unit_.index_range()) {
+    const DNode node = shader_compile_unit_[i];
+    for (const bNodeSocket *output : node->output_sockets()) {
+      const DOutputSocket doutput{node.context(), output};
+
+      int last_use_index = -1;
+      number_of_inputs_linked_to_output_conditioned(doutput, [&](DInputSocket input) {
+        const DNode linked_node = input.node();
+        if (shader_compile_unit_.contains(linked_node)) {
+          last_use_index = math::max(last_use_index,
+                                     int(shader_compile_unit_.index_of(linked_node)));
+        }
+        else if (schedule_.contains(linked_node)) {
+          /* Conservatively assume operation outputs are stored at the end of the shader. */
+          last_use_index = shader_compile_unit_.size() - 1;
+        }
+        return false;
+      });
+
+      /* The output is not used, so it is never alive. */
+      if (last_use_index == -1) {
+        continue;
+      }
+
+      live_values_changes[i]++;
+      live_values_changes[last_use_index + 1]--;
+    }
+  }
+
+  int live_values_count = 0;
+  int max_live_values_count = 0;
+  for (const int change : live_values_changes) {
+    live_values_count += change;
+    max_live_values_count = math::max(max_live_values_count, live_values_count);
+  }
+
+  return max_live_values_count;
+}
+
 Domain CompileState::compute_shader_node_domain(DNode node)
 {
   /* Default to an identity domain in case no domain input was found, most likely because all
@@ -42,6 +42,11 @@ bool Context::is_canceled() const
   return this->get_node_tree().runtime->test_break(get_node_tree().runtime->tbh);
 }
 
+bool Context::are_input_textures_persistent() const
+{
+  return false;
+}
+
 void Context::reset()
 {
   texture_pool_.reset();
@@ -74,6 +79,11 @@ int Context::get_frame_number() const
   return get_render_data().cfra;
 }
 
+int64_t Context::get_node_results_cache_limit() const
+{
+  return int64_t(get_render_data().compositor_cache_limit) * 1024 * 1024;
+}
+
 float Context::get_time() const
 {
   const float frame_number = float(get_frame_number());
@@ -23,6 +23,12 @@ namespace blender::realtime_compositor {
 
 using namespace nodes::derived_node_tree_types;
 
+/* The maximum number of values that the shader of a shader operation can keep alive at the same
+ * time. Values are four component vectors, so this roughly corresponds to 128 registers, beyond
+ * which the occupancy of typical GPUs starts to drop. See
+ * CompileState::compute_shader_compile_unit_live_values_count. */
+static constexpr int max_shader_live_values = 32;
+
 Evaluator::Evaluator(Context &context) : context_(context) {}
 
 void Evaluator::evaluate()
@@ -168,22 +174,32 @@ void Evaluator::compile_and_evaluate_shader_compile_unit(CompileState &compile_s
    * splitting will almost always never happen due to the scheduling strategy we use, so the base
    * case remains fast. */
   int number_of_outputs = 0;
-  for (int i : compile_unit.index_range()) {
-    const DNode node = compile_unit[i];
+  for (const DNode &node : compile_unit) {
     number_of_outputs += compile_state.compute_shader_node_operation_outputs_count(node);
+  }
 
-    /* The GPU module currently only supports up to 8 output images in shaders, but once this
-     * limitation is lifted, we can replace that with GPU_max_images(). */
-    if (number_of_outputs <= 8) {
-      continue;
+  /* The GPU module currently only supports up to 8 output images in shaders, but once this
+   * limitation is lifted, we can replace that with GPU_max_images(). */
+  const bool exceeds_outputs_limit = number_of_outputs > 8;
+
+  /* Large compile units might also keep too many values alive at the same time, which increases
+   * register pressure and reduces the occupancy of the shader, to the point where evaluating the
+   * unit as two shaders is faster. A unit with a single node can't be split any further. */
+  const bool exceeds_live_values_limit =
+      compile_unit.size() > 1 &&
+      compile_state.compute_shader_compile_unit_live_values_count() > max_shader_live_values;
+
+  if (exceeds_outputs_limit || exceeds_live_values_limit) {
+    if (context_.profiler()) {
+      context_.profiler()->count_shader_compile_unit_split(!exceeds_outputs_limit);
     }
 
-    /* The number of outputs surpassed the limit, so we split the compile unit into two equal parts
-     * and recursively call this method on each of them. It might seem unexpected that we split in
-     * half as opposed to split at the node that surpassed the limit, but that is because the act
-     * of splitting might actually introduce new outputs, since links that were previously internal
-     * to the compile unit might now be external. So we can't precisely split and guarantee correct
-     * units, and we just rely or recursive splitting until units are small enough. Further, half
+    /* A limit was surpassed, so we split the compile unit into two equal parts and recursively
+     * call this method on each of them. It might seem unexpected that we split in half as opposed
+     * to split at the node that surpassed the limit, but that is because the act of splitting
+     * might actually introduce new outputs, since links that were previously internal to the
+     * compile unit might now be external. So we can't precisely split and guarantee correct units,
+     * and we just rely or recursive splitting until units are small enough. Further, half
      * splitting helps balancing the shaders, where we don't want to have one gigantic shader and
      * a tiny one. */
     const int split_index = compile_unit.size() / 2;
@@ -196,14 +212,17 @@ void Evaluator::compile_and_evaluate_shader_compile_unit(CompileState &compile_s
     compile_state.get_shader_compile_unit() = end_compile_unit;
     this->compile_and_evaluate_shader_compile_unit(compile_state);
 
-    /* No need to continue, the above recursive calls will eventually exist the loop and do the
-     * actual compilation. */
+    /* No need to continue, the above recursive calls will eventually do the actual compilation. */
     return;
   }
 
   const Schedule &schedule = compile_state.get_schedule();
   ShaderOperation *operation = new ShaderOperation(context_, compile_unit, schedule);
 
+  if (context_.profiler()) {
+    context_.profiler()->count_shader_operation(compile_unit.size());
+  }
+
   for (DNode node : compile_unit) {
     compile_state.map_node_to_shader_operation(node, operation);
   }
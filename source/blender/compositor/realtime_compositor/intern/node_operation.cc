@@ -2,9 +2,14 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cstdint>
 #include <memory>
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
 #include "BLI_assert.h"
+#include "BLI_hash.hh"
 #include "BLI_map.hh"
 #include "BLI_math_base.h"
 #include "BLI_math_base.hh"
@@ -23,12 +28,16 @@
 
 #include "BKE_node.hh"
 
+#include "RNA_access.hh"
+
+#include "COM_cached_node_result.hh"
 #include "COM_context.hh"
 #include "COM_input_descriptor.hh"
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
+#include "COM_static_cache_manager.hh"
 #include "COM_utilities.hh"
 
 namespace blender::realtime_compositor {
@@ -114,4 +123,294 @@ bool NodeOperation::should_compute_output(StringRef identifier)
   return get_result(identifier).should_compute();
 }
 
+/* Returns the hash that identifies the output result with the given identifier of an operation
+ * whose results are identified by the given hash. */
+static uint64_t get_output_cache_hash(const uint64_t results_cache_hash, StringRef identifier)
+{
+  const uint64_t hash = get_default_hash(results_cache_hash, identifier);
+  /* Zero is reserved for results that can't be identified. */
+  return hash == 0 ? 1 : hash;
+}
+
+bool NodeOperation::load_cached_results()
+{
+  results_cache_hash_ = compute_results_cache_hash();
+  if (results_cache_hash_ == 0) {
+    return false;
+  }
+
+  const CachedNodeResult *cached_node_result = context().cache_manager().cached_node_results.get(
+      results_cache_hash_);
+  if (!cached_node_result) {
+    return false;
+  }
+
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = get_result(output->identifier);
+    if (result.should_compute() && !cached_node_result->contains_output(output->identifier)) {
+      return false;
+    }
+  }
+
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = get_result(output->identifier);
+    if (!result.should_compute()) {
+      continue;
+    }
+
+    cached_node_result->load_output(output->identifier, result);
+    result.set_cache_hash(get_output_cache_hash(results_cache_hash_, output->identifier));
+  }
+
+  return true;
+}
+
+void NodeOperation::cache_results()
+{
+  if (results_cache_hash_ == 0) {
+    return;
+  }
+
+  int64_t size = 0;
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = get_result(output->identifier);
+    if (!result.should_compute()) {
+      continue;
+    }
+
+    /* The hash identifies the result even if it doesn't end up being cached, such that operations
+     * that depend on it can still be cached. */
+    result.set_cache_hash(get_output_cache_hash(results_cache_hash_, output->identifier));
+    if (result.is_texture()) {
+      size += GPU_texture_memory_size(result.texture());
+    }
+  }
+
+  CachedNodeResult *cached_node_result = context().cache_manager().cached_node_results.add(
+      context(), results_cache_hash_, size);
+  if (!cached_node_result) {
+    return;
+  }
+
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = get_result(output->identifier);
+    if (result.should_compute()) {
+      cached_node_result->add_output(output->identifier, result);
+    }
+  }
+}
+
+/* RNA structures are nested deeper than this are not hashed, and their owners can't be cached. */
+static constexpr int max_rna_hash_depth = 4;
+
+/* Returns the root base structure of the given structure, for instance, Node for node types. */
+static StructRNA *get_root_struct(StructRNA *type)
+{
+  while (StructRNA *base = RNA_struct_base(type)) {
+    type = base;
+  }
+  return type;
+}
+
+/* Returns true if the given structure is a node or a node socket. Those are not hashed when
+ * referenced by other structures, since they are hashed separately during evaluation. */
+static bool is_node_or_socket_struct(StructRNA *type)
+{
+  const StringRef identifier = RNA_struct_identifier(get_root_struct(type));
+  return ELEM(identifier, "Node", "NodeSocket");
+}
+
+template<typename T, typename GetArrayFunction, typename GetFunction>
+static uint64_t hash_rna_number_property(PointerRNA &ptr,
+                                         PropertyRNA *prop,
+                                         const uint64_t hash,
+                                         GetArrayFunction get_array_function,
+                                         GetFunction get_function)
+{
+  const int length = RNA_property_array_length(&ptr, prop);
+  if (length == 0) {
+    return get_default_hash(hash, T(get_function(&ptr, prop)));
+  }
+
+  Array<T> values(length);
+  get_array_function(&ptr, prop, values.data());
+  uint64_t array_hash = hash;
+  for (const T &value : values) {
+    array_hash = get_default_hash(array_hash, value);
+  }
+  return array_hash;
+}
+
+/* Combine the values of the properties of the given RNA pointer into the given hash, recursing
+ * into pointer and collection properties. Properties that are defined in the skipped structure
+ * are ignored. Returns false if the properties reference an ID or are nested too deeply, since
+ * changes to those can't be identified by the hash. */
+static bool hash_rna_properties(PointerRNA &ptr,
+                                StructRNA *skipped_struct,
+                                const int depth,
+                                uint64_t &hash)
+{
+  if (depth > max_rna_hash_depth) {
+    return false;
+  }
+
+  bool is_hashable = true;
+  RNA_STRUCT_BEGIN_SKIP_RNA_TYPE (&ptr, prop) {
+    const char *identifier = RNA_property_identifier(prop);
+    if (skipped_struct && RNA_struct_type_find_property_no_base(skipped_struct, identifier)) {
+      continue;
+    }
+
+    hash = get_default_hash(hash, StringRef(identifier));
+    switch (RNA_property_type(prop)) {
+      case PROP_BOOLEAN:
+        hash = hash_rna_number_property<bool>(
+            ptr, prop, hash, RNA_property_boolean_get_array, RNA_property_boolean_get);
+        break;
+      case PROP_INT:
+        hash = hash_rna_number_property<int>(
+            ptr, prop, hash, RNA_property_int_get_array, RNA_property_int_get);
+        break;
+      case PROP_FLOAT:
+        hash = hash_rna_number_property<float>(
+            ptr, prop, hash, RNA_property_float_get_array, RNA_property_float_get);
+        break;
+      case PROP_ENUM:
+        hash = get_default_hash(hash, RNA_property_enum_get(&ptr, prop));
+        break;
+      case PROP_STRING: {
+        char fixed_buffer[256];
+        int length;
+        char *value = RNA_property_string_get_alloc(
+            &ptr, prop, fixed_buffer, sizeof(fixed_buffer), &length);
+        hash = get_default_hash(hash, StringRef(value, length));
+        if (value != fixed_buffer) {
+          MEM_freeN(value);
+        }
+        break;
+      }
+      case PROP_POINTER: {
+        PointerRNA pointer = RNA_property_pointer_get(&ptr, prop);
+        if (!pointer.data || is_node_or_socket_struct(pointer.type)) {
+          break;
+        }
+        if (RNA_struct_is_ID(pointer.type)) {
+          is_hashable = false;
+          break;
+        }
+        is_hashable = hash_rna_properties(pointer, nullptr, depth + 1, hash);
+        break;
+      }
+      case PROP_COLLECTION: {
+        int items_count = 0;
+        RNA_PROP_BEGIN (&ptr, item, prop) {
+          if (is_node_or_socket_struct(item.type)) {
+            continue;
+          }
+          if (RNA_struct_is_ID(item.type) || !hash_rna_properties(item, nullptr, depth + 1, hash))
+          {
+            is_hashable = false;
+            break;
+          }
+          items_count++;
+        }
+        RNA_PROP_END;
+        hash = get_default_hash(hash, items_count);
+        break;
+      }
+    }
+
+    if (!is_hashable) {
+      break;
+    }
+  }
+  RNA_STRUCT_END;
+
+  return is_hashable;
+}
+
+uint64_t NodeOperation::compute_node_cache_hash()
+{
+  const bNode &node = bnode();
+
+  /* Changes to IDs can't be identified from the node. */
+  if (node.id) {
+    return 0;
+  }
+
+  uint64_t hash = get_default_hash(StringRef(node.idname), node.custom1, node.custom2);
+  hash = get_default_hash(hash, node.custom3, node.custom4);
+
+  /* Hash the properties specific to the node type, ignoring the common properties of all nodes
+   * like the location and name of the node. */
+  StructRNA *node_struct = node.typeinfo->rna_ext.srna;
+  ID *node_tree_id = const_cast<ID *>(&this->node().context()->btree().id);
+  PointerRNA ptr = RNA_pointer_create(node_tree_id, node_struct, const_cast<bNode *>(&node));
+  if (!hash_rna_properties(ptr, get_root_struct(node_struct), 0, hash)) {
+    return 0;
+  }
+
+  return hash == 0 ? 1 : hash;
+}
+
+uint64_t NodeOperation::compute_results_cache_hash()
+{
+  if (context().get_node_results_cache_limit() == 0) {
+    return 0;
+  }
+
+  /* Nodes without outputs are evaluated for their side effects, like writing to the output. */
+  if (this->node()->output_sockets().is_empty()) {
+    return 0;
+  }
+
+  if (!node_cache_hash_) {
+    node_cache_hash_ = compute_node_cache_hash();
+  }
+  if (*node_cache_hash_ == 0) {
+    return 0;
+  }
+
+  const rcti compositing_region = context().get_compositing_region();
+  uint64_t hash = get_default_hash(*node_cache_hash_,
+                                   context().get_frame_number(),
+                                   context().get_view_name(),
+                                   int(context().get_precision()));
+  hash = get_default_hash(hash,
+                          context().get_render_size(),
+                          int4(compositing_region.xmin,
+                               compositing_region.xmax,
+                               compositing_region.ymin,
+                               compositing_region.ymax));
+
+  for (const bNodeSocket *input : this->node()->input_sockets()) {
+    const Result &result = get_input(input->identifier);
+    if (result.is_texture()) {
+      if (result.cache_hash() == 0) {
+        return 0;
+      }
+      hash = get_default_hash(hash, result.cache_hash());
+      continue;
+    }
+
+    switch (result.type()) {
+      case ResultType::Float:
+        hash = get_default_hash(hash, result.get_float_value());
+        break;
+      case ResultType::Vector:
+        hash = get_default_hash(hash, result.get_vector_value());
+        break;
+      case ResultType::Color:
+        hash = get_default_hash(hash, result.get_color_value());
+        break;
+      default:
+        /* Other types are internal and do not support single values. */
+        BLI_assert_unreachable();
+        break;
+    }
+  }
+
+  return hash == 0 ? 1 : hash;
+}
+
 }  // namespace blender::realtime_compositor
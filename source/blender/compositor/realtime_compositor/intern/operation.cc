@@ -32,7 +32,10 @@ void Operation::evaluate()
 
   reset_results();
 
-  execute();
+  if (!load_cached_results()) {
+    execute();
+    cache_results();
+  }
 
   compute_preview();
 
@@ -139,6 +142,13 @@ void Operation::add_and_evaluate_input_processor(StringRef identifier, SimpleOpe
   processor->evaluate();
 }
 
+bool Operation::load_cached_results()
+{
+  return false;
+}
+
+void Operation::cache_results() {}
+
 void Operation::compute_preview(){};
 
 Result &Operation::get_input(StringRef identifier) const
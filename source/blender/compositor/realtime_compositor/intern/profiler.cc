@@ -26,6 +26,27 @@ void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
+const ShaderFusionStatistics &Profiler::get_shader_fusion_statistics() const
+{
+  return shader_fusion_statistics_;
+}
+
+void Profiler::count_shader_operation(int nodes_count)
+{
+  shader_fusion_statistics_.shader_operations_count++;
+  shader_fusion_statistics_.fused_nodes_count += nodes_count;
+}
+
+void Profiler::count_shader_compile_unit_split(bool is_due_to_register_pressure)
+{
+  if (is_due_to_register_pressure) {
+    shader_fusion_statistics_.register_pressure_splits_count++;
+  }
+  else {
+    shader_fusion_statistics_.outputs_limit_splits_count++;
+  }
+}
+
 timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_tree,
                                                           bNodeInstanceKey instance_key)
 {
@@ -278,6 +278,7 @@ void Result::steal_data(Result &source)
   texture_ = source.texture_;
   texture_pool_ = source.texture_pool_;
   domain_ = source.domain_;
+  cache_hash_ = source.cache_hash_;
 
   switch (type_) {
     case ResultType::Float:
@@ -481,4 +482,14 @@ const Domain &Result::domain() const
   return domain_;
 }
 
+uint64_t Result::cache_hash() const
+{
+  return cache_hash_;
+}
+
+void Result::set_cache_hash(uint64_t hash)
+{
+  cache_hash_ = hash;
+}
+
 }  // namespace blender::realtime_compositor
@@ -24,6 +24,11 @@ void SimpleOperation::map_input_to_result(Result *result)
 
 void SimpleOperation::add_and_evaluate_input_processors() {}
 
+void SimpleOperation::cache_results()
+{
+  get_result().set_cache_hash(get_input().cache_hash());
+}
+
 Result &SimpleOperation::get_input()
 {
   return Operation::get_input(input_identifier_);
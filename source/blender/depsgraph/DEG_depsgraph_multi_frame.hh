@@ -0,0 +1,52 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Evaluation of many frames with multiple dependency graphs at the same time. This is meant for
+ * tools that sample the evaluated state over a frame range, like motion paths and exporters,
+ * where the frames are independent from each other. The evaluated data of every frame is handed
+ * to the caller in frame order.
+ *
+ * Content that depends on the previous frame, like simulations and point caches, can't be
+ * evaluated this way.
+ */
+
+#include "BLI_function_ref.hh"
+
+struct Depsgraph;
+
+namespace blender::deg::multi_frame {
+
+/**
+ * Evaluate all frames from \a start_frame to \a end_frame (inclusive) and call \a consume_fn
+ * with the dependency graph evaluated at each frame, in ascending frame order, on the calling
+ * thread.
+ *
+ * \param graph: Used for the evaluation of some of the frames. It must not be active, so that
+ * the evaluation does not write back to original data.
+ * \param graphs_num: The maximum number of dependency graphs that evaluate frames at the same
+ * time. Values below two evaluate all frames with \a graph on the calling thread.
+ * \param create_graph_fn: Creates an additional inactive dependency graph with the same content
+ * as \a graph. It is called on the calling thread, the created graphs are freed at the end.
+ * \param consume_fn: Must not modify the dependency graph, its evaluated data is only valid until
+ * the function returns.
+ *
+ * Frame change handlers are not run. After this, \a graph is evaluated at an arbitrary frame of
+ * the range.
+ */
+void evaluate_frames(Depsgraph *graph,
+                     int start_frame,
+                     int end_frame,
+                     int graphs_num,
+                     FunctionRef<Depsgraph *()> create_graph_fn,
+                     FunctionRef<void(Depsgraph *graph, int frame)> consume_fn);
+
+/** The number of dependency graphs that is useful for evaluating the given number of frames. */
+int graphs_num_for_frames(int64_t frames_num);
+
+}  // namespace blender::deg::multi_frame
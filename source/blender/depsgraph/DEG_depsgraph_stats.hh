@@ -0,0 +1,73 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Timings of the operations of the last evaluations of a dependency graph, for pipeline tools and
+ * performance tests that track the cost of rigs and node setups. Unlike the timing debug output,
+ * the statistics are gathered per dependency graph and only when requested.
+ */
+
+#include <string>
+
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+struct Depsgraph;
+
+namespace blender::deg {
+
+struct EvaluationStatsOperation {
+  /** Name of the original ID, including the two character ID type prefix. */
+  std::string id_name;
+  std::string component;
+  std::string component_name;
+  std::string operation;
+  std::string operation_name;
+  /** Evaluation time in seconds. */
+  double time;
+  /**
+   * Change of the memory in use while the operation was evaluated, in bytes. Allocations done by
+   * operations evaluated at the same time on other threads are included as well.
+   */
+  int64_t memory_delta;
+  /** Index of the thread that evaluated the operation. */
+  int thread;
+};
+
+struct EvaluationStatsID {
+  std::string id_name;
+  /** Sum of the time and memory change of the evaluated operations of the ID. */
+  double time;
+  int64_t memory_delta;
+};
+
+struct EvaluationStats {
+  /** The value of #DEG_get_update_count for this evaluation. */
+  uint64_t update_count;
+  float frame;
+  /** Wall time of the whole evaluation in seconds. */
+  double time;
+  /** Only IDs and operations which were evaluated are included. */
+  Vector<EvaluationStatsID> ids;
+  Vector<EvaluationStatsOperation> operations;
+};
+
+}  // namespace blender::deg
+
+/**
+ * Gather statistics of the following evaluations of the dependency graph, keeping the statistics
+ * of the last \a history_size evaluations.
+ */
+void DEG_evaluation_stats_enable(Depsgraph *depsgraph, int history_size);
+/** Stop gathering statistics and free the gathered ones. */
+void DEG_evaluation_stats_disable(Depsgraph *depsgraph);
+bool DEG_evaluation_stats_is_enabled(const Depsgraph *depsgraph);
+
+/** Statistics of the last evaluations, the oldest one first. */
+blender::Span<blender::deg::EvaluationStats> DEG_evaluation_stats_history(
+    const Depsgraph *depsgraph);
@@ -375,6 +375,16 @@ ID *DepsgraphNodeBuilder::ensure_cow_id(ID *id_orig)
 
 /* **** Build functions for entity nodes **** */
 
+static uint64_t operation_eval_cost_key(const OperationNode *op_node)
+{
+  const ComponentNode *comp_node = op_node->owner;
+  return get_default_hash(
+      get_default_hash(comp_node->owner->id_orig_session_uid,
+                       int(comp_node->type),
+                       StringRef(comp_node->name)),
+      get_default_hash(int(op_node->opcode), StringRef(op_node->name), op_node->name_tag));
+}
+
 void DepsgraphNodeBuilder::begin_build()
 {
   /* Store existing evaluated versions of datablock, so we can re-use
@@ -412,6 +422,12 @@ void DepsgraphNodeBuilder::begin_build()
     }
   }
 
+  for (const OperationNode *op_node : graph_->operations) {
+    if (op_node->eval_cost > 0.0f) {
+      saved_eval_costs_.add(operation_eval_cost_key(op_node), op_node->eval_cost);
+    }
+  }
+
   /* Make sure graph has no nodes left from previous state. */
   graph_->clear_all_nodes();
   graph_->operations.clear();
@@ -555,10 +571,21 @@ void DepsgraphNodeBuilder::tag_previously_tagged_nodes()
   }
 }
 
+void DepsgraphNodeBuilder::restore_eval_costs()
+{
+  if (saved_eval_costs_.is_empty()) {
+    return;
+  }
+  for (OperationNode *op_node : graph_->operations) {
+    op_node->eval_cost = saved_eval_costs_.lookup_default(operation_eval_cost_key(op_node), 0.0f);
+  }
+}
+
 void DepsgraphNodeBuilder::end_build()
 {
   graph_->light_linking_cache.end_build(*graph_->scene);
   tag_previously_tagged_nodes();
+  restore_eval_costs();
   update_invalid_cow_pointers();
 }
 
@@ -297,6 +297,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
    * Stored before the graph is re-created so that they can be transferred over. */
   Vector<PersistentOperationKey> saved_entry_tags_;
   Vector<PersistentOperationKey> needs_update_operations_;
+  /* Evaluation cost estimates of the operations of the previous dependency graph, so that the
+   * evaluation scheduling does not have to learn them again after every relations update. The
+   * hash of the operation identifiers is used as key to keep this cheap, a collision only affects
+   * the evaluation order. */
+  Map<uint64_t, float> saved_eval_costs_;
 
   struct BuilderWalkUserData {
     DepsgraphNodeBuilder *builder;
@@ -311,6 +316,7 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
                               void *user_data);
 
   void tag_previously_tagged_nodes();
+  void restore_eval_costs();
   /**
    * Check for IDs that need to be flushed (copy-on-eval-updated)
    * because the depsgraph itself created or removed some of their evaluated dependencies.
@@ -25,6 +25,7 @@
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_debug.hh"
+#include "DEG_depsgraph_stats.hh"
 
 #include "intern/depsgraph_physics.hh"
 #include "intern/depsgraph_registry.hh"
@@ -60,6 +61,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       use_visibility_optimization(true),
+      evaluation_stats_history_size(0),
       is_evaluating(false),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false),
@@ -203,9 +205,11 @@ Relation *Depsgraph::check_nodes_connected(const Node *from,
                                            const Node *to,
                                            const char *description)
 {
-  for (Relation *rel : from->outlinks) {
-    BLI_assert(rel->from == from);
-    if (rel->to != to) {
+  /* Search only the shorter list of relations, the time source and some other nodes have many
+   * out-links, while most nodes only have a few in-links. */
+  const bool use_inlinks = to->inlinks.size() < from->outlinks.size();
+  for (Relation *rel : use_inlinks ? to->inlinks : from->outlinks) {
+    if (rel->to != to || rel->from != from) {
       continue;
     }
     if (description != nullptr && !STREQ(rel->name, description)) {
@@ -346,6 +350,35 @@ void DEG_disable_visibility_optimization(Depsgraph *depsgraph)
   deg_graph->use_visibility_optimization = false;
 }
 
+void DEG_evaluation_stats_enable(Depsgraph *depsgraph, const int history_size)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  deg_graph->evaluation_stats_history_size = std::max(history_size, 1);
+  while (deg_graph->evaluation_stats_history.size() > deg_graph->evaluation_stats_history_size) {
+    deg_graph->evaluation_stats_history.remove(0);
+  }
+}
+
+void DEG_evaluation_stats_disable(Depsgraph *depsgraph)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  deg_graph->evaluation_stats_history_size = 0;
+  deg_graph->evaluation_stats_history.clear_and_shrink();
+}
+
+bool DEG_evaluation_stats_is_enabled(const Depsgraph *depsgraph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  return deg_graph->evaluation_stats_history_size > 0;
+}
+
+blender::Span<blender::deg::EvaluationStats> DEG_evaluation_stats_history(
+    const Depsgraph *depsgraph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  return deg_graph->evaluation_stats_history;
+}
+
 uint64_t DEG_get_update_count(const Depsgraph *depsgraph)
 {
   const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
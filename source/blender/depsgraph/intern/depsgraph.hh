@@ -26,6 +26,7 @@
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_physics.hh"
+#include "DEG_depsgraph_stats.hh"
 
 #include "intern/debug/deg_debug.h"
 #include "intern/depsgraph_light_linking.hh"
@@ -154,6 +155,12 @@ struct Depsgraph {
   /* Optimize out evaluation of operations which affect hidden objects or disabled modifiers. */
   bool use_visibility_optimization;
 
+  /* Number of evaluations to keep statistics for, zero when statistics are not gathered.
+   * See #DEG_evaluation_stats_enable. */
+  int evaluation_stats_history_size;
+  /* Statistics of the last evaluations, the oldest one first. */
+  Vector<EvaluationStats> evaluation_stats_history;
+
   DepsgraphDebug debug;
 
   bool is_evaluating;
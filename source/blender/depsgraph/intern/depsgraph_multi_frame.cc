@@ -0,0 +1,126 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "BLI_array.hh"
+#include "BLI_threads.h"
+
+#include "BKE_global.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_multi_frame.hh"
+
+#ifdef WITH_PYTHON
+#  include "BPY_extern.h"
+#endif
+
+namespace blender::deg::multi_frame {
+
+/** Every graph keeps evaluated data of its own, so the memory usage grows with the number. */
+static constexpr int max_graphs_num = 8;
+
+int graphs_num_for_frames(const int64_t frames_num)
+{
+  if (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) {
+    return 1;
+  }
+  return int(std::min<int64_t>({BLI_system_thread_count(), frames_num, max_graphs_num}));
+}
+
+/** Evaluation state of one of the graphs, protected by the mutex of the evaluation. */
+struct GraphSlot {
+  Depsgraph *graph = nullptr;
+  /** Index in the frame range of the last frame that has been evaluated. */
+  int64_t evaluated_index = -1;
+  /** Index in the frame range of the last frame that has been consumed. */
+  int64_t consumed_index = -1;
+};
+
+void evaluate_frames(Depsgraph *graph,
+                     const int start_frame,
+                     const int end_frame,
+                     const int graphs_num,
+                     const FunctionRef<Depsgraph *()> create_graph_fn,
+                     const FunctionRef<void(Depsgraph *graph, int frame)> consume_fn)
+{
+  BLI_assert(!DEG_is_active(graph));
+  const int frames_num = end_frame - start_frame + 1;
+  if (graphs_num < 2 || frames_num < 2) {
+    for (int frame = start_frame; frame <= end_frame; frame++) {
+      DEG_evaluate_on_framechange(graph, float(frame));
+      consume_fn(graph, frame);
+    }
+    return;
+  }
+
+  Array<GraphSlot> slots(std::min(graphs_num, frames_num));
+  slots[0].graph = graph;
+  for (GraphSlot &slot : slots.as_mutable_span().drop_front(1)) {
+    slot.graph = create_graph_fn();
+    BLI_assert(!DEG_is_active(slot.graph));
+  }
+  const int64_t slots_num = slots.size();
+
+  std::mutex mutex;
+  std::condition_variable cond;
+
+  /* Every graph evaluates every n-th frame on its own thread, but only after the consumer is done
+   * with the previous frame of the same graph, since that overwrites the evaluated data. */
+  Array<std::thread> threads(slots_num);
+  for (const int64_t slot_index : slots.index_range()) {
+    threads[slot_index] = std::thread([&, slot_index]() {
+      GraphSlot &slot = slots[slot_index];
+      for (int64_t i = slot_index; i < frames_num; i += slots_num) {
+        {
+          std::unique_lock lock{mutex};
+          cond.wait(lock, [&]() { return slot.consumed_index == i - slots_num; });
+        }
+        DEG_evaluate_on_framechange(slot.graph, float(start_frame + i));
+        {
+          std::lock_guard lock{mutex};
+          slot.evaluated_index = i;
+        }
+        cond.notify_all();
+      }
+    });
+  }
+
+  for (int64_t i = 0; i < frames_num; i++) {
+    GraphSlot &slot = slots[i % slots_num];
+    /* Python drivers are evaluated on the other threads, they need the GIL. */
+#ifdef WITH_PYTHON
+    BPy_BEGIN_ALLOW_THREADS;
+#endif
+    {
+      std::unique_lock lock{mutex};
+      cond.wait(lock, [&]() { return slot.evaluated_index == i; });
+    }
+#ifdef WITH_PYTHON
+    BPy_END_ALLOW_THREADS;
+#endif
+    consume_fn(slot.graph, int(start_frame + i));
+    {
+      std::lock_guard lock{mutex};
+      slot.consumed_index = i;
+    }
+    cond.notify_all();
+  }
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (GraphSlot &slot : slots.as_mutable_span().drop_front(1)) {
+    DEG_graph_free(slot.graph);
+  }
+}
+
+}  // namespace blender::deg::multi_frame
@@ -10,12 +10,21 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "MEM_guardedalloc.h"
+
 #include "BLI_compiler_attrs.h"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 
@@ -83,22 +92,45 @@ struct DepsgraphEvalState {
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+  /* Set when the evaluation cost of an operation changed enough to affect the scheduling order of
+   * the next evaluation. */
+  std::atomic<bool> need_update_critical_path = false;
 };
 
-void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
+/* Store the measured evaluation time of an operation, used to prioritize operations on the
+ * critical path. Small changes are ignored, to avoid updating the critical path of the whole
+ * graph for every interactive update. */
+void update_node_eval_cost(DepsgraphEvalState *state,
+                           OperationNode *operation_node,
+                           const double eval_time)
+{
+  const float old_cost = operation_node->eval_cost;
+  const float new_cost = (old_cost == 0.0f) ? float(eval_time) :
+                                              old_cost * 0.75f + float(eval_time) * 0.25f;
+  operation_node->eval_cost = new_cost;
+  /* Changes of less than 10 microseconds should not matter for the scheduling. */
+  if (std::abs(new_cost - old_cost) > std::max(1e-5f, old_cost * 0.25f)) {
+    state->need_update_critical_path.store(true, std::memory_order_relaxed);
+  }
+}
+
+void evaluate_node(DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
+  const size_t memory_before = state->do_stats ? MEM_get_memory_in_use() : 0;
+  const double start_time = BLI_time_now_seconds();
+  operation_node->evaluate(depsgraph);
+  const double eval_time = BLI_time_now_seconds() - start_time;
+  update_node_eval_cost(state, operation_node, eval_time);
   if (state->do_stats) {
-    const double start_time = BLI_time_now_seconds();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
-  }
-  else {
-    operation_node->evaluate(depsgraph);
+    operation_node->stats.current_time += eval_time;
+    operation_node->stats.current_memory_delta += int64_t(MEM_get_memory_in_use()) -
+                                                  int64_t(memory_before);
+    operation_node->stats.current_thread = BLI_task_parallel_thread_id(nullptr);
   }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
@@ -113,14 +145,26 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    /* Schedule children. The child with the most expensive chain of operations depending on it is
+     * evaluated by this task right away, the others are pushed to the pool. */
+    OperationNode *next_node = nullptr;
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      if (next_node == nullptr) {
+        next_node = node;
+        return;
+      }
+      if (node->critical_path_cost > next_node->critical_path_cost) {
+        std::swap(node, next_node);
+      }
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    });
+    operation_node = next_node;
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -317,12 +361,58 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
+  /* Push the operations that are ready first in the order of their critical path cost, so that
+   * the start of long chains of operations is not delayed by cheap unrelated operations. */
+  Vector<OperationNode *> ready_nodes;
+  schedule_graph(state, [&](OperationNode *node) { ready_nodes.append(node); });
+  std::stable_sort(ready_nodes.begin(),
+                   ready_nodes.end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->critical_path_cost > b->critical_path_cost;
+                   });
+  for (OperationNode *node : ready_nodes) {
     BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  }
   BLI_task_pool_work_and_wait(task_pool);
 }
 
+/* Evaluate the copy-on-evaluation operations in bulk.
+ *
+ * After loading a file or switching view layers, thousands of IDs are copied. Pushing a separate
+ * task for every one of them has a significant overhead on the thread doing the scheduling, so
+ * all operations that are ready are evaluated with a parallel loop instead. The copy-on-eval
+ * operations hardly depend on each other, so there are only a few waves. */
+void evaluate_graph_copy_on_eval_stage(DepsgraphEvalState *state, TaskPool *task_pool)
+{
+  if (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) {
+    evaluate_graph_threaded_stage(state, task_pool, EvaluationStage::COPY_ON_EVAL);
+    return;
+  }
+
+  state->stage = EvaluationStage::COPY_ON_EVAL;
+
+  calculate_pending_parents_if_needed(state);
+
+  Vector<OperationNode *> ready_nodes;
+  schedule_graph(state, [&](OperationNode *node) { ready_nodes.append(node); });
+  while (!ready_nodes.is_empty()) {
+    threading::EnumerableThreadSpecific<Vector<OperationNode *>> next_nodes;
+    threading::parallel_for(ready_nodes.index_range(), 1, [&](const IndexRange range) {
+      Vector<OperationNode *> &local_next_nodes = next_nodes.local();
+      for (OperationNode *operation_node : ready_nodes.as_span().slice(range)) {
+        evaluate_node(state, operation_node);
+        schedule_children(state, operation_node, [&](OperationNode *node) {
+          local_next_nodes.append(node);
+        });
+      }
+    });
+    ready_nodes.clear();
+    for (Vector<OperationNode *> &local_next_nodes : next_nodes) {
+      ready_nodes.extend(local_next_nodes);
+    }
+  }
+}
+
 /* Evaluate remaining operations of the dependency graph in a single threaded manner. */
 void evaluate_graph_single_threaded_if_needed(DepsgraphEvalState *state)
 {
@@ -401,7 +491,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
-  state.do_stats = graph->debug.do_time_debug();
+  state.do_stats = graph->debug.do_time_debug() || graph->evaluation_stats_history_size > 0;
+  const double start_time = BLI_time_now_seconds();
+  threading::trace::TraceTag trace_tag("Depsgraph");
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -425,7 +517,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
 
-  evaluate_graph_threaded_stage(&state, task_pool, EvaluationStage::COPY_ON_EVAL);
+  evaluate_graph_copy_on_eval_stage(&state, task_pool);
 
   if (graph->has_animated_visibility || graph->need_update_nodes_visibility) {
     /* Update pending parents including only the ones which are affecting operations which are
@@ -456,6 +548,12 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (graph->evaluation_stats_history_size > 0) {
+    deg_eval_stats_record(graph, BLI_time_now_seconds() - start_time);
+  }
+  if (state.need_update_critical_path.load(std::memory_order_relaxed)) {
+    deg_eval_stats_update_critical_path(graph);
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
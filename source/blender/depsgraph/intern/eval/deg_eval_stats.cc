@@ -8,9 +8,14 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <algorithm>
+
+#include "BLI_set.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
 
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -36,6 +41,100 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
     IDNode *id_node = comp_node->owner;
     id_node->stats.current_time += op_node->stats.current_time;
     comp_node->stats.current_time += op_node->stats.current_time;
+    id_node->stats.current_memory_delta += op_node->stats.current_memory_delta;
+    comp_node->stats.current_memory_delta += op_node->stats.current_memory_delta;
+  }
+}
+
+void deg_eval_stats_record(Depsgraph *graph, const double eval_time)
+{
+  EvaluationStats stats;
+  stats.update_count = graph->update_count;
+  stats.frame = graph->frame;
+  stats.time = eval_time;
+
+  Set<const IDNode *> evaluated_id_nodes;
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->stats.current_thread == -1) {
+      continue;
+    }
+    const ComponentNode *comp_node = op_node->owner;
+    const IDNode *id_node = comp_node->owner;
+    EvaluationStatsOperation op_stats;
+    op_stats.id_name = id_node->id_orig->name;
+    op_stats.component = nodeTypeAsString(comp_node->type);
+    op_stats.component_name = comp_node->name;
+    op_stats.operation = operationCodeAsString(op_node->opcode);
+    op_stats.operation_name = op_node->name;
+    op_stats.time = op_node->stats.current_time;
+    op_stats.memory_delta = op_node->stats.current_memory_delta;
+    op_stats.thread = op_node->stats.current_thread;
+    stats.operations.append(std::move(op_stats));
+    evaluated_id_nodes.add(id_node);
+  }
+  /* Keep the order of the IDs in the graph, so that the result is stable. */
+  for (const IDNode *id_node : graph->id_nodes) {
+    if (evaluated_id_nodes.contains(id_node)) {
+      stats.ids.append({id_node->id_orig->name,
+                        id_node->stats.current_time,
+                        id_node->stats.current_memory_delta});
+    }
+  }
+
+  Vector<EvaluationStats> &history = graph->evaluation_stats_history;
+  if (history.size() >= graph->evaluation_stats_history_size) {
+    history.remove(0, history.size() - graph->evaluation_stats_history_size + 1);
+  }
+  history.append(std::move(stats));
+}
+
+void deg_eval_stats_update_critical_path(Depsgraph *graph)
+{
+  enum {
+    OP_UNVISITED = 0,
+    OP_VISITING = 1,
+    OP_VISITED = 2,
+  };
+  for (OperationNode *op_node : graph->operations) {
+    op_node->custom_flags = OP_UNVISITED;
+  }
+
+  /* Depth first traversal along the non-cyclic relations, computing the cost of an operation
+   * after the costs of all operations depending on it are known. An explicit stack is used since
+   * chains can be very long in big files. */
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->custom_flags != OP_UNVISITED) {
+      continue;
+    }
+    root->custom_flags = OP_VISITING;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      auto &[op_node, next_link] = stack.last();
+      if (next_link < op_node->outlinks.size()) {
+        const Relation *rel = op_node->outlinks[next_link++];
+        if (rel->flag & RELATION_FLAG_CYCLIC) {
+          continue;
+        }
+        OperationNode *child = static_cast<OperationNode *>(rel->to);
+        if (child->custom_flags == OP_UNVISITED) {
+          child->custom_flags = OP_VISITING;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      float children_cost = 0.0f;
+      for (const Relation *rel : op_node->outlinks) {
+        const OperationNode *child = static_cast<const OperationNode *>(rel->to);
+        /* Relations closing a cycle that was not detected are ignored as well. */
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && child->custom_flags == OP_VISITED) {
+          children_cost = std::max(children_cost, child->critical_path_cost);
+        }
+      }
+      op_node->critical_path_cost = op_node->eval_cost + children_cost;
+      op_node->custom_flags = OP_VISITED;
+      stack.remove_last();
+    }
   }
 }
 
@@ -15,4 +15,11 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Add the statistics of the evaluation that just finished to the history of the graph, see
+ * #DEG_evaluation_stats_enable. Expects the statistics to be aggregated already. */
+void deg_eval_stats_record(Depsgraph *graph, double eval_time);
+
+/* Update the critical path cost of all operations from the evaluation costs measured so far. */
+void deg_eval_stats_update_critical_path(Depsgraph *graph);
+
 }  // namespace blender::deg
@@ -168,6 +168,11 @@ struct Node {
     void reset_current();
     /* Time spent on this node during current graph evaluation. */
     double current_time;
+    /* Change of the memory in use while evaluating this node during current graph evaluation. */
+    int64_t current_memory_delta;
+    /* Thread which evaluated this operation during current graph evaluation, -1 when it was not
+     * evaluated. */
+    int current_thread;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
@@ -281,6 +281,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated evaluation time in seconds, smoothed over the previous evaluations. */
+  float eval_cost = 0.0f;
+  /* Estimated time needed to evaluate this operation and the most expensive chain of operations
+   * depending on it. Operations with a higher cost are scheduled first, so that long chains don't
+   * start late. See #deg_eval_stats_update_critical_path. */
+  float critical_path_cost = 0.0f;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -184,6 +184,11 @@ void DRW_cache_free_old_subdiv();
 /* For the OpenGL evaluators and garbage collected subdivision data. */
 void DRW_subdiv_free();
 
+void DRW_cache_free_old_armature_deform();
+
+/* For the armature deformation shaders and garbage collected weight buffers. */
+void DRW_armature_deform_free();
+
 }  // namespace blender::draw
 
 /* Never use this. Only for closing blender. */
@@ -15,6 +15,7 @@
 #include "BLI_set.hh"
 #include "BLI_span.hh"
 #include "BLI_struct_equality_utils.hh"
+#include "BLI_utildefines.h"
 #include "BLI_virtual_array.hh"
 
 #include "DNA_customdata_types.h"
@@ -57,6 +58,22 @@ enum class CustomRequest : int8_t {
 
 using AttributeRequest = std::variant<CustomRequest, GenericRequest>;
 
+/**
+ * The data of a node that changed since its buffers were filled. Buffers of other data are not
+ * filled and uploaded again.
+ */
+enum class DirtyData : uint8_t {
+  None = 0,
+  /** Positions and normals. */
+  Positions = 1 << 0,
+  Mask = 1 << 1,
+  FaceSets = 1 << 2,
+  /** Generic attributes, like color attributes. */
+  Attributes = 1 << 3,
+  All = Positions | Mask | FaceSets | Attributes,
+};
+ENUM_OPERATORS(DirtyData, DirtyData::Attributes);
+
 struct PBVHBatches;
 
 struct PBVH_GPU_Args {
@@ -96,7 +113,7 @@ struct PBVH_GPU_Args {
   int cd_mask_layer;
 };
 
-void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args);
+void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args, DirtyData dirty);
 void update_pre(PBVHBatches *batches, const PBVH_GPU_Args &args);
 
 void node_gpu_flush(PBVHBatches *batches);
@@ -0,0 +1,63 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup draw
+ *
+ * Access to the statistics of the draw manager profiler, which are also displayed in the viewport
+ * when the debug value is between 21 and 29.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "BLI_vector.hh"
+
+namespace blender::draw {
+
+struct ProfilingStats {
+  struct Engine {
+    std::string name;
+    /** CPU times in milliseconds. */
+    double init_time;
+    double sync_time;
+    double render_time;
+  };
+  struct Timing {
+    std::string name;
+    /** Time in milliseconds. */
+    double time;
+  };
+  struct GPUTiming {
+    std::string name;
+    /** Nesting level of the pass, passes of a level are included in the pass above them. */
+    int level;
+    /** Time in milliseconds. */
+    double time;
+  };
+
+  Vector<Engine> engines;
+  /** CPU time filling the caches of all engines, in milliseconds. */
+  double cache_time = 0.0;
+  /** CPU time spent creating the requested batches, per object type. */
+  Vector<Timing> batch_cache_times;
+  /** GPU time of the draw passes, empty when the GPU backend has no timestamp queries. */
+  Vector<GPUTiming> gpu_timings;
+  /** Vertex buffer data uploaded to the GPU during the last redraw, in bytes. */
+  size_t upload_size = 0;
+};
+
+/**
+ * Record the statistics even when they are not displayed in the viewport.
+ */
+void DRW_profiling_enable(bool enable);
+bool DRW_profiling_is_enabled();
+/**
+ * Statistics of the last redraw of a viewport, averaged over a few redraws.
+ * \return False when nothing was recorded yet.
+ */
+bool DRW_profiling_stats_get(ProfilingStats &r_stats);
+
+}  // namespace blender::draw
@@ -63,7 +63,19 @@ struct SELECTID_Context {
 
   /* To check for updates. */
   float persmat[4][4];
-  bool is_dirty(RegionView3D *rv3d);
+  int size[2];
+  float retopology_offset;
+  int overlay_edit_flag;
+  bool use_xray;
+  bool use_clipping;
+
+  /** Store the view state used to draw the buffer, see #is_dirty. */
+  void view_state_store(const ARegion *region, const View3D *v3d);
+  /**
+   * The buffer is kept between selection operators and only redrawn when the view, the region
+   * or the display settings changed, or when one of the objects was moved or its geometry changed.
+   */
+  bool is_dirty(const ARegion *region, const View3D *v3d);
 };
 
 /* `draw_select_buffer.cc` */
@@ -250,7 +250,9 @@ void Film::init(const int2 &extent, const rcti *output_rect)
                 (EEVEE_RENDER_PASS_CRYPTOMATTE_ASSET | EEVEE_RENDER_PASS_CRYPTOMATTE_MATERIAL |
                  EEVEE_RENDER_PASS_CRYPTOMATTE_OBJECT | EEVEE_RENDER_PASS_NORMAL)))
       {
-        data_.scaling_factor = BKE_render_preview_pixel_size(&inst_.scene->r);
+        data_.scaling_factor = math::min(BKE_render_preview_pixel_size(&inst_.scene->r) *
+                                             inst_.sampling.resolution_scaling(),
+                                         8);
       }
     }
     /* Sharpen the LODs (1.5x) to avoid TAA filtering causing over-blur (see #122941). */
@@ -13,6 +13,7 @@
 #include "BKE_global.hh"
 #include "BKE_object.hh"
 #include "BLI_rect.h"
+#include "BLI_time.h"
 #include "DEG_depsgraph_query.hh"
 #include "DNA_ID.h"
 #include "DNA_lightprobe_types.h"
@@ -548,15 +549,24 @@ void Instance::draw_viewport()
     return;
   }
 
-  render_sample();
+  /* Render as many samples as fit in the frame budget. */
+  const int samples_per_redraw = sampling.samples_per_redraw();
+  for (int i = 0; i < samples_per_redraw; i++) {
+    render_sample();
+    if (sampling.finished_viewport()) {
+      break;
+    }
+  }
   velocity.step_swap();
 
   /* Do not request redraw during viewport animation to lock the frame-rate to the animation
    * playback rate. This is in order to preserve motion blur aspect and also to avoid TAA reset
    * that can show flickering. */
-  if (!sampling.finished_viewport() && !DRW_state_is_playback()) {
+  const bool redraw_requested = !sampling.finished_viewport() && !DRW_state_is_playback();
+  if (redraw_requested) {
     DRW_viewport_request_redraw();
   }
+  sampling.frame_end(redraw_requested);
 
   if (materials.queued_shaders_count > 0) {
     std::stringstream ss;
@@ -702,15 +712,22 @@ void Instance::light_bake_irradiance(
     return;
   }
 
+  /* Batch ray casts to avoid too much overhead of the update function, context switch and result
+   * read-back. The batch size is adjusted to the computation time, so that light-weight scenes
+   * do not spend most of the time updating while heavy scenes still report progress. */
+  constexpr double batch_duration_target = 0.25;
+  constexpr int batch_size_max = 1024;
+  int batch_size = 16;
+
   sampling.init(probe);
   while (!sampling.finished()) {
+    const double batch_start = BLI_time_now_seconds();
+    int batch_sample_count = 0;
+
     context_wrapper([&]() {
       DebugScope debug_scope(debug_scope_irradiance_sample, "EEVEE.irradiance_sample");
 
-      /* Batch ray cast by pack of 16. Avoids too much overhead of the update function & context
-       * switch. */
-      /* TODO(fclem): Could make the number of iteration depend on the computation time. */
-      for (int i = 0; i < 16 && !sampling.finished(); i++) {
+      for (; batch_sample_count < batch_size && !sampling.finished(); batch_sample_count++) {
         sampling.step();
 
         volume_probes.bake.raylists_build();
@@ -734,6 +751,16 @@ void Instance::light_bake_irradiance(
     if (stop()) {
       return;
     }
+
+    /* The result read-back waits for the GPU, so this includes the GPU time of the batch. */
+    const double batch_duration = BLI_time_now_seconds() - batch_start;
+    if (batch_sample_count == batch_size && batch_duration > 0.0) {
+      const double sample_duration = batch_duration / batch_sample_count;
+      /* Grow at most twice per batch to stay responsive if the estimate is too optimistic. */
+      batch_size = math::clamp(int(batch_duration_target / sample_duration),
+                               1,
+                               math::min(batch_size * 2, batch_size_max));
+    }
   }
 }
 
@@ -792,7 +792,11 @@ GPUTexture *DeferredLayer::render(View &main_view,
   inst_.shadows.set_view(render_view, extent);
 
   inst_.gbuffer.bind(gbuffer_fb);
+  /* The HiZ buffer now contains the prepass depth. Surfaces entirely behind it would be rejected
+   * by the depth test anyway, cull them before they reach the vertex stage. */
+  render_view.occlusion_test(inst_.hiz_buffer.front.ref_tx_, inst_.uniform_data.data.hiz.uv_scale);
   inst_.manager->submit(gbuffer_ps_, render_view);
+  render_view.occlusion_test(nullptr);
 
   for (int i = 0; i < ARRAY_SIZE(direct_radiance_txs_); i++) {
     direct_radiance_txs_[i].acquire(
@@ -11,6 +11,7 @@
 #include "BKE_colortools.hh"
 
 #include "BLI_rand.h"
+#include "BLI_time.h"
 
 #include "BLI_math_base.hh"
 #include "BLI_math_base_safe.h"
@@ -68,6 +69,60 @@ void Sampling::init(const Scene *scene)
   clamp_data_.surface_indirect = clamp_value_load(scene->eevee.clamp_surface_indirect);
   clamp_data_.volume_direct = clamp_value_load(scene->eevee.clamp_volume_direct);
   clamp_data_.volume_indirect = clamp_value_load(scene->eevee.clamp_volume_indirect);
+
+  if (inst_.is_viewport()) {
+    frame_budget_ = inst_.is_viewport_image_render() ? 0.0 : scene->eevee.viewport_frame_budget;
+    frame_budget_update();
+  }
+}
+
+void Sampling::frame_budget_update()
+{
+  const double time = BLI_time_now_seconds();
+  const double frame_time = time - frame_start_time_;
+  const int frame_sample_count = frame_sample_count_;
+  frame_start_time_ = time;
+  frame_sample_count_ = 0;
+
+  const bool is_navigating = inst_.is_navigating();
+  /* The time since the previous redraw only measures its duration if no idle time was spent in
+   * between. This is the case if it requested another redraw, or if both happened during the same
+   * navigation, which sends events continuously. */
+  const bool is_continuous = frame_redraw_requested_ || (is_navigating && frame_was_navigating_);
+  frame_was_navigating_ = is_navigating;
+
+  if (frame_budget_ <= 0.0) {
+    samples_per_redraw_ = 1;
+    navigation_scaling_ = 1;
+    return;
+  }
+
+  if (!is_navigating) {
+    /* Converge to the full resolution as soon as the view is static. */
+    navigation_scaling_ = 1;
+  }
+
+  if (!is_continuous) {
+    return;
+  }
+
+  if (is_navigating) {
+    samples_per_redraw_ = 1;
+    if (frame_time > frame_budget_) {
+      navigation_scaling_ = math::min(navigation_scaling_ * 2, navigation_scaling_max_);
+    }
+    else if (frame_time * 4.0 < frame_budget_) {
+      /* Halving the divider renders four times as many pixels. */
+      navigation_scaling_ = math::max(navigation_scaling_ / 2, 1);
+    }
+  }
+  else if (frame_sample_count > 0) {
+    /* The redraw time includes the object sync and the overlays, so this slightly underestimates
+     * the number of samples fitting the budget. */
+    const double sample_time = frame_time / frame_sample_count;
+    samples_per_redraw_ = math::clamp(
+        int(frame_budget_ / sample_time), 1, samples_per_redraw_max_);
+  }
 }
 
 void Sampling::init(const Object &probe_object)
@@ -207,6 +262,7 @@ void Sampling::step()
 
   viewport_sample_++;
   sample_++;
+  frame_sample_count_++;
 
   reset_ = false;
 }
@@ -63,10 +63,35 @@ class Sampling {
    */
   static constexpr int interactive_mode_threshold = 3;
 
+  /* Limits of the viewport frame budget adjustments. */
+  static constexpr int samples_per_redraw_max_ = 16;
+  static constexpr int navigation_scaling_max_ = 4;
+
+  /** Viewport Only: Target duration of a redraw in seconds. Zero if disabled. */
+  double frame_budget_ = 0.0;
+  /** Viewport Only: Start time of the previous redraw. */
+  double frame_start_time_ = 0.0;
+  /** Viewport Only: Number of samples rendered since the start of the previous redraw. */
+  int frame_sample_count_ = 0;
+  /** Viewport Only: True if the previous redraw requested to be directly followed by another. */
+  bool frame_redraw_requested_ = false;
+  /** Viewport Only: True if the previous redraw happened during navigation. */
+  bool frame_was_navigating_ = false;
+  /** Viewport Only: Number of samples to render per redraw to fill the frame budget. */
+  int samples_per_redraw_ = 1;
+  /** Viewport Only: Resolution divider applied during navigation to stay within the budget. */
+  int navigation_scaling_ = 1;
+
   SamplingDataBuf data_;
 
   ClampData &clamp_data_;
 
+  /**
+   * Adjust the number of samples per redraw and the navigation resolution using the duration of
+   * the previous redraw, so that the next one fits the frame budget.
+   */
+  void frame_budget_update();
+
  public:
   Sampling(Instance &inst, ClampData &clamp_data) : inst_(inst), clamp_data_(clamp_data){};
   ~Sampling(){};
@@ -89,6 +114,25 @@ class Sampling {
     return reset_;
   }
 
+  /* Viewport Only: Function to call at the end of a redraw. \a redraw_requested should be true
+   * if another redraw was requested to directly follow this one. */
+  void frame_end(bool redraw_requested)
+  {
+    frame_redraw_requested_ = redraw_requested;
+  }
+
+  /* Viewport Only: Number of samples to render in this redraw to fill the frame budget. */
+  int samples_per_redraw() const
+  {
+    return interactive_mode_ ? 1 : samples_per_redraw_;
+  }
+
+  /* Viewport Only: Resolution divider to apply on top of the preview pixel size. */
+  int resolution_scaling() const
+  {
+    return navigation_scaling_;
+  }
+
   template<typename PassType> void bind_resources(PassType &pass)
   {
     pass.bind_ssbo(SAMPLING_BUF_SLOT, &data_);
@@ -9,6 +9,7 @@
  */
 
 #include "BKE_global.hh"
+#include "BKE_material.h"
 #include "BLI_math_matrix.hh"
 
 #include "eevee_instance.hh"
@@ -731,11 +732,27 @@ void ShadowModule::begin_sync()
   }
 }
 
+/** Hash of the material settings which change the shadow of any caster, like face culling. */
+static uint64_t material_shadow_hash_get(const Object *ob)
+{
+  uint64_t hash = 0;
+  const int materials_num = BKE_object_material_count_eval(ob);
+  for (const int i : IndexRange(materials_num)) {
+    const ::Material *material = BKE_object_material_get_eval(const_cast<Object *>(ob), i + 1);
+    const int shadow_flag = (material != nullptr) ?
+                                (material->blend_flag & MA_BL_CULL_BACKFACE_SHADOW) :
+                                0;
+    hash = get_default_hash(hash, shadow_flag);
+  }
+  return hash;
+}
+
 void ShadowModule::sync_object(const Object *ob,
                                const ObjectHandle &handle,
                                const ResourceHandle &resource_handle,
                                bool is_alpha_blend,
-                               bool has_transparent_shadows)
+                               bool has_transparent_shadows,
+                               bool has_displacement)
 {
   bool is_shadow_caster = !(ob->visibility_flag & OB_HIDE_SHADOW);
   if (!is_shadow_caster && !is_alpha_blend) {
@@ -746,8 +763,29 @@ void ShadowModule::sync_object(const Object *ob,
   shadow_ob.used = true;
   const bool is_initialized = shadow_ob.resource_handle.raw != 0;
   const bool has_jittered_transparency = has_transparent_shadows && data_.use_jitter;
-  if (is_shadow_caster && (handle.recalc || !is_initialized || has_jittered_transparency)) {
-    if (handle.recalc && is_initialized) {
+
+  /* Most material edits (e.g. colors or roughness) do not change the shadow. Only re-render the
+   * caster if its materials change its shadow now or did in the previous sync, or if a material
+   * setting that changes the shadow of every caster changed. This keeps the cached pages of
+   * static casters valid while editing their materials. */
+  const bool depends_on_material = is_alpha_blend || has_transparent_shadows || has_displacement;
+  int recalc = handle.recalc;
+  if (recalc & ID_RECALC_SHADING) {
+    const uint64_t material_shadow_hash = material_shadow_hash_get(ob);
+    if (!depends_on_material && !shadow_ob.depends_on_material &&
+        material_shadow_hash == shadow_ob.material_shadow_hash)
+    {
+      recalc &= ~ID_RECALC_SHADING;
+    }
+    shadow_ob.material_shadow_hash = material_shadow_hash;
+  }
+  else if (!is_initialized) {
+    shadow_ob.material_shadow_hash = material_shadow_hash_get(ob);
+  }
+  shadow_ob.depends_on_material = depends_on_material;
+
+  if (is_shadow_caster && (recalc || !is_initialized || has_jittered_transparency)) {
+    if (recalc && is_initialized) {
       past_casters_updated_.append(shadow_ob.resource_handle.raw);
     }
 
@@ -166,6 +166,10 @@ struct ShadowTileMapPool {
 struct ShadowObject {
   ResourceHandle resource_handle = {0};
   bool used = true;
+  /** True if the materials of the object changed its shadow during the last sync. */
+  bool depends_on_material = false;
+  /** Hash of the material settings that change the shadow of any caster, see #sync_object. */
+  uint64_t material_shadow_hash = 0;
 };
 
 /** \} */
@@ -326,7 +330,8 @@ class ShadowModule {
                    const ObjectHandle &handle,
                    const ResourceHandle &resource_handle,
                    bool is_alpha_blend,
-                   bool has_transparent_shadows);
+                   bool has_transparent_shadows,
+                   bool has_displacement);
   void end_sync();
 
   void set_lights_data();
@@ -124,6 +124,7 @@ void SyncModule::sync_mesh(Object *ob,
 
   bool is_alpha_blend = false;
   bool has_transparent_shadows = false;
+  bool has_displacement = false;
   float inflate_bounds = 0.0f;
   for (auto i : material_array.gpu_materials.index_range()) {
     gpu::Batch *geom = mat_geom[i];
@@ -162,6 +163,7 @@ void SyncModule::sync_mesh(Object *ob,
     inst_.cryptomatte.sync_material(mat);
 
     if (GPU_material_has_displacement_output(gpu_material)) {
+      has_displacement = true;
       inflate_bounds = math::max(inflate_bounds, mat->inflate_bounds);
     }
   }
@@ -172,7 +174,8 @@ void SyncModule::sync_mesh(Object *ob,
 
   inst_.manager->extract_object_attributes(res_handle, ob_ref, material_array.gpu_materials);
 
-  inst_.shadows.sync_object(ob, ob_handle, res_handle, is_alpha_blend, has_transparent_shadows);
+  inst_.shadows.sync_object(
+      ob, ob_handle, res_handle, is_alpha_blend, has_transparent_shadows, has_displacement);
   inst_.cryptomatte.sync_object(ob, res_handle);
 }
 
@@ -195,6 +198,7 @@ bool SyncModule::sync_sculpt(Object *ob,
 
   bool is_alpha_blend = false;
   bool has_transparent_shadows = false;
+  bool has_displacement = false;
   float inflate_bounds = 0.0f;
   for (SculptBatch &batch :
        sculpt_batches_per_material_get(ob_ref.object, material_array.gpu_materials))
@@ -235,6 +239,7 @@ bool SyncModule::sync_sculpt(Object *ob,
     inst_.cryptomatte.sync_material(mat);
 
     if (GPU_material_has_displacement_output(gpu_material)) {
+      has_displacement = true;
       inflate_bounds = math::max(inflate_bounds, mat->inflate_bounds);
     }
   }
@@ -248,7 +253,8 @@ bool SyncModule::sync_sculpt(Object *ob,
 
   inst_.manager->extract_object_attributes(res_handle, ob_ref, material_array.gpu_materials);
 
-  inst_.shadows.sync_object(ob, ob_handle, res_handle, is_alpha_blend, has_transparent_shadows);
+  inst_.shadows.sync_object(
+      ob, ob_handle, res_handle, is_alpha_blend, has_transparent_shadows, has_displacement);
   inst_.cryptomatte.sync_object(ob, res_handle);
 
   return true;
@@ -318,7 +324,8 @@ void SyncModule::sync_point_cloud(Object *ob,
                             ob_handle,
                             res_handle,
                             material.is_alpha_blend_transparent,
-                            material.has_transparent_shadows);
+                            material.has_transparent_shadows,
+                            GPU_material_has_displacement_output(gpu_material));
 }
 
 /** \} */
@@ -501,7 +508,9 @@ void SyncModule::sync_gpencil(Object *ob, ObjectHandle &ob_handle, ResourceHandl
 
   bool is_alpha_blend = true;          /* TODO material.is_alpha_blend. */
   bool has_transparent_shadows = true; /* TODO material.has_transparent_shadows. */
-  inst_.shadows.sync_object(ob, ob_handle, res_handle, is_alpha_blend, has_transparent_shadows);
+  bool has_displacement = false;       /* TODO material.has_displacement. */
+  inst_.shadows.sync_object(
+      ob, ob_handle, res_handle, is_alpha_blend, has_transparent_shadows, has_displacement);
 }
 
 /** \} */
@@ -582,7 +591,8 @@ void SyncModule::sync_curves(Object *ob,
                             ob_handle,
                             res_handle,
                             material.is_alpha_blend_transparent,
-                            material.has_transparent_shadows);
+                            material.has_transparent_shadows,
+                            GPU_material_has_displacement_output(gpu_material));
 }
 
 /** \} */
@@ -10,11 +10,13 @@
 #include "DRW_render.hh"
 
 #include "ED_gpencil_legacy.hh"
+#include "ED_grease_pencil.hh"
 #include "ED_view3d.hh"
 
 #include "DNA_gpencil_legacy_types.h"
 #include "DNA_view3d_types.h"
 
+#include "BKE_curves.hh"
 #include "BKE_gpencil_geom_legacy.h"
 #include "BKE_gpencil_legacy.h"
 #include "BKE_grease_pencil.hh"
@@ -24,6 +26,7 @@
 #include "BLI_hash.h"
 #include "BLI_link_utils.h"
 #include "BLI_math_color.h"
+#include "BLI_math_geom.h"
 #include "BLI_math_vector.hh"
 #include "BLI_memblock.h"
 
@@ -708,4 +711,130 @@ GPENCIL_tLayer *grease_pencil_layer_cache_add(GPENCIL_PrivateData *pd,
 
   return tgp_layer;
 }
+
+/* Returns true if the opaque fill of the stroke covers the whole view. */
+static bool grease_pencil_stroke_fill_covers_view(const blender::float4x4 &layer_to_ndc,
+                                                  const blender::Span<blender::float3> positions,
+                                                  const blender::Span<blender::uint3> triangles)
+{
+  using namespace blender;
+  Array<float2> ndc_positions(positions.size());
+  for (const int i : positions.index_range()) {
+    const float4 clip_pos = layer_to_ndc * float4(positions[i], 1.0f);
+    if (clip_pos.w <= 0.0f) {
+      /* Behind the view, the projection of the fill is not a polygon anymore. */
+      return false;
+    }
+    ndc_positions[i] = clip_pos.xy() / clip_pos.w;
+  }
+
+  /* The view must not be crossed by the outline of the fill. */
+  const float2 corners[4] = {
+      float2(-1.0f, -1.0f), float2(1.0f, -1.0f), float2(1.0f, 1.0f), float2(-1.0f, 1.0f)};
+  for (const int i : ndc_positions.index_range()) {
+    const float2 &v1 = ndc_positions[i];
+    const float2 &v2 = ndc_positions[(i + 1) % ndc_positions.size()];
+    if (math::reduce_max(math::abs(v1)) <= 1.0f) {
+      return false;
+    }
+    for (const int corner : IndexRange(4)) {
+      if (isect_seg_seg_v2(v1, v2, corners[corner], corners[(corner + 1) % 4])) {
+        return false;
+      }
+    }
+  }
+
+  /* The view is then either completely inside or outside of the fill. Check the corners anyway,
+   * the triangulation of self intersecting outlines does not have to match the outline. */
+  for (const float2 &corner : corners) {
+    bool is_inside = false;
+    for (const uint3 &tri : triangles) {
+      if (isect_point_tri_v2(
+              corner, ndc_positions[tri.x], ndc_positions[tri.y], ndc_positions[tri.z]))
+      {
+        is_inside = true;
+        break;
+      }
+    }
+    if (!is_inside) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool grease_pencil_layer_is_opaque_occluder(const GPENCIL_PrivateData *pd,
+                                            const Object *ob,
+                                            const blender::bke::greasepencil::Layer &layer,
+                                            const blender::bke::greasepencil::Drawing &drawing,
+                                            const int onion_id)
+{
+  using namespace blender;
+  const GreasePencil &grease_pencil = *static_cast<const GreasePencil *>(ob->data);
+
+  /* Only layers that replace what is below them. */
+  if (onion_id != 0 || pd->simplify_fill || pd->v3d_color_type != -1 ||
+      (grease_pencil.flag & GREASE_PENCIL_STROKE_ORDER_3D) != 0 ||
+      layer.blend_mode != GP_LAYER_BLEND_NONE ||
+      (layer.use_masks() && !BLI_listbase_is_empty(&layer.masks)))
+  {
+    return false;
+  }
+  /* Effects can reveal what is below the layer (e.g. by offsetting it). */
+  if (!pd->simplify_fx && !BLI_listbase_is_empty(&ob->shader_fx)) {
+    return false;
+  }
+  float layer_alpha = pd->xray_alpha;
+  grease_pencil_layer_final_tint_and_alpha_get(pd, grease_pencil, onion_id, &layer_alpha);
+  if (grease_pencil_layer_final_opacity_get(pd, ob, grease_pencil, layer) < 1.0f ||
+      layer_alpha < 1.0f)
+  {
+    return false;
+  }
+
+  float4x4 persmat;
+  DRW_view_persmat_get(nullptr, persmat.ptr(), false);
+  const float4x4 layer_to_ndc = persmat * layer.to_world_space(*ob);
+
+  const bke::CurvesGeometry &curves = drawing.strokes();
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const Span<float3> positions = curves.positions();
+  const bke::AttributeAccessor attributes = curves.attributes();
+  const VArray<int> materials = *attributes.lookup_or_default<int>(
+      "material_index", bke::AttrDomain::Curve, 0);
+  const VArray<float> fill_opacities = *attributes.lookup_or_default<float>(
+      "fill_opacity", bke::AttrDomain::Curve, 1.0f);
+  const Span<uint3> triangles = drawing.triangles();
+
+  IndexMaskMemory memory;
+  const IndexMask visible_strokes = ed::greasepencil::retrieve_visible_strokes(
+      *const_cast<Object *>(ob), drawing, memory);
+
+  /* Strokes are drawn in order, so any visible stroke can cover the view. */
+  int tris_offset = 0;
+  for (const int curve_i : curves.curves_range()) {
+    const IndexRange points = points_by_curve[curve_i];
+    const int tris_num = (points.size() >= 3) ? (points.size() - 2) : 0;
+    const Span<uint3> curve_triangles = triangles.slice(tris_offset, tris_num);
+    tris_offset += tris_num;
+    if (tris_num == 0 || !visible_strokes.contains(curve_i)) {
+      continue;
+    }
+    const MaterialGPencilStyle *gp_style = BKE_gpencil_material_settings(
+        const_cast<Object *>(ob), materials[curve_i] + 1);
+    if ((gp_style->flag & (GP_MATERIAL_HIDE | GP_MATERIAL_IS_FILL_HOLDOUT)) != 0 ||
+        (gp_style->flag & GP_MATERIAL_FILL_SHOW) == 0 ||
+        gp_style->fill_style != GP_MATERIAL_FILL_STYLE_SOLID || gp_style->fill_rgba[3] < 1.0f ||
+        fill_opacities[curve_i] < 1.0f)
+    {
+      continue;
+    }
+    if (grease_pencil_stroke_fill_covers_view(
+            layer_to_ndc, positions.slice(points), curve_triangles))
+    {
+      return true;
+    }
+  }
+  return false;
+}
 /** \} */
@@ -290,6 +290,8 @@ typedef struct GPENCIL_PrivateData {
   bool simplify_fill;
   bool simplify_fx;
   bool simplify_antialias;
+  /* Skip layers hidden behind opaque fills of layers above them. */
+  bool simplify_cull_occluded;
   /* Use scene lighting or flat shading (global setting). */
   bool use_lighting;
   /* Use physical lights or just ambient lighting. */
@@ -341,6 +343,15 @@ GPENCIL_tLayer *grease_pencil_layer_cache_add(GPENCIL_PrivateData *pd,
                                               int onion_id,
                                               bool is_used_as_mask,
                                               GPENCIL_tObject *tgp_ob);
+/**
+ * Conservative test if the drawing of a layer covers the whole view with an opaque fill, so the
+ * layers drawn before it in the same object are not visible.
+ */
+bool grease_pencil_layer_is_opaque_occluder(const GPENCIL_PrivateData *pd,
+                                            const Object *ob,
+                                            const blender::bke::greasepencil::Layer &layer,
+                                            const blender::bke::greasepencil::Drawing &drawing,
+                                            int onion_id);
 /**
  * Creates a linked list of material pool containing all materials assigned for a given object.
  * We merge the material pools together if object does not contain a huge amount of materials.
@@ -192,6 +192,7 @@ void GPENCIL_cache_init(void *ved)
   const DRWContextState *draw_ctx = DRW_context_state_get();
   pd->cfra = int(DEG_get_ctime(draw_ctx->depsgraph));
   pd->simplify_antialias = GPENCIL_SIMPLIFY_AA(draw_ctx->scene);
+  pd->simplify_cull_occluded = GPENCIL_SIMPLIFY_CULL_OCCLUDED(draw_ctx->scene);
   pd->use_layer_fb = false;
   pd->use_object_fb = false;
   pd->use_mask_fb = false;
@@ -628,6 +629,24 @@ static bool is_used_as_layer_mask_in_viewlayer(const GreasePencil &grease_pencil
   return false;
 }
 
+/* Check if the passed in layer is used by any other layer as a mask. */
+static bool is_used_as_layer_mask(const GreasePencil &grease_pencil,
+                                  const blender::bke::greasepencil::Layer &mask_layer)
+{
+  using namespace blender::bke::greasepencil;
+  for (const Layer *layer : grease_pencil.layers()) {
+    if (!layer->use_masks()) {
+      continue;
+    }
+    LISTBASE_FOREACH (GreasePencilLayerMask *, mask, &layer->masks) {
+      if (STREQ(mask->layer_name, mask_layer.name().c_str())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 /* Returns true if this layer should be rendered (as part of the viewlayer). */
 static bool use_layer_in_render(const GreasePencil &grease_pencil,
                                 const blender::bke::greasepencil::Layer &layer,
@@ -707,12 +726,36 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
         vcount = v_first + v_count - vfirst;
       };
 
+  /* Offsets of the fill triangles in the index buffer and of the stroke vertices in the vertex
+   * buffer. Note that we loop over all the drawings (including the onion skinned ones) to make
+   * sure we match the offsets of the batch cache. */
   int t_offset = 0;
-  /* Note that we loop over all the drawings (including the onion skinned ones) to make sure we
-   * match the offsets of the batch cache. */
+  int v_offset = 0;
   const Vector<DrawingInfo> drawings = retrieve_visible_drawings(*pd->scene, grease_pencil, true);
   const Span<const Layer *> layers = grease_pencil.layers();
-  for (const DrawingInfo info : drawings) {
+
+  /* Drawings before the last one covering the whole view with an opaque fill are hidden. */
+  int first_unoccluded_drawing = 0;
+  if (pd->simplify_cull_occluded) {
+    for (int drawing_i = drawings.size() - 1; drawing_i > 0; drawing_i--) {
+      const DrawingInfo &info = drawings[drawing_i];
+      const Layer &layer = *layers[info.layer_index];
+      /* Layers of other view layers are not drawn, or only drawn into the masks. */
+      bool is_layer_used_as_mask = false;
+      if (!use_layer_in_render(grease_pencil, layer, *pd->view_layer, is_layer_used_as_mask) ||
+          is_layer_used_as_mask)
+      {
+        continue;
+      }
+      if (grease_pencil_layer_is_opaque_occluder(pd, ob, layer, info.drawing, info.onion_id)) {
+        first_unoccluded_drawing = drawing_i;
+        break;
+      }
+    }
+  }
+
+  for (const int drawing_i : drawings.index_range()) {
+    const DrawingInfo &info = drawings[drawing_i];
     const Layer &layer = *layers[info.layer_index];
 
     const bke::CurvesGeometry &curves = info.drawing.strokes();
@@ -735,8 +778,8 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
     visible_strokes.foreach_index([&](const int stroke_i, const int pos) {
       const IndexRange points = points_by_curve[stroke_i];
       const int num_stroke_triangles = (points.size() >= 3) ? (points.size() - 2) : 0;
-      const int num_stroke_vertices = (points.size() +
-                                       int(cyclic[stroke_i] && (points.size() >= 3)));
+      /* Including the padding vertices before and after the stroke. */
+      const int num_stroke_vertices = 1 + points.size() + int(cyclic[stroke_i]) + 1;
       num_triangles_per_stroke[pos] = num_stroke_triangles;
       num_vertices_per_stroke[pos] = num_stroke_vertices;
       total_num_triangles += num_stroke_triangles;
@@ -746,10 +789,13 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
     bool is_layer_used_as_mask = false;
     const bool show_drawing_in_render = use_layer_in_render(
         grease_pencil, layer, *pd->view_layer, is_layer_used_as_mask);
-    if (!show_drawing_in_render) {
+    /* Hidden layers still have to be drawn when they mask other layers. */
+    const bool is_occluded = (drawing_i < first_unoccluded_drawing) &&
+                             !is_used_as_layer_mask(grease_pencil, layer);
+    if (!show_drawing_in_render || is_occluded) {
       /* Skip over the entire drawing. */
       t_offset += total_num_triangles;
-      t_offset += total_num_vertices * 2;
+      v_offset += total_num_vertices;
       continue;
     }
 
@@ -777,6 +823,10 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
     /* Since we don't use the sbuffer in GPv3, this is always 0. */
     DRW_shgroup_uniform_float_copy(grp, "gpStrokeIndexOffset", 0.0f);
     DRW_shgroup_uniform_vec2_copy(grp, "viewportSize", DRW_viewport_size_get());
+    DRW_shgroup_buffer_texture(
+        grp, "gp_pos_tx", draw::DRW_cache_grease_pencil_position_buffer_get(pd->scene, ob));
+    DRW_shgroup_buffer_texture(
+        grp, "gp_col_tx", draw::DRW_cache_grease_pencil_color_buffer_get(pd->scene, ob));
 
     const VArray<int> stroke_materials = *attributes.lookup_or_default<int>(
         "material_index", bke::AttrDomain::Curve, 0);
@@ -805,7 +855,7 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
 
       if (skip_stroke) {
         t_offset += num_triangles_per_stroke[pos];
-        t_offset += num_vertices_per_stroke[pos] * 2;
+        v_offset += num_vertices_per_stroke[pos];
         return;
       }
 
@@ -837,19 +887,8 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
         }
       }
 
-      blender::gpu::Batch *geom = draw::DRW_cache_grease_pencil_get(pd->scene, ob);
-      if (iter_geom != geom) {
-        drawcall_flush();
-
-        blender::gpu::VertBuf *position_tx = draw::DRW_cache_grease_pencil_position_buffer_get(
-            pd->scene, ob);
-        blender::gpu::VertBuf *color_tx = draw::DRW_cache_grease_pencil_color_buffer_get(pd->scene,
-                                                                                         ob);
-        DRW_shgroup_buffer_texture(grp, "gp_pos_tx", position_tx);
-        DRW_shgroup_buffer_texture(grp, "gp_col_tx", color_tx);
-      }
-
       if (show_fill) {
+        blender::gpu::Batch *geom = draw::DRW_cache_grease_pencil_get(pd->scene, ob);
         const int v_first = t_offset * 3;
         const int v_count = num_triangles_per_stroke[pos] * 3;
         drawcall_add(geom, v_first, v_count);
@@ -858,12 +897,15 @@ static GPENCIL_tObject *grease_pencil_object_cache_populate(GPENCIL_PrivateData
       t_offset += num_triangles_per_stroke[pos];
 
       if (show_stroke) {
-        const int v_first = t_offset * 3;
-        const int v_count = num_vertices_per_stroke[pos] * 2 * 3;
+        /* Draw a quad per vertex, the padding vertices are discarded in the shader. This keeps
+         * the ranges of consecutive strokes contiguous so they are drawn together. */
+        blender::gpu::Batch *geom = draw::DRW_cache_grease_pencil_strokes_get(pd->scene, ob);
+        const int v_first = GP_IS_PROCEDURAL_STROKE_BIT | (v_offset * 6);
+        const int v_count = num_vertices_per_stroke[pos] * 6;
         drawcall_add(geom, v_first, v_count);
       }
 
-      t_offset += num_vertices_per_stroke[pos] * 2;
+      v_offset += num_vertices_per_stroke[pos];
     });
   }
 
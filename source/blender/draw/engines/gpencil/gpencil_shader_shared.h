@@ -48,6 +48,8 @@ enum gpLightType {
 
 #define GP_IS_STROKE_VERTEX_BIT (1 << 30)
 #define GP_VERTEX_ID_SHIFT 2
+/* Set on the vertex id of strokes drawn without index buffer, using 6 vertices per point. */
+#define GP_IS_PROCEDURAL_STROKE_BIT (1 << 29)
 
 /* Avoid compiler funkiness with enum types not being strongly typed in C. */
 #ifndef GPU_SHADER
@@ -242,6 +242,10 @@ struct Resources : public select::SelectMap {
 template<typename InstanceDataT> struct ShapeInstanceBuf : private select::SelectBuf {
 
   StorageVectorBuffer<InstanceDataT> data_buf;
+  /** Number of instances valid on the GPU since the last upload. */
+  int64_t uploaded_len = 0;
+  /** True if an instance differs from the uploaded data. */
+  bool is_dirty = true;
 
   ShapeInstanceBuf(const SelectionType selection_type, const char *name = nullptr)
       : select::SelectBuf(selection_type), data_buf(name){};
@@ -255,6 +259,12 @@ template<typename InstanceDataT> struct ShapeInstanceBuf : private select::Selec
   void append(const InstanceDataT &data, select::ID select_id)
   {
     this->select_append(select_id);
+    /* The buffer is kept across redraws. Compare with the previous content to only upload it
+     * when an instance changed. */
+    const int64_t index = data_buf.size();
+    if (!is_dirty && (index >= uploaded_len || memcmp(&data_buf[index], &data, sizeof(data)))) {
+      is_dirty = true;
+    }
     data_buf.append(data);
   }
 
@@ -264,7 +274,11 @@ template<typename InstanceDataT> struct ShapeInstanceBuf : private select::Selec
       return;
     }
     this->select_bind(pass);
-    data_buf.push_update();
+    if (is_dirty) {
+      data_buf.push_update();
+      uploaded_len = data_buf.size();
+      is_dirty = false;
+    }
     pass.bind_ssbo("data_buf", &data_buf);
     pass.draw(shape, data_buf.size());
   }
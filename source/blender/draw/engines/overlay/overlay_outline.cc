@@ -25,6 +25,8 @@
 
 #include "overlay_private.hh"
 
+#include "../gpencil/gpencil_shader_shared.h"
+
 /* Returns the normal plane in NDC space. */
 static void gpencil_depth_plane(Object *ob, float r_plane[4])
 {
@@ -292,7 +294,10 @@ static void OVERLAY_outline_grease_pencil(OVERLAY_PrivateData *pd, Scene *scene,
     gpencil_depth_plane(ob, plane);
   }
 
+  /* Offsets of the fill triangles in the index buffer and of the stroke vertices in the vertex
+   * buffer. */
   int t_offset = 0;
+  int v_offset = 0;
   const Vector<DrawingInfo> drawings = retrieve_visible_drawings(*scene, grease_pencil, true);
   for (const DrawingInfo info : drawings) {
     const bool is_stroke_order_3d = (grease_pencil.flag & GREASE_PENCIL_STROKE_ORDER_3D) != 0;
@@ -333,21 +338,20 @@ static void OVERLAY_outline_grease_pencil(OVERLAY_PrivateData *pd, Scene *scene,
       const bool hide_material = (gp_style->flag & GP_MATERIAL_HIDE) != 0;
 
       const int num_stroke_triangles = (points.size() >= 3) ? (points.size() - 2) : 0;
-      const int num_stroke_vertices = (points.size() +
-                                       int(cyclic[stroke_i] && (points.size() >= 3)));
+      /* Including the padding vertices before and after the stroke. */
+      const int num_stroke_vertices = 1 + points.size() + int(cyclic[stroke_i]) + 1;
 
       if (hide_material || hide_onion) {
         t_offset += num_stroke_triangles;
-        t_offset += num_stroke_vertices * 2;
+        v_offset += num_stroke_vertices;
         return;
       }
 
-      blender::gpu::Batch *geom = draw::DRW_cache_grease_pencil_get(scene, ob);
-
       const bool show_stroke = (gp_style->flag & GP_MATERIAL_STROKE_SHOW) != 0;
       const bool show_fill = (points.size() >= 3) && (gp_style->flag & GP_MATERIAL_FILL_SHOW) != 0;
 
       if (show_fill) {
+        blender::gpu::Batch *geom = draw::DRW_cache_grease_pencil_get(scene, ob);
         int v_first = t_offset * 3;
         int v_count = num_stroke_triangles * 3;
         DRW_shgroup_call_range(grp, ob, geom, v_first, v_count);
@@ -356,11 +360,12 @@ static void OVERLAY_outline_grease_pencil(OVERLAY_PrivateData *pd, Scene *scene,
       t_offset += num_stroke_triangles;
 
       if (show_stroke) {
-        int v_first = t_offset * 3;
-        int v_count = num_stroke_vertices * 2 * 3;
+        blender::gpu::Batch *geom = draw::DRW_cache_grease_pencil_strokes_get(scene, ob);
+        int v_first = GP_IS_PROCEDURAL_STROKE_BIT | (v_offset * 6);
+        int v_count = num_stroke_vertices * 6;
         DRW_shgroup_call_range(grp, ob, geom, v_first, v_count);
       }
-      t_offset += num_stroke_vertices * 2;
+      v_offset += num_stroke_vertices;
     });
   }
 }
@@ -192,7 +192,7 @@ static void select_cache_init(void *vedata)
     sel_data->is_drawn = false;
   }
 
-  copy_m4_m4(e_data.context.persmat, draw_ctx->rv3d->persmat);
+  e_data.context.view_state_store(draw_ctx->region, draw_ctx->v3d);
   e_data.context.index_drawn_len = 1;
   select_engine_framebuffer_setup();
   GPU_framebuffer_bind(e_data.framebuffer_select_id);
@@ -56,6 +56,63 @@ class Instance {
     return dummy_gpu_materials.begin();
   };
 
+  /** Surface batch of a mesh with its material, as drawn by #mesh_sync. */
+  struct MeshDraw {
+    gpu::Batch *batch;
+    Material material;
+    MaterialTexture texture;
+  };
+
+  /**
+   * State of the last synced object. Instances (e.g. from geometry nodes scattering) are synced
+   * one after the other for each instanced mesh, so consecutive dupli-objects with the same
+   * source, data and display settings reuse it and skip the object state, batch and material
+   * lookups.
+   */
+  struct ObjectSyncCache {
+    /* Key, only set for dupli-objects. */
+    const Object *dupli_source = nullptr;
+    const ID *data = nullptr;
+    ::Material **mat = nullptr;
+    const char *matbits = nullptr;
+    int totcol = 0;
+    short dtx = 0;
+    char dt = 0;
+
+    std::optional<ObjectState> object_state;
+    Vector<MeshDraw> mesh_draws;
+    bool has_transparent_material = false;
+
+    bool is_valid_for(const ObjectRef &ob_ref) const
+    {
+      const Object &ob = *ob_ref.object;
+      return ob_ref.dupli_object != nullptr && dupli_source == ob_ref.dupli_object->ob &&
+             data == ob.data && mat == ob.mat && matbits == ob.matbits && totcol == ob.totcol &&
+             dtx == ob.dtx && dt == ob.dt;
+    }
+
+    void clear()
+    {
+      *this = {};
+    }
+
+    void reset(const ObjectRef &ob_ref)
+    {
+      const Object &ob = *ob_ref.object;
+      dupli_source = ob_ref.dupli_object ? ob_ref.dupli_object->ob : nullptr;
+      data = static_cast<const ID *>(ob.data);
+      mat = ob.mat;
+      matbits = ob.matbits;
+      totcol = ob.totcol;
+      dtx = ob.dtx;
+      dt = ob.dt;
+      object_state.reset();
+      mesh_draws.clear();
+      has_transparent_material = false;
+    }
+  };
+  ObjectSyncCache sync_cache_;
+
   void init(Object *camera_ob = nullptr)
   {
     scene_state.init(camera_ob);
@@ -70,6 +127,7 @@ class Instance {
   void begin_sync()
   {
     resources.material_buf.clear_and_trim();
+    sync_cache_.clear();
 
     opaque_ps.sync(scene_state, resources);
     transparent_ps.sync(scene_state, resources);
@@ -121,7 +179,12 @@ class Instance {
       return;
     }
 
-    const ObjectState object_state = ObjectState(scene_state, resources, ob);
+    const bool use_sync_cache = sync_cache_.is_valid_for(ob_ref);
+    if (!use_sync_cache) {
+      sync_cache_.reset(ob_ref);
+      sync_cache_.object_state.emplace(scene_state, resources, ob);
+    }
+    const ObjectState &object_state = *sync_cache_.object_state;
 
     bool is_object_data_visible = (DRW_object_visibility_in_active_context(ob) &
                                    OB_VISIBLE_SELF) &&
@@ -155,7 +218,7 @@ class Instance {
       }
       else if (ob->type == OB_MESH) {
         ResourceHandle handle = manager.resource_handle(ob_ref);
-        mesh_sync(ob_ref, handle, object_state);
+        mesh_sync(ob_ref, handle, object_state, use_sync_cache);
         emitter_handle = handle;
       }
       else if (ob->type == OB_POINTCLOUD) {
@@ -226,7 +289,12 @@ class Instance {
                  const MaterialTexture *texture = nullptr,
                  bool show_missing_texture = false)
   {
-    resources.material_buf.append(material);
+    /* Consecutive draws often share the same material (e.g. instances of the same mesh). */
+    const int64_t last_index = resources.material_buf.size() - 1;
+    if (last_index < 0 || memcmp(&resources.material_buf[last_index], &material, sizeof(Material)))
+    {
+      resources.material_buf.append(material);
+    }
     int material_index = resources.material_buf.size() - 1;
 
     if (show_missing_texture && (!texture || !texture->gpu.texture)) {
@@ -238,10 +306,11 @@ class Instance {
     });
   }
 
-  void mesh_sync(ObjectRef &ob_ref, ResourceHandle handle, const ObjectState &object_state)
+  void mesh_draws_get(ObjectRef &ob_ref,
+                      const ObjectState &object_state,
+                      Vector<MeshDraw> &r_draws,
+                      bool &r_has_transparent_material)
   {
-    bool has_transparent_material = false;
-
     if (object_state.use_per_material_batches) {
       const int material_count = DRW_cache_object_material_count_get(ob_ref.object);
 
@@ -262,14 +331,14 @@ class Instance {
 
           int material_slot = i;
           Material mat = get_material(ob_ref, object_state.color_type, material_slot);
-          has_transparent_material = has_transparent_material || mat.is_transparent();
+          r_has_transparent_material = r_has_transparent_material || mat.is_transparent();
 
           MaterialTexture texture;
           if (object_state.color_type == V3D_SHADING_TEXTURE_COLOR) {
             texture = MaterialTexture(ob_ref.object, material_slot);
           }
 
-          draw_mesh(ob_ref, mat, batches[i], handle, &texture, object_state.show_missing_texture);
+          r_draws.append({batches[i], mat, texture});
         }
       }
     }
@@ -292,11 +361,42 @@ class Instance {
 
       if (batch) {
         Material mat = get_material(ob_ref, object_state.color_type);
-        has_transparent_material = has_transparent_material || mat.is_transparent();
+        r_has_transparent_material = r_has_transparent_material || mat.is_transparent();
+
+        r_draws.append({batch, mat, object_state.image_paint_override});
+      }
+    }
+  }
 
-        draw_mesh(ob_ref, mat, batch, handle, &object_state.image_paint_override);
+  void mesh_sync(ObjectRef &ob_ref,
+                 ResourceHandle handle,
+                 const ObjectState &object_state,
+                 bool use_sync_cache)
+  {
+    bool has_transparent_material = false;
+    if (!use_sync_cache) {
+      mesh_draws_get(ob_ref, object_state, sync_cache_.mesh_draws, has_transparent_material);
+      sync_cache_.has_transparent_material = has_transparent_material;
+    }
+    else if (ELEM(object_state.color_type, V3D_SHADING_OBJECT_COLOR, V3D_SHADING_RANDOM_COLOR)) {
+      /* The color still depends on the instance. */
+      for (MeshDraw &mesh_draw : sync_cache_.mesh_draws) {
+        mesh_draw.material = get_material(ob_ref, object_state.color_type);
+        has_transparent_material = has_transparent_material || mesh_draw.material.is_transparent();
       }
     }
+    else {
+      has_transparent_material = sync_cache_.has_transparent_material;
+    }
+
+    for (MeshDraw &mesh_draw : sync_cache_.mesh_draws) {
+      draw_mesh(ob_ref,
+                mesh_draw.material,
+                mesh_draw.batch,
+                handle,
+                &mesh_draw.texture,
+                object_state.show_missing_texture && object_state.use_per_material_batches);
+    }
 
     if (object_state.draw_shadow) {
       shadow_ps.object_sync(scene_state, ob_ref, handle, has_transparent_material);
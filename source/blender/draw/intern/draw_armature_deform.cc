@@ -0,0 +1,254 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup draw
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_linklist.h"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_armature.hh"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
+
+#include "GPU_capabilities.hh"
+#include "GPU_compute.hh"
+#include "GPU_shader.hh"
+#include "GPU_state.hh"
+#include "GPU_storage_buffer.hh"
+#include "GPU_vertex_buffer.hh"
+
+#include "DRW_engine.hh"
+
+#include "draw_armature_deform.hh"
+#include "draw_cache_extract.hh"
+
+extern "C" char datatoc_common_armature_deform_comp_glsl[];
+
+namespace blender::draw {
+
+enum {
+  SHADER_POSITIONS,
+  SHADER_POSITIONS_NORMALS,
+  SHADER_POSITIONS_HQ_NORMALS,
+  NUM_SHADERS,
+};
+
+static GPUShader *g_armature_deform_shaders[NUM_SHADERS];
+
+static constexpr int work_group_size = 64;
+
+static GPUShader *get_armature_deform_shader(const int shader_type)
+{
+  if (g_armature_deform_shaders[shader_type] == nullptr) {
+    const char *defines = nullptr;
+    const char *name = "Armature Deform";
+    if (shader_type == SHADER_POSITIONS_NORMALS) {
+      defines = "#define NORMALS\n";
+      name = "Armature Deform Normals";
+    }
+    else if (shader_type == SHADER_POSITIONS_HQ_NORMALS) {
+      defines =
+          "#define NORMALS\n"
+          "#define HQ_NORMALS\n";
+      name = "Armature Deform HQ Normals";
+    }
+    g_armature_deform_shaders[shader_type] = GPU_shader_create_compute(
+        datatoc_common_armature_deform_comp_glsl, nullptr, defines, name);
+  }
+  return g_armature_deform_shaders[shader_type];
+}
+
+/** GPU copy of #bke::ArmatureDeformWeights, which is uploaded once and reused for every pose. */
+struct ArmatureDeformGPUCache {
+  GPUStorageBuf *offsets = nullptr;
+  GPUStorageBuf *groups = nullptr;
+  GPUStorageBuf *weights = nullptr;
+};
+
+template<typename T> static GPUStorageBuf *create_storage_buffer(const Span<T> data)
+{
+  /* Empty buffers can't be bound. */
+  const T dummy{};
+  return GPU_storagebuf_create_ex(std::max<size_t>(data.size_in_bytes(), sizeof(T)),
+                                  data.is_empty() ? &dummy : data.data(),
+                                  GPU_USAGE_STATIC,
+                                  __func__);
+}
+
+static const ArmatureDeformGPUCache &ensure_gpu_cache(const bke::ArmatureDeformWeights &weights)
+{
+  if (weights.gpu_cache == nullptr) {
+    ArmatureDeformGPUCache *cache = MEM_new<ArmatureDeformGPUCache>(__func__);
+    cache->offsets = create_storage_buffer(weights.offsets.as_span());
+    cache->groups = create_storage_buffer(weights.groups.as_span());
+    cache->weights = create_storage_buffer(weights.weights.as_span());
+    weights.gpu_cache = cache;
+  }
+  return *static_cast<const ArmatureDeformGPUCache *>(weights.gpu_cache);
+}
+
+static void gpu_cache_free(ArmatureDeformGPUCache *cache)
+{
+  GPU_storagebuf_free(cache->offsets);
+  GPU_storagebuf_free(cache->groups);
+  GPU_storagebuf_free(cache->weights);
+  MEM_delete(cache);
+}
+
+/**
+ * The weights may be freed on any thread, but the GPU buffers have to be freed with an active
+ * GPU context, like the GPU subdivision data.
+ */
+static LinkNode *gpu_cache_free_queue = nullptr;
+static ThreadMutex gpu_cache_queue_mutex = BLI_MUTEX_INITIALIZER;
+
+void DRW_armature_deform_cache_free(void *gpu_cache)
+{
+  BLI_mutex_lock(&gpu_cache_queue_mutex);
+  BLI_linklist_prepend(&gpu_cache_free_queue, gpu_cache);
+  BLI_mutex_unlock(&gpu_cache_queue_mutex);
+}
+
+void DRW_cache_free_old_armature_deform()
+{
+  if (gpu_cache_free_queue == nullptr) {
+    return;
+  }
+
+  BLI_mutex_lock(&gpu_cache_queue_mutex);
+  while (gpu_cache_free_queue != nullptr) {
+    gpu_cache_free(
+        static_cast<ArmatureDeformGPUCache *>(BLI_linklist_pop(&gpu_cache_free_queue)));
+  }
+  BLI_mutex_unlock(&gpu_cache_queue_mutex);
+}
+
+void DRW_armature_deform_free()
+{
+  for (int i = 0; i < NUM_SHADERS; ++i) {
+    GPU_shader_free(g_armature_deform_shaders[i]);
+    g_armature_deform_shaders[i] = nullptr;
+  }
+  DRW_cache_free_old_armature_deform();
+}
+
+/** The vertex of every element in the position buffer, see #extract_positions. */
+static Array<int> calc_element_verts(const Mesh &mesh, const MeshBufferCache &mbc)
+{
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int2> edges = mesh.edges();
+  const Span<int> loose_edges = mbc.loose_geom.edges;
+  const Span<int> loose_verts = mbc.loose_geom.verts;
+
+  Array<int> element_verts(corner_verts.size() + loose_edges.size() * 2 + loose_verts.size());
+  MutableSpan<int> corners_data = element_verts.as_mutable_span().take_front(corner_verts.size());
+  MutableSpan<int> loose_edge_data = element_verts.as_mutable_span().slice(
+      corner_verts.size(), loose_edges.size() * 2);
+  MutableSpan<int> loose_vert_data = element_verts.as_mutable_span().take_back(loose_verts.size());
+  threading::memory_bandwidth_bound_task(element_verts.as_span().size_in_bytes(), [&]() {
+    threading::parallel_invoke(
+        corner_verts.size() > 1024,
+        [&]() { corners_data.copy_from(corner_verts); },
+        [&]() {
+          for (const int i : loose_edges.index_range()) {
+            const int2 edge = edges[loose_edges[i]];
+            loose_edge_data[i * 2 + 0] = edge[0];
+            loose_edge_data[i * 2 + 1] = edge[1];
+          }
+        },
+        [&]() { loose_vert_data.copy_from(loose_verts); });
+  });
+  return element_verts;
+}
+
+void draw_armature_deform_buffers(const Mesh &mesh,
+                                  const MeshBufferCache &mbc,
+                                  gpu::VertBuf *pos,
+                                  gpu::VertBuf *nor)
+{
+  const bke::ArmatureGPUDeform *deform = mesh.runtime->armature_gpu_deform.get();
+  if (deform == nullptr || (pos == nullptr && nor == nullptr)) {
+    return;
+  }
+  DRW_cache_free_old_armature_deform();
+
+  const Array<int> element_verts = calc_element_verts(mesh, mbc);
+  const int corners_num = mesh.corners_num;
+  /* The normal buffer only contains the face corners. When only the normals are deformed, the
+   * shader still needs a position buffer to write to. */
+  const bool has_pos = pos != nullptr;
+  const int elements_num = has_pos ? int(element_verts.size()) : corners_num;
+  BLI_assert(!has_pos || GPU_vertbuf_get_vertex_len(pos) == element_verts.size());
+  if (elements_num == 0) {
+    return;
+  }
+
+  int shader_type = SHADER_POSITIONS;
+  if (nor != nullptr) {
+    const GPUVertFormat *format = GPU_vertbuf_get_format(nor);
+    shader_type = format->attrs[0].comp_type == GPU_COMP_I16 ? SHADER_POSITIONS_HQ_NORMALS :
+                                                               SHADER_POSITIONS_NORMALS;
+  }
+  GPUShader *shader = get_armature_deform_shader(shader_type);
+  if (shader == nullptr) {
+    return;
+  }
+
+  const ArmatureDeformGPUCache &gpu_cache = ensure_gpu_cache(*deform->weights);
+  GPUStorageBuf *matrices = create_storage_buffer(deform->group_matrices.as_span());
+  GPUStorageBuf *verts = create_storage_buffer(element_verts.as_span());
+  GPUStorageBuf *dummy_positions = nullptr;
+  if (!has_pos) {
+    dummy_positions = GPU_storagebuf_create_ex(
+        sizeof(float3) * size_t(elements_num), nullptr, GPU_USAGE_DEVICE_ONLY, __func__);
+  }
+
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1i(shader, "elements_num", elements_num);
+  GPU_shader_uniform_1i(shader, "corners_num", corners_num);
+  GPU_storagebuf_bind(gpu_cache.offsets, 0);
+  GPU_storagebuf_bind(gpu_cache.groups, 1);
+  GPU_storagebuf_bind(gpu_cache.weights, 2);
+  GPU_storagebuf_bind(matrices, 3);
+  GPU_storagebuf_bind(verts, 4);
+  if (has_pos) {
+    GPU_vertbuf_bind_as_ssbo(pos, 5);
+  }
+  else {
+    GPU_storagebuf_bind(dummy_positions, 5);
+  }
+  if (nor != nullptr) {
+    GPU_vertbuf_bind_as_ssbo(nor, 6);
+  }
+
+  /* Use a second dimension when there are more work groups than can be dispatched at once. */
+  const int groups_num = (elements_num + work_group_size - 1) / work_group_size;
+  const int groups_x = std::min(groups_num, GPU_max_work_group_count(0));
+  const int groups_y = (groups_num + groups_x - 1) / groups_x;
+  GPU_compute_dispatch(shader, uint(groups_x), uint(groups_y), 1);
+
+  /* This modifies vertex buffers, so we need to put a barrier on the vertex attribute array. */
+  GPU_memory_barrier(GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+
+  GPU_shader_unbind();
+  GPU_storagebuf_unbind(matrices);
+  GPU_storagebuf_unbind(verts);
+  GPU_storagebuf_free(matrices);
+  GPU_storagebuf_free(verts);
+  if (dummy_positions) {
+    GPU_storagebuf_unbind(dummy_positions);
+    GPU_storagebuf_free(dummy_positions);
+  }
+}
+
+}  // namespace blender::draw
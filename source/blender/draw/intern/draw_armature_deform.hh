@@ -0,0 +1,35 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup draw
+ *
+ * Armature deformation of the mesh vertex buffers with compute shaders, for meshes whose
+ * deformation was delayed to the draw code with #blender::bke::ArmatureGPUDeform.
+ */
+
+#pragma once
+
+struct Mesh;
+namespace blender::gpu {
+class VertBuf;
+}  // namespace blender::gpu
+
+namespace blender::draw {
+
+struct MeshBufferCache;
+
+/**
+ * Deform the position and normal buffers that were just extracted from the undeformed mesh.
+ * Either buffer may be null when it was not extracted.
+ */
+void draw_armature_deform_buffers(const Mesh &mesh,
+                                  const MeshBufferCache &mbc,
+                                  gpu::VertBuf *pos,
+                                  gpu::VertBuf *nor);
+
+/** Queue the GPU buffers of #blender::bke::ArmatureDeformWeights for freeing. */
+void DRW_armature_deform_cache_free(void *gpu_cache);
+
+}  // namespace blender::draw
@@ -35,6 +35,7 @@
 #include "draw_cache.hh"
 #include "draw_cache_impl.hh"
 #include "draw_manager_c.hh"
+#include "draw_manager_profiling.hh"
 
 /* -------------------------------------------------------------------- */
 /** \name Internal Defines
@@ -3399,6 +3400,10 @@ void drw_batch_cache_generate_requested(Object *ob)
                            DRW_object_use_hide_faces(ob)) ||
                           ((mode == CTX_MODE_EDIT_MESH) && DRW_object_is_in_edit_mode(ob))));
 
+  /* Parts of the mesh extraction run in tasks of #DST.task_graph, which are not measured. */
+  const bool use_profiling = DRW_stats_is_enabled();
+  const double stime = use_profiling ? BLI_time_now_seconds() : 0.0;
+
   switch (ob->type) {
     case OB_MESH:
       DRW_mesh_batch_cache_create_requested(
@@ -3419,6 +3424,10 @@ void drw_batch_cache_generate_requested(Object *ob)
     default:
       break;
   }
+
+  if (use_profiling) {
+    DRW_stats_batch_cache_time_add(ob->type, (BLI_time_now_seconds() - stime) * 1e3);
+  }
 }
 
 void drw_batch_cache_generate_requested_evaluated_mesh_or_curve(Object *ob)
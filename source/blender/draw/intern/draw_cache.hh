@@ -282,6 +282,11 @@ void DRW_cache_gpencil_sbuffer_clear(Object *ob);
 /* Grease Pencil */
 
 blender::gpu::Batch *DRW_cache_grease_pencil_get(const Scene *scene, Object *ob);
+/**
+ * Procedural batch drawing the stroke quads of the object, 6 vertices per vertex of the position
+ * buffer. Draw ranges have to be flagged with #GP_IS_PROCEDURAL_STROKE_BIT.
+ */
+blender::gpu::Batch *DRW_cache_grease_pencil_strokes_get(const Scene *scene, Object *ob);
 blender::gpu::Batch *DRW_cache_grease_pencil_edit_points_get(const Scene *scene, Object *ob);
 blender::gpu::Batch *DRW_cache_grease_pencil_edit_lines_get(const Scene *scene, Object *ob);
 gpu::VertBuf *DRW_cache_grease_pencil_position_buffer_get(const Scene *scene, Object *ob);
@@ -8,8 +8,16 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
+#include <string>
+
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "DNA_customdata_types.h"
 
 #include "GPU_shader.hh"
 
@@ -230,6 +238,36 @@ struct MeshBufferCache {
                  &batch_cache.cage : \
                  ((mbc == &batch_cache.cage) ? &batch_cache.uv_cage : nullptr))
 
+/**
+ * The data of a mesh that the buffers of a batch cache were extracted from. The references to the
+ * arrays keep them alive, which also makes sure that they are copied instead of changed in place.
+ * Comparing the pointers with the arrays of another mesh is enough to know whether it has the same
+ * data, see #DRW_mesh_batch_cache_take_for_reuse and #mesh_batch_cache_shared_find.
+ */
+struct MeshBatchCacheSource {
+  struct Layer {
+    CustomDataLayer layer;
+    ImplicitSharingPtr<ImplicitSharingInfo> sharing_info;
+  };
+
+  int verts_num;
+  int edges_num;
+  int faces_num;
+  int corners_num;
+  const int *face_offset_indices;
+  ImplicitSharingPtr<ImplicitSharingInfo> face_offsets_sharing_info;
+  /** Vertex, edge, face and face corner layers. */
+  std::array<Vector<Layer>, 4> layers;
+
+  std::string active_color_attribute;
+  std::string default_color_attribute;
+  Vector<std::string> vertex_group_names;
+  int vertex_group_active_index;
+  char editflag;
+  /** The position and normal buffers were deformed on the GPU after extraction. */
+  bool use_armature_gpu_deform;
+};
+
 struct MeshBatchCache {
   MeshBufferCache final, cage, uv_cage;
 
@@ -275,6 +313,18 @@ struct MeshBatchCache {
   bool no_loose_wire;
 
   eV3DShadingColorType color_type;
+
+  /** Only set while the cache isn't used by a mesh, see #MeshBatchCacheSource. */
+  std::optional<MeshBatchCacheSource> source;
+
+  /**
+   * Number of meshes using the cache. Meshes with the same data share a cache, so that it is only
+   * extracted once for all linked duplicates and instances.
+   */
+  int users = 1;
+  /** Set when the cache can be found by other meshes with the same data. */
+  std::optional<MeshBatchCacheSource> shared_source;
+  uint64_t shared_hash = 0;
 };
 
 #define MBC_EDITUV \
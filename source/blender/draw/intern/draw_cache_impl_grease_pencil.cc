@@ -14,6 +14,9 @@
 #include "BKE_grease_pencil.h"
 #include "BKE_grease_pencil.hh"
 
+#include "BLI_implicit_sharing.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_set.hh"
 #include "BLI_task.hh"
 
 #include "DNA_grease_pencil_types.h"
@@ -27,6 +30,7 @@
 #include "GPU_batch.hh"
 
 #include "draw_cache_impl.hh"
+#include "draw_manager_c.hh"
 
 #include "../engines/gpencil/gpencil_defines.h"
 #include "../engines/gpencil/gpencil_shader_shared.h"
@@ -37,7 +41,10 @@ struct GreasePencilBatchCache {
   /** Instancing Data */
   gpu::VertBuf *vbo;
   gpu::VertBuf *vbo_col;
-  /** Indices in material order, then stroke order with fill first. */
+  /**
+   * Fill triangle indices in stroke order. The quads of the strokes are not stored, they are
+   * drawn procedurally with 6 vertices per vertex of #vbo (see #GP_IS_PROCEDURAL_STROKE_BIT).
+   */
   gpu::IndexBuf *ibo;
   /** Batches */
   gpu::Batch *geom_batch;
@@ -579,6 +586,266 @@ static void grease_pencil_edit_batch_ensure(Object &object,
   cache->is_dirty = false;
 }
 
+/**
+ * Vertex and index data of one drawing, relative to the start of the drawing in the object
+ * buffers. Stored in the runtime data of the drawing, so only drawings that changed are rebuilt
+ * when the object batches are recreated. The others are copied into the object buffers.
+ */
+struct GreasePencilDrawingBatchData : public ImplicitSharingMixin {
+  /* Inputs of the data, in addition to the attributes of the drawing. */
+  uint64_t geometry_stamp;
+  float4x4 layer_space_to_object_space;
+  Array<int> visible_strokes;
+
+  Array<GreasePencilStrokeVert> verts;
+  Array<GreasePencilColorVert> cols;
+  /** Fill triangle indices, shifted by #GP_VERTEX_ID_SHIFT like in the object index buffer. */
+  Array<uint32_t> indices;
+
+  void delete_self() override
+  {
+    MEM_delete(this);
+  }
+};
+
+static bool grease_pencil_drawing_batch_data_valid(const GreasePencilDrawingBatchData &data,
+                                                   const bke::greasepencil::Drawing &drawing,
+                                                   const float4x4 &layer_space_to_object_space,
+                                                   const IndexMask &visible_strokes)
+{
+  if (data.geometry_stamp != drawing.runtime->geometry_stamp ||
+      data.layer_space_to_object_space != layer_space_to_object_space ||
+      data.visible_strokes.size() != visible_strokes.size())
+  {
+    return false;
+  }
+  bool visible_strokes_equal = true;
+  visible_strokes.foreach_index([&](const int curve_i, const int pos) {
+    visible_strokes_equal &= (data.visible_strokes[pos] == curve_i);
+  });
+  return visible_strokes_equal;
+}
+
+static void grease_pencil_drawing_batch_data_build(const bke::greasepencil::Drawing &drawing,
+                                                   const float4x4 &layer_space_to_object_space,
+                                                   const IndexMask &visible_strokes,
+                                                   GreasePencilDrawingBatchData &data)
+{
+  const float4x4 object_space_to_layer_space = math::invert(layer_space_to_object_space);
+  const bke::CurvesGeometry &curves = drawing.strokes();
+  const bke::AttributeAccessor attributes = curves.attributes();
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const Span<float3> positions = curves.positions();
+  const VArray<bool> cyclic = curves.cyclic();
+  const VArray<float> radii = drawing.radii();
+  const VArray<float> opacities = drawing.opacities();
+  const VArray<ColorGeometry4f> vertex_colors = *attributes.lookup_or_default<ColorGeometry4f>(
+      "vertex_color", bke::AttrDomain::Point, ColorGeometry4f(0.0f, 0.0f, 0.0f, 0.0f));
+  const VArray<float> rotations = *attributes.lookup_or_default<float>(
+      "rotation", bke::AttrDomain::Point, 0.0f);
+  const VArray<int8_t> start_caps = *attributes.lookup_or_default<int8_t>(
+      "start_cap", bke::AttrDomain::Curve, GP_STROKE_CAP_TYPE_ROUND);
+  const VArray<int8_t> end_caps = *attributes.lookup_or_default<int8_t>(
+      "end_cap", bke::AttrDomain::Curve, 0);
+  const VArray<float> stroke_softness = *attributes.lookup_or_default<float>(
+      "softness", bke::AttrDomain::Curve, 0.0f);
+  const VArray<float> stroke_point_aspect_ratios = *attributes.lookup_or_default<float>(
+      "aspect_ratio", bke::AttrDomain::Curve, 1.0f);
+  const VArray<ColorGeometry4f> stroke_fill_colors = drawing.fill_colors();
+  const VArray<int> materials = *attributes.lookup_or_default<int>(
+      "material_index", bke::AttrDomain::Curve, 0);
+  const VArray<float> u_translations = *attributes.lookup_or_default<float>(
+      "u_translation", bke::AttrDomain::Curve, 0.0f);
+  const VArray<float> u_scales = *attributes.lookup_or_default<float>(
+      "u_scale", bke::AttrDomain::Curve, 1.0f);
+  const VArray<float> fill_opacities = *attributes.lookup_or_default<float>(
+      "fill_opacity", bke::AttrDomain::Curve, 1.0f);
+
+  const Span<uint3> triangles = drawing.triangles();
+  const Span<float4x2> texture_matrices = drawing.texture_matrices();
+
+  data.geometry_stamp = drawing.runtime->geometry_stamp;
+  data.layer_space_to_object_space = layer_space_to_object_space;
+  data.visible_strokes.reinitialize(visible_strokes.size());
+  visible_strokes.to_indices(data.visible_strokes.as_mutable_span());
+
+  /* Calculate the triangle offsets for all the visible curves. */
+  Array<int> tris_start_offsets(visible_strokes.size());
+  int t_offset = 0;
+  int pos = 0;
+  for (const int curve_i : curves.curves_range()) {
+    IndexRange points = points_by_curve[curve_i];
+    if (visible_strokes.contains(curve_i)) {
+      tris_start_offsets[pos] = t_offset;
+      pos++;
+    }
+    if (points.size() >= 3) {
+      t_offset += points.size() - 2;
+    }
+  }
+
+  /* Calculate the vertex and index offsets for all the visible curves. One vertex is stored
+   * before and after as padding. Cyclic strokes have one extra vertex. Only the triangles of the
+   * fills are indexed, the quads of the points are drawn procedurally. */
+  Array<int> verts_start_offsets(visible_strokes.size());
+  Array<int> indices_start_offsets(visible_strokes.size());
+  int v_offset = 0;
+  int i_offset = 0;
+  visible_strokes.foreach_index([&](const int curve_i, const int pos) {
+    IndexRange points = points_by_curve[curve_i];
+    const bool is_cyclic = cyclic[curve_i];
+    verts_start_offsets[pos] = v_offset;
+    indices_start_offsets[pos] = i_offset;
+    v_offset += 1 + points.size() + (is_cyclic ? 1 : 0) + 1;
+    if (points.size() >= 3) {
+      i_offset += (points.size() - 2) * 3;
+    }
+  });
+
+  data.verts.reinitialize(v_offset);
+  data.cols.reinitialize(v_offset);
+  data.indices.reinitialize(i_offset);
+  MutableSpan<GreasePencilStrokeVert> verts = data.verts;
+  MutableSpan<GreasePencilColorVert> cols = data.cols;
+  MutableSpan<uint32_t> indices = data.indices;
+
+  curves.ensure_evaluated_lengths();
+
+  auto populate_point = [&](IndexRange verts_range,
+                            int curve_i,
+                            int8_t start_cap,
+                            int8_t end_cap,
+                            int point_i,
+                            int idx,
+                            float u_stroke,
+                            const float4x2 &texture_matrix,
+                            GreasePencilStrokeVert &s_vert,
+                            GreasePencilColorVert &c_vert) {
+    const float3 pos = math::transform_point(layer_space_to_object_space, positions[point_i]);
+    copy_v3_v3(s_vert.pos, pos);
+    /* GP data itself does not constrain radii to be positive, but drawing code expects it, and
+     * use negative values as a special 'flag' to get rounded caps. */
+    s_vert.radius = math::max(radii[point_i], 0.0f) *
+                    ((end_cap == GP_STROKE_CAP_TYPE_ROUND) ? 1.0f : -1.0f);
+    /* Convert to legacy "pixel" space. We divide here, because the shader expects the values to
+     * be in the `px` space rather than world space. Otherwise the values will get clamped. */
+    s_vert.radius /= bke::greasepencil::LEGACY_RADIUS_CONVERSION_FACTOR;
+    s_vert.opacity = opacities[point_i] *
+                     ((start_cap == GP_STROKE_CAP_TYPE_ROUND) ? 1.0f : -1.0f);
+    s_vert.point_id = verts_range[idx];
+    s_vert.stroke_id = verts_range.first();
+    s_vert.mat = materials[curve_i] % GPENCIL_MATERIAL_BUFFER_LEN;
+
+    s_vert.packed_asp_hard_rot = pack_rotation_aspect_hardness(
+        rotations[point_i], stroke_point_aspect_ratios[curve_i], stroke_softness[curve_i]);
+    s_vert.u_stroke = u_stroke;
+    copy_v2_v2(s_vert.uv_fill, texture_matrix * float4(pos, 1.0f));
+
+    copy_v4_v4(c_vert.vcol, vertex_colors[point_i]);
+    copy_v4_v4(c_vert.fcol, stroke_fill_colors[curve_i]);
+    c_vert.fcol[3] = (int(c_vert.fcol[3] * 10000.0f) * 10.0f) + fill_opacities[curve_i];
+  };
+
+  /* Every stroke writes to its own range of the buffers, so strokes can be filled in parallel. */
+  visible_strokes.foreach_index(GrainSize(256), [&](const int curve_i, const int pos) {
+    const IndexRange points = points_by_curve[curve_i];
+    const bool is_cyclic = cyclic[curve_i];
+    const int verts_start_offset = verts_start_offsets[pos];
+    const int tris_start_offset = tris_start_offsets[pos];
+    const int num_verts = 1 + points.size() + (is_cyclic ? 1 : 0) + 1;
+    const IndexRange verts_range = IndexRange(verts_start_offset, num_verts);
+    MutableSpan<GreasePencilStrokeVert> verts_slice = verts.slice(verts_range);
+    MutableSpan<GreasePencilColorVert> cols_slice = cols.slice(verts_range);
+    const float4x2 texture_matrix = texture_matrices[curve_i] * object_space_to_layer_space;
+    int index = indices_start_offsets[pos];
+
+    const Span<float> lengths = curves.evaluated_lengths_for_curve(curve_i, is_cyclic);
+
+    /* First vertex is not drawn. */
+    verts_slice.first().mat = -1;
+
+    /* If the stroke has more than 2 points, add the triangle indices to the index buffer. */
+    if (points.size() >= 3) {
+      const Span<uint3> tris_slice = triangles.slice(tris_start_offset, points.size() - 2);
+      for (const uint3 tri : tris_slice) {
+        indices[index++] = (verts_range[1] + tri.x) << GP_VERTEX_ID_SHIFT;
+        indices[index++] = (verts_range[1] + tri.y) << GP_VERTEX_ID_SHIFT;
+        indices[index++] = (verts_range[1] + tri.z) << GP_VERTEX_ID_SHIFT;
+      }
+    }
+
+    /* Write all the point attributes to the vertex buffers. */
+    const float u_scale = u_scales[curve_i];
+    const float u_translation = u_translations[curve_i];
+    for (const int i : IndexRange(points.size())) {
+      const int idx = i + 1;
+      const float u_stroke = u_scale * (i > 0 ? lengths[i - 1] : 0.0f) + u_translation;
+      populate_point(verts_range,
+                     curve_i,
+                     start_caps[curve_i],
+                     end_caps[curve_i],
+                     points[i],
+                     idx,
+                     u_stroke,
+                     texture_matrix,
+                     verts_slice[idx],
+                     cols_slice[idx]);
+    }
+
+    if (is_cyclic) {
+      const int idx = points.size() + 1;
+      const float u = points.size() > 1 ? lengths[points.size() - 1] : 0.0f;
+      const float u_stroke = u_scale * u + u_translation;
+      populate_point(verts_range,
+                     curve_i,
+                     start_caps[curve_i],
+                     end_caps[curve_i],
+                     points[0],
+                     idx,
+                     u_stroke,
+                     texture_matrix,
+                     verts_slice[idx],
+                     cols_slice[idx]);
+    }
+
+    /* Last vertex is not drawn. */
+    verts_slice.last().mat = -1;
+  });
+}
+
+/**
+ * Get the vertex and index data of a drawing, rebuilding it only when the drawing changed. The
+ * caller gets its own user of the data, since the data stored in the drawing is replaced when the
+ * drawing is used again with a different layer transform.
+ */
+static ImplicitSharingPtr<GreasePencilDrawingBatchData> grease_pencil_drawing_batch_data_ensure(
+    Object &object,
+    const bke::greasepencil::Layer &layer,
+    const bke::greasepencil::Drawing &drawing)
+{
+  const float4x4 layer_space_to_object_space = layer.to_object_space(object);
+  IndexMaskMemory memory;
+  const IndexMask visible_strokes = ed::greasepencil::retrieve_visible_strokes(
+      object, drawing, memory);
+
+  const GreasePencilDrawingBatchData *data = static_cast<const GreasePencilDrawingBatchData *>(
+      drawing.runtime->batch_data.get());
+  if (data != nullptr && grease_pencil_drawing_batch_data_valid(
+                             *data, drawing, layer_space_to_object_space, visible_strokes))
+  {
+    data->add_user();
+    return ImplicitSharingPtr<GreasePencilDrawingBatchData>(data);
+  }
+
+  /* The data can be shared with other copies of the drawing, so never modify it in place. */
+  GreasePencilDrawingBatchData *new_data = MEM_new<GreasePencilDrawingBatchData>(__func__);
+  grease_pencil_drawing_batch_data_build(
+      drawing, layer_space_to_object_space, visible_strokes, *new_data);
+  new_data->add_user();
+  drawing.runtime->batch_data = ImplicitSharingPtr<ImplicitSharingInfo>(new_data);
+  return ImplicitSharingPtr<GreasePencilDrawingBatchData>(new_data);
+}
+
 static void grease_pencil_geom_batch_ensure(Object &object,
                                             const GreasePencil &grease_pencil,
                                             const Scene &scene)
@@ -600,65 +867,44 @@ static void grease_pencil_geom_batch_ensure(Object &object,
   const Vector<ed::greasepencil::DrawingInfo> drawings =
       ed::greasepencil::retrieve_visible_drawings(scene, grease_pencil, true);
 
-  /* First, count how many vertices and triangles are needed for the whole object. Also record the
-   * offsets into the curves for the vertices and triangles. */
-  int total_verts_num = 0;
-  int total_triangles_num = 0;
-  int v_offset = 0;
-  Vector<Array<int>> verts_start_offsets_per_visible_drawing;
-  Vector<Array<int>> tris_start_offsets_per_visible_drawing;
+  /* Get the data of every drawing, only drawings that changed are rebuilt. Then record the
+   * offsets of the drawings in the object buffers. The data is stored in the drawing, so drawings
+   * can only be processed in parallel when they are all different. */
+  Array<ImplicitSharingPtr<GreasePencilDrawingBatchData>> drawings_data(drawings.size());
+  auto ensure_drawing_data = [&](const int drawing_i) {
+    const ed::greasepencil::DrawingInfo &info = drawings[drawing_i];
+    const Layer &layer = *grease_pencil.layer(info.layer_index);
+    drawings_data[drawing_i] = grease_pencil_drawing_batch_data_ensure(
+        object, layer, info.drawing);
+  };
+  Set<const Drawing *> unique_drawings;
   for (const ed::greasepencil::DrawingInfo &info : drawings) {
-    const bke::CurvesGeometry &curves = info.drawing.strokes();
-    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
-    const VArray<bool> cyclic = curves.cyclic();
-    IndexMaskMemory memory;
-    const IndexMask visible_strokes = ed::greasepencil::retrieve_visible_strokes(
-        object, info.drawing, memory);
-
-    const int num_curves = visible_strokes.size();
-    const int verts_start_offsets_size = num_curves;
-    const int tris_start_offsets_size = num_curves;
-    Array<int> verts_start_offsets(verts_start_offsets_size);
-    Array<int> tris_start_offsets(tris_start_offsets_size);
-
-    /* Calculate the triangle offsets for all the visible curves. */
-    int t_offset = 0;
-    int pos = 0;
-    for (const int curve_i : curves.curves_range()) {
-      IndexRange points = points_by_curve[curve_i];
-      if (visible_strokes.contains(curve_i)) {
-        tris_start_offsets[pos] = t_offset;
-        pos++;
-      }
-      if (points.size() >= 3) {
-        t_offset += points.size() - 2;
-      }
-    }
-
-    /* Calculate the vertex offsets for all the visible curves. */
-    int num_cyclic = 0;
-    int num_points = 0;
-    visible_strokes.foreach_index([&](const int curve_i, const int pos) {
-      IndexRange points = points_by_curve[curve_i];
-      const bool is_cyclic = cyclic[curve_i];
-
-      if (is_cyclic) {
-        num_cyclic++;
+    unique_drawings.add(&info.drawing);
+  }
+  if (unique_drawings.size() == drawings.size()) {
+    threading::parallel_for(drawings.index_range(), 1, [&](const IndexRange range) {
+      for (const int drawing_i : range) {
+        ensure_drawing_data(drawing_i);
       }
-
-      verts_start_offsets[pos] = v_offset;
-      v_offset += 1 + points.size() + (is_cyclic ? 1 : 0) + 1;
-      num_points += points.size();
     });
+  }
+  else {
+    for (const int drawing_i : drawings.index_range()) {
+      ensure_drawing_data(drawing_i);
+    }
+  }
 
-    /* One vertex is stored before and after as padding. Cyclic strokes have one extra vertex. */
-    total_verts_num += num_points + num_cyclic + num_curves * 2;
-    total_triangles_num += (num_points + num_cyclic) * 2;
-    total_triangles_num += info.drawing.triangles().size();
-
-    verts_start_offsets_per_visible_drawing.append(std::move(verts_start_offsets));
-    tris_start_offsets_per_visible_drawing.append(std::move(tris_start_offsets));
+  Array<int> verts_offsets_data(drawings.size() + 1);
+  Array<int> indices_offsets_data(drawings.size() + 1);
+  for (const int drawing_i : drawings.index_range()) {
+    verts_offsets_data[drawing_i] = drawings_data[drawing_i]->verts.size();
+    indices_offsets_data[drawing_i] = drawings_data[drawing_i]->indices.size();
   }
+  const OffsetIndices<int> verts_offsets = offset_indices::accumulate_counts_to_offsets(
+      verts_offsets_data);
+  const OffsetIndices<int> indices_offsets = offset_indices::accumulate_counts_to_offsets(
+      indices_offsets_data);
+  const int total_verts_num = verts_offsets.total_size();
 
   GPUUsageType vbo_flag = GPU_USAGE_STATIC | GPU_USAGE_FLAG_BUFFER_TEXTURE_ONLY;
   /* Create VBOs. */
@@ -674,160 +920,32 @@ static void grease_pencil_geom_batch_ensure(Object &object,
   MutableSpan<GreasePencilStrokeVert> verts = cache->vbo->data<GreasePencilStrokeVert>();
   MutableSpan<GreasePencilColorVert> cols = cache->vbo_col->data<GreasePencilColorVert>();
   /* Create IBO. */
-  GPU_indexbuf_init(&ibo, GPU_PRIM_TRIS, total_triangles_num, 0xFFFFFFFFu);
-
-  /* Fill buffers with data. */
-  for (const int drawing_i : drawings.index_range()) {
-    const ed::greasepencil::DrawingInfo &info = drawings[drawing_i];
-    const Layer &layer = *grease_pencil.layer(info.layer_index);
-    const float4x4 layer_space_to_object_space = layer.to_object_space(object);
-    const float4x4 object_space_to_layer_space = math::invert(layer_space_to_object_space);
-    const bke::CurvesGeometry &curves = info.drawing.strokes();
-    const bke::AttributeAccessor attributes = curves.attributes();
-    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
-    const Span<float3> positions = curves.positions();
-    const VArray<bool> cyclic = curves.cyclic();
-    const VArray<float> radii = info.drawing.radii();
-    const VArray<float> opacities = info.drawing.opacities();
-    const VArray<ColorGeometry4f> vertex_colors = *attributes.lookup_or_default<ColorGeometry4f>(
-        "vertex_color", bke::AttrDomain::Point, ColorGeometry4f(0.0f, 0.0f, 0.0f, 0.0f));
-    const VArray<float> rotations = *attributes.lookup_or_default<float>(
-        "rotation", bke::AttrDomain::Point, 0.0f);
-    /* Assumes that if the ".selection" attribute does not exist, all points are selected. */
-    const VArray<float> selection_float = *attributes.lookup_or_default<float>(
-        ".selection", bke::AttrDomain::Point, true);
-    const VArray<int8_t> start_caps = *attributes.lookup_or_default<int8_t>(
-        "start_cap", bke::AttrDomain::Curve, GP_STROKE_CAP_TYPE_ROUND);
-    const VArray<int8_t> end_caps = *attributes.lookup_or_default<int8_t>(
-        "end_cap", bke::AttrDomain::Curve, 0);
-    const VArray<float> stroke_softness = *attributes.lookup_or_default<float>(
-        "softness", bke::AttrDomain::Curve, 0.0f);
-    const VArray<float> stroke_point_aspect_ratios = *attributes.lookup_or_default<float>(
-        "aspect_ratio", bke::AttrDomain::Curve, 1.0f);
-    const VArray<ColorGeometry4f> stroke_fill_colors = info.drawing.fill_colors();
-    const VArray<int> materials = *attributes.lookup_or_default<int>(
-        "material_index", bke::AttrDomain::Curve, 0);
-    const VArray<float> u_translations = *attributes.lookup_or_default<float>(
-        "u_translation", bke::AttrDomain::Curve, 0.0f);
-    const VArray<float> u_scales = *attributes.lookup_or_default<float>(
-        "u_scale", bke::AttrDomain::Curve, 1.0f);
-    const VArray<float> fill_opacities = *attributes.lookup_or_default<float>(
-        "fill_opacity", bke::AttrDomain::Curve, 1.0f);
-
-    const Span<uint3> triangles = info.drawing.triangles();
-    const Span<float4x2> texture_matrices = info.drawing.texture_matrices();
-    const Span<int> verts_start_offsets = verts_start_offsets_per_visible_drawing[drawing_i];
-    const Span<int> tris_start_offsets = tris_start_offsets_per_visible_drawing[drawing_i];
-    IndexMaskMemory memory;
-    const IndexMask visible_strokes = ed::greasepencil::retrieve_visible_strokes(
-        object, info.drawing, memory);
-
-    curves.ensure_evaluated_lengths();
-
-    auto populate_point = [&](IndexRange verts_range,
-                              int curve_i,
-                              int8_t start_cap,
-                              int8_t end_cap,
-                              int point_i,
-                              int idx,
-                              float u_stroke,
-                              const float4x2 &texture_matrix,
-                              GreasePencilStrokeVert &s_vert,
-                              GreasePencilColorVert &c_vert) {
-      const float3 pos = math::transform_point(layer_space_to_object_space, positions[point_i]);
-      copy_v3_v3(s_vert.pos, pos);
-      /* GP data itself does not constrain radii to be positive, but drawing code expects it, and
-       * use negative values as a special 'flag' to get rounded caps. */
-      s_vert.radius = math::max(radii[point_i], 0.0f) *
-                      ((end_cap == GP_STROKE_CAP_TYPE_ROUND) ? 1.0f : -1.0f);
-      /* Convert to legacy "pixel" space. We divide here, because the shader expects the values to
-       * be in the `px` space rather than world space. Otherwise the values will get clamped. */
-      s_vert.radius /= bke::greasepencil::LEGACY_RADIUS_CONVERSION_FACTOR;
-      s_vert.opacity = opacities[point_i] *
-                       ((start_cap == GP_STROKE_CAP_TYPE_ROUND) ? 1.0f : -1.0f);
-      s_vert.point_id = verts_range[idx];
-      s_vert.stroke_id = verts_range.first();
-      s_vert.mat = materials[curve_i] % GPENCIL_MATERIAL_BUFFER_LEN;
-
-      s_vert.packed_asp_hard_rot = pack_rotation_aspect_hardness(
-          rotations[point_i], stroke_point_aspect_ratios[curve_i], stroke_softness[curve_i]);
-      s_vert.u_stroke = u_stroke;
-      copy_v2_v2(s_vert.uv_fill, texture_matrix * float4(pos, 1.0f));
-
-      copy_v4_v4(c_vert.vcol, vertex_colors[point_i]);
-      copy_v4_v4(c_vert.fcol, stroke_fill_colors[curve_i]);
-      c_vert.fcol[3] = (int(c_vert.fcol[3] * 10000.0f) * 10.0f) + fill_opacities[curve_i];
-
-      int v_mat = (verts_range[idx] << GP_VERTEX_ID_SHIFT) | GP_IS_STROKE_VERTEX_BIT;
-      GPU_indexbuf_add_tri_verts(&ibo, v_mat + 0, v_mat + 1, v_mat + 2);
-      GPU_indexbuf_add_tri_verts(&ibo, v_mat + 2, v_mat + 1, v_mat + 3);
-    };
-
-    visible_strokes.foreach_index([&](const int curve_i, const int pos) {
-      const IndexRange points = points_by_curve[curve_i];
-      const bool is_cyclic = cyclic[curve_i];
-      const int verts_start_offset = verts_start_offsets[pos];
-      const int tris_start_offset = tris_start_offsets[pos];
-      const int num_verts = 1 + points.size() + (is_cyclic ? 1 : 0) + 1;
-      const IndexRange verts_range = IndexRange(verts_start_offset, num_verts);
-      MutableSpan<GreasePencilStrokeVert> verts_slice = verts.slice(verts_range);
-      MutableSpan<GreasePencilColorVert> cols_slice = cols.slice(verts_range);
-      const float4x2 texture_matrix = texture_matrices[curve_i] * object_space_to_layer_space;
-
-      const Span<float> lengths = curves.evaluated_lengths_for_curve(curve_i, is_cyclic);
-
-      /* First vertex is not drawn. */
-      verts_slice.first().mat = -1;
-
-      /* If the stroke has more than 2 points, add the triangle indices to the index buffer. */
-      if (points.size() >= 3) {
-        const Span<uint3> tris_slice = triangles.slice(tris_start_offset, points.size() - 2);
-        for (const uint3 tri : tris_slice) {
-          GPU_indexbuf_add_tri_verts(&ibo,
-                                     (verts_range[1] + tri.x) << GP_VERTEX_ID_SHIFT,
-                                     (verts_range[1] + tri.y) << GP_VERTEX_ID_SHIFT,
-                                     (verts_range[1] + tri.z) << GP_VERTEX_ID_SHIFT);
-        }
-      }
-
-      /* Write all the point attributes to the vertex buffers. Create a quad for each point. */
-      const float u_scale = u_scales[curve_i];
-      const float u_translation = u_translations[curve_i];
-      for (const int i : IndexRange(points.size())) {
-        const int idx = i + 1;
-        const float u_stroke = u_scale * (i > 0 ? lengths[i - 1] : 0.0f) + u_translation;
-        populate_point(verts_range,
-                       curve_i,
-                       start_caps[curve_i],
-                       end_caps[curve_i],
-                       points[i],
-                       idx,
-                       u_stroke,
-                       texture_matrix,
-                       verts_slice[idx],
-                       cols_slice[idx]);
+  GPU_indexbuf_init(&ibo, GPU_PRIM_TRIS, indices_offsets.total_size() / 3, 0xFFFFFFFFu);
+  MutableSpan<uint32_t> indices = GPU_indexbuf_get_data(&ibo);
+
+  /* Copy the data of the drawings into the object buffers, offsetting the vertex indices. */
+  threading::parallel_for(drawings.index_range(), 1, [&](const IndexRange range) {
+    for (const int drawing_i : range) {
+      const GreasePencilDrawingBatchData &data = *drawings_data[drawing_i];
+      const int verts_start = verts_offsets[drawing_i].start();
+      const uint32_t indices_shift = uint32_t(verts_start) << GP_VERTEX_ID_SHIFT;
+
+      MutableSpan<GreasePencilStrokeVert> verts_slice = verts.slice(verts_offsets[drawing_i]);
+      verts_slice.copy_from(data.verts);
+      for (GreasePencilStrokeVert &vert : verts_slice) {
+        vert.point_id += verts_start;
+        vert.stroke_id += verts_start;
       }
+      cols.slice(verts_offsets[drawing_i]).copy_from(data.cols);
 
-      if (is_cyclic) {
-        const int idx = points.size() + 1;
-        const float u = points.size() > 1 ? lengths[points.size() - 1] : 0.0f;
-        const float u_stroke = u_scale * u + u_translation;
-        populate_point(verts_range,
-                       curve_i,
-                       start_caps[curve_i],
-                       end_caps[curve_i],
-                       points[0],
-                       idx,
-                       u_stroke,
-                       texture_matrix,
-                       verts_slice[idx],
-                       cols_slice[idx]);
+      MutableSpan<uint32_t> indices_slice = indices.slice(indices_offsets[drawing_i]);
+      for (const int i : indices_slice.index_range()) {
+        indices_slice[i] = data.indices[i] + indices_shift;
       }
-
-      /* Last vertex is not drawn. */
-      verts_slice.last().mat = -1;
-    });
-  }
+    }
+  });
+  /* Vertex indices grow with the position in the buffer. */
+  const uint32_t index_max = uint32_t(total_verts_num + 2) << GP_VERTEX_ID_SHIFT;
 
   /* Mark last 2 verts as invalid. */
   verts[total_verts_num + 0].mat = -1;
@@ -836,7 +954,8 @@ static void grease_pencil_geom_batch_ensure(Object &object,
   verts[0].mat = -1;
 
   /* Finish the IBO. */
-  cache->ibo = GPU_indexbuf_build(&ibo);
+  cache->ibo = GPU_indexbuf_calloc();
+  GPU_indexbuf_build_in_place_ex(&ibo, 0, index_max, false, cache->ibo);
   /* Create the batches */
   cache->geom_batch = GPU_batch_create(GPU_PRIM_TRIS, cache->vbo, cache->ibo);
   /* Allow creation of buffer texture. */
@@ -890,6 +1009,16 @@ gpu::Batch *DRW_cache_grease_pencil_get(const Scene *scene, Object *ob)
   return cache->geom_batch;
 }
 
+gpu::Batch *DRW_cache_grease_pencil_strokes_get(const Scene *scene, Object *ob)
+{
+  GreasePencil &grease_pencil = *static_cast<GreasePencil *>(ob->data);
+  grease_pencil_batch_cache_get(grease_pencil);
+  grease_pencil_geom_batch_ensure(*ob, grease_pencil, *scene);
+
+  /* The stroke quads are expanded in the vertex shader from the vertex buffers. */
+  return drw_cache_procedural_triangles_get();
+}
+
 gpu::Batch *DRW_cache_grease_pencil_edit_points_get(const Scene *scene, Object *ob)
 {
   GreasePencil &grease_pencil = *static_cast<GreasePencil *>(ob->data);
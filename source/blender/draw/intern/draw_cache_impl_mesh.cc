@@ -8,6 +8,7 @@
  * \brief Mesh API for render engines
  */
 
+#include <mutex>
 #include <optional>
 
 #include "MEM_guardedalloc.h"
@@ -40,6 +41,7 @@
 #include "BKE_mesh_tangent.hh"
 #include "BKE_modifier.hh"
 #include "BKE_object.hh"
+#include "BKE_object_types.hh"
 #include "BKE_object_deform.h"
 #include "BKE_paint.hh"
 #include "BKE_pbvh_api.hh"
@@ -57,6 +59,7 @@
 #include "ED_mesh.hh"
 #include "ED_uvedit.hh"
 
+#include "draw_armature_deform.hh"
 #include "draw_cache_extract.hh"
 #include "draw_cache_inline.hh"
 #include "draw_subdivision.hh"
@@ -603,13 +606,38 @@ static void mesh_batch_cache_init(Object &object, Mesh &mesh)
   drw_mesh_weight_state_clear(&cache->weight_state);
 }
 
+static bool mesh_batch_cache_reuse(MeshBatchCache &cache, const Mesh &mesh);
+static void mesh_batch_cache_shared_add(const Object &object, const Mesh &mesh);
+static MeshBatchCache *mesh_batch_cache_shared_find(Object &object, const Mesh &mesh);
+static bool mesh_batch_cache_shared_release(MeshBatchCache &cache);
+static bool mesh_batch_cache_is_shared(const MeshBatchCache &cache);
+
 void DRW_mesh_batch_cache_validate(Object &object, Mesh &mesh)
 {
+  if (mesh.runtime->batch_cache == nullptr && object.runtime->mesh_batch_cache_prev != nullptr &&
+      object.runtime->data_eval == &mesh.id)
+  {
+    MeshBatchCache *cache = static_cast<MeshBatchCache *>(object.runtime->mesh_batch_cache_prev);
+    object.runtime->mesh_batch_cache_prev = nullptr;
+    if (mesh_batch_cache_reuse(*cache, mesh)) {
+      mesh.runtime->batch_cache = cache;
+      mesh_batch_cache_shared_add(object, mesh);
+    }
+    else {
+      DRW_mesh_batch_cache_free(cache);
+    }
+  }
+
   if (!mesh_batch_cache_valid(object, mesh)) {
     if (mesh.runtime->batch_cache) {
-      mesh_batch_cache_clear(*static_cast<MeshBatchCache *>(mesh.runtime->batch_cache));
+      DRW_mesh_batch_cache_free(mesh.runtime->batch_cache);
+      mesh.runtime->batch_cache = nullptr;
+    }
+    mesh.runtime->batch_cache = mesh_batch_cache_shared_find(object, mesh);
+    if (mesh.runtime->batch_cache == nullptr) {
+      mesh_batch_cache_init(object, mesh);
+      mesh_batch_cache_shared_add(object, mesh);
     }
-    mesh_batch_cache_init(object, mesh);
   }
 }
 
@@ -727,6 +755,11 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode)
     return;
   }
   MeshBatchCache &cache = *static_cast<MeshBatchCache *>(mesh->runtime->batch_cache);
+  if (mesh_batch_cache_is_shared(cache)) {
+    /* Meshes that share the cache can be tagged from multiple threads, so don't free buffers. */
+    cache.is_dirty = true;
+    return;
+  }
   DRWBatchFlag batch_map;
   switch (mode) {
     case BKE_MESH_BATCH_DIRTY_SELECT:
@@ -833,10 +866,338 @@ static void mesh_batch_cache_clear(MeshBatchCache &cache)
 void DRW_mesh_batch_cache_free(void *batch_cache)
 {
   MeshBatchCache *cache = static_cast<MeshBatchCache *>(batch_cache);
+  if (!mesh_batch_cache_shared_release(*cache)) {
+    return;
+  }
   mesh_batch_cache_clear(*cache);
   MEM_delete(cache);
 }
 
+/** Free the buffers that depend on the vertex positions, directly or through the normals. */
+static void mesh_batch_cache_discard_positions(MeshBatchCache &cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.skin_roots);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.vnor);
+    /* The triangulation of n-gons depends on the positions. */
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris);
+  }
+  for (int i = 0; i < cache.mat_len; i++) {
+    GPU_INDEXBUF_DISCARD_SAFE(cache.tris_per_mat[i]);
+  }
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos,
+                                     vbo.nor,
+                                     vbo.edge_fac,
+                                     vbo.tan,
+                                     vbo.edituv_stretch_area,
+                                     vbo.edituv_stretch_angle,
+                                     vbo.mesh_analysis,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     vbo.skin_roots);
+  batch_map |= BATCH_MAP(vbo.vnor, ibo.tris) | batches_that_use_buffer(TRIS_PER_MAT_INDEX);
+  mesh_batch_cache_discard_batch(cache, batch_map);
+}
+
+static void mesh_source_layers_add(const CustomData &data,
+                                   Vector<MeshBatchCacheSource::Layer> &r_layers)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    if (layer.sharing_info) {
+      layer.sharing_info->add_user();
+    }
+    r_layers.append({layer, ImplicitSharingPtr<ImplicitSharingInfo>(layer.sharing_info)});
+  }
+}
+
+/**
+ * Check whether the layers are the same as the ones the buffers were extracted from. Only the
+ * data of the position attribute may be different, which is reported separately.
+ */
+static bool mesh_source_layers_match(const CustomData &data,
+                                     const Span<MeshBatchCacheSource::Layer> layers_src,
+                                     const bool is_vert_data,
+                                     bool &r_positions_changed)
+{
+  if (data.totlayer != layers_src.size()) {
+    return false;
+  }
+  for (const int i : layers_src.index_range()) {
+    const CustomDataLayer &layer = data.layers[i];
+    const CustomDataLayer &layer_src = layers_src[i].layer;
+    if (layer.type != layer_src.type || layer.flag != layer_src.flag ||
+        layer.active != layer_src.active || layer.active_rnd != layer_src.active_rnd ||
+        layer.active_clone != layer_src.active_clone ||
+        layer.active_mask != layer_src.active_mask || !STREQ(layer.name, layer_src.name))
+    {
+      return false;
+    }
+    /* Without sharing info the data might have been changed in place. */
+    if (layer.sharing_info == nullptr || layer.sharing_info != layer_src.sharing_info ||
+        layer.data != layer_src.data)
+    {
+      if (is_vert_data && STREQ(layer.name, "position")) {
+        r_positions_changed = true;
+        continue;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+static StringRefNull mesh_attribute_name_or_empty(const char *name)
+{
+  return name ? name : "";
+}
+
+static MeshBatchCacheSource mesh_batch_cache_source_create(const Mesh &mesh)
+{
+  MeshBatchCacheSource source;
+  source.verts_num = mesh.verts_num;
+  source.edges_num = mesh.edges_num;
+  source.faces_num = mesh.faces_num;
+  source.corners_num = mesh.corners_num;
+  source.face_offset_indices = mesh.face_offset_indices;
+  if (const ImplicitSharingInfo *sharing_info = mesh.runtime->face_offsets_sharing_info) {
+    sharing_info->add_user();
+    source.face_offsets_sharing_info = ImplicitSharingPtr<ImplicitSharingInfo>(sharing_info);
+  }
+  mesh_source_layers_add(mesh.vert_data, source.layers[0]);
+  mesh_source_layers_add(mesh.edge_data, source.layers[1]);
+  mesh_source_layers_add(mesh.face_data, source.layers[2]);
+  mesh_source_layers_add(mesh.corner_data, source.layers[3]);
+  source.active_color_attribute = mesh_attribute_name_or_empty(mesh.active_color_attribute);
+  source.default_color_attribute = mesh_attribute_name_or_empty(mesh.default_color_attribute);
+  LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+    source.vertex_group_names.append(group->name);
+  }
+  source.vertex_group_active_index = mesh.vertex_group_active_index;
+  source.editflag = mesh.editflag;
+  source.use_armature_gpu_deform = mesh.runtime->armature_gpu_deform != nullptr;
+  return source;
+}
+
+/**
+ * Check whether the mesh has the data that the buffers were extracted from. Only the positions
+ * may be different, which is reported separately.
+ */
+static bool mesh_batch_cache_source_matches(const MeshBatchCacheSource &source,
+                                            const Mesh &mesh,
+                                            bool &r_positions_changed)
+{
+  if (mesh.verts_num != source.verts_num || mesh.edges_num != source.edges_num ||
+      mesh.faces_num != source.faces_num || mesh.corners_num != source.corners_num)
+  {
+    return false;
+  }
+  if (mesh.faces_num > 0 &&
+      (mesh.runtime->face_offsets_sharing_info == nullptr ||
+       mesh.runtime->face_offsets_sharing_info != source.face_offsets_sharing_info.get() ||
+       mesh.face_offset_indices != source.face_offset_indices))
+  {
+    return false;
+  }
+  if (mesh_attribute_name_or_empty(mesh.active_color_attribute) != source.active_color_attribute ||
+      mesh_attribute_name_or_empty(mesh.default_color_attribute) !=
+          source.default_color_attribute ||
+      mesh.vertex_group_active_index != source.vertex_group_active_index ||
+      mesh.editflag != source.editflag)
+  {
+    return false;
+  }
+  int group_index = 0;
+  LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+    if (group_index >= source.vertex_group_names.size() ||
+        source.vertex_group_names[group_index] != group->name)
+    {
+      return false;
+    }
+    group_index++;
+  }
+  if (group_index != source.vertex_group_names.size()) {
+    return false;
+  }
+
+  /* Deformed buffers contain positions that are not in the mesh. */
+  if (source.use_armature_gpu_deform || mesh.runtime->armature_gpu_deform) {
+    r_positions_changed = true;
+  }
+  return mesh_source_layers_match(mesh.vert_data, source.layers[0], true, r_positions_changed) &&
+         mesh_source_layers_match(mesh.edge_data, source.layers[1], false, r_positions_changed) &&
+         mesh_source_layers_match(mesh.face_data, source.layers[2], false, r_positions_changed) &&
+         mesh_source_layers_match(mesh.corner_data, source.layers[3], false, r_positions_changed);
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Shared Batch Caches
+ *
+ * Linked duplicates with modifiers and meshes that were copied with implicit sharing have
+ * different evaluated meshes with the same data. Their batch caches are shared, so that the
+ * buffers are only extracted and uploaded once.
+ * \{ */
+
+struct SharedMeshBatchCaches {
+  /** Protects the map and the user counts, meshes can be freed from multiple threads. */
+  std::mutex mutex;
+  Map<uint64_t, Vector<MeshBatchCache *>> caches_by_hash;
+};
+
+static SharedMeshBatchCaches &shared_caches_get()
+{
+  static SharedMeshBatchCaches shared_caches;
+  return shared_caches;
+}
+
+static uint64_t mesh_batch_cache_shared_hash(const Mesh &mesh)
+{
+  return get_default_hash(mesh.verts_num,
+                          mesh.faces_num,
+                          mesh.face_offset_indices,
+                          CustomData_get_layer_named(&mesh.vert_data, CD_PROP_FLOAT3, "position"));
+}
+
+/** Meshes that are edited or deformed on the GPU use their own cache. */
+static bool mesh_batch_cache_can_share(const Object &object, const Mesh &mesh)
+{
+  return object.mode == OB_MODE_OBJECT && mesh.runtime->edit_mesh == nullptr &&
+         mesh.runtime->wrapper_type == ME_WRAPPER_TYPE_MDATA &&
+         !mesh.runtime->armature_gpu_deform && !BKE_subsurf_modifier_has_gpu_subdiv(&mesh);
+}
+
+/** Must be called with the mutex locked. */
+static void mesh_batch_cache_shared_remove(SharedMeshBatchCaches &shared_caches,
+                                           MeshBatchCache &cache)
+{
+  if (!cache.shared_source) {
+    return;
+  }
+  Vector<MeshBatchCache *> &caches = shared_caches.caches_by_hash.lookup(cache.shared_hash);
+  caches.remove_first_occurrence_and_reorder(&cache);
+  if (caches.is_empty()) {
+    shared_caches.caches_by_hash.remove(cache.shared_hash);
+  }
+  cache.shared_source.reset();
+}
+
+static void mesh_batch_cache_shared_add(const Object &object, const Mesh &mesh)
+{
+  MeshBatchCache &cache = *static_cast<MeshBatchCache *>(mesh.runtime->batch_cache);
+  if (!mesh_batch_cache_can_share(object, mesh)) {
+    return;
+  }
+  SharedMeshBatchCaches &shared_caches = shared_caches_get();
+  std::lock_guard lock{shared_caches.mutex};
+  cache.shared_source = mesh_batch_cache_source_create(mesh);
+  cache.shared_hash = mesh_batch_cache_shared_hash(mesh);
+  shared_caches.caches_by_hash.lookup_or_add_default(cache.shared_hash).append(&cache);
+}
+
+/** Find a cache of a mesh with the same data, the returned cache has a user for the mesh. */
+static MeshBatchCache *mesh_batch_cache_shared_find(Object &object, const Mesh &mesh)
+{
+  if (!mesh_batch_cache_can_share(object, mesh)) {
+    return nullptr;
+  }
+  const int mat_len = mesh_render_mat_len_get(object, mesh);
+  SharedMeshBatchCaches &shared_caches = shared_caches_get();
+  std::lock_guard lock{shared_caches.mutex};
+  const Vector<MeshBatchCache *> *caches = shared_caches.caches_by_hash.lookup_ptr(
+      mesh_batch_cache_shared_hash(mesh));
+  if (caches == nullptr) {
+    return nullptr;
+  }
+  for (MeshBatchCache *cache : *caches) {
+    bool positions_changed = false;
+    if (!cache->is_dirty && cache->mat_len == mat_len &&
+        mesh_batch_cache_source_matches(*cache->shared_source, mesh, positions_changed) &&
+        !positions_changed)
+    {
+      cache->users++;
+      return cache;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Remove a user from the cache. Returns true when the caller was the only user, then the cache
+ * isn't shared anymore and can be changed or freed.
+ */
+static bool mesh_batch_cache_shared_release(MeshBatchCache &cache)
+{
+  SharedMeshBatchCaches &shared_caches = shared_caches_get();
+  std::lock_guard lock{shared_caches.mutex};
+  if (cache.users > 1) {
+    cache.users--;
+    return false;
+  }
+  mesh_batch_cache_shared_remove(shared_caches, cache);
+  return true;
+}
+
+static bool mesh_batch_cache_is_shared(const MeshBatchCache &cache)
+{
+  SharedMeshBatchCaches &shared_caches = shared_caches_get();
+  std::lock_guard lock{shared_caches.mutex};
+  return cache.users > 1;
+}
+
+/** \} */
+
+void *DRW_mesh_batch_cache_take_for_reuse(Mesh *mesh)
+{
+  MeshBatchCache *cache = static_cast<MeshBatchCache *>(mesh->runtime->batch_cache);
+  if (cache == nullptr || cache->is_dirty || cache->is_editmode || cache->subdiv_cache ||
+      mesh->runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA)
+  {
+    return nullptr;
+  }
+  if (mesh_batch_cache_is_shared(*cache)) {
+    /* The cache stays with the other meshes. */
+    return nullptr;
+  }
+  mesh_batch_cache_shared_release(*cache);
+
+  cache->source = mesh_batch_cache_source_create(*mesh);
+  mesh->runtime->batch_cache = nullptr;
+  return cache;
+}
+
+/**
+ * Prepare a cache taken from the previous evaluated mesh for the new one. Deforming a mesh only
+ * changes its positions, so the buffers that don't depend on them (like UVs and attributes) are
+ * kept. Otherwise the cache can't be reused.
+ */
+static bool mesh_batch_cache_reuse(MeshBatchCache &cache, const Mesh &mesh)
+{
+  const MeshBatchCacheSource source = std::move(*cache.source);
+  cache.source.reset();
+
+  if (mesh.runtime->edit_mesh || mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA ||
+      BKE_subsurf_modifier_has_gpu_subdiv(&mesh))
+  {
+    return false;
+  }
+  bool positions_changed = false;
+  if (!mesh_batch_cache_source_matches(source, mesh, positions_changed)) {
+    return false;
+  }
+  if (positions_changed) {
+    mesh_batch_cache_discard_positions(cache);
+  }
+  return true;
+}
+
 /** \} */
 
 /* ---------------------------------------------------------------------- */
@@ -1913,6 +2274,19 @@ void DRW_mesh_batch_cache_create_requested(TaskGraph &task_graph,
     mesh_batch_cache_free_subdiv_cache(cache);
   }
 
+  /* The buffers are extracted from the undeformed mesh and deformed afterwards. Buffers that were
+   * extracted before are already deformed. */
+  gpu::VertBuf *armature_deform_pos = nullptr;
+  gpu::VertBuf *armature_deform_nor = nullptr;
+  if (mesh.runtime->armature_gpu_deform && !do_subdivision) {
+    if (DRW_vbo_requested(mbuflist->vbo.pos)) {
+      armature_deform_pos = mbuflist->vbo.pos;
+    }
+    if (DRW_vbo_requested(mbuflist->vbo.nor)) {
+      armature_deform_nor = mbuflist->vbo.nor;
+    }
+  }
+
   mesh_buffer_cache_create_requested(task_graph,
                                      cache,
                                      cache.final,
@@ -1936,6 +2310,8 @@ void DRW_mesh_batch_cache_create_requested(TaskGraph &task_graph,
    * based on the mode the correct one will be updated. Other option is to look into using
    * drw_batch_cache_generate_requested_delayed. */
   BLI_task_graph_work_and_wait(&task_graph);
+
+  draw_armature_deform_buffers(mesh, cache.final, armature_deform_pos, armature_deform_nor);
 #ifndef NDEBUG
   drw_mesh_batch_cache_check_available(task_graph, mesh);
 #endif
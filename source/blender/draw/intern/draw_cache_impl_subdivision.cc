@@ -656,8 +656,41 @@ static void draw_subdiv_free_edit_mode_cache(DRWSubdivCache &cache)
   GPU_VERTBUF_DISCARD_SAFE(cache.fdots_patch_coords);
 }
 
+/** Copy the fields that only depend on the topology and the resolution. */
+static void draw_subdiv_cache_copy_topology(DRWSubdivCache &dst, const DRWSubdivCache &src)
+{
+  dst.patch_coords = src.patch_coords;
+  dst.corner_patch_coords = src.corner_patch_coords;
+  dst.fdots_patch_coords = src.fdots_patch_coords;
+  dst.resolution = src.resolution;
+  dst.num_subdiv_loops = src.num_subdiv_loops;
+  dst.num_subdiv_edges = src.num_subdiv_edges;
+  dst.num_subdiv_verts = src.num_subdiv_verts;
+  dst.num_subdiv_quads = src.num_subdiv_quads;
+  dst.may_have_loose_geom = src.may_have_loose_geom;
+  dst.num_coarse_faces = src.num_coarse_faces;
+  dst.subdiv_loop_subdiv_vert_index = src.subdiv_loop_subdiv_vert_index;
+  dst.subdiv_loop_subdiv_edge_index = src.subdiv_loop_subdiv_edge_index;
+  dst.subdiv_loop_face_index = src.subdiv_loop_face_index;
+  dst.subdiv_vertex_face_adjacency = src.subdiv_vertex_face_adjacency;
+  dst.subdiv_vertex_face_adjacency_offsets = src.subdiv_vertex_face_adjacency_offsets;
+  dst.verts_orig_index = src.verts_orig_index;
+  dst.edges_orig_index = src.edges_orig_index;
+  dst.edges_draw_flag = src.edges_draw_flag;
+  dst.face_ptex_offset = src.face_ptex_offset;
+  dst.face_ptex_offset_buffer = src.face_ptex_offset_buffer;
+  dst.subdiv_face_offset = src.subdiv_face_offset;
+  dst.subdiv_face_offset_buffer = src.subdiv_face_offset_buffer;
+  dst.gpu_patch_map = src.gpu_patch_map;
+}
+
 void draw_subdiv_cache_free(DRWSubdivCache &cache)
 {
+  if (cache.shared_topology) {
+    /* The buffers are owned by the shared cache, which frees them when it is not used anymore. */
+    draw_subdiv_cache_copy_topology(cache, DRWSubdivCache());
+    cache.shared_topology.reset();
+  }
   GPU_VERTBUF_DISCARD_SAFE(cache.patch_coords);
   GPU_VERTBUF_DISCARD_SAFE(cache.corner_patch_coords);
   GPU_VERTBUF_DISCARD_SAFE(cache.face_ptex_offset_buffer);
@@ -1159,6 +1192,45 @@ static void build_vertex_face_adjacency_maps(DRWSubdivCache &cache)
   MEM_freeN(tmp_set_faces);
 }
 
+/**
+ * Reuse the topology buffers of the last mesh drawn with the same subdivision descriptor. The
+ * descriptor is only reused for meshes with the same topology. Edit-mode is skipped because the
+ * original indices and the edge draw flags depend on the edit-mesh.
+ */
+static bool draw_subdiv_cache_use_shared_topology(DRWSubdivCache &cache,
+                                                  const bke::subdiv::Subdiv &subdiv,
+                                                  const int resolution)
+{
+  if (cache.bm != nullptr || !subdiv.draw_cache) {
+    return false;
+  }
+  std::shared_ptr<DRWSubdivCache> shared = std::static_pointer_cast<DRWSubdivCache>(
+      subdiv.draw_cache);
+  if (shared->resolution != resolution || shared->optimal_display != cache.optimal_display) {
+    return false;
+  }
+  draw_subdiv_cache_copy_topology(cache, *shared);
+  cache.shared_topology = std::move(shared);
+  return true;
+}
+
+/** Move the topology buffers to a cache stored in the subdivision descriptor. */
+static void draw_subdiv_cache_share_topology(DRWSubdivCache &cache, bke::subdiv::Subdiv &subdiv)
+{
+  if (cache.bm != nullptr) {
+    return;
+  }
+  std::shared_ptr<DRWSubdivCache> shared(MEM_new<DRWSubdivCache>(__func__),
+                                         [](DRWSubdivCache *shared_cache) {
+                                           draw_subdiv_cache_free(*shared_cache);
+                                           MEM_delete(shared_cache);
+                                         });
+  draw_subdiv_cache_copy_topology(*shared, cache);
+  shared->optimal_display = cache.optimal_display;
+  cache.shared_topology = shared;
+  subdiv.draw_cache = std::move(shared);
+}
+
 static bool draw_subdiv_build_cache(DRWSubdivCache &cache,
                                     bke::subdiv::Subdiv *subdiv,
                                     const Mesh *mesh_eval,
@@ -1182,6 +1254,10 @@ static bool draw_subdiv_build_cache(DRWSubdivCache &cache,
     return true;
   }
 
+  if (draw_subdiv_cache_use_shared_topology(cache, *subdiv, to_mesh_settings.resolution)) {
+    return true;
+  }
+
   DRWCacheBuildingContext cache_building_context;
   memset(&cache_building_context, 0, sizeof(DRWCacheBuildingContext));
   cache_building_context.coarse_mesh = mesh_eval;
@@ -1266,6 +1342,8 @@ static bool draw_subdiv_build_cache(DRWSubdivCache &cache,
   MEM_SAFE_FREE(cache_building_context.edge_origindex_map);
   MEM_SAFE_FREE(cache_building_context.edge_draw_flag_map);
 
+  draw_subdiv_cache_share_topology(cache, *subdiv);
+
   return true;
 }
 
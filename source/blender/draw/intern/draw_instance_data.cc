@@ -60,6 +60,8 @@ struct DRWTempBufferHandle {
   GPUVertFormat *format;
   /** Touched vertex length for resize. */
   int *vert_len;
+  /** Vertex length of the last upload. Entries after it are not valid on the GPU. */
+  uint uploaded_len;
 };
 
 struct DRWTempInstancingHandle {
@@ -118,6 +120,7 @@ blender::gpu::VertBuf *DRW_temp_buffer_request(DRWInstanceDataList *idatalist,
     GPU_vertbuf_data_alloc(*vert, DRW_BUFFER_VERTS_CHUNK);
 
     handle->buf = vert;
+    handle->uploaded_len = 0;
   }
   handle->vert_len = vert_len;
   return handle->buf;
@@ -215,6 +218,14 @@ void DRW_instance_buffer_finish(DRWInstanceDataList *idatalist)
         GPU_vertbuf_data_resize(*handle->buf, target_buf_size);
       }
       GPU_vertbuf_data_len_set(*handle->buf, vert_len);
+      /* Entries are only written when they changed. Entries past the last upload were not sent
+       * even if they match the data left from an earlier redraw. */
+      if (vert_len > handle->uploaded_len) {
+        GPU_vertbuf_tag_dirty(handle->buf);
+      }
+      if (GPU_vertbuf_get_status(handle->buf) & GPU_VERTBUF_DATA_DIRTY) {
+        handle->uploaded_len = vert_len;
+      }
       GPU_vertbuf_use(handle->buf); /* Send data. */
     }
   }
@@ -7,6 +7,7 @@
  */
 
 #include "BKE_global.hh"
+#include "BLI_task.hh"
 #include "GPU_compute.hh"
 
 #include "draw_debug.hh"
@@ -63,6 +64,7 @@ void Manager::begin_sync()
 #endif
   resource_len_ = 0;
   attribute_len_ = 0;
+  deferred_bounds_.clear();
   /* TODO(fclem): Resize buffers if too big, but with an hysteresis threshold. */
 
   object_active = DST.draw_ctx.obact;
@@ -101,10 +103,26 @@ void Manager::sync_layer_attributes()
   layer_attributes_buf[0].buffer_length = count;
 }
 
+void Manager::compute_deferred_bounds()
+{
+  BLI_assert(deferred_bounds_.size() == resource_len_);
+  ObjectBoundsBuf &bounds = bounds_buf.current();
+  threading::parallel_for(deferred_bounds_.index_range(), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const DeferredBounds &deferred = deferred_bounds_[i];
+      if (deferred.object != nullptr) {
+        bounds[i].sync(*deferred.object, deferred.inflate);
+      }
+    }
+  });
+  deferred_bounds_.clear();
+}
+
 void Manager::end_sync()
 {
   GPU_debug_group_begin("Manager.end_sync");
 
+  compute_deferred_bounds();
   sync_layer_attributes();
 
   matrix_buf.current().push_update();
@@ -113,6 +113,19 @@ class Manager {
 
   Object *object_active = nullptr;
 
+  /** Object bounds whose computation is deferred to #end_sync(). */
+  struct DeferredBounds {
+    /** Null if the bounds of the resource were already computed. */
+    const Object *object;
+    float inflate;
+  };
+  /**
+   * Indexed by resource index. Computing the bounds can be costly (e.g. curves or lattices), so
+   * it is done for all resources at once in parallel. Dupli-objects are not deferred, since their
+   * #Object is a temporary copy that is only valid during the object iteration.
+   */
+  Vector<DeferredBounds> deferred_bounds_;
+
  public:
   Manager(){};
   ~Manager();
@@ -219,13 +232,26 @@ class Manager {
 
  private:
   void sync_layer_attributes();
+  void sync_object_bounds(const ObjectRef &ref, float inflate_bounds);
+  void compute_deferred_bounds();
 };
 
+inline void Manager::sync_object_bounds(const ObjectRef &ref, float inflate_bounds)
+{
+  ObjectBounds &bounds = bounds_buf.current().get_or_resize(resource_len_);
+  if (ref.dupli_object == nullptr) {
+    deferred_bounds_.append({ref.object, inflate_bounds});
+    return;
+  }
+  bounds.sync(*ref.object, inflate_bounds);
+  deferred_bounds_.append({nullptr, 0.0f});
+}
+
 inline ResourceHandle Manager::resource_handle(const ObjectRef ref, float inflate_bounds)
 {
   bool is_active_object = (ref.dupli_object ? ref.dupli_parent : ref.object) == object_active;
   matrix_buf.current().get_or_resize(resource_len_).sync(*ref.object);
-  bounds_buf.current().get_or_resize(resource_len_).sync(*ref.object, inflate_bounds);
+  sync_object_bounds(ref, inflate_bounds);
   infos_buf.current().get_or_resize(resource_len_).sync(ref, is_active_object);
   return ResourceHandle(resource_len_++, (ref.object->transflag & OB_NEG_SCALE) != 0);
 }
@@ -244,9 +270,10 @@ inline ResourceHandle Manager::resource_handle(const ObjectRef ref,
   }
   if (bounds_center && bounds_half_extent) {
     bounds_buf.current().get_or_resize(resource_len_).sync(*bounds_center, *bounds_half_extent);
+    deferred_bounds_.append({nullptr, 0.0f});
   }
   else {
-    bounds_buf.current().get_or_resize(resource_len_).sync(*ref.object);
+    sync_object_bounds(ref, 0.0f);
   }
   infos_buf.current().get_or_resize(resource_len_).sync(ref, is_active_object);
   return ResourceHandle(resource_len_++, (ref.object->transflag & OB_NEG_SCALE) != 0);
@@ -256,6 +283,7 @@ inline ResourceHandle Manager::resource_handle(const float4x4 &model_matrix)
 {
   matrix_buf.current().get_or_resize(resource_len_).sync(model_matrix);
   bounds_buf.current().get_or_resize(resource_len_).sync();
+  deferred_bounds_.append({nullptr, 0.0f});
   infos_buf.current().get_or_resize(resource_len_).sync();
   return ResourceHandle(resource_len_++, false);
 }
@@ -266,6 +294,7 @@ inline ResourceHandle Manager::resource_handle(const float4x4 &model_matrix,
 {
   matrix_buf.current().get_or_resize(resource_len_).sync(model_matrix);
   bounds_buf.current().get_or_resize(resource_len_).sync(bounds_center, bounds_half_extent);
+  deferred_bounds_.append({nullptr, 0.0f});
   infos_buf.current().get_or_resize(resource_len_).sync();
   return ResourceHandle(resource_len_++, false);
 }
@@ -276,6 +305,7 @@ inline ResourceHandle Manager::resource_handle_for_psys(const ObjectRef ref,
   bool is_active_object = (ref.dupli_object ? ref.dupli_parent : ref.object) == object_active;
   matrix_buf.current().get_or_resize(resource_len_).sync(model_matrix);
   bounds_buf.current().get_or_resize(resource_len_).sync();
+  deferred_bounds_.append({nullptr, 0.0f});
   infos_buf.current().get_or_resize(resource_len_).sync(ref, is_active_object);
   return ResourceHandle(resource_len_++, (ref.object->transflag & OB_NEG_SCALE) != 0);
 }
@@ -284,6 +314,11 @@ inline void Manager::update_handle_bounds(ResourceHandle handle,
                                           const ObjectRef ref,
                                           float inflate_bounds)
 {
+  DeferredBounds &deferred = deferred_bounds_[handle.resource_index()];
+  if (deferred.object != nullptr) {
+    deferred.inflate = inflate_bounds;
+    return;
+  }
   bounds_buf.current()[handle.resource_index()].sync(*ref.object, inflate_bounds);
 }
 
@@ -291,6 +326,7 @@ inline void Manager::update_handle_bounds(ResourceHandle handle,
                                           const float3 &bounds_center,
                                           const float3 &bounds_half_extent)
 {
+  deferred_bounds_[handle.resource_index()].object = nullptr;
   bounds_buf.current()[handle.resource_index()].sync(bounds_center, bounds_half_extent);
 }
 
@@ -22,6 +22,7 @@
 
 #include "BLT_translation.hh"
 
+#include "BKE_armature.hh"
 #include "BKE_context.hh"
 #include "BKE_curve.hh"
 #include "BKE_curves.h"
@@ -76,6 +77,7 @@
 #include "WM_api.hh"
 #include "wm_window.hh"
 
+#include "draw_armature_deform.hh"
 #include "draw_color_management.hh"
 #include "draw_manager_c.hh"
 #include "draw_manager_profiling.hh"
@@ -1047,8 +1049,11 @@ static void drw_engines_cache_init()
       DST.text_store_p = &data->text_draw_cache;
     }
 
+    data->sync_time = 0.0;
     if (engine->cache_init) {
+      PROFILE_START(stime);
       engine->cache_init(data);
+      PROFILE_END_ACCUM(data->sync_time, stime);
     }
   }
 }
@@ -1081,13 +1086,20 @@ static void drw_engines_cache_populate(Object *ob)
     drw_batch_cache_validate(ob);
   }
 
+  /* Measuring every object has a cost, only do it when profiling. */
+  const bool use_profiling = DRW_stats_is_enabled();
+
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (engine->id_update) {
       engine->id_update(data, &ob->id);
     }
 
     if (engine->cache_populate) {
+      const double stime = use_profiling ? BLI_time_now_seconds() : 0.0;
       engine->cache_populate(data, ob);
+      if (use_profiling) {
+        data->sync_time += (BLI_time_now_seconds() - stime) * 1e3;
+      }
     }
   }
 
@@ -1106,8 +1118,14 @@ static void drw_engines_cache_finish()
 {
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (engine->cache_finish) {
+      PROFILE_START(stime);
       engine->cache_finish(data);
+      PROFILE_END_ACCUM(data->sync_time, stime);
     }
+#ifdef USE_PROFILE
+    data->background_time = data->background_time * (1.0 - PROFILE_TIMER_FALLOFF) +
+                            data->sync_time * PROFILE_TIMER_FALLOFF;
+#endif
   }
 
   DRW_manager_end_sync();
@@ -2050,6 +2068,7 @@ void DRW_render_to_image(RenderEngine *engine, Depsgraph *depsgraph)
 
   drw_manager_exit(&DST);
   DRW_cache_free_old_subdiv();
+  DRW_cache_free_old_armature_deform();
 
   /* Reset state after drawing */
   DRW_state_reset();
@@ -3086,6 +3105,7 @@ void DRW_engines_register()
 
     BKE_mesh_batch_cache_dirty_tag_cb = DRW_mesh_batch_cache_dirty_tag;
     BKE_mesh_batch_cache_free_cb = DRW_mesh_batch_cache_free;
+    BKE_mesh_batch_cache_take_for_reuse_cb = DRW_mesh_batch_cache_take_for_reuse;
 
     BKE_lattice_batch_cache_dirty_tag_cb = DRW_lattice_batch_cache_dirty_tag;
     BKE_lattice_batch_cache_free_cb = DRW_lattice_batch_cache_free;
@@ -3109,6 +3129,7 @@ void DRW_engines_register()
     BKE_grease_pencil_batch_cache_free_cb = DRW_grease_pencil_batch_cache_free;
 
     BKE_subsurf_modifier_free_gpu_cache_cb = DRW_subdiv_cache_free;
+    blender::bke::armature_deform_free_gpu_cache_cb = DRW_armature_deform_cache_free;
   }
 }
 
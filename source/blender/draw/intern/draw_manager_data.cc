@@ -1584,7 +1584,13 @@ void DRW_buffer_add_entry_struct(DRWCallBuffer *callbuf, const void *data)
     GPU_vertbuf_data_resize(*buf, callbuf->count + DRW_BUFFER_VERTS_CHUNK);
   }
 
-  GPU_vertbuf_vert_set(buf, callbuf->count, data);
+  /* Buffers are reused across redraws. Only write (and tag the buffer for upload) if the entry
+   * changed, so that buffers of static scenes are not uploaded again. */
+  const uint stride = GPU_vertbuf_get_format(buf)->stride;
+  const uchar *dst = buf->data<uchar>().data() + callbuf->count * stride;
+  if (memcmp(dst, data, stride) != 0) {
+    GPU_vertbuf_vert_set(buf, callbuf->count, data);
+  }
 
   if (G.f & G_FLAG_PICKSEL) {
     if (UNLIKELY(resize)) {
@@ -1608,8 +1614,14 @@ void DRW_buffer_add_entry_array(DRWCallBuffer *callbuf, const void *attr[], uint
     GPU_vertbuf_data_resize(*buf, callbuf->count + DRW_BUFFER_VERTS_CHUNK);
   }
 
+  /* Only write changed attributes, see #DRW_buffer_add_entry_struct. */
+  const GPUVertFormat *format = GPU_vertbuf_get_format(buf);
+  const uchar *dst = buf->data<uchar>().data() + callbuf->count * format->stride;
   for (int i = 0; i < attr_len; i++) {
-    GPU_vertbuf_attr_set(buf, i, callbuf->count, attr[i]);
+    const GPUVertAttr &attr_format = format->attrs[i];
+    if (memcmp(dst + attr_format.offset, attr[i], attr_format.size) != 0) {
+      GPU_vertbuf_attr_set(buf, i, callbuf->count, attr[i]);
+    }
   }
 
   if (G.f & G_FLAG_PICKSEL) {
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -16,15 +17,21 @@
 
 #include "BLF_api.hh"
 
+#include "DNA_object_types.h"
+
 #include "MEM_guardedalloc.h"
 
 #include "draw_manager_c.hh"
 
 #include "GPU_debug.hh"
+#include "GPU_query.hh"
 #include "GPU_texture.hh"
+#include "GPU_vertex_buffer.hh"
 
 #include "UI_resources.hh"
 
+#include "DRW_profiling.hh"
+
 #include "draw_manager_profiling.hh"
 
 #define MAX_TIMER_NAME 32
@@ -33,7 +40,12 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 struct DRWTimer {
-  uint32_t query[2];
+  /**
+   * Index of the start and end timestamps in the pools of the current and the previous frame,
+   * -1 when they were not recorded.
+   */
+  int query_start[2];
+  int query_end[2];
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
@@ -48,23 +60,60 @@ static struct DRWTimerPool {
   int end_increment;   /* Keep track of bad usage. */
   bool is_recording;   /* Are we in the render loop? */
   bool is_querying;    /* Keep track of bad usage. */
+  bool is_enabled;     /* Record even when the statistics are not displayed. */
+  /* Index of the timers that are not ended yet, for each level. */
+  int timer_stack[MAX_NESTED_TIMER];
+  /* Timestamps of the current and the previous frame, null when not supported. */
+  GPUTimestampPool *timestamps[2];
+  int frame;
+  bool has_gpu_timings;
+  /* CPU time creating batches per object type, for the current frame and averaged. */
+  double batch_cache_time_accum[OB_TYPE_MAX];
+  double batch_cache_time[OB_TYPE_MAX];
+  size_t upload_size_start;
+  size_t upload_size;
 } DTP = {nullptr};
 
+/* Copy of the statistics of the last recorded frame, for #DRW_profiling_stats_get. */
+static blender::draw::ProfilingStats *last_stats = nullptr;
+
+static void drw_stats_timestamps_free()
+{
+  for (GPUTimestampPool *&pool : DTP.timestamps) {
+    if (pool != nullptr) {
+      GPU_timestamp_pool_free(pool);
+      pool = nullptr;
+    }
+  }
+}
+
 void DRW_stats_free()
 {
   if (DTP.timers != nullptr) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = nullptr;
   }
+  drw_stats_timestamps_free();
+  MEM_delete(last_stats);
+  last_stats = nullptr;
+}
+
+static void drw_stats_timers_init(const int start, const int end)
+{
+  for (int i = start; i < end; i++) {
+    DTP.timers[i].query_start[0] = DTP.timers[i].query_start[1] = -1;
+    DTP.timers[i].query_end[0] = DTP.timers[i].query_end[1] = -1;
+  }
+}
+
+bool DRW_stats_is_enabled()
+{
+  return (G.debug_value > 20 && G.debug_value < 30) || DTP.is_enabled;
 }
 
 void DRW_stats_begin()
 {
-  if (G.debug_value > 20 && G.debug_value < 30) {
+  if (DRW_stats_is_enabled()) {
     DTP.is_recording = true;
   }
 
@@ -73,11 +122,21 @@ void DRW_stats_begin()
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
     DTP.timers = static_cast<DRWTimer *>(
         MEM_callocN(sizeof(DRWTimer) * DTP.timer_count, "DRWTimer stack"));
+    drw_stats_timers_init(0, DTP.timer_count);
   }
   else if (!DTP.is_recording && DTP.timers != nullptr) {
     DRW_stats_free();
   }
 
+  if (DTP.is_recording) {
+    GPUTimestampPool *&pool = DTP.timestamps[DTP.frame & 1];
+    if (pool == nullptr) {
+      pool = GPU_timestamp_pool_create();
+    }
+    DTP.has_gpu_timings = pool != nullptr;
+    DTP.upload_size_start = GPU_vertbuf_get_upload_size();
+  }
+
   DTP.is_querying = false;
   DTP.timer_increment = 0;
   DTP.end_increment = 0;
@@ -87,10 +146,12 @@ static DRWTimer *drw_stats_timer_get()
 {
   if (UNLIKELY(DTP.timer_increment >= DTP.timer_count)) {
     /* Resize the stack. */
+    const int prev_timer_count = DTP.timer_count;
     DTP.chunk_count++;
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
     DTP.timers = static_cast<DRWTimer *>(
         MEM_recallocN(DTP.timers, sizeof(DRWTimer) * DTP.timer_count));
+    drw_stats_timers_init(prev_timer_count, DTP.timer_count);
   }
 
   return &DTP.timers[DTP.timer_increment++];
@@ -99,24 +160,38 @@ static DRWTimer *drw_stats_timer_get()
 static void drw_stats_timer_start_ex(const char *name, const bool is_query)
 {
   if (DTP.is_recording) {
+    const int timer_index = DTP.timer_increment;
     DRWTimer *timer = drw_stats_timer_get();
     STRNCPY(timer->name, name);
     timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
     timer->is_query = is_query;
+    if (timer->lvl < MAX_NESTED_TIMER) {
+      DTP.timer_stack[timer->lvl] = timer_index;
+    }
 
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
       DTP.is_querying = true;
     }
+
+    /* Timestamps can be nested, so groups are measured too. */
+    GPUTimestampPool *pool = DTP.timestamps[DTP.frame & 1];
+    timer->query_start[DTP.frame & 1] = pool ? GPU_timestamp_pool_record(pool) : -1;
+    timer->query_end[DTP.frame & 1] = -1;
+  }
+}
+
+static void drw_stats_timer_end()
+{
+  const int lvl = DTP.timer_increment - DTP.end_increment - 1;
+  DTP.end_increment++;
+  GPUTimestampPool *pool = DTP.timestamps[DTP.frame & 1];
+  if (pool == nullptr || lvl < 0 || lvl >= MAX_NESTED_TIMER) {
+    return;
   }
+  DRWTimer *timer = &DTP.timers[DTP.timer_stack[lvl]];
+  timer->query_end[DTP.frame & 1] = GPU_timestamp_pool_record(pool);
 }
 
 void DRW_stats_group_start(const char *name)
@@ -131,7 +206,7 @@ void DRW_stats_group_end()
   GPU_debug_group_end();
   if (DTP.is_recording) {
     BLI_assert(!DTP.is_querying);
-    DTP.end_increment++;
+    drw_stats_timer_end();
   }
 }
 
@@ -145,13 +220,74 @@ void DRW_stats_query_end()
 {
   GPU_debug_group_end();
   if (DTP.is_recording) {
-    DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    drw_stats_timer_end();
     DTP.is_querying = false;
   }
 }
 
+void DRW_stats_batch_cache_time_add(const int object_type, const double time)
+{
+  if (object_type >= 0 && object_type < OB_TYPE_MAX) {
+    DTP.batch_cache_time_accum[object_type] += time;
+  }
+}
+
+static const char *drw_stats_object_type_name(const int object_type)
+{
+  switch (object_type) {
+    case OB_MESH:
+      return "Mesh";
+    case OB_CURVES_LEGACY:
+      return "Curve";
+    case OB_SURF:
+      return "Surface";
+    case OB_FONT:
+      return "Text";
+    case OB_CURVES:
+      return "Curves";
+    case OB_POINTCLOUD:
+      return "Point Cloud";
+    case OB_VOLUME:
+      return "Volume";
+    case OB_GREASE_PENCIL:
+      return "Grease Pencil";
+    default:
+      return "Other";
+  }
+}
+
+static void drw_stats_snapshot_store()
+{
+  using namespace blender::draw;
+  if (last_stats == nullptr) {
+    last_stats = MEM_new<ProfilingStats>(__func__);
+  }
+  ProfilingStats &stats = *last_stats;
+  stats = {};
+
+  DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
+    stats.engines.append(
+        {engine->idname, data->init_time, data->background_time, data->render_time});
+  }
+  stats.cache_time = *DRW_view_data_cache_time_get(DST.view_data_active);
+
+  for (const int type : blender::IndexRange(OB_TYPE_MAX)) {
+    if (DTP.batch_cache_time[type] > 0.0) {
+      stats.batch_cache_times.append(
+          {drw_stats_object_type_name(type), DTP.batch_cache_time[type]});
+    }
+  }
+
+  if (DTP.has_gpu_timings) {
+    for (const int i : blender::IndexRange(DTP.timer_increment)) {
+      const DRWTimer &timer = DTP.timers[i];
+      stats.gpu_timings.append({timer.name, timer.lvl, timer.time_average / 1000000.0});
+    }
+  }
+  stats.upload_size = DTP.upload_size;
+}
+
 void DRW_stats_reset()
 {
   BLI_assert_msg((DTP.timer_increment - DTP.end_increment) <= 0,
@@ -160,40 +296,72 @@ void DRW_stats_reset()
                  "You forgot a DRW_stats_group/query_start somewhere!");
 
   if (DTP.is_recording) {
-    uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
+    /* Read the timestamps of the previous frame, the GPU is usually done with them. */
+    const int prev = (DTP.frame + 1) & 1;
+    blender::Array<uint64_t> timestamps;
+    if (DTP.timestamps[prev] != nullptr) {
+      timestamps.reinitialize(GPU_timestamp_pool_len(DTP.timestamps[prev]));
+      GPU_timestamp_pool_results(DTP.timestamps[prev], timestamps);
+      GPU_timestamp_pool_free(DTP.timestamps[prev]);
+      DTP.timestamps[prev] = nullptr;
+    }
 
-    /* Swap queries for the next frame and sum up each lvl time. */
-    for (int i = DTP.timer_increment - 1; i >= 0; i--) {
+    for (int i = 0; i < DTP.timer_increment; i++) {
       DRWTimer *timer = &DTP.timers[i];
-      std::swap(timer->query[0], timer->query[1]);
-
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
-      if (timer->is_query) {
-        uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
-        }
-        else {
-          time = 1000000000; /* 1ms default */
-        }
-
+      const int start = timer->query_start[prev];
+      const int end = timer->query_end[prev];
+      if (start >= 0 && end >= 0 && end < timestamps.size()) {
+        const uint64_t time = timestamps[end] - timestamps[start];
         timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
                               time * GPU_TIMER_FALLOFF;
         timer->time_average = std::min(timer->time_average, uint64_t(1000000000));
       }
-      else {
-        timer->time_average = lvl_time[timer->lvl + 1];
-        lvl_time[timer->lvl + 1] = 0;
-      }
+      timer->query_start[prev] = -1;
+      timer->query_end[prev] = -1;
+    }
 
-      lvl_time[timer->lvl] += timer->time_average;
+    for (const int type : blender::IndexRange(OB_TYPE_MAX)) {
+      DTP.batch_cache_time[type] = DTP.batch_cache_time[type] * (1.0 - GPU_TIMER_FALLOFF) +
+                                   DTP.batch_cache_time_accum[type] * GPU_TIMER_FALLOFF;
     }
+    DTP.upload_size = GPU_vertbuf_get_upload_size() - DTP.upload_size_start;
 
+    drw_stats_snapshot_store();
+
+    DTP.frame++;
     DTP.is_recording = false;
   }
+  else {
+    drw_stats_timestamps_free();
+  }
+  std::fill_n(DTP.batch_cache_time_accum, OB_TYPE_MAX, 0.0);
+}
+
+namespace blender::draw {
+
+void DRW_profiling_enable(const bool enable)
+{
+  DTP.is_enabled = enable;
+}
+
+bool DRW_profiling_is_enabled()
+{
+  return DRW_stats_is_enabled();
+}
+
+bool DRW_profiling_stats_get(ProfilingStats &r_stats)
+{
+  if (last_stats == nullptr) {
+    return false;
+  }
+  r_stats = *last_stats;
+  return true;
 }
 
+}  // namespace blender::draw
+
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
 {
   BLF_draw_default(rect->xmin + (1 + u * 5) * U.widget_unit,
@@ -230,7 +398,7 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   STRNCPY(col_label, "Init");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
-  STRNCPY(col_label, "Background");
+  STRNCPY(col_label, "Sync");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   STRNCPY(col_label, "Render");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
@@ -283,7 +451,21 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   SNPRINTF(time_to_txt, "%.2fms", *cache_time);
   draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
-  v += 2;
+  v++;
+
+  /* Batch cache creation per object type. */
+  for (const int type : blender::IndexRange(OB_TYPE_MAX)) {
+    if (DTP.batch_cache_time[type] <= 0.0) {
+      continue;
+    }
+    u = 0;
+    SNPRINTF(stat_string, "Batches (%s)", drw_stats_object_type_name(type));
+    draw_stat_5row(rect, u++, v, stat_string, sizeof(stat_string));
+    SNPRINTF(time_to_txt, "%.2fms", DTP.batch_cache_time[type]);
+    draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+    v++;
+  }
+  v++;
 
   /* ------------------------------------------ */
   /* ---------------- GPU stats --------------- */
@@ -305,9 +487,19 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
   SNPRINTF(stat_string, "%.2fMB", double(vbo_mem) / 1000000.0);
   draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  STRNCPY(stat_string, "Uploads");
+  draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
+  SNPRINTF(stat_string, "%.2fMB", double(DTP.upload_size) / 1000000.0);
+  draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
   v += 1;
 
   /* GPU Timings */
+  if (!DTP.has_gpu_timings) {
+    STRNCPY(stat_string, "GPU Render Timings (not supported by the GPU backend)");
+    draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
+    BLF_batch_draw_end();
+    return;
+  }
   STRNCPY(stat_string, "GPU Render Timings");
   draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
 
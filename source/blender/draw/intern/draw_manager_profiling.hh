@@ -28,3 +28,8 @@ void DRW_stats_query_start(const char *name);
 void DRW_stats_query_end();
 
 void DRW_stats_draw(const rcti *rect);
+
+/** Whether the statistics are recorded, the cost of measuring small steps is only paid then. */
+bool DRW_stats_is_enabled();
+/** Add CPU time in milliseconds spent creating the requested batches of an object. */
+void DRW_stats_batch_cache_time_add(int object_type, double time);
@@ -96,19 +96,42 @@ static std::string calc_request_key(const AttributeRequest &request)
   return buf;
 }
 
+static DirtyData dirty_data_for_request(const AttributeRequest &request)
+{
+  if (const CustomRequest *request_type = std::get_if<CustomRequest>(&request)) {
+    switch (*request_type) {
+      case CustomRequest::Position:
+      case CustomRequest::Normal:
+        return DirtyData::Positions;
+      case CustomRequest::Mask:
+        return DirtyData::Mask;
+      case CustomRequest::FaceSet:
+        return DirtyData::FaceSets;
+    }
+    BLI_assert_unreachable();
+  }
+  return DirtyData::Attributes;
+}
+
 struct PBVHVbo {
   AttributeRequest request;
   gpu::VertBuf *vert_buf = nullptr;
   std::string key;
+  /** The data that has to change for the buffer to be filled again. */
+  DirtyData dependencies;
+  /** False when the buffer has been cleared, then it has to be filled in any case. */
+  bool is_filled = false;
 
   PBVHVbo(const AttributeRequest &request) : request(request)
   {
     key = calc_request_key(request);
+    dependencies = dirty_data_for_request(request);
   }
 
   void clear_data()
   {
     GPU_vertbuf_clear(vert_buf);
+    is_filled = false;
   }
 };
 
@@ -350,7 +373,7 @@ struct PBVHBatches {
   PBVHBatches(const PBVH_GPU_Args &args);
   ~PBVHBatches();
 
-  void update(const PBVH_GPU_Args &args);
+  void update(const PBVH_GPU_Args &args, DirtyData dirty);
   void update_pre(const PBVH_GPU_Args &args);
 
   int create_vbo(const AttributeRequest &request, const PBVH_GPU_Args &args);
@@ -1076,23 +1099,36 @@ static void fill_vbo_bmesh(PBVHVbo &vbo, const PBVH_GPU_Args &args)
   }
 }
 
-void PBVHBatches::update(const PBVH_GPU_Args &args)
+static void fill_vbo(PBVHVbo &vbo, const PBVH_GPU_Args &args, const bool use_flat_layout)
+{
+  switch (args.pbvh_type) {
+    case PBVH_FACES:
+      fill_vbo_faces(vbo, args);
+      break;
+    case PBVH_GRIDS:
+      fill_vbo_grids(vbo, args, use_flat_layout);
+      break;
+    case PBVH_BMESH:
+      fill_vbo_bmesh(vbo, args);
+      break;
+  }
+  vbo.is_filled = true;
+}
+
+void PBVHBatches::update(const PBVH_GPU_Args &args, const DirtyData dirty)
 {
+  /* The index buffers only depend on the topology and visibility, which cause a rebuild of the
+   * batches when changed. So they are kept when only the data changes. */
   if (!this->lines_index) {
     create_index(args);
   }
   for (PBVHVbo &vbo : this->vbos) {
-    switch (args.pbvh_type) {
-      case PBVH_FACES:
-        fill_vbo_faces(vbo, args);
-        break;
-      case PBVH_GRIDS:
-        fill_vbo_grids(vbo, args, this->use_flat_layout);
-        break;
-      case PBVH_BMESH:
-        fill_vbo_bmesh(vbo, args);
-        break;
+    /* Buffers of unchanged data are not filled again. Their data has been freed after it was sent
+     * to the GPU, so they also aren't uploaded again when flushing. */
+    if (vbo.is_filled && !bool(dirty & vbo.dependencies)) {
+      continue;
     }
+    fill_vbo(vbo, args, this->use_flat_layout);
   }
 }
 
@@ -1145,17 +1181,7 @@ int PBVHBatches::create_vbo(const AttributeRequest &request, const PBVH_GPU_Args
 
   vbos.append_as(request);
   vbos.last().vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
-  switch (args.pbvh_type) {
-    case PBVH_FACES:
-      fill_vbo_faces(vbos.last(), args);
-      break;
-    case PBVH_GRIDS:
-      fill_vbo_grids(vbos.last(), args, use_flat_layout);
-      break;
-    case PBVH_BMESH:
-      fill_vbo_bmesh(vbos.last(), args);
-      break;
-  }
+  fill_vbo(vbos.last(), args, use_flat_layout);
 
   return vbos.index_range().last();
 }
@@ -1557,9 +1583,9 @@ static PBVHBatch &ensure_batch(PBVHBatches &batches,
   });
 }
 
-void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args)
+void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args, const DirtyData dirty)
 {
-  batches->update(args);
+  batches->update(args, dirty);
 }
 
 void node_gpu_flush(PBVHBatches *batches)
@@ -16,6 +16,9 @@
 #include "BLI_rect.h"
 
 #include "DNA_screen_types.h"
+#include "DNA_view3d_types.h"
+
+#include "ED_view3d.hh"
 
 #include "GPU_select.hh"
 
@@ -32,24 +35,45 @@
 using blender::int2;
 using blender::Span;
 
-bool SELECTID_Context::is_dirty(RegionView3D *rv3d)
+void SELECTID_Context::view_state_store(const ARegion *region, const View3D *v3d)
+{
+  const RegionView3D *rv3d = static_cast<const RegionView3D *>(region->regiondata);
+  copy_m4_m4(this->persmat, rv3d->persmat);
+  this->size[0] = region->winx;
+  this->size[1] = region->winy;
+  this->retopology_offset = RETOPOLOGY_ENABLED(v3d) ? RETOPOLOGY_OFFSET(v3d) : 0.0f;
+  this->overlay_edit_flag = v3d->overlay.edit_flag;
+  this->use_xray = XRAY_ENABLED(v3d);
+  this->use_clipping = RV3D_CLIPPING_ENABLED(v3d, rv3d);
+}
+
+bool SELECTID_Context::is_dirty(const ARegion *region, const View3D *v3d)
 {
   /* Check if the viewport has changed. */
-  float(*persmat)[4] = rv3d->persmat;
-  bool is_dirty = !compare_m4m4(this->persmat, persmat, FLT_EPSILON);
-
-  if (!is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
-    for (Object *obj_eval : this->objects) {
-      DrawData *data = DRW_drawdata_get(&obj_eval->id, &draw_engine_select_type);
-      if (!data || (data->recalc & ID_RECALC_TRANSFORM)) {
-        is_dirty = true;
-        break;
-      }
-    }
+  const RegionView3D *rv3d = static_cast<const RegionView3D *>(region->regiondata);
+  if (!compare_m4m4(this->persmat, rv3d->persmat, FLT_EPSILON)) {
+    return true;
+  }
+  if (this->size[0] != region->winx || this->size[1] != region->winy) {
+    return true;
+  }
+  const float retopology_offset = RETOPOLOGY_ENABLED(v3d) ? RETOPOLOGY_OFFSET(v3d) : 0.0f;
+  if (this->retopology_offset != retopology_offset ||
+      this->overlay_edit_flag != v3d->overlay.edit_flag || this->use_xray != XRAY_ENABLED(v3d) ||
+      this->use_clipping != RV3D_CLIPPING_ENABLED(v3d, rv3d))
+  {
+    return true;
   }
 
-  return is_dirty;
+  /* Check if any of the drawn objects have been transformed or their geometry changed. Selection
+   * changes only tag the batch cache and do not affect the indices. */
+  for (Object *obj_eval : this->objects) {
+    DrawData *data = DRW_drawdata_get(&obj_eval->id, &draw_engine_select_type);
+    if (!data || (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY))) {
+      return true;
+    }
+  }
+  return false;
 }
 
 /* -------------------------------------------------------------------- */
@@ -74,11 +98,10 @@ uint *DRW_select_buffer_read(
   rcti rect_clamp = *rect;
   if (BLI_rcti_isect(&r, &rect_clamp, &rect_clamp)) {
     SELECTID_Context *select_ctx = DRW_select_engine_context_get();
-    RegionView3D *rv3d = static_cast<RegionView3D *>(region->regiondata);
 
     DRW_gpu_context_enable();
 
-    if (select_ctx->is_dirty(rv3d)) {
+    if (select_ctx->is_dirty(region, v3d)) {
       /* Update drawing. */
       DRW_draw_select_id(depsgraph, region, v3d);
     }
@@ -479,6 +502,20 @@ void DRW_select_buffer_context_create(Depsgraph *depsgraph,
 {
   SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
+  /* Keep the buffer of the previous operator when it was drawn for the same objects. */
+  bool is_same_context = select_ctx->select_mode == select_mode &&
+                         select_ctx->objects.size() == bases.size();
+  for (const int i : bases.index_range()) {
+    if (!is_same_context) {
+      break;
+    }
+    Object *obj_eval = DEG_get_evaluated_object(depsgraph, bases[i]->object);
+    is_same_context = select_ctx->objects[i] == obj_eval;
+  }
+  if (is_same_context) {
+    return;
+  }
+
   select_ctx->objects.reinitialize(bases.size());
   select_ctx->index_offsets.reinitialize(bases.size());
 
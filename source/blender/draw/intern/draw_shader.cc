@@ -24,6 +24,7 @@ static struct {
   GPUShader *debug_print_display_sh;
   GPUShader *debug_draw_display_sh;
   GPUShader *draw_visibility_compute_sh;
+  GPUShader *draw_visibility_occlusion_compute_sh;
   GPUShader *draw_view_finalize_sh;
   GPUShader *draw_resource_finalize_sh;
   GPUShader *draw_command_generate_sh;
@@ -84,6 +85,15 @@ GPUShader *DRW_shader_draw_visibility_compute_get()
   return e_data.draw_visibility_compute_sh;
 }
 
+GPUShader *DRW_shader_draw_visibility_occlusion_compute_get()
+{
+  if (e_data.draw_visibility_occlusion_compute_sh == nullptr) {
+    e_data.draw_visibility_occlusion_compute_sh = GPU_shader_create_from_info_name(
+        "draw_visibility_occlusion_compute");
+  }
+  return e_data.draw_visibility_occlusion_compute_sh;
+}
+
 GPUShader *DRW_shader_draw_view_finalize_get()
 {
   if (e_data.draw_view_finalize_sh == nullptr) {
@@ -118,6 +128,7 @@ void DRW_shaders_free()
   DRW_SHADER_FREE_SAFE(e_data.debug_print_display_sh);
   DRW_SHADER_FREE_SAFE(e_data.debug_draw_display_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_visibility_compute_sh);
+  DRW_SHADER_FREE_SAFE(e_data.draw_visibility_occlusion_compute_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_view_finalize_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_resource_finalize_sh);
   DRW_SHADER_FREE_SAFE(e_data.draw_command_generate_sh);
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "BLI_array.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
@@ -137,6 +139,12 @@ struct DRWSubdivCache {
    */
   Array<float3> loose_edge_positions;
 
+  /**
+   * Cache that owns the buffers which only depend on the topology, when they are shared with the
+   * caches of other meshes. See #bke::subdiv::Subdiv::draw_cache.
+   */
+  std::shared_ptr<DRWSubdivCache> shared_topology;
+
   /* UBO to store settings for the various compute shaders. */
   GPUUniformBuf *ubo;
 
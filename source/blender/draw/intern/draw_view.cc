@@ -276,8 +276,15 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
   GPU_storagebuf_clear(visibility_buf_, data);
 
   if (do_visibility_) {
-    GPUShader *shader = DRW_shader_draw_visibility_compute_get();
+    const bool use_occlusion = hiz_tx_ != nullptr && view_len_ == 1 && !frozen_;
+    GPUShader *shader = use_occlusion ? DRW_shader_draw_visibility_occlusion_compute_get() :
+                                        DRW_shader_draw_visibility_compute_get();
     GPU_shader_bind(shader);
+    if (use_occlusion) {
+      GPU_texture_bind(hiz_tx_, GPU_shader_get_sampler_binding(shader, "hiz_tx"));
+      GPU_shader_uniform_2fv(shader, "hiz_uv_scale", hiz_uv_scale_);
+      GPU_shader_uniform_1i(shader, "hiz_lod_max", GPU_texture_mip_count(hiz_tx_) - 1);
+    }
     GPU_shader_uniform_1i(shader, "resource_len", resource_len);
     GPU_shader_uniform_1i(shader, "view_len", view_len_);
     GPU_shader_uniform_1i(shader, "visibility_word_per_draw", word_per_draw);
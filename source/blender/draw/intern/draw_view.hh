@@ -43,6 +43,9 @@ class View {
   UniformArrayBuffer<ViewCullingData, DRW_VIEW_MAX> culling_freeze_;
   /** Result of the visibility computation. 1 bit or 1 or 2 word per resource ID per view. */
   VisibilityBuf visibility_buf_;
+  /** Optional Hierarchical-Z buffer used for occlusion culling. Not owned. */
+  GPUTexture *hiz_tx_ = nullptr;
+  float2 hiz_uv_scale_ = float2(1.0f);
 
   const char *debug_name_;
 
@@ -79,6 +82,19 @@ class View {
     do_visibility_ = enable;
   }
 
+  /**
+   * Enable occlusion culling against a Hierarchical-Z buffer containing the farthest depth of
+   * each texel footprint in its mip levels (e.g. EEVEE's #HiZBuffer). The depth must have been
+   * rendered with this view's current matrices. \a uv_scale maps the screen UVs to the texture
+   * UVs if the texture is padded. Pass nullptr to disable.
+   * Only supported for single views, the test is skipped if culling is frozen for debugging.
+   */
+  void occlusion_test(GPUTexture *hiz_tx, float2 uv_scale = float2(1.0f))
+  {
+    hiz_tx_ = hiz_tx;
+    hiz_uv_scale_ = uv_scale;
+  }
+
   /**
    * Update culling data using a compute shader.
    * This is to be used if the matrices were updated externally
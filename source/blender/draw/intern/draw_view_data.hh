@@ -62,6 +62,8 @@ struct ViewportEngineData {
   double init_time;
   double render_time;
   double background_time;
+  /** Time spent in the cache callbacks of the current redraw, averaged into #background_time. */
+  double sync_time;
 };
 
 struct ViewportEngineData_Info {
@@ -0,0 +1,154 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/* Linear blend skinning of the position and normal vertex buffers of a mesh, see
+ * #blender::bke::ArmatureGPUDeform. The buffers contain the undeformed data and are deformed in
+ * place. */
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+/* Number of elements in the position buffer. The first elements are the face corners, which are
+ * the only elements in the normal buffer. */
+uniform int elements_num;
+uniform int corners_num;
+
+layout(std430, binding = 0) readonly buffer inputWeightOffsets
+{
+  int weight_offsets[];
+};
+
+layout(std430, binding = 1) readonly buffer inputWeightGroups
+{
+  int weight_groups[];
+};
+
+layout(std430, binding = 2) readonly buffer inputWeights
+{
+  float weights[];
+};
+
+layout(std430, binding = 3) readonly buffer inputGroupMatrices
+{
+  mat4 group_matrices[];
+};
+
+/* The vertex of every element in the position buffer. */
+layout(std430, binding = 4) readonly buffer inputElementVerts
+{
+  int element_verts[];
+};
+
+layout(std430, binding = 5) buffer outputPositions
+{
+  float positions[];
+};
+
+#ifdef NORMALS
+#  ifdef HQ_NORMALS
+/* Four 16 bit integers. */
+layout(std430, binding = 6) buffer outputNormals
+{
+  uint normals[];
+};
+#  else
+/* #GPUPackedNormal. */
+layout(std430, binding = 6) buffer outputNormals
+{
+  int normals[];
+};
+#  endif
+#endif
+
+uint get_global_invocation_index()
+{
+  uint invocations_per_row = gl_WorkGroupSize.x * gl_NumWorkGroups.x;
+  return gl_GlobalInvocationID.x + gl_GlobalInvocationID.y * invocations_per_row;
+}
+
+/* Same as #blender::bke::armature_gpu_deform_positions: the weights may add up to less than one,
+ * the rest of the vertex stays in place. */
+mat4 blended_matrix(int vert)
+{
+  mat4 result = mat4(1.0);
+  for (int i = weight_offsets[vert]; i < weight_offsets[vert + 1]; i++) {
+    result += weights[i] * (group_matrices[weight_groups[i]] - mat4(1.0));
+  }
+  return result;
+}
+
+#ifdef NORMALS
+/* Transform a normal with the cofactor matrix, which is the inverse transpose scaled by the
+ * determinant. The scale does not matter because the normal is normalized afterwards. */
+vec3 transform_normal(mat3 m, vec3 n)
+{
+  mat3 cofactor = mat3(cross(m[1], m[2]), cross(m[2], m[0]), cross(m[0], m[1]));
+  vec3 result = cofactor * n;
+  float len_squared = dot(result, result);
+  return (len_squared > 1e-35) ? result * inversesqrt(len_squared) : n;
+}
+
+#  ifdef HQ_NORMALS
+vec3 read_normal(uint index)
+{
+  uint xy = normals[index * 2u];
+  uint z = normals[index * 2u + 1u];
+  return vec3(bitfieldExtract(int(xy), 0, 16),
+              bitfieldExtract(int(xy), 16, 16),
+              bitfieldExtract(int(z), 0, 16)) /
+         32767.0;
+}
+
+void write_normal(uint index, vec3 n)
+{
+  ivec3 packed_n = ivec3(clamp(n, -1.0, 1.0) * 32767.0);
+  uint xy = bitfieldInsert(uint(packed_n.x) & 0xFFFFu, uint(packed_n.y), 16, 16);
+  /* Keep the fourth component, which contains the flags for paint modes. */
+  uint zw = bitfieldInsert(normals[index * 2u + 1u], uint(packed_n.z), 0, 16);
+  normals[index * 2u] = xy;
+  normals[index * 2u + 1u] = zw;
+}
+#  else
+vec3 read_normal(uint index)
+{
+  int packed_n = normals[index];
+  return vec3(bitfieldExtract(packed_n, 0, 10),
+              bitfieldExtract(packed_n, 10, 10),
+              bitfieldExtract(packed_n, 20, 10)) /
+         511.0;
+}
+
+void write_normal(uint index, vec3 n)
+{
+  ivec3 packed_n = clamp(ivec3(n * 511.0), -512, 511);
+  int result = normals[index];
+  result = bitfieldInsert(result, packed_n.x, 0, 10);
+  result = bitfieldInsert(result, packed_n.y, 10, 10);
+  result = bitfieldInsert(result, packed_n.z, 20, 10);
+  normals[index] = result;
+}
+#  endif
+#endif
+
+void main()
+{
+  uint index = get_global_invocation_index();
+  if (index >= uint(elements_num)) {
+    return;
+  }
+
+  mat4 m = blended_matrix(element_verts[index]);
+
+  vec3 position = vec3(
+      positions[index * 3u], positions[index * 3u + 1u], positions[index * 3u + 2u]);
+  position = (m * vec4(position, 1.0)).xyz;
+  positions[index * 3u] = position.x;
+  positions[index * 3u + 1u] = position.y;
+  positions[index * 3u + 2u] = position.z;
+
+#ifdef NORMALS
+  if (index < uint(corners_num)) {
+    write_normal(index, transform_normal(mat3(m), read_normal(index)));
+  }
+#endif
+}
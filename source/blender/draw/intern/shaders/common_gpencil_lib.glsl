@@ -93,14 +93,31 @@ float gpencil_clamp_small_stroke_thickness(float thickness, vec4 ndc_pos)
 
 #ifdef GPU_VERTEX_SHADER
 
+/**
+ * Returns the vertex id as stored in the index buffer.
+ * Procedural strokes are drawn without index buffer and are expanded to the same ids here.
+ */
+int gpencil_vertex_id()
+{
+  if (!flag_test(gl_VertexID, GP_IS_PROCEDURAL_STROKE_BIT)) {
+    return gl_VertexID;
+  }
+  int procedural_id = gl_VertexID & ~GP_IS_PROCEDURAL_STROKE_BIT;
+  int point_id = procedural_id / 6;
+  /* Same quad corner order as the index buffer: 0, 1, 2, 2, 1, 3. */
+  int corner = procedural_id % 6;
+  corner = (corner < 3) ? corner : ((corner == 5) ? 3 : (5 - corner));
+  return ((point_id << GP_VERTEX_ID_SHIFT) | GP_IS_STROKE_VERTEX_BIT) + corner;
+}
+
 int gpencil_stroke_point_id()
 {
-  return (gl_VertexID & ~GP_IS_STROKE_VERTEX_BIT) >> GP_VERTEX_ID_SHIFT;
+  return (gpencil_vertex_id() & ~GP_IS_STROKE_VERTEX_BIT) >> GP_VERTEX_ID_SHIFT;
 }
 
 bool gpencil_is_stroke_vertex()
 {
-  return flag_test(gl_VertexID, GP_IS_STROKE_VERTEX_BIT);
+  return flag_test(gpencil_vertex_id(), GP_IS_STROKE_VERTEX_BIT);
 }
 
 /**
@@ -150,7 +167,8 @@ vec4 gpencil_vertex(vec4 viewport_size,
                     /* Stroke hardness. */
                     out float out_hardness)
 {
-  int stroke_point_id = (gl_VertexID & ~GP_IS_STROKE_VERTEX_BIT) >> GP_VERTEX_ID_SHIFT;
+  int vertex_id = gpencil_vertex_id();
+  int stroke_point_id = (vertex_id & ~GP_IS_STROKE_VERTEX_BIT) >> GP_VERTEX_ID_SHIFT;
 
   /* Attribute Loading. */
   vec4 pos = texelFetch(gp_pos_tx, (stroke_point_id - 1) * 3 + 0);
@@ -180,7 +198,7 @@ vec4 gpencil_vertex(vec4 viewport_size,
 
   vec4 out_ndc;
 
-  if (gpencil_is_stroke_vertex()) {
+  if (flag_test(vertex_id, GP_IS_STROKE_VERTEX_BIT)) {
     bool is_dot = flag_test(material_flags, GP_STROKE_ALIGNMENT);
     bool is_squares = !flag_test(material_flags, GP_STROKE_DOTS);
 
@@ -190,16 +208,16 @@ vec4 gpencil_vertex(vec4 viewport_size,
       is_squares = false;
     }
 
-    /* Endpoints, we discard the vertices. */
-    if (!is_dot && ma2.x == -1) {
+    /* Endpoints and the padding between procedural strokes, we discard the vertices. */
+    if ((!is_dot && ma2.x == -1) || ma1.x == -1) {
       /* We set the vertex at the camera origin to generate 0 fragments. */
       out_ndc = vec4(0.0, 0.0, -3e36, 0.0);
       return out_ndc;
     }
 
     /* Avoid using a vertex attribute for quad positioning. */
-    float x = float(gl_VertexID & 1) * 2.0 - 1.0; /* [-1..1] */
-    float y = float(gl_VertexID & 2) - 1.0;       /* [-1..1] */
+    float x = float(vertex_id & 1) * 2.0 - 1.0; /* [-1..1] */
+    float y = float(vertex_id & 2) - 1.0;       /* [-1..1] */
 
     bool use_curr = is_dot || (x == -1.0);
 
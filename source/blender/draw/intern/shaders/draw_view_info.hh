@@ -215,6 +215,14 @@ GPU_SHADER_CREATE_INFO(draw_visibility_compute)
     .compute_source("draw_visibility_comp.glsl")
     .additional_info("draw_view", "draw_view_culling");
 
+GPU_SHADER_CREATE_INFO(draw_visibility_occlusion_compute)
+    .do_static_compilation(true)
+    .define("DRW_VISIBILITY_OCCLUSION")
+    .sampler(0, ImageType::FLOAT_2D, "hiz_tx")
+    .push_constant(Type::VEC2, "hiz_uv_scale")
+    .push_constant(Type::INT, "hiz_lod_max")
+    .additional_info("draw_visibility_compute");
+
 GPU_SHADER_CREATE_INFO(draw_command_generate)
     .do_static_compilation(true)
     .typedef_source("draw_shader_shared.hh")
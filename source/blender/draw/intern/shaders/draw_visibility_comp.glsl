@@ -6,6 +6,8 @@
  * Compute visibility of each resource bounds for a given view.
  */
 /* TODO(fclem): This could be augmented by a 2 pass occlusion culling system. */
+/* With `DRW_VISIBILITY_OCCLUSION` defined, the bounds are also tested against a Hierarchical-Z
+ * buffer. Only supported for single views. */
 
 #pragma BLENDER_REQUIRE(common_view_lib.glsl)
 #pragma BLENDER_REQUIRE(common_math_lib.glsl)
@@ -24,6 +26,49 @@ void mask_visibility_bit(uint view_id)
   }
 }
 
+#ifdef DRW_VISIBILITY_OCCLUSION
+/**
+ * Return true if the box is entirely behind the depth stored inside the HiZ buffer.
+ * The HiZ buffer stores the farthest depth of each texel footprint, so testing the nearest depth
+ * of the box against the 2x2 texels covering its screen footprint is conservative.
+ */
+bool is_occluded(IsectBox box)
+{
+  vec2 uv_min = vec2(1.0);
+  vec2 uv_max = vec2(0.0);
+  float depth_min = 1.0;
+  for (int i = 0; i < 8; i++) {
+    vec4 ndc = point_world_to_ndc(box.corners[i]);
+    if (ndc.w <= 0.0) {
+      /* Crosses the camera plane, the projection isn't valid. */
+      return false;
+    }
+    vec3 co = (ndc.xyz / ndc.w) * 0.5 + 0.5;
+    uv_min = min(uv_min, co.xy);
+    uv_max = max(uv_max, co.xy);
+    depth_min = min(depth_min, co.z);
+  }
+  uv_min = clamp(uv_min, 0.0, 1.0) * hiz_uv_scale;
+  uv_max = clamp(uv_max, 0.0, 1.0) * hiz_uv_scale;
+
+  /* Choose the level where the footprint covers at most 2x2 texels. */
+  vec2 footprint = (uv_max - uv_min) * vec2(textureSize(hiz_tx, 0));
+  int lod = int(ceil(log2(max(1.0, max(footprint.x, footprint.y)))));
+  if (lod > hiz_lod_max) {
+    return false;
+  }
+  ivec2 lod_size = textureSize(hiz_tx, lod);
+  ivec2 texel_min = clamp(ivec2(uv_min * vec2(lod_size)), ivec2(0), lod_size - 1);
+  ivec2 texel_max = clamp(ivec2(uv_max * vec2(lod_size)), ivec2(0), lod_size - 1);
+
+  float hiz_depth = max(max(texelFetch(hiz_tx, texel_min, lod).r,
+                            texelFetch(hiz_tx, ivec2(texel_max.x, texel_min.y), lod).r),
+                        max(texelFetch(hiz_tx, ivec2(texel_min.x, texel_max.y), lod).r,
+                            texelFetch(hiz_tx, texel_max, lod).r));
+  return depth_min > hiz_depth;
+}
+#endif
+
 void main()
 {
   if (int(gl_GlobalInvocationID.x) >= resource_len) {
@@ -48,6 +93,12 @@ void main()
       }
       else if (intersect_view(inscribed_sphere) == true) {
         /* Visible. */
+#ifdef DRW_VISIBILITY_OCCLUSION
+        if (is_occluded(box)) {
+          /* Hidden behind other surfaces. */
+          mask_visibility_bit(drw_view_id);
+        }
+#endif
       }
       else if (intersect_view(bounding_sphere) == false) {
         /* Not visible. */
@@ -57,6 +108,12 @@ void main()
         /* Not visible. */
         mask_visibility_bit(drw_view_id);
       }
+#ifdef DRW_VISIBILITY_OCCLUSION
+      else if (is_occluded(box)) {
+        /* Hidden behind other surfaces. */
+        mask_visibility_bit(drw_view_id);
+      }
+#endif
     }
   }
   else {
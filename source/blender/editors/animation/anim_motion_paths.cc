@@ -26,6 +26,7 @@
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_multi_frame.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "GPU_batch.hh"
@@ -38,6 +39,10 @@
 
 #include "CLG_log.h"
 
+#ifdef WITH_PYTHON
+#  include "BPY_extern.h"
+#endif
+
 static CLG_LogRef LOG = {"ed.anim.motion_paths"};
 
 /* Motion path needing to be baked (mpt) */
@@ -57,6 +62,23 @@ struct MPathTarget {
   Object *ob_eval; /* evaluated object */
 };
 
+/* Frames can be evaluated by multiple dependency graphs at the same time when nothing else than
+ * the evaluated data depends on the current frame. */
+static bool motionpaths_calc_can_use_multiple_depsgraphs(const bool is_active_depsgraph,
+                                                         const eAnimvizCalcRange range)
+{
+  if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME || is_active_depsgraph) {
+    return false;
+  }
+#ifdef WITH_PYTHON
+  /* Handlers may change original data for every frame. */
+  if (!BPY_app_handlers_frame_change_is_empty()) {
+    return false;
+  }
+#endif
+  return true;
+}
+
 /* ........ */
 
 /* update scene for current frame */
@@ -147,7 +169,9 @@ static void motionpaths_calc_bake_targets(ListBase *targets,
     /* get the relevant cache vert to write to */
     bMotionPathVert *mpv = mpath->points + (cframe - mpath->start_frame);
 
-    Object *ob_eval = mpt->ob_eval;
+    /* Frames may be evaluated by different dependency graphs, see
+     * #motionpaths_calc_can_use_multiple_depsgraphs. */
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, mpt->ob);
 
     /* Lookup evaluated pose channel, here because the depsgraph
      * evaluation can change them so they are not cached in mpt. */
@@ -503,18 +527,33 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
             sfra,
             efra,
             efra - sfra + 1);
-  for (scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
-    if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
-      /* For current frame, only update tagged. */
-      BKE_scene_graph_update_tagged(depsgraph, bmain);
-    }
-    else {
-      /* Update relevant data for new frame. */
-      motionpaths_calc_update_scene(depsgraph);
-    }
+  const int graphs_num = blender::deg::multi_frame::graphs_num_for_frames(efra - sfra + 1);
+  if (graphs_num > 1 && motionpaths_calc_can_use_multiple_depsgraphs(is_active_depsgraph, range)) {
+    ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+    blender::deg::multi_frame::evaluate_frames(
+        depsgraph,
+        sfra,
+        efra,
+        graphs_num,
+        [&]() { return animviz_depsgraph_build(bmain, scene, view_layer, targets); },
+        [&](Depsgraph *frame_depsgraph, const int frame) {
+          motionpaths_calc_bake_targets(targets, frame, frame_depsgraph, scene->camera);
+        });
+  }
+  else {
+    for (scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
+      if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
+        /* For current frame, only update tagged. */
+        BKE_scene_graph_update_tagged(depsgraph, bmain);
+      }
+      else {
+        /* Update relevant data for new frame. */
+        motionpaths_calc_update_scene(depsgraph);
+      }
 
-    /* perform baking for targets */
-    motionpaths_calc_bake_targets(targets, scene->r.cfra, depsgraph, scene->camera);
+      /* perform baking for targets */
+      motionpaths_calc_bake_targets(targets, scene->r.cfra, depsgraph, scene->camera);
+    }
   }
 
   /* reset original environment */
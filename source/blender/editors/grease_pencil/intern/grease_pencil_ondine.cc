@@ -13,19 +13,26 @@
 #include "BKE_camera.h"
 #include "BKE_context.hh"
 #include "BKE_curves.hh"
+#include "BKE_duplilist.hh"
 #include "BKE_grease_pencil.hh"
 #include "BKE_main.hh"
 #include "BKE_material.h"
 #include "BKE_scene.hh"
 #include "BKE_screen.hh"
 
+#include "BLI_array_utils.hh"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_simd.hh"
+#include "BLI_sort.hh"
+#include "BLI_vector_set.hh"
 
-#include "WM_api.hH"
+#include "WM_api.hh"
 
 #include "RNA_access.hh"
 #include "RNA_define.hh"
@@ -37,6 +44,8 @@
 #include "ED_grease_pencil_ondine.hh"
 #include "ED_view3d.hh"
 
+#include <xxhash.h>
+
 namespace blender::ondine {
 
 /* Object instance of Ondine runtime render data. */
@@ -76,7 +85,10 @@ View3D *get_invoke_view3d(bContext *C)
 }
 
 /* Runtime render properties. */
-GpencilOndine::GpencilOndine() {}
+GpencilOndine::GpencilOndine()
+{
+  diff_mat_ = float4x4::identity();
+}
 
 void GpencilOndine::init(bContext *C)
 {
@@ -86,7 +98,21 @@ void GpencilOndine::init(bContext *C)
   scene_ = CTX_data_scene(C);
   region_ = get_invoke_region(C);
   v3d_ = get_invoke_view3d(C);
-  rv3d_ = (RegionView3D *)region_->regiondata;
+  rv3d_ = (region_ != nullptr) ? (RegionView3D *)region_->regiondata : nullptr;
+  cfra_ = scene_->r.cfra;
+  render_order_.clear();
+}
+
+void GpencilOndine::init(Main *bmain, Depsgraph *depsgraph, Scene *scene, const int frame)
+{
+  bmain_ = bmain;
+  depsgraph_ = depsgraph;
+  scene_ = scene;
+  region_ = nullptr;
+  v3d_ = nullptr;
+  rv3d_ = nullptr;
+  cfra_ = frame;
+  render_order_.clear();
 }
 
 bool GpencilOndine::prepare_camera_params()
@@ -131,60 +157,119 @@ bool GpencilOndine::prepare_camera_params()
 
   /* Camera position. */
   /* TODO: Can we get this in another way? Then we won't need `rv3d_` any more! */
-  copy_v3_v3(camera_z_axis_, rv3d_->viewinv[2]);
+  if (rv3d_ != nullptr) {
+    copy_v3_v3(camera_z_axis_, rv3d_->viewinv[2]);
+  }
+  else if (cam_ob != nullptr) {
+    /* Without a viewport (e.g. when prefetching), use the view axis of the camera. */
+    camera_z_axis_ = math::normalize(cam_ob->object_to_world().z_axis());
+  }
+  else {
+    camera_z_axis_ = float3(0.0f, 0.0f, 1.0f);
+  }
 
   render_x_ = float(scene_->r.xsch * scene_->r.size) / 100.0f;
   render_y_ = float(scene_->r.ysch * scene_->r.size) / 100.0f;
 
+  /* Hash of all camera parameters, used to detect outdated render data. */
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_64bits_reset(state);
+  XXH3_64bits_update(state, persmat_, sizeof(persmat_));
+  XXH3_64bits_update(state, &diff_mat_, sizeof(diff_mat_));
+  XXH3_64bits_update(state, &camera_loc_, sizeof(camera_loc_));
+  XXH3_64bits_update(state, &camera_normal_vec_, sizeof(camera_normal_vec_));
+  XXH3_64bits_update(state, &camera_rot_sin_, sizeof(camera_rot_sin_));
+  XXH3_64bits_update(state, &camera_rot_cos_, sizeof(camera_rot_cos_));
+  XXH3_64bits_update(state, &render_x_, sizeof(render_x_));
+  XXH3_64bits_update(state, &render_y_, sizeof(render_y_));
+  camera_hash_ = XXH3_64bits_digest(state);
+  XXH3_freeState(state);
+
   return true;
 }
 
+uint64_t GpencilOndine::materials_hash_get(Object *object)
+{
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_64bits_reset(state);
+  for (const int mat_i : IndexRange(object->totcol)) {
+    const MaterialGPencilStyle *mat_style = BKE_gpencil_material_settings(object, mat_i + 1);
+    XXH3_64bits_update(state, mat_style, sizeof(MaterialGPencilStyle));
+  }
+  const uint64_t hash = XXH3_64bits_digest(state);
+  XXH3_freeState(state);
+  return hash;
+}
+
+uint64_t GpencilOndine::render_data_hash_get(const bke::greasepencil::Drawing &drawing,
+                                             const bke::greasepencil::Layer &layer,
+                                             const float4x4 &layer_to_world,
+                                             const float4x4 &matrix_world,
+                                             const float4x4 &object_to_world,
+                                             const uint64_t materials_hash)
+{
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_64bits_reset(state);
+  XXH3_64bits_update(state, &drawing.runtime->geometry_stamp, sizeof(uint64_t));
+  XXH3_64bits_update(state, &camera_hash_, sizeof(camera_hash_));
+  XXH3_64bits_update(state, &materials_hash, sizeof(materials_hash));
+  XXH3_64bits_update(state, &layer_to_world, sizeof(layer_to_world));
+  XXH3_64bits_update(state, &matrix_world, sizeof(matrix_world));
+  XXH3_64bits_update(state, &object_to_world, sizeof(object_to_world));
+  XXH3_64bits_update(state, &layer.opacity, sizeof(layer.opacity));
+  uint64_t hash = XXH3_64bits_digest(state);
+  XXH3_freeState(state);
+
+  /* Zero is reserved for "no render data". */
+  return (hash == 0) ? 1 : hash;
+}
+
 void GpencilOndine::set_unique_stroke_seeds(bContext *C, const bool current_frame_only)
 {
   const Main *bmain = CTX_data_main(C);
   const Scene &scene = *CTX_data_scene(C);
 
-  LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
-    if (ob->type != OB_GREASE_PENCIL) {
-      continue;
-    }
-
-    GreasePencil &grease_pencil = *static_cast<GreasePencil *>(ob->data);
-    if ((grease_pencil.ondine_flag & GP_ONDINE_WATERCOLOR) == 0) {
+  /* Seeds are stored in the grease pencil data, so iterate the data-blocks instead of the objects
+   * using them. A drawing can be shown by multiple layers and frames, so keep them unique. */
+  VectorSet<bke::greasepencil::Drawing *> drawings;
+  LISTBASE_FOREACH (GreasePencil *, grease_pencil, &bmain->grease_pencils) {
+    if ((grease_pencil->ondine_flag & GP_ONDINE_WATERCOLOR) == 0) {
       continue;
     }
 
-    auto set_seed = [](bke::greasepencil::Drawing *drawing) {
-      MutableSpan<int> seeds = drawing->seeds_for_write();
-      Set<int> used_seeds;
-      for (const int seed_i : seeds.index_range()) {
-        while (seeds[seed_i] == 0 || used_seeds.contains(seeds[seed_i])) {
-          seeds[seed_i] = rand() * 4096 + rand();
-        }
-        used_seeds.add(seeds[seed_i]);
-      }
-    };
-
     if (current_frame_only) {
-      for (const bke::greasepencil::Layer *layer : grease_pencil.layers()) {
-        bke::greasepencil::Drawing *drawing = grease_pencil.get_drawing_at(*layer, scene.r.cfra);
-        if (drawing == nullptr) {
-          continue;
+      for (const bke::greasepencil::Layer *layer : grease_pencil->layers()) {
+        bke::greasepencil::Drawing *drawing = grease_pencil->get_drawing_at(*layer, scene.r.cfra);
+        if (drawing != nullptr) {
+          drawings.add(drawing);
         }
-        set_seed(drawing);
       }
     }
     else {
-      for (GreasePencilDrawingBase *drawing_base : grease_pencil.drawings()) {
+      for (GreasePencilDrawingBase *drawing_base : grease_pencil->drawings()) {
         if (drawing_base->type != GP_DRAWING) {
           continue;
         }
-        bke::greasepencil::Drawing *drawing = reinterpret_cast<bke::greasepencil::Drawing *>(
-            drawing_base);
-        set_seed(drawing);
+        drawings.add(reinterpret_cast<bke::greasepencil::Drawing *>(drawing_base));
       }
     }
   }
+
+  /* Every drawing gets its own range of seed indices, so new seeds are deterministic and don't
+   * depend on the order in which the drawings are processed. */
+  Array<int> seed_offsets_data(drawings.size() + 1);
+  for (const int drawing_i : drawings.index_range()) {
+    seed_offsets_data[drawing_i] = drawings[drawing_i]->strokes().curves_num();
+  }
+  const OffsetIndices<int> seed_offsets = offset_indices::accumulate_counts_to_offsets(
+      seed_offsets_data);
+
+  /* Drawings with unique seeds already are left untouched, so their caches stay valid. */
+  threading::parallel_for(drawings.index_range(), 1, [&](const IndexRange range) {
+    for (const int drawing_i : range) {
+      drawings[drawing_i]->ensure_unique_seeds(seed_offsets[drawing_i].start());
+    }
+  });
 }
 
 float2 GpencilOndine::gpencil_3d_point_to_2d(const float3 co)
@@ -218,6 +303,171 @@ float GpencilOndine::stroke_point_radius_get(const float3 point, const float thi
   return math::max(radius, 1.0f);
 }
 
+#if BLI_HAVE_SSE2
+/** Row \a row of matrix \a m applied to four points with `w = 1`. */
+static inline __m128 transform_row_4(
+    const float4x4 &m, const int row, const __m128 x, const __m128 y, const __m128 z)
+{
+  __m128 r = _mm_mul_ps(_mm_set1_ps(m[0][row]), x);
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[1][row]), y));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[2][row]), z));
+  return _mm_add_ps(r, _mm_set1_ps(m[3][row]));
+}
+
+static inline __m128 abs_4(const __m128 a)
+{
+  return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+}
+#endif
+
+void GpencilOndine::project_points_batch(const float4x4 &layer_to_clip,
+                                         const float4 &dist_plane,
+                                         const Span<float3> positions,
+                                         const Span<float> radii,
+                                         MutableSpan<GPStrokePoint> r_points)
+{
+  const float half_x = render_x_ * 0.5f;
+  const float half_y = render_y_ * 0.5f;
+  int64_t i = 0;
+
+#if BLI_HAVE_SSE2
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 min_radius = _mm_set1_ps(0.001f);
+  const __m128 half_x_4 = _mm_set1_ps(half_x);
+  const __m128 half_y_4 = _mm_set1_ps(half_y);
+  const __m128 render_y_4 = _mm_set1_ps(render_y_);
+
+  for (; i + 4 <= positions.size(); i += 4) {
+    const float3 *co = &positions[i];
+    const __m128 x = _mm_setr_ps(co[0].x, co[1].x, co[2].x, co[3].x);
+    const __m128 y = _mm_setr_ps(co[0].y, co[1].y, co[2].y, co[3].y);
+    const __m128 z = _mm_setr_ps(co[0].z, co[1].z, co[2].z, co[3].z);
+
+    /* Perspective projection, matching #mul_v2_project_m4_v3. */
+    const __m128 inv_w = _mm_div_ps(one, abs_4(transform_row_4(layer_to_clip, 3, x, y, z)));
+    const __m128 ndc_x = _mm_mul_ps(transform_row_4(layer_to_clip, 0, x, y, z), inv_w);
+    const __m128 ndc_y = _mm_mul_ps(transform_row_4(layer_to_clip, 1, x, y, z), inv_w);
+
+    float screen_x[4], screen_y[4], dist[4], radius[4];
+    _mm_storeu_ps(screen_x, _mm_mul_ps(_mm_add_ps(ndc_x, one), half_x_4));
+    _mm_storeu_ps(screen_y,
+                  _mm_sub_ps(render_y_4, _mm_mul_ps(_mm_add_ps(ndc_y, one), half_y_4)));
+
+    /* Distance to the camera plane. */
+    __m128 d = _mm_mul_ps(_mm_set1_ps(dist_plane.x), x);
+    d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(dist_plane.y), y));
+    d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(dist_plane.z), z));
+    d = _mm_add_ps(d, _mm_set1_ps(dist_plane.w));
+    _mm_storeu_ps(dist, _mm_min_ps(zero, d));
+
+    _mm_storeu_ps(radius, _mm_max_ps(min_radius, _mm_loadu_ps(&radii[i])));
+
+    for (const int j : IndexRange(4)) {
+      GPStrokePoint &point = r_points[i + j];
+      point.x = screen_x[j];
+      point.y = screen_y[j];
+      point.dist_to_cam = dist[j];
+      point.radius = radius[j];
+    }
+  }
+#endif
+
+  for (; i < positions.size(); i++) {
+    const float3 &co = positions[i];
+    const float4 clip = layer_to_clip * float4(co, 1.0f);
+    const float inv_w = 1.0f / fabsf(clip.w);
+    GPStrokePoint &point = r_points[i];
+    point.x = (clip.x * inv_w + 1.0f) * half_x;
+    point.y = render_y_ - (clip.y * inv_w + 1.0f) * half_y;
+    point.dist_to_cam = math::min(0.0f, math::dot(dist_plane, float4(co, 1.0f)));
+    point.radius = math::max(0.001f, radii[i]);
+  }
+}
+
+void GpencilOndine::stroke_point_radii_get(const Span<float3> positions,
+                                           const float thickness,
+                                           MutableSpan<float> r_radii)
+{
+  /* See #stroke_point_radius_get: the radius is the distance in render space between a point and
+   * the point offset by the stroke radius. In clip space that offset is a constant vector. */
+  const float4x4 to_clip = float4x4(persmat_) * diff_mat_;
+  const float stroke_radius = thickness * 0.5f;
+  const float4 offset = to_clip * float4(0.0f,
+                                          stroke_radius * camera_rot_cos_,
+                                          stroke_radius * camera_rot_sin_,
+                                          0.0f);
+  const float half_x = render_x_ * 0.5f;
+  const float half_y = render_y_ * 0.5f;
+  int64_t i = 0;
+
+#if BLI_HAVE_SSE2
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half_x_4 = _mm_set1_ps(half_x);
+  const __m128 half_y_4 = _mm_set1_ps(half_y);
+
+  for (; i + 4 <= positions.size(); i += 4) {
+    const float3 *co = &positions[i];
+    const __m128 x = _mm_setr_ps(co[0].x, co[1].x, co[2].x, co[3].x);
+    const __m128 y = _mm_setr_ps(co[0].y, co[1].y, co[2].y, co[3].y);
+    const __m128 z = _mm_setr_ps(co[0].z, co[1].z, co[2].z, co[3].z);
+
+    const __m128 clip_x = transform_row_4(to_clip, 0, x, y, z);
+    const __m128 clip_y = transform_row_4(to_clip, 1, x, y, z);
+    const __m128 clip_w = transform_row_4(to_clip, 3, x, y, z);
+    const __m128 inv_w1 = _mm_div_ps(one, abs_4(clip_w));
+    const __m128 inv_w2 = _mm_div_ps(one, abs_4(_mm_add_ps(clip_w, _mm_set1_ps(offset.w))));
+
+    const __m128 dx = _mm_mul_ps(
+        _mm_sub_ps(_mm_mul_ps(clip_x, inv_w1),
+                   _mm_mul_ps(_mm_add_ps(clip_x, _mm_set1_ps(offset.x)), inv_w2)),
+        half_x_4);
+    const __m128 dy = _mm_mul_ps(
+        _mm_sub_ps(_mm_mul_ps(clip_y, inv_w1),
+                   _mm_mul_ps(_mm_add_ps(clip_y, _mm_set1_ps(offset.y)), inv_w2)),
+        half_y_4);
+    const __m128 radius = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    _mm_storeu_ps(&r_radii[i], _mm_max_ps(radius, one));
+  }
+#endif
+
+  for (; i < positions.size(); i++) {
+    const float4 clip1 = to_clip * float4(positions[i], 1.0f);
+    const float4 clip2 = clip1 + offset;
+    const float2 delta = float2(clip1.x / fabsf(clip1.w) - clip2.x / fabsf(clip2.w),
+                                clip1.y / fabsf(clip1.w) - clip2.y / fabsf(clip2.w));
+    r_radii[i] = math::max(math::length(delta * float2(half_x, half_y)), 1.0f);
+  }
+}
+
+bool GpencilOndine::bounds_out_of_view(const float4x4 &layer_to_clip,
+                                       const float4 &dist_plane,
+                                       const Bounds<float3> &bounds,
+                                       OndineScreenBounds &r_screen_bounds)
+{
+  r_screen_bounds.bounds = Bounds<float2>(float2(FLT_MAX), float2(-FLT_MAX));
+  r_screen_bounds.max_dist_to_cam = 0.0f;
+
+  for (const int corner_i : IndexRange(8)) {
+    const float3 corner((corner_i & 1) ? bounds.max.x : bounds.min.x,
+                        (corner_i & 2) ? bounds.max.y : bounds.min.y,
+                        (corner_i & 4) ? bounds.max.z : bounds.min.z);
+    const float4 clip = layer_to_clip * float4(corner, 1.0f);
+    /* Never cull geometry that is (partly) behind the camera. */
+    if (clip.w <= 0.0f) {
+      return false;
+    }
+    const float2 screen_co((clip.x / clip.w + 1.0f) * 0.5f * render_x_,
+                           render_y_ - (clip.y / clip.w + 1.0f) * 0.5f * render_y_);
+    math::min_max(screen_co, r_screen_bounds.bounds.min, r_screen_bounds.bounds.max);
+    r_screen_bounds.max_dist_to_cam = math::min(r_screen_bounds.max_dist_to_cam,
+                                                math::dot(dist_plane, float4(corner, 1.0f)));
+  }
+
+  return r_screen_bounds.bounds.max.x < 0.0f || r_screen_bounds.bounds.min.x > render_x_ ||
+         r_screen_bounds.bounds.max.y < 0.0f || r_screen_bounds.bounds.min.y > render_y_;
+}
+
 void GpencilOndine::get_vertex_color(const MaterialGPencilStyle *mat_style,
                                      const ColorGeometry4f &vertex_color,
                                      const bool use_texture,
@@ -258,7 +508,9 @@ void GpencilOndine::set_zdepth(Object *object)
   grease_pencil.runtime->render_zdepth = dot_v3v3(camera_z_axis_, object->object_to_world()[3]);
 }
 
-void GpencilOndine::set_render_data(Object *object, const blender::float4x4 matrix_world)
+void GpencilOndine::collect_render_data_items(Object *object,
+                                              const float4x4 &matrix_world,
+                                              Vector<RenderDataItem> &r_items)
 {
   /* Grease pencil object? */
   if (object->type != OB_GREASE_PENCIL) {
@@ -271,14 +523,18 @@ void GpencilOndine::set_render_data(Object *object, const blender::float4x4 matr
     return;
   }
 
+  const uint64_t materials_hash = materials_hash_get(object);
+
   /* Iterate all layers of GP watercolor object. */
-  for (const bke::greasepencil::Layer *layer : grease_pencil.layers()) {
+  const Span<const bke::greasepencil::Layer *> layers = grease_pencil.layers();
+  for (const int layer_i : layers.index_range()) {
+    const bke::greasepencil::Layer *layer = layers[layer_i];
     /* Layer is hidden? */
     if (!layer->is_visible())
       continue;
 
     /* Active keyframe? */
-    bke::greasepencil::Drawing *drawing = grease_pencil.get_drawing_at(*layer, scene_->r.cfra);
+    bke::greasepencil::Drawing *drawing = grease_pencil.get_drawing_at(*layer, cfra_);
     if (drawing == nullptr) {
       continue;
     }
@@ -286,218 +542,542 @@ void GpencilOndine::set_render_data(Object *object, const blender::float4x4 matr
       continue;
     }
 
-    /* TODO: Prepare layer matrix and pixel size. */
-    const float4x4 viewmat = layer->to_world_space(*object);
-    const float object_scale = mat4_to_scale(object->object_to_world().ptr());
-
-    const bke::CurvesGeometry &curves = drawing->strokes();
-    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
-    drawing->runtime->points_2d.reinitialize(curves.points_num());
-    Array<GPStrokePoint> &points_2d = drawing->runtime->points_2d;
-    drawing->runtime->render_strokes.reinitialize(curves.curves_num());
-    Array<OndineRenderStroke> &render_strokes = drawing->runtime->render_strokes;
-    memset(render_strokes.data(), 0, render_strokes.as_span().size_in_bytes());
-
-    const Span<float3> positions = curves.positions();
-    const VArray<ColorGeometry4f> fill_colors = drawing->fill_colors();
-    const VArray<bool> cyclic = curves.cyclic();
-    const VArray<int> materials = *curves.attributes().lookup_or_default<int>(
-        "material_index", bke::AttrDomain::Curve, 0);
-    const VArray<float> opacities = drawing->opacities();
-    const VArray<float> radii = drawing->radii();
-    const VArray<ColorGeometry4f> vertex_colors = drawing->vertex_colors();
-
-    threading::parallel_for(curves.curves_range(), 64, [&](const IndexRange curve_range) {
-      for (const int curve_i : curve_range) {
-        const IndexRange points = points_by_curve[curve_i];
-
-        /* Set fill and stroke flags. */
-        MaterialGPencilStyle *mat_style = BKE_gpencil_material_settings(object,
-                                                                        materials[curve_i] + 1);
-        if (mat_style->flag & GP_MATERIAL_HIDE) {
-          continue;
-        }
-        const bool has_stroke = ((mat_style->flag & GP_MATERIAL_STROKE_SHOW) &&
-                                 (mat_style->stroke_rgba[3] > GPENCIL_ALPHA_OPACITY_THRESHOLD));
-        const bool has_fill = ((mat_style->flag & GP_MATERIAL_FILL_SHOW) &&
-                               (mat_style->fill_rgba[3] > GPENCIL_ALPHA_OPACITY_THRESHOLD));
-        const bool use_texture = (mat_style->stroke_style == GP_MATERIAL_STROKE_STYLE_TEXTURE &&
-                                  mat_style->sima != nullptr && !has_fill);
-
-        if (has_stroke) {
-          render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_HAS_STROKE;
-        }
-        if (has_fill) {
-          render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_HAS_FILL;
+    RenderDataItem item;
+    item.object = object;
+    item.layer = layer;
+    item.layer_index = layer_i;
+    item.drawing = drawing;
+    item.matrix_world = matrix_world;
+    item.render_hash = render_data_hash_get(*drawing,
+                                            *layer,
+                                            layer->to_world_space(*object),
+                                            matrix_world,
+                                            object->object_to_world(),
+                                            materials_hash);
+    r_items.append(item);
+  }
+}
 
-          /* Set fill color, in linear sRGB. */
-          set_fill_color(fill_colors[curve_i], mat_style, *layer, render_strokes[curve_i]);
-        }
-        if (cyclic[curve_i] || has_fill) {
-          render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_IS_CYCLIC;
-        }
+void GpencilOndine::set_render_data_for_items(Span<RenderDataItem> items, const bool use_cache)
+{
+  /* A drawing can be used by multiple items (e.g. by object instances). The items are computed
+   * in parallel, so only the last item of each drawing is kept, like when the items would have
+   * been computed one after another. */
+  Map<const bke::greasepencil::Drawing *, int64_t> last_item_by_drawing;
+  for (const int64_t item_i : items.index_range()) {
+    last_item_by_drawing.add_overwrite(items[item_i].drawing, item_i);
+  }
 
-        /* Init min/max calculations. */
-        float min_y = FLT_MAX;
-        float max_x = -FLT_MAX;
-        int min_i1 = 0;
-        float bbox_minx = FLT_MAX, bbox_miny = FLT_MAX;
-        float bbox_maxx = -FLT_MAX, bbox_maxy = -FLT_MAX;
-        float dist_to_cam = 0.0f;
-        float min_dist_to_cam = -FLT_MAX, max_dist_to_cam = FLT_MAX;
-        int min_dist_point_index = 0;
-
-        /* Convert 3D stroke points to 2D. */
-        for (const int point : points_by_curve[curve_i]) {
-          /* Apply layer matrix. */
-          float3 co = math::transform_point(viewmat, positions[point]);
-
-          /* Apply object world matrix (given by object instances). */
-          co = math::transform_point(matrix_world, co);
-
-          /* Convert to 2D space. */
-          const float2 screen_co = gpencil_3d_point_to_2d(co);
-          points_2d[point].x = screen_co.x;
-          points_2d[point].y = screen_co.y;
-          points_2d[point].alpha = opacities[point];
-
-          /* Set vertex color. */
-          get_vertex_color(
-              mat_style, vertex_colors[point], use_texture, &points_2d[point].color_r);
-
-          /* Get distance to camera.
-           * Somehow we have to apply the object world matrix here again, I don't know why... */
-          mul_m4_v3(object->object_to_world().ptr(), co);
-          dist_to_cam = math::min(0.0f, math::dot(co - camera_loc_, camera_normal_vec_));
-          points_2d[point].dist_to_cam = dist_to_cam;
-
-          /* Keep track of closest/furthest point to camera. */
-          if (dist_to_cam < max_dist_to_cam) {
-            max_dist_to_cam = dist_to_cam;
-          }
-          if (dist_to_cam > min_dist_to_cam) {
-            min_dist_to_cam = dist_to_cam;
-            min_dist_point_index = point;
-          }
+  Vector<int64_t> items_to_compute;
+  for (const int64_t item_i : items.index_range()) {
+    const RenderDataItem &item = items[item_i];
+    if (last_item_by_drawing.lookup(item.drawing) != item_i) {
+      continue;
+    }
 
-          /* Keep track of minimum y point. */
-          if (screen_co.y <= min_y) {
-            if ((points_2d[point].y < min_y) || (screen_co.x > max_x)) {
-              min_i1 = point;
-              min_y = screen_co.y;
-              max_x = screen_co.x;
-            }
-          }
+    /* Reuse the cached render data when none of the inputs changed since the last call. */
+    const bke::greasepencil::DrawingRuntime &runtime = *item.drawing->runtime;
+    const bke::CurvesGeometry &curves = item.drawing->strokes();
+    if (use_cache && runtime.render_data_hash == item.render_hash &&
+        runtime.points_2d.size() == curves.points_num() &&
+        runtime.render_strokes.size() == curves.curves_num())
+    {
+      continue;
+    }
+    items_to_compute.append(item_i);
+  }
 
-          /* Get bounding box. */
-          if (bbox_minx > screen_co.x) {
-            bbox_minx = screen_co.x;
-          }
-          if (bbox_miny > screen_co.y) {
-            bbox_miny = screen_co.y;
-          }
-          if (bbox_maxx < screen_co.x) {
-            bbox_maxx = screen_co.x;
-          }
-          if (bbox_maxy < screen_co.y) {
-            bbox_maxy = screen_co.y;
-          }
+  /* Drawings are scheduled as separate tasks, the curves of a drawing are split into nested
+   * tasks. That way idle threads can take over work from large drawings. */
+  threading::parallel_for(items_to_compute.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const RenderDataItem &item = items[items_to_compute[i]];
+      set_drawing_render_data(item);
+      item.drawing->runtime->render_data_hash = use_cache ? item.render_hash : 0;
+    }
+  });
+}
+
+void GpencilOndine::set_render_data(Object *object,
+                                    const blender::float4x4 matrix_world,
+                                    const bool use_cache)
+{
+  Vector<RenderDataItem> items;
+  collect_render_data_items(object, matrix_world, items);
+  set_render_data_for_items(items, use_cache);
+}
+
+void GpencilOndine::collect_render_data_all(Vector<RenderDataItem> &r_items)
+{
+  DEGObjectIterSettings deg_iter_settings = {nullptr};
+  deg_iter_settings.depsgraph = depsgraph_;
+  deg_iter_settings.flags = DEG_OBJECT_ITER_FOR_RENDER_ENGINE_FLAGS;
+  DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, ob) {
+    if (ob->type != OB_GREASE_PENCIL) {
+      continue;
+    }
+
+    /* The iterator reports instances as temporary objects, so use the instanced object and the
+     * instance transform on top of its own transform instead. */
+    Object *object = ob;
+    float4x4 matrix_world = float4x4::identity();
+    if (data_.dupli_object_current != nullptr) {
+      object = data_.dupli_object_current->ob;
+      matrix_world = ob->object_to_world() * object->world_to_object();
+    }
+
+    set_zdepth(ob);
+    collect_render_data_items(object, matrix_world, r_items);
+  }
+  DEG_OBJECT_ITER_END;
+}
+
+void GpencilOndine::set_render_data_all(const bool use_cache)
+{
+  Vector<RenderDataItem> items;
+  collect_render_data_all(items);
+  set_render_data_for_items(items, use_cache);
+  update_render_order(items);
+}
+
+/**
+ * Sort data that is expected to be (nearly) sorted already. An insertion sort is linear for
+ * sorted data, but quadratic in the worst case, so fall back to a full sort when many elements
+ * are out of order.
+ */
+template<typename T, typename IsLessFn>
+static void sort_nearly_sorted(MutableSpan<T> data, const IsLessFn &is_less)
+{
+  int64_t descents_num = 0;
+  for (const int64_t i : data.index_range().drop_front(1)) {
+    if (is_less(data[i], data[i - 1])) {
+      descents_num++;
+    }
+  }
+  if (descents_num == 0) {
+    return;
+  }
+  if (descents_num > std::max<int64_t>(16, data.size() / 16)) {
+    parallel_sort(data.begin(), data.end(), is_less);
+    return;
+  }
+  for (const int64_t i : data.index_range().drop_front(1)) {
+    T value = std::move(data[i]);
+    int64_t j = i;
+    for (; j > 0 && is_less(value, data[j - 1]); j--) {
+      data[j] = std::move(data[j - 1]);
+    }
+    data[j] = std::move(value);
+  }
+}
+
+void GpencilOndine::update_stroke_render_order(const bke::greasepencil::Drawing &drawing)
+{
+  const Span<OndineRenderStroke> render_strokes = drawing.runtime->render_strokes;
+  Array<int> &order = drawing.runtime->render_stroke_order;
+  if (order.size() != render_strokes.size()) {
+    order.reinitialize(render_strokes.size());
+    array_utils::fill_index_range<int>(order);
+  }
+  /* Furthest first, the stroke index keeps the drawing order of strokes with equal distance. */
+  sort_nearly_sorted<int>(order, [&](const int a, const int b) {
+    const float dist_a = render_strokes[a].render_dist_to_camera;
+    const float dist_b = render_strokes[b].render_dist_to_camera;
+    return (dist_a > dist_b) || (dist_a == dist_b && a < b);
+  });
+}
+
+void GpencilOndine::update_render_order(Span<RenderDataItem> items)
+{
+  /* Instances share the render data of their drawing, which belongs to the last item. */
+  Map<const bke::greasepencil::Drawing *, int> entry_by_drawing;
+  Vector<OndineDepthEntry> entries;
+  for (const int item_i : items.index_range()) {
+    const RenderDataItem &item = items[item_i];
+    const GreasePencil &grease_pencil = *static_cast<const GreasePencil *>(item.object->data);
+    const float4x4 depth_transform = (grease_pencil.ondine_flag & GP_ONDINE_TRUE_DEPTH) ?
+                                         item.layer->to_world_space(*item.object) :
+                                         item.object->object_to_world();
+
+    OndineDepthEntry entry;
+    entry.object = item.object;
+    entry.layer = item.layer;
+    entry.drawing = item.drawing;
+    entry.zdepth = math::dot(camera_z_axis_, (item.matrix_world * depth_transform).location());
+    entry.item_index = item_i;
+
+    const int entry_i = entry_by_drawing.lookup_or_add(item.drawing, entries.size());
+    if (entry_i == entries.size()) {
+      entries.append(entry);
+    }
+    else {
+      entries[entry_i] = entry;
+    }
+  }
+
+  /* Start from the previous order: entries that are still rendered keep their position, new ones
+   * are added at the end. The previous order is stored by key, the drawings it was computed for
+   * may have been freed since. */
+  Map<OndineDepthKey, int> entry_by_key;
+  for (const int entry_i : entries.index_range()) {
+    const RenderDataItem &item = items[entries[entry_i].item_index];
+    entry_by_key.add({DEG_get_original_id(&item.object->id)->session_uid, item.layer_index},
+                     entry_i);
+  }
+  Vector<OndineDepthEntry> order;
+  order.reserve(entries.size());
+  Set<int> ordered_entries;
+  for (const OndineDepthKey &prev_key : render_order_keys_) {
+    if (const int *entry_i = entry_by_key.lookup_ptr(prev_key)) {
+      if (ordered_entries.add(*entry_i)) {
+        order.append(entries[*entry_i]);
+      }
+    }
+  }
+  for (const int entry_i : entries.index_range()) {
+    if (!ordered_entries.contains(entry_i)) {
+      order.append(entries[entry_i]);
+    }
+  }
+
+  sort_nearly_sorted<OndineDepthEntry>(
+      order, [](const OndineDepthEntry &a, const OndineDepthEntry &b) {
+        return (a.zdepth < b.zdepth) || (a.zdepth == b.zdepth && a.item_index < b.item_index);
+      });
+  render_order_ = std::move(order);
+  render_order_keys_.clear();
+  for (const OndineDepthEntry &entry : render_order_) {
+    const RenderDataItem &item = items[entry.item_index];
+    render_order_keys_.append(
+        {DEG_get_original_id(&item.object->id)->session_uid, item.layer_index});
+  }
+
+  threading::parallel_for(render_order_.index_range(), 1, [&](const IndexRange range) {
+    for (const OndineDepthEntry &entry : render_order_.as_span().slice(range)) {
+      const GreasePencil &grease_pencil = *static_cast<const GreasePencil *>(entry.object->data);
+      if (grease_pencil.ondine_flag & GP_ONDINE_TRUE_DEPTH) {
+        update_stroke_render_order(*entry.drawing);
+      }
+      else {
+        entry.drawing->runtime->render_stroke_order = {};
+      }
+    }
+  });
+}
+
+Span<OndineDepthEntry> GpencilOndine::render_order() const
+{
+  return render_order_;
+}
+
+/**
+ * Quantize the render points to the compact layout and lift constant point colors into the
+ * render strokes.
+ */
+static void set_compact_points(const OffsetIndices<int> points_by_curve,
+                               const Span<GPStrokePoint> points_2d,
+                               MutableSpan<OndineRenderStroke> render_strokes,
+                               MutableSpan<GPStrokePointCompact> r_points_compact)
+{
+  threading::parallel_for(render_strokes.index_range(), 256, [&](const IndexRange curve_range) {
+    for (const int curve_i : curve_range) {
+      const IndexRange points = points_by_curve[curve_i];
+      OndineRenderStroke &render_stroke = render_strokes[curve_i];
+      const float2 bbox_min(render_stroke.render_bbox[0], render_stroke.render_bbox[1]);
+      const float2 bbox_max(render_stroke.render_bbox[2], render_stroke.render_bbox[3]);
+      const float2 bbox_size = math::max(bbox_max - bbox_min, float2(FLT_EPSILON));
+
+      bool constant_color = true;
+      const GPStrokePoint &first_point = points_2d[points.first()];
+      for (const int point : points) {
+        const GPStrokePoint &src = points_2d[point];
+        GPStrokePointCompact &dst = r_points_compact[point];
+        const float2 co = (float2(src.x, src.y) - bbox_min) / bbox_size;
+        dst.dist_to_cam = src.dist_to_cam;
+        dst.x = unit_float_to_ushort_clamp(co.x);
+        dst.y = unit_float_to_ushort_clamp(co.y);
+        dst.radius = unit_float_to_ushort_clamp(src.radius);
+        dst.alpha = unit_float_to_uchar_clamp(src.alpha);
+        dst.color[0] = unit_float_to_uchar_clamp(src.color_r);
+        dst.color[1] = unit_float_to_uchar_clamp(src.color_g);
+        dst.color[2] = unit_float_to_uchar_clamp(src.color_b);
+        dst._pad[0] = dst._pad[1] = 0;
+        constant_color &= (src.color_r == first_point.color_r &&
+                           src.color_g == first_point.color_g &&
+                           src.color_b == first_point.color_b);
+      }
+
+      /* Keep constant colors at full precision. */
+      if (constant_color) {
+        render_stroke.render_flag |= GP_ONDINE_STROKE_HAS_CONSTANT_COLOR;
+        render_stroke.render_stroke_color[0] = first_point.color_r;
+        render_stroke.render_stroke_color[1] = first_point.color_g;
+        render_stroke.render_stroke_color[2] = first_point.color_b;
+      }
+    }
+  });
+}
+
+void GpencilOndine::set_drawing_render_data(const RenderDataItem &item)
+{
+  Object *object = item.object;
+  const bke::greasepencil::Layer *layer = item.layer;
+  bke::greasepencil::Drawing *drawing = item.drawing;
+  const float4x4 &matrix_world = item.matrix_world;
+
+  /* TODO: Prepare layer matrix and pixel size. */
+  const float4x4 viewmat = layer->to_world_space(*object);
+  const float object_scale = mat4_to_scale(object->object_to_world().ptr());
+
+  const bke::CurvesGeometry &curves = drawing->strokes();
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  drawing->runtime->points_2d.reinitialize(curves.points_num());
+  Array<GPStrokePoint> &points_2d = drawing->runtime->points_2d;
+  drawing->runtime->render_strokes.reinitialize(curves.curves_num());
+  Array<OndineRenderStroke> &render_strokes = drawing->runtime->render_strokes;
+  memset(render_strokes.data(), 0, render_strokes.as_span().size_in_bytes());
+
+  const Span<float3> positions = curves.positions();
+  const VArray<ColorGeometry4f> fill_colors = drawing->fill_colors();
+  const VArray<bool> cyclic = curves.cyclic();
+  const VArray<int> materials = *curves.attributes().lookup_or_default<int>(
+      "material_index", bke::AttrDomain::Curve, 0);
+  const VArray<float> opacities = drawing->opacities();
+  const VArraySpan<float> radii = drawing->radii();
+  const VArray<ColorGeometry4f> vertex_colors = drawing->vertex_colors();
+
+  /* Matrices for the batched projection of the points, see #gpencil_3d_point_to_2d. The distance
+   * to the camera is computed with the object world matrix applied again. */
+  const float4x4 layer_to_world = matrix_world * viewmat;
+  const float4x4 layer_to_clip = float4x4(persmat_) * diff_mat_ * layer_to_world;
+  const float4x4 layer_to_dist = object->object_to_world() * layer_to_world;
+  const float4 dist_plane(math::dot(camera_normal_vec_, layer_to_dist.x_axis()),
+                          math::dot(camera_normal_vec_, layer_to_dist.y_axis()),
+                          math::dot(camera_normal_vec_, layer_to_dist.z_axis()),
+                          math::dot(camera_normal_vec_, layer_to_dist.location() - camera_loc_));
+
+  /* Frustum culling, first for the whole drawing, then per stroke. */
+  OndineScreenBounds drawing_screen_bounds;
+  const bool drawing_out_of_view = bounds_out_of_view(
+      layer_to_clip,
+      dist_plane,
+      curves.bounds_min_max().value_or(Bounds<float3>(float3(0.0f))),
+      drawing_screen_bounds);
+  const Span<Bounds<float3>> curve_bounds = drawing_out_of_view ? Span<Bounds<float3>>() :
+                                                                  drawing->curve_bounds();
+
+  threading::parallel_for(curves.curves_range(), 64, [&](const IndexRange curve_range) {
+    for (const int curve_i : curve_range) {
+      const IndexRange points = points_by_curve[curve_i];
+
+      /* Set fill and stroke flags. */
+      MaterialGPencilStyle *mat_style = BKE_gpencil_material_settings(object,
+                                                                      materials[curve_i] + 1);
+      if (mat_style->flag & GP_MATERIAL_HIDE) {
+        continue;
+      }
+      const bool has_stroke = ((mat_style->flag & GP_MATERIAL_STROKE_SHOW) &&
+                               (mat_style->stroke_rgba[3] > GPENCIL_ALPHA_OPACITY_THRESHOLD));
+      const bool has_fill = ((mat_style->flag & GP_MATERIAL_FILL_SHOW) &&
+                             (mat_style->fill_rgba[3] > GPENCIL_ALPHA_OPACITY_THRESHOLD));
+      const bool use_texture = (mat_style->stroke_style == GP_MATERIAL_STROKE_STYLE_TEXTURE &&
+                                mat_style->sima != nullptr && !has_fill);
+
+      if (has_stroke) {
+        render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_HAS_STROKE;
+      }
+      if (has_fill) {
+        render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_HAS_FILL;
+
+        /* Set fill color, in linear sRGB. */
+        set_fill_color(fill_colors[curve_i], mat_style, *layer, render_strokes[curve_i]);
+      }
+      if (cyclic[curve_i] || has_fill) {
+        render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_IS_CYCLIC;
+      }
+
+      /* Skip all per-point work for strokes that are certainly out of view. */
+      OndineScreenBounds screen_bounds = drawing_screen_bounds;
+      if (drawing_out_of_view ||
+          bounds_out_of_view(layer_to_clip, dist_plane, curve_bounds[curve_i], screen_bounds))
+      {
+        memset(&points_2d[points.first()], 0, points.size() * sizeof(GPStrokePoint));
+        render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_IS_OUT_OF_VIEW;
+        render_strokes[curve_i].render_max_radius = 0.001f;
+        render_strokes[curve_i].render_bbox[0] = screen_bounds.bounds.min.x + IMAGE_PADDING;
+        render_strokes[curve_i].render_bbox[1] = screen_bounds.bounds.min.y + IMAGE_PADDING;
+        render_strokes[curve_i].render_bbox[2] = screen_bounds.bounds.max.x + IMAGE_PADDING;
+        render_strokes[curve_i].render_bbox[3] = screen_bounds.bounds.max.y + IMAGE_PADDING;
+        render_strokes[curve_i].render_dist_to_camera = screen_bounds.max_dist_to_cam;
+        continue;
+      }
+
+      /* Init min/max calculations. */
+      float min_y = FLT_MAX;
+      float max_x = -FLT_MAX;
+      int min_i1 = 0;
+      float bbox_minx = FLT_MAX, bbox_miny = FLT_MAX;
+      float bbox_maxx = -FLT_MAX, bbox_maxy = -FLT_MAX;
+      float dist_to_cam = 0.0f;
+      float min_dist_to_cam = -FLT_MAX, max_dist_to_cam = FLT_MAX;
+      int min_dist_point_index = 0;
+
+      /* Convert 3D stroke points to 2D. */
+      project_points_batch(layer_to_clip,
+                           dist_plane,
+                           positions.slice(points),
+                           radii.slice(points),
+                           points_2d.as_mutable_span().slice(points));
+
+      for (const int point : points_by_curve[curve_i]) {
+        const float2 screen_co(points_2d[point].x, points_2d[point].y);
+        points_2d[point].alpha = opacities[point];
+
+        /* Set vertex color. */
+        get_vertex_color(
+            mat_style, vertex_colors[point], use_texture, &points_2d[point].color_r);
+
+        dist_to_cam = points_2d[point].dist_to_cam;
+
+        /* Keep track of closest/furthest point to camera. */
+        if (dist_to_cam < max_dist_to_cam) {
+          max_dist_to_cam = dist_to_cam;
+        }
+        if (dist_to_cam > min_dist_to_cam) {
+          min_dist_to_cam = dist_to_cam;
+          min_dist_point_index = point;
         }
 
-        /* Calculate stroke width. */
-        bool pressure_is_set = false;
-        bool out_of_view = true;
-        float max_radius = 0.001f;
-        render_strokes[curve_i].render_stroke_radius = 0.0f;
-        if (has_stroke) {
-          /* Get stroke thickness, taking object scale into account. */
-          const float max_stroke_radius = stroke_point_radius_get(positions[min_dist_point_index],
-                                                                  object_scale);
-          render_strokes[curve_i].render_stroke_radius = max_stroke_radius;
-
-          /* Adjust point pressure based on distance to camera.
-           * That way a stroke will get thinner when it is further away from the camera. */
-          if ((min_dist_to_cam - max_dist_to_cam) > FLT_EPSILON) {
-            pressure_is_set = true;
-
-            for (const int point : points_by_curve[curve_i]) {
-              /* Adjust pressure based on camera distance. Bit slow, but the most accurate way. */
-              float radius = stroke_point_radius_get(positions[point], object_scale);
-              points_2d[point].radius = math::max(
-                  0.001f, radii[point] * math::min(1.0f, radius / max_stroke_radius));
-              max_radius = math::max(max_radius, points_2d[point].radius);
-
-              /* Point in view of camera? */
-              radius = max_stroke_radius * points_2d[point].radius;
-              if ((points_2d[point].x + radius) >= 0.0f &&
-                  (points_2d[point].x - radius) >= render_x_ &&
-                  (points_2d[point].y + radius) >= 0.0f &&
-                  (points_2d[point].y - radius) >= render_y_)
-              {
-                out_of_view = false;
-              }
-            }
+        /* Keep track of minimum y point. */
+        if (screen_co.y <= min_y) {
+          if ((points_2d[point].y < min_y) || (screen_co.x > max_x)) {
+            min_i1 = point;
+            min_y = screen_co.y;
+            max_x = screen_co.x;
           }
         }
-        if (!pressure_is_set) {
+
+        /* Get bounding box. */
+        if (bbox_minx > screen_co.x) {
+          bbox_minx = screen_co.x;
+        }
+        if (bbox_miny > screen_co.y) {
+          bbox_miny = screen_co.y;
+        }
+        if (bbox_maxx < screen_co.x) {
+          bbox_maxx = screen_co.x;
+        }
+        if (bbox_maxy < screen_co.y) {
+          bbox_maxy = screen_co.y;
+        }
+      }
+
+      /* Calculate stroke width. */
+      bool pressure_is_set = false;
+      bool out_of_view = true;
+      float max_radius = 0.001f;
+      render_strokes[curve_i].render_stroke_radius = 0.0f;
+      if (has_stroke) {
+        /* Get stroke thickness, taking object scale into account. */
+        const float max_stroke_radius = stroke_point_radius_get(positions[min_dist_point_index],
+                                                                object_scale);
+        render_strokes[curve_i].render_stroke_radius = max_stroke_radius;
+
+        /* Adjust point pressure based on distance to camera.
+         * That way a stroke will get thinner when it is further away from the camera. */
+        if ((min_dist_to_cam - max_dist_to_cam) > FLT_EPSILON) {
+          pressure_is_set = true;
+
+          /* Adjust pressure based on camera distance. Bit slow, but the most accurate way. */
+          Array<float, 256> screen_radii(points.size());
+          stroke_point_radii_get(positions.slice(points), object_scale, screen_radii);
+
           for (const int point : points_by_curve[curve_i]) {
-            points_2d[point].radius = math::max(0.001f, radii[point]);
+            float radius = screen_radii[point - points.first()];
+            points_2d[point].radius = math::max(
+                0.001f, radii[point] * math::min(1.0f, radius / max_stroke_radius));
             max_radius = math::max(max_radius, points_2d[point].radius);
 
             /* Point in view of camera? */
-            if (points_2d[point].x >= 0.0f && points_2d[point].x <= render_x_ &&
-                points_2d[point].y >= 0.0f && points_2d[point].y <= render_y_)
+            radius = max_stroke_radius * points_2d[point].radius;
+            if ((points_2d[point].x + radius) >= 0.0f &&
+                (points_2d[point].x - radius) >= render_x_ &&
+                (points_2d[point].y + radius) >= 0.0f &&
+                (points_2d[point].y - radius) >= render_y_)
             {
               out_of_view = false;
             }
           }
         }
-        /* Normalize pressure. */
-        if (max_radius > 1.0f) {
-          for (const int point : points_by_curve[curve_i]) {
-            points_2d[point].radius /= max_radius;
+      }
+      if (!pressure_is_set) {
+        for (const int point : points_by_curve[curve_i]) {
+          /* The radius is already set by #project_points_batch. */
+          max_radius = math::max(max_radius, points_2d[point].radius);
+
+          /* Point in view of camera? */
+          if (points_2d[point].x >= 0.0f && points_2d[point].x <= render_x_ &&
+              points_2d[point].y >= 0.0f && points_2d[point].y <= render_y_)
+          {
+            out_of_view = false;
           }
-          max_radius = 1.0f;
-        }
-        render_strokes[curve_i].render_max_radius = max_radius;
-
-        if (out_of_view) {
-          render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_IS_OUT_OF_VIEW;
         }
-        else {
-          render_strokes[curve_i].render_flag &= ~GP_ONDINE_STROKE_IS_OUT_OF_VIEW;
+      }
+      /* Normalize pressure. */
+      if (max_radius > 1.0f) {
+        for (const int point : points_by_curve[curve_i]) {
+          points_2d[point].radius /= max_radius;
         }
+        max_radius = 1.0f;
+      }
+      render_strokes[curve_i].render_max_radius = max_radius;
 
-        /* Determine wether a fill is clockwise or counterclockwise.
-         * See: https://en.wikipedia.org/wiki/Curve_orientation */
-        render_strokes[curve_i].render_flag &= ~GP_ONDINE_STROKE_FILL_IS_CLOCKWISE;
-        if (has_fill) {
-          const IndexRange curve_range = points_by_curve[curve_i];
-          const int min_i0 = (min_i1 == curve_range.first()) ? curve_range.last() : min_i1 - 1;
-          const int min_i2 = (min_i1 == curve_range.last()) ? curve_range.first() : min_i1 + 1;
-          const float det = (points_2d[min_i1].x - points_2d[min_i0].x) *
-                                (points_2d[min_i2].y - points_2d[min_i0].y) -
-                            (points_2d[min_i2].x - points_2d[min_i0].x) *
-                                (points_2d[min_i1].y - points_2d[min_i0].y);
-          if (det > 0.0f) {
-            render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_FILL_IS_CLOCKWISE;
-          }
-        }
+      if (out_of_view) {
+        render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_IS_OUT_OF_VIEW;
+      }
+      else {
+        render_strokes[curve_i].render_flag &= ~GP_ONDINE_STROKE_IS_OUT_OF_VIEW;
+      }
 
-        /* Add padding to 2d points. */
-        for (const int point : points_by_curve[curve_i]) {
-          points_2d[point].x += IMAGE_PADDING;
-          points_2d[point].y += IMAGE_PADDING;
+      /* Determine wether a fill is clockwise or counterclockwise.
+       * See: https://en.wikipedia.org/wiki/Curve_orientation */
+      render_strokes[curve_i].render_flag &= ~GP_ONDINE_STROKE_FILL_IS_CLOCKWISE;
+      if (has_fill) {
+        const IndexRange curve_range = points_by_curve[curve_i];
+        const int min_i0 = (min_i1 == curve_range.first()) ? curve_range.last() : min_i1 - 1;
+        const int min_i2 = (min_i1 == curve_range.last()) ? curve_range.first() : min_i1 + 1;
+        const float det = (points_2d[min_i1].x - points_2d[min_i0].x) *
+                              (points_2d[min_i2].y - points_2d[min_i0].y) -
+                          (points_2d[min_i2].x - points_2d[min_i0].x) *
+                              (points_2d[min_i1].y - points_2d[min_i0].y);
+        if (det > 0.0f) {
+          render_strokes[curve_i].render_flag |= GP_ONDINE_STROKE_FILL_IS_CLOCKWISE;
         }
+      }
 
-        /* Set bounding box. */
-        render_strokes[curve_i].render_bbox[0] = bbox_minx + IMAGE_PADDING;
-        render_strokes[curve_i].render_bbox[1] = bbox_miny + IMAGE_PADDING;
-        render_strokes[curve_i].render_bbox[2] = bbox_maxx + IMAGE_PADDING;
-        render_strokes[curve_i].render_bbox[3] = bbox_maxy + IMAGE_PADDING;
-        render_strokes[curve_i].render_dist_to_camera = max_dist_to_cam;
+      /* Add padding to 2d points. */
+      for (const int point : points_by_curve[curve_i]) {
+        points_2d[point].x += IMAGE_PADDING;
+        points_2d[point].y += IMAGE_PADDING;
       }
-    });
+
+      /* Set bounding box. */
+      render_strokes[curve_i].render_bbox[0] = bbox_minx + IMAGE_PADDING;
+      render_strokes[curve_i].render_bbox[1] = bbox_miny + IMAGE_PADDING;
+      render_strokes[curve_i].render_bbox[2] = bbox_maxx + IMAGE_PADDING;
+      render_strokes[curve_i].render_bbox[3] = bbox_maxy + IMAGE_PADDING;
+      render_strokes[curve_i].render_dist_to_camera = max_dist_to_cam;
+    }
+  });
+
+  const GreasePencil &grease_pencil = *static_cast<const GreasePencil *>(object->data);
+  if (grease_pencil.ondine_flag & GP_ONDINE_COMPACT_POINTS) {
+    drawing->runtime->points_2d_compact.reinitialize(curves.points_num());
+    set_compact_points(
+        points_by_curve, points_2d, render_strokes, drawing->runtime->points_2d_compact);
+  }
+  else {
+    drawing->runtime->points_2d_compact = {};
   }
 }
 
@@ -506,9 +1086,9 @@ void gpencil_ondine_set_unique_stroke_seeds(bContext *C, const bool current_fram
   ondine_render->set_unique_stroke_seeds(C, current_frame_only);
 }
 
-void gpencil_ondine_set_render_data(Object *ob, const float mat[4][4])
+void gpencil_ondine_set_render_data(Object *ob, const float mat[4][4], const bool use_cache)
 {
-  ondine_render->set_render_data(ob, blender::float4x4(mat));
+  ondine_render->set_render_data(ob, blender::float4x4(mat), use_cache);
 }
 
 void gpencil_ondine_set_zdepth(Object *ob)
@@ -516,10 +1096,37 @@ void gpencil_ondine_set_zdepth(Object *ob)
   ondine_render->set_zdepth(ob);
 }
 
-bool gpencil_ondine_render_init(bContext *C)
+bool gpencil_ondine_render_init(bContext *C,
+                                const bool prepare_render_data,
+                                const bool use_cache,
+                                const char *export_filepath)
 {
   ondine_render->init(C);
-  return ondine_render->prepare_camera_params();
+  if (!ondine_render->prepare_camera_params()) {
+    return false;
+  }
+  if (prepare_render_data) {
+    Vector<RenderDataItem> items;
+    ondine_render->collect_render_data_all(items);
+    const Vector<RenderDataItem> items_to_compute = gpencil_ondine_prefetch_apply(
+        CTX_data_scene(C)->r.cfra, items);
+    ondine_render->set_render_data_for_items(items_to_compute, use_cache);
+    ondine_render->update_render_order(items);
+    if (export_filepath != nullptr && !ondine_render->write_render_data(export_filepath)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Span<OndineDepthEntry> gpencil_ondine_render_order()
+{
+  return ondine_render->render_order();
+}
+
+bool gpencil_ondine_render_data_export(const char *filepath)
+{
+  return ondine_render->write_render_data(filepath);
 }
 
 }  // namespace blender::ondine
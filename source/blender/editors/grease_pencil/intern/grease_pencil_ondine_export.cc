@@ -0,0 +1,116 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edgpencil
+ * Ondine: binary export of the prepared render data of a frame, so it can be painted without
+ * loading the blend file. See #OndineExportHeader for the file layout.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "BLI_fileops.h"
+#include "BLI_string.h"
+#include "BLI_vector.hh"
+
+#include "BKE_grease_pencil.hh"
+
+#include "ED_grease_pencil_ondine.hh"
+
+namespace blender::ondine {
+
+static uint64_t export_align(const uint64_t offset)
+{
+  return (offset + ONDINE_EXPORT_ALIGNMENT - 1) & ~(ONDINE_EXPORT_ALIGNMENT - 1);
+}
+
+static bool export_write_at(FILE *file,
+                            uint64_t &r_offset,
+                            const uint64_t offset,
+                            const void *data,
+                            const uint64_t size)
+{
+  static const char zeros[ONDINE_EXPORT_ALIGNMENT] = {0};
+  BLI_assert(offset >= r_offset && offset - r_offset < ONDINE_EXPORT_ALIGNMENT);
+  if (offset > r_offset && fwrite(zeros, offset - r_offset, 1, file) != 1) {
+    return false;
+  }
+  if (size > 0 && fwrite(data, size, 1, file) != 1) {
+    return false;
+  }
+  r_offset = offset + size;
+  return true;
+}
+
+bool GpencilOndine::write_render_data(const char *filepath)
+{
+  /* Drawings are stored back to front, so they can be painted in the stored order. */
+  const Span<OndineDepthEntry> order = this->render_order();
+
+  OndineExportHeader header = {};
+  memcpy(header.magic, ONDINE_EXPORT_MAGIC, sizeof(header.magic));
+  header.version = ONDINE_EXPORT_VERSION;
+  header.frame = cfra_;
+  header.render_size[0] = int32_t(render_x_);
+  header.render_size[1] = int32_t(render_y_);
+  header.drawings_num = uint32_t(order.size());
+  header.point_size = sizeof(GPStrokePoint);
+  header.stroke_size = sizeof(OndineRenderStroke);
+  header.drawing_size = sizeof(OndineExportDrawing);
+  header.drawings_offset = export_align(sizeof(OndineExportHeader));
+
+  /* Compute the layout of the data arrays. */
+  Array<OndineExportDrawing> drawings(order.size());
+  uint64_t offset = header.drawings_offset + drawings.as_span().size_in_bytes();
+  for (const int i : order.index_range()) {
+    const OndineDepthEntry &entry = order[i];
+    const bke::greasepencil::DrawingRuntime &runtime = *entry.drawing->runtime;
+    OndineExportDrawing &drawing = drawings[i];
+    memset(&drawing, 0, sizeof(drawing));
+    STRNCPY(drawing.object_name, entry.object->id.name + 2);
+    STRNCPY(drawing.layer_name, entry.layer->name().c_str());
+    drawing.zdepth = entry.zdepth;
+    drawing.strokes_num = uint64_t(runtime.render_strokes.size());
+    drawing.strokes_offset = export_align(offset);
+    offset = drawing.strokes_offset + runtime.render_strokes.as_span().size_in_bytes();
+    drawing.points_num = uint64_t(runtime.points_2d.size());
+    drawing.points_offset = export_align(offset);
+    offset = drawing.points_offset + runtime.points_2d.as_span().size_in_bytes();
+  }
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  uint64_t written = 0;
+  bool ok = export_write_at(file, written, 0, &header, sizeof(header));
+  ok = ok && export_write_at(file,
+                             written,
+                             header.drawings_offset,
+                             drawings.data(),
+                             drawings.as_span().size_in_bytes());
+  for (const int i : order.index_range()) {
+    if (!ok) {
+      break;
+    }
+    const bke::greasepencil::DrawingRuntime &runtime = *order[i].drawing->runtime;
+    ok = export_write_at(file,
+                         written,
+                         drawings[i].strokes_offset,
+                         runtime.render_strokes.data(),
+                         runtime.render_strokes.as_span().size_in_bytes());
+    ok = ok && export_write_at(file,
+                               written,
+                               drawings[i].points_offset,
+                               runtime.points_2d.data(),
+                               runtime.points_2d.as_span().size_in_bytes());
+  }
+
+  ok = (fclose(file) == 0) && ok;
+  return ok;
+}
+
+}  // namespace blender::ondine
@@ -0,0 +1,298 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edgpencil
+ * Ondine: prepare the render data of upcoming frames in the background.
+ *
+ * Modeled on the sequencer prefetch job: a worker thread evaluates a render depsgraph of the scene
+ * for the frames after the current frame and stores the prepared render data in a bounded ring of
+ * frames. When the render data of a prefetched frame is requested, it is moved into the drawings
+ * of the active depsgraph instead of being computed, for the drawings of which all inputs still
+ * match.
+ *
+ * Like the sequencer prefetch, the depsgraph is registered in a separate main database, so updates
+ * tagged from the main thread don't reach it while the worker evaluates it. It is built and
+ * evaluated once on the main thread, so the evaluated copies of the data are made there. The
+ * worker only evaluates those copies for other frames. Any edit makes the copies outdated, so the
+ * job is stopped then, see #gpencil_ondine_prefetch_stop.
+ */
+
+#include <string>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_scene_types.h"
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_threads.h"
+#include "BLI_vector.hh"
+
+#include "BKE_context.hh"
+#include "BKE_curves.hh"
+#include "BKE_grease_pencil.hh"
+#include "BKE_layer.hh"
+#include "BKE_main.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_debug.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "ED_grease_pencil_ondine.hh"
+
+namespace blender::ondine {
+
+/* Render data of one drawing, identified by its original object and layer name. */
+struct PrefetchDrawing {
+  const ID *object_orig;
+  std::string layer_name;
+  /* See #RenderDataItem::render_hash. */
+  uint64_t render_hash;
+  Array<GPStrokePoint> points_2d;
+  Array<OndineRenderStroke> render_strokes;
+  Array<GPStrokePointCompact> points_2d_compact;
+};
+
+struct PrefetchFrame {
+  int frame;
+  Vector<PrefetchDrawing> drawings;
+};
+
+struct PrefetchJob {
+  /* Only used to register the depsgraph, it doesn't contain any data. */
+  Main *bmain_eval;
+  Scene *scene;
+  Depsgraph *depsgraph;
+
+  ThreadMutex mutex;
+  ThreadCondition cond;
+  ListBase threads;
+
+  /* Prepared frames, in frame order. Accessed with #mutex locked. */
+  Vector<PrefetchFrame> frames;
+  /* Maximum number of prepared frames. */
+  int num_frames;
+  /* Next frame to prepare. Accessed with #mutex locked. */
+  int next_frame;
+
+  /* Control. Accessed with #mutex locked. */
+  bool stop;
+};
+
+static PrefetchJob *prefetch_job = nullptr;
+
+static bool prefetch_need_suspend(const PrefetchJob &job)
+{
+  return job.frames.size() >= job.num_frames || job.next_frame > job.scene->r.efra;
+}
+
+static std::pair<const ID *, StringRef> prefetch_drawing_key(const RenderDataItem &item)
+{
+  return {DEG_get_original_id(&item.object->id), item.layer->name()};
+}
+
+/**
+ * A drawing can be used by multiple items (e.g. by object instances). Its render data is computed
+ * for the last of them, see #GpencilOndine::set_render_data_for_items.
+ */
+static Map<const bke::greasepencil::Drawing *, int64_t> last_item_by_drawing_get(
+    const Span<RenderDataItem> items)
+{
+  Map<const bke::greasepencil::Drawing *, int64_t> last_item_by_drawing;
+  for (const int64_t item_i : items.index_range()) {
+    last_item_by_drawing.add_overwrite(items[item_i].drawing, item_i);
+  }
+  return last_item_by_drawing;
+}
+
+static PrefetchFrame prefetch_frame_prepare(PrefetchJob &job, const int frame)
+{
+  GpencilOndine ondine;
+  ondine.init(DEG_get_bmain(job.depsgraph), job.depsgraph, job.scene, frame);
+  ondine.prepare_camera_params();
+
+  Vector<RenderDataItem> items;
+  ondine.collect_render_data_all(items);
+  ondine.set_render_data_for_items(items, false);
+
+  PrefetchFrame prepared;
+  prepared.frame = frame;
+  for (const int64_t item_i : last_item_by_drawing_get(items).values()) {
+    const RenderDataItem &item = items[item_i];
+    bke::greasepencil::DrawingRuntime &runtime = *item.drawing->runtime;
+    PrefetchDrawing prefetched;
+    prefetched.object_orig = prefetch_drawing_key(item).first;
+    prefetched.layer_name = item.layer->name();
+    prefetched.render_hash = item.render_hash;
+    prefetched.points_2d = std::move(runtime.points_2d);
+    prefetched.render_strokes = std::move(runtime.render_strokes);
+    prefetched.points_2d_compact = std::move(runtime.points_2d_compact);
+    prepared.drawings.append(std::move(prefetched));
+  }
+  return prepared;
+}
+
+static void *prefetch_frames(void *job_v)
+{
+  PrefetchJob &job = *static_cast<PrefetchJob *>(job_v);
+
+  while (true) {
+    /* Suspend the thread while the ring of prepared frames is full. */
+    BLI_mutex_lock(&job.mutex);
+    while (!job.stop && prefetch_need_suspend(job)) {
+      BLI_condition_wait(&job.cond, &job.mutex);
+    }
+    const bool stop = job.stop;
+    const int frame = job.next_frame;
+    BLI_mutex_unlock(&job.mutex);
+
+    if (stop) {
+      break;
+    }
+
+    DEG_evaluate_on_framechange(job.depsgraph, frame);
+    PrefetchFrame prepared = prefetch_frame_prepare(job, frame);
+
+    BLI_mutex_lock(&job.mutex);
+    /* Discard the frame when the prefetch area was reset in the meantime. */
+    if (job.next_frame == frame) {
+      job.frames.append(std::move(prepared));
+      job.next_frame++;
+    }
+    BLI_mutex_unlock(&job.mutex);
+  }
+
+  return nullptr;
+}
+
+static void prefetch_init_depsgraph(PrefetchJob &job)
+{
+  ViewLayer *view_layer = BKE_view_layer_default_render(job.scene);
+
+  job.bmain_eval = BKE_main_new();
+  job.depsgraph = DEG_graph_new(job.bmain_eval, job.scene, view_layer, DAG_EVAL_RENDER);
+  DEG_debug_name_set(job.depsgraph, "ONDINE PREFETCH");
+  DEG_graph_build_for_render_pipeline(job.depsgraph);
+
+  /* Make the evaluated copies on the main thread, the worker only updates them for other
+   * frames. */
+  DEG_evaluate_on_framechange(job.depsgraph, job.scene->r.cfra);
+}
+
+void gpencil_ondine_prefetch_stop()
+{
+  if (prefetch_job == nullptr) {
+    return;
+  }
+  PrefetchJob *job = prefetch_job;
+  prefetch_job = nullptr;
+
+  BLI_mutex_lock(&job->mutex);
+  job->stop = true;
+  BLI_condition_notify_all(&job->cond);
+  BLI_mutex_unlock(&job->mutex);
+
+  BLI_threadpool_end(&job->threads);
+  BLI_mutex_end(&job->mutex);
+  BLI_condition_end(&job->cond);
+  DEG_graph_free(job->depsgraph);
+  BKE_main_free(job->bmain_eval);
+  MEM_delete(job);
+}
+
+void gpencil_ondine_prefetch_start(bContext *C, const int num_frames)
+{
+  Scene *scene = CTX_data_scene(C);
+  if (prefetch_job != nullptr && prefetch_job->scene == scene &&
+      prefetch_job->num_frames == num_frames)
+  {
+    return;
+  }
+
+  gpencil_ondine_prefetch_stop();
+  if (num_frames < 1) {
+    return;
+  }
+
+  PrefetchJob *job = MEM_new<PrefetchJob>(__func__);
+  job->scene = scene;
+  job->num_frames = num_frames;
+  job->next_frame = scene->r.cfra + 1;
+  job->stop = false;
+  prefetch_init_depsgraph(*job);
+
+  BLI_mutex_init(&job->mutex);
+  BLI_condition_init(&job->cond);
+  BLI_threadpool_init(&job->threads, prefetch_frames, 1);
+  BLI_threadpool_insert(&job->threads, job);
+
+  prefetch_job = job;
+}
+
+Vector<RenderDataItem> gpencil_ondine_prefetch_apply(const int frame,
+                                                     const Span<RenderDataItem> items)
+{
+  if (prefetch_job == nullptr) {
+    return items;
+  }
+  PrefetchJob &job = *prefetch_job;
+
+  BLI_mutex_lock(&job.mutex);
+  /* Drop frames that are no longer needed. */
+  while (!job.frames.is_empty() && job.frames.first().frame < frame) {
+    job.frames.remove(0);
+  }
+  std::optional<PrefetchFrame> prepared;
+  if (!job.frames.is_empty() && job.frames.first().frame == frame) {
+    prepared = std::move(job.frames.first());
+    job.frames.remove(0);
+  }
+  else {
+    /* Not prefetched (e.g. after a jump in time): restart after the requested frame. */
+    job.frames.clear();
+    job.next_frame = frame + 1;
+  }
+  BLI_condition_notify_one(&job.cond);
+  BLI_mutex_unlock(&job.mutex);
+
+  if (!prepared) {
+    return items;
+  }
+
+  Map<std::pair<const ID *, StringRef>, PrefetchDrawing *> drawing_by_key;
+  for (PrefetchDrawing &prefetched : prepared->drawings) {
+    drawing_by_key.add({prefetched.object_orig, prefetched.layer_name}, &prefetched);
+  }
+
+  /* Move the prepared render data into the drawings when it was computed from the same inputs,
+   * the other drawings are computed by the caller. Evaluated copies keep the change stamp of the
+   * original geometry, so the hashes match unless the drawing was changed by modifiers. */
+  Set<const bke::greasepencil::Drawing *> applied_drawings;
+  for (const int64_t item_i : last_item_by_drawing_get(items).values()) {
+    const RenderDataItem &item = items[item_i];
+    PrefetchDrawing *prefetched = drawing_by_key.lookup_default(prefetch_drawing_key(item),
+                                                                nullptr);
+    if (prefetched == nullptr || prefetched->render_hash != item.render_hash) {
+      continue;
+    }
+    bke::greasepencil::DrawingRuntime &runtime = *item.drawing->runtime;
+    runtime.points_2d = std::move(prefetched->points_2d);
+    runtime.render_strokes = std::move(prefetched->render_strokes);
+    runtime.points_2d_compact = std::move(prefetched->points_2d_compact);
+    runtime.render_data_hash = item.render_hash;
+    applied_drawings.add(item.drawing);
+  }
+
+  Vector<RenderDataItem> items_to_compute;
+  for (const RenderDataItem &item : items) {
+    if (!applied_drawings.contains(item.drawing)) {
+      items_to_compute.append(item);
+    }
+  }
+  return items_to_compute;
+}
+
+}  // namespace blender::ondine
@@ -7,6 +7,9 @@
 #include "BKE_grease_pencil.hh"
 
 #include "BLI_math_matrix_types.hh"
+#include "BLI_struct_equality_utils.hh"
+
+struct bContext;
 
 namespace blender::ondine {
 
@@ -14,16 +17,127 @@ namespace blender::ondine {
 constexpr int IMAGE_PADDING = 8;
 constexpr float GPENCIL_ALPHA_OPACITY_THRESHOLD = 0.001f;
 
+/* Projected bounding box of geometry, in render space. */
+struct OndineScreenBounds {
+  Bounds<float2> bounds;
+  /* Distance to the camera of the furthest corner. */
+  float max_dist_to_cam;
+};
+
+/* A drawing of a layer for which render data is computed. */
+struct RenderDataItem {
+  Object *object;
+  const bke::greasepencil::Layer *layer;
+  /* Index of #layer in the layers of the object. */
+  int layer_index;
+  bke::greasepencil::Drawing *drawing;
+  float4x4 matrix_world;
+  /* Hash of all inputs of the render data, see #GpencilOndine::render_data_hash_get. */
+  uint64_t render_hash;
+};
+
+/* Entry of the back to front render order of drawings, see #GpencilOndine::render_order. */
+struct OndineDepthEntry {
+  Object *object;
+  const bke::greasepencil::Layer *layer;
+  bke::greasepencil::Drawing *drawing;
+  /* Position along the camera z-axis, of the layer with true depth, of the object otherwise.
+   * Smaller values are further away. */
+  float zdepth;
+  /* Index in the collected render data items, to keep the order of layers with equal depth. */
+  int item_index;
+};
+
+/**
+ * Identifies an entry of the render order across frames, when the evaluated data the entry points
+ * to may have been freed and recreated.
+ */
+struct OndineDepthKey {
+  /* Session UID of the original object. */
+  uint32_t object_session_uid;
+  int layer_index;
+
+  uint64_t hash() const
+  {
+    return get_default_hash(this->object_session_uid, this->layer_index);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_2(OndineDepthKey, object_session_uid, layer_index)
+};
+
+/**
+ * Binary export of the render data of one frame, see #gpencil_ondine_render_data_export.
+ *
+ * The file starts with an #OndineExportHeader, followed by the #OndineExportDrawing table,
+ * ordered back to front by z-depth. The #OndineRenderStroke and #GPStrokePoint arrays of all
+ * drawings follow at the given byte offsets, aligned to #ONDINE_EXPORT_ALIGNMENT so the file can
+ * be memory-mapped and used in place. All values are stored in native byte order.
+ */
+constexpr char ONDINE_EXPORT_MAGIC[8] = {'O', 'N', 'D', 'I', 'N', 'E', 'R', 'D'};
+constexpr uint32_t ONDINE_EXPORT_VERSION = 1;
+constexpr uint64_t ONDINE_EXPORT_ALIGNMENT = 16;
+
+struct OndineExportHeader {
+  char magic[8];
+  uint32_t version;
+  int32_t frame;
+  int32_t render_size[2];
+  uint32_t drawings_num;
+  /* Size of the stored structs, to detect layout mismatches. */
+  uint32_t point_size;
+  uint32_t stroke_size;
+  uint32_t drawing_size;
+  /* Byte offset of the #OndineExportDrawing table. */
+  uint64_t drawings_offset;
+};
+
+struct OndineExportDrawing {
+  /* Names of the object and layer, without ID code. */
+  char object_name[64];
+  char layer_name[64];
+  float zdepth;
+  uint32_t _pad;
+  uint64_t strokes_offset;
+  uint64_t strokes_num;
+  uint64_t points_offset;
+  uint64_t points_num;
+};
+
 class GpencilOndine {
  public:
   /* Methods */
   GpencilOndine();
 
   void init(bContext *C);
+  /** Initialize without a context, for the given depsgraph and frame. */
+  void init(Main *bmain, Depsgraph *depsgraph, Scene *scene, const int frame);
   bool prepare_camera_params();
   void set_unique_stroke_seeds(bContext *C, const bool current_frame_only);
   float2 gpencil_3d_point_to_2d(const float3 co);
   float stroke_point_radius_get(const float3 point, const float thickness);
+  /**
+   * Batched projection of points in layer space to 2D render space. Sets the `x`, `y`,
+   * `dist_to_cam` and `radius` fields of \a r_points, using SIMD when available.
+   * \param layer_to_clip: Transform from layer space to clip space.
+   * \param dist_plane: Plane equation giving the distance to the camera of a point.
+   */
+  void project_points_batch(const float4x4 &layer_to_clip,
+                            const float4 &dist_plane,
+                            Span<float3> positions,
+                            Span<float> radii,
+                            MutableSpan<GPStrokePoint> r_points);
+  /**
+   * Frustum culling: check if a bounding box in layer space is certainly outside of the camera
+   * view. Bounds that are (partly) behind the camera are never culled.
+   */
+  bool bounds_out_of_view(const float4x4 &layer_to_clip,
+                          const float4 &dist_plane,
+                          const Bounds<float3> &bounds,
+                          OndineScreenBounds &r_screen_bounds);
+  /** Batched version of #stroke_point_radius_get. */
+  void stroke_point_radii_get(Span<float3> positions,
+                              const float thickness,
+                              MutableSpan<float> r_radii);
   void get_vertex_color(const MaterialGPencilStyle *mat_style,
                         const ColorGeometry4f &vertex_color,
                         const bool use_texture,
@@ -33,7 +147,39 @@ class GpencilOndine {
                       const bke::greasepencil::Layer &layer,
                       OndineRenderStroke &r_render_stroke);
   void set_zdepth(Object *object);
-  void set_render_data(Object *object, const blender::float4x4 obmat);
+  /**
+   * Compute the 2D render data of all visible drawings of the object. When \a use_cache is set,
+   * drawings of which the geometry, transforms, materials and camera didn't change since the
+   * previous call keep their existing render data.
+   */
+  void set_render_data(Object *object, const blender::float4x4 obmat, const bool use_cache);
+  /**
+   * Set the z-depth and compute the render data of all watercolor objects (and their instances)
+   * in the depsgraph in a single pass, with all drawings scheduled in parallel.
+   */
+  void set_render_data_all(const bool use_cache);
+  /**
+   * Set the z-depth of all watercolor objects in the depsgraph and collect the drawings for
+   * which render data is needed.
+   */
+  void collect_render_data_all(Vector<RenderDataItem> &r_items);
+  void set_render_data_for_items(Span<RenderDataItem> items, const bool use_cache);
+  /**
+   * Update the back to front order of the drawings of \a items. The order of the previous call is
+   * used as starting point, so the few swaps caused by small camera or object moves are an
+   * incremental update instead of a full sort. Also updates the stroke order of drawings of
+   * objects with true depth.
+   */
+  void update_render_order(Span<RenderDataItem> items);
+  /** Sort the strokes of a drawing back to front, see #DrawingRuntime::render_stroke_order. */
+  void update_stroke_render_order(const bke::greasepencil::Drawing &drawing);
+  /**
+   * Drawings of the prepared render data, ordered back to front. Only valid until the depsgraph
+   * is evaluated again, the entries point to evaluated data.
+   */
+  Span<OndineDepthEntry> render_order() const;
+  /** Write the prepared render data of all drawings to a binary file, see #OndineExportHeader. */
+  bool write_render_data(const char *filepath);
 
  protected:
   blender::float4x4 diff_mat_;
@@ -58,13 +204,72 @@ class GpencilOndine {
 
   int cfra_;
 
+  /* Hash of the camera parameters, part of the render data hash of every drawing. */
+  uint64_t camera_hash_ = 0;
+
+  /* Back to front order of the drawings of the prepared frame. Cleared by #init, since the
+   * evaluated data it points to doesn't outlive the frame. */
+  Vector<OndineDepthEntry> render_order_;
+  /* Keys of #render_order_, kept between frames as starting point of the next order. */
+  Vector<OndineDepthKey> render_order_keys_;
+
+  void collect_render_data_items(Object *object,
+                                 const float4x4 &matrix_world,
+                                 Vector<RenderDataItem> &r_items);
+  void set_drawing_render_data(const RenderDataItem &item);
+
+  uint64_t materials_hash_get(Object *object);
+  uint64_t render_data_hash_get(const bke::greasepencil::Drawing &drawing,
+                                const bke::greasepencil::Layer &layer,
+                                const float4x4 &layer_to_world,
+                                const float4x4 &matrix_world,
+                                const float4x4 &object_to_world,
+                                const uint64_t materials_hash);
+
  private:
   float persmat_[4][4];
 };
 
 void gpencil_ondine_set_unique_stroke_seeds(bContext *C, const bool current_frame_only);
-void gpencil_ondine_set_render_data(Object *ob, const float mat[4][4]);
+void gpencil_ondine_set_render_data(Object *ob, const float mat[4][4], const bool use_cache);
 void gpencil_ondine_set_zdepth(Object *ob);
-bool gpencil_ondine_render_init(bContext *C);
+/**
+ * Initialize the Ondine render data for the current frame. When \a prepare_render_data is set,
+ * the render data of all watercolor objects is computed as well, so there is no need to call
+ * #gpencil_ondine_set_zdepth and #gpencil_ondine_set_render_data per object.
+ */
+bool gpencil_ondine_render_init(bContext *C,
+                                const bool prepare_render_data = false,
+                                const bool use_cache = false,
+                                const char *export_filepath = nullptr);
+/**
+ * Write the prepared render data of the current frame to \a filepath, in the format described at
+ * #OndineExportHeader. Call after the render data is prepared.
+ * \return false when the file couldn't be written.
+ */
+bool gpencil_ondine_render_data_export(const char *filepath);
+/**
+ * Drawings of the prepared render data, ordered back to front, so they can be painted in order
+ * without sorting.
+ */
+Span<OndineDepthEntry> gpencil_ondine_render_order();
+
+/**
+ * Start preparing the render data of the \a num_frames frames after the current frame in a
+ * background thread. #gpencil_ondine_render_init with \a prepare_render_data set uses the
+ * prepared frames when available. A running prefetch job of the same scene and size is kept.
+ */
+void gpencil_ondine_prefetch_start(bContext *C, const int num_frames);
+/**
+ * Stop the prefetch job and free the prepared frames. Called when the data it was started from
+ * changes: on edits, undo, file load and exit.
+ */
+void gpencil_ondine_prefetch_stop();
+/**
+ * Move the prefetched render data of \a frame into the drawings of \a items, for the drawings of
+ * which all inputs are unchanged since they were prefetched.
+ * \return The items of which the render data still has to be computed.
+ */
+Vector<RenderDataItem> gpencil_ondine_prefetch_apply(const int frame, Span<RenderDataItem> items);
 
 }  // namespace blender::ondine
@@ -533,7 +533,9 @@ static Vector<NodeBakeRequest> collect_simulations_to_bake(Main &bmain,
         request.nmd = nmd;
         request.bake_id = id;
         request.node_type = node->type;
-        request.blob_sharing = std::make_unique<bake::BlobWriteSharing>();
+        const NodesModifierBake *bake = nmd->find_bake(id);
+        request.blob_sharing = std::make_unique<bake::BlobWriteSharing>(
+            bake ? bake->keyframe_interval : 0);
         std::optional<bake::BakePath> path = bake::get_node_bake_path(bmain, *object, *nmd, id);
         if (!path) {
           continue;
@@ -834,12 +836,12 @@ static Vector<NodeBakeRequest> bake_single_node_gather_bake_request(bContext *C,
   request.nmd = &nmd;
   request.bake_id = bake_id;
   request.node_type = node->type;
-  request.blob_sharing = std::make_unique<bake::BlobWriteSharing>();
 
   const NodesModifierBake *bake = nmd.find_bake(bake_id);
   if (!bake) {
     return {};
   }
+  request.blob_sharing = std::make_unique<bake::BlobWriteSharing>(bake->keyframe_interval);
   const std::optional<bake::BakePath> bake_path = bake::get_node_bake_path(
       *bmain, *object, nmd, bake_id);
   if (!bake_path.has_value()) {
@@ -39,6 +39,7 @@
 #include "RE_engine.h"
 #include "RE_pipeline.h"
 
+#include "ED_grease_pencil_ondine.hh"
 #include "ED_node.hh"
 #include "ED_node_preview.hh"
 #include "ED_paint.hh"
@@ -317,6 +318,8 @@ void ED_render_id_flush_update(const DEGEditorUpdateContext *update_ctx, ID *id)
     return;
   }
   Main *bmain = update_ctx->bmain;
+  /* Render data prefetched for upcoming frames was computed before the edit. */
+  blender::ondine::gpencil_ondine_prefetch_stop();
   /* Internal ID update handlers. */
   switch (GS(id->name)) {
     case ID_MA:
@@ -20,6 +20,8 @@ void do_blob_brush(const Scene &scene, const Sculpt &sd, Object &ob, Span<PBVHNo
 void do_displacement_eraser_brush(const Sculpt &sd, Object &ob, Span<PBVHNode *> nodes);
 /** A simple normal-direction displacement. */
 void do_draw_brush(const Sculpt &sd, Object &object, Span<PBVHNode *> nodes);
+/** A normal-direction displacement with the influence based on the original positions. */
+void do_draw_sharp_brush(const Sculpt &sd, Object &object, Span<PBVHNode *> nodes);
 /** A simple normal-direction displacement based on image texture RGB/XYZ values. */
 void do_draw_vector_displacement_brush(const Sculpt &sd, Object &object, Span<PBVHNode *> nodes);
 void do_fill_brush(const Sculpt &sd, Object &object, Span<PBVHNode *> nodes);
@@ -6,6 +6,7 @@
 
 #include "curves_sculpt_intern.hh"
 
+#include "BLI_bounds.hh"
 #include "BLI_kdtree.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix_types.hh"
@@ -53,6 +54,17 @@ namespace blender::ed::sculpt_paint {
 
 using blender::bke::CurvesGeometry;
 
+/** Unlike #bounds::intersect, bounds that only touch or have no volume are overlapping too. */
+template<typename T> static bool bounds_overlap(const Bounds<T> &a, const Bounds<T> &b)
+{
+  for (const int i : IndexRange(T::type_length)) {
+    if (a.max[i] < b.min[i] || a.min[i] > b.max[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /**
  * Moves individual points under the brush and does a length preservation step afterwards.
  */
@@ -69,6 +81,14 @@ class CombOperation : public CurvesSculptStrokeOperation {
 
   Array<float> curve_lengths_;
 
+  /**
+   * Bounds of the deformed positions of every curve, used to skip curves that are far away from
+   * the brush without testing all their points. Only the bounds of the curves that were changed
+   * by the previous brush step have to be updated.
+   */
+  Array<Bounds<float3>> curve_bounds_cu_;
+  Vector<int> curves_with_outdated_bounds_;
+
   friend struct CombOperationExecutor;
 
  public:
@@ -153,10 +173,20 @@ struct CombOperationExecutor {
           self_->curve_lengths_[curve_i] = std::accumulate(lengths.begin(), lengths.end(), 0.0f);
         }
       });
+      self_->curve_bounds_cu_.reinitialize(curves_orig_->curves_num());
+      this->update_curve_bounds(curve_selection_);
       /* Combing does nothing when there is no mouse movement, so return directly. */
       return;
     }
 
+    if (!self_->curves_with_outdated_bounds_.is_empty()) {
+      /* The deformed positions of the curves changed in the previous step are available now. */
+      IndexMaskMemory memory;
+      this->update_curve_bounds(
+          IndexMask::from_indices(self_->curves_with_outdated_bounds_.as_span(), memory));
+      self_->curves_with_outdated_bounds_.clear();
+    }
+
     Array<bool> changed_curves(curves_orig_->curves_num(), false);
 
     if (falloff_shape == PAINT_FALLOFF_SHAPE_TUBE) {
@@ -176,6 +206,8 @@ struct CombOperationExecutor {
     IndexMaskMemory memory;
     const IndexMask changed_curves_mask = IndexMask::from_bools(changed_curves, memory);
     self_->constraint_solver_.solve_step(*curves_orig_, changed_curves_mask, surface, transforms_);
+    self_->curves_with_outdated_bounds_.resize(changed_curves_mask.size());
+    changed_curves_mask.to_indices(self_->curves_with_outdated_bounds_.as_mutable_span());
 
     curves_orig_->tag_positions_changed();
     DEG_id_tag_update(&curves_id_orig_->id, ID_RECALC_GEOMETRY);
@@ -183,6 +215,43 @@ struct CombOperationExecutor {
     ED_region_tag_redraw(ctx_.region);
   }
 
+  void update_curve_bounds(const IndexMask &curves)
+  {
+    const bke::crazyspace::GeometryDeformation deformation =
+        bke::crazyspace::get_evaluated_curves_deformation(*ctx_.depsgraph, *curves_ob_orig_);
+    const OffsetIndices points_by_curve = curves_orig_->points_by_curve();
+    curves.foreach_index(GrainSize(512), [&](const int curve_i) {
+      self_->curve_bounds_cu_[curve_i] = *bounds::min_max(
+          deformation.positions.slice(points_by_curve[curve_i]));
+    });
+  }
+
+  /**
+   * Whether the bounds of a curve may overlap with the brush in screen space. The test is
+   * conservative when parts of the bounds are behind the view.
+   */
+  bool curve_may_be_in_projected_brush(const int curve_i,
+                                       const float4x4 &brush_transform_inv,
+                                       const float4x4 &projection,
+                                       const Bounds<float2> &brush_bounds_re) const
+  {
+    const Bounds<float3> &bounds_cu = self_->curve_bounds_cu_[curve_i];
+    Bounds<float2> bounds_re(float2(FLT_MAX), float2(-FLT_MAX));
+    for (const int corner : IndexRange(8)) {
+      const float3 corner_cu(corner & 1 ? bounds_cu.max.x : bounds_cu.min.x,
+                             corner & 2 ? bounds_cu.max.y : bounds_cu.min.y,
+                             corner & 4 ? bounds_cu.max.z : bounds_cu.min.z);
+      const float3 symm_corner_cu = math::transform_point(brush_transform_inv, corner_cu);
+      if ((projection * float4(symm_corner_cu, 1.0f)).w <= FLT_EPSILON) {
+        return true;
+      }
+      const float2 corner_re = ED_view3d_project_float_v2_m4(
+          ctx_.region, symm_corner_cu, projection);
+      math::min_max(corner_re, bounds_re.min, bounds_re.max);
+    }
+    return bounds_overlap(bounds_re, brush_bounds_re);
+  }
+
   /**
    * Do combing in screen space.
    */
@@ -215,8 +284,17 @@ struct CombOperationExecutor {
 
     const Span<float> segment_lengths = self_->constraint_solver_.segment_lengths();
 
+    Bounds<float2> brush_bounds_re(math::min(brush_pos_prev_re_, brush_pos_re_),
+                                   math::max(brush_pos_prev_re_, brush_pos_re_));
+    brush_bounds_re.pad(brush_radius_re);
+
     curve_selection_.foreach_segment(GrainSize(256), [&](const IndexMaskSegment segment) {
       for (const int curve_i : segment) {
+        if (!this->curve_may_be_in_projected_brush(
+                curve_i, brush_transform_inv, projection, brush_bounds_re))
+        {
+          continue;
+        }
         bool curve_changed = false;
         const IndexRange points = points_by_curve[curve_i];
 
@@ -330,8 +408,15 @@ struct CombOperationExecutor {
     const OffsetIndices points_by_curve = curves_orig_->points_by_curve();
     const Span<float> segment_lengths = self_->constraint_solver_.segment_lengths();
 
+    Bounds<float3> brush_bounds_cu(math::min(brush_start_cu, brush_end_cu),
+                                   math::max(brush_start_cu, brush_end_cu));
+    brush_bounds_cu.pad(brush_radius_cu);
+
     curve_selection_.foreach_segment(GrainSize(256), [&](const IndexMaskSegment segment) {
       for (const int curve_i : segment) {
+        if (!bounds_overlap(self_->curve_bounds_cu_[curve_i], brush_bounds_cu)) {
+          continue;
+        }
         bool curve_changed = false;
         const IndexRange points = points_by_curve[curve_i];
 
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <numeric>
+#include <optional>
 
 #include "BKE_attribute_math.hh"
 #include "BKE_brush.hh"
@@ -26,6 +27,7 @@
 #include "BLI_array_utils.hh"
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_kdtree.h"
+#include "BLI_map.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
 
@@ -40,6 +42,54 @@
 
 namespace blender::ed::sculpt_paint {
 
+/**
+ * Uniform grid of the root positions that have been added in the current stroke. Unlike a
+ * KD-tree, it can be extended after every brush step without rebuilding it. The cell size is the
+ * minimum distance at the start of the stroke, so usually only neighboring cells are checked.
+ */
+class RootPositionGrid {
+ private:
+  float cell_size_;
+  Map<int3, Vector<float3>> cells_;
+
+ public:
+  RootPositionGrid(const float cell_size) : cell_size_(std::max(cell_size, 1e-4f)) {}
+
+  void add(const float3 &position)
+  {
+    cells_.lookup_or_add_default(this->cell_of(position)).append(position);
+  }
+
+  bool has_position_within(const float3 &position, const float distance) const
+  {
+    const int3 cell = this->cell_of(position);
+    const int cells_range = int(std::ceil(distance / cell_size_));
+    const float distance_sq = distance * distance;
+    for (int z = -cells_range; z <= cells_range; z++) {
+      for (int y = -cells_range; y <= cells_range; y++) {
+        for (int x = -cells_range; x <= cells_range; x++) {
+          const Vector<float3> *positions = cells_.lookup_ptr(cell + int3(x, y, z));
+          if (positions == nullptr) {
+            continue;
+          }
+          for (const float3 &other : *positions) {
+            if (math::distance_squared(position, other) <= distance_sq) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+ private:
+  int3 cell_of(const float3 &position) const
+  {
+    return int3(math::floor(position / cell_size_));
+  }
+};
+
 class DensityAddOperation : public CurvesSculptStrokeOperation {
  private:
   /** Used when some data should be interpolated from existing curves. */
@@ -47,7 +97,7 @@ class DensityAddOperation : public CurvesSculptStrokeOperation {
   /** Contains curve roots of all curves that existed before the brush started. */
   KDTree_3d *deformed_curve_roots_kdtree_ = nullptr;
   /** Root positions of curves that have been added in the current brush stroke. */
-  Vector<float3> new_deformed_root_positions_;
+  std::optional<RootPositionGrid> new_deformed_roots_grid_;
   int original_curve_num_ = 0;
 
   friend struct DensityAddOperationExecutor;
@@ -182,67 +232,44 @@ struct DensityAddOperationExecutor {
     if (stroke_extension.is_first) {
       this->prepare_curve_roots_kdtrees();
     }
-
-    const int already_added_curves = self_->new_deformed_root_positions_.size();
-    KDTree_3d *new_roots_kdtree = BLI_kdtree_3d_new(already_added_curves +
-                                                    new_positions_cu.size());
-    BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(new_roots_kdtree); });
+    if (!self_->new_deformed_roots_grid_) {
+      self_->new_deformed_roots_grid_.emplace(brush_settings_->minimum_distance);
+    }
+    RootPositionGrid &new_roots_grid = *self_->new_deformed_roots_grid_;
+    const float minimum_distance = brush_settings_->minimum_distance;
 
     /* Used to tag all curves that are too close to existing curves or too close to other new
      * curves. */
     Array<bool> new_curve_skipped(new_positions_cu.size(), false);
-    threading::parallel_invoke(
-        512 < already_added_curves + new_positions_cu.size(),
-        /* Build kdtree from root points created by the current stroke. */
-        [&]() {
-          for (const int i : IndexRange(already_added_curves)) {
-            BLI_kdtree_3d_insert(new_roots_kdtree, -1, self_->new_deformed_root_positions_[i]);
-          }
-          for (const int new_i : new_positions_cu.index_range()) {
-            const float3 &root_pos_cu = new_positions_cu[new_i];
-            BLI_kdtree_3d_insert(new_roots_kdtree, new_i, root_pos_cu);
-          }
-          BLI_kdtree_3d_balance(new_roots_kdtree);
-        },
-        /* Check which new root points are close to roots that existed before the current stroke
-         * started. */
-        [&]() {
-          threading::parallel_for(
-              new_positions_cu.index_range(), 128, [&](const IndexRange range) {
-                for (const int new_i : range) {
-                  const float3 &new_root_pos_cu = new_positions_cu[new_i];
-                  KDTreeNearest_3d nearest;
-                  nearest.dist = FLT_MAX;
-                  BLI_kdtree_3d_find_nearest(
-                      self_->deformed_curve_roots_kdtree_, new_root_pos_cu, &nearest);
-                  if (nearest.dist < brush_settings_->minimum_distance) {
-                    new_curve_skipped[new_i] = true;
-                  }
-                }
-              });
-        });
 
-    /* Find new points that are too close too other new points. */
+    /* Check which new root points are close to roots that existed before the current stroke
+     * started. */
+    threading::parallel_for(new_positions_cu.index_range(), 128, [&](const IndexRange range) {
+      for (const int new_i : range) {
+        const float3 &new_root_pos_cu = new_positions_cu[new_i];
+        KDTreeNearest_3d nearest;
+        nearest.dist = FLT_MAX;
+        BLI_kdtree_3d_find_nearest(self_->deformed_curve_roots_kdtree_, new_root_pos_cu, &nearest);
+        if (nearest.dist < minimum_distance) {
+          new_curve_skipped[new_i] = true;
+        }
+      }
+    });
+
+    /* Find new points that are too close to points added in this stroke, including the ones that
+     * are kept in this step. */
     for (const int new_i : new_positions_cu.index_range()) {
       if (new_curve_skipped[new_i]) {
         continue;
       }
       const float3 &root_pos_cu = new_positions_cu[new_i];
-      BLI_kdtree_3d_range_search_cb_cpp(
-          new_roots_kdtree,
-          root_pos_cu,
-          brush_settings_->minimum_distance,
-          [&](const int other_new_i, const float * /*co*/, float /*dist_sq*/) {
-            if (other_new_i == -1) {
-              new_curve_skipped[new_i] = true;
-              return false;
-            }
-            if (new_i == other_new_i) {
-              return true;
-            }
-            new_curve_skipped[other_new_i] = true;
-            return true;
-          });
+      if (minimum_distance > 0.0f &&
+          new_roots_grid.has_position_within(root_pos_cu, minimum_distance))
+      {
+        new_curve_skipped[new_i] = true;
+        continue;
+      }
+      new_roots_grid.add(root_pos_cu);
     }
 
     /* Remove points that are too close to others. */
@@ -252,7 +279,6 @@ struct DensityAddOperationExecutor {
         new_uvs.remove_and_reorder(i);
       }
     }
-    self_->new_deformed_root_positions_.extend(new_positions_cu);
 
     const Span<float3> corner_normals_su = surface_orig_->corner_normals();
     const Span<int3> surface_corner_tris_orig = surface_orig_->corner_tris();
@@ -48,6 +48,19 @@ class EraseOperation : public GreasePencilStrokeOperation {
   float radius_ = 50.0f;
   eGP_BrushEraserMode eraser_mode_ = GP_BRUSH_ERASER_HARD;
   bool active_layer_only_ = false;
+
+  /* Screen space data of a drawing, kept for the brush stroke until the eraser changes the
+   * drawing. */
+  struct DrawingScreenSpace {
+    Array<float2> positions;
+    /* Segments, identified by their first point. The last point of non-cyclic curves is a
+     * degenerate segment. */
+    ScreenSpaceGrid segments;
+    Array<int> point_to_curve;
+  };
+  /* Entries are added before the drawings are processed in parallel, each task only changes its
+   * own entry. */
+  Map<const bke::greasepencil::Drawing *, std::unique_ptr<DrawingScreenSpace>> screen_space_;
 };
 
 /**
@@ -252,6 +265,8 @@ struct EraseOperationExecutor {
    *
    * \param screen_space_positions: 2D positions of the geometry in screen space.
    *
+   * \param brush_curves: curves that may intersect the eraser, other curves are left untouched.
+   *
    * \param intersections_max_per_segment: maximum number of intersections per-segment.
    *
    * \param r_point_side: (output) for each point in the source, enum describing where the point
@@ -267,6 +282,7 @@ struct EraseOperationExecutor {
   int curves_intersections_and_points_sides(
       const bke::CurvesGeometry &src,
       const Span<float2> screen_space_positions,
+      const IndexMask &brush_curves,
       const int intersections_max_per_segment,
       MutableSpan<PointCircleSide> r_point_side,
       MutableSpan<SegmentCircleIntersection> r_intersections) const
@@ -276,15 +292,15 @@ struct EraseOperationExecutor {
     const VArray<bool> src_cyclic = src.cyclic();
 
     Array<int2> screen_space_positions_pixel(src.points_num());
-    threading::parallel_for(src.points_range(), 1024, [&](const IndexRange src_points) {
-      for (const int src_point : src_points) {
+    brush_curves.foreach_index(GrainSize(512), [&](const int src_curve) {
+      for (const int src_point : src_points_by_curve[src_curve]) {
         const float2 pos = screen_space_positions[src_point];
         screen_space_positions_pixel[src_point] = int2(round_fl_to_int(pos[0]),
                                                        round_fl_to_int(pos[1]));
       }
     });
 
-    threading::parallel_for(src.curves_range(), 512, [&](const IndexRange src_curves) {
+    brush_curves.foreach_segment(GrainSize(512), [&](const IndexMaskSegment src_curves) {
       for (const int src_curve : src_curves) {
         const IndexRange src_curve_points = src_points_by_curve[src_curve];
 
@@ -362,11 +378,17 @@ struct EraseOperationExecutor {
 
     /* Compute total number of intersections. */
     int total_intersections = 0;
-    for (const SegmentCircleIntersection &intersection : r_intersections) {
-      if (intersection.is_valid()) {
-        total_intersections++;
+    brush_curves.foreach_index([&](const int src_curve) {
+      const IndexRange src_curve_points = src_points_by_curve[src_curve];
+      for (const SegmentCircleIntersection &intersection : r_intersections.slice(
+               src_curve_points.start() * intersections_max_per_segment,
+               src_curve_points.size() * intersections_max_per_segment))
+      {
+        if (intersection.is_valid()) {
+          total_intersections++;
+        }
       }
-    }
+    });
 
     return total_intersections;
   }
@@ -377,6 +399,7 @@ struct EraseOperationExecutor {
 
   bool hard_eraser(const bke::CurvesGeometry &src,
                    const Span<float2> screen_space_positions,
+                   const IndexMask &brush_curves,
                    bke::CurvesGeometry &dst,
                    const bool keep_caps) const
   {
@@ -391,14 +414,28 @@ struct EraseOperationExecutor {
     Array<PointCircleSide> src_point_side(src_points_num, PointCircleSide::Outside);
     Array<SegmentCircleIntersection> src_intersections(src_points_num *
                                                        intersections_max_per_segment);
-    curves_intersections_and_points_sides(src,
+    const int intersections_num = curves_intersections_and_points_sides(src,
                                           screen_space_positions,
+                                          brush_curves,
                                           intersections_max_per_segment,
                                           src_point_side,
                                           src_intersections);
 
-    Array<Vector<ed::greasepencil::PointTransferData>> src_to_dst_points(src_points_num);
     const OffsetIndices<int> src_points_by_curve = src.points_by_curve();
+    if (intersections_num == 0) {
+      /* Nothing to erase unless some curves are entirely inside of the eraser. */
+      bool has_inside_points = false;
+      brush_curves.foreach_index([&](const int src_curve) {
+        for (const int src_point : src_points_by_curve[src_curve]) {
+          has_inside_points |= (src_point_side[src_point] == PointCircleSide::Inside);
+        }
+      });
+      if (!has_inside_points) {
+        return false;
+      }
+    }
+
+    Array<Vector<ed::greasepencil::PointTransferData>> src_to_dst_points(src_points_num);
     for (const int src_curve : src.curves_range()) {
       const IndexRange src_points = src_points_by_curve[src_curve];
 
@@ -443,21 +480,22 @@ struct EraseOperationExecutor {
 
   bool stroke_eraser(const bke::CurvesGeometry &src,
                      const Span<float2> screen_space_positions,
+                     const IndexMask &brush_curves,
                      bke::CurvesGeometry &dst) const
   {
     const OffsetIndices<int> src_points_by_curve = src.points_by_curve();
     const VArray<bool> src_cyclic = src.cyclic();
 
     IndexMaskMemory memory;
-    const IndexMask strokes_to_keep = IndexMask::from_predicate(
-        src.curves_range(), GrainSize(256), memory, [&](const int src_curve) {
+    const IndexMask strokes_to_erase = IndexMask::from_predicate(
+        brush_curves, GrainSize(256), memory, [&](const int src_curve) {
           const IndexRange src_curve_points = src_points_by_curve[src_curve];
 
           /* One-point stroke : remove the stroke if the point lies inside of the eraser. */
           if (src_curve_points.size() == 1) {
             const float2 &point_pos = screen_space_positions[src_curve_points.first()];
             const float dist_to_eraser = math::distance(point_pos, this->mouse_position);
-            return !(dist_to_eraser < this->eraser_radius);
+            return dist_to_eraser < this->eraser_radius;
           }
 
           /* If any segment of the stroke is closer to the eraser than its radius, then remove
@@ -468,7 +506,7 @@ struct EraseOperationExecutor {
                 screen_space_positions[src_point],
                 screen_space_positions[src_point + 1]);
             if (dist_to_eraser < this->eraser_radius) {
-              return false;
+              return true;
             }
           }
 
@@ -478,21 +516,88 @@ struct EraseOperationExecutor {
                 screen_space_positions[src_curve_points.first()],
                 screen_space_positions[src_curve_points.last()]);
             if (dist_to_eraser < this->eraser_radius) {
-              return false;
+              return true;
             }
           }
 
-          return true;
+          return false;
         });
 
-    if (strokes_to_keep.size() == src.curves_num()) {
+    if (strokes_to_erase.is_empty()) {
       return false;
     }
 
+    const IndexMask strokes_to_keep = strokes_to_erase.complement(src.curves_range(), memory);
+
     dst = bke::curves_copy_curve_selection(src, strokes_to_keep, {});
     return true;
   }
 
+  static EraseOperation::DrawingScreenSpace build_screen_space(
+      const ARegion &region,
+      const Object &ob_eval,
+      const Object &ob_orig,
+      const bke::greasepencil::Layer &layer,
+      const int layer_index,
+      const int frame_number,
+      const bke::CurvesGeometry &src)
+  {
+    /* Evaluated geometry. */
+    bke::crazyspace::GeometryDeformation deformation =
+        bke::crazyspace::get_evaluated_grease_pencil_drawing_deformation(
+            &ob_eval, ob_orig, layer_index, frame_number);
+
+    /* Compute screen space positions. */
+    EraseOperation::DrawingScreenSpace screen_space;
+    screen_space.positions.reinitialize(src.points_num());
+    MutableSpan<float2> positions = screen_space.positions;
+    const float4x4 transform = layer.to_world_space(ob_eval);
+    threading::parallel_for(src.points_range(), 4096, [&](const IndexRange src_points) {
+      for (const int src_point : src_points) {
+        ED_view3d_project_float_global(&region,
+                                       math::transform_point(transform,
+                                                             deformation.positions[src_point]),
+                                       positions[src_point],
+                                       V3D_PROJ_TEST_NOP);
+      }
+    });
+
+    const OffsetIndices<int> points_by_curve = src.points_by_curve();
+    const VArray<bool> cyclic = src.cyclic();
+    Array<Bounds<float2>> segment_bounds(src.points_num());
+    threading::parallel_for(src.curves_range(), 512, [&](const IndexRange range) {
+      for (const int curve : range) {
+        const IndexRange points = points_by_curve[curve];
+        for (const int point : points) {
+          const int last_next_point = cyclic[curve] ? points.first() : point;
+          const int next_point = (point < points.last()) ? point + 1 : last_next_point;
+          segment_bounds[point] = {math::min(positions[point], positions[next_point]),
+                                   math::max(positions[point], positions[next_point])};
+        }
+      }
+    });
+    screen_space.segments = ScreenSpaceGrid(segment_bounds);
+    screen_space.point_to_curve = src.point_to_curve_map();
+    return screen_space;
+  }
+
+  /* Curves with segments within the eraser radius. */
+  IndexMask brush_curves(const EraseOperation::DrawingScreenSpace &screen_space,
+                         IndexMaskMemory &memory) const
+  {
+    /* Add a pixel for the rounding of the positions in the hard eraser. */
+    const IndexMask segments = screen_space.segments.items_in_circle(
+        this->mouse_position, this->eraser_radius + 1.0f, memory);
+    Vector<int> curves;
+    segments.foreach_index([&](const int segment) {
+      const int curve = screen_space.point_to_curve[segment];
+      if (curves.is_empty() || curves.last() != curve) {
+        curves.append(curve);
+      }
+    });
+    return IndexMask::from_indices(curves.as_span(), memory);
+  }
+
   void execute(EraseOperation &self, const bContext &C, const InputSample &extension_sample)
   {
     using namespace blender::bke::greasepencil;
@@ -528,32 +633,31 @@ struct EraseOperationExecutor {
       const Layer &layer = *grease_pencil.layer(layer_index);
       const bke::CurvesGeometry &src = drawing.strokes();
 
-      /* Evaluated geometry. */
-      bke::crazyspace::GeometryDeformation deformation =
-          bke::crazyspace::get_evaluated_grease_pencil_drawing_deformation(
-              ob_eval, *obact, layer_index, frame_number);
-
-      /* Compute screen space positions. */
-      Array<float2> screen_space_positions(src.points_num());
-      threading::parallel_for(src.points_range(), 4096, [&](const IndexRange src_points) {
-        for (const int src_point : src_points) {
-          ED_view3d_project_float_global(region,
-                                         math::transform_point(layer.to_world_space(*ob_eval),
-                                                               deformation.positions[src_point]),
-                                         screen_space_positions[src_point],
-                                         V3D_PROJ_TEST_NOP);
-        }
-      });
+      std::unique_ptr<EraseOperation::DrawingScreenSpace> &screen_space =
+          self.screen_space_.lookup(&drawing);
+      if (!screen_space) {
+        screen_space = std::make_unique<EraseOperation::DrawingScreenSpace>(
+            build_screen_space(*region, *ob_eval, *obact, layer, layer_index, frame_number, src));
+      }
+      const Span<float2> screen_space_positions = screen_space->positions;
+
+      /* Only test the curves with segments close to the eraser. */
+      IndexMaskMemory memory;
+      const IndexMask brush_curves = this->brush_curves(*screen_space, memory);
+      if (brush_curves.is_empty()) {
+        return;
+      }
 
       /* Erasing operator. */
       bke::CurvesGeometry dst;
       bool erased = false;
       switch (self.eraser_mode_) {
         case GP_BRUSH_ERASER_STROKE:
-          erased = stroke_eraser(src, screen_space_positions, dst);
+          erased = stroke_eraser(src, screen_space_positions, brush_curves, dst);
           break;
         case GP_BRUSH_ERASER_HARD:
-          erased = hard_eraser(src, screen_space_positions, dst, self.keep_caps_);
+          erased = hard_eraser(
+              src, screen_space_positions, brush_curves, dst, self.keep_caps_);
           break;
         case GP_BRUSH_ERASER_SOFT:
           /* To be implemented. */
@@ -566,6 +670,8 @@ struct EraseOperationExecutor {
         drawing.ensure_unique_seeds();
         drawing.tag_topology_changed();
         changed = true;
+        /* Built again on the next sample. */
+        screen_space.reset();
       }
     };
 
@@ -581,6 +687,7 @@ struct EraseOperationExecutor {
         return;
       }
 
+      self.screen_space_.add(drawing, nullptr);
       execute_eraser_on_drawing(
           *grease_pencil.get_layer_index(active_layer), scene->r.cfra, *drawing);
     }
@@ -588,6 +695,9 @@ struct EraseOperationExecutor {
       /* Erase on all editable drawings. */
       const Vector<ed::greasepencil::MutableDrawingInfo> drawings =
           ed::greasepencil::retrieve_editable_drawings(*scene, grease_pencil);
+      for (const ed::greasepencil::MutableDrawingInfo &info : drawings) {
+        self.screen_space_.add(&info.drawing, nullptr);
+      }
       threading::parallel_for_each(
           drawings, [&](const ed::greasepencil::MutableDrawingInfo &info) {
             execute_eraser_on_drawing(info.layer_index, info.frame_number, info.drawing);
@@ -40,6 +40,7 @@
 
 #include "GPU_state.hh"
 
+#include <atomic>
 #include <list>
 #include <optional>
 
@@ -256,6 +257,73 @@ enum FillBorderMode {
   Ignore,
 };
 
+enum LeakFilterFlag {
+  /* Stroke pixels above or below, don't spread horizontally. */
+  BoundaryHorizontal = (1 << 0),
+  /* Stroke pixels left or right, don't spread vertically. */
+  BoundaryVertical = (1 << 1),
+};
+
+/* Directional box filtering for gap detection. Computed for all pixels in advance, so that the
+ * flood fill only does constant work per pixel. */
+static Array<uint8_t> compute_leak_filter(const ImageBufferAccessor &buffer,
+                                          const int leak_filter_width)
+{
+  const Span<ColorGeometry4b> pixels = buffer.pixels();
+  const int width = buffer.width();
+  const int height = buffer.height();
+
+  Array<uint8_t> leak_filter(pixels.size(), 0);
+  if (leak_filter_width <= 0) {
+    return leak_filter;
+  }
+  threading::parallel_for(IndexRange(height), 16, [&](const IndexRange range) {
+    for (const int y : range) {
+      for (const int x : IndexRange(width)) {
+        const int2 coord = {x, y};
+        const IndexRange filter_x_neg = IndexRange(1, std::min(coord.x, leak_filter_width));
+        const IndexRange filter_x_pos = IndexRange(
+            1, std::min(width - 1 - coord.x, leak_filter_width));
+        const IndexRange filter_y_neg = IndexRange(1, std::min(coord.y, leak_filter_width));
+        const IndexRange filter_y_pos = IndexRange(
+            1, std::min(height - 1 - coord.y, leak_filter_width));
+        bool is_boundary_horizontal = false;
+        bool is_boundary_vertical = false;
+        for (const int filter_i : filter_y_neg) {
+          is_boundary_horizontal |= get_flag(buffer.pixel_from_coord(coord - int2(0, filter_i)),
+                                             ColorFlag::Stroke);
+        }
+        for (const int filter_i : filter_y_pos) {
+          is_boundary_horizontal |= get_flag(buffer.pixel_from_coord(coord + int2(0, filter_i)),
+                                             ColorFlag::Stroke);
+        }
+        for (const int filter_i : filter_x_neg) {
+          is_boundary_vertical |= get_flag(buffer.pixel_from_coord(coord - int2(filter_i, 0)),
+                                           ColorFlag::Stroke);
+        }
+        for (const int filter_i : filter_x_pos) {
+          is_boundary_vertical |= get_flag(buffer.pixel_from_coord(coord + int2(filter_i, 0)),
+                                           ColorFlag::Stroke);
+        }
+        leak_filter[buffer.index_from_coord(coord)] =
+            (is_boundary_horizontal ? LeakFilterFlag::BoundaryHorizontal : 0) |
+            (is_boundary_vertical ? LeakFilterFlag::BoundaryVertical : 0);
+      }
+    }
+  });
+  return leak_filter;
+}
+
+/* Size of the square tiles that are filled in parallel. */
+constexpr const int fill_tile_size = 64;
+
+/**
+ * Fill the pixels reachable from the seed pixels.
+ *
+ * The image is split into tiles that are filled in parallel, each tile only writes its own
+ * pixels. Pixels reached across a tile edge are handed over to the neighbor tile, which fills
+ * them in the next round. Rounds continue until no tile has pixels left.
+ */
 template<FillBorderMode border_mode>
 FillResult flood_fill(ImageBufferAccessor &buffer, const int leak_filter_width = 0)
 {
@@ -263,89 +331,137 @@ FillResult flood_fill(ImageBufferAccessor &buffer, const int leak_filter_width =
   const int width = buffer.width();
   const int height = buffer.height();
 
-  blender::Stack<int> active_pixels;
-  /* Initialize the stack with filled pixels (dot at mouse position). */
-  for (const int i : pixels.index_range()) {
-    if (get_flag(pixels[i], ColorFlag::Seed)) {
-      active_pixels.push(i);
-    }
-  }
+  const Array<uint8_t> leak_filter = compute_leak_filter(buffer, leak_filter_width);
 
-  enum FilterDirection {
-    Horizontal = 1,
-    Vertical = 2,
+  const int2 tiles_size = (buffer.size() + fill_tile_size - 1) / fill_tile_size;
+  const int tiles_num = tiles_size.x * tiles_size.y;
+  auto tile_from_coord = [&](const int2 &coord) {
+    return coord.x / fill_tile_size + (coord.y / fill_tile_size) * tiles_size.x;
+  };
+  auto tile_bounds = [&](const int tile_i) {
+    const int2 min = int2(tile_i % tiles_size.x, tile_i / tiles_size.x) * fill_tile_size;
+    return std::pair<int2, int2>(min, math::min(min + fill_tile_size, buffer.size()));
   };
 
-  bool border_contact = false;
-  while (!active_pixels.is_empty()) {
-    const int index = active_pixels.pop();
-    const int2 coord = buffer.coord_from_index(index);
-    ColorGeometry4b pixel_value = buffer.pixels()[index];
-
-    if constexpr (border_mode == FillBorderMode::Cancel) {
-      if (get_flag(pixel_value, ColorFlag::Border)) {
-        border_contact = true;
-        break;
+  /* Pixels to fill for each tile. Initialized with filled pixels (dot at mouse position). */
+  Array<Vector<int>> tile_pixels(tiles_num);
+  threading::parallel_for(IndexRange(tiles_num), 1, [&](const IndexRange range) {
+    for (const int tile_i : range) {
+      const auto [min, max] = tile_bounds(tile_i);
+      for (const int y : IndexRange(min.y, max.y - min.y)) {
+        for (const int x : IndexRange(min.x, max.x - min.x)) {
+          const int index = buffer.index_from_coord({x, y});
+          if (get_flag(pixels[index], ColorFlag::Seed)) {
+            tile_pixels[tile_i].append(index);
+          }
+        }
       }
     }
-    else if constexpr (border_mode == FillBorderMode::Ignore) {
-      if (get_flag(pixel_value, ColorFlag::Border)) {
-        border_contact = true;
-      }
+  });
+  Vector<int> active_tiles;
+  for (const int tile_i : IndexRange(tiles_num)) {
+    if (!tile_pixels[tile_i].is_empty()) {
+      active_tiles.append(tile_i);
     }
+  }
 
-    if (get_flag(pixel_value, ColorFlag::Fill)) {
-      /* Pixel already filled. */
-      continue;
-    }
+  std::atomic<bool> border_contact = false;
+  while (!active_tiles.is_empty()) {
+    /* Pixels reached across the edges of each active tile. */
+    Array<Vector<int>> handover_pixels(active_tiles.size());
+    threading::parallel_for(active_tiles.index_range(), 1, [&](const IndexRange range) {
+      for (const int active_i : range) {
+        const int tile_i = active_tiles[active_i];
+        const auto [tile_min, tile_max] = tile_bounds(tile_i);
+        auto push_pixel = [&](const int2 &coord) {
+          const int index = buffer.index_from_coord(coord);
+          if (coord.x < tile_min.x || coord.y < tile_min.y || coord.x >= tile_max.x ||
+              coord.y >= tile_max.y)
+          {
+            handover_pixels[active_i].append(index);
+          }
+          else {
+            tile_pixels[tile_i].append(index);
+          }
+        };
+
+        Vector<int> &active_pixels = tile_pixels[tile_i];
+        while (!active_pixels.is_empty()) {
+          if constexpr (border_mode == FillBorderMode::Cancel) {
+            if (border_contact.load(std::memory_order_relaxed)) {
+              active_pixels.clear();
+              break;
+            }
+          }
 
-    if (get_flag(pixel_value, ColorFlag::Stroke)) {
-      /* Boundary pixel, ignore. */
-      continue;
-    }
+          const int index = active_pixels.pop_last();
+          const int2 coord = buffer.coord_from_index(index);
+          ColorGeometry4b pixel_value = pixels[index];
 
-    /* Mark as filled. */
-    set_flag(pixels[index], ColorFlag::Fill, true);
-
-    /* Directional box filtering for gap detection. */
-    const IndexRange filter_x_neg = IndexRange(1, std::min(coord.x, leak_filter_width));
-    const IndexRange filter_x_pos = IndexRange(1,
-                                               std::min(width - 1 - coord.x, leak_filter_width));
-    const IndexRange filter_y_neg = IndexRange(1, std::min(coord.y, leak_filter_width));
-    const IndexRange filter_y_pos = IndexRange(1,
-                                               std::min(height - 1 - coord.y, leak_filter_width));
-    bool is_boundary_horizontal = false;
-    bool is_boundary_vertical = false;
-    for (const int filter_i : filter_y_neg) {
-      is_boundary_horizontal |= get_flag(buffer.pixel_from_coord(coord - int2(0, filter_i)),
-                                         ColorFlag::Stroke);
-    }
-    for (const int filter_i : filter_y_pos) {
-      is_boundary_horizontal |= get_flag(buffer.pixel_from_coord(coord + int2(0, filter_i)),
-                                         ColorFlag::Stroke);
-    }
-    for (const int filter_i : filter_x_neg) {
-      is_boundary_vertical |= get_flag(buffer.pixel_from_coord(coord - int2(filter_i, 0)),
-                                       ColorFlag::Stroke);
-    }
-    for (const int filter_i : filter_x_pos) {
-      is_boundary_vertical |= get_flag(buffer.pixel_from_coord(coord + int2(filter_i, 0)),
-                                       ColorFlag::Stroke);
-    }
+          if (get_flag(pixel_value, ColorFlag::Border)) {
+            border_contact.store(true, std::memory_order_relaxed);
+            if constexpr (border_mode == FillBorderMode::Cancel) {
+              active_pixels.clear();
+              break;
+            }
+          }
 
-    /* Activate neighbors */
-    if (coord.x > 0 && !is_boundary_horizontal) {
-      active_pixels.push(buffer.index_from_coord(coord - int2{1, 0}));
-    }
-    if (coord.x < width - 1 && !is_boundary_horizontal) {
-      active_pixels.push(buffer.index_from_coord(coord + int2{1, 0}));
-    }
-    if (coord.y > 0 && !is_boundary_vertical) {
-      active_pixels.push(buffer.index_from_coord(coord - int2{0, 1}));
+          if (get_flag(pixel_value, ColorFlag::Fill)) {
+            /* Pixel already filled. */
+            continue;
+          }
+
+          if (get_flag(pixel_value, ColorFlag::Stroke)) {
+            /* Boundary pixel, ignore. */
+            continue;
+          }
+
+          /* Mark as filled. */
+          set_flag(pixels[index], ColorFlag::Fill, true);
+
+          const bool is_boundary_horizontal = leak_filter[index] &
+                                              LeakFilterFlag::BoundaryHorizontal;
+          const bool is_boundary_vertical = leak_filter[index] & LeakFilterFlag::BoundaryVertical;
+
+          /* Activate neighbors */
+          if (coord.x > 0 && !is_boundary_horizontal) {
+            push_pixel(coord - int2{1, 0});
+          }
+          if (coord.x < width - 1 && !is_boundary_horizontal) {
+            push_pixel(coord + int2{1, 0});
+          }
+          if (coord.y > 0 && !is_boundary_vertical) {
+            push_pixel(coord - int2{0, 1});
+          }
+          if (coord.y < height - 1 && !is_boundary_vertical) {
+            push_pixel(coord + int2{0, 1});
+          }
+        }
+      }
+    });
+
+    if constexpr (border_mode == FillBorderMode::Cancel) {
+      if (border_contact) {
+        break;
+      }
     }
-    if (coord.y < height - 1 && !is_boundary_vertical) {
-      active_pixels.push(buffer.index_from_coord(coord + int2{0, 1}));
+
+    /* Hand over pixels to their tiles for the next round. */
+    Vector<int> next_active_tiles;
+    for (const Span<int> indices : handover_pixels) {
+      for (const int index : indices) {
+        if (get_flag(pixels[index], ColorFlag::Fill)) {
+          /* Border contact has been detected when the pixel was filled. */
+          continue;
+        }
+        const int tile_i = tile_from_coord(buffer.coord_from_index(index));
+        if (tile_pixels[tile_i].is_empty()) {
+          next_active_tiles.append(tile_i);
+        }
+        tile_pixels[tile_i].append(index);
+      }
     }
+    active_tiles = std::move(next_active_tiles);
   }
 
   return border_contact ? FillResult::BorderContact : FillResult::Success;
@@ -463,25 +579,34 @@ static FillBoundary build_fill_boundary(const ImageBufferAccessor &buffer, bool
    * Direction 3 == (1, 0) is the starting direction. */
   constexpr const uint8_t start_direction = 3;
   auto find_start_coordinates = [&]() -> BoundaryStartMap {
-    BoundaryStartMap starts;
-    for (const int y : IndexRange(height)) {
-      /* Check for empty pixels next to filled pixels. */
-      for (const int x : IndexRange(width).drop_back(1)) {
-        const int index_left = buffer.index_from_coord({x, y});
-        const int index_right = buffer.index_from_coord({x + 1, y});
-        const bool filled_left = get_flag(pixels[index_left], ColorFlag::Fill);
-        const bool filled_right = get_flag(pixels[index_right], ColorFlag::Fill);
-        const bool border_right = get_flag(pixels[index_right], ColorFlag::Border);
-        if (!filled_left && filled_right && !border_right) {
-          /* Empty index list indicates uninitialized section. */
-          starts.add(index_right, {});
-          /* First filled pixel on the line is in the outer boundary.
-           * Pixels further to the right are part of holes and can be disregarded. */
-          if (!include_holes) {
-            break;
+    /* Rows are searched in parallel, then added in order to keep the result deterministic. */
+    Array<Vector<int>> starts_by_row(height);
+    threading::parallel_for(IndexRange(height), 64, [&](const IndexRange range) {
+      for (const int y : range) {
+        /* Check for empty pixels next to filled pixels. */
+        for (const int x : IndexRange(width).drop_back(1)) {
+          const int index_left = buffer.index_from_coord({x, y});
+          const int index_right = buffer.index_from_coord({x + 1, y});
+          const bool filled_left = get_flag(pixels[index_left], ColorFlag::Fill);
+          const bool filled_right = get_flag(pixels[index_right], ColorFlag::Fill);
+          const bool border_right = get_flag(pixels[index_right], ColorFlag::Border);
+          if (!filled_left && filled_right && !border_right) {
+            starts_by_row[y].append(index_right);
+            /* First filled pixel on the line is in the outer boundary.
+             * Pixels further to the right are part of holes and can be disregarded. */
+            if (!include_holes) {
+              break;
+            }
           }
         }
       }
+    });
+    BoundaryStartMap starts;
+    for (const Span<int> row_starts : starts_by_row) {
+      for (const int index : row_starts) {
+        /* Empty index list indicates uninitialized section. */
+        starts.add(index, {});
+      }
     }
     return starts;
   };
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "BLI_bounds_types.hh"
+
 #include "DNA_scene_types.h"
 #include "ED_grease_pencil.hh"
 
@@ -97,6 +99,64 @@ bke::crazyspace::GeometryDeformation get_drawing_deformation(
 Array<float2> calculate_view_positions(const GreasePencilStrokeParams &params,
                                        const IndexMask &selection);
 
+/**
+ * Uniform grid over the screen space bounds of items (points or segments), to find the items
+ * under the brush in time proportional to the brush size rather than the number of items.
+ */
+class ScreenSpaceGrid {
+ private:
+  float cell_size_ = 1.0f;
+  int2 cells_min_ = int2(0);
+  int2 cells_num_ = int2(0);
+  /* Items overlapping each cell. */
+  Array<Vector<int>> cells_;
+  Array<Bounds<float2>> item_bounds_;
+
+ public:
+  ScreenSpaceGrid() = default;
+  ScreenSpaceGrid(Span<Bounds<float2>> item_bounds);
+
+  /* Items of which the bounds intersect the circle. */
+  IndexMask items_in_circle(const float2 &center, float radius, IndexMaskMemory &memory) const;
+  /* Move items to new bounds, indexed like \a items. */
+  void update_items(const IndexMask &items, Span<Bounds<float2>> item_bounds);
+
+ private:
+  Bounds<int2> cells_in_bounds(const Bounds<float2> &bounds) const;
+};
+
+/**
+ * Screen space positions of the points of a drawing with a grid over them. Built when a brush
+ * stroke first affects a drawing and kept for the rest of the brush stroke, so the points are
+ * only projected again when the brush moves them.
+ */
+class ScreenSpacePoints {
+ private:
+  Array<float2> positions_;
+  /**
+   * Offsets from the original to the deformed positions at the start of the brush stroke. The
+   * deformed positions are only evaluated again after the brush changed the original positions.
+   */
+  Array<float3> deform_offsets_;
+  ScreenSpaceGrid grid_;
+
+ public:
+  ScreenSpacePoints(const GreasePencilStrokeParams &params);
+
+  Span<float2> positions() const
+  {
+    return positions_;
+  }
+
+  /* Points of \a selection within \a radius of \a center. */
+  IndexMask points_in_circle(const IndexMask &selection,
+                             const float2 &center,
+                             float radius,
+                             IndexMaskMemory &memory) const;
+  /* Project points again after their original positions were changed by the brush. */
+  void update_points(const GreasePencilStrokeParams &params, const IndexMask &points);
+};
+
 /* Stroke operation base class that performs various common initializations. */
 class GreasePencilStrokeOperationCommon : public GreasePencilStrokeOperation {
  public:
@@ -122,6 +182,26 @@ class GreasePencilStrokeOperationCommon : public GreasePencilStrokeOperation {
 
   void foreach_editable_drawing(
       const bContext &C, FunctionRef<bool(const GreasePencilStrokeParams &params)> fn) const;
+
+  /**
+   * Screen space positions of the drawing points for this brush stroke. Only valid for drawings
+   * passed to #foreach_editable_drawing.
+   */
+  ScreenSpacePoints &view_points(const GreasePencilStrokeParams &params) const;
+
+  /* Points of \a selection that can be influenced by the brush. */
+  IndexMask brush_points(const Scene &scene,
+                         const Brush &brush,
+                         const InputSample &sample,
+                         const GreasePencilStrokeParams &params,
+                         const IndexMask &selection,
+                         IndexMaskMemory &memory) const;
+
+ private:
+  /* Built by #foreach_editable_drawing for the drawings of the brush stroke. Entries are added
+   * before the drawings are processed in parallel, each task only builds its own entry. */
+  mutable Map<const bke::greasepencil::Drawing *, std::unique_ptr<ScreenSpacePoints>>
+      view_points_;
 };
 
 std::unique_ptr<GreasePencilStrokeOperation> new_paint_operation();
@@ -10,6 +10,7 @@
 #include "BKE_grease_pencil.hh"
 #include "BKE_paint.hh"
 
+#include "BLI_bounds.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_task.hh"
@@ -218,6 +219,192 @@ Array<float2> calculate_view_positions(const GreasePencilStrokeParams &params,
   return view_positions;
 }
 
+/* Cells are made larger when the items are spread over a large area, to bound the memory. */
+constexpr const float grid_cell_size_min = 32.0f;
+constexpr const int grid_cells_num_max = 128;
+
+ScreenSpaceGrid::ScreenSpaceGrid(const Span<Bounds<float2>> item_bounds)
+    : item_bounds_(item_bounds)
+{
+  if (item_bounds.is_empty()) {
+    return;
+  }
+  const Bounds<float2> bounds = threading::parallel_reduce(
+      item_bounds.index_range(),
+      4096,
+      item_bounds.first(),
+      [&](const IndexRange range, Bounds<float2> init) {
+        for (const int item : range) {
+          init = bounds::merge(init, item_bounds[item]);
+        }
+        return init;
+      },
+      [](const Bounds<float2> &a, const Bounds<float2> &b) { return bounds::merge(a, b); });
+  const float2 size = bounds.max - bounds.min;
+  cell_size_ = std::max({grid_cell_size_min,
+                         size.x / grid_cells_num_max,
+                         size.y / grid_cells_num_max});
+  cells_min_ = int2(math::floor(bounds.min / cell_size_));
+  cells_num_ = int2(math::floor(bounds.max / cell_size_)) - cells_min_ + 1;
+  cells_.reinitialize(cells_num_.x * cells_num_.y);
+
+  for (const int item : item_bounds.index_range()) {
+    const Bounds<int2> cells = this->cells_in_bounds(item_bounds[item]);
+    for (int y = cells.min.y; y <= cells.max.y; y++) {
+      for (int x = cells.min.x; x <= cells.max.x; x++) {
+        cells_[x + y * cells_num_.x].append(item);
+      }
+    }
+  }
+}
+
+Bounds<int2> ScreenSpaceGrid::cells_in_bounds(const Bounds<float2> &bounds) const
+{
+  /* Items outside of the initial bounds are stored in the outermost cells. */
+  const int2 min = math::clamp(
+      int2(math::floor(bounds.min / cell_size_)) - cells_min_, int2(0), cells_num_ - 1);
+  const int2 max = math::clamp(
+      int2(math::floor(bounds.max / cell_size_)) - cells_min_, int2(0), cells_num_ - 1);
+  return {min, max};
+}
+
+IndexMask ScreenSpaceGrid::items_in_circle(const float2 &center,
+                                           const float radius,
+                                           IndexMaskMemory &memory) const
+{
+  if (cells_.is_empty()) {
+    return {};
+  }
+  const Bounds<int2> cells = this->cells_in_bounds({center - radius, center + radius});
+  Vector<int> items;
+  for (int y = cells.min.y; y <= cells.max.y; y++) {
+    for (int x = cells.min.x; x <= cells.max.x; x++) {
+      for (const int item : cells_[x + y * cells_num_.x]) {
+        const Bounds<float2> &bounds = item_bounds_[item];
+        const float2 closest = math::clamp(center, bounds.min, bounds.max);
+        if (math::distance_squared(closest, center) <= radius * radius) {
+          items.append(item);
+        }
+      }
+    }
+  }
+  /* Items overlapping multiple cells are found more than once. */
+  std::sort(items.begin(), items.end());
+  items.resize(std::unique(items.begin(), items.end()) - items.begin());
+  return IndexMask::from_indices(items.as_span(), memory);
+}
+
+void ScreenSpaceGrid::update_items(const IndexMask &items, const Span<Bounds<float2>> item_bounds)
+{
+  if (cells_.is_empty()) {
+    return;
+  }
+  items.foreach_index([&](const int item, const int pos) {
+    const Bounds<int2> old_cells = this->cells_in_bounds(item_bounds_[item]);
+    const Bounds<int2> new_cells = this->cells_in_bounds(item_bounds[pos]);
+    item_bounds_[item] = item_bounds[pos];
+    if (old_cells.min == new_cells.min && old_cells.max == new_cells.max) {
+      return;
+    }
+    for (int y = old_cells.min.y; y <= old_cells.max.y; y++) {
+      for (int x = old_cells.min.x; x <= old_cells.max.x; x++) {
+        cells_[x + y * cells_num_.x].remove_first_occurrence_and_reorder(item);
+      }
+    }
+    for (int y = new_cells.min.y; y <= new_cells.max.y; y++) {
+      for (int x = new_cells.min.x; x <= new_cells.max.x; x++) {
+        cells_[x + y * cells_num_.x].append(item);
+      }
+    }
+  });
+}
+
+static Array<Bounds<float2>> point_bounds(const Span<float2> positions)
+{
+  Array<Bounds<float2>> bounds(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int point : range) {
+      bounds[point] = {positions[point], positions[point]};
+    }
+  });
+  return bounds;
+}
+
+static Array<float3> deform_offsets_get(const GreasePencilStrokeParams &params)
+{
+  const bke::crazyspace::GeometryDeformation deformation = get_drawing_deformation(params);
+  const Span<float3> positions = params.drawing.strokes().positions();
+  Array<float3> offsets(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int point : range) {
+      offsets[point] = deformation.positions[point] - positions[point];
+    }
+  });
+  return offsets;
+}
+
+ScreenSpacePoints::ScreenSpacePoints(const GreasePencilStrokeParams &params)
+    : positions_(calculate_view_positions(params, params.drawing.strokes().points_range())),
+      deform_offsets_(deform_offsets_get(params)),
+      grid_(point_bounds(positions_))
+{
+}
+
+IndexMask ScreenSpacePoints::points_in_circle(const IndexMask &selection,
+                                              const float2 &center,
+                                              const float radius,
+                                              IndexMaskMemory &memory) const
+{
+  const IndexMask points = grid_.items_in_circle(center, radius, memory);
+  return IndexMask::from_intersection(points, selection, memory);
+}
+
+void ScreenSpacePoints::update_points(const GreasePencilStrokeParams &params,
+                                      const IndexMask &points)
+{
+  /* The evaluated positions are outdated until the depsgraph is evaluated again, so use the new
+   * original positions with the deformation from the start of the stroke. */
+  const Span<float3> positions = params.drawing.strokes().positions();
+  const float4x4 transform = params.layer.to_world_space(params.ob_eval);
+  Array<Bounds<float2>> bounds(points.size());
+  points.foreach_index(GrainSize(4096), [&](const int point, const int pos) {
+    float2 &view_position = positions_[point];
+    const float3 position = positions[point] + deform_offsets_[point];
+    if (ED_view3d_project_float_global(&params.region,
+                                       math::transform_point(transform, position),
+                                       view_position,
+                                       V3D_PROJ_TEST_NOP) != V3D_PROJ_RET_OK)
+    {
+      view_position = float2(0);
+    }
+    bounds[pos] = {view_position, view_position};
+  });
+  grid_.update_items(points, bounds);
+}
+
+ScreenSpacePoints &GreasePencilStrokeOperationCommon::view_points(
+    const GreasePencilStrokeParams &params) const
+{
+  std::unique_ptr<ScreenSpacePoints> &view_points = view_points_.lookup(&params.drawing);
+  if (!view_points || view_points->positions().size() != params.drawing.strokes().points_num()) {
+    view_points = std::make_unique<ScreenSpacePoints>(params);
+  }
+  return *view_points;
+}
+
+IndexMask GreasePencilStrokeOperationCommon::brush_points(const Scene &scene,
+                                                          const Brush &brush,
+                                                          const InputSample &sample,
+                                                          const GreasePencilStrokeParams &params,
+                                                          const IndexMask &selection,
+                                                          IndexMaskMemory &memory) const
+{
+  /* Add a pixel for the rounding of the distance in #brush_influence. */
+  const float radius = brush_radius(scene, brush, sample.pressure) + 1.0f;
+  return this->view_points(params).points_in_circle(
+      selection, sample.mouse_position, radius, memory);
+}
+
 bool GreasePencilStrokeOperationCommon::is_inverted(const Brush &brush) const
 {
   return is_brush_inverted(brush, this->stroke_mode);
@@ -243,6 +430,9 @@ void GreasePencilStrokeOperationCommon::foreach_editable_drawing(
 
   std::atomic<bool> changed = false;
   const Vector<MutableDrawingInfo> drawings = get_drawings_for_sculpt(C);
+  for (const MutableDrawingInfo &info : drawings) {
+    view_points_.add(&info.drawing, nullptr);
+  }
   threading::parallel_for_each(drawings, [&](const MutableDrawingInfo &info) {
     const Layer &layer = *grease_pencil.layer(info.layer_index);
 
@@ -67,7 +67,14 @@ void RandomizeOperation::on_stroke_extended(const bContext &C, const InputSample
       return false;
     }
 
-    Array<float2> view_positions = calculate_view_positions(params, selection);
+    const IndexMask brush_points = this->brush_points(
+        scene, brush, extension_sample, params, selection, selection_memory);
+    if (brush_points.is_empty()) {
+      return false;
+    }
+
+    ScreenSpacePoints &view_points = this->view_points(params);
+    const Span<float2> view_positions = view_points.positions();
     bke::CurvesGeometry &curves = params.drawing.strokes_for_write();
     bke::MutableAttributeAccessor attributes = curves.attributes_for_write();
 
@@ -79,7 +86,7 @@ void RandomizeOperation::on_stroke_extended(const bContext &C, const InputSample
       const float2 forward = math::normalize(this->mouse_delta(extension_sample));
       const float2 sideways = float2(-forward.y, forward.x);
 
-      selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+      brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
         const float2 &co = view_positions[point_i];
         const float influence = brush_influence(
             scene, brush, co, extension_sample, params.multi_frame_falloff);
@@ -95,7 +102,7 @@ void RandomizeOperation::on_stroke_extended(const bContext &C, const InputSample
     }
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_STRENGTH) {
       MutableSpan<float> opacities = params.drawing.opacities_for_write();
-      selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+      brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
         const float2 &co = view_positions[point_i];
         const float influence = brush_influence(
             scene, brush, co, extension_sample, params.multi_frame_falloff);
@@ -109,7 +116,7 @@ void RandomizeOperation::on_stroke_extended(const bContext &C, const InputSample
     }
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_THICKNESS) {
       const MutableSpan<float> radii = params.drawing.radii_for_write();
-      selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+      brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
         const float2 &co = view_positions[point_i];
         const float influence = brush_influence(
             scene, brush, co, extension_sample, params.multi_frame_falloff);
@@ -125,7 +132,7 @@ void RandomizeOperation::on_stroke_extended(const bContext &C, const InputSample
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_UV) {
       bke::SpanAttributeWriter<float> rotations = attributes.lookup_or_add_for_write_span<float>(
           "rotation", bke::AttrDomain::Point);
-      selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+      brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
         const float2 &co = view_positions[point_i];
         const float influence = brush_influence(
             scene, brush, co, extension_sample, params.multi_frame_falloff);
@@ -139,6 +146,9 @@ void RandomizeOperation::on_stroke_extended(const bContext &C, const InputSample
       rotations.finish();
       changed = true;
     }
+    if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_POSITION) {
+      view_points.update_points(params, brush_points);
+    }
     return changed;
   });
   this->stroke_extended(extension_sample);
@@ -53,10 +53,22 @@ void SmoothOperation::on_stroke_extended(const bContext &C, const InputSample &e
       return false;
     }
 
-    Array<float2> view_positions = calculate_view_positions(params, selection);
+    const IndexMask brush_points = this->brush_points(
+        scene, brush, extension_sample, params, selection, selection_memory);
+    if (brush_points.is_empty()) {
+      return false;
+    }
+
+    ScreenSpacePoints &view_points = this->view_points(params);
+    const Span<float2> view_positions = view_points.positions();
     bke::CurvesGeometry &curves = params.drawing.strokes_for_write();
     bke::MutableAttributeAccessor attributes = curves.attributes_for_write();
     const OffsetIndices points_by_curve = curves.points_by_curve();
+    /* Only curves with points under the brush are affected. */
+    const IndexMask brush_curves = IndexMask::from_predicate(
+        curves.curves_range(), GrainSize(512), selection_memory, [&](const int curve) {
+          return !brush_points.slice_content(points_by_curve[curve]).is_empty();
+        });
     const VArray<bool> cyclic = curves.cyclic();
     const int iterations = 2;
 
@@ -72,7 +84,7 @@ void SmoothOperation::on_stroke_extended(const bContext &C, const InputSample &e
     bool changed = false;
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_POSITION) {
       MutableSpan<float3> positions = curves.positions_for_write();
-      geometry::smooth_curve_attribute(curves.curves_range(),
+      geometry::smooth_curve_attribute(brush_curves,
                                        points_by_curve,
                                        selection_varray,
                                        cyclic,
@@ -86,7 +98,7 @@ void SmoothOperation::on_stroke_extended(const bContext &C, const InputSample &e
     }
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_STRENGTH) {
       MutableSpan<float> opacities = params.drawing.opacities_for_write();
-      geometry::smooth_curve_attribute(curves.curves_range(),
+      geometry::smooth_curve_attribute(brush_curves,
                                        points_by_curve,
                                        selection_varray,
                                        cyclic,
@@ -99,7 +111,7 @@ void SmoothOperation::on_stroke_extended(const bContext &C, const InputSample &e
     }
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_THICKNESS) {
       const MutableSpan<float> radii = params.drawing.radii_for_write();
-      geometry::smooth_curve_attribute(curves.curves_range(),
+      geometry::smooth_curve_attribute(brush_curves,
                                        points_by_curve,
                                        selection_varray,
                                        cyclic,
@@ -114,7 +126,7 @@ void SmoothOperation::on_stroke_extended(const bContext &C, const InputSample &e
     if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_UV) {
       bke::SpanAttributeWriter<float> rotations = attributes.lookup_or_add_for_write_span<float>(
           "rotation", bke::AttrDomain::Point);
-      geometry::smooth_curve_attribute(curves.curves_range(),
+      geometry::smooth_curve_attribute(brush_curves,
                                        points_by_curve,
                                        selection_varray,
                                        cyclic,
@@ -126,6 +138,9 @@ void SmoothOperation::on_stroke_extended(const bContext &C, const InputSample &e
       rotations.finish();
       changed = true;
     }
+    if (sculpt_mode_flag & GP_SCULPT_FLAGMODE_APPLY_POSITION) {
+      view_points.update_points(params, brush_points);
+    }
     return changed;
   });
   this->stroke_extended(extension_sample);
@@ -47,10 +47,16 @@ void StrengthOperation::on_stroke_extended(const bContext &C, const InputSample
       return false;
     }
 
-    Array<float2> view_positions = calculate_view_positions(params, selection);
+    const IndexMask brush_points = this->brush_points(
+        scene, brush, extension_sample, params, selection, selection_memory);
+    if (brush_points.is_empty()) {
+      return false;
+    }
+
+    const Span<float2> view_positions = this->view_points(params).positions();
     MutableSpan<float> opacities = params.drawing.opacities_for_write();
 
-    selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+    brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
       float &opacity = opacities[point_i];
       const float influence = brush_influence(
           scene, brush, view_positions[point_i], extension_sample, params.multi_frame_falloff);
@@ -48,12 +48,18 @@ void ThicknessOperation::on_stroke_extended(const bContext &C, const InputSample
       return false;
     }
 
-    Array<float2> view_positions = calculate_view_positions(params, selection);
+    const IndexMask brush_points = this->brush_points(
+        scene, brush, extension_sample, params, selection, selection_memory);
+    if (brush_points.is_empty()) {
+      return false;
+    }
+
+    const Span<float2> view_positions = this->view_points(params).positions();
     bke::CurvesGeometry &curves = params.drawing.strokes_for_write();
     BLI_assert(view_positions.size() == curves.points_num());
     MutableSpan<float> radii = params.drawing.radii_for_write();
 
-    selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+    brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
       float &radius = radii[point_i];
       const float influence = brush_influence(
           scene, brush, view_positions[point_i], extension_sample, params.multi_frame_falloff);
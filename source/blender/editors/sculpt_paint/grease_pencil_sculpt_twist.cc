@@ -55,13 +55,20 @@ void TwistOperation::on_stroke_extended(const bContext &C, const InputSample &ex
       return false;
     }
 
-    Array<float2> view_positions = calculate_view_positions(params, selection);
+    const IndexMask brush_points = this->brush_points(
+        scene, brush, extension_sample, params, selection, selection_memory);
+    if (brush_points.is_empty()) {
+      return false;
+    }
+
+    ScreenSpacePoints &view_points = this->view_points(params);
+    const Span<float2> view_positions = view_points.positions();
     bke::CurvesGeometry &curves = params.drawing.strokes_for_write();
     MutableSpan<float3> positions = curves.positions_for_write();
 
     const float2 mouse_pos = extension_sample.mouse_position;
 
-    selection.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
+    brush_points.foreach_index(GrainSize(4096), [&](const int64_t point_i) {
       const float2 &co = view_positions[point_i];
       const float influence = brush_influence(
           scene, brush, co, extension_sample, params.multi_frame_falloff);
@@ -75,6 +82,7 @@ void TwistOperation::on_stroke_extended(const bContext &C, const InputSample &ex
     });
 
     params.drawing.tag_positions_changed();
+    view_points.update_points(params, brush_points);
     return true;
   });
   this->stroke_extended(extension_sample);
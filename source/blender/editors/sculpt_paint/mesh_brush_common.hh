@@ -30,6 +30,7 @@
  * new value from scratch.
  */
 
+struct BMLog;
 struct BMVert;
 struct Brush;
 struct Mesh;
@@ -65,6 +66,22 @@ void gather_grids_positions(const SubdivCCG &subdiv_ccg,
 
 void gather_bmesh_positions(const Set<BMVert *, 0> &verts, MutableSpan<float3> positions);
 
+/**
+ * Positions and normals from before the current stroke, stored in the position undo step. For
+ * meshes the arrays contain the node's unique vertices, for grids all of the node's grid
+ * vertices, in the same order as the node's indices.
+ */
+struct OrigPositionData {
+  Span<float3> positions;
+  Span<float3> normals;
+};
+OrigPositionData orig_position_data_get_mesh(const Object &object, const PBVHNode &node);
+OrigPositionData orig_position_data_get_grids(const Object &object, const PBVHNode &node);
+void orig_position_data_gather_bmesh(BMLog &bm_log,
+                                     const Set<BMVert *, 0> &verts,
+                                     MutableSpan<float3> positions,
+                                     MutableSpan<float3> normals);
+
 /**
  * Calculate initial influence factors based on vertex visibility.
  */
@@ -101,6 +118,7 @@ void calc_front_face(const float3 &view_normal,
 void calc_front_face(const float3 &view_normal,
                      const Set<BMVert *, 0> &verts,
                      const MutableSpan<float> factors);
+void calc_front_face(const float3 &view_normal, Span<float3> normals, MutableSpan<float> factors);
 
 /**
  * When the 3D view's clipping planes are enabled, brushes shouldn't have any effect on vertices
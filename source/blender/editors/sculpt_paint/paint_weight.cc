@@ -13,6 +13,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_array_utils.h"
 #include "BLI_color.hh"
 #include "BLI_color_mix.hh"
@@ -122,6 +123,9 @@ struct WPaintData {
   /* original weight values for use in blur/smear */
   float *precomputed_weight;
   bool precomputed_weight_ready;
+
+  /* X-mirror vertex of every vertex when mirroring vertex groups, -1 when there is none. */
+  int *vert_mirror_indices;
 };
 
 /* struct to avoid passing many args each call to do_weight_paint_vertex()
@@ -132,6 +136,9 @@ struct WeightPaintInfo {
 
   MutableSpan<MDeformVert> dvert;
 
+  /* same as WPaintData.vert_mirror_indices, empty when not mirroring vertex groups */
+  Span<int> vert_mirror_indices;
+
   int defbase_tot;
 
   /* both must add up to 'defbase_tot' */
@@ -512,7 +519,6 @@ static void do_weight_paint_vertex_single(const VPaint &wp,
 {
   Mesh *mesh = (Mesh *)ob.data;
   MDeformVert *dv = &wpi.dvert[index];
-  bool topology = (mesh->editflag & ME_EDIT_MIRROR_TOPO) != 0;
 
   MDeformWeight *dw;
   float weight_prev, weight_cur;
@@ -526,7 +532,7 @@ static void do_weight_paint_vertex_single(const VPaint &wp,
 
   /* Check if we should mirror vertex groups (X-axis). */
   if (ME_USING_MIRROR_X_VERTEX_GROUPS(mesh)) {
-    index_mirr = mesh_get_x_mirror_vert(&ob, nullptr, index, topology);
+    index_mirr = wpi.vert_mirror_indices[index];
     vgroup_mirr = wpi.mirror.index;
 
     /* another possible error - mirror group _and_ active group are the same (which is fine),
@@ -717,7 +723,6 @@ static void do_weight_paint_vertex_multi(const VPaint &wp,
 {
   Mesh *mesh = (Mesh *)ob.data;
   MDeformVert *dv = &wpi.dvert[index];
-  bool topology = (mesh->editflag & ME_EDIT_MIRROR_TOPO) != 0;
 
   int index_mirr = -1;
   MDeformVert *dv_mirr = nullptr;
@@ -727,7 +732,7 @@ static void do_weight_paint_vertex_multi(const VPaint &wp,
 
   /* Check if we should mirror vertex groups (X-axis). */
   if (ME_USING_MIRROR_X_VERTEX_GROUPS(mesh)) {
-    index_mirr = mesh_get_x_mirror_vert(&ob, nullptr, index, topology);
+    index_mirr = wpi.vert_mirror_indices[index];
 
     if (!ELEM(index_mirr, -1, index)) {
       dv_mirr = &wpi.dvert[index_mirr];
@@ -992,6 +997,16 @@ static bool wpaint_stroke_test_start(bContext *C, wmOperator *op, const float mo
     wpd->precomputed_weight = (float *)MEM_mallocN(sizeof(float) * mesh.verts_num, __func__);
   }
 
+  /* Look up the mirror vertices once, so that painting the vertices doesn't have to. The lookup
+   * lazily builds the mirror tables, so it isn't done in parallel. */
+  if (ME_USING_MIRROR_X_VERTEX_GROUPS(&mesh)) {
+    const bool use_topology = (mesh.editflag & ME_EDIT_MIRROR_TOPO) != 0;
+    wpd->vert_mirror_indices = (int *)MEM_mallocN(sizeof(int) * mesh.verts_num, __func__);
+    for (int i = 0; i < mesh.verts_num; i++) {
+      wpd->vert_mirror_indices[i] = mesh_get_x_mirror_vert(&ob, nullptr, i, use_topology);
+    }
+  }
+
   if (ob.sculpt->mode.wpaint.dvert_prev != nullptr) {
     MDeformVert *dv = ob.sculpt->mode.wpaint.dvert_prev;
     for (int i = 0; i < mesh.verts_num; i++, dv++) {
@@ -1048,16 +1063,49 @@ static void precompute_weight_values(
 /** \name Weight paint brushes.
  * \{ */
 
-static void parallel_nodes_loop_with_mirror_check(const Mesh &mesh,
+/** Applies the weight painted by a brush to a vertex, see #do_weight_paint_vertex. */
+using PaintVertFn = FunctionRef<void(int vert, float alpha, float paintweight)>;
+
+struct VertPaintWrite {
+  int vert;
+  float alpha;
+  float paintweight;
+};
+
+/**
+ * Evaluate the brush for all nodes in parallel. Painting a vertex with X-mirrored vertex groups
+ * also writes to its mirror vertex, which may be in another node. In that case the writes are
+ * gathered per node and applied afterwards, in the same order as a single threaded loop would.
+ */
+static void parallel_nodes_loop_with_mirror_check(const VPaint &vp,
+                                                  Object &ob,
+                                                  const WeightPaintInfo &wpi,
+                                                  const Mesh &mesh,
                                                   const Span<PBVHNode *> nodes,
-                                                  FunctionRef<void(IndexRange)> fn)
+                                                  FunctionRef<void(IndexRange, PaintVertFn)> fn)
 {
-  /* NOTE: current mirroring code cannot be run in parallel */
-  if (ME_USING_MIRROR_X_VERTEX_GROUPS(&mesh)) {
-    fn(nodes.index_range());
+  if (!ME_USING_MIRROR_X_VERTEX_GROUPS(&mesh)) {
+    threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+      fn(range, [&](const int vert, const float alpha, const float paintweight) {
+        do_weight_paint_vertex(vp, ob, wpi, vert, alpha, paintweight);
+      });
+    });
+    return;
   }
-  else {
-    threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) { fn(range); });
+
+  Array<Vector<VertPaintWrite>> node_writes(nodes.size());
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Vector<VertPaintWrite> &writes = node_writes[i];
+      fn(IndexRange(i, 1), [&](const int vert, const float alpha, const float paintweight) {
+        writes.append({vert, alpha, paintweight});
+      });
+    }
+  });
+  for (const Span<VertPaintWrite> writes : node_writes) {
+    for (const VertPaintWrite &write : writes) {
+      do_weight_paint_vertex(vp, ob, wpi, write.vert, write.alpha, write.paintweight);
+    }
   }
 }
 
@@ -1100,61 +1148,63 @@ static void do_wpaint_brush_blur(const Scene &scene,
     select_vert = *attributes.lookup<bool>(".select_vert", bke::AttrDomain::Point);
   }
 
-  parallel_nodes_loop_with_mirror_check(mesh, nodes, [&](const IndexRange range) {
-    SculptBrushTest test = test_init;
-    for (const int i : range) {
-      for (const int vert : bke::pbvh::node_unique_verts(*nodes[i])) {
-        if (!hide_vert.is_empty() && hide_vert[vert]) {
-          continue;
-        }
-        if (!select_vert.is_empty() && !select_vert[vert]) {
-          continue;
-        }
-        if (!sculpt_brush_test_sq_fn(test, vert_positions[vert])) {
-          continue;
-        }
+  parallel_nodes_loop_with_mirror_check(
+      vp, ob, wpi, mesh, nodes, [&](const IndexRange range, const PaintVertFn paint_vert) {
+        SculptBrushTest test = test_init;
+        for (const int i : range) {
+          for (const int vert : bke::pbvh::node_unique_verts(*nodes[i])) {
+            if (!hide_vert.is_empty() && hide_vert[vert]) {
+              continue;
+            }
+            if (!select_vert.is_empty() && !select_vert[vert]) {
+              continue;
+            }
+            if (!sculpt_brush_test_sq_fn(test, vert_positions[vert])) {
+              continue;
+            }
 
-        /* Get the average face weight */
-        int total_hit_loops = 0;
-        float weight_final = 0.0f;
-        for (const int face : vert_to_face[vert]) {
-          total_hit_loops += faces[face].size();
-          for (const int vert : corner_verts.slice(faces[face])) {
-            weight_final += wpd.precomputed_weight[vert];
-          }
-        }
+            /* Get the average face weight */
+            int total_hit_loops = 0;
+            float weight_final = 0.0f;
+            for (const int face : vert_to_face[vert]) {
+              total_hit_loops += faces[face].size();
+              for (const int vert : corner_verts.slice(faces[face])) {
+                weight_final += wpd.precomputed_weight[vert];
+              }
+            }
 
-        if (total_hit_loops == 0) {
-          continue;
-        }
+            if (total_hit_loops == 0) {
+              continue;
+            }
 
-        float brush_strength = cache->bstrength;
-        const float angle_cos = use_normal ?
-                                    dot_v3v3(sculpt_normal_frontface, vert_normals[vert]) :
-                                    1.0f;
-        if (!vwpaint::test_brush_angle_falloff(
-                brush, wpd.normal_angle_precalc, angle_cos, &brush_strength))
-        {
-          continue;
-        }
+            float brush_strength = cache->bstrength;
+            const float angle_cos = use_normal ?
+                                        dot_v3v3(sculpt_normal_frontface, vert_normals[vert]) :
+                                        1.0f;
+            if (!vwpaint::test_brush_angle_falloff(
+                    brush, wpd.normal_angle_precalc, angle_cos, &brush_strength))
+            {
+              continue;
+            }
 
-        const float brush_fade = BKE_brush_curve_strength(&brush, sqrtf(test.dist), cache->radius);
-        const float final_alpha = brush_fade * brush_strength * brush_alpha_pressure;
+            const float brush_fade = BKE_brush_curve_strength(
+                &brush, sqrtf(test.dist), cache->radius);
+            const float final_alpha = brush_fade * brush_strength * brush_alpha_pressure;
+
+            if ((brush.flag & BRUSH_ACCUMULATE) == 0) {
+              if (ss.mode.wpaint.alpha_weight[vert] < final_alpha) {
+                ss.mode.wpaint.alpha_weight[vert] = final_alpha;
+              }
+              else {
+                continue;
+              }
+            }
 
-        if ((brush.flag & BRUSH_ACCUMULATE) == 0) {
-          if (ss.mode.wpaint.alpha_weight[vert] < final_alpha) {
-            ss.mode.wpaint.alpha_weight[vert] = final_alpha;
-          }
-          else {
-            continue;
+            weight_final /= total_hit_loops;
+            paint_vert(vert, final_alpha, weight_final);
           }
         }
-
-        weight_final /= total_hit_loops;
-        do_weight_paint_vertex(vp, ob, wpi, vert, final_alpha, weight_final);
-      }
-    }
-  });
+      });
 }
 
 static void do_wpaint_brush_smear(const Scene &scene,
@@ -1205,75 +1255,76 @@ static void do_wpaint_brush_smear(const Scene &scene,
   const float *sculpt_normal_frontface = SCULPT_brush_frontface_normal_from_falloff_shape(
       ss, brush.falloff_shape);
 
-  parallel_nodes_loop_with_mirror_check(mesh, nodes, [&](const IndexRange range) {
-    SculptBrushTest test = test_init;
-    for (const int i : range) {
-      for (const int vert : bke::pbvh::node_unique_verts(*nodes[i])) {
-        if (!hide_vert.is_empty() && hide_vert[vert]) {
-          continue;
-        }
-        if (!select_vert.is_empty() && !select_vert[vert]) {
-          continue;
-        }
-        if (!sculpt_brush_test_sq_fn(test, vert_positions[vert])) {
-          continue;
-        }
-
-        float brush_strength = cache->bstrength;
-        const float angle_cos = use_normal ?
-                                    dot_v3v3(sculpt_normal_frontface, vert_normals[vert]) :
-                                    1.0f;
-        if (!vwpaint::test_brush_angle_falloff(
-                brush, wpd.normal_angle_precalc, angle_cos, &brush_strength))
-        {
-          continue;
-        }
-
-        bool do_color = false;
-        /* Minimum dot product between brush direction and current
-         * to neighbor direction is 0.0, meaning orthogonal. */
-        float stroke_dot_max = 0.0f;
-
-        /* Get the color of the loop in the opposite direction of the brush movement
-         * (this callback is specifically for smear.) */
-        float weight_final = 0.0;
-        for (const int face : vert_to_face[vert]) {
-          for (const int vert_other : corner_verts.slice(faces[face])) {
-            if (vert_other == vert) {
+  parallel_nodes_loop_with_mirror_check(
+      vp, ob, wpi, mesh, nodes, [&](const IndexRange range, const PaintVertFn paint_vert) {
+        SculptBrushTest test = test_init;
+        for (const int i : range) {
+          for (const int vert : bke::pbvh::node_unique_verts(*nodes[i])) {
+            if (!hide_vert.is_empty() && hide_vert[vert]) {
+              continue;
+            }
+            if (!select_vert.is_empty() && !select_vert[vert]) {
+              continue;
+            }
+            if (!sculpt_brush_test_sq_fn(test, vert_positions[vert])) {
               continue;
             }
 
-            /* Get the direction from the selected vert to the neighbor. */
-            float other_dir[3];
-            sub_v3_v3v3(other_dir, vert_positions[vert], vert_positions[vert_other]);
-            project_plane_v3_v3v3(other_dir, other_dir, cache->view_normal);
-
-            normalize_v3(other_dir);
-
-            const float stroke_dot = dot_v3v3(other_dir, brush_dir);
-
-            if (stroke_dot > stroke_dot_max) {
-              stroke_dot_max = stroke_dot;
-              weight_final = wpd.precomputed_weight[vert_other];
-              do_color = true;
+            float brush_strength = cache->bstrength;
+            const float angle_cos = use_normal ?
+                                        dot_v3v3(sculpt_normal_frontface, vert_normals[vert]) :
+                                        1.0f;
+            if (!vwpaint::test_brush_angle_falloff(
+                    brush, wpd.normal_angle_precalc, angle_cos, &brush_strength))
+            {
+              continue;
             }
-          }
-          if (!do_color) {
-            continue;
-          }
-          const float brush_fade = BKE_brush_curve_strength(
-              &brush, sqrtf(test.dist), cache->radius);
-          const float final_alpha = brush_fade * brush_strength * brush_alpha_pressure;
 
-          if (final_alpha <= 0.0f) {
-            continue;
+            bool do_color = false;
+            /* Minimum dot product between brush direction and current
+             * to neighbor direction is 0.0, meaning orthogonal. */
+            float stroke_dot_max = 0.0f;
+
+            /* Get the color of the loop in the opposite direction of the brush movement
+             * (this callback is specifically for smear.) */
+            float weight_final = 0.0;
+            for (const int face : vert_to_face[vert]) {
+              for (const int vert_other : corner_verts.slice(faces[face])) {
+                if (vert_other == vert) {
+                  continue;
+                }
+
+                /* Get the direction from the selected vert to the neighbor. */
+                float other_dir[3];
+                sub_v3_v3v3(other_dir, vert_positions[vert], vert_positions[vert_other]);
+                project_plane_v3_v3v3(other_dir, other_dir, cache->view_normal);
+
+                normalize_v3(other_dir);
+
+                const float stroke_dot = dot_v3v3(other_dir, brush_dir);
+
+                if (stroke_dot > stroke_dot_max) {
+                  stroke_dot_max = stroke_dot;
+                  weight_final = wpd.precomputed_weight[vert_other];
+                  do_color = true;
+                }
+              }
+              if (!do_color) {
+                continue;
+              }
+              const float brush_fade = BKE_brush_curve_strength(
+                  &brush, sqrtf(test.dist), cache->radius);
+              const float final_alpha = brush_fade * brush_strength * brush_alpha_pressure;
+
+              if (final_alpha <= 0.0f) {
+                continue;
+              }
+
+              paint_vert(vert, final_alpha, float(weight_final));
+            }
           }
-
-          do_weight_paint_vertex(vp, ob, wpi, vert, final_alpha, float(weight_final));
         }
-      }
-    }
-  });
+      });
 }
 
 static void do_wpaint_brush_draw(const Scene &scene,
@@ -1315,44 +1366,46 @@ static void do_wpaint_brush_draw(const Scene &scene,
     select_vert = *attributes.lookup<bool>(".select_vert", bke::AttrDomain::Point);
   }
 
-  parallel_nodes_loop_with_mirror_check(mesh, nodes, [&](const IndexRange range) {
-    SculptBrushTest test = test_init;
-    for (const int i : range) {
-      for (const int vert : bke::pbvh::node_unique_verts(*nodes[i])) {
-        if (!hide_vert.is_empty() && hide_vert[vert]) {
-          continue;
-        }
-        if (!select_vert.is_empty() && !select_vert[vert]) {
-          continue;
-        }
-        if (!sculpt_brush_test_sq_fn(test, vert_positions[vert])) {
-          continue;
-        }
-        float brush_strength = cache->bstrength;
-        const float angle_cos = use_normal ?
-                                    dot_v3v3(sculpt_normal_frontface, vert_normals[vert]) :
-                                    1.0f;
-        if (!vwpaint::test_brush_angle_falloff(
-                brush, wpd.normal_angle_precalc, angle_cos, &brush_strength))
-        {
-          continue;
-        }
-        const float brush_fade = BKE_brush_curve_strength(&brush, sqrtf(test.dist), cache->radius);
-        const float final_alpha = brush_fade * brush_strength * brush_alpha_pressure;
+  parallel_nodes_loop_with_mirror_check(
+      vp, ob, wpi, mesh, nodes, [&](const IndexRange range, const PaintVertFn paint_vert) {
+        SculptBrushTest test = test_init;
+        for (const int i : range) {
+          for (const int vert : bke::pbvh::node_unique_verts(*nodes[i])) {
+            if (!hide_vert.is_empty() && hide_vert[vert]) {
+              continue;
+            }
+            if (!select_vert.is_empty() && !select_vert[vert]) {
+              continue;
+            }
+            if (!sculpt_brush_test_sq_fn(test, vert_positions[vert])) {
+              continue;
+            }
+            float brush_strength = cache->bstrength;
+            const float angle_cos = use_normal ?
+                                        dot_v3v3(sculpt_normal_frontface, vert_normals[vert]) :
+                                        1.0f;
+            if (!vwpaint::test_brush_angle_falloff(
+                    brush, wpd.normal_angle_precalc, angle_cos, &brush_strength))
+            {
+              continue;
+            }
+            const float brush_fade = BKE_brush_curve_strength(
+                &brush, sqrtf(test.dist), cache->radius);
+            const float final_alpha = brush_fade * brush_strength * brush_alpha_pressure;
+
+            if ((brush.flag & BRUSH_ACCUMULATE) == 0) {
+              if (ss.mode.wpaint.alpha_weight[vert] < final_alpha) {
+                ss.mode.wpaint.alpha_weight[vert] = final_alpha;
+              }
+              else {
+                continue;
+              }
+            }
 
-        if ((brush.flag & BRUSH_ACCUMULATE) == 0) {
-          if (ss.mode.wpaint.alpha_weight[vert] < final_alpha) {
-            ss.mode.wpaint.alpha_weight[vert] = final_alpha;
-          }
-          else {
-            continue;
+            paint_vert(vert, final_alpha, paintweight);
           }
         }
-
-        do_weight_paint_vertex(vp, ob, wpi, vert, final_alpha, paintweight);
-      }
-    }
-  });
+      });
 }
 
 static float calculate_average_weight(Object &ob,
@@ -1742,6 +1795,9 @@ static void wpaint_stroke_update_step(bContext *C,
 
   /* *** setup WeightPaintInfo - pass onto do_weight_paint_vertex *** */
   wpi.dvert = mesh.deform_verts_for_write();
+  if (wpd->vert_mirror_indices) {
+    wpi.vert_mirror_indices = Span(wpd->vert_mirror_indices, mesh.verts_num);
+  }
 
   wpi.defbase_tot = wpd->defbase_tot;
   wpi.defbase_sel = wpd->defbase_sel;
@@ -1818,6 +1874,7 @@ static void wpaint_stroke_done(const bContext *C, PaintStroke *stroke)
     MEM_SAFE_FREE(wpd->active.lock);
     MEM_SAFE_FREE(wpd->mirror.lock);
     MEM_SAFE_FREE(wpd->precomputed_weight);
+    MEM_SAFE_FREE(wpd->vert_mirror_indices);
     MEM_freeN(wpd);
   }
 
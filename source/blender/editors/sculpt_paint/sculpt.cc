@@ -3872,7 +3872,7 @@ static void do_brush_action(const Scene &scene,
       pose::do_pose_brush(sd, ob, nodes);
       break;
     case SCULPT_TOOL_DRAW_SHARP:
-      SCULPT_do_draw_sharp_brush(sd, ob, nodes);
+      do_draw_sharp_brush(sd, ob, nodes);
       break;
     case SCULPT_TOOL_ELASTIC_DEFORM:
       SCULPT_do_elastic_deform_brush(sd, ob, nodes);
@@ -6508,6 +6508,7 @@ int SCULPT_vertex_island_get(const SculptSession &ss, PBVHVertRef vertex)
 void SCULPT_topology_islands_invalidate(SculptSession &ss)
 {
   ss.islands_valid = false;
+  ss.geodesic_cache.clear_and_shrink();
 }
 
 void SCULPT_topology_islands_ensure(Object &ob)
@@ -6624,6 +6625,39 @@ void gather_bmesh_positions(const Set<BMVert *, 0> &verts, const MutableSpan<flo
   }
 }
 
+OrigPositionData orig_position_data_get_mesh(const Object & /*object*/, const PBVHNode &node)
+{
+  const undo::Node *unode = undo::get_node(&node, undo::Type::Position);
+  const int verts_num = bke::pbvh::node_unique_verts(node).size();
+  return {unode->position.as_span().take_front(verts_num),
+          unode->normal.as_span().take_front(verts_num)};
+}
+
+OrigPositionData orig_position_data_get_grids(const Object & /*object*/, const PBVHNode &node)
+{
+  const undo::Node *unode = undo::get_node(&node, undo::Type::Position);
+  return {unode->position.as_span(), unode->normal.as_span()};
+}
+
+void orig_position_data_gather_bmesh(BMLog &bm_log,
+                                     const Set<BMVert *, 0> &verts,
+                                     const MutableSpan<float3> positions,
+                                     const MutableSpan<float3> normals)
+{
+  BLI_assert(verts.size() == positions.size());
+  BLI_assert(verts.size() == normals.size());
+
+  int i = 0;
+  for (BMVert *vert : verts) {
+    const float *co;
+    const float *no;
+    BM_log_original_vert_data(&bm_log, vert, &co, &no);
+    positions[i] = co;
+    normals[i] = no;
+    i++;
+  }
+}
+
 void fill_factor_from_hide(const Mesh &mesh,
                            const Span<int> verts,
                            const MutableSpan<float> r_factors)
@@ -6802,6 +6836,18 @@ void calc_front_face(const float3 &view_normal,
   }
 }
 
+void calc_front_face(const float3 &view_normal,
+                     const Span<float3> normals,
+                     const MutableSpan<float> factors)
+{
+  BLI_assert(normals.size() == factors.size());
+
+  for (const int i : normals.index_range()) {
+    const float dot = math::dot(view_normal, normals[i]);
+    factors[i] *= std::max(dot, 0.0f);
+  }
+}
+
 void filter_region_clip_factors(const SculptSession &ss,
                                 const Span<float3> positions,
                                 const Span<int> verts,
@@ -6,15 +6,18 @@
  * \ingroup edsculpt
  */
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_hash_mm2a.hh"
 #include "BLI_linklist_stack.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "DNA_brush_types.h"
 #include "DNA_mesh_types.h"
@@ -223,6 +226,85 @@ static Array<float> geodesic_mesh_create(Object &ob,
   return dists;
 }
 
+/** The number of geodesic distance fields kept in #SculptSession::geodesic_cache. */
+static constexpr int geodesic_cache_size = 2;
+
+template<typename T> static uint32_t hash_span(const Span<T> data, const uint32_t seed)
+{
+  return BLI_hash_mm2(
+      reinterpret_cast<const unsigned char *>(data.data()), data.size_in_bytes(), seed);
+}
+
+/**
+ * Hash the data that the distances depend on besides the topology. That is much faster than
+ * calculating the distances, so it's fine to do on every use of the cache.
+ */
+static uint32_t geodesic_state_hash(const Span<float3> positions, const Span<bool> hide_poly)
+{
+  constexpr int64_t chunk_size = 1 << 16;
+  const int64_t chunks_num = (positions.size() + chunk_size - 1) / chunk_size;
+  Array<uint32_t> chunk_hashes(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange chunk_range = IndexRange(chunk * chunk_size, chunk_size)
+                                         .intersect(positions.index_range());
+      chunk_hashes[chunk] = hash_span(positions.slice(chunk_range), 0);
+    }
+  });
+  chunk_hashes.last() = hash_span(hide_poly, 0);
+  return hash_span(chunk_hashes.as_span(), 0);
+}
+
+static Array<float> geodesic_mesh_create_cached(Object &ob,
+                                                const Set<int> &initial_verts,
+                                                const float limit_radius)
+{
+  SculptSession &ss = *ob.sculpt;
+  const Mesh &mesh = *BKE_object_get_original_mesh(&ob);
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  const VArraySpan<bool> hide_poly = *attributes.lookup<bool>(".hide_poly", bke::AttrDomain::Face);
+
+  Vector<int> sorted_verts;
+  sorted_verts.reserve(initial_verts.size());
+  for (const int vert : initial_verts) {
+    sorted_verts.append(vert);
+  }
+  std::sort(sorted_verts.begin(), sorted_verts.end());
+
+  const uint32_t state_hash = geodesic_state_hash(SCULPT_mesh_deformed_positions_get(ss),
+                                                  hide_poly);
+
+  Vector<SculptGeodesicCacheEntry> &cache = ss.geodesic_cache;
+  for (const int i : cache.index_range()) {
+    const SculptGeodesicCacheEntry &entry = cache[i];
+    if (entry.state_hash == state_hash && entry.limit_radius == limit_radius &&
+        entry.initial_verts.as_span() == sorted_verts.as_span() &&
+        entry.distances.size() == mesh.verts_num)
+    {
+      SculptGeodesicCacheEntry found = std::move(cache[i]);
+      cache.remove(i);
+      cache.append(std::move(found));
+      return cache.last().distances;
+    }
+  }
+
+  /* The positions may have changed since the other distances were calculated. */
+  cache.remove_if([&](const SculptGeodesicCacheEntry &entry) {
+    return entry.state_hash != state_hash;
+  });
+  if (cache.size() >= geodesic_cache_size) {
+    cache.remove(0);
+  }
+
+  SculptGeodesicCacheEntry entry;
+  entry.initial_verts = std::move(sorted_verts);
+  entry.limit_radius = limit_radius;
+  entry.state_hash = state_hash;
+  entry.distances = geodesic_mesh_create(ob, initial_verts, limit_radius);
+  cache.append(std::move(entry));
+  return cache.last().distances;
+}
+
 /* For sculpt mesh data that does not support a geodesic distances algorithm, fallback to the
  * distance to each vertex. In this case, only one of the initial vertices will be used to
  * calculate the distance. */
@@ -254,7 +336,7 @@ Array<float> distances_create(Object &ob, const Set<int> &initial_verts, const f
   SculptSession &ss = *ob.sculpt;
   switch (BKE_pbvh_type(*ss.pbvh)) {
     case PBVH_FACES:
-      return geodesic_mesh_create(ob, initial_verts, limit_radius);
+      return geodesic_mesh_create_cached(ob, initial_verts, limit_radius);
     case PBVH_BMESH:
     case PBVH_GRIDS:
       return geodesic_fallback_create(ob, initial_verts);
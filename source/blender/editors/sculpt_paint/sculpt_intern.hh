@@ -137,6 +137,16 @@ enum class Type : int8_t {
   Color,
 };
 
+/**
+ * A compressed copy of an array, created when an undo step is pushed. Only used in
+ * `sculpt_undo.cc`.
+ */
+struct CompressedArray {
+  Array<std::byte> data;
+  /** The number of elements in the uncompressed array. */
+  int64_t size = 0;
+};
+
 struct Node {
   Array<float3> position;
   Array<float3> orig_position;
@@ -167,6 +177,12 @@ struct Node {
   Array<int> face_sets;
 
   Vector<int> face_indices;
+
+  /* Compressed storage of the arrays above while the undo step isn't used. */
+
+  CompressedArray position_compressed;
+  CompressedArray orig_position_compressed;
+  CompressedArray mask_compressed;
 };
 
 }
@@ -2025,7 +2041,6 @@ void SCULPT_do_layer_brush(const Sculpt &sd, Object &ob, blender::Span<PBVHNode
 void SCULPT_do_pinch_brush(const Sculpt &sd, Object &ob, blender::Span<PBVHNode *> nodes);
 void SCULPT_do_grab_brush(const Sculpt &sd, Object &ob, blender::Span<PBVHNode *> nodes);
 void SCULPT_do_elastic_deform_brush(const Sculpt &sd, Object &ob, blender::Span<PBVHNode *> nodes);
-void SCULPT_do_draw_sharp_brush(const Sculpt &sd, Object &ob, blender::Span<PBVHNode *> nodes);
 void SCULPT_do_slide_relax_brush(const Sculpt &sd, Object &ob, blender::Span<PBVHNode *> nodes);
 
 void SCULPT_do_displacement_smear_brush(const Sculpt &sd,
@@ -2083,7 +2098,7 @@ void ensure_valid_pivot(const Object &ob, Scene &scene);
 void SCULPT_topology_islands_ensure(Object &ob);
 
 /**
- * Mark vertex island keys as invalid.
+ * Mark vertex island keys and cached geodesic distances as invalid.
  * Call when adding or hiding geometry.
  */
 void SCULPT_topology_islands_invalidate(SculptSession &ss);
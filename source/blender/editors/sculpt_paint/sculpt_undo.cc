@@ -30,13 +30,17 @@
  * Operators must have the OPTYPE_UNDO flag set for this to work properly.
  */
 
+#include <atomic>
 #include <cstddef>
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_key_types.h"
@@ -83,6 +87,9 @@ namespace blender::ed::sculpt_paint::undo {
 /* Uncomment to print the undo stack in the console on push/undo/redo. */
 // #define SCULPT_UNDO_DEBUG
 
+/* Compress the undo nodes in a background task instead of blocking the end of the stroke. */
+#define USE_COMPRESSION_THREAD
+
 /* Implementation of undo system for objects in sculpt mode.
  *
  * Each undo step in sculpt mode consists of list of nodes, each node contains:
@@ -208,6 +215,14 @@ struct StepData {
   Vector<std::unique_ptr<Node>> nodes;
 
   size_t undo_size;
+
+#ifdef USE_COMPRESSION_THREAD
+  /** Compresses the nodes after the step is pushed or restored, see #nodes_compress. */
+  TaskPool *compression_pool;
+#endif
+  /** The size of the step after compression, only valid when #compression_finished is set. */
+  size_t undo_size_compressed;
+  std::atomic<bool> compression_finished;
 };
 
 struct SculptAttrRef {
@@ -1148,8 +1163,195 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Positions and masks make up most of the memory of an undo step, but they aren't accessed
+ * until the step is undone or redone. So they are compressed after the step is pushed and
+ * decompressed just before it is restored. Every value is XOR'd with the value of the previous
+ * element, which is usually close by in the same PBVH node, and the bytes are grouped by their
+ * position in the value. That leaves long runs of zero bytes that compress well.
+ * \{ */
+
+static constexpr int compression_level = 1;
+
+template<typename T> static void compress_array(Array<T> &array, CompressedArray &r_compressed)
+{
+  static_assert(sizeof(T) % sizeof(uint32_t) == 0);
+  if (array.is_empty()) {
+    return;
+  }
+  constexpr int64_t stride = sizeof(T) / sizeof(uint32_t);
+  const Span<uint32_t> words(reinterpret_cast<const uint32_t *>(array.data()),
+                             array.size() * stride);
+  const int64_t words_num = words.size();
+
+  Array<std::byte> delta(words.size_in_bytes());
+  for (const int64_t i : words.index_range()) {
+    const uint32_t value = words[i] ^ (i >= stride ? words[i - stride] : 0);
+    for (const int64_t byte : IndexRange(sizeof(uint32_t))) {
+      delta[byte * words_num + i] = std::byte((value >> (byte * 8)) & 0xFF);
+    }
+  }
+
+  Array<std::byte> compressed(ZSTD_compressBound(size_t(delta.size())));
+  const size_t compressed_size = ZSTD_compress(compressed.data(),
+                                               size_t(compressed.size()),
+                                               delta.data(),
+                                               size_t(delta.size()),
+                                               compression_level);
+  if (ZSTD_isError(compressed_size) || int64_t(compressed_size) >= delta.size()) {
+    /* Keep the uncompressed array. */
+    return;
+  }
+  r_compressed.data = compressed.as_span().take_front(int64_t(compressed_size));
+  r_compressed.size = array.size();
+  array = {};
+}
+
+template<typename T>
+static void decompress_array(CompressedArray &compressed, Array<T> &r_array)
+{
+  if (compressed.data.is_empty()) {
+    return;
+  }
+  constexpr int64_t stride = sizeof(T) / sizeof(uint32_t);
+  const int64_t words_num = compressed.size * stride;
+
+  Array<std::byte> delta(words_num * int64_t(sizeof(uint32_t)));
+  const size_t delta_size = ZSTD_decompress(delta.data(),
+                                            size_t(delta.size()),
+                                            compressed.data.data(),
+                                            size_t(compressed.data.size()));
+  BLI_assert(!ZSTD_isError(delta_size) && int64_t(delta_size) == delta.size());
+  UNUSED_VARS_NDEBUG(delta_size);
+
+  r_array.reinitialize(compressed.size);
+  MutableSpan<uint32_t> words(reinterpret_cast<uint32_t *>(r_array.data()), words_num);
+  for (const int64_t i : words.index_range()) {
+    uint32_t value = 0;
+    for (const int64_t byte : IndexRange(sizeof(uint32_t))) {
+      value |= uint32_t(delta[byte * words_num + i]) << (byte * 8);
+    }
+    words[i] = value ^ (i >= stride ? words[i - stride] : 0);
+  }
+  compressed = {};
+}
+
+static size_t node_size_in_bytes(const Node &node)
+{
+  size_t size = sizeof(Node);
+  size += node.position.as_span().size_in_bytes();
+  size += node.orig_position.as_span().size_in_bytes();
+  size += node.normal.as_span().size_in_bytes();
+  size += node.col.as_span().size_in_bytes();
+  size += node.mask.as_span().size_in_bytes();
+  size += node.loop_col.as_span().size_in_bytes();
+  size += node.orig_loop_col.as_span().size_in_bytes();
+  size += node.vert_indices.as_span().size_in_bytes();
+  size += node.corner_indices.as_span().size_in_bytes();
+  size += node.vert_hidden.size() / 8;
+  size += node.face_hidden.size() / 8;
+  size += node.grids.as_span().size_in_bytes();
+  size += node.grid_hidden.all_bits().size() / 8;
+  size += node.face_sets.as_span().size_in_bytes();
+  size += node.face_indices.as_span().size_in_bytes();
+  size += node.position_compressed.data.as_span().size_in_bytes();
+  size += node.orig_position_compressed.data.as_span().size_in_bytes();
+  size += node.mask_compressed.data.as_span().size_in_bytes();
+  return size;
+}
+
+static void compress_nodes_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  StepData &step_data = *static_cast<StepData *>(taskdata);
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Node &node = *step_data.nodes[i];
+      compress_array(node.position, node.position_compressed);
+      compress_array(node.orig_position, node.orig_position_compressed);
+      compress_array(node.mask, node.mask_compressed);
+    }
+  });
+  step_data.undo_size_compressed = threading::parallel_reduce(
+      step_data.nodes.index_range(),
+      16,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_size_in_bytes(*step_data.nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+  step_data.compression_finished = true;
+}
+
+/** Wait until the nodes of the step are compressed, the nodes must not be accessed before. */
+static void nodes_compress_wait(StepData &step_data)
+{
+#ifdef USE_COMPRESSION_THREAD
+  if (step_data.compression_pool) {
+    BLI_task_pool_work_and_wait(step_data.compression_pool);
+    BLI_task_pool_free(step_data.compression_pool);
+    step_data.compression_pool = nullptr;
+  }
+#else
+  UNUSED_VARS(step_data);
+#endif
+}
+
+static void nodes_compress(StepData &step_data)
+{
+  nodes_compress_wait(step_data);
+  if (step_data.nodes.is_empty()) {
+    return;
+  }
+  step_data.compression_finished = false;
+#ifdef USE_COMPRESSION_THREAD
+  step_data.compression_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  BLI_task_pool_push(step_data.compression_pool, compress_nodes_task, &step_data, false, nullptr);
+#else
+  compress_nodes_task(nullptr, &step_data);
+#endif
+}
+
+static void nodes_decompress(StepData &step_data)
+{
+  nodes_compress_wait(step_data);
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Node &node = *step_data.nodes[i];
+      decompress_array(node.position_compressed, node.position);
+      decompress_array(node.orig_position_compressed, node.orig_position);
+      decompress_array(node.mask_compressed, node.mask);
+    }
+  });
+}
+
+/**
+ * The memory usage of a step is stored when it is pushed, before its nodes are compressed.
+ * Update it for the steps that have been compressed since, so that the undo memory limit takes
+ * the compression into account.
+ */
+static void update_compressed_steps_size(UndoStack &ustack)
+{
+  LISTBASE_FOREACH (UndoStep *, us_iter, &ustack.steps) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+      continue;
+    }
+    const SculptUndoStep *us = reinterpret_cast<const SculptUndoStep *>(us_iter);
+    if (us->data.compression_finished) {
+      us_iter->data_size = us->data.undo_size_compressed;
+    }
+  }
+}
+
+/** \} */
+
 static void free_step_data(StepData &step_data)
 {
+  nodes_compress_wait(step_data);
   geometry_free_data(&step_data.geometry_original);
   geometry_free_data(&step_data.geometry_modified);
   geometry_free_data(&step_data.geometry_bmesh_enter);
@@ -1665,6 +1867,8 @@ void push_begin_ex(Object &ob, const char *name)
 
   SculptUndoStep *us = (SculptUndoStep *)BKE_undosys_step_push_init_with_type(
       ustack, C, name, BKE_UNDOSYS_TYPE_SCULPT);
+  /* Nodes can be added to a step that has been ended before, in nested undo pushes. */
+  nodes_compress_wait(us->data);
   us->data.object_name = ob.id.name;
 
   if (!us->active_color_start.was_set) {
@@ -1712,30 +1916,10 @@ void push_end(Object &ob)
   push_end_ex(ob, false);
 }
 
-static size_t node_size_in_bytes(const Node &node)
-{
-  size_t size = sizeof(Node);
-  size += node.position.as_span().size_in_bytes();
-  size += node.orig_position.as_span().size_in_bytes();
-  size += node.normal.as_span().size_in_bytes();
-  size += node.col.as_span().size_in_bytes();
-  size += node.mask.as_span().size_in_bytes();
-  size += node.loop_col.as_span().size_in_bytes();
-  size += node.orig_loop_col.as_span().size_in_bytes();
-  size += node.vert_indices.as_span().size_in_bytes();
-  size += node.corner_indices.as_span().size_in_bytes();
-  size += node.vert_hidden.size() / 8;
-  size += node.face_hidden.size() / 8;
-  size += node.grids.as_span().size_in_bytes();
-  size += node.grid_hidden.all_bits().size() / 8;
-  size += node.face_sets.as_span().size_in_bytes();
-  size += node.face_indices.as_span().size_in_bytes();
-  return size;
-}
-
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
+  nodes_compress_wait(*step_data);
 
   /* Move undo node storage from map to vector. */
   step_data->nodes.reserve(step_data->undo_nodes_by_pbvh_node.size());
@@ -1761,12 +1945,15 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
       },
       std::plus<size_t>());
 
+  nodes_compress(*step_data);
+
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
   if (wm->op_undo_depth == 0 || use_nested_undo) {
     UndoStack *ustack = ED_undo_stack_get();
     BKE_undosys_step_push(ustack, nullptr, nullptr);
     if (wm->op_undo_depth == 0) {
+      update_compressed_steps_size(*ustack);
       BKE_undosys_stack_limit_steps_and_memory_defaults(ustack);
     }
     WM_file_tag_modified();
@@ -1862,7 +2049,9 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == true);
 
+  nodes_decompress(us->data);
   restore_list(C, depsgraph, us->data);
+  nodes_compress(us->data);
   us->step.is_applied = false;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
@@ -1872,7 +2061,9 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
+  nodes_decompress(us->data);
   restore_list(C, depsgraph, us->data);
+  nodes_compress(us->data);
   us->step.is_applied = true;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
@@ -3661,6 +3661,13 @@ static void node_draw_hidden(const bContext &C,
                              uiBlock &block)
 {
   const rctf &rct = node.runtime->totr;
+
+  /* Skip if out of view. */
+  if (BLI_rctf_isect(&rct, &v2d.cur, nullptr) == false) {
+    UI_block_end(&C, &block);
+    return;
+  }
+
   float centy = BLI_rctf_cent_y(&rct);
   float hiddenrad = BLI_rctf_size_y(&rct) / 2.0f;
 
@@ -4400,10 +4407,13 @@ static void node_draw_zones_and_frames(const bContext &C,
     return;
   }
 
+  const View2D &v2d = region.v2d;
+
   Array<Vector<float2>> bounds_by_zone(zones->zones.size());
   Array<bke::CurvesGeometry> fillet_curve_by_zone(zones->zones.size());
   /* Bounding box area of zones is used to determine draw order. */
   Array<float> bounding_box_width_by_zone(zones->zones.size());
+  Array<bool> is_visible_by_zone(zones->zones.size());
 
   for (const int zone_i : zones->zones.index_range()) {
     const bNodeTreeZone &zone = *zones->zones[zone_i];
@@ -4416,6 +4426,19 @@ static void node_draw_zones_and_frames(const bContext &C,
     const float bounding_box_width = bounding_box.max.x - bounding_box.min.x;
     bounding_box_width_by_zone[zone_i] = bounding_box_width;
 
+    /* Skip the rounded boundary of zones that are out of view, the bounds of the nested zones are
+     * still needed by their parents. */
+    rctf zone_rect;
+    BLI_rctf_init(&zone_rect,
+                  bounding_box.min.x,
+                  bounding_box.max.x,
+                  bounding_box.min.y,
+                  bounding_box.max.y);
+    is_visible_by_zone[zone_i] = BLI_rctf_isect(&zone_rect, &v2d.cur, nullptr);
+    if (!is_visible_by_zone[zone_i]) {
+      continue;
+    }
+
     bke::CurvesGeometry boundary_curve(boundary_positions_num, 1);
     boundary_curve.cyclic_for_write().first() = true;
     boundary_curve.fill_curve_types(CURVE_TYPE_POLY);
@@ -4434,7 +4457,6 @@ static void node_draw_zones_and_frames(const bContext &C,
         {});
   }
 
-  const View2D &v2d = region.v2d;
   float scale;
   UI_view2d_scale_get(&v2d, &scale, nullptr);
   float line_width = 1.0f * scale;
@@ -4480,6 +4502,9 @@ static void node_draw_zones_and_frames(const bContext &C,
     if (const bNodeTreeZone *const *zone_p = std::get_if<const bNodeTreeZone *>(&zone_or_node)) {
       const bNodeTreeZone &zone = **zone_p;
       const int zone_i = zone.index;
+      if (!is_visible_by_zone[zone_i]) {
+        continue;
+      }
       float zone_color[4];
       UI_GetThemeColor4fv(get_theme_id(zone_i), zone_color);
       if (zone_color[3] == 0.0f) {
@@ -4515,6 +4540,9 @@ static void node_draw_zones_and_frames(const bContext &C,
     }
     const bNodeTreeZone &zone = **zone_p;
     const int zone_i = zone.index;
+    if (!is_visible_by_zone[zone_i]) {
+      continue;
+    }
     const Span<float3> fillet_boundary_positions = fillet_curve_by_zone[zone_i].positions();
     /* Draw the contour lines. */
     immBindBuiltinProgram(GPU_SHADER_3D_POLYLINE_UNIFORM_COLOR);
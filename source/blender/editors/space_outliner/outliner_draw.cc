@@ -3404,12 +3404,17 @@ static void outliner_draw_tree_element(bContext *C,
   float ufac = UI_UNIT_X / 20.0f;
   int offsx = 0;
   eOLDrawState active = OL_DRAWSEL_NONE;
-  uchar text_color[4];
-  UI_GetThemeColor4ubv(TH_TEXT, text_color);
-  float icon_bgcolor[4], icon_border[4];
-  outliner_icon_background_colors(icon_bgcolor, icon_border);
 
   if (*starty + 2 * UI_UNIT_Y >= region->v2d.cur.ymin && *starty <= region->v2d.cur.ymax) {
+    /* Only look up the colors for elements in view, the tree may contain many more elements. */
+    uchar text_color[4];
+    UI_GetThemeColor4ubv(TH_TEXT, text_color);
+    float icon_bgcolor[4], icon_border[4];
+    outliner_icon_background_colors(icon_bgcolor, icon_border);
+
+    /* Icon rows of closed elements change the coordinates of their children. */
+    te->flag &= ~TE_SUBTREE_COORDS_CLEARED;
+
     const float alpha_fac = element_should_draw_faded(tvc, te, tselem) ? 0.5f : 1.0f;
     int xmax = region->v2d.cur.xmax;
 
@@ -3591,6 +3596,7 @@ static void outliner_draw_tree_element(bContext *C,
 
   if (TSELEM_OPEN(tselem, space_outliner)) {
     *starty -= UI_UNIT_Y;
+    te->flag &= ~TE_SUBTREE_COORDS_CLEARED;
 
     LISTBASE_FOREACH (TreeElement *, ten, &te->subtree) {
       /* Check if element needs to be drawn grayed out, but also gray out
@@ -3611,7 +3617,11 @@ static void outliner_draw_tree_element(bContext *C,
     }
   }
   else {
-    outliner_set_subtree_coords(te);
+    /* Walking the whole subtree on every redraw is expensive for big closed hierarchies. */
+    if ((te->flag & TE_SUBTREE_COORDS_CLEARED) == 0) {
+      outliner_set_subtree_coords(te);
+      te->flag |= TE_SUBTREE_COORDS_CLEARED;
+    }
     *starty -= UI_UNIT_Y;
   }
 }
@@ -177,6 +177,9 @@ enum {
   /* Child elements of the same type in the icon-row are drawn merged as one icon.
    * This flag is set for an element that is part of these merged child icons. */
   TE_ICONROW_MERGED = (1 << 7),
+  /* The coordinates of the subtree of this closed element were reset and nothing in it was drawn
+   * since, so there is no need to reset them again on every redraw. */
+  TE_SUBTREE_COORDS_CLEARED = (1 << 8),
 };
 
 /* button events */
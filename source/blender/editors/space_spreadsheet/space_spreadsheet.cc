@@ -5,6 +5,7 @@
 #include <cstring>
 
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_string.h"
 
 #include "BKE_screen.hh"
@@ -390,8 +391,14 @@ static int get_index_column_width(const int tot_rows)
          UI_UNIT_X * 0.75;
 }
 
-static void update_visible_columns(ListBase &columns, DataSource &data_source)
+/**
+ * Remove columns that don't exist anymore and add the default columns of the data source. The
+ * values of all remaining columns are returned, so that they don't have to be retrieved again.
+ */
+static Map<const SpreadsheetColumn *, std::unique_ptr<ColumnValues>> update_visible_columns(
+    ListBase &columns, DataSource &data_source)
 {
+  Map<const SpreadsheetColumn *, std::unique_ptr<ColumnValues>> column_values;
   Set<SpreadsheetColumnID> used_ids;
   LISTBASE_FOREACH_MUTABLE (SpreadsheetColumn *, column, &columns) {
     std::unique_ptr<ColumnValues> values = data_source.get_column_values(*column->id);
@@ -408,6 +415,8 @@ static void update_visible_columns(ListBase &columns, DataSource &data_source)
       spreadsheet_column_free(column);
       continue;
     }
+
+    column_values.add_new(column, std::move(values));
   }
 
   data_source.foreach_default_column_ids(
@@ -423,9 +432,12 @@ static void update_visible_columns(ListBase &columns, DataSource &data_source)
             else {
               BLI_addtail(&columns, new_column);
             }
+            column_values.add_new(new_column, std::move(values));
           }
         }
       });
+
+  return column_values;
 }
 
 static void spreadsheet_main_region_draw(const bContext *C, ARegion *region)
@@ -439,13 +451,14 @@ static void spreadsheet_main_region_draw(const bContext *C, ARegion *region)
     data_source = std::make_unique<DataSource>();
   }
 
-  update_visible_columns(sspreadsheet->columns, *data_source);
+  Map<const SpreadsheetColumn *, std::unique_ptr<ColumnValues>> column_values =
+      update_visible_columns(sspreadsheet->columns, *data_source);
 
   SpreadsheetLayout spreadsheet_layout;
   ResourceScope scope;
 
   LISTBASE_FOREACH (SpreadsheetColumn *, column, &sspreadsheet->columns) {
-    std::unique_ptr<ColumnValues> values_ptr = data_source->get_column_values(*column->id);
+    std::unique_ptr<ColumnValues> values_ptr = column_values.pop(column);
     /* Should have been removed before if it does not exist anymore. */
     BLI_assert(values_ptr);
     const ColumnValues *values = scope.add(std::move(values_ptr));
@@ -33,6 +33,15 @@ static IndexMask apply_filter_operation(const VArray<T> &data,
                                         const IndexMask &mask,
                                         IndexMaskMemory &memory)
 {
+  /* Avoid a virtual function call per row for the common kinds of virtual arrays. */
+  if (data.is_single()) {
+    return check_fn(data.get_internal_single()) ? mask : IndexMask();
+  }
+  if (data.is_span()) {
+    const Span<T> span = data.get_internal_span();
+    return IndexMask::from_predicate(
+        mask, GrainSize(1024), memory, [&](const int64_t i) { return check_fn(span[i]); });
+  }
   return IndexMask::from_predicate(
       mask, GrainSize(1024), memory, [&](const int64_t i) { return check_fn(data[i]); });
 }
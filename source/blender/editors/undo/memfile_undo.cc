@@ -221,6 +221,8 @@ static void memfile_undosys_step_decode(
   /* bmain has been freed. */
   bmain = CTX_data_main(C);
   ED_editors_init_for_undo(bmain);
+  /* Re-read IDs may use other addresses than the ones stored in the loaded step. */
+  bmain->is_memfile_undo_id_skip_allowed = false;
 
   if (use_old_bmain_data) {
     /* Restore previous depsgraphs into current bmain. */
@@ -492,6 +492,35 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 const FieldContext &context,
                                 Span<GVMutableArray> dst_varrays = {});
 
+/**
+ * Evaluates some varying fields in a different way than with a multi-function procedure, e.g. on
+ * the GPU. #evaluate_fields uses the registered backend for every field that it supports and falls
+ * back to the procedure when the backend fails.
+ */
+class FieldEvaluationBackend {
+ public:
+  virtual ~FieldEvaluationBackend() = default;
+
+  /** Whether the backend should be used to compute the field for the indices in the mask. */
+  virtual bool supports(const GFieldRef &field, const IndexMask &mask) const = 0;
+
+  /**
+   * Compute the field for all indices in the mask and construct the results in the uninitialized
+   * #dst. Nothing has been constructed in #dst when false is returned.
+   */
+  virtual bool evaluate(ResourceScope &scope,
+                        const GFieldRef &field,
+                        const IndexMask &mask,
+                        const FieldContext &context,
+                        GMutableSpan dst) const = 0;
+};
+
+/**
+ * Register the backend used by #evaluate_fields. Null unregisters the current backend. This is not
+ * thread-safe, it is meant to be called when the program starts and exits.
+ */
+void set_field_evaluation_backend(const FieldEvaluationBackend *backend);
+
 /* -------------------------------------------------------------------- */
 /** \name Utility functions for simple field creation and evaluation
  * \{ */
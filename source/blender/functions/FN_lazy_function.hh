@@ -47,6 +47,7 @@
 #include "BLI_vector.hh"
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 #ifndef NDEBUG
@@ -309,6 +310,13 @@ class LazyFunction {
   virtual void possible_output_dependencies(int output_index,
                                             FunctionRef<void(Span<int>)> fn) const;
 
+  /**
+   * Estimated time a single execution of the function takes, or zero if that is unknown. Graph
+   * executors use this to decide which nodes are worth running on a separate thread. The estimate
+   * may be based on how long previous executions took.
+   */
+  virtual std::chrono::nanoseconds estimated_run_time() const;
+
   /**
    * Inputs of the function.
    */
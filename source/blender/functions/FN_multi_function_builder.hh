@@ -430,11 +430,26 @@ inline void execute_element_fn_as_multi_function(const ElementFn element_fn,
             }
             else {
               const auto segment_indices = std::get<IndexMaskSegment>(segment);
-              execute_array(TypeSequence<ParamTags...>(),
-                            std::index_sequence<I...>(),
-                            element_fn,
-                            segment_indices,
-                            std::forward<decltype(args)>(args)...);
+              if constexpr (ExecPreset::fallback_mode == exec_presets::FallbackMode::Materialized)
+              {
+                /* Indexing the devirtualized arrays with arbitrary indices results in scalar
+                 * gathers and scatters around every call of the element function. Instead,
+                 * process the segment in small contiguous chunks, so that the same vectorizable
+                 * loop as for ranges is used. This does not depend on the devirtualized types, so
+                 * it is only instantiated once. */
+                execute_materialized(TypeSequence<ParamTags...>(),
+                                     std::index_sequence<I...>(),
+                                     element_fn,
+                                     segment_indices,
+                                     loaded_params);
+              }
+              else {
+                execute_array(TypeSequence<ParamTags...>(),
+                              std::index_sequence<I...>(),
+                              element_fn,
+                              segment_indices,
+                              std::forward<decltype(args)>(args)...);
+              }
             }
           }
         });
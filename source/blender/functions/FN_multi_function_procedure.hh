@@ -262,6 +262,12 @@ class Procedure : NonCopyable, NonMovable {
   DummyInstruction &new_dummy_instruction();
   ReturnInstruction &new_return_instruction();
 
+  /**
+   * Remove an instruction that is not the next instruction of any other instruction anymore. The
+   * variables it references are kept in the procedure.
+   */
+  void remove_instruction(Instruction &instruction);
+
   void add_parameter(ParamType::InterfaceType interface_type, Variable &variable);
   Span<ConstParameter> params() const;
 
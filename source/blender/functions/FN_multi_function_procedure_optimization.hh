@@ -46,4 +46,23 @@ namespace blender::fn::multi_function::procedure_optimization {
  */
 void move_destructs_up(Procedure &procedure, Instruction &block_end_instr);
 
+/**
+ * Every call instruction writes its outputs into arrays that are as large as the mask the
+ * procedure is evaluated on. For long chains of cheap functions, like the math nodes, most of the
+ * time is spent writing and reading these intermediate arrays.
+ *
+ * This optimization pass replaces consecutive calls of functions in a linear chain of
+ * instructions with a single call. The combined function evaluates the original functions on
+ * small chunks of indices at a time, so that intermediate values stay in the CPU cache. Variables
+ * that are destructed within the chain don't need an array for the full mask anymore.
+ *
+ * Only functions with single inputs and outputs are combined. Functions without inputs are not,
+ * because the procedure executor only evaluates them once instead of for every index.
+ *
+ * \param procedure: The procedure that should be optimized.
+ * \param block_end_instr: Same as in #move_destructs_up. This pass should run after that, so that
+ * the destruct instructions of intermediate variables are within the chain of calls.
+ */
+void fuse_element_wise_calls(Procedure &procedure, Instruction &block_end_instr);
+
 }  // namespace blender::fn::multi_function::procedure_optimization
@@ -273,11 +273,19 @@ static void build_multi_function_procedure_for_fields(mf::Procedure &procedure,
   mf::ReturnInstruction &return_instr = builder.add_return();
 
   mf::procedure_optimization::move_destructs_up(procedure, return_instr);
+  mf::procedure_optimization::fuse_element_wise_calls(procedure, return_instr);
 
   // std::cout << procedure.to_dot() << "\n";
   BLI_assert(procedure.validate());
 }
 
+static const FieldEvaluationBackend *field_evaluation_backend = nullptr;
+
+void set_field_evaluation_backend(const FieldEvaluationBackend *backend)
+{
+  field_evaluation_backend = backend;
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 const IndexMask &mask,
@@ -365,6 +373,56 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     }
   }
 
+  /* Get the buffer that the result of a varying field is written to. The buffer is only created
+   * once for every field, so that the procedure can reuse it when the backend failed. */
+  Array<GMutableSpan> output_buffers(fields_to_evaluate.size());
+  auto get_output_buffer = [&](const int out_index) -> GMutableSpan {
+    if (output_buffers[out_index].data() != nullptr) {
+      return output_buffers[out_index];
+    }
+    const CPPType &type = fields_to_evaluate[out_index].cpp_type();
+    /* Try to get an existing virtual array that the result should be written into. */
+    GVMutableArray dst_varray = get_dst_varray(out_index);
+    void *buffer;
+    if (!dst_varray || !dst_varray.is_span()) {
+      /* Allocate a new buffer for the computed result. */
+      buffer = scope.linear_allocator().allocate(type.size() * array_size, type.alignment());
+
+      if (!type.is_trivially_destructible()) {
+        /* Destruct values in the end. */
+        scope.add_destruct_call([buffer, mask, &type]() { type.destruct_indices(buffer, mask); });
+      }
+
+      r_varrays[out_index] = GVArray::ForSpan({type, buffer, array_size});
+    }
+    else {
+      /* Write the result into the existing span. */
+      buffer = dst_varray.get_internal_span().data();
+
+      r_varrays[out_index] = dst_varray;
+      is_output_written_to_dst[out_index] = true;
+    }
+    output_buffers[out_index] = GMutableSpan{type, buffer, array_size};
+    return output_buffers[out_index];
+  };
+
+  /* Let the backend compute the fields that it supports. */
+  if (field_evaluation_backend != nullptr) {
+    for (int i = varying_fields_to_evaluate.size() - 1; i >= 0; i--) {
+      const GFieldRef &field = varying_fields_to_evaluate[i];
+      if (!field_evaluation_backend->supports(field, mask)) {
+        continue;
+      }
+      const int out_index = varying_field_indices[i];
+      if (field_evaluation_backend->evaluate(
+              scope, field, mask, context, get_output_buffer(out_index)))
+      {
+        varying_fields_to_evaluate.remove(i);
+        varying_field_indices.remove(i);
+      }
+    }
+  }
+
   /* Evaluate varying fields if necessary. */
   if (!varying_fields_to_evaluate.is_empty()) {
     /* Build the procedure for those fields. */
@@ -382,36 +440,8 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     }
 
     for (const int i : varying_fields_to_evaluate.index_range()) {
-      const GFieldRef &field = varying_fields_to_evaluate[i];
-      const CPPType &type = field.cpp_type();
-      const int out_index = varying_field_indices[i];
-
-      /* Try to get an existing virtual array that the result should be written into. */
-      GVMutableArray dst_varray = get_dst_varray(out_index);
-      void *buffer;
-      if (!dst_varray || !dst_varray.is_span()) {
-        /* Allocate a new buffer for the computed result. */
-        buffer = scope.linear_allocator().allocate(type.size() * array_size, type.alignment());
-
-        if (!type.is_trivially_destructible()) {
-          /* Destruct values in the end. */
-          scope.add_destruct_call(
-              [buffer, mask, &type]() { type.destruct_indices(buffer, mask); });
-        }
-
-        r_varrays[out_index] = GVArray::ForSpan({type, buffer, array_size});
-      }
-      else {
-        /* Write the result into the existing span. */
-        buffer = dst_varray.get_internal_span().data();
-
-        r_varrays[out_index] = dst_varray;
-        is_output_written_to_dst[out_index] = true;
-      }
-
       /* Pass output buffer to the procedure executor. */
-      const GMutableSpan span{type, buffer, array_size};
-      mf_params.add_uninitialized_single_output(span);
+      mf_params.add_uninitialized_single_output(get_output_buffer(varying_field_indices[i]));
     }
 
     procedure_executor.call_auto(mask, mf_params, mf_context);
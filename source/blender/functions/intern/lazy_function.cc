@@ -49,6 +49,11 @@ void LazyFunction::possible_output_dependencies(const int /*output_index*/,
   fn(indices);
 }
 
+std::chrono::nanoseconds LazyFunction::estimated_run_time() const
+{
+  return std::chrono::nanoseconds(0);
+}
+
 bool LazyFunction::always_used_inputs_available(const Params &params) const
 {
   if (allow_missing_requested_inputs_) {
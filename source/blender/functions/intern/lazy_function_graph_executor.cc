@@ -214,46 +214,99 @@ struct LockedNode {
 class Executor;
 class GraphExecutorLFParams;
 
+/**
+ * Nodes that are estimated to take at least this long are started on a separate thread when there
+ * are other nodes that the current thread can work on in the meantime.
+ */
+static constexpr std::chrono::nanoseconds expensive_node_run_time = std::chrono::microseconds(100);
+
+/**
+ * Many scheduled nodes are only distributed to multiple threads when they are estimated to take at
+ * least this long together. Otherwise the threading overhead is larger than the gain.
+ */
+static constexpr std::chrono::nanoseconds min_split_run_time = std::chrono::milliseconds(1);
+
 /**
  * Keeps track of nodes that are currently scheduled on a thread. A node can only be scheduled by
  * one thread at the same time.
  */
 struct ScheduledNodes {
  private:
+  struct ScheduledNode {
+    const FunctionNode *node;
+    /** The estimate is remembered, because it can change while the node is scheduled. */
+    std::chrono::nanoseconds estimated_run_time;
+  };
+
   /** Use two stacks of scheduled nodes for different priorities. */
-  Vector<const FunctionNode *> priority_;
-  Vector<const FunctionNode *> normal_;
+  Vector<ScheduledNode> priority_;
+  Vector<ScheduledNode> normal_;
+  /** Nodes that are estimated to take longer than #expensive_node_run_time. */
+  Vector<ScheduledNode> expensive_;
+  /** Sum of the run time estimates of the scheduled nodes that have an estimate. */
+  std::chrono::nanoseconds estimated_run_time_{0};
+  int64_t nodes_with_estimate_num_ = 0;
 
  public:
   void schedule(const FunctionNode &node, const bool is_priority)
   {
-    if (is_priority) {
-      this->priority_.append(&node);
+    const ScheduledNode scheduled_node{&node, node.function().estimated_run_time()};
+    this->add_estimate(scheduled_node);
+    if (scheduled_node.estimated_run_time >= expensive_node_run_time) {
+      this->expensive_.append(scheduled_node);
+    }
+    else if (is_priority) {
+      this->priority_.append(scheduled_node);
     }
     else {
-      this->normal_.append(&node);
+      this->normal_.append(scheduled_node);
     }
   }
 
   const FunctionNode *pop_next_node()
   {
-    if (!this->priority_.is_empty()) {
-      return this->priority_.pop_last();
-    }
-    if (!this->normal_.is_empty()) {
-      return this->normal_.pop_last();
+    for (Vector<ScheduledNode> *nodes : {&priority_, &expensive_, &normal_}) {
+      if (!nodes->is_empty()) {
+        const ScheduledNode scheduled_node = nodes->pop_last();
+        this->remove_estimate(scheduled_node);
+        return scheduled_node.node;
+      }
     }
     return nullptr;
   }
 
+  const FunctionNode *pop_expensive_node()
+  {
+    if (expensive_.is_empty()) {
+      return nullptr;
+    }
+    const ScheduledNode scheduled_node = expensive_.pop_last();
+    this->remove_estimate(scheduled_node);
+    return scheduled_node.node;
+  }
+
   bool is_empty() const
   {
-    return this->priority_.is_empty() && this->normal_.is_empty();
+    return this->priority_.is_empty() && this->normal_.is_empty() && this->expensive_.is_empty();
   }
 
   int64_t nodes_num() const
   {
-    return priority_.size() + normal_.size();
+    return priority_.size() + normal_.size() + expensive_.size();
+  }
+
+  int64_t expensive_nodes_num() const
+  {
+    return expensive_.size();
+  }
+
+  /**
+   * Whether it's worth distributing the scheduled nodes to multiple threads. When there are no
+   * estimates, the nodes are assumed to be expensive enough.
+   */
+  bool is_worth_splitting() const
+  {
+    return nodes_with_estimate_num_ == 0 || estimated_run_time_ >= min_split_run_time;
   }
 
   /**
@@ -262,12 +315,36 @@ struct ScheduledNodes {
   void split_into(ScheduledNodes &other)
   {
     BLI_assert(this != &other);
-    const int64_t priority_split = priority_.size() / 2;
-    const int64_t normal_split = normal_.size() / 2;
-    other.priority_.extend(priority_.as_span().drop_front(priority_split));
-    other.normal_.extend(normal_.as_span().drop_front(normal_split));
-    priority_.resize(priority_split);
-    normal_.resize(normal_split);
+    BLI_assert(other.is_empty());
+    for (Vector<ScheduledNode> ScheduledNodes::*nodes :
+         {&ScheduledNodes::priority_, &ScheduledNodes::normal_, &ScheduledNodes::expensive_})
+    {
+      Vector<ScheduledNode> &src_nodes = this->*nodes;
+      const int64_t split = src_nodes.size() / 2;
+      for (const ScheduledNode &scheduled_node : src_nodes.as_span().drop_front(split)) {
+        this->remove_estimate(scheduled_node);
+        other.add_estimate(scheduled_node);
+      }
+      (other.*nodes).extend(src_nodes.as_span().drop_front(split));
+      src_nodes.resize(split);
+    }
+  }
+
+ private:
+  void add_estimate(const ScheduledNode &scheduled_node)
+  {
+    if (scheduled_node.estimated_run_time.count() > 0) {
+      estimated_run_time_ += scheduled_node.estimated_run_time;
+      nodes_with_estimate_num_++;
+    }
+  }
+
+  void remove_estimate(const ScheduledNode &scheduled_node)
+  {
+    if (scheduled_node.estimated_run_time.count() > 0) {
+      estimated_run_time_ -= scheduled_node.estimated_run_time;
+      nodes_with_estimate_num_--;
+    }
   }
 };
 
@@ -808,15 +885,22 @@ class Executor {
 
   void run_task(CurrentTask &current_task, const LocalData &local_data)
   {
-    while (const FunctionNode *node = current_task.scheduled_nodes.pop_next_node()) {
+    while (true) {
+      this->push_expensive_nodes_to_task_pool(current_task);
+      const FunctionNode *node = current_task.scheduled_nodes.pop_next_node();
+      if (node == nullptr) {
+        break;
+      }
       if (current_task.scheduled_nodes.is_empty()) {
         current_task.has_scheduled_nodes.store(false, std::memory_order_relaxed);
       }
       this->run_node_task(*node, current_task, local_data);
 
       /* If there are many nodes scheduled at the same time, it's beneficial to let multiple
-       * threads work on those. */
-      if (current_task.scheduled_nodes.nodes_num() > 128) {
+       * threads work on those. Nodes that are known to be cheap are run on the current thread. */
+      if (current_task.scheduled_nodes.nodes_num() > 128 &&
+          current_task.scheduled_nodes.is_worth_splitting())
+      {
         if (this->try_enable_multi_threading()) {
           std::unique_ptr<ScheduledNodes> split_nodes = std::make_unique<ScheduledNodes>();
           current_task.scheduled_nodes.split_into(*split_nodes);
@@ -826,6 +910,26 @@ class Executor {
     }
   }
 
+  /**
+   * Start nodes that are estimated to take long in separate tasks, so that independent expensive
+   * parts of the graph are computed in parallel. At least one node stays on the current thread.
+   */
+  void push_expensive_nodes_to_task_pool(CurrentTask &current_task)
+  {
+    ScheduledNodes &scheduled_nodes = current_task.scheduled_nodes;
+    if (scheduled_nodes.expensive_nodes_num() == 0 || scheduled_nodes.nodes_num() <= 1) {
+      return;
+    }
+    if (!this->try_enable_multi_threading()) {
+      return;
+    }
+    while (scheduled_nodes.expensive_nodes_num() > 0 && scheduled_nodes.nodes_num() > 1) {
+      std::unique_ptr<ScheduledNodes> task_nodes = std::make_unique<ScheduledNodes>();
+      task_nodes->schedule(*scheduled_nodes.pop_expensive_node(), false);
+      this->push_to_task_pool(std::move(task_nodes));
+    }
+  }
+
   void run_node_task(const FunctionNode &node,
                      CurrentTask &current_task,
                      const LocalData &local_data)
@@ -1267,7 +1371,7 @@ class Executor {
       if (current_task.scheduled_nodes.is_empty()) {
         return;
       }
-      *scheduled_nodes = std::move(current_task.scheduled_nodes);
+      *scheduled_nodes = std::exchange(current_task.scheduled_nodes, {});
       current_task.has_scheduled_nodes.store(false, std::memory_order_relaxed);
     }
     this->push_to_task_pool(std::move(scheduled_nodes));
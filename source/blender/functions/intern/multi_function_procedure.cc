@@ -228,6 +228,54 @@ ReturnInstruction &Procedure::new_return_instruction()
   return instruction;
 }
 
+void Procedure::remove_instruction(Instruction &instruction)
+{
+  BLI_assert(instruction.prev_.is_empty());
+  BLI_assert(entry_ != &instruction);
+  switch (instruction.type_) {
+    case InstructionType::Call: {
+      CallInstruction &call_instr = static_cast<CallInstruction &>(instruction);
+      call_instr.set_next(nullptr);
+      for (const int param_index : call_instr.params_.index_range()) {
+        call_instr.set_param_variable(param_index, nullptr);
+      }
+      call_instructions_.remove_first_occurrence_and_reorder(&call_instr);
+      call_instr.~CallInstruction();
+      break;
+    }
+    case InstructionType::Branch: {
+      BranchInstruction &branch_instr = static_cast<BranchInstruction &>(instruction);
+      branch_instr.set_condition(nullptr);
+      branch_instr.set_branch_true(nullptr);
+      branch_instr.set_branch_false(nullptr);
+      branch_instructions_.remove_first_occurrence_and_reorder(&branch_instr);
+      branch_instr.~BranchInstruction();
+      break;
+    }
+    case InstructionType::Destruct: {
+      DestructInstruction &destruct_instr = static_cast<DestructInstruction &>(instruction);
+      destruct_instr.set_variable(nullptr);
+      destruct_instr.set_next(nullptr);
+      destruct_instructions_.remove_first_occurrence_and_reorder(&destruct_instr);
+      destruct_instr.~DestructInstruction();
+      break;
+    }
+    case InstructionType::Dummy: {
+      DummyInstruction &dummy_instr = static_cast<DummyInstruction &>(instruction);
+      dummy_instr.set_next(nullptr);
+      dummy_instructions_.remove_first_occurrence_and_reorder(&dummy_instr);
+      dummy_instr.~DummyInstruction();
+      break;
+    }
+    case InstructionType::Return: {
+      ReturnInstruction &return_instr = static_cast<ReturnInstruction &>(instruction);
+      return_instructions_.remove_first_occurrence_and_reorder(&return_instr);
+      return_instr.~ReturnInstruction();
+      break;
+    }
+  }
+}
+
 void Procedure::add_parameter(ParamType::InterfaceType interface_type, Variable &variable)
 {
   params_.append({interface_type, &variable});
@@ -148,8 +148,17 @@ class ValueAllocator : NonCopyable, NonMovable {
   Stack<void *> small_single_value_free_list_;
   Map<const CPPType *, Stack<void *>> single_value_free_lists_;
 
+  /**
+   * Number of elements that all span buffers have space for. This makes buffers reusable when the
+   * procedure is executed on multiple chunks with different sizes.
+   */
+  int64_t span_buffer_size_;
+
  public:
-  ValueAllocator(LinearAllocator<> &linear_allocator) : linear_allocator_(linear_allocator) {}
+  ValueAllocator(LinearAllocator<> &linear_allocator, const int64_t span_buffer_size)
+      : linear_allocator_(linear_allocator), span_buffer_size_(span_buffer_size)
+  {
+  }
 
   VariableValue_GVArray *obtain_GVArray(const GVArray &varray)
   {
@@ -168,6 +177,7 @@ class ValueAllocator : NonCopyable, NonMovable {
 
   VariableValue_Span *obtain_Span(const CPPType &type, int size)
   {
+    BLI_assert(size <= span_buffer_size_);
     void *buffer = nullptr;
 
     const int64_t element_size = type.size();
@@ -184,7 +194,8 @@ class ValueAllocator : NonCopyable, NonMovable {
                                  span_buffers_free_lists_.lookup_ptr(element_size);
       if (stack == nullptr || stack->is_empty()) {
         buffer = linear_allocator_.allocate(
-            std::max<int64_t>(element_size, small_value_max_size) * size, min_alignment);
+            std::max<int64_t>(element_size, small_value_max_size) * span_buffer_size_,
+            min_alignment);
       }
       else {
         /* Reuse existing buffer. */
@@ -813,17 +824,17 @@ class VariableState : NonCopyable, NonMovable {
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  ValueAllocator &value_allocator_;
   const Procedure &procedure_;
   /** The state of every variable, indexed by #Variable::index_in_procedure(). */
   Array<VariableState> variable_states_;
   const IndexMask &full_mask_;
 
  public:
-  VariableStates(LinearAllocator<> &linear_allocator,
+  VariableStates(ValueAllocator &value_allocator,
                  const Procedure &procedure,
                  const IndexMask &full_mask)
-      : value_allocator_(linear_allocator),
+      : value_allocator_(value_allocator),
         procedure_(procedure),
         variable_states_(procedure.variables().size()),
         full_mask_(full_mask)
@@ -1157,19 +1168,18 @@ class InstructionScheduler {
   }
 };
 
-void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+static void execute_procedure(const ProcedureExecutor &fn,
+                              const Procedure &procedure,
+                              const IndexMask &full_mask,
+                              Params params,
+                              const Context &context,
+                              ValueAllocator &value_allocator)
 {
-  BLI_assert(procedure_.validate());
-
-  AlignedBuffer<512, 64> local_buffer;
-  LinearAllocator<> linear_allocator;
-  linear_allocator.provide_buffer(local_buffer);
-
-  VariableStates variable_states{linear_allocator, procedure_, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  VariableStates variable_states{value_allocator, procedure, full_mask};
+  variable_states.add_initial_variable_states(fn, procedure, params);
 
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (!scheduler.is_done()) {
@@ -1218,9 +1228,9 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
     }
   }
 
-  for (const int param_index : this->param_indices()) {
-    const ParamType param_type = this->param_type(param_index);
-    const Variable *variable = procedure_.params()[param_index].variable;
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    const Variable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case ParamType::Input: {
@@ -1241,6 +1251,86 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
   }
 }
 
+/**
+ * Executing the procedure on chunks of indices one after another keeps the buffers of all
+ * intermediate variables small enough to stay in the CPU cache. They are reused for every chunk.
+ */
+static constexpr int64_t chunk_size = 4096;
+
+static bool supports_chunked_execution(const MultiFunction &fn)
+{
+  for (const int param_index : fn.param_indices()) {
+    if (fn.param_type(param_index).data_type().is_vector()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+{
+  BLI_assert(procedure_.validate());
+
+  AlignedBuffer<512, 64> local_buffer;
+  LinearAllocator<> linear_allocator;
+  linear_allocator.provide_buffer(local_buffer);
+
+  if (full_mask.size() <= chunk_size || !supports_chunked_execution(*this)) {
+    ValueAllocator value_allocator{linear_allocator, full_mask.min_array_size()};
+    execute_procedure(*this, procedure_, full_mask, params, context, value_allocator);
+    return;
+  }
+
+  const int64_t chunks_num = (full_mask.size() + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * chunk_size;
+    return IndexRange(start, std::min(chunk_size, full_mask.size() - start));
+  };
+
+  /* The indices of every chunk are shifted to start at zero. Buffers are allocated for the
+   * largest chunk, which is only larger than #chunk_size if the mask has gaps. */
+  int64_t max_chunk_array_size = 0;
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const IndexRange bounds = full_mask.slice(chunk_range(chunk)).bounds();
+    max_chunk_array_size = std::max(max_chunk_array_size, bounds.size());
+  }
+  ValueAllocator value_allocator{linear_allocator, max_chunk_array_size};
+
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const IndexRange mask_range = chunk_range(chunk);
+    const IndexRange bounds = full_mask.slice(mask_range).bounds();
+    IndexMaskMemory memory;
+    const IndexMask chunk_mask = full_mask.slice_and_shift(mask_range, -bounds.start(), memory);
+
+    ParamsBuilder chunk_params{*this, &chunk_mask};
+    for (const int param_index : this->param_indices()) {
+      switch (this->param_type(param_index).category()) {
+        case ParamCategory::SingleInput: {
+          chunk_params.add_readonly_single_input(
+              params.readonly_single_input(param_index).slice(bounds));
+          break;
+        }
+        case ParamCategory::SingleMutable: {
+          chunk_params.add_single_mutable(params.single_mutable(param_index).slice(bounds));
+          break;
+        }
+        case ParamCategory::SingleOutput: {
+          chunk_params.add_uninitialized_single_output(
+              params.uninitialized_single_output(param_index).slice(bounds));
+          break;
+        }
+        case ParamCategory::VectorInput:
+        case ParamCategory::VectorMutable:
+        case ParamCategory::VectorOutput: {
+          BLI_assert_unreachable();
+          break;
+        }
+      }
+    }
+    execute_procedure(*this, procedure_, chunk_mask, chunk_params, context, value_allocator);
+  }
+}
+
 MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
@@ -2,6 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+#include <limits>
+
+#include "BLI_array.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_set.hh"
+
 #include "FN_multi_function_procedure_optimization.hh"
 
 namespace blender::fn::multi_function::procedure_optimization {
@@ -74,4 +81,392 @@ void move_destructs_up(Procedure &procedure, Instruction &block_end_instr)
   }
 }
 
+namespace {
+
+/** A call within a #FusedCallsFunction. */
+struct FusedCall {
+  const MultiFunction *fn;
+  /**
+   * For every parameter of the function, the index of the value that is passed in. Indices below
+   * the number of parameters of the fused function refer to those parameters, larger indices
+   * refer to temporary values. -1 is used for ignored outputs.
+   */
+  Vector<int> value_indices;
+};
+
+/**
+ * Evaluates multiple functions one after another on small chunks of the mask. Temporary values
+ * that are only used between the functions are stored in buffers that are only as large as a
+ * chunk.
+ */
+class FusedCallsFunction : public MultiFunction {
+ private:
+  /** Small enough that the temporary values of a chunk usually stay in the CPU cache. */
+  static constexpr int64_t chunk_size = 1024;
+
+  Signature signature_;
+  /** The inputs come before the outputs in the parameters. */
+  int inputs_num_;
+  Vector<const CPPType *> temporary_types_;
+  Vector<FusedCall> calls_;
+
+ public:
+  FusedCallsFunction(const Span<ParamType> param_types,
+                     const int inputs_num,
+                     Vector<const CPPType *> temporary_types,
+                     Vector<FusedCall> calls)
+      : inputs_num_(inputs_num),
+        temporary_types_(std::move(temporary_types)),
+        calls_(std::move(calls))
+  {
+    SignatureBuilder builder("Fused Calls", signature_);
+    for (const ParamType &param_type : param_types) {
+      builder.add("Parameter", param_type);
+    }
+    this->set_signature(&signature_);
+  }
+
+  void call(const IndexMask &mask, Params params, Context context) const override
+  {
+    const int params_num = signature_.params.size();
+
+    LinearAllocator<> allocator;
+    Array<void *> temporary_buffers(temporary_types_.size(), nullptr);
+    int64_t temporary_buffer_size = 0;
+
+    for (int64_t chunk_start = 0; chunk_start < mask.size(); chunk_start += chunk_size) {
+      const IndexRange chunk(chunk_start, std::min(chunk_size, mask.size() - chunk_start));
+      /* Shift the indices of the chunk so that the temporary buffers can start at zero. */
+      const IndexRange range = mask.slice(chunk).bounds();
+      IndexMaskMemory memory;
+      const IndexMask shifted_mask = mask.slice_and_shift(chunk, -range.start(), memory);
+
+      if (range.size() > temporary_buffer_size) {
+        /* The range is only larger than the chunk when the mask has gaps. */
+        temporary_buffer_size = range.size();
+        for (const int i : temporary_types_.index_range()) {
+          const CPPType &type = *temporary_types_[i];
+          temporary_buffers[i] = allocator.allocate(type.size() * temporary_buffer_size,
+                                                    type.alignment());
+        }
+      }
+
+      for (const FusedCall &fused_call : calls_) {
+        const MultiFunction &fn = *fused_call.fn;
+        ParamsBuilder call_params{fn, &shifted_mask};
+        for (const int param_index : fn.param_indices()) {
+          const ParamType param_type = fn.param_type(param_index);
+          const int value_index = fused_call.value_indices[param_index];
+          if (value_index == -1) {
+            call_params.add_ignored_single_output();
+            continue;
+          }
+          const bool is_param = value_index < params_num;
+          const CPPType &type = param_type.data_type().single_type();
+          if (param_type.interface_type() == ParamType::Input) {
+            if (is_param && value_index >= inputs_num_) {
+              /* The output has been computed by a previous call already. */
+              call_params.add_readonly_single_input(
+                  GSpan(params.uninitialized_single_output(value_index).slice(range)));
+            }
+            else if (is_param) {
+              call_params.add_readonly_single_input(
+                  params.readonly_single_input(value_index).slice(range));
+            }
+            else {
+              call_params.add_readonly_single_input(
+                  GSpan(type, temporary_buffers[value_index - params_num], range.size()));
+            }
+          }
+          else {
+            if (is_param) {
+              call_params.add_uninitialized_single_output(
+                  params.uninitialized_single_output(value_index).slice(range));
+            }
+            else {
+              call_params.add_uninitialized_single_output(
+                  GMutableSpan(type, temporary_buffers[value_index - params_num], range.size()));
+            }
+          }
+        }
+        fn.call(shifted_mask, call_params, context);
+      }
+
+      for (const int i : temporary_types_.index_range()) {
+        temporary_types_[i]->destruct_indices(temporary_buffers[i], shifted_mask);
+      }
+    }
+  }
+
+ private:
+  ExecutionHints get_execution_hints() const override
+  {
+    ExecutionHints hints;
+    hints.min_grain_size = std::numeric_limits<int64_t>::max();
+    for (const FusedCall &fused_call : calls_) {
+      const ExecutionHints call_hints = fused_call.fn->execution_hints();
+      hints.min_grain_size = std::min(hints.min_grain_size, call_hints.min_grain_size);
+      hints.uniform_execution_time &= call_hints.uniform_execution_time;
+    }
+    return hints;
+  }
+};
+
+}  // namespace
+
+static bool call_can_be_fused(const CallInstruction &call_instr)
+{
+  const MultiFunction &fn = call_instr.fn();
+  bool has_input = false;
+  for (const int param_index : fn.param_indices()) {
+    switch (fn.param_type(param_index).category()) {
+      case ParamCategory::SingleInput:
+        has_input = true;
+        break;
+      case ParamCategory::SingleOutput:
+        break;
+      default:
+        return false;
+    }
+  }
+  return has_input;
+}
+
+static Instruction *next_instruction(Instruction &instr)
+{
+  switch (instr.type()) {
+    case InstructionType::Call:
+      return static_cast<CallInstruction &>(instr).next();
+    case InstructionType::Destruct:
+      return static_cast<DestructInstruction &>(instr).next();
+    default:
+      BLI_assert_unreachable();
+      return nullptr;
+  }
+}
+
+static void set_next_instruction(Procedure &procedure, Instruction &instr, Instruction *next)
+{
+  switch (instr.type()) {
+    case InstructionType::Call:
+      InstructionCursor(static_cast<CallInstruction &>(instr)).set_next(procedure, next);
+      break;
+    case InstructionType::Destruct:
+      InstructionCursor(static_cast<DestructInstruction &>(instr)).set_next(procedure, next);
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+/**
+ * Replace a chain of call and destruct instructions with a single call to a #FusedCallsFunction,
+ * followed by the destruct instructions of variables that were created before the chain.
+ */
+static void fuse_instructions(Procedure &procedure, const Span<Instruction *> instructions)
+{
+  Set<Variable *> created_variables;
+  Set<Variable *> destructed_variables;
+  for (Instruction *instr : instructions) {
+    if (instr->type() == InstructionType::Call) {
+      CallInstruction &call_instr = static_cast<CallInstruction &>(*instr);
+      const MultiFunction &fn = call_instr.fn();
+      for (const int param_index : fn.param_indices()) {
+        Variable *variable = call_instr.params()[param_index];
+        if (variable != nullptr && fn.param_type(param_index).interface_type() == ParamType::Output)
+        {
+          created_variables.add(variable);
+        }
+      }
+    }
+    else {
+      destructed_variables.add(static_cast<DestructInstruction &>(*instr).variable());
+    }
+  }
+
+  /* Variables that are created and destructed within the chain become temporary values, all
+   * other variables become inputs or outputs of the fused function. */
+  Vector<Variable *> input_variables;
+  Vector<Variable *> output_variables;
+  Vector<Variable *> temporary_variables;
+  Vector<CallInstruction *> call_instructions;
+  Vector<DestructInstruction *> internal_destructs;
+  Vector<DestructInstruction *> remaining_destructs;
+  for (Instruction *instr : instructions) {
+    if (instr->type() == InstructionType::Destruct) {
+      DestructInstruction &destruct_instr = static_cast<DestructInstruction &>(*instr);
+      if (created_variables.contains(destruct_instr.variable())) {
+        internal_destructs.append(&destruct_instr);
+      }
+      else {
+        remaining_destructs.append(&destruct_instr);
+      }
+      continue;
+    }
+    CallInstruction &call_instr = static_cast<CallInstruction &>(*instr);
+    call_instructions.append(&call_instr);
+    for (Variable *variable : call_instr.params()) {
+      if (variable == nullptr) {
+        continue;
+      }
+      if (!created_variables.contains(variable)) {
+        input_variables.append_non_duplicates(variable);
+      }
+      else if (destructed_variables.contains(variable)) {
+        temporary_variables.append_non_duplicates(variable);
+      }
+      else {
+        output_variables.append_non_duplicates(variable);
+      }
+    }
+  }
+
+  Vector<Variable *> param_variables;
+  Vector<ParamType> param_types;
+  Map<const Variable *, int> value_indices;
+  for (Variable *variable : input_variables) {
+    value_indices.add_new(variable, int(param_variables.size()));
+    param_variables.append(variable);
+    param_types.append(ParamType(ParamType::Input, variable->data_type()));
+  }
+  for (Variable *variable : output_variables) {
+    value_indices.add_new(variable, int(param_variables.size()));
+    param_variables.append(variable);
+    param_types.append(ParamType(ParamType::Output, variable->data_type()));
+  }
+  Vector<const CPPType *> temporary_types;
+  for (Variable *variable : temporary_variables) {
+    value_indices.add_new(variable, int(param_variables.size() + temporary_types.size()));
+    temporary_types.append(&variable->data_type().single_type());
+  }
+
+  Vector<FusedCall> fused_calls;
+  for (CallInstruction *call_instr : call_instructions) {
+    FusedCall fused_call;
+    fused_call.fn = &call_instr->fn();
+    for (const Variable *variable : call_instr->params()) {
+      fused_call.value_indices.append(variable ? value_indices.lookup(variable) : -1);
+    }
+    fused_calls.append(std::move(fused_call));
+  }
+
+  const MultiFunction &fused_fn = procedure.construct_function<FusedCallsFunction>(
+      param_types,
+      int(input_variables.size()),
+      std::move(temporary_types),
+      std::move(fused_calls));
+  CallInstruction &fused_instr = procedure.new_call_instruction(fused_fn);
+  fused_instr.set_params(param_variables);
+
+  /* Replace the chain with the new call and the remaining destruct instructions. */
+  Instruction &first_instr = *instructions.first();
+  Instruction *after_instr = next_instruction(*instructions.last());
+  while (!first_instr.prev().is_empty()) {
+    /* Copy the cursor, because the previous instructions change when #set_next is called. */
+    const InstructionCursor cursor = first_instr.prev()[0];
+    cursor.set_next(procedure, &fused_instr);
+  }
+  for (Instruction *instr : instructions) {
+    set_next_instruction(procedure, *instr, nullptr);
+  }
+  Instruction *last_instr = &fused_instr;
+  for (DestructInstruction *destruct_instr : remaining_destructs) {
+    set_next_instruction(procedure, *last_instr, destruct_instr);
+    last_instr = destruct_instr;
+  }
+  set_next_instruction(procedure, *last_instr, after_instr);
+
+  for (CallInstruction *call_instr : call_instructions) {
+    procedure.remove_instruction(*call_instr);
+  }
+  for (DestructInstruction *destruct_instr : internal_destructs) {
+    procedure.remove_instruction(*destruct_instr);
+  }
+}
+
+void fuse_element_wise_calls(Procedure &procedure, Instruction &block_end_instr)
+{
+  /* Gather the linear chain of instructions that ends at the given instruction. */
+  Vector<Instruction *> chain;
+  Instruction *current_instr = &block_end_instr;
+  while (current_instr != nullptr) {
+    chain.append(current_instr);
+    const Span<InstructionCursor> prev_cursors = current_instr->prev();
+    if (prev_cursors.size() != 1) {
+      /* Stop when there is some branching before this instruction. */
+      break;
+    }
+    current_instr = prev_cursors[0].instruction();
+  }
+  std::reverse(chain.begin(), chain.end());
+
+  /* Consecutive call and destruct instructions that are fused together. */
+  Vector<Instruction *> group;
+  int group_calls_num = 0;
+  Set<const Variable *> group_variables;
+  Set<const Variable *> group_destructed_variables;
+
+  const auto finish_group = [&]() {
+    if (group_calls_num >= 2) {
+      fuse_instructions(procedure, group);
+    }
+    group.clear();
+    group_calls_num = 0;
+    group_variables.clear();
+    group_destructed_variables.clear();
+  };
+
+  for (Instruction *instr : chain) {
+    switch (instr->type()) {
+      case InstructionType::Call: {
+        CallInstruction &call_instr = static_cast<CallInstruction &>(*instr);
+        if (!call_can_be_fused(call_instr)) {
+          finish_group();
+          break;
+        }
+        const MultiFunction &fn = call_instr.fn();
+        bool is_compatible = true;
+        for (const int param_index : fn.param_indices()) {
+          const Variable *variable = call_instr.params()[param_index];
+          if (variable == nullptr) {
+            continue;
+          }
+          /* Variables that are initialized again after they have been destructed, or that are
+           * written more than once, can't be represented by a single value in a fused call. */
+          if (group_destructed_variables.contains(variable) ||
+              (fn.param_type(param_index).interface_type() == ParamType::Output &&
+               group_variables.contains(variable)))
+          {
+            is_compatible = false;
+          }
+        }
+        if (!is_compatible) {
+          finish_group();
+        }
+        group.append(instr);
+        group_calls_num++;
+        for (const Variable *variable : call_instr.params()) {
+          if (variable != nullptr) {
+            group_variables.add(variable);
+          }
+        }
+        break;
+      }
+      case InstructionType::Destruct: {
+        if (!group.is_empty()) {
+          group.append(instr);
+          group_destructed_variables.add(static_cast<DestructInstruction &>(*instr).variable());
+        }
+        break;
+      }
+      default: {
+        finish_group();
+        break;
+      }
+    }
+  }
+  finish_group();
+}
+
 }  // namespace blender::fn::multi_function::procedure_optimization
@@ -281,4 +281,77 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+/** Computes operations with the given function by evaluating them element by element. */
+class TestEvaluationBackend : public FieldEvaluationBackend {
+ public:
+  const mf::MultiFunction *supported_fn = nullptr;
+  bool fail = false;
+  mutable int evaluated_num = 0;
+
+  bool supports(const GFieldRef &field, const IndexMask & /*mask*/) const override
+  {
+    return field.node().node_type() == FieldNodeType::Operation &&
+           &static_cast<const FieldOperation &>(field.node()).multi_function() == supported_fn;
+  }
+
+  bool evaluate(ResourceScope &scope,
+                const GFieldRef &field,
+                const IndexMask &mask,
+                const FieldContext &context,
+                GMutableSpan dst) const override
+  {
+    evaluated_num++;
+    if (fail) {
+      return false;
+    }
+    const FieldOperation &operation = static_cast<const FieldOperation &>(field.node());
+    Vector<GFieldRef> inputs;
+    for (const GField &input : operation.inputs()) {
+      inputs.append(input);
+    }
+    const Vector<GVArray> input_values = evaluate_fields(scope, inputs, mask, context);
+    const VArray<int> a = input_values[0].typed<int>();
+    const VArray<int> b = input_values[1].typed<int>();
+    MutableSpan<int> result = dst.typed<int>();
+    mask.foreach_index([&](const int i) { result[i] = 2 * (a[i] + b[i]); });
+    return true;
+  }
+};
+
+TEST(field, EvaluationBackend)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  GField output_field{FieldOperation::Create(add_fn, {index_field, index_field}), 0};
+
+  TestEvaluationBackend backend;
+  backend.supported_fn = &add_fn;
+  set_field_evaluation_backend(&backend);
+
+  FieldContext context;
+  {
+    Array<int> result(4);
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add_with_destination(output_field, result.as_mutable_span());
+    evaluator.evaluate();
+    EXPECT_EQ(backend.evaluated_num, 1);
+    /* The backend computes a different result to make sure that it was used. */
+    EXPECT_EQ(result[1], 4);
+    EXPECT_EQ(result[3], 12);
+  }
+  {
+    /* The procedure is used when the backend fails. */
+    backend.fail = true;
+    Array<int> result(4);
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add_with_destination(output_field, result.as_mutable_span());
+    evaluator.evaluate();
+    EXPECT_EQ(backend.evaluated_num, 2);
+    EXPECT_EQ(result[1], 2);
+    EXPECT_EQ(result[3], 6);
+  }
+
+  set_field_evaluation_backend(nullptr);
+}
+
 }  // namespace blender::fn::tests
@@ -7,6 +7,7 @@
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_procedure_builder.hh"
 #include "FN_multi_function_procedure_executor.hh"
+#include "FN_multi_function_procedure_optimization.hh"
 #include "FN_multi_function_test_common.hh"
 
 namespace blender::fn::multi_function::tests {
@@ -423,4 +424,161 @@ TEST(multi_function_procedure, OutputBufferReplaced)
   EXPECT_EQ(output[2], output_value);
 }
 
+TEST(multi_function_procedure, ChunkedExecution)
+{
+  /**
+   * procedure(int &var1, int var2, int *var4) {
+   *   int var3 = var1 * var2;
+   *   if (var2 > 2) {
+   *     var1 += 100;
+   *   }
+   *   var4 = var3 + var1;
+   * }
+   */
+
+  auto mul_fn = build::SI2_SO<int, int, int>("mul", [](int a, int b) { return a * b; });
+  auto add_fn = build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  auto greater_fn = build::SI1_SO<int, bool>("greater", [](int a) { return a > 2; });
+  auto add_100_fn = build::SM<int>("add_100", [](int &a) { a += 100; });
+
+  Procedure procedure;
+  ProcedureBuilder builder{procedure};
+
+  Variable *var1 = &builder.add_single_mutable_parameter<int>();
+  Variable *var2 = &builder.add_single_input_parameter<int>();
+  auto [var3] = builder.add_call<1>(mul_fn, {var1, var2});
+  auto [var_cond] = builder.add_call<1>(greater_fn, {var2});
+  ProcedureBuilder::Branch branch = builder.add_branch(*var_cond);
+  branch.branch_true.add_call(add_100_fn, {var1});
+  builder.set_cursor_after_branch(branch);
+  auto [var4] = builder.add_call<1>(add_fn, {var3, var1});
+  builder.add_destruct({var2, var3, var_cond});
+  builder.add_return();
+  builder.add_output_parameter(*var4);
+
+  EXPECT_TRUE(procedure.validate());
+
+  ProcedureExecutor procedure_fn{procedure};
+
+  /* Use a mask with gaps that is large enough to be executed in multiple chunks. */
+  const int size = 50000;
+  Array<int> values_1(size);
+  Array<int> values_2(size);
+  for (const int i : IndexRange(size)) {
+    values_1[i] = i;
+    values_2[i] = i % 5;
+  }
+  Array<int> results(size, -1);
+
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(1024), memory, [](const int64_t i) { return i % 4 != 1; });
+  ParamsBuilder params{procedure_fn, &mask};
+  params.add_single_mutable(values_1.as_mutable_span());
+  params.add_readonly_single_input(values_2.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  ContextBuilder context;
+  procedure_fn.call(mask, params, context);
+
+  for (const int i : IndexRange(size)) {
+    if (i % 4 == 1) {
+      EXPECT_EQ(values_1[i], i);
+      EXPECT_EQ(results[i], -1);
+    }
+    else {
+      const int value_1 = i % 5 > 2 ? i + 100 : i;
+      EXPECT_EQ(values_1[i], value_1);
+      EXPECT_EQ(results[i], i * (i % 5) + value_1);
+    }
+  }
+}
+
+TEST(multi_function_procedure, FuseElementWiseCalls)
+{
+  /**
+   * procedure(int a, int b, int *out_1, int *out_2) {
+   *   int c = 5;
+   *   int d = a * b;
+   *   int e = d + c;
+   *   out_1 = e * 2;
+   *   out_2 = e + b;
+   * }
+   */
+
+  CustomMF_Constant<int> constant_fn{5};
+  auto add_fn = build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  auto mul_fn = build::SI2_SO<int, int, int>("mul", [](int a, int b) { return a * b; });
+  auto double_fn = build::SI1_SO<int, int>("double", [](int a) { return a * 2; });
+
+  Procedure procedure;
+  ProcedureBuilder builder{procedure};
+
+  Variable *var_a = &builder.add_single_input_parameter<int>();
+  Variable *var_b = &builder.add_single_input_parameter<int>();
+  auto [var_c] = builder.add_call<1>(constant_fn);
+  auto [var_d] = builder.add_call<1>(mul_fn, {var_a, var_b});
+  auto [var_e] = builder.add_call<1>(add_fn, {var_d, var_c});
+  auto [var_out_1] = builder.add_call<1>(double_fn, {var_e});
+  auto [var_out_2] = builder.add_call<1>(add_fn, {var_e, var_b});
+  builder.add_destruct({var_a, var_b, var_c, var_d, var_e});
+  ReturnInstruction &return_instr = builder.add_return();
+  builder.add_output_parameter(*var_out_1);
+  builder.add_output_parameter(*var_out_2);
+
+  procedure_optimization::move_destructs_up(procedure, return_instr);
+  procedure_optimization::fuse_element_wise_calls(procedure, return_instr);
+  EXPECT_TRUE(procedure.validate());
+
+  /* The constant is computed separately, all other calls are fused into one. */
+  int calls_num = 0;
+  for (const Instruction *instr = procedure.entry(); instr->type() != InstructionType::Return;) {
+    if (instr->type() == InstructionType::Call) {
+      calls_num++;
+      instr = static_cast<const CallInstruction *>(instr)->next();
+    }
+    else {
+      instr = static_cast<const DestructInstruction *>(instr)->next();
+    }
+  }
+  EXPECT_EQ(calls_num, 2);
+
+  ProcedureExecutor procedure_fn{procedure};
+
+  /* Use a mask with gaps that is split into multiple chunks. */
+  const int size = 10000;
+  Array<int> inputs_a(size);
+  Array<int> inputs_b(size);
+  for (const int i : IndexRange(size)) {
+    inputs_a[i] = i;
+    inputs_b[i] = i % 7;
+  }
+  Array<int> results_1(size, -1);
+  Array<int> results_2(size, -1);
+
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(1024), memory, [](const int64_t i) { return i % 3 != 0; });
+  ParamsBuilder params{procedure_fn, &mask};
+  params.add_readonly_single_input(inputs_a.as_span());
+  params.add_readonly_single_input(inputs_b.as_span());
+  params.add_uninitialized_single_output(results_1.as_mutable_span());
+  params.add_uninitialized_single_output(results_2.as_mutable_span());
+
+  ContextBuilder context;
+  procedure_fn.call(mask, params, context);
+
+  for (const int i : IndexRange(size)) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(results_1[i], -1);
+      EXPECT_EQ(results_2[i], -1);
+    }
+    else {
+      const int e = inputs_a[i] * inputs_b[i] + 5;
+      EXPECT_EQ(results_1[i], e * 2);
+      EXPECT_EQ(results_2[i], e + inputs_b[i]);
+    }
+  }
+}
+
 }  // namespace blender::fn::multi_function::tests
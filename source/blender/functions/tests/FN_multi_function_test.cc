@@ -255,5 +255,36 @@ TEST(multi_function, IgnoredOutputs)
   }
 }
 
+TEST(multi_function, DevirtualizedSparseMask)
+{
+  static auto fn = build::SI2_SO<float, float, float>(
+      "Multiply Add",
+      [](const float a, const float b) { return a * b + 1.0f; },
+      build::exec_presets::AllSpanOrSingle());
+
+  const int size = 1000;
+  Array<float> input(size);
+  for (const int i : input.index_range()) {
+    input[i] = float(i);
+  }
+  Array<float> output(size, -1.0f);
+
+  /* Every third index, so that the mask is not converted to ranges. */
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(4096), memory, [](const int64_t i) { return i % 3 == 0; });
+
+  ParamsBuilder params(fn, &mask);
+  params.add_readonly_single_input(input.as_span());
+  params.add_readonly_single_input_value(2.0f);
+  params.add_uninitialized_single_output(output.as_mutable_span());
+  ContextBuilder context;
+  fn.call(mask, params, context);
+
+  for (const int i : output.index_range()) {
+    EXPECT_EQ(output[i], (i % 3 == 0) ? float(i) * 2.0f + 1.0f : -1.0f);
+  }
+}
+
 }  // namespace
 }  // namespace blender::fn::multi_function::tests
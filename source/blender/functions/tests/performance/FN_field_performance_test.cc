@@ -0,0 +1,180 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_threads.h"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+#include "FN_field.hh"
+#include "FN_multi_function_builder.hh"
+
+#ifdef WITH_TBB
+#  include <tbb/task_arena.h>
+#endif
+
+/**
+ * Measures the throughput of field evaluation for different numbers of elements and threads. The
+ * results are printed as a table with the elements processed per second and the speedup compared
+ * to a single thread, so that regressions in specific parts of the evaluation are easy to spot.
+ *
+ * The largest size is only used when `USE_BIG_TESTS` is defined.
+ */
+
+// #define USE_BIG_TESTS
+
+namespace blender::fn::tests {
+
+#ifdef USE_BIG_TESTS
+static constexpr int64_t max_elements_num = 100'000'000;
+#else
+static constexpr int64_t max_elements_num = 10'000'000;
+#endif
+
+/** Every measurement is repeated and the fastest run is used, to reduce the noise. */
+static constexpr int repetitions_num = 3;
+
+class IndexFieldInput final : public FieldInput {
+ public:
+  IndexFieldInput() : FieldInput(CPPType::get<int>(), "Index") {}
+
+  GVArray get_varray_for_context(const FieldContext & /*context*/,
+                                 const IndexMask &mask,
+                                 ResourceScope & /*scope*/) const final
+  {
+    return VArray<int>::ForFunc(mask.min_array_size(), [](const int i) { return i; });
+  }
+};
+
+static void run_with_threads(const int threads_num, const FunctionRef<void()> fn)
+{
+#ifdef WITH_TBB
+  tbb::task_arena arena{threads_num};
+  arena.execute(fn);
+#else
+  UNUSED_VARS(threads_num);
+  fn();
+#endif
+}
+
+static Vector<int> get_threads_nums()
+{
+  Vector<int> threads_nums;
+#ifdef WITH_TBB
+  const int max_threads_num = BLI_system_thread_count();
+  for (int threads_num = 1; threads_num < max_threads_num; threads_num *= 2) {
+    threads_nums.append(threads_num);
+  }
+  threads_nums.append(max_threads_num);
+#else
+  threads_nums.append(1);
+#endif
+  return threads_nums;
+}
+
+/**
+ * Run the given evaluation for increasing numbers of elements with every number of threads and
+ * print the throughput.
+ */
+static void measure_throughput(const char *name, const FunctionRef<void(int64_t size)> evaluate)
+{
+  printf("\n========== %s ==========\n", name);
+  printf("%12s %8s %12s %16s %8s\n", "Elements", "Threads", "Time (ms)", "Elements/s", "Speedup");
+  const Vector<int> threads_nums = get_threads_nums();
+  for (int64_t size = 1000; size <= max_elements_num; size *= 10) {
+    double single_thread_seconds = 0.0;
+    for (const int threads_num : threads_nums) {
+      timeit::Nanoseconds best_duration = timeit::Nanoseconds::max();
+      for ([[maybe_unused]] const int i : IndexRange(repetitions_num)) {
+        const timeit::TimePoint start = timeit::Clock::now();
+        run_with_threads(threads_num, [&]() { evaluate(size); });
+        best_duration = std::min(best_duration, timeit::Clock::now() - start);
+      }
+      const double seconds = std::chrono::duration<double>(best_duration).count();
+      if (threads_num == 1) {
+        single_thread_seconds = seconds;
+      }
+      printf("%12lld %8d %12.3f %16.0f %8.2f\n",
+             (long long)size,
+             threads_num,
+             seconds * 1000.0,
+             double(size) / seconds,
+             single_thread_seconds / seconds);
+    }
+  }
+}
+
+/** A field that does a few float operations for every index. */
+static Field<float> create_math_chain_field(const int operations_num)
+{
+  static auto int_to_float = mf::build::SI1_SO<int, float>(
+      "Int to Float", [](const int a) { return float(a); });
+  static auto multiply_add = mf::build::SI2_SO<float, float, float>(
+      "Multiply Add", [](const float a, const float b) { return a * 1.0001f + b; });
+
+  const Field<int> index_field{std::make_shared<IndexFieldInput>()};
+  Field<float> field{FieldOperation::Create(int_to_float, {index_field})};
+  const Field<float> constant_field = make_constant_field<float>(0.5f);
+  for ([[maybe_unused]] const int i : IndexRange(operations_num)) {
+    field = Field<float>(FieldOperation::Create(multiply_add, {field, constant_field}));
+  }
+  return field;
+}
+
+TEST(field_performance, MathChain)
+{
+  const Field<float> field = create_math_chain_field(8);
+  measure_throughput("Math Chain", [&](const int64_t size) {
+    Array<float> result(size);
+    const FieldContext context;
+    FieldEvaluator evaluator{context, size};
+    evaluator.add_with_destination(field, result.as_mutable_span());
+    evaluator.evaluate();
+  });
+}
+
+TEST(field_performance, MathChainSparseSelection)
+{
+  const Field<float> field = create_math_chain_field(8);
+  measure_throughput("Math Chain with Every Third Element", [&](const int64_t size) {
+    IndexMaskMemory memory;
+    const IndexMask mask = IndexMask::from_predicate(
+        IndexRange(size), GrainSize(4096), memory, [](const int64_t i) { return i % 3 == 0; });
+    Array<float> result(size);
+    const FieldContext context;
+    FieldEvaluator evaluator{context, &mask};
+    evaluator.add_with_destination(field, result.as_mutable_span());
+    evaluator.evaluate();
+  });
+}
+
+TEST(field_performance, SharedInputs)
+{
+  static auto add = mf::build::SI2_SO<float, float, float>(
+      "Add", [](const float a, const float b) { return a + b; });
+  const Field<float> shared_field = create_math_chain_field(8);
+  Vector<Field<float>> fields;
+  for (const int i : IndexRange(4)) {
+    fields.append(Field<float>(
+        FieldOperation::Create(add, {shared_field, make_constant_field<float>(float(i))})));
+  }
+  measure_throughput("Four Outputs with a Shared Input", [&](const int64_t size) {
+    Array<Array<float>> results(fields.size(), Array<float>(size));
+    const FieldContext context;
+    FieldEvaluator evaluator{context, size};
+    for (const int i : fields.index_range()) {
+      evaluator.add_with_destination(fields[i], results[i].as_mutable_span());
+    }
+    evaluator.evaluate();
+  });
+}
+
+}  // namespace blender::fn::tests
@@ -527,21 +527,6 @@ static bke::GeometrySet geometry_set_from_reference(const InstanceReference &ref
   return {};
 }
 
-/**
- * Calls #fn for every geometry in the given #InstanceReference. Also passes on the transformation
- * that is applied to every instance.
- */
-static void foreach_geometry_in_reference(
-    const InstanceReference &reference,
-    const float4x4 &base_transform,
-    const uint32_t id,
-    FunctionRef<void(const bke::GeometrySet &geometry_set, const float4x4 &transform, uint32_t id)>
-        fn)
-{
-  bke::GeometrySet geometry_set = geometry_set_from_reference(reference);
-  fn(geometry_set, base_transform, id);
-}
-
 static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
                                                const int current_depth,
                                                const int target_depth,
@@ -572,6 +557,10 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   Vector<std::pair<int, GSpan>> instance_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances, gather_info.instances_attriubutes);
 
+  /* Retrieving the geometry of a reference can be expensive, e.g. for collections, so it is only
+   * done once for every reference instead of once for every instance. */
+  Array<std::optional<bke::GeometrySet>> geometry_by_handle(references.size());
+
   const bool is_top_level = current_depth == 0;
   /* If at top level, get instance indices from selection field, else use all instances. */
   const IndexMask indices = is_top_level ? gather_info.selection :
@@ -581,7 +570,6 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
     const int child_target_depth = is_top_level ? gather_info.depths[i] : target_depth;
     const int handle = handles[i];
     const float4x4 &transform = transforms[i];
-    const InstanceReference &reference = references[handle];
     const float4x4 new_base_transform = base_transform * transform;
 
     /* Update attribute fallbacks for the current instance. */
@@ -609,21 +597,19 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
     }
     const uint32_t instance_id = noise::hash(base_instance_context.id, local_instance_id);
 
+    std::optional<bke::GeometrySet> &instance_geometry_set = geometry_by_handle[handle];
+    if (!instance_geometry_set) {
+      instance_geometry_set = geometry_set_from_reference(references[handle]);
+    }
+
     /* Add realize tasks for all referenced geometry sets recursively. */
-    foreach_geometry_in_reference(reference,
-                                  new_base_transform,
-                                  instance_id,
-                                  [&](const bke::GeometrySet &instance_geometry_set,
-                                      const float4x4 &transform,
-                                      const uint32_t id) {
-                                    instance_context.id = id;
-                                    gather_realize_tasks_recursive(gather_info,
-                                                                   current_depth + 1,
-                                                                   child_target_depth,
-                                                                   instance_geometry_set,
-                                                                   transform,
-                                                                   instance_context);
-                                  });
+    instance_context.id = instance_id;
+    gather_realize_tasks_recursive(gather_info,
+                                   current_depth + 1,
+                                   child_target_depth,
+                                   *instance_geometry_set,
+                                   new_base_transform,
+                                   instance_context);
   });
 }
 
@@ -693,7 +679,10 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
       case bke::GeometryComponent::Type::Instance: {
         if (current_depth == target_depth) {
           gather_info.instances.attribute_fallback.append(base_instance_context.instances);
-          gather_info.instances.instances_components_to_merge.append(component->copy());
+          /* The component is only read, so it can be shared instead of copied. */
+          component->add_user();
+          gather_info.instances.instances_components_to_merge.append(
+              bke::GeometryComponentPtr(const_cast<bke::GeometryComponent *>(component)));
           gather_info.instances.instances_components_transforms.append(base_transform);
         }
         else {
@@ -765,23 +754,31 @@ static bool attribute_foreach(const bke::GeometrySet &geometry_set,
     child_has_component = false;
 
     const Instances &instances = *geometry_set.get_instances();
+    const Span<int> handles = instances.reference_handles();
     const IndexMask indices = 0 == current_depth ?
                                   selection :
                                   IndexMask(IndexRange(instances.instances_num()));
+    /* Many instances usually share the same reference, and visiting it again for the same depth
+     * finds the same attributes. So every reference is only processed once per depth. */
+    Set<std::pair<int, int>> handled_references;
     indices.foreach_index([&](const int i) {
       const int child_depth_target = (0 == current_depth) ? instance_depth[i] : depth_target;
-      bke::GeometrySet instance_geometry_set = geometry_set_from_reference(
-          instances.references()[instances.reference_handles()[i]]);
-      /* Process child instances with a recursive call. */
-      if (current_depth != child_depth_target) {
-        child_has_component = child_has_component | attribute_foreach(instance_geometry_set,
-                                                                      component_types,
-                                                                      current_depth + 1,
-                                                                      child_depth_target,
-                                                                      instance_depth,
-                                                                      selection,
-                                                                      callback);
+      if (current_depth == child_depth_target) {
+        return;
       }
+      if (!handled_references.add({handles[i], child_depth_target})) {
+        return;
+      }
+      const bke::GeometrySet instance_geometry_set = geometry_set_from_reference(
+          instances.references()[handles[i]]);
+      /* Process child instances with a recursive call. */
+      child_has_component = child_has_component | attribute_foreach(instance_geometry_set,
+                                                                    component_types,
+                                                                    current_depth + 1,
+                                                                    child_depth_target,
+                                                                    instance_depth,
+                                                                    selection,
+                                                                    callback);
     });
   }
 
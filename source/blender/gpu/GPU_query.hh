@@ -0,0 +1,37 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Timestamp queries, used to measure the time the GPU spends on the commands recorded between
+ * two timestamps. The results are only available once the GPU reached the timestamps, so they
+ * are usually read a frame later to avoid waiting.
+ */
+
+#pragma once
+
+#include "BLI_span.hh"
+
+struct GPUTimestampPool;
+
+/**
+ * Create a pool of timestamp queries. Returns null when the backend does not support them.
+ */
+GPUTimestampPool *GPU_timestamp_pool_create();
+void GPU_timestamp_pool_free(GPUTimestampPool *pool);
+
+/**
+ * Record the time at which the GPU reaches this point of the command stream.
+ * \return The index of the timestamp in the pool.
+ */
+int GPU_timestamp_pool_record(GPUTimestampPool *pool);
+/** Number of timestamps recorded in the pool. */
+int GPU_timestamp_pool_len(const GPUTimestampPool *pool);
+/**
+ * Get the times of all the timestamps in the pool, in nanoseconds. Only the differences between
+ * timestamps are meaningful.
+ * \note This waits for the GPU to reach the last timestamp.
+ */
+void GPU_timestamp_pool_results(GPUTimestampPool *pool, blender::MutableSpan<uint64_t> r_times);
@@ -944,6 +944,12 @@ int GPU_texture_mip_count(const GPUTexture *texture);
  */
 eGPUTextureFormat GPU_texture_format(const GPUTexture *texture);
 
+/**
+ * Return the size in bytes of all the mip levels and layers of \a texture.
+ * This is an estimate, the driver can add padding or compress the data.
+ */
+size_t GPU_texture_memory_size(const GPUTexture *texture);
+
 /**
  * Return the usage flags of \a tex.
  */
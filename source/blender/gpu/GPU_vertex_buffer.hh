@@ -61,6 +61,8 @@ namespace blender::gpu {
 class VertBuf {
  public:
   static size_t memory_usage;
+  /** Total size of the data uploaded from the host, used to measure the uploads per frame. */
+  static size_t upload_size;
 
   GPUVertFormat format = {};
   /** Number of verts we want to draw. */
@@ -285,6 +287,7 @@ void GPU_vertbuf_update_sub(blender::gpu::VertBuf *verts, uint start, uint len,
 
 /* Metrics */
 uint GPU_vertbuf_get_memory_usage();
+size_t GPU_vertbuf_get_upload_size();
 
 /* Macros */
 #define GPU_VERTBUF_DISCARD_SAFE(verts) \
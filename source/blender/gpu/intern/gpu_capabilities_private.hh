@@ -50,6 +50,7 @@ struct GPUCapabilities {
   bool hdr_viewport_support = false;
   bool texture_view_support = true;
   bool stencil_export_support = false;
+  bool timestamp_query_support = false;
 
   int max_parallel_compilations = 0;
 
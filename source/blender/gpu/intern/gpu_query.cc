@@ -6,8 +6,53 @@
  * \ingroup gpu
  */
 
+#include "MEM_guardedalloc.h"
+
+#include "GPU_query.hh"
+
+#include "gpu_backend.hh"
+#include "gpu_capabilities_private.hh"
 #include "gpu_query.hh"
 
+using namespace blender;
 using namespace blender::gpu;
 
-/* TODO(fclem): Make the associated C-API to use inside DRW profiler. */
+struct GPUTimestampPool {
+  QueryPool *queries;
+  int queries_len;
+};
+
+GPUTimestampPool *GPU_timestamp_pool_create()
+{
+  if (!GCaps.timestamp_query_support) {
+    return nullptr;
+  }
+  GPUTimestampPool *pool = MEM_new<GPUTimestampPool>(__func__);
+  pool->queries = GPUBackend::get()->querypool_alloc();
+  pool->queries->init(GPU_QUERY_TIMESTAMP);
+  pool->queries_len = 0;
+  return pool;
+}
+
+void GPU_timestamp_pool_free(GPUTimestampPool *pool)
+{
+  delete pool->queries;
+  MEM_delete(pool);
+}
+
+int GPU_timestamp_pool_record(GPUTimestampPool *pool)
+{
+  pool->queries->begin_query();
+  return pool->queries_len++;
+}
+
+int GPU_timestamp_pool_len(const GPUTimestampPool *pool)
+{
+  return pool->queries_len;
+}
+
+void GPU_timestamp_pool_results(GPUTimestampPool *pool, MutableSpan<uint64_t> r_times)
+{
+  BLI_assert(r_times.size() == pool->queries_len);
+  pool->queries->get_timestamp_result(r_times);
+}
@@ -16,6 +16,11 @@ namespace blender::gpu {
 
 enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  /**
+   * Records the time at which the GPU reaches #QueryPool::begin_query in the command stream.
+   * #QueryPool::end_query must not be called, so timestamps can be recorded in any order.
+   */
+  GPU_QUERY_TIMESTAMP = 1,
 };
 
 class QueryPool {
@@ -41,6 +46,11 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /**
+   * Same as #get_occlusion_result for #GPU_QUERY_TIMESTAMP. The results are in nanoseconds.
+   */
+  virtual void get_timestamp_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
 }  // namespace blender::gpu
@@ -744,6 +744,27 @@ int GPU_texture_mip_count(const GPUTexture *tex)
   return reinterpret_cast<const Texture *>(tex)->mip_count();
 }
 
+size_t GPU_texture_memory_size(const GPUTexture *tex)
+{
+  const Texture *texture = reinterpret_cast<const Texture *>(tex);
+  const eGPUTextureFormat format = texture->format_get();
+  const bool is_compressed = texture->format_flag_get() & GPU_FORMAT_COMPRESSED;
+  size_t size = 0;
+  for (int mip = 0; mip < texture->mip_count(); mip++) {
+    int extent[3] = {1, 1, 1};
+    texture->mip_size_get(mip, extent);
+    if (is_compressed) {
+      /* Compressed formats are stored in blocks of 4x4 pixels. */
+      size += size_t(divide_ceil_u(extent[0], 4)) * size_t(divide_ceil_u(extent[1], 4)) *
+              size_t(extent[2]) * to_block_size(format);
+    }
+    else {
+      size += size_t(extent[0]) * size_t(extent[1]) * size_t(extent[2]) * to_bytesize(format);
+    }
+  }
+  return size;
+}
+
 int GPU_texture_original_width(const GPUTexture *tex)
 {
   return reinterpret_cast<const Texture *>(tex)->src_w;
@@ -28,6 +28,7 @@
 namespace blender::gpu {
 
 size_t VertBuf::memory_usage = 0;
+size_t VertBuf::upload_size = 0;
 
 VertBuf::VertBuf()
 {
@@ -307,6 +308,11 @@ uint GPU_vertbuf_get_memory_usage()
   return VertBuf::memory_usage;
 }
 
+size_t GPU_vertbuf_get_upload_size()
+{
+  return VertBuf::upload_size;
+}
+
 void GPU_vertbuf_use(VertBuf *verts)
 {
   verts->upload();
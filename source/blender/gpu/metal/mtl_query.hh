@@ -39,5 +39,6 @@ class MTLQueryPool : public QueryPool {
   void end_query() override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  void get_timestamp_result(MutableSpan<uint64_t> r_values) override;
 };
 }  // namespace blender::gpu
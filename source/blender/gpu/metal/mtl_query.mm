@@ -126,4 +126,10 @@ void MTLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   ctx->set_visibility_buffer(nullptr);
 }
 
+void MTLQueryPool::get_timestamp_result(MutableSpan<uint64_t> /*r_values*/)
+{
+  /* Timestamp queries are not supported, see #GPUCapabilities::timestamp_query_support. */
+  BLI_assert_unreachable();
+}
+
 }  // namespace blender::gpu
@@ -193,6 +193,7 @@ void MTLVertBuf::bind()
       void *dst_data = vbo_->get_host_ptr();
       memcpy((uint8_t *)dst_data, this->data_, required_size_raw);
       vbo_->flush_range(0, required_size_raw);
+      upload_size += required_size_raw;
     }
 
     /* If static usage, free host-side data. */
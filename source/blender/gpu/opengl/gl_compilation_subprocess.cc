@@ -6,10 +6,12 @@
 
 #if BLI_SUBPROCESS_SUPPORT
 
+#  include "BKE_appdir.hh"
 #  include "BLI_fileops.hh"
 #  include "BLI_hash.hh"
 #  include "BLI_path_util.h"
 #  include "BLI_tempfile.h"
+#  include "BLI_vector.hh"
 #  include "CLG_log.h"
 #  include "GHOST_C-api.h"
 #  include "GPU_context.hh"
@@ -114,9 +116,15 @@ class SubprocessShader {
 };
 
 /* Check if the binary is valid and can be loaded by the driver. */
-static bool validate_binary(void *binary)
+static bool validate_binary(void *binary, const size_t binary_size)
 {
   ShaderBinaryHeader *bin = reinterpret_cast<ShaderBinaryHeader *>(binary);
+  if (binary_size < offsetof(ShaderBinaryHeader, data) ||
+      bin->size + offsetof(ShaderBinaryHeader, data) != binary_size)
+  {
+    /* Truncated file. */
+    return false;
+  }
   GLuint program = glCreateProgram();
   glProgramBinary(program, bin->format, bin->data, bin->size);
   GLint status;
@@ -125,6 +133,29 @@ static bool validate_binary(void *binary)
   return status;
 }
 
+/**
+ * Binaries are only valid for the driver that generated them, so each driver gets its own cache
+ * folder. The folder is inside the user cache folder, so binaries are kept between sessions.
+ */
+static std::string cache_dir_get()
+{
+  char cache_root[FILE_MAX];
+  if (!BKE_appdir_folder_caches(cache_root, sizeof(cache_root))) {
+    BLI_temp_directory_path_get(cache_root, sizeof(cache_root));
+  }
+
+  const std::string driver = std::string(reinterpret_cast<const char *>(glGetString(GL_VENDOR))) +
+                             reinterpret_cast<const char *>(glGetString(GL_RENDERER)) +
+                             reinterpret_cast<const char *>(glGetString(GL_VERSION));
+  const std::string driver_hash = std::to_string(DefaultHash<std::string>{}(driver));
+
+  char cache_dir[FILE_MAX];
+  BLI_path_join(
+      cache_dir, sizeof(cache_dir), cache_root, "shaders", "opengl", driver_hash.c_str(), SEP_STR);
+  BLI_dir_create_recursive(cache_dir);
+  return cache_dir;
+}
+
 }  // namespace blender::gpu
 
 void GPU_compilation_subprocess_run(const char *subprocess_name)
@@ -165,10 +196,8 @@ void GPU_compilation_subprocess_run(const char *subprocess_name)
   GPUContext *gpu_context = GPU_context_create(nullptr, ghost_context);
   GPU_init();
 
-  static char tmp_dir[1024];
-  BLI_temp_directory_path_get(tmp_dir, sizeof(tmp_dir));
-  std::string cache_dir = std::string(tmp_dir) + "BLENDER_SHADER_CACHE" + SEP_STR;
-  BLI_dir_create_recursive(cache_dir.c_str());
+  const std::string cache_dir = cache_dir_get();
+  Vector<uint8_t> cached_binary;
 
   while (true) {
     /* Process events to avoid crashes on Wayland.
@@ -220,35 +249,27 @@ void GPU_compilation_subprocess_run(const char *subprocess_name)
       frag_src = get_src();
     }
 
-    std::string cache_path = cache_dir + SEP_STR + hash_str;
+    std::string cache_path = cache_dir + hash_str;
 
-    /* TODO: This should lock the files? */
     if (BLI_exists(cache_path.c_str())) {
-      /* Read cached binary. */
+      /* Read the cached binary aside, the sources are still needed if it can't be loaded. */
       fstream file(cache_path, std::ios::binary | std::ios::in | std::ios::ate);
       std::streamsize size = file.tellg();
-      if (size <= compilation_subprocess_shared_memory_size) {
+      if (size > 0 && size <= compilation_subprocess_shared_memory_size) {
+        cached_binary.resize(size);
         file.seekg(0, std::ios::beg);
-        file.read(reinterpret_cast<char *>(shared_mem.get_data()), size);
-        /* Ensure it's valid. */
-        if (!validate_binary(shared_mem.get_data())) {
-          std::cout << "Compilation Subprocess: Failed to load cached shader binary " << hash_str
-                    << "\n";
-          /* We can't compile the shader anymore since we have written over the source code,
-           * but we delete the cache for the next time this shader is requested. */
-          file.close();
-          BLI_delete(cache_path.c_str(), false, false);
+        file.read(reinterpret_cast<char *>(cached_binary.data()), size);
+        if (file && validate_binary(cached_binary.data(), size)) {
+          memcpy(shared_mem.get_data(), cached_binary.data(), size);
+          end_semaphore.increment();
+          continue;
         }
-        end_semaphore.increment();
-        continue;
-      }
-      else {
-        /* This should never happen, since shaders larger than the pool size should be discarded
-         * and compiled in the main Blender process. */
-        std::cerr << "Compilation Subprocess: Wrong size for cached shader binary " << hash_str
-                  << "\n";
-        BLI_assert_unreachable();
       }
+      /* Outdated or corrupted binary. Compile the shader again and replace it. */
+      std::cout << "Compilation Subprocess: Failed to load cached shader binary " << hash_str
+                << "\n";
+      file.close();
+      BLI_delete(cache_path.c_str(), false, false);
     }
 
     SubprocessShader shader(comp_src, vert_src, geom_src, frag_src);
@@ -256,10 +277,18 @@ void GPU_compilation_subprocess_run(const char *subprocess_name)
 
     end_semaphore.increment();
 
-    if (binary) {
-      fstream file(cache_path, std::ios::binary | std::ios::out);
-      file.write(reinterpret_cast<char *>(shared_mem.get_data()),
-                 binary->size + offsetof(ShaderBinaryHeader, data));
+    if (binary && binary->size > 0) {
+      /* Write to a file unique to this subprocess and move it in place once complete, so other
+       * subprocesses (or Blender instances) never read a partially written binary. */
+      const std::string tmp_path = cache_path + name + ".tmp";
+      {
+        fstream file(tmp_path, std::ios::binary | std::ios::out);
+        file.write(reinterpret_cast<char *>(shared_mem.get_data()),
+                   binary->size + offsetof(ShaderBinaryHeader, data));
+      }
+      if (BLI_rename_overwrite(tmp_path.c_str(), cache_path.c_str()) != 0) {
+        BLI_delete(tmp_path.c_str(), false, false);
+      }
     }
   }
 
@@ -42,12 +42,17 @@ void GLQueryPool::begin_query()
     query_ids_.resize(prev_size + chunk_size);
     glGenQueries(chunk_size, &query_ids_[prev_size]);
   }
+  if (type_ == GPU_QUERY_TIMESTAMP) {
+    glQueryCounter(query_ids_[query_issued_++], GL_TIMESTAMP);
+    return;
+  }
   glBeginQuery(gl_type_, query_ids_[query_issued_++]);
 }
 
 void GLQueryPool::end_query()
 {
   /* TODO: add assert about expected usage. */
+  BLI_assert(type_ != GPU_QUERY_TIMESTAMP);
   glEndQuery(gl_type_);
 }
 
@@ -61,4 +66,16 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void GLQueryPool::get_timestamp_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(r_values.size() == query_issued_);
+
+  for (int i = 0; i < query_issued_; i++) {
+    /* NOTE: This is a sync point. */
+    GLuint64 time;
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &time);
+    r_values[i] = time;
+  }
+}
+
 }  // namespace blender::gpu
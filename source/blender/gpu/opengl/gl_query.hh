@@ -39,6 +39,7 @@ class GLQueryPool : public QueryPool {
   void end_query() override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  void get_timestamp_result(MutableSpan<uint64_t> r_values) override;
 };
 
 static inline GLenum to_gl(GPUQueryType type)
@@ -47,6 +48,9 @@ static inline GLenum to_gl(GPUQueryType type)
     /* TODO(fclem): try with GL_ANY_SAMPLES_PASSED​. */
     return GL_SAMPLES_PASSED;
   }
+  if (type == GPU_QUERY_TIMESTAMP) {
+    return GL_TIMESTAMP;
+  }
   BLI_assert(0);
   return GL_SAMPLES_PASSED;
 }
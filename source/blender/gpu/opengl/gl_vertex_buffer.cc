@@ -98,6 +98,7 @@ void GLVertBuf::bind()
     /* Do not transfer data from host to device when buffer is device only. */
     if (usage_ != GPU_USAGE_DEVICE_ONLY) {
       glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data_);
+      upload_size += vbo_size_;
     }
     memory_usage += vbo_size_;
 
@@ -0,0 +1,22 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * Evaluates a geometry nodes field for every element. The `evaluate` function is generated from
+ * the field and appended to this shader, see `gpu_field_evaluation.cc`. It may call the functions
+ * of the common math library.
+ */
+
+#pragma BLENDER_REQUIRE(gpu_shader_common_math.glsl)
+
+void main()
+{
+  /* The second dimension is used when there are too many elements for a single dimension. */
+  int index = int(gl_GlobalInvocationID.x +
+                  gl_GlobalInvocationID.y * gl_NumWorkGroups.x * gl_WorkGroupSize.x);
+  if (index >= elements_num) {
+    return;
+  }
+  evaluate(index);
+}
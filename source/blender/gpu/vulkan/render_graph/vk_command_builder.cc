@@ -6,6 +6,8 @@
  * \ingroup gpu
  */
 
+#include "BLI_task.hh"
+
 #include "vk_command_builder.hh"
 #include "vk_render_graph.hh"
 
@@ -53,11 +55,57 @@ void VKCommandBuilder::build_nodes(VKRenderGraph &render_graph,
   render_graph.resources_.reset_image_layouts();
 
   state_.active_pipelines = {};
+  groups_init(render_graph, nodes);
+
+  auto build_barriers = [&]() {
+    while (build_next_group_barriers(render_graph, nodes)) {
+    }
+  };
+
+  auto record_commands = [&]() {
+    command_buffer.begin_recording();
+    state_.debug_level = 0;
+    state_.active_debug_group_id = -1;
+    std::optional<NodeHandle> rendering_scope;
+    for (const int64_t group_index : groups_.index_range()) {
+      while (group_index >= groups_with_barriers_num_.load(std::memory_order_acquire)) {
+        /* Don't wait for the other thread, it might not have been started. */
+        build_next_group_barriers(render_graph, nodes);
+      }
+      const NodeGroup &group = groups_[group_index];
+      build_node_group(
+          render_graph, command_buffer, group, nodes.slice(group.nodes), rendering_scope);
+    }
+
+    finish_debug_groups(command_buffer);
+    state_.debug_level = 0;
+
+    command_buffer.end_recording();
+  };
+
+  /* Small graphs aren't worth the threading overhead. */
+  const bool use_threading = groups_.size() > 64;
+  threading::parallel_invoke(use_threading, build_barriers, record_commands);
+}
+
+void VKCommandBuilder::groups_init(VKRenderGraph &render_graph, Span<NodeHandle> nodes)
+{
+  groups_.clear();
+  barriers_.clear();
+  vk_buffer_memory_barriers_.clear();
+  vk_image_memory_barriers_.clear();
+  groups_with_barriers_num_.store(0, std::memory_order_relaxed);
+
+  /* Each node has at most one barrier command and each link at most one memory barrier. */
+  int64_t links_num = 0;
+  for (const NodeHandle node_handle : nodes) {
+    const VKRenderGraphNodeLinks &links = render_graph.links_[node_handle];
+    links_num += links.inputs.size() + links.outputs.size();
+  }
+  barriers_.reserve(nodes.size());
+  vk_buffer_memory_barriers_.reserve(links_num);
+  vk_image_memory_barriers_.reserve(links_num);
 
-  command_buffer.begin_recording();
-  state_.debug_level = 0;
-  state_.active_debug_group_id = -1;
-  std::optional<NodeHandle> rendering_scope;
   IndexRange nodes_range = nodes.index_range();
   while (!nodes_range.is_empty()) {
     IndexRange node_group = nodes_range.slice(0, 1);
@@ -72,25 +120,41 @@ void VKCommandBuilder::build_nodes(VKRenderGraph &render_graph,
       node_group = nodes_range.slice(0, node_group.size() + 1);
     }
 
-    build_node_group(render_graph, command_buffer, nodes.slice(node_group), rendering_scope);
+    groups_.append({IndexRange(nodes_range.first(), node_group.size()), {}});
     nodes_range = nodes_range.drop_front(node_group.size());
   }
+}
 
-  finish_debug_groups(command_buffer);
-  state_.debug_level = 0;
+bool VKCommandBuilder::build_next_group_barriers(VKRenderGraph &render_graph,
+                                                 Span<NodeHandle> nodes)
+{
+  std::scoped_lock lock(barriers_mutex_);
+  const int64_t group_index = groups_with_barriers_num_.load(std::memory_order_relaxed);
+  if (group_index == groups_.size()) {
+    return false;
+  }
 
-  command_buffer.end_recording();
+  NodeGroup &group = groups_[group_index];
+  const int64_t barriers_start = barriers_.size();
+  for (const NodeHandle node_handle : nodes.slice(group.nodes)) {
+    VKRenderGraphNode &node = render_graph.nodes_[node_handle];
+    build_pipeline_barriers(render_graph, node_handle, node.pipeline_stage_get());
+  }
+  group.barriers = IndexRange(barriers_start, barriers_.size() - barriers_start);
+
+  groups_with_barriers_num_.store(group_index + 1, std::memory_order_release);
+  return true;
 }
 
 void VKCommandBuilder::build_node_group(VKRenderGraph &render_graph,
                                         VKCommandBufferInterface &command_buffer,
+                                        const NodeGroup &group,
                                         Span<NodeHandle> node_group,
                                         std::optional<NodeHandle> &r_rendering_scope)
 {
   bool is_rendering = false;
-  for (NodeHandle node_handle : node_group) {
-    VKRenderGraphNode &node = render_graph.nodes_[node_handle];
-    build_pipeline_barriers(render_graph, command_buffer, node_handle, node.pipeline_stage_get());
+  for (const Barrier &barrier : barriers_.as_span().slice(group.barriers)) {
+    send_pipeline_barriers(command_buffer, barrier);
   }
 
   for (NodeHandle node_handle : node_group) {
@@ -209,14 +273,13 @@ void VKCommandBuilder::finish_debug_groups(VKCommandBufferInterface &command_buf
 }
 
 void VKCommandBuilder::build_pipeline_barriers(VKRenderGraph &render_graph,
-                                               VKCommandBufferInterface &command_buffer,
                                                NodeHandle node_handle,
                                                VkPipelineStageFlags pipeline_stage)
 {
   reset_barriers();
   add_image_barriers(render_graph, node_handle, pipeline_stage);
   add_buffer_barriers(render_graph, node_handle, pipeline_stage);
-  send_pipeline_barriers(command_buffer);
+  finish_barrier();
 }
 
 /** \} */
@@ -227,36 +290,46 @@ void VKCommandBuilder::build_pipeline_barriers(VKRenderGraph &render_graph,
 
 void VKCommandBuilder::reset_barriers()
 {
-  vk_buffer_memory_barriers_.clear();
-  vk_image_memory_barriers_.clear();
+  state_.buffer_memory_barriers_start = vk_buffer_memory_barriers_.size();
+  state_.image_memory_barriers_start = vk_image_memory_barriers_.size();
   state_.src_stage_mask = VK_PIPELINE_STAGE_NONE;
   state_.dst_stage_mask = VK_PIPELINE_STAGE_NONE;
 }
 
-void VKCommandBuilder::send_pipeline_barriers(VKCommandBufferInterface &command_buffer)
+void VKCommandBuilder::finish_barrier()
 {
-  if (vk_image_memory_barriers_.is_empty() && vk_buffer_memory_barriers_.is_empty()) {
-    reset_barriers();
+  Barrier barrier;
+  barrier.buffer_memory_barriers = IndexRange::from_begin_end(
+      state_.buffer_memory_barriers_start, vk_buffer_memory_barriers_.size());
+  barrier.image_memory_barriers = IndexRange::from_begin_end(state_.image_memory_barriers_start,
+                                                             vk_image_memory_barriers_.size());
+  if (barrier.buffer_memory_barriers.is_empty() && barrier.image_memory_barriers.is_empty()) {
     return;
   }
 
   /* When no resources have been used, we can start the barrier at the top of the pipeline.
    * It is not allowed to set it to None. */
   /* TODO: VK_KHR_synchronization2 allows setting src_stage_mask to NONE. */
-  if (state_.src_stage_mask == VK_PIPELINE_STAGE_NONE) {
-    state_.src_stage_mask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-  }
+  barrier.src_stage_mask = state_.src_stage_mask == VK_PIPELINE_STAGE_NONE ?
+                               VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT :
+                               state_.src_stage_mask;
+  barrier.dst_stage_mask = state_.dst_stage_mask;
+  barriers_.append(barrier);
+}
 
-  command_buffer.pipeline_barrier(state_.src_stage_mask,
-                                  state_.dst_stage_mask,
-                                  VK_DEPENDENCY_BY_REGION_BIT,
-                                  0,
-                                  nullptr,
-                                  vk_buffer_memory_barriers_.size(),
-                                  vk_buffer_memory_barriers_.data(),
-                                  vk_image_memory_barriers_.size(),
-                                  vk_image_memory_barriers_.data());
-  reset_barriers();
+void VKCommandBuilder::send_pipeline_barriers(VKCommandBufferInterface &command_buffer,
+                                              const Barrier &barrier)
+{
+  command_buffer.pipeline_barrier(
+      barrier.src_stage_mask,
+      barrier.dst_stage_mask,
+      VK_DEPENDENCY_BY_REGION_BIT,
+      0,
+      nullptr,
+      barrier.buffer_memory_barriers.size(),
+      vk_buffer_memory_barriers_.data() + barrier.buffer_memory_barriers.start(),
+      barrier.image_memory_barriers.size(),
+      vk_image_memory_barriers_.data() + barrier.image_memory_barriers.start());
 }
 
 void VKCommandBuilder::add_buffer_barriers(VKRenderGraph &render_graph,
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "vk_common.hh"
 #include "vk_render_graph_node.hh"
 #include "vk_scheduler.hh"
@@ -20,12 +23,42 @@ class VKRenderGraph;
  *
  * Determine which nodes needs to be scheduled, Then for each node generate the needed pipeline
  * barriers and commands.
+ *
+ * The pipeline barriers depend on the state of the resources after all previous nodes, so they
+ * are built in node order. Recording the commands of a node group only needs the barriers of that
+ * group. Both happen at the same time: the barriers of the next groups are built on another
+ * thread while the previous groups are being recorded.
  */
 class VKCommandBuilder {
  private:
-  /* Pool of VKBufferMemoryBarriers that can be reused when building barriers */
+  /** Nodes that are recorded together, see #build_node_group. */
+  struct NodeGroup {
+    IndexRange nodes;
+    /** Pipeline barriers of the nodes in the group, points into #barriers_. */
+    IndexRange barriers;
+  };
+
+  /** A pipeline barrier command. */
+  struct Barrier {
+    VkPipelineStageFlags src_stage_mask = VK_PIPELINE_STAGE_NONE;
+    VkPipelineStageFlags dst_stage_mask = VK_PIPELINE_STAGE_NONE;
+    /** Points into #vk_buffer_memory_barriers_ and #vk_image_memory_barriers_. */
+    IndexRange buffer_memory_barriers;
+    IndexRange image_memory_barriers;
+  };
+
+  Vector<NodeGroup> groups_;
+  /**
+   * Barriers of all node groups. Storage is reserved up-front so the barriers that are being
+   * recorded aren't moved when the barriers of later groups are added.
+   */
+  Vector<Barrier> barriers_;
   Vector<VkBufferMemoryBarrier> vk_buffer_memory_barriers_;
   Vector<VkImageMemoryBarrier> vk_image_memory_barriers_;
+  /** Number of groups at the start of #groups_ whose barriers have been built. */
+  std::atomic<int64_t> groups_with_barriers_num_ = 0;
+  /** Protects building barriers, which can happen on the recording thread as well. */
+  std::mutex barriers_mutex_;
 
   /** Template buffer memory barrier. */
   VkBufferMemoryBarrier vk_buffer_memory_barrier_;
@@ -43,10 +76,13 @@ class VKCommandBuilder {
      * pass them to
      * `https://docs.vulkan.org/spec/latest/chapters/synchronization.html#vkCmdPipelineBarrier`
      *
-     * NOTE: Only valid between `reset_barriers` and `send_pipeline_barriers`.
+     * NOTE: Only valid between `reset_barriers` and `finish_barrier`.
      */
     VkPipelineStageFlags src_stage_mask = VK_PIPELINE_STAGE_NONE;
     VkPipelineStageFlags dst_stage_mask = VK_PIPELINE_STAGE_NONE;
+    /** First memory barriers of the barrier that is being built. */
+    int64_t buffer_memory_barriers_start = 0;
+    int64_t image_memory_barriers_start = 0;
 
     /**
      * Index of the active debug_group. Points to an element in
@@ -78,29 +114,40 @@ class VKCommandBuilder {
 
  private:
   /**
-   * Build the commands of the node group provided by the `node_group` parameter. The commands are
-   * recorded into the given `command_buffer`.
+   * Split the nodes into groups and reserve the storage for their barriers.
    *
-   * build_nodes splits the given node_handles into groups. All synchronization events inside the
-   * group will be pushed to the front or back of this group. This allows us to record resource
-   * usage on node level, perform reordering and then invoke the synchronization events outside
-   * rendering scopes.
+   * All synchronization events inside a group will be pushed to the front or back of this group.
+   * This allows us to record resource usage on node level, perform reordering and then invoke the
+   * synchronization events outside rendering scopes.
+   */
+  void groups_init(VKRenderGraph &render_graph, Span<NodeHandle> node_handles);
+
+  /**
+   * Build the commands of the node group provided by the `node_group` parameter. The commands are
+   * recorded into the given `command_buffer`. The barriers of the group must have been built.
    */
   void build_node_group(VKRenderGraph &render_graph,
                         VKCommandBufferInterface &command_buffer,
+                        const NodeGroup &group,
                         Span<NodeHandle> node_group,
                         std::optional<NodeHandle> &r_rendering_scope);
 
+  /**
+   * Build the pipeline barriers of the first group whose barriers haven't been built yet.
+   * Returns false when the barriers of all groups have been built.
+   */
+  bool build_next_group_barriers(VKRenderGraph &render_graph, Span<NodeHandle> node_handles);
+
   /**
    * Build the pipeline barriers that should be recorded before any other commands of the node
    * group the given node is part of is being recorded.
    */
   void build_pipeline_barriers(VKRenderGraph &render_graph,
-                               VKCommandBufferInterface &command_buffer,
                                NodeHandle node_handle,
                                VkPipelineStageFlags pipeline_stage);
   void reset_barriers();
-  void send_pipeline_barriers(VKCommandBufferInterface &command_buffer);
+  void finish_barrier();
+  void send_pipeline_barriers(VKCommandBufferInterface &command_buffer, const Barrier &barrier);
 
   void add_buffer_barriers(VKRenderGraph &render_graph,
                            NodeHandle node_handle,
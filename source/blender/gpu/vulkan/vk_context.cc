@@ -268,7 +268,7 @@ void VKContext::update_pipeline_data(VKShader &vk_shader,
   r_pipeline_data.vk_descriptor_set = VK_NULL_HANDLE;
   if (vk_shader.has_descriptor_set()) {
     descriptor_set_.update(*this);
-    r_pipeline_data.vk_descriptor_set = descriptor_set_get().active_descriptor_set()->vk_handle();
+    r_pipeline_data.vk_descriptor_set = descriptor_set_get().active_vk_descriptor_set();
   }
 }
 
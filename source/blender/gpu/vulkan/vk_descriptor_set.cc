@@ -129,18 +129,67 @@ VKDescriptorSetTracker::Binding &VKDescriptorSetTracker::ensure_location(
   return bindings_.last();
 }
 
+uint64_t VKDescriptorSetTracker::DescriptorSetKey::hash() const
+{
+  uint64_t hash = get_default_hash(uint64_t(vk_descriptor_set_layout));
+  for (const uint64_t value : bindings) {
+    hash = hash * 33 ^ get_default_hash(value);
+  }
+  return hash;
+}
+
 void VKDescriptorSetTracker::update(VKContext &context)
 {
   const VKShader &shader = *unwrap(context.shader);
   VkDescriptorSetLayout vk_descriptor_set_layout = shader.vk_descriptor_set_layout_get();
   const bool new_descriptor_set_layout = assign_if_different(active_vk_descriptor_set_layout,
                                                              vk_descriptor_set_layout);
-  const bool renew_resource = new_descriptor_set_layout || !bindings_.is_empty();
-  tracked_resource_for(context, renew_resource);
-  std::unique_ptr<VKDescriptorSet> &descriptor_set = active_descriptor_set();
+  const bool new_submission = reusable_submission_tracker_.is_changed(context);
+  if (new_submission) {
+    /* The descriptor sets of the previous submission are freed by the resource tracker. */
+    reusable_descriptor_sets_.clear();
+  }
+  else if (!new_descriptor_set_layout && bindings_.is_empty() &&
+           active_vk_descriptor_set_ != VK_NULL_HANDLE)
+  {
+    /* Nothing changed since the previous draw. */
+    return;
+  }
+
+  DescriptorSetKey key;
+  key.vk_descriptor_set_layout = vk_descriptor_set_layout;
+  key.bindings.reserve(bindings_.size() * 4);
+  for (const Binding &binding : bindings_) {
+    uint64_t vk_handle = 0;
+    if (binding.is_buffer()) {
+      vk_handle = uint64_t(binding.vk_buffer);
+    }
+    else if (binding.is_texel_buffer()) {
+      vk_handle = uint64_t(binding.vk_buffer_view);
+    }
+    else if (binding.is_image()) {
+      vk_handle = uint64_t(binding.texture->image_view_get(binding.arrayed).vk_handle());
+    }
+    key.bindings.append((uint64_t(binding.location) << 32) | uint64_t(binding.type));
+    key.bindings.append(vk_handle);
+    key.bindings.append(uint64_t(binding.vk_sampler));
+    key.bindings.append(binding.buffer_size);
+  }
+
+  if (const VkDescriptorSet *reusable_descriptor_set = reusable_descriptor_sets_.lookup_ptr(key))
+  {
+    active_vk_descriptor_set_ = *reusable_descriptor_set;
+    bindings_.clear();
+    return;
+  }
+
+  tracked_resource_for(context, true);
+  std::unique_ptr<VKDescriptorSet> &descriptor_set = active_resource();
   VkDescriptorSet vk_descriptor_set = descriptor_set->vk_handle();
   BLI_assert(vk_descriptor_set != VK_NULL_HANDLE);
   debug::object_label(vk_descriptor_set, shader.name_get());
+  active_vk_descriptor_set_ = vk_descriptor_set;
+  reusable_descriptor_sets_.add_new(std::move(key), vk_descriptor_set);
 
   /* TODO: should be replaced by a better system. The buffer_infos and image_infos can be
    * reallocated, making previous references invalid. */
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "BLI_map.hh"
 #include "BLI_utility_mixins.hh"
 #include "BLI_vector.hh"
 
@@ -154,10 +155,34 @@ class VKDescriptorSetTracker : protected VKResourceTracker<VKDescriptorSet> {
   };
 
  private:
+  /** Layout and resources written to a descriptor set. */
+  struct DescriptorSetKey {
+    VkDescriptorSetLayout vk_descriptor_set_layout = VK_NULL_HANDLE;
+    /** Location, type, handles and size of each binding. */
+    Vector<uint64_t> bindings;
+
+    uint64_t hash() const;
+    friend bool operator==(const DescriptorSetKey &a, const DescriptorSetKey &b)
+    {
+      return a.vk_descriptor_set_layout == b.vk_descriptor_set_layout &&
+             a.bindings.as_span() == b.bindings.as_span();
+    }
+  };
+
   /** A list of bindings that needs to be updated. */
   Vector<Binding> bindings_;
 
   VkDescriptorSetLayout active_vk_descriptor_set_layout = VK_NULL_HANDLE;
+  /** Descriptor set to use for the next draw or dispatch. Can be a reused descriptor set. */
+  VkDescriptorSet active_vk_descriptor_set_ = VK_NULL_HANDLE;
+
+  /**
+   * Descriptor sets written during the current submission. They are only freed when the
+   * submission changes, so drawing again with the same resources can reuse them instead of
+   * allocating and writing a new descriptor set.
+   */
+  Map<DescriptorSetKey, VkDescriptorSet> reusable_descriptor_sets_;
+  VKSubmissionTracker reusable_submission_tracker_;
 
  public:
   VKDescriptorSetTracker() {}
@@ -178,9 +203,9 @@ class VKDescriptorSetTracker : protected VKResourceTracker<VKDescriptorSet> {
   /* Bind as uniform texel buffer. */
   void bind(VKVertexBuffer &vertex_buffer, VKDescriptorSet::Location location);
 
-  std::unique_ptr<VKDescriptorSet> &active_descriptor_set()
+  VkDescriptorSet active_vk_descriptor_set() const
   {
-    return active_resource();
+    return active_vk_descriptor_set_;
   }
 
   /**
@@ -19,10 +19,20 @@
 
 #include "GPU_capabilities.hh"
 
+#include "BKE_appdir.hh"
+
+#include "BLI_fileops.hh"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_system.h"
+
+#include BLI_SYSTEM_PID_H
 
 #include "GHOST_C-api.h"
 
+#include "MEM_guardedalloc.h"
+
 extern "C" char datatoc_glsl_shader_defines_glsl[];
 
 namespace blender::gpu {
@@ -44,6 +54,7 @@ void VKDevice::deinit()
   samplers_.free();
   destroy_discarded_resources();
   pipelines.free_data();
+  save_pipeline_cache();
   vkDestroyPipelineCache(vk_device_, vk_pipeline_cache_, vk_allocation_callbacks);
   descriptor_set_layouts_.deinit();
   vmaDestroyAllocator(mem_allocator_);
@@ -175,12 +186,93 @@ void VKDevice::init_memory_allocator()
   vmaCreateAllocator(&info, &mem_allocator_);
 }
 
+/** Location of the pipeline cache of this device inside the user cache folder. */
+static std::string pipeline_cache_filepath_get(const VkPhysicalDeviceProperties &properties)
+{
+  char cache_dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(cache_dir, sizeof(cache_dir))) {
+    return "";
+  }
+  char filename[64];
+  SNPRINTF(filename, "pipeline_cache_%x_%x.bin", properties.vendorID, properties.deviceID);
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), cache_dir, "shaders", "vulkan", filename);
+  return filepath;
+}
+
+/**
+ * Pipeline cache data is only valid for the device and driver that created it. Check it up-front
+ * as not all drivers handle incompatible data gracefully.
+ */
+static bool pipeline_cache_is_compatible(const void *data,
+                                         const size_t data_size,
+                                         const VkPhysicalDeviceProperties &properties)
+{
+  VkPipelineCacheHeaderVersionOne header;
+  if (data_size < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  return header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+         memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
 void VKDevice::init_pipeline_cache()
 {
   VK_ALLOCATION_CALLBACKS;
   VkPipelineCacheCreateInfo create_info = {};
   create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+  /* Start from the pipelines compiled in previous sessions. */
+  void *cache_data = nullptr;
+  size_t cache_data_size = 0;
+  const std::string filepath = pipeline_cache_filepath_get(vk_physical_device_properties_);
+  if (!filepath.empty() && BLI_exists(filepath.c_str())) {
+    cache_data = BLI_file_read_binary_as_mem(filepath.c_str(), 0, &cache_data_size);
+    if (cache_data &&
+        pipeline_cache_is_compatible(cache_data, cache_data_size, vk_physical_device_properties_))
+    {
+      create_info.initialDataSize = cache_data_size;
+      create_info.pInitialData = cache_data;
+    }
+  }
+
   vkCreatePipelineCache(vk_device_, &create_info, vk_allocation_callbacks, &vk_pipeline_cache_);
+  MEM_SAFE_FREE(cache_data);
+}
+
+void VKDevice::save_pipeline_cache()
+{
+  const std::string filepath = pipeline_cache_filepath_get(vk_physical_device_properties_);
+  if (filepath.empty()) {
+    return;
+  }
+
+  size_t data_size = 0;
+  if (vkGetPipelineCacheData(vk_device_, vk_pipeline_cache_, &data_size, nullptr) != VK_SUCCESS ||
+      data_size == 0)
+  {
+    return;
+  }
+  Array<uint8_t> data(data_size);
+  if (vkGetPipelineCacheData(vk_device_, vk_pipeline_cache_, &data_size, data.data()) !=
+      VK_SUCCESS)
+  {
+    return;
+  }
+
+  /* Write to a file unique to this process and move it in place once complete, so other Blender
+   * instances never read a partially written cache. */
+  BLI_file_ensure_parent_dir_exists(filepath.c_str());
+  const std::string tmp_filepath = filepath + "." + std::to_string(getpid()) + ".tmp";
+  {
+    fstream file(tmp_filepath, std::ios::binary | std::ios::out);
+    file.write(reinterpret_cast<const char *>(data.data()), data_size);
+  }
+  if (BLI_rename_overwrite(tmp_filepath.c_str(), filepath.c_str()) != 0) {
+    BLI_delete(tmp_filepath.c_str(), false, false);
+  }
 }
 
 void VKDevice::init_dummy_buffer(VKContext &context)
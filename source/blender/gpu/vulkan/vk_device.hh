@@ -261,6 +261,8 @@ class VKDevice : public NonCopyable {
   void init_debug_callbacks();
   void init_memory_allocator();
   void init_pipeline_cache();
+  /** Write the pipeline cache to disk, so pipelines don't need to be recompiled next session. */
+  void save_pipeline_cache();
   /**
    * Initialize the functions struct with extension specific function pointer.
    */
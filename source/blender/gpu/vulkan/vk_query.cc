@@ -31,4 +31,9 @@ void VKQueryPool::get_occlusion_result(MutableSpan<uint32_t> /*r_values*/)
   NOT_YET_IMPLEMENTED
 }
 
+void VKQueryPool::get_timestamp_result(MutableSpan<uint64_t> /*r_values*/)
+{
+  NOT_YET_IMPLEMENTED
+}
+
 }  // namespace blender::gpu
@@ -18,6 +18,7 @@ class VKQueryPool : public QueryPool {
   void begin_query() override;
   void end_query() override;
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  void get_timestamp_result(MutableSpan<uint64_t> r_values) override;
 };
 
 }  // namespace blender::gpu
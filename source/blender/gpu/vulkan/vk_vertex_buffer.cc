@@ -176,6 +176,7 @@ void VKVertexBuffer::upload_data()
       VKContext &context = *VKContext::get();
       upload_data_via_staging_buffer(context);
     }
+    upload_size += size_used_get();
     if (usage_ == GPU_USAGE_STATIC) {
       MEM_SAFE_FREE(data_);
     }
@@ -357,6 +357,17 @@ ImBuf *IMB_anim_absolute(ImBufAnim *anim,
                          IMB_Timecode_Type tc /* = 1 = IMB_TC_RECORD_RUN */,
                          IMB_Proxy_Size preview_size /* = 0 = IMB_PROXY_NONE */);
 
+/**
+ * Fetch the frame at the given position from the original movie, converted to an image whose
+ * size is the original size multiplied by the given scale. Scaling during the color conversion
+ * is much cheaper than fetching the full size frame and scaling it afterwards, so this can be
+ * used in place of a proxy that was not built.
+ */
+ImBuf *IMB_anim_absolute_scaled(ImBufAnim *anim,
+                                int position,
+                                IMB_Timecode_Type tc,
+                                float scale);
+
 /**
  * fetches a define preview-frame, usually half way into the movie.
  */
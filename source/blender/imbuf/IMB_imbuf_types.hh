@@ -112,6 +112,8 @@ enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Decode movies with a hardware decoder when one is available. */
+  IB_animhwaccel = 1 << 19,
 };
 
 /** \} */
@@ -47,6 +47,19 @@ void IMB_moviecache_remove(MovieCache *cache, void *userkey);
 bool IMB_moviecache_has_frame(MovieCache *cache, void *userkey);
 void IMB_moviecache_free(MovieCache *cache);
 
+/**
+ * Account memory of image caches which are not movie caches (like the sequencer cache) against
+ * the shared cache budget from #MEM_CacheLimiter_get_maximum, so that movie caches free their
+ * items when other caches grow and the caches together do not exceed the limit.
+ */
+void IMB_moviecache_external_memory_add(size_t size);
+void IMB_moviecache_external_memory_remove(size_t size);
+/**
+ * Get memory used by all movie caches and the external memory, to be compared against the shared
+ * cache budget.
+ */
+size_t IMB_moviecache_get_memory_in_use();
+
 void IMB_moviecache_cleanup(MovieCache *cache,
                             bool(cleanup_check_cb)(ImBuf *ibuf, void *userkey, void *userdata),
                             void *userdata);
@@ -18,6 +18,7 @@ struct AVCodecContext;
 struct AVCodec;
 struct AVFrame;
 struct AVPacket;
+struct AVBufferRef;
 struct SwsContext;
 #endif
 
@@ -47,8 +48,23 @@ struct ImBufAnim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   SwsContext *img_convert_ctx;
+  /* RGB frame and conversion context used when frames are fetched at a reduced size, created on
+   * demand and recreated when the requested size changes. */
+  AVFrame *pFrameScaledRGB;
+  SwsContext *img_scale_ctx;
   int videoStream;
 
+  /* Hardware decoding device, null when frames are decoded in software. */
+  AVBufferRef *hw_device_ctx;
+  /* The `AVPixelFormat` of frames decoded by the hardware decoder. */
+  int hw_pix_fmt;
+  /* The `AVPixelFormat` of the frames downloaded from the hardware decoder, which the conversion
+   * contexts are created for. Differs from the format of the codec context with hardware
+   * decoding. */
+  int sws_src_pix_fmt;
+  /* Frame that hardware decoded frames are downloaded to. */
+  AVFrame *pFrameDownloaded;
+
   AVFrame *pFrame;
   bool pFrame_complete;
   AVFrame *pFrame_backup;
@@ -708,20 +708,19 @@ size_t IMB_get_rect_len(const ImBuf *ibuf)
 size_t IMB_get_size_in_memory(ImBuf *ibuf)
 {
   int a;
-  size_t size = 0, channel_size = 0;
+  size_t size = 0;
 
   size += sizeof(ImBuf);
 
+  /* Byte buffers always have 4 channels, only float buffers use the channels of the image. */
   if (ibuf->byte_buffer.data) {
-    channel_size += sizeof(char);
+    size += sizeof(uint8_t[4]) * IMB_get_rect_len(ibuf);
   }
 
   if (ibuf->float_buffer.data) {
-    channel_size += sizeof(float);
+    size += sizeof(float) * ibuf->channels * IMB_get_rect_len(ibuf);
   }
 
-  size += channel_size * ibuf->x * ibuf->y * ibuf->channels;
-
   if (ibuf->miptot) {
     for (a = 0; a < ibuf->miptot; a++) {
       if (ibuf->mipmap[a]) {
@@ -18,6 +18,7 @@
 #  include <io.h>
 #endif
 
+#include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
@@ -43,6 +44,7 @@
 extern "C" {
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -54,6 +56,7 @@ extern "C" {
 
 #ifdef WITH_FFMPEG
 static void free_anim_ffmpeg(ImBufAnim *anim);
+static void ffmpeg_sws_setup_colorspace(ImBufAnim *anim, SwsContext *sws_ctx);
 #endif
 
 void IMB_free_anim(ImBufAnim *anim)
@@ -161,6 +164,64 @@ void IMB_suffix_anim(ImBufAnim *anim, const char *suffix)
 
 #ifdef WITH_FFMPEG
 
+static AVPixelFormat ffmpeg_get_hw_format(AVCodecContext *codec_ctx,
+                                          const AVPixelFormat *pix_fmts)
+{
+  const ImBufAnim *anim = static_cast<const ImBufAnim *>(codec_ctx->opaque);
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+
+  /* The hardware decoder does not support this stream, fall back to software decoding. */
+  return avcodec_default_get_format(codec_ctx, pix_fmts);
+}
+
+/**
+ * Create a hardware decoding device for the codec and set up the codec context to use it. Does
+ * nothing if no supported device is available, in which case frames are decoded in software.
+ */
+static void ffmpeg_hw_device_setup(ImBufAnim *anim,
+                                   const AVCodec *codec,
+                                   AVCodecContext *codec_ctx)
+{
+  /* Device types in order of preference. */
+  const AVHWDeviceType device_types[] = {
+      AV_HWDEVICE_TYPE_CUDA,
+      AV_HWDEVICE_TYPE_VAAPI,
+      AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+      AV_HWDEVICE_TYPE_D3D11VA,
+      AV_HWDEVICE_TYPE_DXVA2,
+  };
+
+  for (const AVHWDeviceType device_type : device_types) {
+    for (int i = 0;; i++) {
+      const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+      if (config == nullptr) {
+        break;
+      }
+      if (config->device_type != device_type ||
+          (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0)
+      {
+        continue;
+      }
+      if (av_hwdevice_ctx_create(&anim->hw_device_ctx, device_type, nullptr, nullptr, 0) < 0) {
+        break;
+      }
+
+      anim->hw_pix_fmt = config->pix_fmt;
+      codec_ctx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+      codec_ctx->opaque = anim;
+      codec_ctx->get_format = ffmpeg_get_hw_format;
+      /* Decoded frames are kept alive by the double buffer, see
+       * #ffmpeg_double_buffer_backup_frame_store, so the surface pool needs extra frames. */
+      codec_ctx->extra_hw_frames = 2;
+      return;
+    }
+  }
+}
+
 static int startffmpeg(ImBufAnim *anim)
 {
   int i, video_stream_index;
@@ -174,11 +235,6 @@ static int startffmpeg(ImBufAnim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == nullptr) {
     return (-1);
   }
@@ -228,6 +284,12 @@ static int startffmpeg(ImBufAnim *anim)
   avcodec_parameters_to_context(pCodecCtx, video_stream->codecpar);
   pCodecCtx->workaround_bugs = FF_BUG_AUTODETECT;
 
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  /* De-interlacing operates on software frames in the codec pixel format. */
+  if ((anim->ib_flags & IB_animhwaccel) && (anim->ib_flags & IB_animdeinterlace) == 0) {
+    ffmpeg_hw_device_setup(anim, pCodec, pCodecCtx);
+  }
+
   if (pCodec->capabilities & AV_CODEC_CAP_OTHER_THREADS) {
     pCodecCtx->thread_count = 0;
   }
@@ -408,9 +470,10 @@ static int startffmpeg(ImBufAnim *anim)
         1);
   }
 
+  anim->sws_src_pix_fmt = anim->pCodecCtx->pix_fmt;
   anim->img_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
                                                      anim->y,
-                                                     anim->pCodecCtx->pix_fmt,
+                                                     anim->sws_src_pix_fmt,
                                                      AV_PIX_FMT_RGBA,
                                                      SWS_BILINEAR | SWS_PRINT_INFO |
                                                          SWS_FULL_CHR_H_INT);
@@ -428,8 +491,20 @@ static int startffmpeg(ImBufAnim *anim)
     return -1;
   }
 
+  ffmpeg_sws_setup_colorspace(anim, anim->img_convert_ctx);
+
+  return 0;
+}
+
+static void ffmpeg_sws_setup_colorspace(ImBufAnim *anim, SwsContext *sws_ctx)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
   /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
+  if (!sws_getColorspaceDetails(sws_ctx,
                                 (int **)&inv_table,
                                 &srcRange,
                                 &table,
@@ -441,7 +516,7 @@ static int startffmpeg(ImBufAnim *anim)
     srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
     inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
 
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
+    if (sws_setColorspaceDetails(sws_ctx,
                                  (int *)inv_table,
                                  srcRange,
                                  table,
@@ -456,8 +531,6 @@ static int startffmpeg(ImBufAnim *anim)
   else {
     fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
   }
-
-  return 0;
 }
 
 static double ffmpeg_steps_per_frame_get(ImBufAnim *anim)
@@ -514,6 +587,72 @@ static AVFrame *ffmpeg_double_buffer_frame_fallback_get(ImBufAnim *anim)
   return nullptr;
 }
 
+/**
+ * Ensure the RGB frame and conversion context used to convert decoded frames to an image of the
+ * given reduced size exist. Returns false if they could not be created.
+ */
+static bool ffmpeg_scaled_frame_ensure(ImBufAnim *anim, const int width, const int height)
+{
+  if (anim->pFrameScaledRGB && anim->pFrameScaledRGB->width == width &&
+      anim->pFrameScaledRGB->height == height)
+  {
+    return true;
+  }
+
+  av_frame_free(&anim->pFrameScaledRGB);
+  if (anim->img_scale_ctx) {
+    BKE_ffmpeg_sws_release_context(anim->img_scale_ctx);
+    anim->img_scale_ctx = nullptr;
+  }
+
+  anim->pFrameScaledRGB = av_frame_alloc();
+  anim->pFrameScaledRGB->format = AV_PIX_FMT_RGBA;
+  anim->pFrameScaledRGB->width = width;
+  anim->pFrameScaledRGB->height = height;
+  if (av_frame_get_buffer(anim->pFrameScaledRGB, 0) < 0) {
+    av_frame_free(&anim->pFrameScaledRGB);
+    return false;
+  }
+
+  anim->img_scale_ctx = BKE_ffmpeg_sws_get_context(anim->x,
+                                                   anim->y,
+                                                   anim->sws_src_pix_fmt,
+                                                   width,
+                                                   height,
+                                                   AV_PIX_FMT_RGBA,
+                                                   SWS_BILINEAR | SWS_FULL_CHR_H_INT);
+  if (!anim->img_scale_ctx) {
+    av_frame_free(&anim->pFrameScaledRGB);
+    return false;
+  }
+
+  ffmpeg_sws_setup_colorspace(anim, anim->img_scale_ctx);
+  return true;
+}
+
+/**
+ * Convert the decoded frame to RGB while scaling it down to the size of the given image buffer,
+ * then vertically flip it into the buffer.
+ */
+static void ffmpeg_postprocess_scaled(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
+{
+  if (!ffmpeg_scaled_frame_ensure(anim, ibuf->x, ibuf->y)) {
+    fprintf(stderr, "ffmpeg_fetchibuf: could not create scaled frame...\n");
+    return;
+  }
+
+  BKE_ffmpeg_sws_scale_frame(anim->img_scale_ctx, anim->pFrameScaledRGB, input);
+
+  /* Use negative line size to do vertical image flip. */
+  const int rgb_linesize = anim->pFrameScaledRGB->linesize[0];
+  const int src_linesize[4] = {-rgb_linesize, 0, 0, 0};
+  const uint8_t *const src[4] = {
+      anim->pFrameScaledRGB->data[0] + (ibuf->y - 1) * rgb_linesize, nullptr, nullptr, nullptr};
+  int dst_size = av_image_get_buffer_size(AV_PIX_FMT_RGBA, ibuf->x, ibuf->y, 1);
+  av_image_copy_to_buffer(
+      ibuf->byte_buffer.data, dst_size, src, src_linesize, AV_PIX_FMT_RGBA, ibuf->x, ibuf->y, 1);
+}
+
 /**
  * Postprocess the image in anim->pFrame and do color conversion and de-interlacing stuff.
  *
@@ -556,6 +695,14 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
     }
   }
 
+  if (ibuf->x != anim->x || ibuf->y != anim->y) {
+    ffmpeg_postprocess_scaled(anim, input, ibuf);
+    if (filter_y) {
+      IMB_filtery(ibuf);
+    }
+    return;
+  }
+
   /* If final destination image layout matches that of decoded RGB frame (including
    * any line padding done by ffmpeg for SIMD alignment), we can directly
    * decode into that, doing the vertical flip in the same step. Otherwise have
@@ -1081,7 +1228,56 @@ static bool ffmpeg_must_seek(ImBufAnim *anim, int position)
   return must_seek;
 }
 
-static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type tc)
+/**
+ * Download a frame decoded by the hardware decoder to system memory, software decoded frames are
+ * returned as is. The format of downloaded frames is only known once the first frame is
+ * downloaded, so the conversion contexts are recreated if it differs from the format they were
+ * created for.
+ */
+static AVFrame *ffmpeg_hw_frame_download(ImBufAnim *anim, AVFrame *frame)
+{
+  if (anim->hw_device_ctx == nullptr || frame->format != anim->hw_pix_fmt) {
+    return frame;
+  }
+
+  if (anim->pFrameDownloaded == nullptr) {
+    anim->pFrameDownloaded = av_frame_alloc();
+  }
+  av_frame_unref(anim->pFrameDownloaded);
+  if (av_hwframe_transfer_data(anim->pFrameDownloaded, frame, 0) < 0) {
+    fprintf(stderr, "ffmpeg_fetchibuf: could not download hardware frame...\n");
+    return nullptr;
+  }
+  av_frame_copy_props(anim->pFrameDownloaded, frame);
+
+  const int pix_fmt = anim->pFrameDownloaded->format;
+  if (pix_fmt != anim->sws_src_pix_fmt) {
+    SwsContext *sws_ctx = BKE_ffmpeg_sws_get_context(
+        anim->x, anim->y, pix_fmt, AV_PIX_FMT_RGBA, SWS_BILINEAR | SWS_FULL_CHR_H_INT);
+    if (sws_ctx == nullptr) {
+      return nullptr;
+    }
+    ffmpeg_sws_setup_colorspace(anim, sws_ctx);
+
+    BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    anim->img_convert_ctx = sws_ctx;
+    anim->sws_src_pix_fmt = pix_fmt;
+
+    /* The scaled frame context is recreated on demand for the new format. */
+    av_frame_free(&anim->pFrameScaledRGB);
+  }
+
+  return anim->pFrameDownloaded;
+}
+
+/**
+ * Fetch the frame at the given position, converted to an image of the original size multiplied
+ * by the given scale.
+ */
+static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim,
+                               int position,
+                               IMB_Timecode_Type tc,
+                               const float scale)
 {
   if (anim == nullptr) {
     return nullptr;
@@ -1134,18 +1330,26 @@ static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type
    * The issue was reported to FFmpeg under ticket #8747 in the FFmpeg tracker
    * and is fixed in the newer versions than 4.3.1. */
 
-  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(
+      AVPixelFormat(anim->sws_src_pix_fmt));
 
   int planes = R_IMF_PLANES_RGBA;
   if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
     planes = R_IMF_PLANES_RGB;
   }
 
-  ImBuf *cur_frame_final = IMB_allocImBuf(anim->x, anim->y, planes, 0);
+  int width = anim->x;
+  int height = anim->y;
+  if (scale < 1.0f) {
+    width = max_ii(1, int(width * scale));
+    height = max_ii(1, int(height * scale));
+  }
+
+  ImBuf *cur_frame_final = IMB_allocImBuf(width, height, planes, 0);
 
   /* Allocate the storage explicitly to ensure the memory is aligned. */
   uint8_t *buffer_data = static_cast<uint8_t *>(
-      MEM_mallocN_aligned(size_t(4) * anim->x * anim->y, 32, "ffmpeg ibuf"));
+      MEM_mallocN_aligned(size_t(4) * width * height, 32, "ffmpeg ibuf"));
   IMB_assign_byte_buffer(cur_frame_final, buffer_data, IB_TAKE_OWNERSHIP);
 
   cur_frame_final->byte_buffer.colorspace = colormanage_colorspace_get_named(anim->colorspace);
@@ -1156,6 +1360,9 @@ static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type
      * if it is incorrect. */
     final_frame = ffmpeg_double_buffer_frame_fallback_get(anim);
   }
+  if (final_frame != nullptr) {
+    final_frame = ffmpeg_hw_frame_download(anim, final_frame);
+  }
 
   /* Even with the fallback from above it is possible that the current decode frame is nullptr. In
    * this case skip post-processing and return current image buffer. */
@@ -1183,8 +1390,15 @@ static void free_anim_ffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrame_backup);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameScaledRGB);
+    av_frame_free(&anim->pFrameDownloaded);
     BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    if (anim->img_scale_ctx) {
+      BKE_ffmpeg_sws_release_context(anim->img_scale_ctx);
+      anim->img_scale_ctx = nullptr;
+    }
   }
+  av_buffer_unref(&anim->hw_device_ctx);
   anim->duration_in_frames = 0;
 }
 
@@ -1288,11 +1502,48 @@ ImBuf *IMB_anim_absolute(ImBufAnim *anim,
 
 #ifdef WITH_FFMPEG
   if (anim->state == ImBufAnim::State::Valid) {
-    ibuf = ffmpeg_fetchibuf(anim, position, tc);
+    ibuf = ffmpeg_fetchibuf(anim, position, tc, 1.0f);
+    if (ibuf) {
+      anim->cur_position = position;
+    }
+  }
+#endif
+
+  if (ibuf) {
+    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, anim->cur_position + 1);
+  }
+  return ibuf;
+}
+
+ImBuf *IMB_anim_absolute_scaled(ImBufAnim *anim,
+                                int position,
+                                IMB_Timecode_Type tc,
+                                const float scale)
+{
+  if (anim == nullptr) {
+    return nullptr;
+  }
+
+  if (anim->state == ImBufAnim::State::Uninitialized) {
+    if (!anim_getnew(anim)) {
+      return nullptr;
+    }
+  }
+
+  if (position < 0 || position >= anim->duration_in_frames) {
+    return nullptr;
+  }
+
+  ImBuf *ibuf = nullptr;
+#ifdef WITH_FFMPEG
+  if (anim->state == ImBufAnim::State::Valid) {
+    ibuf = ffmpeg_fetchibuf(anim, position, tc, scale);
     if (ibuf) {
       anim->cur_position = position;
     }
   }
+#else
+  UNUSED_VARS(tc, scale);
 #endif
 
   if (ibuf) {
@@ -9,6 +9,7 @@
 #include "IMB_colormanagement.hh"
 #include "IMB_colormanagement_intern.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -1809,6 +1810,7 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
                                           uchar *display_buffer_byte,
                                           ColormanageProcessor *cm_processor)
 {
+  using namespace blender;
   DisplayBufferInitData init_data;
 
   init_data.ibuf = ibuf;
@@ -1836,11 +1838,23 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
     init_data.float_colorspace = nullptr;
   }
 
-  IMB_processor_apply_threaded(ibuf->y,
-                               sizeof(DisplayBufferThread),
-                               &init_data,
-                               display_buffer_init_handle,
-                               do_display_buffer_apply_thread);
+  /* Process the image in blocks of rows that are small enough for the intermediate linear buffer
+   * to stay in the CPU cache between the conversion to linear, the display transform and the byte
+   * packing. The dither noise depends on the position within the processed rows, so dithered
+   * images are processed in one block per thread to avoid repeating the noise every block. */
+  const bool use_blocks = ibuf->dither == 0.0f;
+  const int64_t rows_per_block = max_ii(1, 16384 / max_ii(1, ibuf->x));
+  const int64_t grain_size = use_blocks ? rows_per_block :
+                                          divide_ceil_u(ibuf->y, BLI_system_thread_count());
+  threading::parallel_for(IndexRange(ibuf->y), grain_size, [&](const IndexRange y_range) {
+    const int64_t block_size = use_blocks ? rows_per_block : y_range.size();
+    for (int64_t start = y_range.first(); start < y_range.one_after_last(); start += block_size) {
+      const int64_t size = std::min(block_size, y_range.one_after_last() - start);
+      DisplayBufferThread handle;
+      display_buffer_init_handle(&handle, int(start), int(size), &init_data);
+      do_display_buffer_apply_thread(&handle);
+    }
+  });
 }
 
 static bool is_ibuf_rect_in_display_space(ImBuf *ibuf,
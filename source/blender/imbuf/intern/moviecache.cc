@@ -8,6 +8,7 @@
 
 #undef DEBUG_MESSAGES
 
+#include <atomic>
 #include <cstdlib> /* for qsort */
 #include <memory.h>
 #include <mutex>
@@ -43,6 +44,10 @@ static MEM_CacheLimiterC *limitor = nullptr;
  * so regular mutex will not work here, hence the recursive lock. */
 static std::recursive_mutex limitor_lock;
 
+/* Memory used by image caches which are not movie caches but share the same memory budget, like
+ * the sequencer cache, see #IMB_moviecache_external_memory_add. */
+static std::atomic<size_t> external_memory_in_use = 0;
+
 struct MovieCache {
   char name[64];
 
@@ -229,6 +234,11 @@ static int get_item_priority(void *item_v, int default_priority)
   return priority;
 }
 
+static size_t get_external_memory_in_use()
+{
+  return external_memory_in_use;
+}
+
 static bool get_item_destroyable(void *item_v)
 {
   MovieCacheItem *item = (MovieCacheItem *)item_v;
@@ -252,6 +262,7 @@ void IMB_moviecache_init()
 
   MEM_CacheLimiter_ItemPriority_Func_set(limitor, get_item_priority);
   MEM_CacheLimiter_ItemDestroyable_Func_set(limitor, get_item_destroyable);
+  MEM_CacheLimiter_ExternalMemory_Func_set(limitor, get_external_memory_in_use);
 }
 
 void IMB_moviecache_destruct()
@@ -378,7 +389,7 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   mem_limit = MEM_CacheLimiter_get_maximum();
 
   limitor_lock.lock();
-  mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
+  mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor) + external_memory_in_use;
 
   if (mem_in_use + elem_size <= mem_limit) {
     do_moviecache_put(cache, userkey, ibuf, false);
@@ -390,6 +401,30 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   return result;
 }
 
+void IMB_moviecache_external_memory_add(size_t size)
+{
+  external_memory_in_use += size;
+}
+
+void IMB_moviecache_external_memory_remove(size_t size)
+{
+  BLI_assert(external_memory_in_use >= size);
+  external_memory_in_use -= size;
+}
+
+size_t IMB_moviecache_get_memory_in_use()
+{
+  size_t mem_in_use = external_memory_in_use;
+
+  if (limitor) {
+    limitor_lock.lock();
+    mem_in_use += MEM_CacheLimiter_get_memory_in_use(limitor);
+    limitor_lock.unlock();
+  }
+
+  return mem_in_use;
+}
+
 void IMB_moviecache_remove(MovieCache *cache, void *userkey)
 {
   MovieCacheKey key;
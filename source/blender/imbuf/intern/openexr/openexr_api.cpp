@@ -1278,6 +1278,7 @@ void IMB_exr_read_channels(void *handle)
 
     /* Insert all matching channel into frame-buffer. */
     FrameBuffer frameBuffer;
+    int num_slices = 0;
 
     LISTBASE_FOREACH (ExrChannel *, echan, &data->channels) {
       if (echan->m->part_number != i) {
@@ -1309,9 +1310,17 @@ void IMB_exr_read_channels(void *handle)
 
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+        num_slices++;
       }
     }
 
+    /* OpenEXR still decompresses every line block of a part even when no slice uses it, so skip
+     * parts without any requested channel entirely. */
+    if (num_slices == 0) {
+      exr_printf("readPixels:readPixels[%d]: skipped, no channels requested\n", i);
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -7,8 +7,11 @@
  */
 
 #include <cmath>
+#include <type_traits>
 
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 #include "MEM_guardedalloc.h"
 
 #include "IMB_filter.hh"
@@ -748,21 +751,95 @@ static bool q_scale_linear_interpolation(ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
+/**
+ * The source pixels that contribute to one destination pixel when scaling down with a box filter
+ * along one axis. Pixels from #first to #last are added, the last one weighted by #last_weight.
+ * The pixel before #first was already added in full to the previous destination pixel, so its
+ * part that is outside of this destination pixel is subtracted using #prev_weight.
+ */
+struct ScaleDownStep {
+  int first;
+  int last;
+  float prev_weight;
+  float last_weight;
+};
+
+struct ScaleDownSchedule {
+  /* Number of source pixels per destination pixel. */
+  float add;
+  blender::Vector<ScaleDownStep> steps;
+};
+
+/**
+ * The weights only depend on the position along the scaled axis, so they are computed once and
+ * shared by all lines of the image, which can then be scaled independently of each other.
+ */
+static ScaleDownSchedule scale_down_schedule(const int old_size, const int new_size)
+{
+  ScaleDownSchedule schedule;
+  schedule.add = (old_size - 0.01) / new_size;
+  schedule.steps.resize(new_size);
+
+  float sample = 0.0f;
+  int index = 0;
+  for (ScaleDownStep &step : schedule.steps) {
+    step.prev_weight = sample;
+    sample += schedule.add;
+
+    step.first = index;
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+      index++;
+    }
+    step.last = index;
+    step.last_weight = sample;
+
+    index++;
+    sample -= 1.0f;
+  }
+  BLI_assert(index == old_size); /* see bug #26502. */
+
+  return schedule;
+}
+
+/**
+ * Compute the destination values of a step from source lines of the given size, which are
+ * src_stride values apart in the source buffer.
+ */
+template<typename T>
+static void scale_down_step(const ScaleDownStep &step,
+                            const float add,
+                            const T *src,
+                            const int64_t src_stride,
+                            const int64_t size,
+                            T *dst)
+{
+  const T *prev = step.first > 0 ? src + (step.first - 1) * src_stride : nullptr;
+  const T *last = src + step.last * src_stride;
+  for (int64_t i = 0; i < size; i++) {
+    float value = prev ? -float(prev[i]) * step.prev_weight : 0.0f;
+    for (int j = step.first; j < step.last; j++) {
+      value += src[j * src_stride + i];
+    }
+    value = (value + step.last_weight * last[i]) / add;
+
+    if constexpr (std::is_same_v<T, uchar>) {
+      dst[i] = roundf(value);
+    }
+    else {
+      dst[i] = value;
+    }
+  }
+}
+
 static ImBuf *scaledownx(ImBuf *ibuf, int newx)
 {
+  using namespace blender;
   const bool do_rect = (ibuf->byte_buffer.data != nullptr);
   const bool do_float = (ibuf->float_buffer.data != nullptr);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
 
-  rectf = _newrectf = newrectf = nullptr;
-  rect = _newrect = newrect = nullptr;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = nullptr;
+  float *_newrectf = nullptr;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -785,127 +862,55 @@ static ImBuf *scaledownx(ImBuf *ibuf, int newx)
     }
   }
 
-  add = (ibuf->x - 0.01) / newx;
-
-  if (do_rect) {
-    rect = ibuf->byte_buffer.data;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->float_buffer.data;
-    newrectf = _newrectf;
-  }
-
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
-
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+  const ScaleDownSchedule schedule = scale_down_schedule(ibuf->x, newx);
+  const int64_t src_row_size = int64_t(ibuf->x) * 4;
+  const int64_t dst_row_size = int64_t(newx) * 4;
 
+  threading::parallel_for(IndexRange(ibuf->y), 16, [&](const IndexRange y_range) {
+    for (const int64_t y : y_range) {
+      for (const int x : IndexRange(newx)) {
+        const ScaleDownStep &step = schedule.steps[x];
         if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
+          scale_down_step(step,
+                          schedule.add,
+                          ibuf->byte_buffer.data + y * src_row_size,
+                          4,
+                          4,
+                          _newrect + y * dst_row_size + x * 4);
         }
         if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
+          scale_down_step(step,
+                          schedule.add,
+                          ibuf->float_buffer.data + y * src_row_size,
+                          4,
+                          4,
+                          _newrectf + y * dst_row_size + x * 4);
         }
       }
-
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += 4;
-      }
-      if (do_float) {
-
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
-
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
-
-        newrectf += 4;
-      }
-
-      sample -= 1.0f;
     }
-  }
+  });
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ibuf->byte_buffer.data, rect_size);
-    BLI_assert((uchar *)rect - ibuf->byte_buffer.data == rect_size); /* see bug #26502. */
-
     imb_freerectImBuf(ibuf);
     IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->float_buffer.data, rect_size);
-    BLI_assert((rectf - ibuf->float_buffer.data) == rect_size); /* see bug #26502. */
-
     imb_freerectfloatImBuf(ibuf);
     IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
   }
 
-  (void)rect_size; /* UNUSED in release builds */
-
   ibuf->x = newx;
   return ibuf;
 }
 
 static ImBuf *scaledowny(ImBuf *ibuf, int newy)
 {
+  using namespace blender;
   const bool do_rect = (ibuf->byte_buffer.data != nullptr);
   const bool do_float = (ibuf->float_buffer.data != nullptr);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
 
-  rectf = _newrectf = newrectf = nullptr;
-  rect = _newrect = newrect = nullptr;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = nullptr;
+  float *_newrectf = nullptr;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -928,109 +933,42 @@ static ImBuf *scaledowny(ImBuf *ibuf, int newy)
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ibuf->byte_buffer.data + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->float_buffer.data + x;
-      newrectf = _newrectf + x;
-    }
-
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
-
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+  /* Whole source rows are combined into each destination row, which is more cache friendly than
+   * walking the image column by column. */
+  const ScaleDownSchedule schedule = scale_down_schedule(ibuf->y, newy);
+  const int64_t row_size = int64_t(ibuf->x) * 4;
 
+  threading::parallel_for(IndexRange(newy), 4, [&](const IndexRange y_range) {
+    for (const int64_t y : y_range) {
+      const ScaleDownStep &step = schedule.steps[y];
       if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += skipx;
+        scale_down_step(step,
+                        schedule.add,
+                        ibuf->byte_buffer.data,
+                        row_size,
+                        row_size,
+                        _newrect + y * row_size);
       }
       if (do_float) {
-
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
-
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
-
-        newrectf += skipx;
+        scale_down_step(step,
+                        schedule.add,
+                        ibuf->float_buffer.data,
+                        row_size,
+                        row_size,
+                        _newrectf + y * row_size);
       }
-
-      sample -= 1.0f;
     }
-  }
+  });
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - byte_buffer.data, rect_size);
-    BLI_assert((uchar *)rect - ibuf->byte_buffer.data == rect_size); /* see bug #26502. */
-
     imb_freerectImBuf(ibuf);
     IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->float_buffer.data, rect_size);
-    BLI_assert((rectf - ibuf->float_buffer.data) == rect_size); /* see bug #26502. */
-
     imb_freerectfloatImBuf(ibuf);
     IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
   }
 
-  (void)rect_size; /* UNUSED in release builds */
-
   ibuf->y = newy;
   return ibuf;
 }
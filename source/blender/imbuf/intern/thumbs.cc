@@ -285,6 +285,21 @@ static bool thumbpathname_from_uri(const char *uri,
   return false;
 }
 
+/** Construct the path of an already hashed thumbnail name, see #thumbname_from_uri. */
+static bool thumbpath_from_name(const char *name,
+                                char *r_path,
+                                const int path_maxncpy,
+                                ThumbSize size)
+{
+  char tmppath[FILE_MAX];
+
+  if (get_thumb_dir(tmppath, size)) {
+    BLI_snprintf(r_path, path_maxncpy, "%s%s", tmppath, name);
+    return true;
+  }
+  return false;
+}
+
 static void thumbname_from_uri(const char *uri, char *thumb, const int thumb_maxncpy)
 {
   thumbpathname_from_uri(uri, nullptr, 0, thumb, thumb_maxncpy, THB_FAIL);
@@ -530,6 +545,31 @@ void IMB_thumb_delete(const char *file_or_lib_path, ThumbSize size)
   }
 }
 
+/**
+ * Check for a failure thumbnail of a file which is not older than the file itself, in which case
+ * creating the thumbnail is not attempted again. Out of date failure thumbnails are removed.
+ *
+ * Failure thumbnails are only written when there is no regular thumbnail, so this is only checked
+ * once loading the regular thumbnail failed, saving a file system access for every file that
+ * already has a thumbnail.
+ */
+static bool thumb_fail_is_up_to_date(const char *thumb_name, const char *file_path)
+{
+  char thumb_path[FILE_MAX];
+  if (!thumbpath_from_name(thumb_name, thumb_path, sizeof(thumb_path), THB_FAIL)) {
+    return false;
+  }
+  if (!BLI_exists(thumb_path)) {
+    return false;
+  }
+  /* Clear out of date fail case (note for blen IDs we use blender file itself here). */
+  if (BLI_file_older(thumb_path, file_path)) {
+    BLI_delete(thumb_path, false, false);
+    return false;
+  }
+  return true;
+}
+
 ImBuf *IMB_thumb_manage(const char *file_or_lib_path, ThumbSize size, ThumbSource source)
 {
   char path_buff[FILE_MAX_LIBEXTRA];
@@ -559,35 +599,23 @@ ImBuf *IMB_thumb_manage(const char *file_or_lib_path, ThumbSize size, ThumbSourc
     return nullptr;
   }
 
+  /* The hashed name is the same for all thumbnail sizes, only compute it once. */
+  char thumb_name[40];
+  thumbname_from_uri(uri, thumb_name, sizeof(thumb_name));
+
   /* Don't access offline files, only use already existing thumbnails (don't recreate). */
   const eFileAttributes file_attributes = BLI_file_attributes(file_path);
   if (file_attributes & FILE_ATTR_OFFLINE) {
     char thumb_path[FILE_MAX];
-    if (thumbpath_from_uri(uri, thumb_path, sizeof(thumb_path), size)) {
+    if (thumbpath_from_name(thumb_name, thumb_path, sizeof(thumb_path), size)) {
       return IMB_loadiffname(thumb_path, IB_rect | IB_metadata, nullptr);
     }
     return nullptr;
   }
 
-  char thumb_path[FILE_MAX];
-  if (thumbpath_from_uri(uri, thumb_path, sizeof(thumb_path), THB_FAIL)) {
-    /* failure thumb exists, don't try recreating */
-    if (BLI_exists(thumb_path)) {
-      /* clear out of date fail case (note for blen IDs we use blender file itself here) */
-      if (BLI_file_older(thumb_path, file_path)) {
-        BLI_delete(thumb_path, false, false);
-      }
-      else {
-        return nullptr;
-      }
-    }
-  }
-
   ImBuf *img = nullptr;
-  char thumb_name[40];
-  if (thumbpathname_from_uri(
-          uri, thumb_path, sizeof(thumb_path), thumb_name, sizeof(thumb_name), size))
-  {
+  char thumb_path[FILE_MAX];
+  if (thumbpath_from_name(thumb_name, thumb_path, sizeof(thumb_path), size)) {
     /* The requested path points to a generated thumbnail already (path into the thumbnail cache
      * directory). Attempt to load that, there's nothing we can recreate. */
     if (BLI_path_ncmp(file_or_lib_path, thumb_path, sizeof(thumb_path)) == 0) {
@@ -634,7 +662,7 @@ ImBuf *IMB_thumb_manage(const char *file_or_lib_path, ThumbSize size, ThumbSourc
               file_path, uri, thumb_name, use_hash, thumb_hash, blen_group, blen_id, size, source);
         }
       }
-      else {
+      else if (!thumb_fail_is_up_to_date(thumb_name, file_path)) {
         char thumb_hash[33];
         const bool use_hash = thumbhash_from_path(file_path, source, thumb_hash);
 
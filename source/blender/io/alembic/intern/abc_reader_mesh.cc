@@ -122,6 +122,10 @@ struct AbcMeshData {
   AbcUvScope uv_scope;
   V2fArraySamplePtr uvs;
   UInt32ArraySamplePtr uvs_indices;
+
+  /* When true, the face offsets and corner vertices of the mesh already match the sample, so
+   * only the per-corner data is read. */
+  bool use_existing_topology = false;
 };
 
 static void read_mverts_interp(float3 *vert_positions,
@@ -194,6 +198,11 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   const bool do_uvs = (mloopuvs && uvs && uvs_indices);
   const bool do_uvs_per_loop = do_uvs && mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
   BLI_assert(!do_uvs || mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
+  const bool use_existing_topology = mesh_data.use_existing_topology;
+  if (use_existing_topology && !do_uvs) {
+    return;
+  }
+
   uint loop_index = 0;
   uint rev_loop_index = 0;
   uint uv_index = 0;
@@ -202,7 +211,9 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   for (int i = 0; i < face_counts->size(); i++) {
     const int face_size = (*face_counts)[i];
 
-    face_offsets[i] = loop_index;
+    if (!use_existing_topology) {
+      face_offsets[i] = loop_index;
+    }
 
     /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be flat-shaded,
      * this is encoded in custom loop normals. See #71246. */
@@ -213,7 +224,9 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     uint last_vertex_index = 0;
     for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
       const int vert = (*face_indices)[loop_index];
-      corner_verts[rev_loop_index] = vert;
+      if (!use_existing_topology) {
+        corner_verts[rev_loop_index] = vert;
+      }
 
       if (f > 0 && vert == last_vertex_index) {
         /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
@@ -236,6 +249,10 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     }
   }
 
+  if (use_existing_topology) {
+    return;
+  }
+
   bke::mesh_calc_edges(*config.mesh, false, false);
   if (seen_invalid_geometry) {
     if (config.modifier_error_message) {
@@ -435,11 +452,13 @@ static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
                              const ISampleSelector &selector,
-                             CDStreamConfig &config)
+                             CDStreamConfig &config,
+                             const bool use_existing_topology)
 {
   const IPolyMeshSchema::Sample sample = schema.getValue(selector);
 
   AbcMeshData abc_mesh_data;
+  abc_mesh_data.use_existing_topology = use_existing_topology;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
   abc_mesh_data.positions = sample.getPositions();
@@ -485,13 +504,21 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 }
 
-static CDStreamConfig get_config(Mesh *mesh)
+static CDStreamConfig get_config(Mesh *mesh, const bool use_existing_topology = false)
 {
   CDStreamConfig config;
   config.mesh = mesh;
   config.positions = mesh->vert_positions_for_write().data();
-  config.corner_verts = mesh->corner_verts_for_write().data();
-  config.face_offsets = mesh->face_offsets_for_write().data();
+  if (use_existing_topology) {
+    /* The topology is only read, so keep sharing its arrays with other meshes instead of making
+     * a copy of them for writing. */
+    config.corner_verts = const_cast<int *>(mesh->corner_verts().data());
+    config.face_offsets = const_cast<int *>(mesh->face_offsets().data());
+  }
+  else {
+    config.corner_verts = mesh->corner_verts_for_write().data();
+    config.face_offsets = mesh->face_offsets_for_write().data();
+  }
   config.totvert = mesh->verts_num;
   config.totloop = mesh->corners_num;
   config.faces_num = mesh->faces_num;
@@ -751,6 +778,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
+  /* Whether the faces of the existing mesh match the sample, in which case they are kept. */
+  bool use_existing_topology = false;
+
   if (topology_changed(existing_mesh, sample_sel)) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, face_counts->size(), face_indices->size());
@@ -772,14 +802,18 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
             "read!");
       }
     }
+    else {
+      use_existing_topology = true;
+    }
   }
 
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
-  CDStreamConfig config = get_config(mesh_to_export);
+  CDStreamConfig config = get_config(mesh_to_export, use_existing_topology);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(
+      m_iobject.getFullName(), &settings, m_schema, sample_sel, config, use_existing_topology);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -22,6 +22,8 @@
 
 #include "IO_dupli_persistent_id.hh"
 
+#include "BLI_span.hh"
+
 #include "DEG_depsgraph.hh"
 
 #include <map>
@@ -254,9 +256,10 @@ class AbstractHierarchyIterator {
   void export_graph_clear();
 
   void visit_object(Object *object, Object *export_parent, bool weak_export);
-  void visit_dupli_object(DupliObject *dupli_object,
-                          Object *duplicator,
-                          const DupliParentFinder &dupli_parent_finder);
+  void visit_dupli_objects(Span<DupliObject *> dupli_objects,
+                           Object *duplicator,
+                           const DupliParentFinder &dupli_parent_finder);
+  HierarchyContext *create_dupli_context(DupliObject *dupli_object, Object *duplicator) const;
 
   void context_update_for_graph_index(HierarchyContext *context,
                                       const ExportGraph::key_type &graph_index) const;
@@ -310,6 +313,7 @@ class AbstractHierarchyIterator {
   virtual bool should_visit_dupli_object(const DupliObject *dupli_object) const;
 
   virtual ExportGraph::key_type determine_graph_index_object(const HierarchyContext *context);
+  /* Called for many duplicated objects in parallel, so it should only read shared data. */
   virtual ExportGraph::key_type determine_graph_index_dupli(
       const HierarchyContext *context,
       const DupliObject *dupli_object,
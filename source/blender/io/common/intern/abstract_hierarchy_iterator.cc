@@ -7,6 +7,7 @@
 #include <climits>
 #include <cstdio>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -16,9 +17,12 @@
 #include "BKE_object.hh"
 #include "BKE_particle.h"
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -289,21 +293,17 @@ void AbstractHierarchyIterator::export_graph_construct()
     ListBase *lb = object_duplilist(depsgraph_, scene, object);
     if (lb) {
       DupliParentFinder dupli_parent_finder;
+      Vector<DupliObject *> dupli_objects;
 
       LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        PersistentID persistent_id(dupli_object);
         if (!should_visit_dupli_object(dupli_object)) {
           continue;
         }
         dupli_parent_finder.insert(dupli_object);
+        dupli_objects.append(dupli_object);
       }
 
-      LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        if (!should_visit_dupli_object(dupli_object)) {
-          continue;
-        }
-        visit_dupli_object(dupli_object, object, dupli_parent_finder);
-      }
+      visit_dupli_objects(dupli_objects, object, dupli_parent_finder);
     }
 
     free_object_duplilist(lb);
@@ -440,9 +440,32 @@ AbstractHierarchyIterator::ExportGraph::key_type AbstractHierarchyIterator::
   return ObjectIdentifier::for_real_object(context->export_parent);
 }
 
-void AbstractHierarchyIterator::visit_dupli_object(DupliObject *dupli_object,
-                                                   Object *duplicator,
-                                                   const DupliParentFinder &dupli_parent_finder)
+void AbstractHierarchyIterator::visit_dupli_objects(const Span<DupliObject *> dupli_objects,
+                                                    Object *duplicator,
+                                                    const DupliParentFinder &dupli_parent_finder)
+{
+  /* Creating the contexts, including their export names and graph indices, only reads shared
+   * data, so it is done in parallel. This is the expensive part for large amounts of instances.
+   * Only the insertion into the export graph is done serially. */
+  Array<HierarchyContext *> contexts(dupli_objects.size());
+  Array<std::optional<ExportGraph::key_type>> graph_indices(dupli_objects.size());
+  threading::parallel_for(dupli_objects.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      HierarchyContext *context = create_dupli_context(dupli_objects[i], duplicator);
+      graph_indices[i] = determine_graph_index_dupli(
+          context, dupli_objects[i], dupli_parent_finder);
+      context_update_for_graph_index(context, *graph_indices[i]);
+      contexts[i] = context;
+    }
+  });
+
+  for (const int64_t i : contexts.index_range()) {
+    export_graph_[*graph_indices[i]].insert(contexts[i]);
+  }
+}
+
+HierarchyContext *AbstractHierarchyIterator::create_dupli_context(DupliObject *dupli_object,
+                                                                  Object *duplicator) const
 {
   HierarchyContext *context = new HierarchyContext();
   context->object = dupli_object->ob;
@@ -461,11 +484,7 @@ void AbstractHierarchyIterator::visit_dupli_object(DupliObject *dupli_object,
                      << context->persistent_id.as_object_name_suffix();
   context->export_name = make_valid_name(export_name_stream.str());
 
-  ExportGraph::key_type graph_index = determine_graph_index_dupli(
-      context, dupli_object, dupli_parent_finder);
-  context_update_for_graph_index(context, graph_index);
-
-  export_graph_[graph_index].insert(context);
+  return context;
 }
 
 AbstractHierarchyIterator::ExportGraph::key_type AbstractHierarchyIterator::
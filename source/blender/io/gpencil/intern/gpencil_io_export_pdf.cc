@@ -108,6 +108,7 @@ bool GpencilExporterPDF::create_document()
     std::cout << "error: cannot create PdfDoc object\n";
     return false;
   }
+  alpha_states_.clear();
   return true;
 }
 
@@ -280,14 +281,30 @@ void GpencilExporterPDF::export_stroke_to_polyline(bGPdata *gpd,
   HPDF_Page_GRestore(page_);
 }
 
+HPDF_ExtGState GpencilExporterPDF::alpha_state_get(const float opacity, const bool do_fill)
+{
+  /* Long frame ranges contain many translucent strokes, creating a new graphic state object for
+   * each of them grows the document with identical objects. */
+  const int alpha = int(clamp_f(opacity, 0.0f, 1.0f) * 255.0f + 0.5f);
+  if (alpha == 255) {
+    return nullptr;
+  }
+  return alpha_states_.lookup_or_add_cb(alpha * 2 + int(do_fill), [&]() {
+    HPDF_ExtGState gstate = HPDF_CreateExtGState(pdf_);
+    HPDF_ExtGState_SetAlphaFill(gstate, float(alpha) / 255.0f);
+    if (!do_fill) {
+      HPDF_ExtGState_SetAlphaStroke(gstate, float(alpha) / 255.0f);
+    }
+    return gstate;
+  });
+}
+
 void GpencilExporterPDF::color_set(bGPDlayer *gpl, const bool do_fill)
 {
   const float fill_opacity = fill_color_[3] * gpl->opacity;
   const float stroke_opacity = stroke_color_[3] * stroke_average_opacity_get() * gpl->opacity;
-  const bool need_state = (do_fill && fill_opacity < 1.0f) || (stroke_opacity < 1.0f);
 
   HPDF_Page_GSave(page_);
-  HPDF_ExtGState gstate = (need_state) ? HPDF_CreateExtGState(pdf_) : nullptr;
 
   float3 col;
   if (do_fill) {
@@ -295,9 +312,6 @@ void GpencilExporterPDF::color_set(bGPDlayer *gpl, const bool do_fill)
     linearrgb_to_srgb_v3_v3(col, col);
     col = math::clamp(col, 0.0f, 1.0f);
     HPDF_Page_SetRGBFill(page_, col[0], col[1], col[2]);
-    if (gstate) {
-      HPDF_ExtGState_SetAlphaFill(gstate, clamp_f(fill_opacity, 0.0f, 1.0f));
-    }
   }
   else {
     interp_v3_v3v3(col, stroke_color_, gpl->tintcolor, gpl->tintcolor[3]);
@@ -306,11 +320,8 @@ void GpencilExporterPDF::color_set(bGPDlayer *gpl, const bool do_fill)
 
     HPDF_Page_SetRGBFill(page_, col[0], col[1], col[2]);
     HPDF_Page_SetRGBStroke(page_, col[0], col[1], col[2]);
-    if (gstate) {
-      HPDF_ExtGState_SetAlphaFill(gstate, clamp_f(stroke_opacity, 0.0f, 1.0f));
-      HPDF_ExtGState_SetAlphaStroke(gstate, clamp_f(stroke_opacity, 0.0f, 1.0f));
-    }
   }
+  HPDF_ExtGState gstate = alpha_state_get(do_fill ? fill_opacity : stroke_opacity, do_fill);
   if (gstate) {
     HPDF_Page_SetExtGState(page_, gstate);
   }
@@ -7,6 +7,8 @@
  * \ingroup bgpencil
  */
 
+#include "BLI_map.hh"
+
 #include "gpencil_io_export_base.hh"
 #include "hpdf.h"
 
@@ -34,6 +36,11 @@ class GpencilExporterPDF : public GpencilExporter {
   HPDF_Doc pdf_;
   /** PDF page. */
   HPDF_Page page_;
+  /**
+   * Graphic states for translucent strokes, shared by all pages of the document. The key is the
+   * opacity quantized to 8 bits, with the lowest bit telling whether it applies to fills only.
+   */
+  Map<int, HPDF_ExtGState> alpha_states_;
 
   /** Create PDF document. */
   bool create_document();
@@ -53,6 +60,8 @@ class GpencilExporterPDF : public GpencilExporter {
    * \param do_fill: True if the stroke is only fill.
    */
   void color_set(bGPDlayer *gpl, bool do_fill);
+  /** Get the shared graphic state for the opacity, or null when the color is opaque. */
+  HPDF_ExtGState alpha_state_get(float opacity, bool do_fill);
 };
 
 }  // namespace blender::io::gpencil
@@ -7,6 +7,9 @@
  */
 
 #include <algorithm>
+#include <iterator>
+
+#include <fmt/format.h>
 
 #include "BLI_math_color.h"
 #include "BLI_math_matrix.h"
@@ -44,6 +47,13 @@
 
 namespace blender ::io ::gpencil {
 
+/* Append the coordinates with the same precision as `std::to_string`, without creating temporary
+ * strings for every point of the stroke. */
+static void append_point(std::string &txt, const float2 &co)
+{
+  fmt::format_to(std::back_inserter(txt), "{:f},{:f}", co.x, co.y);
+}
+
 /* Constructor. */
 GpencilExporterSVG::GpencilExporterSVG(const char *filepath, const GpencilIOParams *iparams)
     : GpencilExporter(iparams)
@@ -270,13 +280,14 @@ void GpencilExporterSVG::export_stroke_to_path(bGPDlayer *gpl,
   node_gps.append_attribute("stroke").set_value("none");
 
   std::string txt = "M";
+  txt.reserve(size_t(gps->totpoints) * 24);
   for (const int i : IndexRange(gps->totpoints)) {
     if (i > 0) {
       txt.append("L");
     }
     bGPDspoint &pt = gps->points[i];
     const float2 screen_co = gpencil_3D_point_to_2D(&pt.x);
-    txt.append(std::to_string(screen_co.x) + "," + std::to_string(screen_co.y));
+    append_point(txt, screen_co);
   }
   /* Close patch (cyclic). */
   if (gps->flag & GP_STROKE_CYCLIC) {
@@ -322,13 +333,14 @@ void GpencilExporterSVG::export_stroke_to_polyline(bGPdata *gpd,
   }
 
   std::string txt;
+  txt.reserve(size_t(gps->totpoints) * 24);
   for (const int i : IndexRange(gps->totpoints)) {
     if (i > 0) {
       txt.append(" ");
     }
     bGPDspoint *pt = &gps->points[i];
     const float2 screen_co = gpencil_3D_point_to_2D(&pt->x);
-    txt.append(std::to_string(screen_co.x) + "," + std::to_string(screen_co.y));
+    append_point(txt, screen_co);
   }
 
   node_gps.append_attribute("points").set_value(txt.c_str());
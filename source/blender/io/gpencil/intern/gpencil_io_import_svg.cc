@@ -13,6 +13,8 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_gpencil_legacy_types.h"
 
@@ -70,6 +72,7 @@ bool GpencilImporterSVG::read()
   rescale_m4(matrix, scale);
 
   /* Loop all shapes. */
+  Vector<StrokeData> strokes;
   char prv_id[70] = {"*"};
   int prefix = 0;
   for (NSVGshape *shape = svg_data->shapes; shape; shape = shape->next) {
@@ -116,12 +119,20 @@ bool GpencilImporterSVG::read()
     }
     int32_t mat_index = create_material(mat_names[index], is_stroke, is_fill);
 
-    /* Loop all paths to create the stroke data. */
+    /* Loop all paths to allocate the strokes, their points are computed afterwards. */
     for (NSVGpath *path = shape->paths; path; path = path->next) {
-      create_stroke(gpd_, gpf, shape, path, mat_index, matrix);
+      bGPDstroke *gps = create_stroke(gpf, shape, path, mat_index);
+      strokes.append({gps, gpf, shape, path});
     }
   }
 
+  /* Each stroke only touches its own points, so the paths can be tessellated in parallel. */
+  threading::parallel_for(strokes.index_range(), 64, [&](const IndexRange range) {
+    for (const StrokeData &stroke : strokes.as_span().slice(range)) {
+      fill_stroke(gpd_, stroke.gpf, stroke.gps, stroke.shape, stroke.path, matrix);
+    }
+  });
+
   /* Free SVG memory. */
   nsvgDelete(svg_data);
 
@@ -129,34 +140,28 @@ bool GpencilImporterSVG::read()
   float gp_center[3];
   BKE_gpencil_centroid_3d(gpd_, gp_center);
 
-  LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd_->layers) {
-    LISTBASE_FOREACH (bGPDframe *, gpf, &gpl->frames) {
-      LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-        for (bGPDspoint &pt : MutableSpan(gps->points, gps->totpoints)) {
-          sub_v3_v3(&pt.x, gp_center);
-        }
-        /* Calc stroke bounding box. */
-        BKE_gpencil_stroke_boundingbox_calc(gps);
+  threading::parallel_for(strokes.index_range(), 256, [&](const IndexRange range) {
+    for (const StrokeData &stroke : strokes.as_span().slice(range)) {
+      bGPDstroke *gps = stroke.gps;
+      for (bGPDspoint &pt : MutableSpan(gps->points, gps->totpoints)) {
+        sub_v3_v3(&pt.x, gp_center);
       }
+      /* Calc stroke bounding box. */
+      BKE_gpencil_stroke_boundingbox_calc(gps);
     }
-  }
+  });
 
   return result;
 }
 
-void GpencilImporterSVG::create_stroke(bGPdata *gpd,
-                                       bGPDframe *gpf,
-                                       NSVGshape *shape,
-                                       NSVGpath *path,
-                                       const int32_t mat_index,
-                                       const float matrix[4][4])
+bGPDstroke *GpencilImporterSVG::create_stroke(bGPDframe *gpf,
+                                              NSVGshape *shape,
+                                              NSVGpath *path,
+                                              const int32_t mat_index)
 {
   const bool is_stroke = bool(shape->stroke.type);
   const bool is_fill = bool(shape->fill.type);
 
-  const int edges = params_.resolution;
-  const float step = 1.0f / float(edges - 1);
-
   const int totpoints = (path->npts / 3) * params_.resolution;
 
   bGPDstroke *gps = BKE_gpencil_stroke_new(mat_index, totpoints, 1.0f);
@@ -176,9 +181,36 @@ void GpencilImporterSVG::create_stroke(bGPdata *gpd,
     gps->vert_color_fill[3] = 1.0f;
   }
 
+  return gps;
+}
+
+void GpencilImporterSVG::fill_stroke(bGPdata *gpd,
+                                     bGPDframe *gpf,
+                                     bGPDstroke *gps,
+                                     const NSVGshape *shape,
+                                     const NSVGpath *path,
+                                     const float matrix[4][4])
+{
+  const bool is_stroke = bool(shape->stroke.type);
+  const bool is_fill = bool(shape->fill.type);
+
+  const int edges = params_.resolution;
+  const float step = 1.0f / float(edges - 1);
+
+  /* The vertex color is the same for all points of the path. */
+  float vert_color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  if (is_fill) {
+    convert_color(shape->fill.color, vert_color);
+  }
+  if (is_stroke) {
+    convert_color(shape->stroke.color, vert_color);
+    gps->fill_opacity_fac = vert_color[3];
+  }
+  vert_color[3] = 1.0f;
+
   int start_index = 0;
   for (int i = 0; i < path->npts - 1; i += 3) {
-    float *p = &path->pts[i * 2];
+    const float *p = &path->pts[i * 2];
     float a = 0.0f;
     for (int v = 0; v < edges; v++) {
       bGPDspoint *pt = &gps->points[start_index];
@@ -193,16 +225,7 @@ void GpencilImporterSVG::create_stroke(bGPdata *gpd,
       mul_m4_v3(matrix, &pt->x);
 
       /* Apply color to vertex color. */
-      if (is_fill) {
-        NSVGpaint fill = shape->fill;
-        convert_color(fill.color, pt->vert_color);
-      }
-      if (is_stroke) {
-        NSVGpaint stroke = shape->stroke;
-        convert_color(stroke.color, pt->vert_color);
-        gps->fill_opacity_fac = pt->vert_color[3];
-      }
-      pt->vert_color[3] = 1.0f;
+      copy_v4_v4(pt->vert_color, vert_color);
 
       a += step;
       start_index++;
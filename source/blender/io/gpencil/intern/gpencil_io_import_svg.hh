@@ -12,6 +12,7 @@ struct GpencilIOParams;
 struct NSVGpath;
 struct NSVGshape;
 struct bGPDframe;
+struct bGPDstroke;
 struct bGPdata;
 
 #define SVG_IMPORTER_NAME "SVG Import for Grease Pencil"
@@ -28,12 +29,23 @@ class GpencilImporterSVG : public GpencilImporter {
 
  protected:
  private:
-  void create_stroke(bGPdata *gpd_,
-                     bGPDframe *gpf,
-                     NSVGshape *shape,
-                     NSVGpath *path,
-                     int32_t mat_index,
-                     const float matrix[4][4]);
+  /** A stroke allocated for a path, with its points still to be computed. */
+  struct StrokeData {
+    bGPDstroke *gps;
+    bGPDframe *gpf;
+    const NSVGshape *shape;
+    const NSVGpath *path;
+  };
+
+  /** Add a stroke sized for the tessellated path to the frame. */
+  bGPDstroke *create_stroke(bGPDframe *gpf, NSVGshape *shape, NSVGpath *path, int32_t mat_index);
+  /** Tessellate the path into the points of the stroke, can run for several strokes at once. */
+  void fill_stroke(bGPdata *gpd,
+                   bGPDframe *gpf,
+                   bGPDstroke *gps,
+                   const NSVGshape *shape,
+                   const NSVGpath *path,
+                   const float matrix[4][4]);
 
   void convert_color(int32_t color, float r_linear_rgba[4]);
 };
@@ -16,8 +16,10 @@
 #include "BKE_report.hh"
 #include "BKE_scene.hh"
 
+#include "BLI_array.hh"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph_query.hh"
 
@@ -122,19 +124,31 @@ void export_frame(Depsgraph *depsgraph,
     mul_v3_m3v3(xform[3], axes_transform, obj_eval->object_to_world().location());
     xform[3][3] = obj_eval->object_to_world()[3][3];
 
-    /* Write triangles. */
+    /* Write triangles. They are transformed in parallel in batches of limited size, so that
+     * large meshes don't need a copy of all their triangles in memory. */
     const Span<float3> positions = mesh->vert_positions();
     const Span<int> corner_verts = mesh->corner_verts();
-    for (const int3 &tri : mesh->corner_tris()) {
-      PackedTriangle data{};
-      for (int i = 0; i < 3; i++) {
-        float3 pos = positions[corner_verts[tri[i]]];
-        mul_m4_v3(xform, pos);
-        pos *= global_scale;
-        data.vertices[i] = pos;
-      }
-      data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
-      writer->write_triangle(data);
+    const Span<int3> corner_tris = mesh->corner_tris();
+    const int64_t batch_size = 1 << 16;
+    Array<PackedTriangle> batch(std::min(corner_tris.size(), batch_size));
+    for (int64_t batch_start = 0; batch_start < corner_tris.size(); batch_start += batch_size) {
+      const IndexRange batch_range = corner_tris.index_range().drop_front(batch_start).take_front(
+          batch_size);
+      threading::parallel_for(batch_range.index_range(), 4096, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          const int3 &tri = corner_tris[batch_range[i]];
+          PackedTriangle &data = batch[i];
+          data = {};
+          for (int j = 0; j < 3; j++) {
+            float3 pos = positions[corner_verts[tri[j]]];
+            mul_m4_v3(xform, pos);
+            pos *= global_scale;
+            data.vertices[j] = pos;
+          }
+          data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
+        }
+      });
+      writer->write_triangles(batch.as_span().take_front(batch_range.size()));
     }
   }
   DEG_OBJECT_ITER_END;
@@ -87,4 +87,17 @@ void FileWriter::write_triangle(const PackedTriangle &data)
   }
 }
 
+void FileWriter::write_triangles(const Span<PackedTriangle> tris)
+{
+  if (ascii_) {
+    for (const PackedTriangle &data : tris) {
+      this->write_triangle(data);
+    }
+  }
+  else {
+    tris_num_ += uint32_t(tris.size());
+    fwrite(tris.data(), sizeof(PackedTriangle), tris.size(), file_);
+  }
+}
+
 }  // namespace blender::io::stl
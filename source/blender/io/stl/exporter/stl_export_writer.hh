@@ -10,6 +10,8 @@
 
 #include <cstdio>
 
+#include "BLI_span.hh"
+
 namespace blender::io::stl {
 
 struct PackedTriangle;
@@ -19,6 +21,7 @@ class FileWriter {
   FileWriter(const char *filepath, bool ascii);
   ~FileWriter();
   void write_triangle(const PackedTriangle &data);
+  void write_triangles(Span<PackedTriangle> tris);
 
  private:
   FILE *file_;
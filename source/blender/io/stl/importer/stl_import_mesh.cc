@@ -10,8 +10,12 @@
 
 #include "BKE_mesh.hh"
 
+#include "BLI_array.hh"
 #include "BLI_array_utils.hh"
+#include "BLI_map.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -53,29 +57,161 @@ bool STLMeshHelper::add_triangle(const PackedTriangle &data)
   return true;
 }
 
-Mesh *STLMeshHelper::to_mesh()
+static void report_removed_tris(const int degenerate_tris_num, const int duplicate_tris_num)
 {
-  if (degenerate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << degenerate_tris_num_ << " degenerate triangles were removed"
+  if (degenerate_tris_num > 0) {
+    std::cout << "STL Importer: " << degenerate_tris_num << " degenerate triangles were removed"
               << std::endl;
   }
-  if (duplicate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << duplicate_tris_num_ << " duplicate triangles were removed"
+  if (duplicate_tris_num > 0) {
+    std::cout << "STL Importer: " << duplicate_tris_num << " duplicate triangles were removed"
               << std::endl;
   }
+}
+
+static void finish_mesh(Mesh &mesh,
+                        const bool use_custom_normals,
+                        MutableSpan<float3> loop_normals)
+{
+  /* NOTE: edges must be calculated first before setting custom normals. */
+  bke::mesh_calc_edges(mesh, false, false);
+
+  if (use_custom_normals && loop_normals.size() == mesh.corners_num) {
+    BKE_mesh_set_custom_normals(&mesh, reinterpret_cast<float(*)[3]>(loop_normals.data()));
+  }
+}
+
+Mesh *STLMeshHelper::to_mesh()
+{
+  report_removed_tris(degenerate_tris_num_, duplicate_tris_num_);
 
   Mesh *mesh = BKE_mesh_new_nomain(verts_.size(), 0, tris_.size(), tris_.size() * 3);
   mesh->vert_positions_for_write().copy_from(verts_);
   offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
   array_utils::copy(tris_.as_span().cast<int>(), mesh->corner_verts_for_write());
 
-  /* NOTE: edges must be calculated first before setting custom normals. */
-  bke::mesh_calc_edges(*mesh, false, false);
+  finish_mesh(*mesh, use_custom_normals_, loop_normals_);
 
-  if (use_custom_normals_ && loop_normals_.size() == mesh->corners_num) {
-    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(loop_normals_.data()));
+  return mesh;
+}
+
+/**
+ * Find the index of the first occurrence of every value, as if the values were added one at a time
+ * to a single set. The values are distributed over hash partitions which are merged independently,
+ * so the result does not depend on the number of threads.
+ */
+template<typename T, typename GetValueFn>
+static void find_first_occurrences(const int64_t size,
+                                   const GetValueFn &get_value,
+                                   MutableSpan<int> r_first_indices)
+{
+  constexpr int partitions_num = 64;
+
+  /* Use the high bits of a re-mixed hash, the low bits are used by the maps of each partition. */
+  Array<uint8_t> partition_by_index(size);
+  threading::parallel_for(IndexRange(size), 8192, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const uint64_t hash = DefaultHash<T>{}(get_value(i)) * uint64_t(0x9E3779B97F4A7C15);
+      partition_by_index[i] = uint8_t(hash >> 58);
+    }
+  });
+
+  /* Group the indices by partition, keeping their order within each partition. */
+  Array<int> offset_data(partitions_num + 1, 0);
+  for (const uint8_t partition : partition_by_index) {
+    offset_data[partition]++;
+  }
+  const OffsetIndices<int> partitions = offset_indices::accumulate_counts_to_offsets(offset_data);
+  Array<int> indices_by_partition(size);
+  {
+    Array<int> fill_positions(offset_data.as_span().drop_back(1));
+    for (const int64_t i : IndexRange(size)) {
+      indices_by_partition[fill_positions[partition_by_index[i]]++] = int(i);
+    }
   }
 
+  threading::parallel_for(partitions.index_range(), 1, [&](const IndexRange range) {
+    for (const int partition : range) {
+      const Span<int> indices = indices_by_partition.as_span().slice(partitions[partition]);
+      Map<T, int> first_index_by_value;
+      first_index_by_value.reserve(indices.size());
+      for (const int i : indices) {
+        r_first_indices[i] = first_index_by_value.lookup_or_add(get_value(i), i);
+      }
+    }
+  });
+}
+
+Mesh *stl_triangles_to_mesh(const Span<PackedTriangle> tris, const bool use_custom_normals)
+{
+  const int64_t corners_num = tris.size() * 3;
+  const auto corner_position = [&](const int64_t corner) -> const float3 & {
+    return tris[corner / 3].vertices[corner % 3];
+  };
+
+  /* Merge vertices, numbering them in the order they first appear. */
+  Array<int> first_corners(corners_num);
+  find_first_occurrences<float3>(corners_num, corner_position, first_corners);
+  Array<int> corner_verts(corners_num);
+  Vector<int> vert_corners;
+  for (const int64_t corner : IndexRange(corners_num)) {
+    const int first_corner = first_corners[corner];
+    if (first_corner == corner) {
+      corner_verts[corner] = vert_corners.append_and_get_index(int(corner));
+    }
+    else {
+      corner_verts[corner] = corner_verts[first_corner];
+    }
+  }
+  first_corners = {};
+
+  /* Merge triangles. Degenerate triangles can never be equal to valid ones, so they don't have to
+   * be skipped when looking for duplicates. */
+  const Span<Triangle> tri_verts = corner_verts.as_span().cast<Triangle>();
+  Array<int> first_tris(tris.size());
+  const auto tri_verts_fn = [&](const int64_t tri) -> const Triangle & { return tri_verts[tri]; };
+  find_first_occurrences<Triangle>(tris.size(), tri_verts_fn, first_tris);
+  Vector<int> kept_tris;
+  int degenerate_tris_num = 0;
+  int duplicate_tris_num = 0;
+  for (const int64_t tri : tris.index_range()) {
+    const Triangle &verts = tri_verts[tri];
+    if ((verts.v1 == verts.v2) || (verts.v1 == verts.v3) || (verts.v2 == verts.v3)) {
+      degenerate_tris_num++;
+    }
+    else if (first_tris[tri] != tri) {
+      duplicate_tris_num++;
+    }
+    else {
+      kept_tris.append(int(tri));
+    }
+  }
+  first_tris = {};
+
+  report_removed_tris(degenerate_tris_num, duplicate_tris_num);
+
+  Mesh *mesh = BKE_mesh_new_nomain(vert_corners.size(), 0, kept_tris.size(), kept_tris.size() * 3);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  threading::parallel_for(positions.index_range(), 8192, [&](const IndexRange range) {
+    for (const int vert : range) {
+      positions[vert] = corner_position(vert_corners[vert]);
+    }
+  });
+  offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
+  MutableSpan<Triangle> mesh_tri_verts = mesh->corner_verts_for_write().cast<Triangle>();
+  Array<float3> loop_normals(use_custom_normals ? mesh->corners_num : 0);
+  threading::parallel_for(kept_tris.index_range(), 8192, [&](const IndexRange range) {
+    for (const int face : range) {
+      const int tri = kept_tris[face];
+      mesh_tri_verts[face] = tri_verts[tri];
+      if (use_custom_normals) {
+        loop_normals.as_mutable_span().slice(face * 3, 3).fill(tris[tri].normal);
+      }
+    }
+  });
+
+  finish_mesh(*mesh, use_custom_normals, loop_normals);
+
   return mesh;
 }
 
@@ -11,6 +11,7 @@
 #include <cstdint>
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 #include "stl_data.hh"
@@ -67,4 +68,11 @@ class STLMeshHelper {
   Mesh *to_mesh();
 };
 
+/**
+ * Create a mesh from all triangles of a file at once. Duplicate vertices and triangles are merged
+ * with the same result as adding them one by one to #STLMeshHelper, but the merging is done in
+ * parallel.
+ */
+Mesh *stl_triangles_to_mesh(Span<PackedTriangle> tris, bool use_custom_normals);
+
 }  // namespace blender::io::stl
@@ -25,6 +25,7 @@
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "DNA_customdata_types.h"
 #include "DNA_material_types.h"
@@ -282,24 +283,33 @@ void USDMeshReader::read_mpolys(Mesh *mesh)
   int loop_index = 0;
 
   for (int i = 0; i < face_counts_.size(); i++) {
-    const int face_size = face_counts_[i];
-
     face_offsets[i] = loop_index;
+    loop_index += face_counts_[i];
+  }
 
-    /* Polygons are always assumed to be smooth-shaded. If the mesh should be flat-shaded,
-     * this is encoded in custom loop normals. */
+  /* Polygons are always assumed to be smooth-shaded. If the mesh should be flat-shaded,
+   * this is encoded in custom loop normals. */
 
-    if (is_left_handed_) {
-      int loop_end_index = loop_index + (face_size - 1);
-      for (int f = 0; f < face_size; ++f, ++loop_index) {
-        corner_verts[loop_index] = face_indices_[loop_end_index - f];
+  /* Access the USD array through a const reference, so that it is not detached when read from
+   * multiple threads. */
+  const pxr::VtIntArray &face_indices = face_indices_;
+  const OffsetIndices<int> faces(face_offsets);
+  if (is_left_handed_) {
+    threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const IndexRange face = faces[i];
+        for (const int j : face.index_range()) {
+          corner_verts[face.start() + j] = face_indices[face.last(j)];
+        }
       }
-    }
-    else {
-      for (int f = 0; f < face_size; ++f, ++loop_index) {
-        corner_verts[loop_index] = face_indices_[loop_index];
+    });
+  }
+  else {
+    threading::parallel_for(IndexRange(loop_index), 8192, [&](const IndexRange range) {
+      for (const int i : range) {
+        corner_verts[i] = face_indices[i];
       }
-    }
+    });
   }
 
   bke::mesh_calc_edges(*mesh, false, false);
@@ -311,7 +321,8 @@ void USDMeshReader::read_uv_data_primvar(Mesh *mesh,
 {
   const StringRef primvar_name(primvar.StripPrimvarsName(primvar.GetName()).GetString());
 
-  pxr::VtArray<pxr::GfVec2f> usd_uvs = get_primvar_array<pxr::GfVec2f>(primvar, motionSampleTime);
+  const pxr::VtArray<pxr::GfVec2f> usd_uvs = get_primvar_array<pxr::GfVec2f>(primvar,
+                                                                             motionSampleTime);
 
   if (usd_uvs.empty()) {
     return;
@@ -350,29 +361,36 @@ void USDMeshReader::read_uv_data_primvar(Mesh *mesh,
     if (is_left_handed_) {
       /* Reverse the index order. */
       const OffsetIndices faces = mesh->faces();
-      for (const int i : faces.index_range()) {
-        const IndexRange face = faces[i];
-        for (int j : face.index_range()) {
-          const int rev_index = face.last(j);
-          uv_data.span[face.start() + j] = float2(usd_uvs[rev_index][0], usd_uvs[rev_index][1]);
+      threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          const IndexRange face = faces[i];
+          for (int j : face.index_range()) {
+            const int rev_index = face.last(j);
+            uv_data.span[face.start() + j] = float2(usd_uvs[rev_index][0],
+                                                    usd_uvs[rev_index][1]);
+          }
         }
-      }
+      });
     }
     else {
-      for (int i = 0; i < uv_data.span.size(); ++i) {
-        uv_data.span[i] = float2(usd_uvs[i][0], usd_uvs[i][1]);
-      }
+      threading::parallel_for(uv_data.span.index_range(), 8192, [&](const IndexRange range) {
+        for (const int i : range) {
+          uv_data.span[i] = float2(usd_uvs[i][0], usd_uvs[i][1]);
+        }
+      });
     }
   }
   else {
     /* Handle vertex interpolation. */
     const Span<int> corner_verts = mesh->corner_verts();
     BLI_assert(mesh->verts_num == usd_uvs.size());
-    for (int i = 0; i < uv_data.span.size(); ++i) {
-      /* Get the vertex index for this corner. */
-      int vi = corner_verts[i];
-      uv_data.span[i] = float2(usd_uvs[vi][0], usd_uvs[vi][1]);
-    }
+    threading::parallel_for(uv_data.span.index_range(), 8192, [&](const IndexRange range) {
+      for (const int i : range) {
+        /* Get the vertex index for this corner. */
+        int vi = corner_verts[i];
+        uv_data.span[i] = float2(usd_uvs[vi][0], usd_uvs[vi][1]);
+      }
+    });
   }
 
   uv_data.finish();
@@ -496,25 +514,28 @@ void USDMeshReader::process_normals_face_varying(Mesh *mesh)
   float(*lnors)[3] = static_cast<float(*)[3]>(
       MEM_malloc_arrayN(loop_count, sizeof(float[3]), "USD::FaceNormals"));
 
+  const pxr::VtVec3fArray &normals = normals_;
   const OffsetIndices faces = mesh->faces();
-  for (const int i : faces.index_range()) {
-    const IndexRange face = faces[i];
-    for (int j : face.index_range()) {
-      int blender_index = face.start() + j;
-
-      int usd_index = face.start();
-      if (is_left_handed_) {
-        usd_index += face.size() - 1 - j;
-      }
-      else {
-        usd_index += j;
-      }
+  threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      for (int j : face.index_range()) {
+        int blender_index = face.start() + j;
+
+        int usd_index = face.start();
+        if (is_left_handed_) {
+          usd_index += face.size() - 1 - j;
+        }
+        else {
+          usd_index += j;
+        }
 
-      lnors[blender_index][0] = normals_[usd_index][0];
-      lnors[blender_index][1] = normals_[usd_index][1];
-      lnors[blender_index][2] = normals_[usd_index][2];
+        lnors[blender_index][0] = normals[usd_index][0];
+        lnors[blender_index][1] = normals[usd_index][1];
+        lnors[blender_index][2] = normals[usd_index][2];
+      }
     }
-  }
+  });
   BKE_mesh_set_custom_normals(mesh, lnors);
 
   MEM_freeN(lnors);
@@ -535,14 +556,17 @@ void USDMeshReader::process_normals_uniform(Mesh *mesh)
   float(*lnors)[3] = static_cast<float(*)[3]>(
       MEM_malloc_arrayN(mesh->corners_num, sizeof(float[3]), "USD::FaceNormals"));
 
+  const pxr::VtVec3fArray &normals = normals_;
   const OffsetIndices faces = mesh->faces();
-  for (const int i : faces.index_range()) {
-    for (const int corner : faces[i]) {
-      lnors[corner][0] = normals_[i][0];
-      lnors[corner][1] = normals_[i][1];
-      lnors[corner][2] = normals_[i][2];
+  threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (const int corner : faces[i]) {
+        lnors[corner][0] = normals[i][0];
+        lnors[corner][1] = normals[i][1];
+        lnors[corner][2] = normals[i][2];
+      }
     }
-  }
+  });
 
   BKE_mesh_set_custom_normals(mesh, lnors);
 
@@ -560,9 +584,12 @@ void USDMeshReader::read_mesh_sample(ImportSettings *settings,
 
   if (new_mesh || (settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
     MutableSpan<float3> vert_positions = mesh->vert_positions_for_write();
-    for (int i = 0; i < positions_.size(); i++) {
-      vert_positions[i] = {positions_[i][0], positions_[i][1], positions_[i][2]};
-    }
+    const pxr::VtVec3fArray &positions = positions_;
+    threading::parallel_for(IndexRange(positions.size()), 8192, [&](const IndexRange range) {
+      for (const int i : range) {
+        vert_positions[i] = {positions[i][0], positions[i][1], positions[i][2]};
+      }
+    });
     mesh->tag_positions_changed();
 
     read_vertex_creases(mesh, motionSampleTime);
@@ -19,6 +19,7 @@
 #include "BLI_assert.h"
 #include "BLI_color.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
@@ -745,9 +746,11 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
     case bke::MeshNormalDomain::Face: {
       const OffsetIndices faces = mesh->faces();
       const Span<float3> face_normals = mesh->face_normals();
-      for (const int i : faces.index_range()) {
-        dst_normals.slice(faces[i]).fill(face_normals[i]);
-      }
+      threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+        for (const int i : range) {
+          dst_normals.slice(faces[i]).fill(face_normals[i]);
+        }
+      });
       break;
     }
     case bke::MeshNormalDomain::Corner: {
@@ -776,15 +779,15 @@ void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeom
     return;
   }
 
-  const float(*velocities)[3] = reinterpret_cast<float(*)[3]>(velocity_layer->data);
+  const Span<float3> velocities(static_cast<const float3 *>(velocity_layer->data),
+                                mesh->verts_num);
 
   /* Export per-vertex velocity vectors. */
   pxr::VtVec3fArray usd_velocities;
-  usd_velocities.reserve(mesh->verts_num);
-
-  for (int vertex_idx = 0, totvert = mesh->verts_num; vertex_idx < totvert; ++vertex_idx) {
-    usd_velocities.push_back(pxr::GfVec3f(velocities[vertex_idx]));
-  }
+  usd_velocities.resize(mesh->verts_num);
+  array_utils::copy(
+      velocities,
+      MutableSpan(reinterpret_cast<float3 *>(usd_velocities.data()), usd_velocities.size()));
 
   pxr::UsdTimeCode timecode = get_export_time_code();
   usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
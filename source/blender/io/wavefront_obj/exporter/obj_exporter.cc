@@ -8,6 +8,7 @@
 
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <system_error>
 
 #include "BKE_context.hh"
@@ -158,8 +159,9 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
                                const OBJExportParams &export_params)
 {
   /* Parallelization is over meshes/objects, which means
-   * we have to have the output text buffer for each object,
-   * and write them all into the file at the end. */
+   * we have to have the output text buffer for each object.
+   * The buffers are written into the file in object order,
+   * as soon as all the preceding objects are done. */
   size_t count = exportable_as_mesh.size();
   Array<FormatHandler> buffers(count);
 
@@ -203,6 +205,10 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
   }
 
   /* Parallel over meshes: main result writing. */
+  FILE *f = obj_writer.get_outfile();
+  std::mutex write_mutex;
+  Array<bool> buffers_done(count, false);
+  size_t next_buffer_to_write = 0;
   threading::parallel_for(IndexRange(count), 1, [&](IndexRange range) {
     for (const int i : range) {
       OBJMesh &obj = *exportable_as_mesh[i];
@@ -240,14 +246,18 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
       /* Nothing will need this object's data after this point, release
        * various arrays here. */
       obj.clear();
+
+      /* Write out all buffers that are ready in order, so that the text of finished objects
+       * doesn't have to be kept in memory until the end. */
+      std::lock_guard lock{write_mutex};
+      buffers_done[i] = true;
+      while (next_buffer_to_write < count && buffers_done[next_buffer_to_write]) {
+        buffers[next_buffer_to_write].write_to_file(f);
+        next_buffer_to_write++;
+      }
     }
   });
-
-  /* Write all the object text buffers into the output file. */
-  FILE *f = obj_writer.get_outfile();
-  for (auto &b : buffers) {
-    b.write_to_file(f);
-  }
+  BLI_assert(next_buffer_to_write == count);
 }
 
 /**
@@ -93,6 +93,24 @@ typedef struct GPStrokePoint {
   float color_b;
 } GPStrokePoint;
 
+/**
+ * Ondine: Compact variant of #GPStrokePoint, computed for objects with
+ * #GP_ONDINE_COMPACT_POINTS. Positions are relative to the stroke bounding box
+ * (#OndineRenderStroke.render_bbox), radius, alpha and color are quantized.
+ */
+typedef struct GPStrokePointCompact {
+  float dist_to_cam;
+  /** Position in the stroke bounding box, 0 is the minimum and 65535 the maximum. */
+  uint16_t x;
+  uint16_t y;
+  /** Normalized radius, 65535 is 1.0. */
+  uint16_t radius;
+  uint8_t alpha;
+  /** Linear color, use #OndineRenderStroke.render_stroke_color when the color is constant. */
+  uint8_t color[3];
+  char _pad[2];
+} GPStrokePointCompact;
+
 typedef struct OndineRenderStroke {
   float render_fill_color[3];
   float render_fill_opacity;
@@ -103,6 +121,9 @@ typedef struct OndineRenderStroke {
   int render_flag;
   float render_bbox[4];
   float render_max_radius;
+  /** Color of all points, when #GP_ONDINE_STROKE_HAS_CONSTANT_COLOR is set. */
+  float render_stroke_color[3];
+  char _pad[4];
 } OndineRenderStroke;
 
 typedef enum GreasePencilOndineRenderStrokeFlag {
@@ -111,6 +132,7 @@ typedef enum GreasePencilOndineRenderStrokeFlag {
   GP_ONDINE_STROKE_FILL_IS_CLOCKWISE = (1 << 2),
   GP_ONDINE_STROKE_IS_OUT_OF_VIEW = (1 << 3),
   GP_ONDINE_STROKE_IS_CYCLIC = (1 << 4),
+  GP_ONDINE_STROKE_HAS_CONSTANT_COLOR = (1 << 5),
 } GreasePencilOndineRenderStrokeFlag;
 
 /**
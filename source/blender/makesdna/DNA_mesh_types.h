@@ -18,6 +18,7 @@
 
 #  include <optional>
 
+#  include "BLI_index_mask_fwd.hh"
 #  include "BLI_math_vector_types.hh"
 
 namespace blender {
@@ -397,6 +398,12 @@ typedef struct Mesh {
 
   /** Call after changing vertex positions to tag lazily calculated caches for recomputation. */
   void tag_positions_changed();
+  /**
+   * Same as above, but only the given vertices were moved. Normals that are already calculated
+   * are updated for the faces using those vertices and their neighbors, instead of tagging them
+   * for a full recomputation.
+   */
+  void tag_positions_changed(const blender::IndexMask &changed_verts);
   /** Call after moving every mesh vertex by the same translation. */
   void tag_positions_changed_uniformly();
   /** Like #tag_positions_changed but doesn't tag normals; they must be updated separately. */
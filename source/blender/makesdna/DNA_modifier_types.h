@@ -2408,7 +2408,12 @@ typedef struct NodesModifierBake {
   uint32_t flag;
   /** #NodesModifierBakeMode. */
   uint8_t bake_mode;
-  char _pad[7];
+  char _pad[3];
+  /**
+   * Only every n-th baked frame is stored in full, the frames in between are stored as difference
+   * to it. Zero and one store every frame in full.
+   */
+  int keyframe_interval;
   /**
    * Directory where the baked data should be stored. This is only used when
    * `NODES_MODIFIER_BAKE_CUSTOM_PATH` is set.
@@ -2483,6 +2488,7 @@ typedef struct NodesModifierData {
 
 typedef enum NodesModifierFlag {
   NODES_MODIFIER_HIDE_DATABLOCK_SELECTOR = (1 << 0),
+  NODES_MODIFIER_CACHE_NODE_RESULTS = (1 << 1),
 } NodesModifierFlag;
 
 typedef struct MeshToVolumeModifierData {
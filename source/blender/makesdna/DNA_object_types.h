@@ -786,6 +786,8 @@ typedef enum eGP_OndineFlag {
   GP_ONDINE_GOUACHE_STYLE = (1 << 2),
   GP_ONDINE_SMOOTH_RANDOMIZE_STEPS = (1 << 4),
   GP_ONDINE_TRUE_DEPTH = (1 << 5),
+  /** Compute the compact #GPStrokePointCompact render points as well. */
+  GP_ONDINE_COMPACT_POINTS = (1 << 6),
 } eGP_OndineFlag;
 
 #define MAX_DUPLI_RECUR 8
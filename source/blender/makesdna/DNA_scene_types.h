@@ -831,6 +831,10 @@ typedef struct RenderData {
 
   /** Precision used by the GPU execution of the compositor tree. */
   int compositor_precision; /* eCompositorPrecision */
+
+  /** Size in megabytes of the GPU memory used to cache compositor node results, zero disables. */
+  int compositor_cache_limit;
+  char _pad10[4];
 } RenderData;
 
 /** #RenderData::quality_flag */
@@ -1911,6 +1915,10 @@ typedef struct SceneEEVEE {
 
   float overscan;
   float light_threshold;
+
+  /** Target duration of a viewport redraw in seconds, disabled if zero. */
+  float viewport_frame_budget;
+  char _pad1[4];
 } SceneEEVEE;
 
 typedef struct SceneGpencil {
@@ -2728,6 +2736,8 @@ typedef enum eGPencil_SimplifyFlags {
   SIMPLIFY_GPENCIL_TINT = (1 << 7),
   /** Simplify Anti-aliasing. */
   SIMPLIFY_GPENCIL_AA = (1 << 8),
+  /** Skip layers hidden behind opaque fills. */
+  SIMPLIFY_GPENCIL_CULL_OCCLUDED = (1 << 9),
 } eGPencil_SimplifyFlags;
 
 /** `ToolSettings.gpencil_*_align` - Stroke Placement mode flags. */
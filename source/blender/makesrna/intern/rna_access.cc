@@ -4824,8 +4824,45 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      if (out.type != PROP_RAW_UNSET) {
+        /* Non-matching types: convert the values directly between the raw arrays, which is still
+         * much faster than going through the RNA accessors of every item below. Use double as
+         * intermediate type for floating point values, to not lose precision of 64 bit integers
+         * otherwise. */
+        const bool use_double = ELEM(in.type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE) ||
+                                ELEM(out.type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE);
+        RawArray out_item = out;
+        for (int a = 0; a < out.len; a++) {
+          out_item.array = (char *)out.array + size_t(a) * out.stride;
+          for (int j = 0; j < arraylen; j++) {
+            const int in_index = a * arraylen + j;
+            if (use_double) {
+              double value;
+              if (set) {
+                RAW_GET(double, value, in, in_index);
+                RAW_SET(double, out_item, j, value);
+              }
+              else {
+                RAW_GET(double, value, out_item, j);
+                RAW_SET(double, in, in_index, value);
+              }
+            }
+            else {
+              int64_t value;
+              if (set) {
+                RAW_GET(int64_t, value, in, in_index);
+                RAW_SET(int64_t, out_item, j, value);
+              }
+              else {
+                RAW_GET(int64_t, value, out_item, j);
+                RAW_SET(int64_t, in, in_index, value);
+              }
+            }
+          }
+        }
+
+        return 1;
+      }
     }
     BLI_assert_msg(itemlen == 0 || itemtype != PROP_ENUM,
                    "Enum array properties should not exist");
@@ -42,6 +42,7 @@
 #  include "DEG_depsgraph_build.hh"
 #  include "DEG_depsgraph_debug.hh"
 #  include "DEG_depsgraph_query.hh"
+#  include "DEG_depsgraph_stats.hh"
 
 #  include "MEM_guardedalloc.h"
 
@@ -289,6 +290,21 @@ static void rna_Depsgraph_debug_stats(Depsgraph *depsgraph, char *result)
                outer);
 }
 
+static void rna_Depsgraph_evaluation_stats_enable(Depsgraph *depsgraph, int history_size)
+{
+  DEG_evaluation_stats_enable(depsgraph, history_size);
+}
+
+static void rna_Depsgraph_evaluation_stats_disable(Depsgraph *depsgraph)
+{
+  DEG_evaluation_stats_disable(depsgraph);
+}
+
+static bool rna_Depsgraph_use_evaluation_stats_get(PointerRNA *ptr)
+{
+  return DEG_evaluation_stats_is_enabled(static_cast<Depsgraph *>(ptr->data));
+}
+
 static void rna_Depsgraph_update(Depsgraph *depsgraph, Main *bmain, ReportList *reports)
 {
   if (DEG_is_evaluating(depsgraph)) {
@@ -726,6 +742,34 @@ static void rna_def_depsgraph(BlenderRNA *brna)
       parm, PROP_THICK_WRAP, ParameterFlag(0)); /* needed for string return value */
   RNA_def_function_output(func, parm);
 
+  /* Evaluation statistics. */
+
+  func = RNA_def_function(
+      srna, "evaluation_stats_enable", "rna_Depsgraph_evaluation_stats_enable");
+  RNA_def_function_ui_description(func,
+                                  "Start gathering timing and memory statistics of every "
+                                  "evaluation, available with evaluation_stats()");
+  RNA_def_int(func,
+              "history_size",
+              1,
+              1,
+              INT_MAX,
+              "History Size",
+              "Number of evaluations to keep statistics of, older ones are removed",
+              1,
+              1000);
+
+  func = RNA_def_function(
+      srna, "evaluation_stats_disable", "rna_Depsgraph_evaluation_stats_disable");
+  RNA_def_function_ui_description(func,
+                                  "Stop gathering evaluation statistics and free the history");
+
+  prop = RNA_def_property(srna, "use_evaluation_stats", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_funcs(prop, "rna_Depsgraph_use_evaluation_stats_get", nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop, "Use Evaluation Statistics", "Evaluation statistics are gathered");
+
   /* Updates. */
 
   func = RNA_def_function(srna, "update", "rna_Depsgraph_update");
@@ -1459,6 +1459,16 @@ static void rna_def_grease_pencil_data(BlenderRNA *brna)
       prop, "Hide Threshold", "Alpha threshold for hiding underlying pixels completely");
   RNA_def_property_update(prop, NC_GPENCIL | ND_DATA, "rna_grease_pencil_update");
 
+  /* Compact render points. */
+  prop = RNA_def_property(srna, "use_compact_render_points", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "ondine_flag", GP_ONDINE_COMPACT_POINTS);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Compact Render Points",
+                           "Also prepare the render points in a compact, quantized layout, "
+                           "halving the memory bandwidth needed for painting");
+  RNA_def_property_update(prop, NC_GPENCIL | ND_DATA, "rna_grease_pencil_update");
+
   /* Gouache style. */
   prop = RNA_def_property(srna, "gouache_style", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "ondine_flag", GP_ONDINE_GOUACHE_STYLE);
@@ -2355,9 +2355,9 @@ void rna_Object_gpencil_ondine_set_zdepth(Object *ob)
   blender::ondine::gpencil_ondine_set_zdepth(ob);
 }
 
-void rna_Object_gpencil_ondine_set_render_data(Object *ob, const float mat[16])
+void rna_Object_gpencil_ondine_set_render_data(Object *ob, const float mat[16], bool use_cache)
 {
-  blender::ondine::gpencil_ondine_set_render_data(ob, (const float(*)[4])mat);
+  blender::ondine::gpencil_ondine_set_render_data(ob, (const float(*)[4])mat, use_cache);
 }
 
 #else
@@ -3864,6 +3864,12 @@ static void rna_def_object(BlenderRNA *brna)
   parm = RNA_def_float_matrix(
       func, "matrix_world", 4, 4, nullptr, 0.0f, 0.0f, "", "World Matrix", 0.0f, 0.0f);
   RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
+  RNA_def_boolean(func,
+                  "use_cache",
+                  false,
+                  "Use Cache",
+                  "Keep the existing render data of drawings of which the geometry, transforms, "
+                  "materials and camera didn't change");
 
   RNA_define_lib_overridable(false);
 
@@ -736,6 +736,7 @@ static const EnumPropertyItem eevee_resolution_scale_items[] = {
 
 #  include "NOD_composite.hh"
 
+#  include "ED_grease_pencil_ondine.hh"
 #  include "ED_image.hh"
 #  include "ED_info.hh"
 #  include "ED_keyframing.hh"
@@ -3004,6 +3005,18 @@ static float rna_Scene_ondine_render_progress_get(PointerRNA * /*ptr*/)
 
 static void rna_Scene_ondine_render_progress_set(PointerRNA * /*ptr*/, float /*value*/) {}
 
+static bool rna_SceneOndine_prepare_render_data(SceneOndine * /*ondine*/,
+                                                bContext *C,
+                                                bool use_cache,
+                                                int prefetch_frames)
+{
+  if (!blender::ondine::gpencil_ondine_render_init(C, true, use_cache)) {
+    return false;
+  }
+  blender::ondine::gpencil_ondine_prefetch_start(C, prefetch_frames);
+  return true;
+}
+
 #else
 
 /* Grease Pencil Interpolation tool settings */
@@ -7486,6 +7499,15 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Layers Tinting", "Display layer tint");
   RNA_def_property_update(prop, NC_GPENCIL | ND_DATA, "rna_GPencil_update");
 
+  prop = RNA_def_property(srna, "simplify_gpencil_cull_occluded", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, nullptr, "simplify_gpencil", SIMPLIFY_GPENCIL_CULL_OCCLUDED);
+  RNA_def_property_ui_text(prop,
+                           "Cull Occluded Layers",
+                           "Skip drawing layers that are covered by an opaque fill of a layer "
+                           "above them over the whole view");
+  RNA_def_property_update(prop, NC_GPENCIL | ND_DATA, "rna_GPencil_update");
+
   /* persistent data */
   prop = RNA_def_property(srna, "use_persistent_data", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "mode", R_PERSISTENT_DATA);
@@ -7530,6 +7552,16 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
       prop, "Compositor Precision", "The precision of compositor intermediate result");
   RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_Scene_compositor_update");
 
+  prop = RNA_def_property(srna, "compositor_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "compositor_cache_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 16384, 64, -1);
+  RNA_def_property_ui_text(prop,
+                           "Compositor Cache Limit",
+                           "Amount of GPU memory in megabytes used to keep the results of "
+                           "unchanged nodes between compositor evaluations, zero disables caching");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_Scene_compositor_update");
+
   /* Ondine. */
   prop = RNA_def_property(srna, "ondine_progress", PROP_FLOAT, PROP_NONE);
   RNA_def_property_float_funcs(prop,
@@ -8052,6 +8084,18 @@ static void rna_def_scene_eevee(BlenderRNA *brna)
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
   RNA_def_property_flag(prop, PROP_ANIMATABLE);
 
+  prop = RNA_def_property(srna, "viewport_frame_budget", PROP_FLOAT, PROP_TIME_ABSOLUTE);
+  RNA_def_property_ui_text(prop,
+                           "Frame Time Budget",
+                           "Target duration of a viewport redraw. While navigating, the "
+                           "resolution is lowered to stay within the budget. When the view is "
+                           "static, as many samples as fit in the budget are rendered per redraw "
+                           "(disabled if 0)");
+  RNA_def_property_range(prop, 0.0f, FLT_MAX);
+  RNA_def_property_ui_range(prop, 0.0f, 0.1f, 1, 3);
+  RNA_def_property_override_flag(prop, PROPOVERRIDE_OVERRIDABLE_LIBRARY);
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   prop = RNA_def_property(srna, "taa_render_samples", PROP_INT, PROP_NONE);
   RNA_def_property_ui_text(prop, "Render Samples", "Number of samples per pixel for rendering");
   RNA_def_property_range(prop, 1, INT_MAX);
@@ -8723,6 +8767,33 @@ static void rna_def_scene_ondine(BlenderRNA *brna)
       "Paper Texture",
       "An image (e.g. a paper texture) that is placed in the background of the render");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
+  /* Prepare render data. */
+  FunctionRNA *func = RNA_def_function(
+      srna, "prepare_render_data", "rna_SceneOndine_prepare_render_data");
+  RNA_def_function_ui_description(
+      func,
+      "Prepare the render data of all watercolor grease pencil objects for the current frame, "
+      "and of upcoming frames in the background");
+  RNA_def_function_flag(func, FUNC_USE_CONTEXT);
+  RNA_def_boolean(func,
+                  "use_cache",
+                  false,
+                  "Use Cache",
+                  "Keep the render data of drawings of which the inputs didn't change");
+  RNA_def_int(func,
+              "prefetch_frames",
+              0,
+              0,
+              INT_MAX,
+              "Prefetch Frames",
+              "Number of upcoming frames of which the render data is prepared in the background, "
+              "used by later calls for those frames. Zero stops prefetching",
+              0,
+              100);
+  PropertyRNA *parm = RNA_def_boolean(
+      func, "result", false, "", "False when the render data couldn't be prepared");
+  RNA_def_function_return(func, parm);
 }
 
 static void rna_def_scene_hydra(BlenderRNA *brna)
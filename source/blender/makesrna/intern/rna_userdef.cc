@@ -188,6 +188,7 @@ static const EnumPropertyItem rna_enum_preference_gpu_backend_items[] = {
 #  include "BKE_image.h"
 #  include "BKE_main.hh"
 #  include "BKE_mesh_runtime.hh"
+#  include "BKE_modifier.hh"
 #  include "BKE_object.hh"
 #  include "BKE_paint.hh"
 #  include "BKE_preferences.h"
@@ -868,6 +869,18 @@ static void rna_UserDef_subdivision_update(Main *bmain, Scene *scene, PointerRNA
   rna_userdef_update(bmain, scene, ptr);
 }
 
+/* Reevaluate objects with an armature modifier, it may be moved to the draw code. */
+static void rna_userdef_gpu_armature_deform_update(Main *bmain, Scene *scene, PointerRNA *ptr)
+{
+  LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+    if (BKE_modifiers_findby_type(ob, eModifierType_Armature) != nullptr) {
+      DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+    }
+  }
+
+  rna_userdef_update(bmain, scene, ptr);
+}
+
 static void rna_UserDef_audio_update(Main *bmain, Scene * /*scene*/, PointerRNA * /*ptr*/)
 {
   BKE_sound_init(bmain);
@@ -6077,6 +6090,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, nullptr, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, nullptr, "sequencer_editor_flag", USER_SEQ_ED_HARDWARE_DECODING);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Decoding",
+                           "Decode movie strips with the GPU video decoder when available, "
+                           "reducing the CPU load of playback. Applies to movies opened after "
+                           "changing this option");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, nullptr, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -6180,6 +6202,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Texture Collection Rate",
       "Number of seconds between each run of the GL texture garbage collector");
 
+  prop = RNA_def_property(srna, "texture_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "texmemlimit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_text(prop,
+                           "Texture Memory Limit",
+                           "Maximum GPU memory used by image textures (in megabytes). The least "
+                           "recently used textures are freed when it is exceeded "
+                           "(set to 0 for no limit)");
+
   prop = RNA_def_property(srna, "vbo_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, nullptr, "vbotimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -7452,6 +7483,22 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       "New Animation Data-block",
       "The new 'Animation' data-block can contain the animation for multiple data-blocks at once");
   RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "use_gpu_fields", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_gpu_fields", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Fields",
+                           "Evaluate large geometry nodes fields made up of math nodes with "
+                           "compute shaders when a GPU context is available");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "use_gpu_armature_deform", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_gpu_armature_deform", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Armature Deform",
+                           "Deform meshes with compute shaders in the viewport when the armature "
+                           "modifier is the last modifier and only vertex groups are used");
+  RNA_def_property_update(prop, 0, "rna_userdef_gpu_armature_deform_update");
 }
 
 static void rna_def_userdef_addon_collection(BlenderRNA *brna, PropertyRNA *cprop)
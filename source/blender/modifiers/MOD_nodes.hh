@@ -10,6 +10,9 @@ struct Object;
 namespace blender::bke::bake {
 struct ModifierCache;
 }
+namespace blender::nodes {
+class GeoNodesNodeResultCache;
+}
 namespace blender::nodes::geo_eval_log {
 class GeoModifierLog;
 }
@@ -35,6 +38,12 @@ struct NodesModifierRuntime {
    * used by the evaluated modifier.
    */
   std::shared_ptr<bke::bake::ModifierCache> cache;
+  /**
+   * Results of nodes from the previous evaluation in the active depsgraph, when
+   * #NODES_MODIFIER_CACHE_NODE_RESULTS is enabled. Shared between original and evaluated
+   * modifiers like the simulation cache.
+   */
+  std::shared_ptr<nodes::GeoNodesNodeResultCache> node_result_cache;
 };
 
 void nodes_modifier_data_block_destruct(NodesModifierDataBlock *data_block, bool do_id_user);
@@ -18,14 +18,18 @@
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_action.h"
 #include "BKE_armature.hh"
 #include "BKE_deform.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_modifier.hh"
 
+#include "DEG_depsgraph_query.hh"
+
 #include "UI_interface.hh"
 #include "UI_resources.hh"
 
@@ -36,6 +40,11 @@
 #include "MOD_ui_common.hh"
 #include "MOD_util.hh"
 
+/** Kept between evaluations, so that the weights for the draw code are only created once. */
+struct ArmatureModifierRuntime {
+  std::shared_ptr<const blender::bke::ArmatureDeformWeights> gpu_deform_weights;
+};
+
 static void init_data(ModifierData *md)
 {
   ArmatureModifierData *amd = (ArmatureModifierData *)md;
@@ -113,6 +122,54 @@ static void update_depsgraph(ModifierData *md, const ModifierUpdateDepsgraphCont
   DEG_add_depends_on_transform_relation(ctx->node, "Armature Modifier");
 }
 
+static ModifierData *modifier_get_last_enabled_for_mode(const Scene *scene,
+                                                        const Object *ob,
+                                                        const int required_mode)
+{
+  ModifierData *md = static_cast<ModifierData *>(ob->modifiers.last);
+  while (md) {
+    if (BKE_modifier_is_enabled(scene, md, required_mode)) {
+      break;
+    }
+    md = md->prev;
+  }
+  return md;
+}
+
+/**
+ * Like GPU subdivision, the deformation is delayed to the draw code when the result is only
+ * needed for drawing the mesh in the viewport. Code that needs the deformed positions on the CPU
+ * deforms a copy of the mesh lazily.
+ */
+static bool can_deform_in_draw_code(const ArmatureModifierData *amd,
+                                    const ModifierEvalContext *ctx,
+                                    const Mesh *mesh,
+                                    const blender::Span<blender::float3> positions)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_gpu_armature_deform)) {
+    return false;
+  }
+  if (ctx->flag & (MOD_APPLY_RENDER | MOD_APPLY_TO_BASE_MESH)) {
+    return false;
+  }
+  if (mesh == nullptr || mesh->runtime->edit_mesh != nullptr ||
+      positions.data() != mesh->vert_positions().data())
+  {
+    return false;
+  }
+  /* Sculpt and paint modes access the positions directly. */
+  if (ctx->object->mode != OB_MODE_OBJECT || amd->vert_coords_prev != nullptr) {
+    return false;
+  }
+  const Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
+  if (modifier_get_last_enabled_for_mode(scene, ctx->object, eModifierMode_Realtime) !=
+      &amd->modifier)
+  {
+    return false;
+  }
+  return blender::bke::armature_deform_supports_gpu(*amd->object, *mesh, amd->deformflag);
+}
+
 static void deform_verts(ModifierData *md,
                          const ModifierEvalContext *ctx,
                          Mesh *mesh,
@@ -120,6 +177,21 @@ static void deform_verts(ModifierData *md,
 {
   ArmatureModifierData *amd = (ArmatureModifierData *)md;
 
+  if (can_deform_in_draw_code(amd, ctx, mesh, positions)) {
+    if (md->runtime == nullptr) {
+      md->runtime = MEM_new<ArmatureModifierRuntime>(__func__);
+    }
+    ArmatureModifierRuntime *runtime = static_cast<ArmatureModifierRuntime *>(md->runtime);
+    mesh->runtime->armature_gpu_deform = blender::bke::armature_gpu_deform_create(
+        *amd->object,
+        *ctx->object,
+        *mesh,
+        amd->deformflag,
+        amd->defgrp_name,
+        runtime->gpu_deform_weights);
+    return;
+  }
+
   /* if next modifier needs original vertices */
   MOD_previous_vcos_store(md, reinterpret_cast<float(*)[3]>(positions.data()));
 
@@ -229,6 +301,11 @@ static void panel_draw(const bContext * /*C*/, Panel *panel)
   modifier_panel_end(layout, ptr);
 }
 
+static void free_runtime_data(void *runtime_data)
+{
+  MEM_delete(static_cast<ArmatureModifierRuntime *>(runtime_data));
+}
+
 static void panel_register(ARegionType *region_type)
 {
   modifier_panel_register(region_type, eModifierType_Armature, panel_draw);
@@ -270,7 +347,7 @@ ModifierTypeInfo modifierType_Armature = {
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ foreach_ID_link,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ nullptr,
     /*blend_read*/ blend_read,
@@ -647,7 +647,7 @@ static void modify_geometry_set(ModifierData *md,
   const float scene_fps = float(scene.r.frs_sec) / scene.r.frs_sec_base;
   const Span<const bke::greasepencil::Layer *> layers = grease_pencil.layers();
 
-  threading::parallel_for_each(
+  modifier::greasepencil::foreach_drawing(
       drawing_infos, [&](modifier::greasepencil::LayerDrawingInfo drawing_info) {
         const bke::greasepencil::Drawing *prev_drawing = grease_pencil.get_drawing_at(
             *layers[drawing_info.layer_index], eval_frame - 1);
@@ -364,7 +364,7 @@ static void modify_geometry_set(ModifierData *md,
 
   const Vector<Drawing *> drawings = modifier::greasepencil::get_drawings_for_write(
       grease_pencil, layer_mask, frame);
-  threading::parallel_for_each(
+  modifier::greasepencil::foreach_drawing(
       drawings, [&](Drawing *drawing) { modify_drawing(*dmd, *ctx, pattern_info, *drawing); });
 }
 
@@ -661,8 +661,8 @@ static void modify_geometry_set(ModifierData *md,
 
   const Vector<Drawing *> drawings = modifier::greasepencil::get_drawings_for_write(
       grease_pencil, layer_mask, frame);
-  threading::parallel_for_each(drawings,
-                               [&](Drawing *drawing) { modify_drawing(*emd, *ctx, *drawing); });
+  modifier::greasepencil::foreach_drawing(
+      drawings, [&](Drawing *drawing) { modify_drawing(*emd, *ctx, *drawing); });
 }
 
 static void panel_draw(const bContext *C, Panel *panel)
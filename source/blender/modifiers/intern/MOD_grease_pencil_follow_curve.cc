@@ -784,11 +784,8 @@ static void modify_geometry_set(ModifierData *md,
 
   const Vector<Drawing *> drawings = modifier::greasepencil::get_drawings_for_write(
       grease_pencil, layer_mask, frame);
-  threading::parallel_for(drawings.index_range(), 1, [&](const IndexRange range) {
-    for (const int drawing_i : range) {
-      deform_drawing(md, ctx, *drawings[drawing_i]);
-    }
-  });
+  modifier::greasepencil::foreach_drawing(
+      drawings, [&](Drawing *drawing) { deform_drawing(md, ctx, *drawing); });
 
   frame_clear(mmd);
 }
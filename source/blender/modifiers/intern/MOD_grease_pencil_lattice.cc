@@ -144,7 +144,7 @@ static void modify_geometry_set(ModifierData *md,
   const int frame = grease_pencil.runtime->eval_frame;
   const Vector<Drawing *> drawings = modifier::greasepencil::get_drawings_for_write(
       grease_pencil, layer_mask, frame);
-  threading::parallel_for_each(
+  modifier::greasepencil::foreach_drawing(
       drawings, [&](Drawing *drawing) { modify_curves(md, ctx, *cache_data, *drawing); });
 
   BKE_lattice_deform_data_destroy(cache_data);
@@ -414,7 +414,7 @@ static void modify_geometry_set(ModifierData *md,
   const Vector<modifier::greasepencil::FrameDrawingInfo> drawing_infos =
       modifier::greasepencil::get_drawing_infos_by_frame(grease_pencil, layer_mask, current_frame);
 
-  threading::parallel_for_each(
+  modifier::greasepencil::foreach_drawing(
       drawing_infos, [&](const modifier::greasepencil::FrameDrawingInfo &info) {
         deform_drawing(*mmd, *ctx->object, current_frame, info.start_frame_number, *info.drawing);
       });
@@ -364,7 +364,7 @@ static void modify_geometry_set(ModifierData *md,
   if (omd->offset_mode == MOD_GREASE_PENCIL_OFFSET_LAYER) {
     const Vector<LayerDrawingInfo> drawings = modifier::greasepencil::get_drawing_infos_by_layer(
         grease_pencil, layer_mask, frame);
-    threading::parallel_for_each(drawings, [&](const LayerDrawingInfo &info) {
+    modifier::greasepencil::foreach_drawing(drawings, [&](const LayerDrawingInfo &info) {
       modify_drawing_by_layer(
           *md, *ctx, *info.drawing, info.layer_index, grease_pencil.layers().size());
     });
@@ -372,8 +372,8 @@ static void modify_geometry_set(ModifierData *md,
   else {
     const Vector<Drawing *> drawings = modifier::greasepencil::get_drawings_for_write(
         grease_pencil, layer_mask, frame);
-    threading::parallel_for_each(drawings,
-                                 [&](Drawing *drawing) { modify_drawing(*md, *ctx, *drawing); });
+    modifier::greasepencil::foreach_drawing(
+        drawings, [&](Drawing *drawing) { modify_drawing(*md, *ctx, *drawing); });
   }
 }
 
@@ -136,7 +136,7 @@ static void modify_geometry_set(ModifierData *md,
   const Vector<bke::greasepencil::Drawing *> drawings =
       modifier::greasepencil::get_drawings_for_write(grease_pencil, layer_mask, current_frame);
 
-  threading::parallel_for_each(drawings, [&](bke::greasepencil::Drawing *drawing) {
+  modifier::greasepencil::foreach_drawing(drawings, [&](bke::greasepencil::Drawing *drawing) {
     subdivide_drawing(*md, *ctx->object, *drawing);
   });
 }
@@ -9,6 +9,7 @@
 #include "MOD_grease_pencil_util.hh"
 
 #include "BLI_set.hh"
+#include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
 #include "DNA_grease_pencil_types.h"
@@ -391,4 +392,52 @@ Vector<FrameDrawingInfo> get_drawing_infos_by_frame(GreasePencil &grease_pencil,
   return drawing_infos;
 }
 
+/* Approximate number of points processed by a single task. */
+static constexpr int64_t foreach_drawing_grain_size = 4096;
+
+static void foreach_drawing_impl(const int64_t drawings_num,
+                                 const FunctionRef<int64_t(int64_t)> get_points_num,
+                                 const FunctionRef<void(int64_t)> fn)
+{
+  threading::parallel_for(
+      IndexRange(drawings_num),
+      foreach_drawing_grain_size,
+      [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          fn(i);
+        }
+      },
+      threading::individual_task_sizes(
+          [&](const int64_t i) {
+            /* Also account for the fixed cost of empty drawings. */
+            return get_points_num(i) + 1;
+          }));
+}
+
+void foreach_drawing(const Span<Drawing *> drawings, const FunctionRef<void(Drawing *drawing)> fn)
+{
+  foreach_drawing_impl(
+      drawings.size(),
+      [&](const int64_t i) { return drawings[i]->strokes().points_num(); },
+      [&](const int64_t i) { fn(drawings[i]); });
+}
+
+void foreach_drawing(const Span<LayerDrawingInfo> drawing_infos,
+                     const FunctionRef<void(const LayerDrawingInfo &info)> fn)
+{
+  foreach_drawing_impl(
+      drawing_infos.size(),
+      [&](const int64_t i) { return drawing_infos[i].drawing->strokes().points_num(); },
+      [&](const int64_t i) { fn(drawing_infos[i]); });
+}
+
+void foreach_drawing(const Span<FrameDrawingInfo> drawing_infos,
+                     const FunctionRef<void(const FrameDrawingInfo &info)> fn)
+{
+  foreach_drawing_impl(
+      drawing_infos.size(),
+      [&](const int64_t i) { return drawing_infos[i].drawing->strokes().points_num(); },
+      [&](const int64_t i) { fn(drawing_infos[i]); });
+}
+
 }  // namespace blender::modifier::greasepencil
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "BLI_function_ref.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_vector.hh"
 
@@ -86,4 +87,16 @@ Vector<FrameDrawingInfo> get_drawing_infos_by_frame(GreasePencil &grease_pencil,
                                                     const IndexMask &layer_mask,
                                                     int frame);
 
+/**
+ * Call the function for every drawing, in parallel. The work is balanced by the number of points
+ * of the drawings: drawings with few points are grouped into one task, so stacks of many small
+ * layers do not pay the threading overhead for each of them.
+ */
+void foreach_drawing(Span<bke::greasepencil::Drawing *> drawings,
+                     FunctionRef<void(bke::greasepencil::Drawing *drawing)> fn);
+void foreach_drawing(Span<LayerDrawingInfo> drawing_infos,
+                     FunctionRef<void(const LayerDrawingInfo &info)> fn);
+void foreach_drawing(Span<FrameDrawingInfo> drawing_infos,
+                     FunctionRef<void(const FrameDrawingInfo &info)> fn);
+
 }  // namespace blender::modifier::greasepencil
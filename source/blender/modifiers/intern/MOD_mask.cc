@@ -364,8 +364,12 @@ static void add_interp_verts_copy_edges_to_new_mesh(const Mesh &src_mesh,
   const Span<int2> src_edges = src_mesh.edges();
   MutableSpan<int2> dst_edges = dst_mesh.edges_for_write();
 
-  uint vert_index = dst_mesh.verts_num - verts_add_num;
+  const int verts_add_start = dst_mesh.verts_num - verts_add_num;
+  uint vert_index = verts_add_start;
   uint edge_index = edges_masked_num - verts_add_num;
+  /* The new vertices are interpolated from the vertices of the cut edges in a single pass. */
+  Array<int> interp_src_verts(verts_add_num * 2);
+  Array<float> interp_weights(verts_add_num * 2);
   for (int i_src : IndexRange(src_mesh.edges_num)) {
     if (r_edge_map[i_src] != -1) {
       int i_dst = r_edge_map[i_src];
@@ -398,19 +402,24 @@ static void add_interp_verts_copy_edges_to_new_mesh(const Mesh &src_mesh,
       float fac = get_interp_factor_from_vgroup(
           dvert, defgrp_index, threshold, e_src[0], e_src[1]);
 
-      float weights[2] = {1.0f - fac, fac};
-      CustomData_interp(&src_mesh.vert_data,
-                        &dst_mesh.vert_data,
-                        (int *)&e_src[0],
-                        weights,
-                        nullptr,
-                        2,
-                        vert_index);
+      const int interp_index = (vert_index - verts_add_start) * 2;
+      interp_src_verts[interp_index] = e_src[0];
+      interp_src_verts[interp_index + 1] = e_src[1];
+      interp_weights[interp_index] = 1.0f - fac;
+      interp_weights[interp_index + 1] = fac;
       vert_index++;
     }
   }
   BLI_assert(vert_index == dst_mesh.verts_num);
   BLI_assert(edge_index == edges_masked_num);
+  Array<int> interp_offsets(verts_add_num + 1);
+  blender::offset_indices::fill_constant_group_size(2, 0, interp_offsets);
+  CustomData_interp_groups(&src_mesh.vert_data,
+                           &dst_mesh.vert_data,
+                           blender::OffsetIndices<int>(interp_offsets),
+                           interp_src_verts,
+                           interp_weights,
+                           verts_add_start);
 }
 
 static void copy_masked_edges_to_new_mesh(const Mesh &src_mesh,
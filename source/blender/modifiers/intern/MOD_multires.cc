@@ -7,9 +7,13 @@
  */
 
 #include <cstddef>
+#include <utility>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array_utils.hh"
+#include "BLI_implicit_sharing_ptr.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -45,7 +49,22 @@
 
 struct MultiresRuntimeData {
   /* Cached subdivision surface descriptor, with topology and settings. */
-  blender::bke::subdiv::Subdiv *subdiv;
+  blender::bke::subdiv::Subdiv *subdiv = nullptr;
+
+  /**
+   * Grids of the last evaluation in sculpt mode. When the base mesh topology did not change, they
+   * are updated in place for the changed base mesh positions instead of evaluating all grids.
+   */
+  std::shared_ptr<SubdivCCG> subdiv_ccg;
+  /** Base mesh positions the grids were evaluated for. */
+  blender::Array<blender::float3> subdiv_ccg_positions;
+  /**
+   * Users of the displacement and mask layers the grids were evaluated for. Because they are
+   * shared, modifying them makes a copy, so changes can be detected by comparing the pointers.
+   */
+  blender::ImplicitSharingPtr<blender::ImplicitSharingInfo> subdiv_ccg_displacement;
+  blender::ImplicitSharingPtr<blender::ImplicitSharingInfo> subdiv_ccg_mask;
+  int subdiv_ccg_totlvl = 0;
 };
 
 static void init_data(ModifierData *md)
@@ -82,7 +101,7 @@ static void free_runtime_data(void *runtime_data_v)
   if (runtime_data->subdiv != nullptr) {
     blender::bke::subdiv::free(runtime_data->subdiv);
   }
-  MEM_freeN(runtime_data);
+  MEM_delete(runtime_data);
 }
 
 static void free_data(ModifierData *md)
@@ -95,8 +114,7 @@ static MultiresRuntimeData *multires_ensure_runtime(MultiresModifierData *mmd)
 {
   MultiresRuntimeData *runtime_data = (MultiresRuntimeData *)mmd->modifier.runtime;
   if (runtime_data == nullptr) {
-    runtime_data = static_cast<MultiresRuntimeData *>(
-        MEM_callocN(sizeof(*runtime_data), __func__));
+    runtime_data = MEM_new<MultiresRuntimeData>(__func__);
     mmd->modifier.runtime = runtime_data;
   }
   return runtime_data;
@@ -163,6 +181,64 @@ static void multires_ccg_settings_init(SubdivToCCGSettings *settings,
   settings->need_mask = has_mask;
 }
 
+static const blender::ImplicitSharingInfo *corner_layer_sharing_info(const Mesh &mesh,
+                                                                    const eCustomDataType type)
+{
+  const int layer_index = CustomData_get_layer_index(&mesh.corner_data, type);
+  if (layer_index == -1) {
+    return nullptr;
+  }
+  return mesh.corner_data.layers[layer_index].sharing_info;
+}
+
+static blender::ImplicitSharingPtr<blender::ImplicitSharingInfo> corner_layer_user_add(
+    const Mesh &mesh, const eCustomDataType type)
+{
+  const blender::ImplicitSharingInfo *sharing_info = corner_layer_sharing_info(mesh, type);
+  if (sharing_info != nullptr) {
+    sharing_info->add_user();
+  }
+  return blender::ImplicitSharingPtr<blender::ImplicitSharingInfo>(sharing_info);
+}
+
+static bool corner_layer_is_unchanged(
+    const Mesh &mesh,
+    const eCustomDataType type,
+    const blender::ImplicitSharingPtr<blender::ImplicitSharingInfo> &cached_sharing_info)
+{
+  if (!CustomData_has_layer(&mesh.corner_data, type)) {
+    return !cached_sharing_info;
+  }
+  const blender::ImplicitSharingInfo *sharing_info = corner_layer_sharing_info(mesh, type);
+  return sharing_info != nullptr && sharing_info == cached_sharing_info.get();
+}
+
+static void multires_ccg_cache_store(MultiresRuntimeData &runtime_data,
+                                     const MultiresModifierData &mmd,
+                                     const Mesh &mesh,
+                                     const Mesh &result)
+{
+  runtime_data.subdiv_ccg = result.runtime->subdiv_ccg;
+  if (!runtime_data.subdiv_ccg) {
+    runtime_data.subdiv_ccg_positions = {};
+    runtime_data.subdiv_ccg_displacement = {};
+    runtime_data.subdiv_ccg_mask = {};
+    return;
+  }
+  runtime_data.subdiv_ccg_positions = mesh.vert_positions();
+  runtime_data.subdiv_ccg_displacement = corner_layer_user_add(mesh, CD_MDISPS);
+  runtime_data.subdiv_ccg_mask = corner_layer_user_add(mesh, CD_GRID_PAINT_MASK);
+  runtime_data.subdiv_ccg_totlvl = mmd.totlvl;
+}
+
+static void multires_ccg_cache_free(MultiresRuntimeData &runtime_data)
+{
+  runtime_data.subdiv_ccg.reset();
+  runtime_data.subdiv_ccg_positions = {};
+  runtime_data.subdiv_ccg_displacement = {};
+  runtime_data.subdiv_ccg_mask = {};
+}
+
 static Mesh *multires_as_ccg(MultiresModifierData *mmd,
                              const ModifierEvalContext *ctx,
                              Mesh *mesh,
@@ -182,10 +258,101 @@ static Mesh *multires_as_ccg(MultiresModifierData *mmd,
    * on the ownership model here. */
   MultiresRuntimeData *runtime_data = static_cast<MultiresRuntimeData *>(mmd->modifier.runtime);
   runtime_data->subdiv = nullptr;
+  if (result != nullptr) {
+    multires_ccg_cache_store(*runtime_data, *mmd, *mesh, *result);
+  }
 
   return result;
 }
 
+/**
+ * Reuse the grids of the previous evaluation when the base mesh has the same topology and only
+ * some of its positions changed, so that only the grids around the changed vertices have to be
+ * evaluated again. Returns null when the grids have to be created from scratch.
+ */
+static Mesh *multires_as_ccg_from_cache(MultiresModifierData *mmd,
+                                        const ModifierEvalContext *ctx,
+                                        const blender::bke::subdiv::Settings *subdiv_settings,
+                                        Mesh *mesh)
+{
+  using namespace blender;
+  MultiresRuntimeData *runtime_data = static_cast<MultiresRuntimeData *>(mmd->modifier.runtime);
+  /* The grids are modified in place, which is only possible when no evaluated mesh uses them. */
+  if (!runtime_data->subdiv_ccg || runtime_data->subdiv_ccg.use_count() != 1) {
+    return nullptr;
+  }
+  SubdivCCG &subdiv_ccg = *runtime_data->subdiv_ccg;
+  SubdivToCCGSettings ccg_settings;
+  multires_ccg_settings_init(&ccg_settings, mmd, ctx, mesh);
+  if (ccg_settings.resolution != subdiv_ccg.grid_size ||
+      ccg_settings.need_mask != subdiv_ccg.has_mask ||
+      mmd->totlvl != runtime_data->subdiv_ccg_totlvl || subdiv_ccg.dirty.coords ||
+      subdiv_ccg.dirty.hidden ||
+      mesh->verts_num != runtime_data->subdiv_ccg_positions.size() ||
+      !corner_layer_is_unchanged(*mesh, CD_MDISPS, runtime_data->subdiv_ccg_displacement) ||
+      !corner_layer_is_unchanged(*mesh, CD_GRID_PAINT_MASK, runtime_data->subdiv_ccg_mask))
+  {
+    multires_ccg_cache_free(*runtime_data);
+    return nullptr;
+  }
+
+  bke::subdiv::Subdiv *subdiv = subdiv_ccg.subdiv;
+  subdiv_ccg.subdiv = bke::subdiv::update_from_mesh(subdiv, subdiv_settings, mesh);
+  if (subdiv_ccg.subdiv != subdiv) {
+    /* The old descriptor was freed because the topology changed. Keep the new one, it can be used
+     * to create the new grids. */
+    if (runtime_data->subdiv == nullptr) {
+      runtime_data->subdiv = std::exchange(subdiv_ccg.subdiv, nullptr);
+    }
+    multires_ccg_cache_free(*runtime_data);
+    return nullptr;
+  }
+
+  const Span<float3> positions = mesh->vert_positions();
+  const Span<float3> cached_positions = runtime_data->subdiv_ccg_positions;
+  IndexMaskMemory memory;
+  const IndexMask changed_verts = IndexMask::from_predicate(
+      positions.index_range(), GrainSize(4096), memory, [&](const int vert) {
+        return positions[vert] != cached_positions[vert];
+      });
+
+  bke::subdiv::displacement_attach_from_multires(subdiv, mesh, mmd);
+  if (!BKE_subdiv_ccg_update_from_mesh(subdiv_ccg, *mesh, changed_verts)) {
+    multires_ccg_cache_free(*runtime_data);
+    return nullptr;
+  }
+  array_utils::copy(positions, runtime_data->subdiv_ccg_positions.as_mutable_span());
+
+  Mesh *result = BKE_mesh_new_nomain_from_template(mesh, 0, 0, 0, 0);
+  result->runtime->subdiv_ccg = runtime_data->subdiv_ccg;
+  return result;
+}
+
+static void multires_ccg_sculpt_session_init(MultiresModifierData *mmd,
+                                             const ModifierEvalContext *ctx,
+                                             const Mesh *mesh,
+                                             Mesh *result)
+{
+  result->runtime->subdiv_ccg_tot_level = mmd->totlvl;
+  /* TODO(sergey): Usually it is sculpt stroke's update variants which
+   * takes care of this, but is possible that we need this before the
+   * stroke: i.e. when exiting blender right after stroke is done.
+   * Annoying and not so much black-boxed as far as sculpting goes, and
+   * surely there is a better way of solving this. */
+  if (ctx->object->sculpt != nullptr) {
+    SculptSession *sculpt_session = ctx->object->sculpt;
+    sculpt_session->subdiv_ccg = result->runtime->subdiv_ccg.get();
+    sculpt_session->multires.active = true;
+    sculpt_session->multires.modifier = mmd;
+    sculpt_session->multires.level = mmd->sculptlvl;
+    sculpt_session->totvert = mesh->verts_num;
+    sculpt_session->faces_num = mesh->faces_num;
+    sculpt_session->vert_positions = {};
+    sculpt_session->faces = {};
+    sculpt_session->corner_verts = {};
+  }
+}
+
 static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
   Mesh *result = mesh;
@@ -200,13 +367,6 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
     return result;
   }
   MultiresRuntimeData *runtime_data = multires_ensure_runtime(mmd);
-  blender::bke::subdiv::Subdiv *subdiv = subdiv_descriptor_ensure(mmd, &subdiv_settings, mesh);
-  if (subdiv == nullptr) {
-    /* Happens on bad topology, also on empty input mesh. */
-    return result;
-  }
-  const bool use_clnors = mmd->flags & eMultiresModifierFlag_UseCustomNormals &&
-                          mesh->normals_domain() == blender::bke::MeshNormalDomain::Corner;
   /* NOTE: Orco needs final coordinates on CPU side, which are expected to be
    * accessible via mesh vertices. For this reason we do not evaluate multires to
    * grids when orco is requested. */
@@ -216,27 +376,30 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
 
   const bool sculpt_base_mesh = mmd->flags & eMultiresModifierFlag_UseSculptBaseMesh;
 
-  if ((ctx->object->mode & OB_MODE_SCULPT) && !for_orco && !for_render && !sculpt_base_mesh) {
+  const bool use_ccg = (ctx->object->mode & OB_MODE_SCULPT) && !for_orco && !for_render &&
+                       !sculpt_base_mesh;
+  if (use_ccg) {
+    if (Mesh *ccg_result = multires_as_ccg_from_cache(mmd, ctx, &subdiv_settings, mesh)) {
+      multires_ccg_sculpt_session_init(mmd, ctx, mesh, ccg_result);
+      return ccg_result;
+    }
+  }
+  else {
+    multires_ccg_cache_free(*runtime_data);
+  }
+
+  blender::bke::subdiv::Subdiv *subdiv = subdiv_descriptor_ensure(mmd, &subdiv_settings, mesh);
+  if (subdiv == nullptr) {
+    /* Happens on bad topology, also on empty input mesh. */
+    return result;
+  }
+  const bool use_clnors = mmd->flags & eMultiresModifierFlag_UseCustomNormals &&
+                          mesh->normals_domain() == blender::bke::MeshNormalDomain::Corner;
+
+  if (use_ccg) {
     /* NOTE: CCG takes ownership over Subdiv. */
     result = multires_as_ccg(mmd, ctx, mesh, subdiv);
-    result->runtime->subdiv_ccg_tot_level = mmd->totlvl;
-    /* TODO(sergey): Usually it is sculpt stroke's update variants which
-     * takes care of this, but is possible that we need this before the
-     * stroke: i.e. when exiting blender right after stroke is done.
-     * Annoying and not so much black-boxed as far as sculpting goes, and
-     * surely there is a better way of solving this. */
-    if (ctx->object->sculpt != nullptr) {
-      SculptSession *sculpt_session = ctx->object->sculpt;
-      sculpt_session->subdiv_ccg = result->runtime->subdiv_ccg.get();
-      sculpt_session->multires.active = true;
-      sculpt_session->multires.modifier = mmd;
-      sculpt_session->multires.level = mmd->sculptlvl;
-      sculpt_session->totvert = mesh->verts_num;
-      sculpt_session->faces_num = mesh->faces_num;
-      sculpt_session->vert_positions = {};
-      sculpt_session->faces = {};
-      sculpt_session->corner_verts = {};
-    }
+    multires_ccg_sculpt_session_init(mmd, ctx, mesh, result);
     // blender::bke::subdiv::stats_print(&subdiv->stats);
   }
   else {
@@ -21,6 +21,7 @@
 #include "BLI_path_util.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_array_utils.hh"
@@ -92,6 +93,7 @@
 #include "NOD_geometry.hh"
 #include "NOD_geometry_nodes_execute.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_node_result_cache.hh"
 #include "NOD_node_declaration.hh"
 
 #include "FN_field.hh"
@@ -926,25 +928,77 @@ static BakeFrameIndices get_bake_frame_indices(
   return frame_indices;
 }
 
-static void ensure_bake_loaded(bake::NodeBakeCache &bake_cache, bake::FrameCache &frame_cache)
+/** The #bake::FrameCache::load_mutex has to be locked by the caller. */
+static void load_baked_frame(const bake::NodeBakeCache &bake_cache, bake::FrameCache &frame_cache)
 {
-  if (!frame_cache.state.items_by_id.is_empty()) {
+  frame_cache.load_attempted = true;
+  bke::bake::DiskBlobReader blob_reader{*bake_cache.blobs_dir};
+  fstream meta_file{*frame_cache.meta_path};
+  std::optional<bke::bake::BakeState> bake_state = bke::bake::deserialize_bake(
+      meta_file, blob_reader, *bake_cache.blob_sharing);
+  if (!bake_state.has_value()) {
     return;
   }
+  frame_cache.state = std::move(*bake_state);
+}
+
+static void ensure_bake_loaded(bake::NodeBakeCache &bake_cache, bake::FrameCache &frame_cache)
+{
   if (!bake_cache.blobs_dir) {
     return;
   }
   if (!frame_cache.meta_path) {
     return;
   }
-  bke::bake::DiskBlobReader blob_reader{*bake_cache.blobs_dir};
-  fstream meta_file{*frame_cache.meta_path};
-  std::optional<bke::bake::BakeState> bake_state = bke::bake::deserialize_bake(
-      meta_file, blob_reader, *bake_cache.blob_sharing);
-  if (!bake_state.has_value()) {
+  std::lock_guard lock{frame_cache.load_mutex};
+  if (!frame_cache.state.items_by_id.is_empty()) {
     return;
   }
-  frame_cache.state = std::move(*bake_state);
+  load_baked_frame(bake_cache, frame_cache);
+}
+
+/**
+ * Number of frames after the ones that are read that are loaded in the background. During
+ * playback, the next frame is then usually loaded by the time it is needed.
+ */
+static constexpr int bake_prefetch_frames_num = 2;
+
+static void prefetch_baked_frame_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const bake::NodeBakeCache &bake_cache = *static_cast<const bake::NodeBakeCache *>(
+      BLI_task_pool_user_data(pool));
+  bake::FrameCache &frame_cache = *static_cast<bake::FrameCache *>(taskdata);
+  std::lock_guard lock{frame_cache.load_mutex};
+  /* Don't retry when loading on the evaluation thread failed already. */
+  if (frame_cache.load_attempted) {
+    return;
+  }
+  load_baked_frame(bake_cache, frame_cache);
+}
+
+/**
+ * Start loading the lazily loaded frames following the given frame index in the background. This
+ * has to be called while the #bake::ModifierCache is locked.
+ */
+static void prefetch_baked_frames(bake::NodeBakeCache &bake_cache, const int last_read_index)
+{
+  if (!bake_cache.blobs_dir) {
+    return;
+  }
+  const IndexRange prefetch_range = IndexRange(last_read_index + 1, bake_prefetch_frames_num)
+                                        .intersect(bake_cache.frames.index_range());
+  for (const int frame_index : prefetch_range) {
+    bake::FrameCache &frame_cache = *bake_cache.frames[frame_index];
+    if (!frame_cache.meta_path || frame_cache.prefetch_scheduled) {
+      continue;
+    }
+    frame_cache.prefetch_scheduled = true;
+    if (!bake_cache.prefetch_pool) {
+      bake_cache.prefetch_pool = BLI_task_pool_create_background(&bake_cache, TASK_PRIORITY_LOW);
+    }
+    BLI_task_pool_push(
+        bake_cache.prefetch_pool, prefetch_baked_frame_task, &frame_cache, false, nullptr);
+  }
 }
 
 static bool try_find_baked_data(bake::NodeBakeCache &bake,
@@ -1260,6 +1314,8 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
       const float delta_frames = std::min(max_delta_frames,
                                           float(current_frame_) - float(frame_cache.frame));
       output_copy_info.delta_time = delta_frames / fps_;
+      /* The frame may be loaded by a prefetch task currently. */
+      std::lock_guard lock{frame_cache.load_mutex};
       output_copy_info.state = frame_cache.state;
     }
     else {
@@ -1291,6 +1347,7 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
   {
     bake::FrameCache &frame_cache = *node_cache.bake.frames[frame_index];
     ensure_bake_loaded(node_cache.bake, frame_cache);
+    prefetch_baked_frames(node_cache.bake, frame_index);
     auto &read_single_info = zone_behavior.output.emplace<sim_output::ReadSingle>();
     read_single_info.state = frame_cache.state;
   }
@@ -1304,6 +1361,7 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
     bake::FrameCache &next_frame_cache = *node_cache.bake.frames[next_frame_index];
     ensure_bake_loaded(node_cache.bake, prev_frame_cache);
     ensure_bake_loaded(node_cache.bake, next_frame_cache);
+    prefetch_baked_frames(node_cache.bake, next_frame_index);
     auto &read_interpolated_info = zone_behavior.output.emplace<sim_output::ReadInterpolated>();
     read_interpolated_info.mix_factor = (float(current_frame_) - float(prev_frame_cache.frame)) /
                                         (float(next_frame_cache.frame) -
@@ -1434,6 +1492,7 @@ class NodesModifierBakeParams : public nodes::GeoNodesBakeParams {
   {
     bake::FrameCache &frame_cache = *node_cache.bake.frames[frame_index];
     ensure_bake_loaded(node_cache.bake, frame_cache);
+    prefetch_baked_frames(node_cache.bake, frame_index);
     if (this->check_read_error(frame_cache, behavior)) {
       return;
     }
@@ -1450,6 +1509,7 @@ class NodesModifierBakeParams : public nodes::GeoNodesBakeParams {
     bake::FrameCache &next_frame_cache = *node_cache.bake.frames[next_frame_index];
     ensure_bake_loaded(node_cache.bake, prev_frame_cache);
     ensure_bake_loaded(node_cache.bake, next_frame_cache);
+    prefetch_baked_frames(node_cache.bake, next_frame_index);
     if (this->check_read_error(prev_frame_cache, behavior) ||
         this->check_read_error(next_frame_cache, behavior))
     {
@@ -1716,6 +1776,23 @@ static void modifyGeometry(ModifierData *md,
   find_side_effect_nodes(*nmd, *ctx, side_effect_nodes);
   call_data.side_effect_nodes = &side_effect_nodes;
 
+  /* Only use the cache in the active depsgraph, other depsgraphs may evaluate the same modifier
+   * at the same time. The cache is stored in the original modifier to keep it when the evaluated
+   * modifier is copied again. */
+  std::shared_ptr<nodes::GeoNodesNodeResultCache> node_result_cache;
+  if (DEG_is_active(ctx->depsgraph) && !(ctx->flag & MOD_APPLY_TO_BASE_MESH)) {
+    if (nmd->flag & NODES_MODIFIER_CACHE_NODE_RESULTS) {
+      if (!nmd_orig->runtime->node_result_cache) {
+        nmd_orig->runtime->node_result_cache = std::make_shared<nodes::GeoNodesNodeResultCache>();
+      }
+      node_result_cache = nmd_orig->runtime->node_result_cache;
+      call_data.node_result_cache = node_result_cache.get();
+    }
+    else {
+      nmd_orig->runtime->node_result_cache.reset();
+    }
+  }
+
   bke::ModifierComputeContext modifier_compute_context{nullptr, nmd->modifier.name};
 
   geometry_set = nodes::execute_geometry_nodes_on_geometry(tree,
@@ -1724,6 +1801,10 @@ static void modifyGeometry(ModifierData *md,
                                                            call_data,
                                                            std::move(geometry_set));
 
+  if (node_result_cache) {
+    node_result_cache->evaluation_finished();
+  }
+
   if (logging_enabled(ctx)) {
     nmd_orig->runtime->eval_log = std::move(eval_log);
   }
@@ -2266,6 +2347,8 @@ static void draw_manage_panel(const bContext *C,
                               PointerRNA *modifier_ptr,
                               NodesModifierData &nmd)
 {
+  uiItemR(layout, modifier_ptr, "use_node_result_cache", UI_ITEM_NONE, nullptr, ICON_NONE);
+
   if (uiLayout *panel_layout = uiLayoutPanelProp(
           C, layout, modifier_ptr, "open_bake_panel", IFACE_("Bake")))
   {
@@ -2457,6 +2540,7 @@ static void copy_data(const ModifierData *md, ModifierData *target, const int fl
   if (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) {
     /* Share the simulation cache between the original and evaluated modifier. */
     tnmd->runtime->cache = nmd->runtime->cache;
+    tnmd->runtime->node_result_cache = nmd->runtime->node_result_cache;
     /* Keep bake path in the evaluated modifier. */
     tnmd->bake_directory = nmd->bake_directory ? BLI_strdup(nmd->bake_directory) : nullptr;
   }
@@ -39,6 +39,8 @@ struct Scene;
 
 namespace blender::nodes {
 
+class GeoNodesNodeResultCache;
+
 using lf::LazyFunction;
 using mf::MultiFunction;
 
@@ -230,6 +232,11 @@ struct GeoNodesCallData {
    * If this is null, all socket values will be logged.
    */
   const Set<ComputeContextHash> *socket_log_contexts = nullptr;
+  /**
+   * Optional cache of node results from the previous evaluation, to skip executing nodes of which
+   * the inputs did not change.
+   */
+  GeoNodesNodeResultCache *node_result_cache = nullptr;
 
   /**
    * Data from the modifier that is being evaluated.
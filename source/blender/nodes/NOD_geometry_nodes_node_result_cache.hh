@@ -0,0 +1,100 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/**
+ * The node result cache keeps the inputs and outputs of geometry nodes from the previous
+ * evaluation of a node tree. When a node is executed again with the same inputs and settings, the
+ * cached outputs are used instead. That way, changing a value near the end of a large node tree
+ * only recomputes the nodes that depend on it.
+ *
+ * Nodes are identified by their compute context hash and identifier. Inputs are compared by
+ * value for single values and fields, and by the identity of their data for geometries. Because
+ * the cache keeps the compared inputs alive, data that is shared with them can't be freed and
+ * reused for different data in the meantime.
+ */
+
+#include <mutex>
+
+#include "BLI_compute_context.hh"
+#include "BLI_generic_pointer.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "NOD_geometry_nodes_log.hh"
+
+struct bNode;
+
+namespace blender::nodes {
+
+class GeoNodesNodeResultCache : NonCopyable, NonMovable {
+ public:
+  struct Key {
+    ComputeContextHash context_hash;
+    int32_t node_id;
+
+    uint64_t hash() const
+    {
+      return get_default_hash(context_hash, node_id);
+    }
+
+    BLI_STRUCT_EQUALITY_OPERATORS_2(Key, context_hash, node_id)
+  };
+
+  struct AttributeUsage {
+    std::string name;
+    geo_eval_log::NamedAttributeUsage usage;
+  };
+
+  /** The result of one execution of a node. */
+  struct Entry : NonCopyable, NonMovable {
+    /** Owns the memory of the input and output values. */
+    LinearAllocator<> allocator;
+    /** The settings of the node that are not passed as inputs, see #node_settings_get. */
+    Vector<std::byte> settings;
+    Vector<GMutablePointer> inputs;
+    Vector<GMutablePointer> outputs;
+    /** Logged by the node during execution, logged again when the entry is used. */
+    Vector<geo_eval_log::NodeWarning> warnings;
+    Vector<AttributeUsage> used_named_attributes;
+    /** Entries that are not used in an evaluation are removed, see #evaluation_finished. */
+    int last_used_evaluation = 0;
+
+    ~Entry();
+  };
+
+ private:
+  std::mutex mutex_;
+  Map<Key, std::unique_ptr<Entry>> entries_;
+  int evaluation_ = 0;
+
+ public:
+  /**
+   * Get the entry of the node from a previous evaluation. It stays valid until
+   * #evaluation_finished is called.
+   */
+  const Entry *lookup(const Key &key);
+  /** Add the result of a node, replacing the previous one. */
+  void add(const Key &key, std::unique_ptr<Entry> entry);
+  /** Remove the entries of nodes that were not executed in the last evaluation. */
+  void evaluation_finished();
+
+  /**
+   * Gather the settings of the node that change its result without being one of its inputs, like
+   * the operation of a math node.
+   */
+  static Vector<std::byte> node_settings_get(const bNode &node);
+  /** Whether values of the type can be compared with #values_are_equal. */
+  static bool type_is_supported(const CPPType &type);
+  /**
+   * Compare input values of a node. Geometries are equal when they reference the same data, even
+   * if they are stored in different data-blocks.
+   */
+  static bool values_are_equal(const CPPType &type, const void *a, const void *b);
+};
+
+}  // namespace blender::nodes
@@ -0,0 +1,63 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/**
+ * Large fields that only consist of operations with a GPU implementation can be evaluated in a
+ * compute shader instead of on the CPU. Parts of the field that are not supported, like field
+ * inputs, are still evaluated on the CPU and uploaded to the GPU. The results are read back, so
+ * the consumer of the field does not have to know where it was evaluated.
+ *
+ * This is an experimental feature that is only used when enabled in the preferences. Shaders can
+ * only be dispatched on threads that have an active GPU context, other threads use the CPU.
+ */
+
+#include <string>
+
+#include "FN_multi_function.hh"
+
+namespace blender::nodes {
+
+/**
+ * Wraps a multi-function that can also be evaluated with a GLSL function. All parameters have to
+ * be single float values and the last one has to be the only output. The GLSL function has the
+ * signature of the functions in `gpu_shader_common_math.glsl`, i.e. three float inputs and a
+ * float output. Inputs that the multi-function does not have are passed as zero.
+ */
+class GPUMultiFunction : public mf::MultiFunction {
+ private:
+  const mf::MultiFunction &fn_;
+  std::string glsl_function_name_;
+  bool clamp_result_;
+
+ public:
+  GPUMultiFunction(const mf::MultiFunction &fn,
+                   std::string glsl_function_name,
+                   bool clamp_result = false);
+
+  void call(const IndexMask &mask, mf::Params params, mf::Context context) const override;
+
+  const std::string &glsl_function_name() const
+  {
+    return glsl_function_name_;
+  }
+
+  /** The result is clamped to the 0-1 range, on the CPU and the GPU. */
+  bool clamp_result() const
+  {
+    return clamp_result_;
+  }
+
+ private:
+  ExecutionHints get_execution_hints() const override;
+};
+
+/** Make #fn::evaluate_fields use the GPU for the fields that support it. */
+void gpu_field_evaluation_register();
+
+/** Free the cached shaders. This has to be called with an active GPU context. */
+void gpu_field_evaluation_free();
+
+}  // namespace blender::nodes
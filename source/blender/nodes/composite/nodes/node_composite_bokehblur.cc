@@ -14,6 +14,7 @@
 
 #include "GPU_texture.hh"
 
+#include "COM_algorithm_fft_convolution.hh"
 #include "COM_algorithm_parallel_reduction.hh"
 #include "COM_node_operation.hh"
 #include "COM_utilities.hh"
@@ -82,10 +83,23 @@ class BokehBlurOperation : public NodeOperation {
 
   void execute_constant_size()
   {
+    /* The cost of the direct convolution grows quadratically with the radius, so use an FFT
+     * convolution for large radii. The FFT convolution doesn't support masking, so only use it if
+     * the mask is a single value, which is necessarily non-zero, see is_identity(). */
+    const int radius = int(compute_blur_radius());
+    if (is_fft_convolution_preferred(radius) && get_input("Bounding box").is_single_value()) {
+      fft_convolution(get_input("Image"),
+                      get_input("Bokeh"),
+                      get_result("Image"),
+                      radius,
+                      get_extend_bounds());
+      return;
+    }
+
     GPUShader *shader = context().get_shader("compositor_bokeh_blur");
     GPU_shader_bind(shader);
 
-    GPU_shader_uniform_1i(shader, "radius", int(compute_blur_radius()));
+    GPU_shader_uniform_1i(shader, "radius", radius);
     GPU_shader_uniform_1b(shader, "extend_bounds", get_extend_bounds());
 
     const Result &input_image = get_input("Image");
@@ -100,7 +114,7 @@ class BokehBlurOperation : public NodeOperation {
     Domain domain = compute_domain();
     if (get_extend_bounds()) {
       /* Add a radius amount of pixels in both sides of the image, hence the multiply by 2. */
-      domain.size += int2(int(compute_blur_radius()) * 2);
+      domain.size += int2(radius * 2);
     }
 
     Result &output_image = get_result("Image");
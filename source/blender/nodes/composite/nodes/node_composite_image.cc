@@ -8,6 +8,7 @@
 
 #include "node_composite_util.hh"
 
+#include "BLI_hash.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_rect.h"
@@ -704,7 +705,7 @@ class RenderLayerOperation : public NodeOperation {
         execute_pass(image_result, combined_texture, "compositor_read_input_color");
       }
       if (alpha_result.should_compute()) {
-        execute_pass(alpha_result, combined_texture, "compositor_read_input_alpha");
+        execute_pass(alpha_result, combined_texture, "compositor_read_input_alpha", false);
       }
     }
 
@@ -736,7 +737,13 @@ class RenderLayerOperation : public NodeOperation {
     }
   }
 
-  void execute_pass(Result &result, GPUTexture *pass_texture, const char *shader_name)
+  /* Read the given pass texture into the given result using the given shader. If is_read_as_is is
+   * true, the shader is expected to read the pass without modifying its values, in which case, the
+   * pass texture might be used directly without copying it. */
+  void execute_pass(Result &result,
+                    GPUTexture *pass_texture,
+                    const char *shader_name,
+                    const bool is_read_as_is = true)
   {
     if (pass_texture == nullptr) {
       /* Pass not rendered yet, or not supported by viewport. */
@@ -750,24 +757,37 @@ class RenderLayerOperation : public NodeOperation {
       return;
     }
 
+    /* Depth passes always need to be stored in full precision. */
+    if (GPU_texture_has_depth_format(pass_texture)) {
+      result.set_precision(ResultPrecision::Full);
+    }
+
+    /* If the pass is read as is and the compositing region covers the entire pass, wrap the pass
+     * texture directly if it has the same format as the result to avoid a full copy of the pass.
+     * This is the common case for final renders, which composite passes in full precision
+     * without a border. Input textures are guaranteed to be kept alive throughout the
+     * evaluation. */
+    const rcti compositing_region = context().get_compositing_region();
+    const int2 lower_bound = int2(compositing_region.xmin, compositing_region.ymin);
+    const int2 compositing_region_size = context().get_compositing_region_size();
+    const int2 pass_size = int2(GPU_texture_width(pass_texture), GPU_texture_height(pass_texture));
+    if (is_read_as_is && lower_bound == int2(0) && compositing_region_size == pass_size &&
+        GPU_texture_format(pass_texture) == result.get_texture_format())
+    {
+      result.wrap_external(pass_texture);
+      return;
+    }
+
     GPUShader *shader = context().get_shader(shader_name);
     GPU_shader_bind(shader);
 
     /* The compositing space might be limited to a subset of the pass texture, so only read that
      * compositing region into an appropriately sized texture. */
-    const rcti compositing_region = context().get_compositing_region();
-    const int2 lower_bound = int2(compositing_region.xmin, compositing_region.ymin);
     GPU_shader_uniform_2iv(shader, "lower_bound", lower_bound);
 
     const int input_unit = GPU_shader_get_sampler_binding(shader, "input_tx");
     GPU_texture_bind(pass_texture, input_unit);
 
-    /* Depth passes always need to be stored in full precision. */
-    if (GPU_texture_has_depth_format(pass_texture)) {
-      result.set_precision(ResultPrecision::Full);
-    }
-
-    const int2 compositing_region_size = context().get_compositing_region_size();
     result.allocate_texture(Domain(compositing_region_size));
     result.bind_as_image(shader, "output_img");
 
@@ -777,6 +797,35 @@ class RenderLayerOperation : public NodeOperation {
     GPU_texture_unbind(pass_texture);
     result.unbind_as_image();
   }
+
+  uint64_t compute_node_cache_hash() override
+  {
+    /* The render passes can only be identified by their textures if they are persistent. */
+    if (!context().are_input_textures_persistent()) {
+      return 0;
+    }
+
+    const Scene *scene = reinterpret_cast<const Scene *>(bnode().id);
+    const int view_layer = bnode().custom1;
+
+    uint64_t hash = get_default_hash(StringRef(bnode().idname), view_layer);
+    for (const bNodeSocket *output : this->node()->output_sockets()) {
+      if (!should_compute_output(output->identifier)) {
+        continue;
+      }
+
+      const char *pass_name = STR_ELEM(output->identifier, "Image", "Alpha") ?
+                                  RE_PASSNAME_COMBINED :
+                                  output->identifier;
+      GPUTexture *pass_texture = context().get_input_texture(scene, view_layer, pass_name);
+      if (!pass_texture) {
+        return 0;
+      }
+      hash = get_default_hash(hash, StringRef(output->identifier), pass_texture);
+    }
+
+    return hash == 0 ? 1 : hash;
+  }
 };
 
 static NodeOperation *get_compositor_operation(Context &context, DNode node)
@@ -648,6 +648,12 @@ static void node_layout_ex(uiLayout *layout, bContext *C, PointerRNA *ptr)
                         ctx.bake->flag & NODES_MODIFIER_BAKE_CUSTOM_SIMULATION_FRAME_RANGE);
       uiItemR(subcol, &ctx.bake_rna, "frame_start", UI_ITEM_NONE, IFACE_("Start"), ICON_NONE);
       uiItemR(subcol, &ctx.bake_rna, "frame_end", UI_ITEM_NONE, IFACE_("End"), ICON_NONE);
+      uiItemR(settings_col,
+              &ctx.bake_rna,
+              "keyframe_interval",
+              UI_ITEM_NONE,
+              IFACE_("Keyframe Interval"),
+              ICON_NONE);
     }
   }
 
@@ -444,6 +444,12 @@ static void node_layout_ex(uiLayout *layout, bContext *C, PointerRNA *current_no
       uiItemR(subcol, &bake_rna, "frame_start", UI_ITEM_NONE, IFACE_("Start"), ICON_NONE);
       uiItemR(subcol, &bake_rna, "frame_end", UI_ITEM_NONE, IFACE_("End"), ICON_NONE);
     }
+    uiItemR(settings_col,
+            &bake_rna,
+            "keyframe_interval",
+            UI_ITEM_NONE,
+            IFACE_("Keyframe Interval"),
+            ICON_NONE);
   }
 
   draw_data_blocks(C, layout, bake_rna);
@@ -108,11 +108,10 @@ static int identifiers_to_indices(MutableSpan<int> r_identifiers_to_indices)
     return deduplicated_identifiers.index_of(identifier);
   });
 
+  Array<int> identifiers(deduplicated_identifiers.as_span());
   Array<int> indices(deduplicated_identifiers.size());
   array_utils::fill_index_range<int>(indices);
-  parallel_sort(indices.begin(), indices.end(), [&](const int index_a, const int index_b) {
-    return deduplicated_identifiers[index_a] < deduplicated_identifiers[index_b];
-  });
+  parallel_radix_sort<int, int>(identifiers, indices);
   Array<int> permutation = invert_permutation(indices);
   parallel_transform(
       r_identifiers_to_indices, 4096, [&](const int index) { return permutation[index]; });
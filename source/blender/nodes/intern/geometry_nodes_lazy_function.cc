@@ -22,6 +22,7 @@
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_node_result_cache.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 
@@ -49,6 +50,7 @@
 
 #include "DEG_depsgraph_query.hh"
 
+#include <atomic>
 #include <fmt/format.h>
 #include <sstream>
 
@@ -162,6 +164,16 @@ class LazyFunctionForGeometryNode : public LazyFunction {
    * does not have to execute.
    */
   Vector<bool> is_attribute_output_bsocket_;
+  /**
+   * True if the outputs of the node only depend on its inputs and settings, so that they can be
+   * reused from a previous evaluation, see #GeoNodesNodeResultCache.
+   */
+  bool use_result_cache_ = false;
+  /**
+   * Moving average of the time the node took to execute in previous evaluations in nanoseconds.
+   * It helps the graph executor to decide which nodes should run on separate threads.
+   */
+  mutable std::atomic<int64_t> run_time_estimate_ns_ = 0;
 
   struct OutputAttributeID {
     int bsocket_index;
@@ -186,6 +198,7 @@ class LazyFunctionForGeometryNode : public LazyFunction {
 
     const NodeDeclaration &node_decl = *node.declaration();
     const aal::RelationsInNode *relations = node_decl.anonymous_attribute_relations();
+    use_result_cache_ = this->supports_result_cache(relations);
     if (relations == nullptr) {
       return;
     }
@@ -224,6 +237,34 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     }
   }
 
+  /**
+   * Nodes without inputs often depend on the context, like the current frame or the self object,
+   * and nodes without outputs are only executed for their side effects.
+   * Data-block inputs can't be compared, because their data can change without the pointer
+   * changing, and imported files can change on disk. Anonymous attributes are created again in
+   * every evaluation.
+   */
+  bool supports_result_cache(const aal::RelationsInNode *relations) const
+  {
+    if (inputs_.is_empty() || outputs_.is_empty()) {
+      return false;
+    }
+    if (relations != nullptr &&
+        (!relations->available_relations.is_empty() || !relations->propagate_relations.is_empty()))
+    {
+      return false;
+    }
+    if (StringRef(node_.idname).startswith("GeometryNodeImport")) {
+      return false;
+    }
+    for (const lf::Input &input : inputs_) {
+      if (!GeoNodesNodeResultCache::type_is_supported(*input.type)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void *init_storage(LinearAllocator<> &allocator) const override
   {
     return allocator.construct<Storage>().release();
@@ -316,23 +357,189 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return;
     }
 
+    geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
+    GeoNodesNodeResultCache *result_cache = user_data->call_data->node_result_cache;
+    if (result_cache != nullptr && use_result_cache_) {
+      this->execute_with_result_cache(
+          *result_cache, params, context, *user_data, local_user_data, get_output_attribute_id);
+    }
+    else {
+      GeoNodeExecParams geo_params{
+          node_,
+          params,
+          context,
+          own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+          own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
+          get_output_attribute_id};
+      node_.typeinfo->geometry_node_execute(geo_params);
+    }
+    geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
+    this->update_run_time_estimate(end_time - start_time);
+
+    if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data))
+    {
+      tree_logger->node_execution_times.append(*tree_logger->allocator,
+                                               {node_.identifier, start_time, end_time});
+    }
+  }
+
+  std::chrono::nanoseconds estimated_run_time() const override
+  {
+    return std::chrono::nanoseconds(run_time_estimate_ns_.load(std::memory_order_relaxed));
+  }
+
+  void update_run_time_estimate(const std::chrono::nanoseconds run_time) const
+  {
+    /* Updates from different threads may overwrite each other, which is fine for an estimate. */
+    const int64_t old_estimate = run_time_estimate_ns_.load(std::memory_order_relaxed);
+    const int64_t new_estimate = old_estimate == 0 ? run_time.count() :
+                                                     (3 * old_estimate + run_time.count()) / 4;
+    run_time_estimate_ns_.store(std::max<int64_t>(new_estimate, 1), std::memory_order_relaxed);
+  }
+
+  /**
+   * Use the outputs from the previous evaluation if the inputs and settings of the node did not
+   * change. Otherwise execute the node and remember its inputs and outputs for the next
+   * evaluation.
+   */
+  void execute_with_result_cache(
+      GeoNodesNodeResultCache &result_cache,
+      lf::Params &params,
+      const lf::Context &context,
+      const GeoNodesLFUserData &user_data,
+      const GeoNodesLFLocalUserData &local_user_data,
+      const FunctionRef<AnonymousAttributeIDPtr(int)> get_output_attribute_id) const
+  {
+    using Entry = GeoNodesNodeResultCache::Entry;
+    const GeoNodesNodeResultCache::Key key{user_data.compute_context->hash(), node_.identifier};
+    Vector<std::byte> settings = GeoNodesNodeResultCache::node_settings_get(node_);
+
+    if (const Entry *entry = result_cache.lookup(key)) {
+      if (this->result_cache_entry_matches(*entry, params, settings)) {
+        GeoNodeExecParams geo_params{
+            node_,
+            params,
+            context,
+            own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+            own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
+            get_output_attribute_id};
+        for (const geo_eval_log::NodeWarning &warning : entry->warnings) {
+          geo_params.error_message_add(warning.type, warning.message);
+        }
+        for (const GeoNodesNodeResultCache::AttributeUsage &usage : entry->used_named_attributes) {
+          geo_params.used_named_attribute(usage.name, usage.usage);
+        }
+        for (const int i : outputs_.index_range()) {
+          if (params.get_output_usage(i) == lf::ValueUsage::Unused || params.output_was_set(i)) {
+            continue;
+          }
+          outputs_[i].type->copy_construct(entry->outputs[i].get(), params.get_output_data_ptr(i));
+          params.output_set(i);
+        }
+        return;
+      }
+    }
+
+    auto new_entry = std::make_unique<Entry>();
+    new_entry->settings = std::move(settings);
+
+    /* Copy the inputs before executing the node, which may move them. */
+    Array<GMutablePointer, 16> input_values(inputs_.size());
+    Array<std::optional<lf::ValueUsage>, 16> input_usages(inputs_.size());
+    for (const int i : inputs_.index_range()) {
+      const CPPType &type = *inputs_[i].type;
+      void *input_value = params.try_get_input_data_ptr(i);
+      void *cached_value = new_entry->allocator.allocate(type.size(), type.alignment());
+      type.copy_construct(input_value, cached_value);
+      new_entry->inputs.append({type, cached_value});
+      input_values[i] = {type, input_value};
+    }
+
+    /* All outputs are computed, even when they are not used currently, so that the cached result
+     * is complete. They are stored in the cache first and then copied to the actual outputs. */
+    Array<GMutablePointer, 16> output_values(outputs_.size());
+    Array<lf::ValueUsage, 16> output_usages(outputs_.size(), lf::ValueUsage::Used);
+    Array<bool, 16> set_outputs(outputs_.size(), false);
+    for (const int i : outputs_.index_range()) {
+      const CPPType &type = *outputs_[i].type;
+      output_values[i] = {type, new_entry->allocator.allocate(type.size(), type.alignment())};
+    }
+
+    lf::BasicParams cache_params{
+        *this, input_values, output_values, input_usages, output_usages, set_outputs};
     GeoNodeExecParams geo_params{
         node_,
-        params,
+        cache_params,
         context,
         own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
         own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
         get_output_attribute_id};
-
-    geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
     node_.typeinfo->geometry_node_execute(geo_params);
-    geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
 
-    if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data))
+    const bool all_outputs_set = !set_outputs.as_span().contains(false);
+    for (const int i : outputs_.index_range()) {
+      if (!set_outputs[i]) {
+        continue;
+      }
+      const CPPType &type = *outputs_[i].type;
+      if (all_outputs_set) {
+        type.copy_construct(output_values[i].get(), params.get_output_data_ptr(i));
+        new_entry->outputs.append(output_values[i]);
+      }
+      else {
+        type.move_construct(output_values[i].get(), params.get_output_data_ptr(i));
+        output_values[i].destruct();
+      }
+      params.output_set(i);
+    }
+    if (!all_outputs_set) {
+      return;
+    }
+
+    if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(user_data))
     {
-      tree_logger->node_execution_times.append(*tree_logger->allocator,
-                                               {node_.identifier, start_time, end_time});
+      for (const geo_eval_log::GeoTreeLogger::WarningWithNode &warning :
+           tree_logger->node_warnings)
+      {
+        if (warning.node_id == node_.identifier) {
+          new_entry->warnings.append(warning.warning);
+        }
+      }
+      for (const geo_eval_log::GeoTreeLogger::AttributeUsageWithNode &usage :
+           tree_logger->used_named_attributes)
+      {
+        if (usage.node_id == node_.identifier) {
+          new_entry->used_named_attributes.append({usage.attribute_name, usage.usage});
+        }
+      }
+    }
+    result_cache.add(key, std::move(new_entry));
+  }
+
+  bool result_cache_entry_matches(const GeoNodesNodeResultCache::Entry &entry,
+                                  const lf::Params &params,
+                                  const Span<std::byte> settings) const
+  {
+    if (entry.settings.as_span() != settings || entry.inputs.size() != inputs_.size() ||
+        entry.outputs.size() != outputs_.size())
+    {
+      return false;
     }
+    for (const int i : inputs_.index_range()) {
+      const CPPType &type = *inputs_[i].type;
+      if (entry.inputs[i].type() != &type ||
+          !GeoNodesNodeResultCache::values_are_equal(
+              type, entry.inputs[i].get(), params.try_get_input_data_ptr(i)))
+      {
+        return false;
+      }
+    }
+    for (const int i : outputs_.index_range()) {
+      if (entry.outputs[i].type() != outputs_[i].type) {
+        return false;
+      }
+    }
+    return true;
   }
 
   /**
@@ -0,0 +1,216 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_geometry_set.hh"
+#include "BKE_mesh_types.hh"
+#include "BKE_node_socket_value.hh"
+
+#include "NOD_geometry_nodes_node_result_cache.hh"
+
+namespace blender::nodes {
+
+GeoNodesNodeResultCache::Entry::~Entry()
+{
+  for (GMutablePointer &value : inputs) {
+    value.destruct();
+  }
+  for (GMutablePointer &value : outputs) {
+    value.destruct();
+  }
+}
+
+const GeoNodesNodeResultCache::Entry *GeoNodesNodeResultCache::lookup(const Key &key)
+{
+  std::lock_guard lock{mutex_};
+  std::unique_ptr<Entry> *entry = entries_.lookup_ptr(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  (*entry)->last_used_evaluation = evaluation_;
+  return entry->get();
+}
+
+void GeoNodesNodeResultCache::add(const Key &key, std::unique_ptr<Entry> entry)
+{
+  std::lock_guard lock{mutex_};
+  entry->last_used_evaluation = evaluation_;
+  entries_.add_overwrite(key, std::move(entry));
+}
+
+void GeoNodesNodeResultCache::evaluation_finished()
+{
+  std::lock_guard lock{mutex_};
+  entries_.remove_if([&](const auto item) {
+    return item.value->last_used_evaluation != evaluation_;
+  });
+  evaluation_++;
+}
+
+Vector<std::byte> GeoNodesNodeResultCache::node_settings_get(const bNode &node)
+{
+  Vector<std::byte> settings;
+  const auto append = [&](const void *data, const int64_t size) {
+    settings.extend(Span(static_cast<const std::byte *>(data), size));
+  };
+  append(&node.custom1, sizeof(node.custom1));
+  append(&node.custom2, sizeof(node.custom2));
+  append(&node.custom3, sizeof(node.custom3));
+  append(&node.custom4, sizeof(node.custom4));
+  if (node.storage != nullptr) {
+    /* Pointers in the storage are compared as well. That makes the comparison conservative,
+     * because they change when the node tree is copied. */
+    append(node.storage, int64_t(MEM_allocN_len(node.storage)));
+  }
+  return settings;
+}
+
+bool GeoNodesNodeResultCache::type_is_supported(const CPPType &type)
+{
+  /* Data-block pointers are comparable, but the data they point to can change without the pointer
+   * changing, e.g. when an object is moved. */
+  if (type.is_any<Object *, Collection *, Tex *, Image *, Material *>()) {
+    return false;
+  }
+  return type.is<bke::SocketValueVariant>() || type.is<bke::GeometrySet>() ||
+         type.is_equality_comparable();
+}
+
+static bool custom_data_is_same(const CustomData &a, const CustomData &b)
+{
+  if (a.totlayer != b.totlayer) {
+    return false;
+  }
+  for (const int i : IndexRange(a.totlayer)) {
+    const CustomDataLayer &layer_a = a.layers[i];
+    const CustomDataLayer &layer_b = b.layers[i];
+    if (layer_a.type != layer_b.type || layer_a.data != layer_b.data ||
+        !STREQ(layer_a.name, layer_b.name))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool vertex_group_names_are_same(const ListBase &a, const ListBase &b)
+{
+  const bDeformGroup *group_b = static_cast<const bDeformGroup *>(b.first);
+  LISTBASE_FOREACH (const bDeformGroup *, group_a, &a) {
+    if (group_b == nullptr || !STREQ(group_a->name, group_b->name)) {
+      return false;
+    }
+    group_b = group_b->next;
+  }
+  return group_b == nullptr;
+}
+
+static bool meshes_are_same(const Mesh &a, const Mesh &b)
+{
+  if (a.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA ||
+      b.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA)
+  {
+    return false;
+  }
+  return a.verts_num == b.verts_num && a.edges_num == b.edges_num && a.faces_num == b.faces_num &&
+         a.corners_num == b.corners_num && a.face_offset_indices == b.face_offset_indices &&
+         custom_data_is_same(a.vert_data, b.vert_data) &&
+         custom_data_is_same(a.edge_data, b.edge_data) &&
+         custom_data_is_same(a.face_data, b.face_data) &&
+         custom_data_is_same(a.corner_data, b.corner_data) &&
+         vertex_group_names_are_same(a.vertex_group_names, b.vertex_group_names) &&
+         Span(a.mat, a.totcol) == Span(b.mat, b.totcol) &&
+         STREQ(a.active_color_attribute ? a.active_color_attribute : "",
+               b.active_color_attribute ? b.active_color_attribute : "") &&
+         STREQ(a.default_color_attribute ? a.default_color_attribute : "",
+               b.default_color_attribute ? b.default_color_attribute : "");
+}
+
+static bool curves_are_same(const Curves &a, const Curves &b)
+{
+  const CurvesGeometry &geometry_a = a.geometry;
+  const CurvesGeometry &geometry_b = b.geometry;
+  return geometry_a.point_num == geometry_b.point_num &&
+         geometry_a.curve_num == geometry_b.curve_num &&
+         geometry_a.curve_offsets == geometry_b.curve_offsets &&
+         custom_data_is_same(geometry_a.point_data, geometry_b.point_data) &&
+         custom_data_is_same(geometry_a.curve_data, geometry_b.curve_data) &&
+         vertex_group_names_are_same(geometry_a.vertex_group_names,
+                                     geometry_b.vertex_group_names) &&
+         Span(a.mat, a.totcol) == Span(b.mat, b.totcol);
+}
+
+static bool pointclouds_are_same(const PointCloud &a, const PointCloud &b)
+{
+  return a.totpoint == b.totpoint && custom_data_is_same(a.pdata, b.pdata) &&
+         Span(a.mat, a.totcol) == Span(b.mat, b.totcol);
+}
+
+/**
+ * Geometries are usually passed on without copying the components, so comparing the pointers is
+ * enough for most of them. Meshes, curves and point clouds are also compared by their implicitly
+ * shared arrays, because the input of a modifier is a new data-block in every evaluation.
+ */
+static bool geometry_components_are_same(const bke::GeometryComponent *a,
+                                         const bke::GeometryComponent *b)
+{
+  if (a == b) {
+    return true;
+  }
+  if (a == nullptr || b == nullptr) {
+    return false;
+  }
+  switch (a->type()) {
+    case bke::GeometryComponent::Type::Mesh: {
+      const Mesh *mesh_a = static_cast<const bke::MeshComponent *>(a)->get();
+      const Mesh *mesh_b = static_cast<const bke::MeshComponent *>(b)->get();
+      return mesh_a && mesh_b && meshes_are_same(*mesh_a, *mesh_b);
+    }
+    case bke::GeometryComponent::Type::Curve: {
+      const Curves *curves_a = static_cast<const bke::CurveComponent *>(a)->get();
+      const Curves *curves_b = static_cast<const bke::CurveComponent *>(b)->get();
+      return curves_a && curves_b && curves_are_same(*curves_a, *curves_b);
+    }
+    case bke::GeometryComponent::Type::PointCloud: {
+      const PointCloud *pointcloud_a = static_cast<const bke::PointCloudComponent *>(a)->get();
+      const PointCloud *pointcloud_b = static_cast<const bke::PointCloudComponent *>(b)->get();
+      return pointcloud_a && pointcloud_b && pointclouds_are_same(*pointcloud_a, *pointcloud_b);
+    }
+    default:
+      return false;
+  }
+}
+
+bool GeoNodesNodeResultCache::values_are_equal(const CPPType &type, const void *a, const void *b)
+{
+  if (type.is<bke::GeometrySet>()) {
+    const bke::GeometrySet &geometry_a = *static_cast<const bke::GeometrySet *>(a);
+    const bke::GeometrySet &geometry_b = *static_cast<const bke::GeometrySet *>(b);
+    for (const int i : IndexRange(GEO_COMPONENT_TYPE_ENUM_SIZE)) {
+      const bke::GeometryComponent::Type component_type = bke::GeometryComponent::Type(i);
+      if (!geometry_components_are_same(geometry_a.get_component(component_type),
+                                        geometry_b.get_component(component_type)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (type.is<bke::SocketValueVariant>()) {
+    return static_cast<const bke::SocketValueVariant *>(a)->is_equal_to(
+        *static_cast<const bke::SocketValueVariant *>(b));
+  }
+  return type.is_equal_or_false(a, b);
+}
+
+}  // namespace blender::nodes
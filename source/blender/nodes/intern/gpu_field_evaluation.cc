@@ -0,0 +1,335 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <array>
+#include <mutex>
+
+#include <fmt/format.h>
+
+#include "BLI_array_utils.hh"
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_vector_set.hh"
+
+#include "DNA_userdef_types.h"
+
+#include "FN_field.hh"
+
+#include "GPU_capabilities.hh"
+#include "GPU_compute.hh"
+#include "GPU_context.hh"
+#include "GPU_platform.hh"
+#include "GPU_shader.hh"
+#include "GPU_state.hh"
+#include "GPU_storage_buffer.hh"
+
+#include "gpu_shader_create_info.hh"
+
+#include "NOD_gpu_field_evaluation.hh"
+
+namespace blender::nodes {
+
+using fn::FieldNodeType;
+using fn::FieldOperation;
+using fn::GFieldRef;
+
+GPUMultiFunction::GPUMultiFunction(const mf::MultiFunction &fn,
+                                   std::string glsl_function_name,
+                                   const bool clamp_result)
+    : fn_(fn), glsl_function_name_(std::move(glsl_function_name)), clamp_result_(clamp_result)
+{
+  this->set_signature(&fn.signature());
+#ifndef NDEBUG
+  const mf::Signature &signature = fn.signature();
+  BLI_assert(signature.params.size() <= 4);
+  for (const int param_index : signature.params.index_range()) {
+    const mf::ParamType param_type = signature.params[param_index].type;
+    const bool is_output = param_index == signature.params.size() - 1;
+    BLI_assert(param_type == (is_output ? mf::ParamType::ForSingleOutput(CPPType::get<float>()) :
+                                          mf::ParamType::ForSingleInput(CPPType::get<float>())));
+  }
+#endif
+}
+
+void GPUMultiFunction::call(const IndexMask &mask, mf::Params params, mf::Context context) const
+{
+  fn_.call(mask, params, context);
+  if (clamp_result_) {
+    /* This has actually been initialized in the call above. */
+    MutableSpan<float> results = params.uninitialized_single_output<float>(
+        this->param_amount() - 1);
+    mask.foreach_index_optimized<int>([&](const int i) {
+      float &value = results[i];
+      CLAMP(value, 0.0f, 1.0f);
+    });
+  }
+}
+
+mf::MultiFunction::ExecutionHints GPUMultiFunction::get_execution_hints() const
+{
+  return fn_.execution_hints();
+}
+
+/**
+ * Smaller fields are evaluated on the CPU, because uploading the inputs and reading back the
+ * result takes longer than computing them.
+ */
+static constexpr int64_t min_gpu_elements_num = 1 << 16;
+static constexpr int work_group_size = 64;
+
+static const GPUMultiFunction *get_gpu_multi_function(const GFieldRef &field)
+{
+  if (field.node().node_type() != FieldNodeType::Operation) {
+    return nullptr;
+  }
+  const FieldOperation &operation = static_cast<const FieldOperation &>(field.node());
+  return dynamic_cast<const GPUMultiFunction *>(&operation.multi_function());
+}
+
+/** Find the parts of the field that are not computed on the GPU, they are evaluated first. */
+static void gather_cpu_inputs(const GFieldRef &field,
+                              Set<GFieldRef> &visited,
+                              VectorSet<GFieldRef> &r_inputs)
+{
+  if (!visited.add(field)) {
+    return;
+  }
+  if (get_gpu_multi_function(field) == nullptr) {
+    r_inputs.add(field);
+    return;
+  }
+  for (const GFieldRef input : static_cast<const FieldOperation &>(field.node()).inputs()) {
+    gather_cpu_inputs(input, visited, r_inputs);
+  }
+}
+
+/**
+ * Generates the GLSL code that computes a field. The code only depends on the structure of the
+ * field and not on the values of its inputs, so that shaders can be reused when the values
+ * change. Inputs that have a single value are passed in the `constants` buffer, all other inputs
+ * get their own buffer.
+ */
+class GPUFieldCodeGenerator {
+ private:
+  Map<GFieldRef, std::string> variables_;
+
+ public:
+  std::string code;
+  /** Single values of the inputs, ordered like the `constants` buffer. */
+  Vector<float> constants;
+  /** Indices of the varying inputs in the CPU inputs, ordered like the input buffers. */
+  Vector<int> varying_inputs;
+
+  GPUFieldCodeGenerator(const VectorSet<GFieldRef> &cpu_inputs, Span<GVArray> cpu_input_values)
+  {
+    for (const int i : cpu_inputs.index_range()) {
+      const GVArray &varray = cpu_input_values[i];
+      std::string variable = fmt::format("v{}", variables_.size());
+      if (varray.is_single()) {
+        code += fmt::format("  float {} = constants[{}];\n", variable, constants.size());
+        constants.append(varray.typed<float>().get_internal_single());
+      }
+      else {
+        code += fmt::format("  float {} = input_{}[index];\n", variable, varying_inputs.size());
+        varying_inputs.append(i);
+      }
+      variables_.add_new(cpu_inputs[i], std::move(variable));
+    }
+  }
+
+  const std::string &variable_for_field(const GFieldRef &field)
+  {
+    if (const std::string *variable = variables_.lookup_ptr(field)) {
+      return *variable;
+    }
+    const GPUMultiFunction &fn = *get_gpu_multi_function(field);
+    const FieldOperation &operation = static_cast<const FieldOperation &>(field.node());
+    std::array<std::string, 3> args = {"0.0", "0.0", "0.0"};
+    for (const int i : operation.inputs().index_range()) {
+      args[i] = this->variable_for_field(operation.inputs()[i]);
+    }
+    std::string variable = fmt::format("v{}", variables_.size());
+    code += fmt::format("  float {};\n", variable);
+    code += fmt::format(
+        "  {}({}, {}, {}, {});\n", fn.glsl_function_name(), args[0], args[1], args[2], variable);
+    if (fn.clamp_result()) {
+      code += fmt::format("  {0} = clamp({0}, 0.0, 1.0);\n", variable);
+    }
+    return variables_.lookup_or_add(field, std::move(variable));
+  }
+};
+
+/** Shaders are compiled once for every generated code and are kept until Blender exits. */
+struct ShaderCache {
+  std::mutex mutex;
+  /** The value is null when the shader failed to compile. */
+  Map<std::string, GPUShader *> shaders;
+};
+
+static ShaderCache &get_shader_cache()
+{
+  static ShaderCache cache;
+  return cache;
+}
+
+static GPUShader *get_shader(const std::string &code,
+                             const int constants_num,
+                             const int varying_inputs_num)
+{
+  using namespace gpu::shader;
+  const std::string key = fmt::format("{} {}\n{}", constants_num, varying_inputs_num, code);
+
+  ShaderCache &cache = get_shader_cache();
+  std::lock_guard lock{cache.mutex};
+  return cache.shaders.lookup_or_add_cb(key, [&]() {
+    ShaderCreateInfo info("gpu_field_evaluation");
+    info.local_group_size(work_group_size);
+    info.push_constant(Type::INT, "elements_num");
+    /* The create info only references the resource names, so they have to outlive it. */
+    Array<std::string> input_names(varying_inputs_num);
+    int slot = 0;
+    if (constants_num > 0) {
+      info.storage_buf(slot++, Qualifier::READ, "float", "constants[]");
+    }
+    for (const int i : IndexRange(varying_inputs_num)) {
+      input_names[i] = fmt::format("input_{}[]", i);
+      info.storage_buf(slot++, Qualifier::READ, "float", input_names[i]);
+    }
+    info.storage_buf(slot, Qualifier::WRITE, "float", "result[]");
+    /* The main function of the source file calls the generated evaluate function. */
+    info.compute_source("gpu_shader_field_evaluation.glsl");
+    if (GPU_backend_get_type() != GPU_BACKEND_METAL) {
+      info.typedef_source_generated += "void evaluate(int index);\n";
+    }
+    info.compute_source_generated = "void evaluate(int index)\n{\n" + code + "}\n";
+    return GPU_shader_create_from_info(reinterpret_cast<const GPUShaderCreateInfo *>(&info));
+  });
+}
+
+class GPUFieldEvaluationBackend : public fn::FieldEvaluationBackend {
+ public:
+  bool supports(const GFieldRef &field, const IndexMask &mask) const override
+  {
+    if (!USER_EXPERIMENTAL_TEST(&U, use_gpu_fields)) {
+      return false;
+    }
+    if (mask.size() < min_gpu_elements_num) {
+      return false;
+    }
+    if (get_gpu_multi_function(field) == nullptr) {
+      return false;
+    }
+    return GPU_context_active_get() != nullptr;
+  }
+
+  bool evaluate(ResourceScope &scope,
+                const GFieldRef &field,
+                const IndexMask &mask,
+                const fn::FieldContext &context,
+                GMutableSpan dst) const override
+  {
+    const int64_t size = mask.size();
+    const size_t buffer_size = sizeof(float) * size_t(size);
+    if (buffer_size > GPU_max_storage_buffer_size()) {
+      return false;
+    }
+
+    Set<GFieldRef> visited;
+    VectorSet<GFieldRef> cpu_inputs;
+    gather_cpu_inputs(field, visited, cpu_inputs);
+    const Vector<GVArray> cpu_input_values = fn::evaluate_fields(
+        scope, cpu_inputs.as_span(), mask, context);
+
+    GPUFieldCodeGenerator generator{cpu_inputs, cpu_input_values};
+    const std::string &result_variable = generator.variable_for_field(field);
+    generator.code += fmt::format("  result[index] = {};\n", result_variable);
+
+    const int constants_num = generator.constants.size();
+    const int varying_inputs_num = generator.varying_inputs.size();
+    const int buffers_num = (constants_num > 0) + varying_inputs_num + 1;
+    if (buffers_num > GPU_max_compute_shader_storage_blocks()) {
+      return false;
+    }
+    GPUShader *shader = get_shader(generator.code, constants_num, varying_inputs_num);
+    if (shader == nullptr) {
+      return false;
+    }
+
+    Vector<GPUStorageBuf *> buffers;
+    if (constants_num > 0) {
+      buffers.append(GPU_storagebuf_create_ex(sizeof(float) * constants_num,
+                                              generator.constants.data(),
+                                              GPU_USAGE_STATIC,
+                                              __func__));
+    }
+    {
+      Array<float> input_data(size);
+      for (const int input_index : generator.varying_inputs) {
+        cpu_input_values[input_index].materialize_compressed(mask, input_data.data());
+        buffers.append(
+            GPU_storagebuf_create_ex(buffer_size, input_data.data(), GPU_USAGE_STATIC, __func__));
+      }
+    }
+    GPUStorageBuf *result_buffer = GPU_storagebuf_create_ex(
+        buffer_size, nullptr, GPU_USAGE_DEVICE_ONLY, __func__);
+    buffers.append(result_buffer);
+
+    GPU_shader_bind(shader);
+    GPU_shader_uniform_1i(shader, "elements_num", int(size));
+    for (const int slot : buffers.index_range()) {
+      GPU_storagebuf_bind(buffers[slot], slot);
+    }
+
+    /* Use a second dimension when there are more work groups than can be dispatched at once. */
+    const int64_t groups_num = (size + work_group_size - 1) / work_group_size;
+    const int64_t max_groups_x = GPU_max_work_group_count(0);
+    const int64_t groups_x = std::min(groups_num, max_groups_x);
+    const int64_t groups_y = (groups_num + groups_x - 1) / groups_x;
+    GPU_compute_dispatch(shader, uint(groups_x), uint(groups_y), 1);
+    GPU_memory_barrier(GPU_BARRIER_BUFFER_UPDATE);
+
+    MutableSpan<float> dst_values = dst.typed<float>();
+    if (const std::optional<IndexRange> range = mask.to_range()) {
+      GPU_storagebuf_read(result_buffer, dst_values.slice(*range).data());
+    }
+    else {
+      Array<float> result(size);
+      GPU_storagebuf_read(result_buffer, result.data());
+      array_utils::scatter(result.as_span(), mask, dst_values);
+    }
+
+    for (GPUStorageBuf *buffer : buffers) {
+      GPU_storagebuf_unbind(buffer);
+      GPU_storagebuf_free(buffer);
+    }
+    GPU_shader_unbind();
+    return true;
+  }
+};
+
+static GPUFieldEvaluationBackend &get_backend()
+{
+  static GPUFieldEvaluationBackend backend;
+  return backend;
+}
+
+void gpu_field_evaluation_register()
+{
+  fn::set_field_evaluation_backend(&get_backend());
+}
+
+void gpu_field_evaluation_free()
+{
+  fn::set_field_evaluation_backend(nullptr);
+  ShaderCache &cache = get_shader_cache();
+  std::lock_guard lock{cache.mutex};
+  for (GPUShader *shader : cache.shaders.values()) {
+    if (shader != nullptr) {
+      GPU_shader_free(shader);
+    }
+  }
+  cache.shaders.clear();
+}
+
+}  // namespace blender::nodes
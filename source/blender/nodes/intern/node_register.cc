@@ -5,6 +5,7 @@
 #include "BLI_string.h"
 
 #include "NOD_geometry.hh"
+#include "NOD_gpu_field_evaluation.hh"
 #include "NOD_register.hh"
 #include "NOD_socket.hh"
 
@@ -112,4 +113,6 @@ void register_nodes()
   register_texture_nodes();
   register_geometry_nodes();
   register_function_nodes();
+
+  blender::nodes::gpu_field_evaluation_register();
 }
@@ -339,7 +339,33 @@ class NoiseFunction : public mf::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        if (compute_factor && type_ == SHD_NOISE_FBM && scale.is_single() && detail.is_single() &&
+            roughness.is_single() && lacunarity.is_single() && distortion.is_single() &&
+            distortion.get_internal_single() == 0.0f)
+        {
+          /* Evaluate many positions at once when the parameters are the same for all of them. */
+          const float scale_value = scale.get_internal_single();
+          const float detail_value = math::clamp(detail.get_internal_single(), 0.0f, 15.0f);
+          const float roughness_value = math::max(roughness.get_internal_single(), 0.0f);
+          const float lacunarity_value = lacunarity.get_internal_single();
+          mask.foreach_segment([&](const IndexMaskSegment segment) {
+            Array<float3> positions(segment.size());
+            Array<float> factors(segment.size());
+            for (const int64_t i : segment.index_range()) {
+              positions[i] = vector[segment[i]] * scale_value;
+            }
+            noise::perlin_fbm(positions,
+                              detail_value,
+                              roughness_value,
+                              lacunarity_value,
+                              normalize_,
+                              factors);
+            for (const int64_t i : segment.index_range()) {
+              r_factor[segment[i]] = factors[i];
+            }
+          });
+        }
+        else if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
             const float3 position = vector[i] * scale[i];
             r_factor[i] = noise::perlin_fractal_distorted(position,
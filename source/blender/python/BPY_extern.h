@@ -70,6 +70,11 @@ void BPY_modules_update(void);
 void BPY_modules_load_user(struct bContext *C);
 
 void BPY_app_handlers_reset(bool do_all);
+/**
+ * Whether no Python handlers are registered for frame changes, so that frames can be evaluated
+ * without running them.
+ */
+bool BPY_app_handlers_frame_change_is_empty(void);
 
 /**
  * Run on exit to free any cached data.
@@ -20,6 +20,7 @@
 #include "gpu_py_compute.hh"
 #include "gpu_py_matrix.hh"
 #include "gpu_py_platform.hh"
+#include "gpu_py_profiling.hh"
 #include "gpu_py_select.hh"
 #include "gpu_py_state.hh"
 #include "gpu_py_types.hh"
@@ -67,6 +68,9 @@ PyObject *BPyInit_gpu()
   PyModule_AddObject(mod, "platform", (submodule = bpygpu_platform_init()));
   PyDict_SetItem(sys_modules, PyModule_GetNameObject(submodule), submodule);
 
+  PyModule_AddObject(mod, "profiling", (submodule = bpygpu_profiling_init()));
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(submodule), submodule);
+
   PyModule_AddObject(mod, "select", (submodule = bpygpu_select_init()));
   PyDict_SetItem(sys_modules, PyModule_GetNameObject(submodule), submodule);
 
@@ -0,0 +1,189 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bpygpu
+ *
+ * - Use `bpygpu_` for local API.
+ * - Use `BPyGPU` for public API.
+ */
+
+#include <Python.h>
+
+#include "BLI_utildefines.h"
+
+#include "DRW_profiling.hh"
+
+#include "../generic/py_capi_utils.h"
+#include "../generic/python_utildefines.h"
+
+#include "gpu_py.hh"
+#include "gpu_py_profiling.hh" /* Own include. */
+
+using namespace blender::draw;
+
+/* -------------------------------------------------------------------- */
+/** \name Functions
+ * \{ */
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profiling_enabled_set_doc,
+    ".. function:: enabled_set(enable)\n"
+    "\n"
+    "   Record the draw statistics of the viewports, even when they are not displayed.\n"
+    "\n"
+    "   :arg enable: True to record the statistics.\n"
+    "   :type enable: bool\n");
+static PyObject *pygpu_profiling_enabled_set(PyObject * /*self*/, PyObject *value)
+{
+  bool enable;
+  if (!PyC_ParseBool(value, &enable)) {
+    return nullptr;
+  }
+  DRW_profiling_enable(enable);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profiling_enabled_get_doc,
+    ".. function:: enabled_get()\n"
+    "\n"
+    "   Whether the draw statistics are recorded.\n"
+    "\n"
+    "   :rtype: bool\n");
+static PyObject *pygpu_profiling_enabled_get(PyObject * /*self*/)
+{
+  return PyBool_FromLong(DRW_profiling_is_enabled());
+}
+
+static void pygpu_dict_set_item_steal(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profiling_stats_get_doc,
+    ".. function:: stats_get()\n"
+    "\n"
+    "   Get the statistics of the last recorded viewport redraw. Times are in milliseconds and "
+    "averaged over the last redraws.\n"
+    "\n"
+    "   - ``engines``: List of ``(name, init_time, sync_time, render_time)`` CPU times of the "
+    "draw engines.\n"
+    "   - ``cache_time``: CPU time filling the caches of all engines.\n"
+    "   - ``batch_cache_times``: Dictionary of the CPU time creating the batches of each object "
+    "type.\n"
+    "   - ``gpu_timings``: List of ``(name, level, time)`` GPU times of the draw passes, empty "
+    "when the GPU backend does not support timestamp queries.\n"
+    "   - ``upload_size``: Vertex buffer data uploaded during the redraw, in bytes.\n"
+    "\n"
+    "   :return: The statistics, or None when nothing was recorded yet.\n"
+    "   :rtype: dict | None\n");
+static PyObject *pygpu_profiling_stats_get(PyObject * /*self*/)
+{
+  ProfilingStats stats;
+  if (!DRW_profiling_stats_get(stats)) {
+    Py_RETURN_NONE;
+  }
+
+  PyObject *py_engines = PyList_New(stats.engines.size());
+  for (const int i : stats.engines.index_range()) {
+    const ProfilingStats::Engine &engine = stats.engines[i];
+    PyObject *item = PyTuple_New(4);
+    PyTuple_SET_ITEMS(item,
+                      PyUnicode_FromString(engine.name.c_str()),
+                      PyFloat_FromDouble(engine.init_time),
+                      PyFloat_FromDouble(engine.sync_time),
+                      PyFloat_FromDouble(engine.render_time));
+    PyList_SET_ITEM(py_engines, i, item);
+  }
+
+  PyObject *py_batch_cache_times = PyDict_New();
+  for (const ProfilingStats::Timing &timing : stats.batch_cache_times) {
+    pygpu_dict_set_item_steal(
+        py_batch_cache_times, timing.name.c_str(), PyFloat_FromDouble(timing.time));
+  }
+
+  PyObject *py_gpu_timings = PyList_New(stats.gpu_timings.size());
+  for (const int i : stats.gpu_timings.index_range()) {
+    const ProfilingStats::GPUTiming &timing = stats.gpu_timings[i];
+    PyObject *item = PyTuple_New(3);
+    PyTuple_SET_ITEMS(item,
+                      PyUnicode_FromString(timing.name.c_str()),
+                      PyLong_FromLong(timing.level),
+                      PyFloat_FromDouble(timing.time));
+    PyList_SET_ITEM(py_gpu_timings, i, item);
+  }
+
+  PyObject *result = PyDict_New();
+  pygpu_dict_set_item_steal(result, "engines", py_engines);
+  pygpu_dict_set_item_steal(result, "cache_time", PyFloat_FromDouble(stats.cache_time));
+  pygpu_dict_set_item_steal(result, "batch_cache_times", py_batch_cache_times);
+  pygpu_dict_set_item_steal(result, "gpu_timings", py_gpu_timings);
+  pygpu_dict_set_item_steal(result, "upload_size", PyLong_FromSize_t(stats.upload_size));
+  return result;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Module
+ * \{ */
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+static PyMethodDef pygpu_profiling__tp_methods[] = {
+    {"enabled_set",
+     (PyCFunction)pygpu_profiling_enabled_set,
+     METH_O,
+     pygpu_profiling_enabled_set_doc},
+    {"enabled_get",
+     (PyCFunction)pygpu_profiling_enabled_get,
+     METH_NOARGS,
+     pygpu_profiling_enabled_get_doc},
+    {"stats_get",
+     (PyCFunction)pygpu_profiling_stats_get,
+     METH_NOARGS,
+     pygpu_profiling_stats_get_doc},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profiling__tp_doc,
+    "This module provides access to the statistics of the viewport draw manager, to find what "
+    "makes a scene slow to draw.");
+static PyModuleDef pygpu_profiling_module_def = {
+    /*m_base*/ PyModuleDef_HEAD_INIT,
+    /*m_name*/ "gpu.profiling",
+    /*m_doc*/ pygpu_profiling__tp_doc,
+    /*m_size*/ 0,
+    /*m_methods*/ pygpu_profiling__tp_methods,
+    /*m_slots*/ nullptr,
+    /*m_traverse*/ nullptr,
+    /*m_clear*/ nullptr,
+    /*m_free*/ nullptr,
+};
+
+PyObject *bpygpu_profiling_init()
+{
+  PyObject *submodule;
+
+  submodule = PyModule_Create(&pygpu_profiling_module_def);
+
+  return submodule;
+}
+
+/** \} */
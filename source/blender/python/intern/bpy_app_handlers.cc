@@ -340,6 +340,19 @@ void BPY_app_handlers_reset(const bool do_all)
   PyGILState_Release(gilstate);
 }
 
+bool BPY_app_handlers_frame_change_is_empty()
+{
+  if (py_cb_array[BKE_CB_EVT_FRAME_CHANGE_PRE] == nullptr) {
+    return true;
+  }
+
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  const bool is_empty = PyList_GET_SIZE(py_cb_array[BKE_CB_EVT_FRAME_CHANGE_PRE]) == 0 &&
+                        PyList_GET_SIZE(py_cb_array[BKE_CB_EVT_FRAME_CHANGE_POST]) == 0;
+  PyGILState_Release(gilstate);
+  return is_empty;
+}
+
 static PyObject *choose_arguments(PyObject *func, PyObject *args_all, PyObject *args_single)
 {
   if (!PyFunction_Check(func)) {
@@ -0,0 +1,158 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This file extends the dependency graph with C/Python API methods to read the statistics of its
+ * evaluations.
+ */
+
+#define PY_SSIZE_T_CLEAN
+
+#include <Python.h>
+
+#include "DEG_depsgraph_stats.hh"
+
+#include "RNA_types.hh"
+
+#include "../generic/py_capi_utils.h"
+#include "../generic/python_compat.h"
+
+#include "bpy_rna.h"
+#include "bpy_rna_depsgraph.h" /* Declare #BPY_rna_depsgraph_evaluation_stats_method_def. */
+
+/* -------------------------------------------------------------------- */
+/** \name Evaluation Statistics
+ * \{ */
+
+/** Add the value to the dictionary and release the reference to it. */
+static void bpy_rna_depsgraph_dict_set_steal(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+static PyObject *bpy_rna_depsgraph_evaluation_stats_operation_to_py(
+    const blender::deg::EvaluationStatsOperation &stats)
+{
+  PyObject *result = PyDict_New();
+  bpy_rna_depsgraph_dict_set_steal(result, "id", PyUnicode_FromString(stats.id_name.c_str()));
+  bpy_rna_depsgraph_dict_set_steal(
+      result, "component", PyUnicode_FromString(stats.component.c_str()));
+  bpy_rna_depsgraph_dict_set_steal(
+      result, "component_name", PyUnicode_FromString(stats.component_name.c_str()));
+  bpy_rna_depsgraph_dict_set_steal(
+      result, "operation", PyUnicode_FromString(stats.operation.c_str()));
+  bpy_rna_depsgraph_dict_set_steal(
+      result, "operation_name", PyUnicode_FromString(stats.operation_name.c_str()));
+  bpy_rna_depsgraph_dict_set_steal(result, "time", PyFloat_FromDouble(stats.time));
+  bpy_rna_depsgraph_dict_set_steal(
+      result, "memory_delta", PyLong_FromLongLong(stats.memory_delta));
+  bpy_rna_depsgraph_dict_set_steal(result, "thread", PyLong_FromLong(stats.thread));
+  return result;
+}
+
+static PyObject *bpy_rna_depsgraph_evaluation_stats_to_py(
+    const blender::deg::EvaluationStats &stats)
+{
+  PyObject *result = PyDict_New();
+  bpy_rna_depsgraph_dict_set_steal(result, "frame", PyFloat_FromDouble(stats.frame));
+  bpy_rna_depsgraph_dict_set_steal(
+      result, "update_count", PyLong_FromUnsignedLongLong(stats.update_count));
+  bpy_rna_depsgraph_dict_set_steal(result, "time", PyFloat_FromDouble(stats.time));
+
+  PyObject *ids = PyDict_New();
+  for (const blender::deg::EvaluationStatsID &id_stats : stats.ids) {
+    PyObject *py_id_stats = PyDict_New();
+    bpy_rna_depsgraph_dict_set_steal(py_id_stats, "time", PyFloat_FromDouble(id_stats.time));
+    bpy_rna_depsgraph_dict_set_steal(
+        py_id_stats, "memory_delta", PyLong_FromLongLong(id_stats.memory_delta));
+    bpy_rna_depsgraph_dict_set_steal(ids, id_stats.id_name.c_str(), py_id_stats);
+  }
+  bpy_rna_depsgraph_dict_set_steal(result, "ids", ids);
+
+  PyObject *operations = PyList_New(stats.operations.size());
+  for (const int64_t i : stats.operations.index_range()) {
+    PyList_SET_ITEM(
+        operations, i, bpy_rna_depsgraph_evaluation_stats_operation_to_py(stats.operations[i]));
+  }
+  bpy_rna_depsgraph_dict_set_steal(result, "operations", operations);
+  return result;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_depsgraph_evaluation_stats_doc,
+    ".. method:: evaluation_stats(*, history=False)\n"
+    "\n"
+    "   Timing and memory statistics of the last evaluations of the dependency graph, "
+    "gathered after calling ``evaluation_stats_enable``.\n"
+    "   The memory delta of an operation is the change of the allocated memory while it ran, "
+    "which includes allocations of operations running at the same time on other threads.\n"
+    "\n"
+    "   :arg history: Return the statistics of all evaluations in the history, "
+    "instead of only the last one.\n"
+    "   :type history: bool\n"
+    "   :return: A dictionary with the ``frame``, ``update_count`` and ``time`` of the "
+    "evaluation, the ``ids`` dictionary with the ``time`` and ``memory_delta`` per evaluated ID "
+    "name, and the ``operations`` list with the ``id``, ``component``, ``component_name``, "
+    "``operation``, ``operation_name``, ``time``, ``memory_delta`` and ``thread`` of every "
+    "evaluated operation. None when no evaluation was recorded. "
+    "With ``history``, a list of these dictionaries ordered from old to new.\n"
+    "   :rtype: dict | list[dict] | None\n");
+static PyObject *bpy_rna_depsgraph_evaluation_stats(PyObject *self,
+                                                    PyObject *args,
+                                                    PyObject *kwds)
+{
+  bool use_history = false;
+  static const char *_keywords[] = {"history", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `history` */
+      ":evaluation_stats",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &use_history)) {
+    return nullptr;
+  }
+
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  const Depsgraph *depsgraph = static_cast<const Depsgraph *>(pyrna->ptr.data);
+  const blender::Span<blender::deg::EvaluationStats> history = DEG_evaluation_stats_history(
+      depsgraph);
+
+  if (!use_history) {
+    if (history.is_empty()) {
+      Py_RETURN_NONE;
+    }
+    return bpy_rna_depsgraph_evaluation_stats_to_py(history.last());
+  }
+
+  PyObject *result = PyList_New(history.size());
+  for (const int64_t i : history.index_range()) {
+    PyList_SET_ITEM(result, i, bpy_rna_depsgraph_evaluation_stats_to_py(history[i]));
+  }
+  return result;
+}
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+PyMethodDef BPY_rna_depsgraph_evaluation_stats_method_def = {
+    "evaluation_stats",
+    (PyCFunction)bpy_rna_depsgraph_evaluation_stats,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_depsgraph_evaluation_stats_doc,
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+/** \} */
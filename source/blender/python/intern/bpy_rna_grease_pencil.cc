@@ -0,0 +1,289 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This file extends Grease Pencil layers with C/Python API methods that give zero-copy access to
+ * the Ondine render data of their drawings.
+ */
+
+#define PY_SSIZE_T_CLEAN
+
+#include <Python.h>
+
+#include "BKE_grease_pencil.hh"
+
+#include "DNA_grease_pencil_types.h"
+
+#include "RNA_types.hh"
+
+#include "../generic/python_compat.h"
+
+#include "bpy_rna.h"
+#include "bpy_rna_grease_pencil.h" /* Declare #BPY_rna_grease_pencil_ondine_points_2d_method_def. */
+
+/* -------------------------------------------------------------------- */
+/** \name Ondine Render Data Buffers
+ * \{ */
+
+/**
+ * PEP 3118 struct formats, so NumPy can map the buffers as structured arrays.
+ * These must match #GPStrokePoint, #GPStrokePointCompact and #OndineRenderStroke.
+ */
+static const char *ondine_points_2d_format =
+    "T{f:x:f:y:f:radius:f:alpha:f:dist_to_cam:f:color_r:f:color_g:f:color_b:}";
+static const char *ondine_points_2d_compact_format =
+    "T{f:dist_to_cam:H:x:H:y:H:radius:B:alpha:(3)B:color:2x:}";
+static const char *ondine_render_strokes_format =
+    "T{(3)f:render_fill_color:f:render_fill_opacity:f:render_stroke_opacity:"
+    "f:render_stroke_radius:f:render_thickness:f:render_dist_to_camera:i:render_flag:"
+    "(4)f:render_bbox:f:render_max_radius:(3)f:render_stroke_color:4x:}";
+
+static const blender::bke::greasepencil::Drawing *bpy_rna_grease_pencil_drawing_at(
+    PyObject *self, const int frame_number)
+{
+  using namespace blender::bke::greasepencil;
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  const GreasePencil &grease_pencil = *reinterpret_cast<const GreasePencil *>(
+      pyrna->ptr.owner_id);
+  const Layer &layer = static_cast<const GreasePencilLayer *>(pyrna->ptr.data)->wrap();
+
+  const Drawing *drawing = grease_pencil.get_drawing_at(layer, frame_number);
+  if (drawing == nullptr) {
+    PyErr_Format(PyExc_ValueError, "No drawing found at frame %d", frame_number);
+    return nullptr;
+  }
+  return drawing;
+}
+
+/**
+ * Create a read-only memory-view over existing memory, without taking ownership of it.
+ */
+static PyObject *bpy_rna_grease_pencil_memoryview(void *data,
+                                                  const Py_ssize_t len,
+                                                  const Py_ssize_t itemsize,
+                                                  const char *format)
+{
+  Py_ssize_t shape[1] = {len};
+  Py_buffer view = {nullptr};
+  view.buf = data;
+  view.obj = nullptr;
+  view.len = len * itemsize;
+  view.itemsize = itemsize;
+  view.readonly = 1;
+  view.ndim = 1;
+  view.format = const_cast<char *>(format);
+  view.shape = shape;
+  view.strides = &view.itemsize;
+  /* The shape and strides are copied by the memory-view. */
+  return PyMemoryView_FromBuffer(&view);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_grease_pencil_ondine_points_2d_doc,
+    ".. method:: ondine_points_2d(frame_number)\n"
+    "\n"
+    "   Read-only view of the Ondine 2D render points of the drawing at the given frame, "
+    "without copying the data.\n"
+    "   Use ``numpy.asarray`` to access it as a structured array.\n"
+    "   The view becomes invalid when the render data is recomputed or the drawing is freed.\n"
+    "\n"
+    "   :arg frame_number: Frame of the drawing.\n"
+    "   :type frame_number: int\n"
+    "   :return: One item per point with the fields ``x``, ``y``, ``radius``, ``alpha``, "
+    "``dist_to_cam``, ``color_r``, ``color_g`` and ``color_b``.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_grease_pencil_ondine_points_2d(PyObject *self,
+                                                        PyObject *args,
+                                                        PyObject *kwds)
+{
+  int frame_number;
+  static const char *_keywords[] = {"frame_number", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "i" /* `frame_number` */
+      ":ondine_points_2d",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &frame_number)) {
+    return nullptr;
+  }
+  const blender::bke::greasepencil::Drawing *drawing = bpy_rna_grease_pencil_drawing_at(
+      self, frame_number);
+  if (drawing == nullptr) {
+    return nullptr;
+  }
+  blender::Array<GPStrokePoint> &points_2d = drawing->runtime->points_2d;
+  return bpy_rna_grease_pencil_memoryview(
+      points_2d.data(), points_2d.size(), sizeof(GPStrokePoint), ondine_points_2d_format);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_grease_pencil_ondine_points_2d_compact_doc,
+    ".. method:: ondine_points_2d_compact(frame_number)\n"
+    "\n"
+    "   Read-only view of the compact Ondine 2D render points of the drawing at the given frame, "
+    "without copying the data. Only available when ``use_compact_render_points`` is enabled, "
+    "empty otherwise.\n"
+    "   Positions are relative to the bounding box of the stroke, in the range 0 to 65535. "
+    "Radius is in the range 0 to 65535, alpha and color in the range 0 to 255.\n"
+    "   The view becomes invalid when the render data is recomputed or the drawing is freed.\n"
+    "\n"
+    "   :arg frame_number: Frame of the drawing.\n"
+    "   :type frame_number: int\n"
+    "   :return: One item per point with the fields ``dist_to_cam``, ``x``, ``y``, ``radius``, "
+    "``alpha`` and ``color``.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_grease_pencil_ondine_points_2d_compact(PyObject *self,
+                                                                PyObject *args,
+                                                                PyObject *kwds)
+{
+  int frame_number;
+  static const char *_keywords[] = {"frame_number", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "i" /* `frame_number` */
+      ":ondine_points_2d_compact",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &frame_number)) {
+    return nullptr;
+  }
+  const blender::bke::greasepencil::Drawing *drawing = bpy_rna_grease_pencil_drawing_at(
+      self, frame_number);
+  if (drawing == nullptr) {
+    return nullptr;
+  }
+  blender::Array<GPStrokePointCompact> &points_2d_compact = drawing->runtime->points_2d_compact;
+  return bpy_rna_grease_pencil_memoryview(points_2d_compact.data(),
+                                          points_2d_compact.size(),
+                                          sizeof(GPStrokePointCompact),
+                                          ondine_points_2d_compact_format);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_grease_pencil_ondine_render_strokes_doc,
+    ".. method:: ondine_render_strokes(frame_number)\n"
+    "\n"
+    "   Read-only view of the Ondine render data of the strokes of the drawing at the given "
+    "frame, without copying the data.\n"
+    "   Use ``numpy.asarray`` to access it as a structured array.\n"
+    "   The view becomes invalid when the render data is recomputed or the drawing is freed.\n"
+    "\n"
+    "   :arg frame_number: Frame of the drawing.\n"
+    "   :type frame_number: int\n"
+    "   :return: One item per stroke, with the fields of the render stroke.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_grease_pencil_ondine_render_strokes(PyObject *self,
+                                                             PyObject *args,
+                                                             PyObject *kwds)
+{
+  int frame_number;
+  static const char *_keywords[] = {"frame_number", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "i" /* `frame_number` */
+      ":ondine_render_strokes",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &frame_number)) {
+    return nullptr;
+  }
+  const blender::bke::greasepencil::Drawing *drawing = bpy_rna_grease_pencil_drawing_at(
+      self, frame_number);
+  if (drawing == nullptr) {
+    return nullptr;
+  }
+  blender::Array<OndineRenderStroke> &render_strokes = drawing->runtime->render_strokes;
+  return bpy_rna_grease_pencil_memoryview(render_strokes.data(),
+                                          render_strokes.size(),
+                                          sizeof(OndineRenderStroke),
+                                          ondine_render_strokes_format);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_grease_pencil_ondine_render_stroke_order_doc,
+    ".. method:: ondine_render_stroke_order(frame_number)\n"
+    "\n"
+    "   Read-only view of the stroke indices of the drawing at the given frame, ordered back to "
+    "front by their distance to the camera, without copying the data.\n"
+    "   Only available for objects rendered with true depth, empty otherwise.\n"
+    "   The view becomes invalid when the render data is recomputed or the drawing is freed.\n"
+    "\n"
+    "   :arg frame_number: Frame of the drawing.\n"
+    "   :type frame_number: int\n"
+    "   :return: One stroke index per stroke.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_grease_pencil_ondine_render_stroke_order(PyObject *self,
+                                                                  PyObject *args,
+                                                                  PyObject *kwds)
+{
+  int frame_number;
+  static const char *_keywords[] = {"frame_number", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "i" /* `frame_number` */
+      ":ondine_render_stroke_order",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &frame_number)) {
+    return nullptr;
+  }
+  const blender::bke::greasepencil::Drawing *drawing = bpy_rna_grease_pencil_drawing_at(
+      self, frame_number);
+  if (drawing == nullptr) {
+    return nullptr;
+  }
+  blender::Array<int> &render_stroke_order = drawing->runtime->render_stroke_order;
+  return bpy_rna_grease_pencil_memoryview(
+      render_stroke_order.data(), render_stroke_order.size(), sizeof(int), "i");
+}
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+PyMethodDef BPY_rna_grease_pencil_ondine_points_2d_method_def = {
+    "ondine_points_2d",
+    (PyCFunction)bpy_rna_grease_pencil_ondine_points_2d,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_grease_pencil_ondine_points_2d_doc,
+};
+
+PyMethodDef BPY_rna_grease_pencil_ondine_points_2d_compact_method_def = {
+    "ondine_points_2d_compact",
+    (PyCFunction)bpy_rna_grease_pencil_ondine_points_2d_compact,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_grease_pencil_ondine_points_2d_compact_doc,
+};
+
+PyMethodDef BPY_rna_grease_pencil_ondine_render_strokes_method_def = {
+    "ondine_render_strokes",
+    (PyCFunction)bpy_rna_grease_pencil_ondine_render_strokes,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_grease_pencil_ondine_render_strokes_doc,
+};
+
+PyMethodDef BPY_rna_grease_pencil_ondine_render_stroke_order_method_def = {
+    "ondine_render_stroke_order",
+    (PyCFunction)bpy_rna_grease_pencil_ondine_render_stroke_order,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_grease_pencil_ondine_render_stroke_order_doc,
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+/** \} */
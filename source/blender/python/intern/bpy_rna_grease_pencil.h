@@ -0,0 +1,22 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern PyMethodDef BPY_rna_grease_pencil_ondine_points_2d_method_def;
+extern PyMethodDef BPY_rna_grease_pencil_ondine_points_2d_compact_method_def;
+extern PyMethodDef BPY_rna_grease_pencil_ondine_render_strokes_method_def;
+extern PyMethodDef BPY_rna_grease_pencil_ondine_render_stroke_order_method_def;
+
+#ifdef __cplusplus
+}
+#endif
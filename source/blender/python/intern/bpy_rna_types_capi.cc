@@ -26,6 +26,8 @@
 #include "bpy_rna_callback.h"
 #include "bpy_rna_context.h"
 #include "bpy_rna_data.h"
+#include "bpy_rna_depsgraph.h"
+#include "bpy_rna_grease_pencil.h"
 #include "bpy_rna_id_collection.h"
 #include "bpy_rna_text.h"
 #include "bpy_rna_types_capi.h"
@@ -78,6 +80,33 @@ static PyMethodDef pyrna_uilayout_methods[] = {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Depsgraph
+ * \{ */
+
+static PyMethodDef pyrna_depsgraph_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_depsgraph_evaluation_stats_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Grease Pencil Layer
+ * \{ */
+
+static PyMethodDef pyrna_grease_pencil_layer_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_grease_pencil_ondine_points_2d_method_def */
+    /* #BPY_rna_grease_pencil_ondine_points_2d_compact_method_def */
+    {nullptr, nullptr, 0, nullptr},
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_grease_pencil_ondine_render_strokes_method_def */
+    /* #BPY_rna_grease_pencil_ondine_render_stroke_order_method_def */
+    {nullptr, nullptr, 0, nullptr},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Operator
  * \{ */
@@ -306,6 +335,21 @@ void BPY_rna_types_extend_capi()
   BLI_assert(ARRAY_SIZE(pyrna_text_methods) == 3);
   pyrna_struct_type_extend_capi(&RNA_Text, pyrna_text_methods, nullptr);
 
+  /* Depsgraph */
+  ARRAY_SET_ITEMS(pyrna_depsgraph_methods, BPY_rna_depsgraph_evaluation_stats_method_def);
+  BLI_assert(ARRAY_SIZE(pyrna_depsgraph_methods) == 2);
+  pyrna_struct_type_extend_capi(&RNA_Depsgraph, pyrna_depsgraph_methods, nullptr);
+
+  /* GreasePencilLayer */
+  ARRAY_SET_ITEMS(pyrna_grease_pencil_layer_methods,
+                  BPY_rna_grease_pencil_ondine_points_2d_method_def,
+                  BPY_rna_grease_pencil_ondine_points_2d_compact_method_def,
+                  BPY_rna_grease_pencil_ondine_render_strokes_method_def,
+                  BPY_rna_grease_pencil_ondine_render_stroke_order_method_def);
+  BLI_assert(ARRAY_SIZE(pyrna_grease_pencil_layer_methods) == 5);
+  pyrna_struct_type_extend_capi(
+      &RNA_GreasePencilLayer, pyrna_grease_pencil_layer_methods, nullptr);
+
   /* wmOperator */
   ARRAY_SET_ITEMS(pyrna_operator_methods, BPY_rna_operator_poll_message_set_method_def);
   BLI_assert(ARRAY_SIZE(pyrna_operator_methods) == 2);
@@ -80,6 +80,10 @@ class TexturePool : public realtime_compositor::TexturePool {
     Vector<GPUTexture *> &available_textures = available_textures_.lookup_or_add_default(key);
     GPUTexture *texture = nullptr;
     if (available_textures.is_empty()) {
+      /* The previous evaluation used textures of different sizes or formats, for instance because
+       * the render resolution or the node tree changed. Free them before allocating, such that the
+       * textures of the previous and current evaluations don't need to fit in memory together. */
+      free_available_textures_except(key);
       texture = GPU_texture_create_2d("compositor_texture_pool",
                                       size.x,
                                       size.y,
@@ -96,6 +100,21 @@ class TexturePool : public realtime_compositor::TexturePool {
     return texture;
   }
 
+  /** Free the textures that are available to be acquired, except the ones matching the given
+   * key. */
+  void free_available_textures_except(const realtime_compositor::TexturePoolKey &key)
+  {
+    for (auto item : available_textures_.items()) {
+      if (item.key == key) {
+        continue;
+      }
+      for (GPUTexture *texture : item.value) {
+        GPU_texture_free(texture);
+      }
+      item.value.clear();
+    }
+  }
+
   /** Should be called after compositor evaluation to free unused textures and reset the texture
    * pool. */
   void free_unused_and_reset()
@@ -331,6 +350,13 @@ class Context : public realtime_compositor::Context {
     return input_data_.view_name;
   }
 
+  bool are_input_textures_persistent() const override
+  {
+    /* Render passes are never modified once rendered, and the context keeps a reference to their
+     * textures, so a texture can't be freed and reallocated for a different pass. */
+    return true;
+  }
+
   realtime_compositor::ResultPrecision get_precision() const override
   {
     switch (input_data_.scene->r.compositor_precision) {
@@ -475,8 +501,9 @@ class Context : public realtime_compositor::Context {
      * make editing faster, but we can't do that if all operations are submitted to the GPU all at
      * once, and we can't cancel work that was already submitted to the GPU. This does have a
      * performance penalty, but in practice, the improved interactivity is worth it according to
-     * user feedback. */
-    if (!this->render_context()) {
+     * user feedback. Similarly, when profiling, we wait until the operation finishes executing
+     * such that the measured evaluation time of nodes includes their GPU time. */
+    if (!this->render_context() || this->profiler()) {
       GPU_finish();
     }
   }
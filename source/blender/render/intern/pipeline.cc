@@ -15,6 +15,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <forward_list>
+#include <optional>
 
 #include "DNA_anim_types.h"
 #include "DNA_collection_types.h"
@@ -57,6 +58,7 @@
 #include "BKE_main.hh"
 #include "BKE_mask.h"
 #include "BKE_modifier.hh"
+#include "BKE_node.hh"
 #include "BKE_node_runtime.hh"
 #include "BKE_pointcache.h"
 #include "BKE_report.hh"
@@ -66,6 +68,7 @@
 
 #include "NOD_composite.hh"
 
+#include "COM_profiler.hh"
 #include "COM_render_context.hh"
 
 #include "DEG_depsgraph.hh"
@@ -1274,6 +1277,26 @@ static void render_compositor_stats(void *arg, const char *str)
   re->stats_draw(&i);
 }
 
+/* Print the evaluation time of every node in the given node tree that was evaluated by the
+ * compositor, see the --debug-compositor command line argument. */
+static void render_compositor_print_node_times(const bNodeTree &node_tree,
+                                               blender::realtime_compositor::Profiler &profiler)
+{
+  using namespace blender;
+  const Map<bNodeInstanceKey, timeit::Nanoseconds> &times = profiler.get_nodes_evaluation_times();
+  for (const bNode *node : node_tree.all_nodes()) {
+    const bNodeInstanceKey key = bke::BKE_node_instance_key(
+        bke::NODE_INSTANCE_KEY_BASE, &node_tree, node);
+    const timeit::Nanoseconds *time = times.lookup_ptr(key);
+    if (!time) {
+      continue;
+    }
+    const double milliseconds = std::chrono::duration<double, std::milli>(*time).count();
+    printf("Compositor: node \"%s\" evaluated in %.3f ms\n", node->name, milliseconds);
+  }
+  fflush(stdout);
+}
+
 /* Render compositor nodes, along with any scenes required for them.
  * The result will be output into a compositing render layer in the render result. */
 static void do_render_compositor(Render *re)
@@ -1343,6 +1366,11 @@ static void do_render_compositor(Render *re)
           /* If we have consistent depsgraph now would be a time to update them. */
         }
 
+        std::optional<blender::realtime_compositor::Profiler> profiler;
+        if (G.debug & G_DEBUG_COMPOSITOR) {
+          profiler.emplace();
+        }
+
         blender::realtime_compositor::RenderContext compositor_render_context;
         LISTBASE_FOREACH (RenderView *, rv, &re->result->views) {
           ntreeCompositExecTree(re,
@@ -1351,10 +1379,14 @@ static void do_render_compositor(Render *re)
                                 &re->r,
                                 rv->name,
                                 &compositor_render_context,
-                                nullptr);
+                                profiler ? &*profiler : nullptr);
         }
         compositor_render_context.save_file_outputs(re->pipeline_scene_eval);
 
+        if (profiler) {
+          render_compositor_print_node_times(*ntree, *profiler);
+        }
+
         ntree->runtime->stats_draw = nullptr;
         ntree->runtime->test_break = nullptr;
         ntree->runtime->progress = nullptr;
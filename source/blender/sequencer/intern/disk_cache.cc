@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <ctime>
 #include <memory.h>
+#include <string>
 
 #include "MEM_guardedalloc.h"
 
@@ -25,7 +26,9 @@
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_path_util.h"
+#include "BLI_string.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.hh"
@@ -51,6 +54,8 @@
  * size specified in user preferences.
  * To distinguish 2 blend files with same name, scene->ed->disk_cache_timestamp
  * is used as UID. Blend file can still be copied manually which may cause conflict.
+ * Files found by scanning the cache directory are indexed by their path, so looking up the file
+ * of an image doesn't need to go over all files.
  */
 
 /* Format string:
@@ -73,12 +78,17 @@ struct DiskCacheHeader {
   DiskCacheHeaderEntry entry[DCACHE_IMAGES_PER_FILE];
 };
 
+struct DiskCacheFile;
+
 struct SeqDiskCache {
-  Main *bmain;
-  int64_t timestamp;
-  ListBase files;
+  Main *bmain = nullptr;
+  int64_t timestamp = 0;
+  ListBase files = {nullptr, nullptr};
+  /* The files in the files list keyed by their lower case path, since paths are compared case
+   * insensitively. */
+  blender::Map<std::string, DiskCacheFile *> files_by_path;
   ThreadMutex read_write_mutex;
-  size_t size_total;
+  size_t size_total = 0;
 };
 
 struct DiskCacheFile {
@@ -128,6 +138,13 @@ bool seq_disk_cache_is_enabled(Main *bmain)
           bmain->filepath[0] != '\0');
 }
 
+static std::string seq_disk_cache_file_path_key(const char *filepath)
+{
+  std::string key = filepath;
+  BLI_str_tolower_ascii(key.data(), key.size());
+  return key;
+}
+
 static DiskCacheFile *seq_disk_cache_add_file_to_list(SeqDiskCache *disk_cache,
                                                       const char *filepath)
 {
@@ -149,9 +166,16 @@ static DiskCacheFile *seq_disk_cache_add_file_to_list(SeqDiskCache *disk_cache,
          &cache_file->start_frame);
   cache_file->start_frame *= DCACHE_IMAGES_PER_FILE;
   BLI_addtail(&disk_cache->files, cache_file);
+  disk_cache->files_by_path.add_overwrite(seq_disk_cache_file_path_key(filepath), cache_file);
   return cache_file;
 }
 
+static void seq_disk_cache_clear_files(SeqDiskCache *disk_cache)
+{
+  disk_cache->files_by_path.clear();
+  BLI_freelistN(&disk_cache->files);
+}
+
 static void seq_disk_cache_get_files(SeqDiskCache *disk_cache, const char *dirpath)
 {
   direntry *filelist, *fl;
@@ -212,6 +236,7 @@ static void seq_disk_cache_delete_file(SeqDiskCache *disk_cache, DiskCacheFile *
 {
   disk_cache->size_total -= file->fstat.st_size;
   BLI_delete(file->filepath, false, false);
+  disk_cache->files_by_path.remove(seq_disk_cache_file_path_key(file->filepath));
   BLI_remlink(&disk_cache->files, file);
   MEM_freeN(file);
 }
@@ -230,7 +255,7 @@ bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
 
     if (BLI_exists(oldest_file->filepath) == 0) {
       /* File may have been manually deleted during runtime, do re-scan. */
-      BLI_freelistN(&disk_cache->files);
+      seq_disk_cache_clear_files(disk_cache);
       seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
       continue;
     }
@@ -245,15 +270,7 @@ bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
 static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache,
                                                             const char *filepath)
 {
-  DiskCacheFile *cache_file = static_cast<DiskCacheFile *>(disk_cache->files.first);
-
-  for (; cache_file; cache_file = cache_file->next) {
-    if (BLI_strcasecmp(cache_file->filepath, filepath) == 0) {
-      return cache_file;
-    }
-  }
-
-  return nullptr;
+  return disk_cache->files_by_path.lookup_default(seq_disk_cache_file_path_key(filepath), nullptr);
 }
 
 /* Update file size and timestamp. */
@@ -664,8 +681,7 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 
 SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 {
-  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(
-      MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache"));
+  SeqDiskCache *disk_cache = MEM_new<SeqDiskCache>("SeqDiskCache");
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
   seq_disk_cache_handle_versioning(disk_cache);
@@ -677,7 +693,7 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
-  BLI_freelistN(&disk_cache->files);
+  seq_disk_cache_clear_files(disk_cache);
   BLI_mutex_end(&disk_cache->read_write_mutex);
-  MEM_freeN(disk_cache);
+  MEM_delete(disk_cache);
 }
@@ -6,6 +6,7 @@
  * \ingroup bke
  */
 
+#include <algorithm>
 #include <cstddef>
 #include <ctime>
 #include <memory.h>
@@ -18,11 +19,13 @@
 
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
+#include "IMB_moviecache.hh"
 
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "BKE_main.hh"
 
@@ -59,6 +62,10 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Locking: The cache is protected by a read-write lock. Lookups only take a read lock, such that
+ * the UI and prefetch threads can query the cache concurrently, while any modification of the
+ * cache takes a write lock.
  */
 
 #define THUMB_CACHE_LIMIT 5000
@@ -66,7 +73,7 @@
 struct SeqCache {
   Main *bmain;
   GHash *hash;
-  ThreadMutex iterator_mutex;
+  ThreadRWMutex iterator_mutex;
   BLI_mempool *keys_pool;
   BLI_mempool *items_pool;
   SeqCacheKey *last_key;
@@ -77,6 +84,8 @@ struct SeqCache {
 struct SeqCacheItem {
   SeqCache *cache_owner;
   ImBuf *ibuf;
+  /* Size of the image buffer when it was stored, as accounted in the shared cache budget. */
+  size_t size;
 };
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -160,7 +169,17 @@ static void seq_cache_lock(Scene *scene)
   SeqCache *cache = seq_cache_get_from_scene(scene);
 
   if (cache) {
-    BLI_mutex_lock(&cache->iterator_mutex);
+    BLI_rw_mutex_lock(&cache->iterator_mutex, THREAD_LOCK_WRITE);
+  }
+}
+
+/* Lock the cache for reading only, multiple readers can hold the lock at the same time. */
+static void seq_cache_lock_read(Scene *scene)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+
+  if (cache) {
+    BLI_rw_mutex_lock(&cache->iterator_mutex, THREAD_LOCK_READ);
   }
 }
 
@@ -169,7 +188,7 @@ static void seq_cache_unlock(Scene *scene)
   SeqCache *cache = seq_cache_get_from_scene(scene);
 
   if (cache) {
-    BLI_mutex_unlock(&cache->iterator_mutex);
+    BLI_rw_mutex_unlock(&cache->iterator_mutex);
   }
 }
 
@@ -189,6 +208,7 @@ static void seq_cache_valfree(void *val)
   SeqCacheItem *item = (SeqCacheItem *)val;
 
   if (item->ibuf) {
+    IMB_moviecache_external_memory_remove(item->size);
     IMB_freeImBuf(item->ibuf);
   }
 
@@ -218,6 +238,8 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = static_cast<SeqCacheItem *>(BLI_mempool_alloc(cache->items_pool));
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->size = ibuf ? IMB_get_size_in_memory(ibuf) : 0;
+  IMB_moviecache_external_memory_add(item->size);
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -386,22 +408,19 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
   }
 }
 
-static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
+/* Collect the keys that can be recycled, which are the last keys of the chains of permanent keys,
+ * sorted by their timeline frame. The keys are collected and sorted once per recycling, such that
+ * the leftmost and rightmost keys can be found in constant time for every recycled frame. */
+static blender::Vector<SeqCacheKey *> seq_cache_get_items_for_removal(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
-  SeqCacheKey *finalkey = nullptr;
-  /* Leftmost key. */
-  SeqCacheKey *lkey = nullptr;
-  /* Rightmost key. */
-  SeqCacheKey *rkey = nullptr;
-  SeqCacheKey *key = nullptr;
+  blender::Vector<SeqCacheKey *> keys;
 
   GHashIterator gh_iter;
   BLI_ghashIterator_init(&gh_iter, cache->hash);
-  int total_count = 0;
 
   while (!BLI_ghashIterator_done(&gh_iter)) {
-    key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
+    SeqCacheKey *key = static_cast<SeqCacheKey *>(BLI_ghashIterator_getKey(&gh_iter));
     SeqCacheItem *item = static_cast<SeqCacheItem *>(BLI_ghashIterator_getValue(&gh_iter));
     BLI_ghashIterator_step(&gh_iter);
     BLI_assert(key->cache_owner == cache);
@@ -411,6 +430,7 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       seq_cache_recycle_linked(scene, key);
       /* Can not continue iterating after linked remove. */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
+      keys.clear();
       continue;
     }
 
@@ -418,30 +438,14 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
-    total_count++;
-
-    if (lkey) {
-      if (key->timeline_frame < lkey->timeline_frame) {
-        lkey = key;
-      }
-    }
-    else {
-      lkey = key;
-    }
-    if (rkey) {
-      if (key->timeline_frame > rkey->timeline_frame) {
-        rkey = key;
-      }
-    }
-    else {
-      rkey = key;
-    }
+    keys.append(key);
   }
-  (void)total_count; /* Quiet set-but-unused warning (may be removed). */
 
-  finalkey = seq_cache_choose_key(scene, lkey, rkey);
+  std::sort(keys.begin(), keys.end(), [](const SeqCacheKey *a, const SeqCacheKey *b) {
+    return a->timeline_frame < b->timeline_frame;
+  });
 
-  return finalkey;
+  return keys;
 }
 
 bool seq_cache_recycle_item(Scene *scene)
@@ -453,16 +457,36 @@ bool seq_cache_recycle_item(Scene *scene)
 
   seq_cache_lock(scene);
 
+  if (!seq_cache_is_full()) {
+    seq_cache_unlock(scene);
+    return true;
+  }
+
+  /* Recycling a key only removes its own chain, so the remaining candidate keys stay valid and
+   * only the range between the first and last candidate is left after each recycling. */
+  const blender::Vector<SeqCacheKey *> keys = seq_cache_get_items_for_removal(scene);
+  int64_t first = 0;
+  int64_t last = keys.size() - 1;
+
   while (seq_cache_is_full()) {
-    SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
+    /* Leftmost key. */
+    SeqCacheKey *lkey = first <= last ? keys[first] : nullptr;
+    /* Rightmost key. */
+    SeqCacheKey *rkey = first <= last ? keys[last] : nullptr;
 
-    if (finalkey) {
-      seq_cache_recycle_linked(scene, finalkey);
-    }
-    else {
+    SeqCacheKey *finalkey = seq_cache_choose_key(scene, lkey, rkey);
+    if (!finalkey) {
       seq_cache_unlock(scene);
       return false;
     }
+
+    if (finalkey == lkey) {
+      first++;
+    }
+    else {
+      last--;
+    }
+    seq_cache_recycle_linked(scene, finalkey);
   }
   seq_cache_unlock(scene);
   return true;
@@ -503,7 +527,7 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->last_key = nullptr;
     cache->bmain = bmain;
     cache->thumbnail_count = 0;
-    BLI_mutex_init(&cache->iterator_mutex);
+    BLI_rw_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
 
     if (scene->ed->disk_cache_timestamp == 0) {
@@ -590,7 +614,7 @@ void seq_cache_destruct(Scene *scene)
   BLI_ghash_free(cache->hash, seq_cache_keyfree, seq_cache_valfree);
   BLI_mempool_destroy(cache->keys_pool);
   BLI_mempool_destroy(cache->items_pool);
-  BLI_mutex_end(&cache->iterator_mutex);
+  BLI_rw_mutex_end(&cache->iterator_mutex);
 
   if (cache->disk_cache != nullptr) {
     seq_disk_cache_free(cache->disk_cache);
@@ -756,7 +780,7 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
     seq_cache_create(context->bmain, scene);
   }
 
-  seq_cache_lock(scene);
+  seq_cache_lock_read(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   ImBuf *ibuf = nullptr;
   SeqCacheKey key;
@@ -889,7 +913,7 @@ void seq_cache_put(
   if (!key->is_temp_cache) {
     if (seq_disk_cache_is_enabled(context->bmain)) {
       if (cache->disk_cache == nullptr) {
-        seq_disk_cache_create(context->bmain, context->scene);
+        cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
       }
 
       seq_disk_cache_write_file(cache->disk_cache, key, i);
@@ -945,5 +969,7 @@ void SEQ_cache_iterate(
 
 bool seq_cache_is_full()
 {
-  return seq_cache_get_mem_total() < MEM_get_memory_in_use();
+  /* The budget is shared with the movie caches of clips and images, only count cached images
+   * instead of all memory used by Blender. */
+  return seq_cache_get_mem_total() < IMB_moviecache_get_memory_in_use();
 }
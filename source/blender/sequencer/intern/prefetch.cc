@@ -57,6 +57,9 @@ struct PrefetchJob {
 
   ThreadMutex prefetch_suspend_mutex;
   ThreadCondition prefetch_suspend_cond;
+  /** Protects `running`, signaled by the job when it finishes, see #SEQ_prefetch_stop. */
+  ThreadMutex prefetch_running_mutex;
+  ThreadCondition prefetch_finished_cond;
 
   ListBase threads;
 
@@ -70,7 +73,7 @@ struct PrefetchJob {
   float cfra;
   int num_frames_prefetched;
 
-  /* control */
+  /* control, `stop` is protected by `prefetch_suspend_mutex`. */
   bool running;
   bool waiting;
   bool stop;
@@ -117,7 +120,18 @@ bool seq_prefetch_job_is_running(Scene *scene)
     return false;
   }
 
-  return pfjob->running;
+  BLI_mutex_lock(&pfjob->prefetch_running_mutex);
+  const bool running = pfjob->running;
+  BLI_mutex_unlock(&pfjob->prefetch_running_mutex);
+  return running;
+}
+
+static bool seq_prefetch_job_is_stopped(PrefetchJob *pfjob)
+{
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  const bool stop = pfjob->stop;
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+  return stop;
 }
 
 static bool seq_prefetch_job_is_waiting(Scene *scene)
@@ -264,11 +278,18 @@ void SEQ_prefetch_stop(Scene *scene)
     return;
   }
 
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
   pfjob->stop = true;
+  /* Wake the job up in case it is suspended. Otherwise it stops after rendering its current
+   * frame, which can take a while for heavy timelines. */
+  BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 
+  BLI_mutex_lock(&pfjob->prefetch_running_mutex);
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_wait(&pfjob->prefetch_finished_cond, &pfjob->prefetch_running_mutex);
   }
+  BLI_mutex_unlock(&pfjob->prefetch_running_mutex);
 }
 
 static void seq_prefetch_update_context(const SeqRenderData *context)
@@ -353,6 +374,8 @@ void seq_prefetch_free(Scene *scene)
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
+  BLI_mutex_end(&pfjob->prefetch_running_mutex);
+  BLI_condition_end(&pfjob->prefetch_finished_cond);
   seq_prefetch_free_depsgraph(pfjob);
   BKE_main_free(pfjob->bmain_eval);
   MEM_freeN(pfjob);
@@ -494,7 +517,9 @@ static void *seq_prefetch_frames(void *job)
     if (seq_prefetch_must_skip_frame(pfjob, channels, seqbase)) {
       pfjob->num_frames_prefetched++;
       /* Break instead of keep looping if the job should be terminated. */
-      if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
+      if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) ||
+          seq_prefetch_job_is_stopped(pfjob))
+      {
         break;
       }
       continue;
@@ -513,7 +538,9 @@ static void *seq_prefetch_frames(void *job)
       break;
     }
 
-    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
+    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) ||
+        seq_prefetch_job_is_stopped(pfjob))
+    {
       break;
     }
 
@@ -522,9 +549,14 @@ static void *seq_prefetch_frames(void *job)
   }
 
   seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-  pfjob->running = false;
   pfjob->scene_eval->ed->prefetch_job = nullptr;
 
+  /* The job data can be changed by the main thread as soon as it knows the job finished. */
+  BLI_mutex_lock(&pfjob->prefetch_running_mutex);
+  pfjob->running = false;
+  BLI_condition_notify_all(&pfjob->prefetch_finished_cond);
+  BLI_mutex_unlock(&pfjob->prefetch_running_mutex);
+
   return nullptr;
 }
 
@@ -540,6 +572,8 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
       BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
       BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
       BLI_condition_init(&pfjob->prefetch_suspend_cond);
+      BLI_mutex_init(&pfjob->prefetch_running_mutex);
+      BLI_condition_init(&pfjob->prefetch_finished_cond);
 
       pfjob->bmain_eval = BKE_main_new();
       pfjob->scene = context->scene;
@@ -552,8 +586,12 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
   pfjob->num_frames_prefetched = 1;
 
   pfjob->waiting = false;
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
   pfjob->stop = false;
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+  BLI_mutex_lock(&pfjob->prefetch_running_mutex);
   pfjob->running = true;
+  BLI_mutex_unlock(&pfjob->prefetch_running_mutex);
 
   seq_prefetch_update_scene(context->scene);
   seq_prefetch_update_context(context);
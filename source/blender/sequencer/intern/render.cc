@@ -25,6 +25,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.hh"
 
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -635,40 +636,38 @@ static void sequencer_preprocess_transform_crop(
 
 static void multibuf(ImBuf *ibuf, const float fmul, const bool multiply_alpha)
 {
-  uchar *rt;
-  float *rt_float;
-
-  int a;
-
-  rt = ibuf->byte_buffer.data;
-  rt_float = ibuf->float_buffer.data;
+  uchar *rt = ibuf->byte_buffer.data;
+  float *rt_float = ibuf->float_buffer.data;
+  const int64_t pixel_count = int64_t(ibuf->x) * ibuf->y;
 
   if (rt) {
     const int imul = int(256.0f * fmul);
-    a = ibuf->x * ibuf->y;
-    while (a--) {
-      rt[0] = min_ii((imul * rt[0]) >> 8, 255);
-      rt[1] = min_ii((imul * rt[1]) >> 8, 255);
-      rt[2] = min_ii((imul * rt[2]) >> 8, 255);
-      if (multiply_alpha) {
-        rt[3] = min_ii((imul * rt[3]) >> 8, 255);
+    threading::parallel_for(IndexRange(pixel_count), 64 * 1024, [&](const IndexRange range) {
+      uchar *ptr = rt + range.first() * 4;
+      for ([[maybe_unused]] const int64_t i : range) {
+        ptr[0] = min_ii((imul * ptr[0]) >> 8, 255);
+        ptr[1] = min_ii((imul * ptr[1]) >> 8, 255);
+        ptr[2] = min_ii((imul * ptr[2]) >> 8, 255);
+        if (multiply_alpha) {
+          ptr[3] = min_ii((imul * ptr[3]) >> 8, 255);
+        }
+        ptr += 4;
       }
-
-      rt += 4;
-    }
+    });
   }
   if (rt_float) {
-    a = ibuf->x * ibuf->y;
-    while (a--) {
-      rt_float[0] *= fmul;
-      rt_float[1] *= fmul;
-      rt_float[2] *= fmul;
-      if (multiply_alpha) {
-        rt_float[3] *= fmul;
+    threading::parallel_for(IndexRange(pixel_count), 64 * 1024, [&](const IndexRange range) {
+      float *ptr = rt_float + range.first() * 4;
+      for ([[maybe_unused]] const int64_t i : range) {
+        ptr[0] *= fmul;
+        ptr[1] *= fmul;
+        ptr[2] *= fmul;
+        if (multiply_alpha) {
+          ptr[3] *= fmul;
+        }
+        ptr += 4;
       }
-
-      rt_float += 4;
-    }
+    });
   }
 }
 
@@ -1202,6 +1201,23 @@ static ImBuf *seq_render_movie_strip_view(const SeqRenderData *context,
     }
   }
 
+  /* No proxy was built for the requested size, generate the proxy image on the fly by converting
+   * the original frame directly to the preview size. This avoids processing full resolution
+   * images during playback, which is what proxies are used for. */
+  if (ibuf == nullptr && context->use_proxies && psize != IMB_PROXY_NONE &&
+      psize != IMB_PROXY_100)
+  {
+    ibuf = IMB_anim_absolute_scaled(sanim->anim,
+                                    frame_index + seq->anim_startofs,
+                                    seq_render_movie_strip_timecode_get(seq),
+                                    SEQ_rendersize_to_scale_factor(context->preview_render_size));
+    if (ibuf != nullptr) {
+      *r_is_proxy_image = true;
+      seq->strip->stripdata->orig_width = IMB_anim_get_image_width(sanim->anim);
+      seq->strip->stripdata->orig_height = IMB_anim_get_image_height(sanim->anim);
+    }
+  }
+
   /* Fetching for requested proxy size failed, try fetching the original instead. */
   if (ibuf == nullptr) {
     ibuf = IMB_anim_absolute(sanim->anim,
@@ -16,6 +16,7 @@
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_vector_set.hh"
@@ -207,17 +208,21 @@ static void open_anim_filepath(Sequence *seq,
                                const char *filepath,
                                bool openfile)
 {
+  int flags = IB_rect;
+  if (seq->flag & SEQ_FILTERY) {
+    flags |= IB_animdeinterlace;
+  }
+  if (U.sequencer_editor_flag & USER_SEQ_ED_HARDWARE_DECODING) {
+    flags |= IB_animhwaccel;
+  }
+
   if (openfile) {
-    sanim->anim = openanim(filepath,
-                           IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
-                           seq->streamindex,
-                           seq->strip->colorspace_settings.name);
+    sanim->anim = openanim(
+        filepath, flags, seq->streamindex, seq->strip->colorspace_settings.name);
   }
   else {
-    sanim->anim = openanim_noload(filepath,
-                                  IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
-                                  seq->streamindex,
-                                  seq->strip->colorspace_settings.name);
+    sanim->anim = openanim_noload(
+        filepath, flags, seq->streamindex, seq->strip->colorspace_settings.name);
   }
 }
 
@@ -21,8 +21,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "CLG_log.h"
+
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -64,6 +67,8 @@
 #  include "BKE_subsurf.hh"
 #endif
 
+static CLG_LogRef LOG = {"wm.draw"};
+
 /* -------------------------------------------------------------------- */
 /** \name Internal Utilities
  * \{ */
@@ -927,6 +932,8 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
   Main *bmain = CTX_data_main(C);
   wmWindowManager *wm = CTX_wm_manager(C);
   bScreen *screen = WM_window_get_active_screen(win);
+  /* Only query the time when the draw times are actually logged. */
+  const bool use_timing = CLOG_CHECK(&LOG, 2);
 
   /* Draw screen areas into their own frame buffer. */
   ED_screen_areas_iter (win, screen, area) {
@@ -972,6 +979,7 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
 
       CTX_wm_region_set(C, region);
       bool use_viewport = WM_region_use_viewport(area, region);
+      const double draw_time_start = use_timing ? BLI_time_now_seconds() : 0.0;
 
       GPU_debug_group_begin(use_viewport ? "Viewport" : "ARegion");
 
@@ -1009,6 +1017,15 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
 
       GPU_debug_group_end();
 
+      if (use_timing) {
+        CLOG_INFO(&LOG,
+                  2,
+                  "region %d of %s drawn in %.3f ms",
+                  region->regiontype,
+                  wm_area_name(area),
+                  (BLI_time_now_seconds() - draw_time_start) * 1000.0);
+      }
+
       region->do_draw = 0;
       CTX_wm_region_set(C, nullptr);
     }
@@ -1160,6 +1177,9 @@ static void wm_draw_window_onscreen(bContext *C, wmWindow *win, int view)
 
 static void wm_draw_window(bContext *C, wmWindow *win)
 {
+  const bool use_timing = CLOG_CHECK(&LOG, 1);
+  const double draw_time_start = use_timing ? BLI_time_now_seconds() : 0.0;
+
   GPU_context_begin_frame(static_cast<GPUContext *>(win->gpuctx));
 
   bScreen *screen = WM_window_get_active_screen(win);
@@ -1237,6 +1257,14 @@ static void wm_draw_window(bContext *C, wmWindow *win)
   screen->do_draw = false;
 
   GPU_context_end_frame(static_cast<GPUContext *>(win->gpuctx));
+
+  if (use_timing) {
+    CLOG_INFO(&LOG,
+              1,
+              "window %d drawn in %.3f ms",
+              win->winid,
+              (BLI_time_now_seconds() - draw_time_start) * 1000.0);
+  }
 }
 
 /**
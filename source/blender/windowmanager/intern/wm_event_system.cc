@@ -31,6 +31,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_time.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
@@ -2535,10 +2536,22 @@ static eHandlerActionFlag wm_handler_operator_call(bContext *C,
         wm->op_undo_depth++;
       }
 
+      /* Only query the time when the modal handler times are actually logged. */
+      const bool use_timing = CLOG_CHECK(WM_LOG_HANDLERS, 2);
+      const double modal_time_start = use_timing ? BLI_time_now_seconds() : 0.0;
+
       /* Warning, after this call all context data and 'event' may be freed. see check below. */
       retval = ot->modal(C, op, event);
       OPERATOR_RETVAL_CHECK(retval);
 
+      if (use_timing) {
+        CLOG_INFO(WM_LOG_HANDLERS,
+                  2,
+                  "modal handler %s took %.3f ms",
+                  ot->idname,
+                  (BLI_time_now_seconds() - modal_time_start) * 1000.0);
+      }
+
       if (ot->flag & OPTYPE_UNDO && CTX_wm_manager(C) == wm) {
         wm->op_undo_depth--;
       }
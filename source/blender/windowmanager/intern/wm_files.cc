@@ -2138,6 +2138,46 @@ bool WM_autosave_is_scheduled(wmWindowManager *wm)
   return wm->autosave_scheduled;
 }
 
+static void wm_autosave_write_job_startjob(void *buffer_v, wmJobWorkerStatus * /*worker_status*/)
+{
+  const BlendFileWriteBuffer *buffer = static_cast<const BlendFileWriteBuffer *>(buffer_v);
+  /* Error reporting into console. */
+  BLO_write_buffer_to_file(buffer, nullptr);
+}
+
+static void wm_autosave_write_job_free(void *buffer_v)
+{
+  BLO_write_buffer_free(static_cast<BlendFileWriteBuffer *>(buffer_v));
+}
+
+/**
+ * Only serialize the file on the main thread and write it to disk in a background job, so that
+ * auto-saving big files doesn't block the interface while the data goes to disk.
+ */
+static void wm_autosave_write_in_background(wmWindowManager *wm,
+                                            Main *bmain,
+                                            const char *filepath,
+                                            const int fileflags,
+                                            const BlendFileWriteParams *params)
+{
+  /* Skip this auto-save when the previous one is still being written. */
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    return;
+  }
+
+  BlendFileWriteBuffer *buffer = BLO_write_file_to_buffer(
+      bmain, filepath, fileflags, params, nullptr);
+  if (buffer == nullptr) {
+    return;
+  }
+
+  wmJob *wm_job = WM_jobs_get(
+      wm, wm->winactive, wm, "Auto-saving...", eWM_JobFlag(0), WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, buffer, wm_autosave_write_job_free);
+  WM_jobs_callbacks(wm_job, wm_autosave_write_job_startjob, nullptr, nullptr, nullptr);
+  WM_jobs_start(wm, wm_job);
+}
+
 void WM_autosave_write(wmWindowManager *wm, Main *bmain)
 {
   ED_editors_flush_edits(bmain);
@@ -2147,9 +2187,14 @@ void WM_autosave_write(wmWindowManager *wm, Main *bmain)
   /* Save as regular blend file with recovery information. */
   const int fileflags = (G.fileflags & ~G_FILE_COMPRESS) | G_FILE_RECOVER_WRITE;
 
-  /* Error reporting into console. */
   BlendFileWriteParams params{};
-  BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  if (G.background) {
+    /* Error reporting into console. */
+    BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  }
+  else {
+    wm_autosave_write_in_background(wm, bmain, filepath, fileflags, &params);
+  }
 
   /* Restart auto-save timer. */
   wm_autosave_timer_end(wm);
@@ -114,6 +114,8 @@
 
 #include "DRW_engine.hh"
 
+#include "NOD_gpu_field_evaluation.hh"
+
 #ifdef WITH_ONDINE
 #  include "ondine_ops.hh"
 #endif
@@ -612,6 +614,7 @@ void WM_exit_ex(bContext *C, const bool do_python_exit, const bool do_user_exit_
    * the modifiers were garbage collected. */
   if (gpu_is_init) {
     blender::draw::DRW_subdiv_free();
+    blender::draw::DRW_armature_deform_free();
   }
 
   ANIM_fcurves_copybuf_free();
@@ -664,6 +667,7 @@ void WM_exit_ex(bContext *C, const bool do_python_exit, const bool do_user_exit_
   if (gpu_is_init) {
     DRW_gpu_context_enable_ex(false);
     UI_exit();
+    blender::nodes::gpu_field_evaluation_free();
     GPU_pass_cache_free();
     GPU_exit();
     DRW_gpu_context_disable_ex(false);
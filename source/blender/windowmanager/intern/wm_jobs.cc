@@ -24,6 +24,8 @@
 
 #include "SEQ_prefetch.hh"
 
+#include "ED_grease_pencil_ondine.hh"
+
 #include "WM_api.hh"
 #include "WM_types.hh"
 #include "wm.hh"
@@ -581,8 +583,9 @@ void WM_jobs_kill_all(wmWindowManager *wm)
     wm_jobs_kill_job(wm, wm_job);
   }
 
-  /* This job will be automatically restarted. */
+  /* These jobs will be automatically restarted. */
   SEQ_prefetch_stop_all();
+  blender::ondine::gpencil_ondine_prefetch_stop();
 }
 
 void WM_jobs_kill_all_except(wmWindowManager *wm, const void *owner)
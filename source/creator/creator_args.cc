@@ -28,6 +28,7 @@
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task.hh"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 #  ifndef NDEBUG
@@ -35,6 +36,7 @@
 #  endif
 
 #  include "BKE_appdir.hh"
+#  include "BKE_blender.hh"
 #  include "BKE_blender_cli_command.hh"
 #  include "BKE_blender_version.h"
 #  include "BKE_blendfile.hh"
@@ -760,11 +762,13 @@ static void print_help(bArgs *ba, bool all)
     BLI_args_print_arg_doc(ba, "--debug-xr");
     BLI_args_print_arg_doc(ba, "--debug-xr-time");
   }
+  BLI_args_print_arg_doc(ba, "--debug-compositor");
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
 
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
+  BLI_args_print_arg_doc(ba, "--debug-tasks-trace");
   BLI_args_print_arg_doc(ba, "--debug-exit-on-error");
   if (defs.with_freestyle) {
     BLI_args_print_arg_doc(ba, "--debug-freestyle");
@@ -1267,6 +1271,10 @@ static const char arg_handle_debug_mode_generic_set_doc_xr[] =
 static const char arg_handle_debug_mode_generic_set_doc_xr_time[] =
     "\n\t"
     "Enable debug messages for virtual reality frame rendering times.";
+static const char arg_handle_debug_mode_generic_set_doc_compositor[] =
+    "\n\t"
+    "Enable time profiling of the compositor in final renders, printing the evaluation time of\n"
+    "\teach node. GPU work is waited on after each node such that times include GPU time.";
 static const char arg_handle_debug_mode_generic_set_doc_jobs[] =
     "\n\t"
     "Enable time profiling for background jobs.";
@@ -1493,6 +1501,35 @@ static int arg_handle_debug_fpe_set(int /*argc*/, const char ** /*argv*/, void *
   return 0;
 }
 
+static char debug_tasks_trace_filepath[FILE_MAX];
+
+static void debug_tasks_trace_write(void * /*user_data*/)
+{
+  if (!blender::threading::trace::stop_and_write(debug_tasks_trace_filepath)) {
+    fprintf(stderr, "\nError: could not write tasks trace '%s'.\n", debug_tasks_trace_filepath);
+  }
+}
+
+static const char arg_handle_debug_tasks_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the tasks run by the task scheduler and write them on exit as Chrome trace JSON,\n"
+    "\twhich can be opened in 'chrome://tracing' or Perfetto.";
+static int arg_handle_debug_tasks_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-tasks-trace";
+  if (argc > 1) {
+    STRNCPY(debug_tasks_trace_filepath, argv[1]);
+    BLI_path_abs_from_cwd(debug_tasks_trace_filepath, sizeof(debug_tasks_trace_filepath));
+    if (!blender::threading::trace::is_enabled()) {
+      BKE_blender_atexit_register(debug_tasks_trace_write, nullptr);
+    }
+    blender::threading::trace::start();
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_app_template_doc[] =
     "<template>\n"
     "\tSet the application template (matching the directory name), use 'default' for none.";
@@ -2654,11 +2691,18 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-wintab",
                CB_EX(arg_handle_debug_mode_generic_set, wintab),
                (void *)G_DEBUG_WINTAB);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-compositor",
+               CB_EX(arg_handle_debug_mode_generic_set, compositor),
+               (void *)G_DEBUG_COMPOSITOR);
   BLI_args_add(ba, nullptr, "--debug-all", CB(arg_handle_debug_mode_all), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-io", CB(arg_handle_debug_mode_io), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-fpe", CB(arg_handle_debug_fpe_set), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--debug-tasks-trace", CB(arg_handle_debug_tasks_trace_set), nullptr);
 
   if (defs.with_libmv) {
     BLI_args_add(ba, nullptr, "--debug-libmv", CB(arg_handle_debug_mode_libmv), nullptr);
@@ -4,7 +4,7 @@
 
 import abc
 import fnmatch
-from typing import Dict, List
+from typing import Dict, List, Optional
 
 
 class Test:
@@ -39,6 +39,23 @@ class Test:
         """
 
 
+def peak_memory() -> Optional[float]:
+    """
+    Peak resident memory of the current process in bytes, or None when it
+    can't be queried on this platform. Meant to be called from a test
+    function that runs inside Blender.
+    """
+    try:
+        import resource
+    except ImportError:
+        return None
+
+    import sys
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Reported in bytes on macOS and in kilobytes on other platforms.
+    return float(peak) if sys.platform == 'darwin' else float(peak) * 1024.0
+
+
 class TestCollection:
     def __init__(self, env, names_filter: List = ['*'], categories_filter: List = ['*'], background: bool = False):
         import importlib
@@ -4,27 +4,78 @@
 
 import api
 
+TIMEOUT = 10
+
+LOG_KEY = "ANIMATION_DRAW_PERFORMANCE: "
+
+
+def _percentile(sorted_values, percentile):
+    index = min(len(sorted_values) - 1, int(round(percentile / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def _frame_time_results(frame_times, prefix=''):
+    # Averages hide uneven frame pacing, so report percentiles of the individual frame times too.
+    frame_times = sorted(frame_times)
+    return {
+        prefix + 'time': sum(frame_times) / len(frame_times),
+        prefix + 'p50': _percentile(frame_times, 50),
+        prefix + 'p95': _percentile(frame_times, 95),
+        prefix + 'p99': _percentile(frame_times, 99),
+    }
+
 
 def _run(args):
     import bpy
     import time
 
-    start_time = time.time()
-    elapsed_time = 0.0
-    num_frames = 0
+    start_time = time.perf_counter()
+    frame_times = []
 
-    while elapsed_time < 10.0:
+    while time.perf_counter() - start_time < TIMEOUT:
         scene = bpy.context.scene
         for i in range(scene.frame_start, scene.frame_end + 1):
+            frame_start_time = time.perf_counter()
             scene.frame_set(i)
+            frame_times.append(time.perf_counter() - frame_start_time)
+
+    return _frame_time_results(frame_times)
+
+
+def _run_draw(args):
+    import bpy
+    import time
+
+    window = bpy.context.window_manager.windows[0]
+
+    with bpy.context.temp_override(window=window, screen=window.screen):
+        # Draw once first, to avoid measuring shader compilation and other one time initializations.
+        bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+
+        start_time = time.perf_counter()
+        eval_times = []
+        draw_times = []
+        frame_times = []
 
-        num_frames += scene.frame_end + 1 - scene.frame_start
-        elapsed_time = time.time() - start_time
+        while time.perf_counter() - start_time < TIMEOUT:
+            scene = bpy.context.scene
+            for i in range(scene.frame_start, scene.frame_end + 1):
+                frame_start_time = time.perf_counter()
+                scene.frame_set(i)
+                eval_end_time = time.perf_counter()
+                # Draw synchronization, GPU work and the buffer swap of the window.
+                bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+                draw_end_time = time.perf_counter()
 
-    time_per_frame = elapsed_time / num_frames
+                eval_times.append(eval_end_time - frame_start_time)
+                draw_times.append(draw_end_time - eval_end_time)
+                frame_times.append(draw_end_time - frame_start_time)
 
-    result = {'time': time_per_frame}
-    return result
+    result = _frame_time_results(frame_times)
+    result.update(_frame_time_results(eval_times, 'eval_'))
+    result.update(_frame_time_results(draw_times, 'draw_'))
+    print(f"{LOG_KEY}{result}")
+    bpy.ops.wm.quit_blender()
 
 
 class AnimationTest(api.Test):
@@ -43,6 +94,31 @@ class AnimationTest(api.Test):
         return result
 
 
+class AnimationDrawTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "animation_draw"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        import ast
+
+        args = {}
+        _, log = env.run_in_blender(_run_draw, args, [self.filepath], foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                return ast.literal_eval(line[len(LOG_KEY):])
+        raise Exception("No animation draw performance result found in log.")
+
+
 def generate(env):
     filepaths = env.find_blend_files('animation/*')
-    return [AnimationTest(filepath) for filepath in filepaths]
+    return ([AnimationTest(filepath) for filepath in filepaths] +
+            [AnimationDrawTest(filepath) for filepath in filepaths])
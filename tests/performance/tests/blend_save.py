@@ -0,0 +1,53 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+    import time
+
+    bpy.ops.wm.open_mainfile(filepath=args['filepath'])
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        filepath = os.path.join(tempdir, "save.blend")
+
+        # Save once first, so that the output file already exists as for regular saves.
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, compress=args['compress'], copy=True)
+
+        # Measure saving the second time.
+        start_time = time.time()
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, compress=args['compress'], copy=True)
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time}
+    memory = api.peak_memory()
+    if memory is not None:
+        result['peak_memory'] = memory
+    return result
+
+
+class BlendSaveTest(api.Test):
+    def __init__(self, filepath, compress):
+        self.filepath = filepath
+        self.compress = compress
+
+    def name(self):
+        return f"{self.filepath.stem}_{'compressed' if self.compress else 'uncompressed'}"
+
+    def category(self):
+        return "blend_save"
+
+    def run(self, env, device_id):
+        args = {'filepath': str(self.filepath), 'compress': self.compress}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('*/*')
+    return [BlendSaveTest(filepath, compress) for filepath in filepaths for compress in (False, True)]
@@ -0,0 +1,181 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+RESOLUTIONS = {
+    '2k': (2048, 1080),
+    '4k': (3840, 2160),
+    '8k': (7680, 4320),
+}
+
+DEVICES = ('CPU', 'GPU')
+
+NODE_TREES = (
+    'blur',
+    'bokeh_blur',
+    'defocus',
+    'glare_fog_glow',
+    'glare_streaks',
+    'keying',
+    'transform',
+)
+
+NODE_TIME_PREFIX = 'Compositor: node "'
+
+
+def _build_node_tree(args):
+    import bpy
+
+    scene = bpy.context.scene
+    scene.use_nodes = True
+    scene.render.use_compositing = True
+    scene.render.compositor_device = args['device']
+    scene.render.resolution_x, scene.render.resolution_y = args['resolution']
+    scene.render.resolution_percentage = 100
+
+    node_tree = scene.node_tree
+    node_tree.nodes.clear()
+
+    # Use a generated image as an input, such that no render is needed and only the compositor is
+    # measured.
+    image = bpy.data.images.new("Input", *args['resolution'], alpha=True, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    image_node = node_tree.nodes.new('CompositorNodeImage')
+    image_node.image = image
+    image_output = image_node.outputs['Image']
+
+    composite_node = node_tree.nodes.new('CompositorNodeComposite')
+    links = node_tree.links
+    nodes = node_tree.nodes
+
+    name = args['node_tree']
+    if name == 'blur':
+        node = nodes.new('CompositorNodeBlur')
+        node.filter_type = 'GAUSS'
+        node.size_x = 50
+        node.size_y = 50
+    elif name == 'bokeh_blur':
+        node = nodes.new('CompositorNodeBokehBlur')
+        bokeh_image_node = nodes.new('CompositorNodeBokehImage')
+        links.new(bokeh_image_node.outputs['Image'], node.inputs['Bokeh'])
+        node.inputs['Size'].default_value = 5.0
+    elif name == 'defocus':
+        node = nodes.new('CompositorNodeDefocus')
+        node.use_zbuffer = True
+        node.f_stop = 2.0
+        node.blur_max = 64.0
+        separate_node = nodes.new('CompositorNodeSeparateColor')
+        links.new(image_output, separate_node.inputs['Image'])
+        depth_node = nodes.new('CompositorNodeMath')
+        depth_node.operation = 'MULTIPLY'
+        depth_node.inputs[1].default_value = 10.0
+        links.new(separate_node.outputs['Red'], depth_node.inputs[0])
+        links.new(depth_node.outputs['Value'], node.inputs['Z'])
+    elif name == 'glare_fog_glow':
+        node = nodes.new('CompositorNodeGlare')
+        node.glare_type = 'FOG_GLOW'
+        node.quality = 'HIGH'
+        node.size = 9
+    elif name == 'glare_streaks':
+        node = nodes.new('CompositorNodeGlare')
+        node.glare_type = 'STREAKS'
+        node.quality = 'HIGH'
+    elif name == 'keying':
+        node = nodes.new('CompositorNodeKeying')
+        node.inputs['Key Color'].default_value = (0.0, 1.0, 0.0, 1.0)
+    elif name == 'transform':
+        node = nodes.new('CompositorNodeTransform')
+        node.inputs['Angle'].default_value = 0.5
+        node.inputs['Scale'].default_value = 0.75
+    else:
+        raise Exception(f"Unknown node tree {name}")
+
+    links.new(image_output, node.inputs['Image'])
+    links.new(node.outputs['Image'], composite_node.inputs['Image'])
+
+
+def _run(args):
+    import bpy
+    import time
+
+    _build_node_tree(args)
+
+    # Render once first, to avoid measuring shader compilation and other one time initializations.
+    bpy.ops.render.render()
+
+    test_time_start = time.time()
+    measured_times = []
+
+    min_measurements = 3
+    max_measurements = 20
+    timeout = 10
+
+    while True:
+        start_time = time.time()
+        bpy.ops.render.render()
+        elapsed_time = time.time() - start_time
+        measured_times.append(elapsed_time)
+
+        if len(measured_times) >= min_measurements and test_time_start + timeout < time.time():
+            break
+        if len(measured_times) >= max_measurements:
+            break
+
+    average_time = sum(measured_times) / len(measured_times)
+    result = {'time': average_time}
+    return result
+
+
+def _parse_node_times(lines):
+    # Parse the per-node evaluation times printed by --debug-compositor, which have the form:
+    #   Compositor: node "Name" evaluated in 1.234 ms
+    # The first render is a warm up render, so its times are skipped.
+    node_times = {}
+    for line in lines:
+        line = line.strip()
+        if not line.startswith(NODE_TIME_PREFIX):
+            continue
+        name, _, remainder = line[len(NODE_TIME_PREFIX):].partition('" evaluated in ')
+        milliseconds = float(remainder.split()[0])
+        node_times.setdefault(name, []).append(milliseconds / 1000.0)
+
+    result = {}
+    for name, times in node_times.items():
+        times = times[1:] if len(times) > 1 else times
+        result['node_' + name] = sum(times) / len(times)
+    return result
+
+
+class CompositorTest(api.Test):
+    def __init__(self, node_tree, resolution, device):
+        self.node_tree = node_tree
+        self.resolution = resolution
+        self.device = device
+
+    def name(self):
+        return f"{self.node_tree}_{self.resolution}_{self.device.lower()}"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {'node_tree': self.node_tree,
+                'resolution': RESOLUTIONS[self.resolution],
+                'device': self.device}
+
+        result, lines = env.run_in_blender(_run, args, ['--debug-compositor'])
+        if not result:
+            raise Exception("No compositor performance result found in log.")
+
+        result.update(_parse_node_times(lines))
+        return result
+
+
+def generate(env):
+    return [CompositorTest(node_tree, resolution, device)
+            for node_tree in NODE_TREES
+            for resolution in RESOLUTIONS
+            for device in DEVICES]
@@ -0,0 +1,58 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    view_layer = bpy.context.view_layer
+    view_layer.update()
+
+    # Linking and unlinking an object tags the relations of the dependency graph for a rebuild,
+    # and the following update rebuilds them. This also includes evaluating the scene changes.
+    obj = bpy.data.objects.new("Benchmark", None)
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_rebuilds = 0
+
+    while elapsed_time < 10.0:
+        scene.collection.objects.link(obj)
+        view_layer.update()
+        scene.collection.objects.unlink(obj)
+        view_layer.update()
+
+        num_rebuilds += 2
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_rebuilds}
+    memory = api.peak_memory()
+    if memory is not None:
+        result['peak_memory'] = memory
+    return result
+
+
+class DepsgraphRelationsTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "depsgraph_relations"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('*/*')
+    return [DepsgraphRelationsTest(filepath) for filepath in filepaths]
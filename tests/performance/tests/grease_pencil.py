@@ -0,0 +1,197 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Generated scenes as (layers, strokes per layer, points per stroke, keyframes per layer). The
+# first keyframe of every layer contains the strokes, the other keyframes are blank.
+SCENES = {
+    'many_layers': (2000, 50, 100, 1),
+    'many_points': (10, 5000, 200, 1),
+    'many_frames': (100, 100, 100, 2000),
+}
+
+MEASUREMENTS = ('load', 'frame_change', 'modifiers', 'draw')
+
+TIMEOUT = 10
+
+LOG_KEY = "GREASE_PENCIL_PERFORMANCE: "
+
+
+def _generate_scene(scene_name):
+    import bpy
+    import numpy as np
+
+    num_layers, num_strokes, num_points, num_frames = SCENES[scene_name]
+
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete()
+
+    # Grease pencil drawings can't be filled from Python directly, so create curves with wavy
+    # strokes and convert them.
+    curves = bpy.data.hair_curves.new("Strokes")
+    curves.add_curves([num_points] * num_strokes)
+    t = np.tile(np.linspace(0.0, 1.0, num_points), num_strokes)
+    stroke = np.repeat(np.arange(num_strokes) / num_strokes, num_points)
+    positions = np.column_stack((t * 2.0 - 1.0, np.sin(t * 20.0 + stroke * 10.0) * 0.1, stroke))
+    curves.position_data.foreach_set('vector', positions.astype(np.float32).ravel())
+
+    obj = bpy.data.objects.new("Strokes", curves)
+    bpy.context.scene.collection.objects.link(obj)
+    bpy.context.view_layer.objects.active = obj
+    obj.select_set(True)
+    bpy.ops.object.convert(target='GREASE_PENCIL')
+
+    obj = bpy.context.view_layer.objects.active
+    grease_pencil = obj.data
+    grease_pencil.layers.active_layer = grease_pencil.layers[0]
+
+    scene = bpy.context.scene
+    for frame in range(2, num_frames + 1):
+        scene.frame_current = frame
+        bpy.ops.grease_pencil.insert_blank_frame()
+    scene.frame_start = 1
+    scene.frame_end = max(num_frames, 2)
+    scene.frame_current = 1
+
+    # Duplicating a layer also duplicates its keyframes and their drawings.
+    for _ in range(num_layers - 1):
+        bpy.ops.grease_pencil.layer_duplicate()
+
+    bpy.context.view_layer.update()
+    return obj, num_layers * num_frames
+
+
+def _measure_load(obj):
+    import bpy
+    import os
+    import tempfile
+    import time
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        filepath = os.path.join(tempdir, "grease_pencil.blend")
+        bpy.ops.wm.save_as_mainfile(filepath=filepath)
+
+        # Load once to ensure it's cached by OS.
+        bpy.ops.wm.open_mainfile(filepath=filepath)
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+        # Measure loading the second time.
+        start_time = time.perf_counter()
+        bpy.ops.wm.open_mainfile(filepath=filepath)
+        return time.perf_counter() - start_time
+
+
+def _measure_frame_change(obj):
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    start_time = time.perf_counter()
+    num_frames = 0
+
+    while time.perf_counter() - start_time < TIMEOUT:
+        for frame in range(scene.frame_start, scene.frame_end + 1):
+            scene.frame_set(frame)
+        num_frames += scene.frame_end + 1 - scene.frame_start
+
+    return (time.perf_counter() - start_time) / num_frames
+
+
+def _measure_modifiers(obj):
+    # Modifiers are evaluated again on every frame change, the noise changes per frame.
+    noise = obj.modifiers.new("Noise", type='GREASE_PENCIL_NOISE')
+    noise.use_random = True
+    noise.step = 1
+    obj.modifiers.new("Thickness", type='GREASE_PENCIL_THICKNESS')
+    obj.modifiers.new("Smooth", type='GREASE_PENCIL_SMOOTH')
+    return _measure_frame_change(obj)
+
+
+def _measure_draw(obj):
+    import bpy
+    import time
+
+    # Draw once first, to avoid measuring shader compilation and other one time initializations.
+    bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+    start_time = time.perf_counter()
+    num_redraws = 0
+
+    while time.perf_counter() - start_time < TIMEOUT:
+        # Tagging the geometry rebuilds the draw cache of all drawings in the next redraw.
+        obj.data.update_tag()
+        bpy.context.view_layer.update()
+        bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+        num_redraws += 1
+
+    return (time.perf_counter() - start_time) / num_redraws
+
+
+def _find_view3d():
+    import bpy
+
+    window = bpy.context.window_manager.windows[0]
+    for area in window.screen.areas:
+        if area.type == 'VIEW_3D':
+            for region in area.regions:
+                if region.type == 'WINDOW':
+                    return {'window': window, 'screen': window.screen, 'area': area, 'region': region}
+    return None
+
+
+def _run(args):
+    import bpy
+
+    measure_fn = globals()['_measure_' + args['measurement']]
+    context = _find_view3d() if args['measurement'] == 'draw' else {}
+
+    with bpy.context.temp_override(**context):
+        obj, num_drawings = _generate_scene(args['scene'])
+        elapsed_time = measure_fn(obj)
+
+    result = {'time': elapsed_time}
+    memory = api.peak_memory()
+    if memory is not None:
+        result['peak_memory'] = memory
+        result['peak_memory_per_drawing'] = memory / num_drawings
+
+    if args['measurement'] == 'draw':
+        print(f"{LOG_KEY}{result}")
+        bpy.ops.wm.quit_blender()
+    return result
+
+
+class GreasePencilTest(api.Test):
+    def __init__(self, scene_name, measurement):
+        self.scene_name = scene_name
+        self.measurement = measurement
+
+    def name(self):
+        return f"{self.scene_name}_{self.measurement}"
+
+    def category(self):
+        return "grease_pencil"
+
+    def use_background(self):
+        return self.measurement != 'draw'
+
+    def run(self, env, device_id):
+        import ast
+
+        args = {'scene': self.scene_name, 'measurement': self.measurement}
+        if self.use_background():
+            result, _ = env.run_in_blender(_run, args)
+            return result
+
+        _, log = env.run_in_blender(_run, args, foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                return ast.literal_eval(line[len(LOG_KEY):])
+        raise Exception("No grease pencil performance result found in log.")
+
+
+def generate(env):
+    return [GreasePencilTest(scene_name, measurement)
+            for scene_name in SCENES
+            for measurement in MEASUREMENTS]
@@ -0,0 +1,172 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import enum
+
+# Brushes that are replayed on every mesh type.
+BRUSH_TOOLS = ('DRAW', 'CLAY_STRIPS', 'INFLATE', 'SMOOTH')
+
+# Number of dabs in a stroke and number of times the stroke is replayed.
+STROKE_DABS = 100
+MIN_STROKES = 5
+MAX_STROKES = 50
+TIMEOUT = 10
+
+LOG_KEY = "SCULPT_PERFORMANCE: "
+
+
+class MeshType(enum.Enum):
+    MESH = 'mesh'
+    MULTIRES = 'multires'
+    DYNTOPO = 'dyntopo'
+
+
+def _find_view3d():
+    import bpy
+
+    window = bpy.context.window_manager.windows[0]
+    for area in window.screen.areas:
+        if area.type == 'VIEW_3D':
+            for region in area.regions:
+                if region.type == 'WINDOW':
+                    return {'window': window, 'screen': window.screen, 'area': area, 'region': region}
+    return None
+
+
+def _prepare_scene(mesh_type, brush_tool):
+    import bpy
+
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete()
+
+    # Roughly a million vertices for regular meshes and multires, and less for dynamic topology
+    # which subdivides the mesh while sculpting.
+    if mesh_type == MeshType.MESH:
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=1000, y_subdivisions=1000, size=2.0)
+    elif mesh_type == MeshType.MULTIRES:
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=125, y_subdivisions=125, size=2.0)
+        bpy.ops.object.modifier_add(type='MULTIRES')
+        for _ in range(3):
+            bpy.ops.object.multires_subdivide(modifier="Multires", mode='SIMPLE')
+    else:
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=250, y_subdivisions=250, size=2.0)
+
+    bpy.ops.object.mode_set(mode='SCULPT')
+    if mesh_type == MeshType.DYNTOPO:
+        bpy.ops.sculpt.dynamic_topology_toggle()
+
+    tool_settings = bpy.context.scene.tool_settings
+    brush = bpy.data.brushes.new("Benchmark", mode='SCULPT')
+    brush.sculpt_tool = brush_tool
+    brush.size = 60
+    brush.strength = 0.5
+    tool_settings.sculpt.brush = brush
+    tool_settings.unified_paint_settings.use_unified_size = False
+    tool_settings.unified_paint_settings.use_unified_strength = False
+
+
+def _generate_stroke(context):
+    from bpy_extras import view3d_utils
+    from mathutils import Vector
+    import math
+
+    region = context['region']
+    rv3d = context['area'].spaces.active.region_3d
+
+    # A wave across the grid, so that the brush keeps touching new parts of the mesh.
+    stroke = []
+    for i in range(STROKE_DABS):
+        factor = i / (STROKE_DABS - 1)
+        location = Vector((factor * 1.6 - 0.8, math.sin(factor * math.pi * 4.0) * 0.6, 0.0))
+        mouse = view3d_utils.location_3d_to_region_2d(region, rv3d, location)
+        stroke.append({
+            "name": "dab",
+            "location": location,
+            "mouse": (mouse.x, mouse.y, 0.0),
+            "mouse_event": (mouse.x, mouse.y, 0.0),
+            "pressure": 1.0,
+            "size": 60.0,
+            "pen_flip": False,
+            "x_tilt": 0.0,
+            "y_tilt": 0.0,
+            "time": float(i),
+            "is_start": i == 0,
+        })
+    return stroke
+
+
+def _percentile(sorted_values, percentile):
+    index = min(len(sorted_values) - 1, int(round(percentile / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def _run(args):
+    import bpy
+    import time
+
+    mesh_type = MeshType(args['mesh_type'])
+    context = _find_view3d()
+
+    with bpy.context.temp_override(**context):
+        _prepare_scene(mesh_type, args['brush_tool'])
+        bpy.ops.view3d.view_axis(type='TOP')
+        bpy.ops.view3d.view_selected()
+        # Redraw once so that the view matrices used for projecting the stroke are up to date.
+        bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+
+        stroke = _generate_stroke(context)
+
+        # Each stroke is executed directly, so all of its dabs are evaluated in one operator call.
+        # The latency of a dab is the average over a stroke, percentiles are over all strokes.
+        dab_times = []
+        test_time_start = time.perf_counter()
+        while True:
+            start_time = time.perf_counter()
+            bpy.ops.sculpt.brush_stroke(stroke=stroke, mode='NORMAL')
+            dab_times.append((time.perf_counter() - start_time) / STROKE_DABS)
+
+            if len(dab_times) >= MIN_STROKES and test_time_start + TIMEOUT < time.perf_counter():
+                break
+            if len(dab_times) >= MAX_STROKES:
+                break
+
+    dab_times.sort()
+    result = {
+        'time': sum(dab_times) / len(dab_times),
+        'p50': _percentile(dab_times, 50),
+        'p90': _percentile(dab_times, 90),
+        'p99': _percentile(dab_times, 99),
+    }
+    print(f"{LOG_KEY}{result}")
+    bpy.ops.wm.quit_blender()
+
+
+class SculptTest(api.Test):
+    def __init__(self, mesh_type, brush_tool):
+        self.mesh_type = mesh_type
+        self.brush_tool = brush_tool
+
+    def name(self):
+        return f"{self.mesh_type.value}_{self.brush_tool.lower()}"
+
+    def category(self):
+        return "sculpt"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        import ast
+
+        args = {'mesh_type': self.mesh_type.value, 'brush_tool': self.brush_tool}
+        _, log = env.run_in_blender(_run, args, foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                return ast.literal_eval(line[len(LOG_KEY):])
+        raise Exception("No sculpt performance result found in log.")
+
+
+def generate(env):
+    return [SculptTest(mesh_type, brush_tool) for mesh_type in MeshType for brush_tool in BRUSH_TOOLS]
@@ -0,0 +1,110 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Object mode uses global (memfile) undo, edit mode uses the mesh undo system.
+MODES = ('OBJECT', 'EDIT')
+
+MIN_STEPS = 5
+MAX_STEPS = 50
+TIMEOUT = 10
+
+LOG_KEY = "UNDO_PERFORMANCE: "
+
+
+def _prepare_scene(mode):
+    import bpy
+
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete()
+
+    # Roughly a million vertices, undo steps store or compare all of them.
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=1000, y_subdivisions=1000, size=2.0)
+    bpy.ops.object.mode_set(mode=mode)
+
+
+def _modify(mode):
+    import bpy
+
+    # A change that is cheap compared to the undo step, so that undo dominates the timing.
+    if mode == 'OBJECT':
+        bpy.context.object.location.x += 0.1
+    else:
+        bpy.ops.mesh.select_all(action='INVERT')
+
+
+def _run(args):
+    import bpy
+    import time
+
+    mode = args['mode']
+    window = bpy.context.window_manager.windows[0]
+
+    with bpy.context.temp_override(window=window, screen=window.screen):
+        _prepare_scene(mode)
+        bpy.ops.ed.undo_push(message="Benchmark Start")
+
+        push_times = []
+        undo_times = []
+        redo_times = []
+        test_time_start = time.perf_counter()
+        while True:
+            _modify(mode)
+
+            start_time = time.perf_counter()
+            bpy.ops.ed.undo_push(message="Benchmark")
+            push_times.append(time.perf_counter() - start_time)
+
+            start_time = time.perf_counter()
+            bpy.ops.ed.undo()
+            undo_times.append(time.perf_counter() - start_time)
+
+            start_time = time.perf_counter()
+            bpy.ops.ed.redo()
+            redo_times.append(time.perf_counter() - start_time)
+
+            if len(push_times) >= MIN_STEPS and test_time_start + TIMEOUT < time.perf_counter():
+                break
+            if len(push_times) >= MAX_STEPS:
+                break
+
+    result = {
+        'time': sum(push_times) / len(push_times),
+        'undo_time': sum(undo_times) / len(undo_times),
+        'redo_time': sum(redo_times) / len(redo_times),
+    }
+    memory = api.peak_memory()
+    if memory is not None:
+        result['peak_memory'] = memory
+    print(f"{LOG_KEY}{result}")
+    bpy.ops.wm.quit_blender()
+
+
+class UndoTest(api.Test):
+    def __init__(self, mode):
+        self.mode = mode
+
+    def name(self):
+        return self.mode.lower()
+
+    def category(self):
+        return "undo"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        import ast
+
+        args = {'mode': self.mode}
+        _, log = env.run_in_blender(_run, args, foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                return ast.literal_eval(line[len(LOG_KEY):])
+        raise Exception("No undo performance result found in log.")
+
+
+def generate(env):
+    return [UndoTest(mode) for mode in MODES]
@@ -0,0 +1,53 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --factory-startup \
+#   --python tests/python/bl_geometry_nodes_node_result_cache.py -- --verbose
+import unittest
+
+import bpy
+
+
+class NodeResultCacheTest(unittest.TestCase):
+    def setUp(self):
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        self.scene = bpy.context.scene
+
+    def _add_mesh_object(self, name):
+        obj = bpy.data.objects.new(name, bpy.data.meshes.new(name))
+        self.scene.collection.objects.link(obj)
+        return obj
+
+    def test_object_info_follows_moved_object(self):
+        target = self._add_mesh_object("Target")
+        obj = self._add_mesh_object("Object")
+
+        # A single vertex at the location of the target object.
+        tree = bpy.data.node_groups.new("Object Location", 'GeometryNodeTree')
+        tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+        group_output = tree.nodes.new('NodeGroupOutput')
+        object_info = tree.nodes.new('GeometryNodeObjectInfo')
+        object_info.inputs["Object"].default_value = target
+        mesh_line = tree.nodes.new('GeometryNodeMeshLine')
+        mesh_line.inputs["Count"].default_value = 1
+        tree.links.new(object_info.outputs["Location"], mesh_line.inputs["Start Location"])
+        tree.links.new(mesh_line.outputs["Mesh"], group_output.inputs["Geometry"])
+
+        modifier = obj.modifiers.new("Nodes", 'NODES')
+        modifier.node_group = tree
+        modifier.use_node_result_cache = True
+
+        view_layer = bpy.context.view_layer
+        for location in ((0.0, 0.0, 0.0), (1.0, 2.0, 3.0), (-4.0, 0.5, 2.0)):
+            target.location = location
+            view_layer.update()
+            obj_eval = obj.evaluated_get(bpy.context.evaluated_depsgraph_get())
+            self.assertEqual(len(obj_eval.data.vertices), 1)
+            self.assertEqual(tuple(obj_eval.data.vertices[0].co), location)
+
+
+if __name__ == '__main__':
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
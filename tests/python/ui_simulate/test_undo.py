@@ -324,6 +324,23 @@ def view3d_simple():
     t.assertEqual(len(window.view_layer.objects.active.data.polygons), 16)
 
 
+def view3d_simple_move_twice():
+    e, t = _test_vars(window := _test_window())
+    yield from _view3d_startup_area_maximized(e)
+
+    yield from _call_menu(e, "Add -> Mesh -> Plane")
+    # Two edits in a row that tag the object with the same update flags.
+    yield e.g().x().text("1").ret()
+    yield e.g().x().text("1").ret()
+    t.assertAlmostEqual(window.view_layer.objects.active.location.x, 2.0)
+    yield e.ctrl.z()                    # Undo the second move.
+    t.assertAlmostEqual(window.view_layer.objects.active.location.x, 1.0)
+    yield e.ctrl.z()                    # Undo the first move.
+    t.assertAlmostEqual(window.view_layer.objects.active.location.x, 0.0)
+    yield e.ctrl.shift.z(2)             # Redo both moves.
+    t.assertAlmostEqual(window.view_layer.objects.active.location.x, 2.0)
+
+
 def view3d_sculpt_with_memfile_step():
     e, t = _test_vars(window := _test_window())
     yield from _view3d_startup_area_maximized(e)